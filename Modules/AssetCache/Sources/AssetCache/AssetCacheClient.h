@@ -1,9 +1,10 @@
 #pragma once
 
 #include "AssetCache/AssetCache.h"
+#include "AssetCache/ReceivedValueFile.h"
 
 #include <Base/Introspection.h>
-#include <FileSystem/DynamicMemoryFile.h>
+#include <Compression/Compressor.h>
 
 #include <atomic>
 
@@ -18,6 +19,7 @@ public:
         String ip = AssetCache::GetLocalHost();
         uint16 port = AssetCache::ASSET_SERVER_PORT;
         uint64 timeoutms = 60u * 1000u;
+        Compressor::Type chunksCompression = Compressor::Type::None; // Lz4 saves traffic to remote cache at cost of CPU time
     };
 
     AssetCacheClient();
@@ -91,7 +93,7 @@ private:
 
     struct GetFilesRequest
     {
-        Vector<uint8> receivedData;
+        std::unique_ptr<AssetCache::ReceivedValueFile> receivedData; // streamed into temporary folder
         size_t bytesReceived = 0;
         size_t bytesRemaining = 0;
         uint32 chunksReceived = 0;
@@ -99,7 +101,7 @@ private:
 
         void Reset()
         {
-            receivedData.clear();
+            receivedData.reset();
             bytesReceived = 0;
             bytesRemaining = 0;
             chunksReceived = 0;
@@ -108,22 +110,12 @@ private:
 
     struct AddFilesRequest
     {
-        AddFilesRequest()
-        {
-            serializedData = DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ);
-            Reset();
-        }
-
         void Reset()
         {
-            serializedData->Truncate(0);
-            chunksSent = 0;
-            chunksOverall = 0;
+            chunksAcknowledged = 0;
         }
 
-        ScopedPtr<DynamicMemoryFile> serializedData;
-        uint32 chunksSent = 0;
-        uint32 chunksOverall = 0;
+        uint32 chunksAcknowledged = 0;
     };
 
     struct Stats
@@ -145,6 +137,7 @@ private:
     AssetCache::ClientNetProxy client;
 
     uint64 timeoutMs = 60u * 1000u;
+    Compressor::Type chunksCompression = Compressor::Type::None;
 
     Mutex requestLocker;
     Mutex connectEstablishLocker;
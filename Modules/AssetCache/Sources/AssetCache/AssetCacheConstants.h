@@ -9,6 +9,7 @@ namespace AssetCache
 static const uint32 NET_SERVICE_ID = 0xACCA;
 static const uint16 ASSET_SERVER_PORT = 0xACCA;
 static const uint16 ASSET_SERVER_HTTP_PORT = 0xACCB;
+static const uint32 MAX_CHUNKS_IN_FLIGHT = 4; //chunks which are sent or requested without waiting for previous ones
 
 extern const String& GetLocalHost();
 
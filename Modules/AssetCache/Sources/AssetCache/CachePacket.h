@@ -4,6 +4,7 @@
 #include "AssetCache/CachedItemValue.h"
 #include "AssetCache/AssetCacheConstants.h"
 
+#include <Compression/Compressor.h>
 #include <FileSystem/DynamicMemoryFile.h>
 
 #include <memory>
@@ -17,6 +18,7 @@ struct IChannel;
 
 namespace AssetCache
 {
+class CachedItemValueReader;
 
 #pragma pack(push, 1) // exact fit - no padding
 struct CachePacketHeader
@@ -74,21 +76,33 @@ private:
 };
 
 //////////////////////////////////////////////////////////////////////////
+/**
+    Chunk of serialized CachedItemValue.
+    Chunk data is written into packet right from its source and is compressed if `compression` is Lz4 and compression reduces its size.
+    Received chunk data is always decompressed.
+*/
 class DataChunkPacket : public CachePacket
 {
 public:
     DataChunkPacket(ePacketID packetId);
-    DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression);
+    DataChunkPacket(ePacketID packetId, const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression);
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
 
+private:
+    void WriteChunkInfo(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkDataSize);
+    void WriteChunkData(const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression);
+
 public:
     CacheItemKey key;
     uint64 dataSize = 0;
     uint32 numOfChunks = 0;
     uint32 chunkNumber = 0;
     Vector<uint8> chunkData;
+
+    bool chunkDataIsRead = true; // false if chunk can't be read from its source and packet shouldn't be sent
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -96,7 +110,7 @@ class AddChunkRequestPacket : public DataChunkPacket
 {
 public:
     AddChunkRequestPacket();
-    AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    AddChunkRequestPacket(const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -119,7 +133,7 @@ class GetChunkRequestPacket : public CachePacket
 {
 public:
     GetChunkRequestPacket();
-    GetChunkRequestPacket(const CacheItemKey& key, uint32 chunkNumber);
+    GetChunkRequestPacket(const CacheItemKey& key, uint32 chunkNumber, Compressor::Type compression);
 
 protected:
     bool DeserializeFromBuffer(File* file) override;
@@ -127,6 +141,7 @@ protected:
 public:
     CacheItemKey key;
     uint32 chunkNumber = 0;
+    Compressor::Type compression = Compressor::Type::None; // compression of chunk data requested by client
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -134,7 +149,8 @@ class GetChunkResponsePacket : public DataChunkPacket
 {
 public:
     GetChunkResponsePacket();
-    GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression);
+    GetChunkResponsePacket(const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression);
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -16,6 +16,8 @@ namespace AssetCache
 {
 class CachedItemValue final
 {
+    friend class CachedItemValueReader;
+
     using ValueData = std::shared_ptr<Vector<uint8>>;
     using ValueDataContainer = Map<String, ValueData>;
 
@@ -55,7 +57,7 @@ public:
     void Serialize(KeyedArchive* archieve, bool serializeData) const;
     void Deserialize(KeyedArchive* archieve);
 
-    bool Serialize(File* file) const;
+    bool Serialize(File* file, bool serializeData = true) const;
     bool Deserialize(File* file);
 
     bool operator==(const CachedItemValue& right) const;
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "AssetCache/CachedItemValue.h"
+
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+#include <Functional/Function.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+/**
+    Serialized CachedItemValue, byte to byte the same as written by `CachedItemValue::Serialize(File*)`, which is read by ranges.
+
+    Only description and sizes of value are serialized into memory, data of files is not copied:
+    loaded data of value is read from its shared buffers, not loaded data is read from files in given folder.
+    So chunks of big value are sent without serializing whole value into memory.
+*/
+class CachedItemValueReader final
+{
+public:
+    using Consumer = Function<bool(const uint8* data, uint32 size)>;
+
+    CachedItemValueReader() = default;
+
+    /**
+        Create reader of `value`. Not loaded data of value is read from files in `folder`.
+        If `folder` is empty, not loaded data is serialized as empty, like `CachedItemValue::Serialize` does.
+    */
+    explicit CachedItemValueReader(const CachedItemValue& value, const FilePath& folder = FilePath());
+
+    /** Return false if reader wasn't created from value or files of value are not found in folder. */
+    bool IsValid() const;
+    uint64 GetSize() const;
+
+    /**
+        Pass `size` bytes starting from `offset` to `consumer` by one or several contiguous pieces.
+        Return false if range is out of data, file can't be read or consumer returned false.
+    */
+    bool Read(uint64 offset, uint32 size, const Consumer& consumer) const;
+
+private:
+    struct Segment
+    {
+        uint64 offset = 0;
+        uint64 size = 0;
+        Vector<uint8> bytes; // serialized fields of value
+        std::shared_ptr<Vector<uint8>> data; // loaded data of value
+        FilePath path; // file with not loaded data of value
+    };
+
+    void AppendBytes(const void* bytes, uint32 bytesCount);
+    void AppendString(const String& string);
+    void AppendSegment(Segment&& segment);
+
+    bool ReadSegment(const Segment& segment, uint64 offset, uint32 size, const Consumer& consumer) const;
+
+    Vector<Segment> segments;
+    uint64 size = 0;
+    bool valid = false;
+};
+
+inline bool CachedItemValueReader::IsValid() const
+{
+    return valid;
+}
+
+inline uint64 CachedItemValueReader::GetSize() const
+{
+    return size;
+}
+
+} // end of namespace AssetCache
+} // end of namespace DAVA
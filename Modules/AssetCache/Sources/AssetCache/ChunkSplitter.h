@@ -9,7 +9,13 @@ namespace AssetCache
 namespace ChunkSplitter
 {
 uint32 GetNumberOfChunks(uint64 overallSize);
-Vector<uint8> GetChunk(const Vector<uint8>& dataVector, uint32 chunkNumber);
+uint32 GetMaxChunkSize();
+
+/** Return position of first byte of chunk `chunkNumber` in data. */
+uint64 GetChunkOffset(uint32 chunkNumber);
+
+/** Return size of chunk `chunkNumber` of data with `overallSize` bytes, 0 if there is no such chunk. */
+uint32 GetChunkSize(uint64 overallSize, uint32 chunkNumber);
 }
 } // namespace AssetCache
 } // namespace DAVA
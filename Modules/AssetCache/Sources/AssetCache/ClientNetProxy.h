@@ -4,6 +4,7 @@
 #include "AssetCache/CacheItemKey.h"
 
 #include <Base/BaseTypes.h>
+#include <Compression/Compressor.h>
 #include <Network/IChannel.h>
 #include <Network/Base/AddressResolver.h>
 
@@ -12,6 +13,7 @@ namespace DAVA
 namespace AssetCache
 {
 class CachedItemValue;
+class CachedItemValueReader;
 
 enum class IncorrectPacketType
 {
@@ -51,8 +53,8 @@ public:
 
     // requests to sent on server
     bool RequestServerStatus();
-    bool RequestAddNextChunk(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
-    bool RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber);
+    bool RequestAddNextChunk(const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression);
+    bool RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber, Compressor::Type compression = Compressor::Type::None);
     bool RequestWarmingUp(const CacheItemKey& key);
     bool RequestRemoveData(const CacheItemKey& key);
     bool RequestClearCache();
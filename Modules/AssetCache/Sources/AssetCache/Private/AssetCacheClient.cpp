@@ -1,10 +1,10 @@
 #include "AssetCache/AssetCacheClient.h"
+#include "AssetCache/CachedItemValueReader.h"
 #include "AssetCache/ChunkSplitter.h"
 
 #include <FileSystem/FileSystem.h>
 #include <Concurrency/LockGuard.h>
 #include <Concurrency/Thread.h>
-#include <FileSystem/DynamicMemoryFile.h>
 #include <Time/SystemTimer.h>
 #include <Utils/StringFormat.h>
 #include <Logger/Logger.h>
@@ -34,6 +34,7 @@ AssetCache::Error AssetCacheClient::ConnectSynchronously(const ConnectionParams&
 {
     isActive = true;
     timeoutMs = connectionParams.timeoutms;
+    chunksCompression = connectionParams.chunksCompression;
 
     client.Connect(connectionParams.ip, AssetCache::ASSET_SERVER_PORT);
 
@@ -99,48 +100,55 @@ AssetCache::Error AssetCacheClient::CheckStatusSynchronously()
 
 AssetCache::Error AssetCacheClient::AddToCacheSynchronously(const AssetCache::CacheItemKey& key, const AssetCache::CachedItemValue& value)
 {
-    uint64 dataSizeOverall = 0;
-    uint32 chunksOverall = 0;
+    // chunks are read from buffers of value while sending, whole value isn't serialized into memory
+    AssetCache::CachedItemValueReader reader(value);
+    const uint32 chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(reader.GetSize());
     {
         LockGuard<Mutex> guard(requestLocker);
         request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
         addFilesRequest.Reset();
-        value.Serialize(addFilesRequest.serializedData);
-        dataSizeOverall = addFilesRequest.serializedData->GetSize();
-        chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(dataSizeOverall);
-        addFilesRequest.chunksSent = 0;
     }
 
-    AssetCache::Error resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+    AssetCache::Error resultCode = AssetCache::Error::NO_ERRORS;
 
-    for (uint32 currentChunk = 0; currentChunk < chunksOverall; ++currentChunk)
+    uint32 chunksSent = 0;
+    while (resultCode == AssetCache::Error::NO_ERRORS)
     {
-        Vector<uint8> chunkData;
+        uint32 chunksAcknowledged = 0;
         {
             LockGuard<Mutex> guard(requestLocker);
-            request = Request(AssetCache::PACKET_ADD_CHUNK_REQUEST, key);
-            chunkData = AssetCache::ChunkSplitter::GetChunk(addFilesRequest.serializedData->GetDataVector(), currentChunk);
+            request.recieved = false;
+            chunksAcknowledged = addFilesRequest.chunksAcknowledged;
         }
 
-        resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
-
-        bool requestSent = client.RequestAddNextChunk(key, dataSizeOverall, chunksOverall, currentChunk, chunkData);
-        if (requestSent)
+        if (chunksAcknowledged == chunksOverall)
         {
-            resultCode = WaitRequest();
+            break;
         }
 
+        // keep several chunks in flight to not wait for server response after each of them
+        while (chunksSent < chunksOverall && (chunksSent - chunksAcknowledged) < AssetCache::MAX_CHUNKS_IN_FLIGHT)
         {
-            LockGuard<Mutex> guard(requestLocker);
-            request.Reset();
+            bool requestSent = client.RequestAddNextChunk(key, reader, chunksSent, chunksCompression);
+            if (requestSent == false)
+            {
+                resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+                break;
+            }
+            ++chunksSent;
         }
 
-        if (resultCode != AssetCache::Error::NO_ERRORS)
+        if (resultCode == AssetCache::Error::NO_ERRORS)
         {
-            break;
+            resultCode = WaitRequest();
         }
     }
 
+    {
+        LockGuard<Mutex> guard(requestLocker);
+        request.Reset();
+    }
+
     { //process stats
         ++stats.addRequestsCount;
         switch (resultCode)
@@ -173,63 +181,54 @@ AssetCache::Error AssetCacheClient::RequestFromCacheSynchronously(const AssetCac
 
     AssetCache::Error resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
 
-    bool requestSent = client.RequestGetNextChunk(key, 0);
+    // first chunk tells size of data, so it is requested alone
+    bool requestSent = client.RequestGetNextChunk(key, 0, chunksCompression);
     if (requestSent)
     {
         resultCode = WaitRequest();
     }
 
-    uint32 chunksOverall = 0;
-    {
-        LockGuard<Mutex> guard(requestLocker);
-        request.Reset();
-        chunksOverall = getFilesRequest.chunksOverall;
-    }
-
     if (resultCode == AssetCache::Error::NO_ERRORS)
     {
-        DVASSERT(chunksOverall > 0);
-        for (uint32 currentChunk = 1; currentChunk < chunksOverall; ++currentChunk)
+        uint32 chunksRequested = 1;
+        while (resultCode == AssetCache::Error::NO_ERRORS)
         {
+            uint32 chunksReceived = 0;
+            uint32 chunksOverall = 0;
             {
                 LockGuard<Mutex> guard(requestLocker);
-                request = Request(AssetCache::PACKET_GET_CHUNK_REQUEST, key);
+                request.recieved = false;
+                chunksReceived = getFilesRequest.chunksReceived;
+                chunksOverall = getFilesRequest.chunksOverall;
             }
 
-            resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
-
-            bool requestSent = client.RequestGetNextChunk(key, currentChunk);
-            if (requestSent)
+            DVASSERT(chunksOverall > 0);
+            if (chunksReceived == chunksOverall)
             {
-                resultCode = WaitRequest();
+                break;
             }
 
+            while (chunksRequested < chunksOverall && (chunksRequested - chunksReceived) < AssetCache::MAX_CHUNKS_IN_FLIGHT)
             {
-                LockGuard<Mutex> guard(requestLocker);
-                request.Reset();
+                requestSent = client.RequestGetNextChunk(key, chunksRequested, chunksCompression);
+                if (requestSent == false)
+                {
+                    resultCode = AssetCache::Error::CANNOT_SEND_REQUEST;
+                    break;
+                }
+                ++chunksRequested;
             }
 
-            if (resultCode != AssetCache::Error::NO_ERRORS)
+            if (resultCode == AssetCache::Error::NO_ERRORS)
             {
-                break;
+                resultCode = WaitRequest();
             }
         }
 
         if (resultCode == AssetCache::Error::NO_ERRORS)
         {
             LockGuard<Mutex> guard(requestLocker);
-            if (getFilesRequest.chunksReceived == getFilesRequest.chunksOverall && getFilesRequest.bytesRemaining == 0)
-            {
-                ScopedPtr<DynamicMemoryFile> f(DynamicMemoryFile::Create(std::move(getFilesRequest.receivedData), File::OPEN | File::READ, "receivedData"));
-                value->Deserialize(f);
-
-                const AssetCache::CachedItemValue::Description& description = value->GetDescription();
-                Logger::Info("Data got from cache. Generated %s on machine %s (%s)",
-                             description.creationDate.c_str(),
-                             description.machineName.c_str(),
-                             description.comment.c_str());
-            }
-            else
+            if (getFilesRequest.chunksReceived != getFilesRequest.chunksOverall || getFilesRequest.bytesRemaining != 0)
             {
                 Logger::Error("Packet was not completely transferred. Chunks %u/%u, bytes remaining: %u",
                               getFilesRequest.chunksReceived,
@@ -237,9 +236,29 @@ AssetCache::Error AssetCacheClient::RequestFromCacheSynchronously(const AssetCac
                               getFilesRequest.bytesRemaining);
                 resultCode = AssetCache::Error::CORRUPTED_DATA;
             }
+            else if (getFilesRequest.receivedData->Complete() == false || getFilesRequest.receivedData->Deserialize(*value) == false)
+            {
+                Logger::Error("Received data can't be read from file");
+                resultCode = AssetCache::Error::CORRUPTED_DATA;
+            }
+            else
+            {
+                const AssetCache::CachedItemValue::Description& description = value->GetDescription();
+                Logger::Info("Data got from cache. Generated %s on machine %s (%s)",
+                             description.creationDate.c_str(),
+                             description.machineName.c_str(),
+                             description.comment.c_str());
+            }
+
+            getFilesRequest.receivedData.reset();
         }
     }
 
+    {
+        LockGuard<Mutex> guard(requestLocker);
+        request.Reset();
+    }
+
     { //process stats
         ++stats.getRequestsCount;
         switch (resultCode)
@@ -375,7 +394,14 @@ void AssetCacheClient::OnAddedToCache(const AssetCache::CacheItemKey& key, bool
 
     if ((request.requestID == AssetCache::PACKET_ADD_CHUNK_REQUEST) && request.key == key)
     {
-        request.result = (added) ? AssetCache::Error::NO_ERRORS : AssetCache::Error::SERVER_ERROR;
+        if (added)
+        {
+            ++addFilesRequest.chunksAcknowledged;
+        }
+        else
+        {
+            request.result = AssetCache::Error::SERVER_ERROR;
+        }
         request.recieved = true;
         request.processingRequest = false;
     }
@@ -391,6 +417,12 @@ void AssetCacheClient::OnReceivedFromCache(const AssetCache::CacheItemKey& key,
 
     if (request.requestID == AssetCache::PACKET_GET_CHUNK_REQUEST && request.key == key)
     {
+        if (request.result != AssetCache::Error::NO_ERRORS)
+        {
+            //skip chunks that were requested in advance, because request has already failed
+            return;
+        }
+
         if (getFilesRequest.chunksReceived == 0)
         {
             if (dataSize == 0 || numOfChunks == 0)
@@ -405,7 +437,7 @@ void AssetCacheClient::OnReceivedFromCache(const AssetCache::CacheItemKey& key,
                 request.result = AssetCache::Error::NO_ERRORS;
                 getFilesRequest.chunksOverall = numOfChunks;
                 getFilesRequest.bytesRemaining = static_cast<size_t>(dataSize);
-                getFilesRequest.receivedData.resize(getFilesRequest.bytesRemaining);
+                getFilesRequest.receivedData = std::make_unique<AssetCache::ReceivedValueFile>(FileSystem::Instance()->GetTempDirectoryPath() + "/AssetCache/" + Format("%s_%p.received", key.ToString().c_str(), this));
                 Logger::FrameworkDebug("Received info: %u bytes, %u chunks", dataSize, numOfChunks);
             }
         }
@@ -424,10 +456,14 @@ void AssetCacheClient::OnReceivedFromCache(const AssetCache::CacheItemKey& key,
             Logger::Error("Chunk #%u size is too big. Remaining bytes: %u, received chunk size: ", chunkNumber, getFilesRequest.bytesRemaining, chunkData.size());
             request.result = AssetCache::Error::WRONG_CHUNK;
         }
+        else if (getFilesRequest.receivedData->Append(chunkData.data(), static_cast<uint32>(chunkData.size())) == false)
+        {
+            Logger::Error("Chunk #%u can't be written into file", chunkNumber);
+            request.result = AssetCache::Error::CORRUPTED_DATA;
+        }
         else
         {
             request.result = AssetCache::Error::NO_ERRORS;
-            Memcpy(getFilesRequest.receivedData.data() + getFilesRequest.bytesReceived, chunkData.data(), chunkData.size());
             getFilesRequest.bytesReceived += chunkData.size();
             getFilesRequest.bytesRemaining -= chunkData.size();
             ++(getFilesRequest.chunksReceived);
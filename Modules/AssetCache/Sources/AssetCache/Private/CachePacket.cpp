@@ -1,5 +1,8 @@
 #include "AssetCache/CachePacket.h"
+#include "AssetCache/CachedItemValueReader.h"
+#include "AssetCache/ChunkSplitter.h"
 
+#include <Compression/LZ4Compressor.h>
 #include <FileSystem/DynamicMemoryFile.h>
 #include <Network/IChannel.h>
 #include <Logger/Logger.h>
@@ -9,7 +12,7 @@ namespace DAVA
 namespace AssetCache
 {
 const uint16 PACKET_HEADER = 0xACCA;
-const uint8 PACKET_VERSION = 3;
+const uint8 PACKET_VERSION = 4;
 
 Map<const uint8*, ScopedPtr<DynamicMemoryFile>> CachePacket::sendingPackets;
 
@@ -39,6 +42,33 @@ bool ReadFromBuffer(File* buffer, Vector<uint8>& data, uint32 dataSize)
         return true;
     }
 };
+
+bool ReadChunkData(File* buffer, Vector<uint8>& data, uint32 dataSize, Compressor::Type compression, uint32 packedSize)
+{
+    if (dataSize > ChunkSplitter::GetMaxChunkSize())
+    {
+        return false;
+    }
+
+    if (compression == Compressor::Type::None)
+    {
+        return (packedSize == dataSize) && ReadFromBuffer(buffer, data, dataSize);
+    }
+    else if (compression == Compressor::Type::Lz4)
+    {
+        Vector<uint8> packed;
+        if (packedSize >= dataSize || !ReadFromBuffer(buffer, packed, packedSize))
+        {
+            return false;
+        }
+
+        data.resize(dataSize);
+        return LZ4Compressor().Decompress(packed, data);
+    }
+
+    Logger::Error("[CachePacket::%s] Unsupported chunk compression: %u", __FUNCTION__, static_cast<uint32>(compression));
+    return false;
+}
 }
 
 bool CachePacket::SendTo(std::shared_ptr<Net::IChannel> channel)
@@ -155,28 +185,97 @@ void CachePacket::WriteHeader(File* file) const
 }
 
 //////////////////////////////////////////////////////////////////////////
-DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
+DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression)
     : CachePacket(packetId, CREATE_SENDING_BUFFER)
 {
     WriteHeader(serializationBuffer);
+    WriteChunkInfo(key, dataSize, numOfChunks, chunkNumber, chunkDataSize);
+    WriteChunkData(chunkData, chunkDataSize, compression);
+}
+
+DataChunkPacket::DataChunkPacket(ePacketID packetId, const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression)
+    : CachePacket(packetId, CREATE_SENDING_BUFFER)
+{
+    const uint64 chunkOffset = ChunkSplitter::GetChunkOffset(chunkNumber);
+    const uint32 chunkDataSize = ChunkSplitter::GetChunkSize(reader.GetSize(), chunkNumber);
+
+    WriteHeader(serializationBuffer);
+    WriteChunkInfo(key, reader.GetSize(), ChunkSplitter::GetNumberOfChunks(reader.GetSize()), chunkNumber, chunkDataSize);
+
+    if (compression == Compressor::Type::None)
+    {
+        // data goes from reader right into sending buffer
+        uint8 compressionId = static_cast<uint8>(compression);
+        serializationBuffer->Write(&compressionId, sizeof(compressionId));
+        serializationBuffer->Write(&chunkDataSize, sizeof(chunkDataSize));
+
+        chunkDataIsRead = reader.Read(chunkOffset, chunkDataSize, [this](const uint8* data, uint32 size)
+                                      {
+                                          return serializationBuffer->Write(data, size) == size;
+                                      });
+    }
+    else
+    {
+        // compressor needs whole chunk in contiguous buffer
+        Vector<uint8> chunk;
+        chunk.reserve(chunkDataSize);
+        chunkDataIsRead = reader.Read(chunkOffset, chunkDataSize, [&chunk](const uint8* data, uint32 size)
+                                      {
+                                          chunk.insert(chunk.end(), data, data + size);
+                                          return true;
+                                      });
+
+        WriteChunkData(chunk.data(), static_cast<uint32>(chunk.size()), compression);
+    }
+}
+
+DataChunkPacket::DataChunkPacket(ePacketID packetId)
+    : CachePacket(packetId, DO_NOT_CREATE_SENDING_BUFFER)
+{
+}
 
+void DataChunkPacket::WriteChunkInfo(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, uint32 chunkDataSize)
+{
     uint32 keySize = static_cast<uint32>(key.size());
-    uint32 chunkDataSize = static_cast<uint32>(chunkData.size());
 
     serializationBuffer->Write(key.data(), keySize);
     serializationBuffer->Write(&dataSize, sizeof(dataSize));
     serializationBuffer->Write(&numOfChunks, sizeof(numOfChunks));
     serializationBuffer->Write(&chunkNumber, sizeof(chunkNumber));
     serializationBuffer->Write(&chunkDataSize, sizeof(chunkDataSize));
-    if (chunkDataSize > 0)
-    {
-        serializationBuffer->Write(chunkData.data(), chunkDataSize);
-    }
 }
 
-DataChunkPacket::DataChunkPacket(ePacketID packetId)
-    : CachePacket(packetId, DO_NOT_CREATE_SENDING_BUFFER)
+void DataChunkPacket::WriteChunkData(const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression)
 {
+    DVASSERT(compression == Compressor::Type::None || compression == Compressor::Type::Lz4);
+
+    Vector<uint8> packed;
+    if (compression == Compressor::Type::Lz4 && chunkDataSize > 0)
+    {
+        Vector<uint8> chunk(chunkData, chunkData + chunkDataSize);
+        bool compressed = LZ4Compressor().Compress(chunk, packed);
+        if (compressed && packed.size() < chunkDataSize)
+        {
+            chunkData = packed.data();
+            chunkDataSize = static_cast<uint32>(packed.size());
+        }
+        else
+        {
+            compression = Compressor::Type::None;
+        }
+    }
+    else
+    {
+        compression = Compressor::Type::None;
+    }
+
+    uint8 compressionId = static_cast<uint8>(compression);
+    serializationBuffer->Write(&compressionId, sizeof(compressionId));
+    serializationBuffer->Write(&chunkDataSize, sizeof(chunkDataSize));
+    if (chunkDataSize > 0)
+    {
+        serializationBuffer->Write(chunkData, chunkDataSize);
+    }
 }
 
 bool DataChunkPacket::DeserializeFromBuffer(File* buffer)
@@ -184,17 +283,21 @@ bool DataChunkPacket::DeserializeFromBuffer(File* buffer)
     using namespace CachePacketDetails;
 
     uint32 chunkDataSize = 0;
+    uint8 compressionId = 0;
+    uint32 packedSize = 0;
     return (ReadFromBuffer(buffer, key)
             && ReadFromBuffer(buffer, dataSize)
             && ReadFromBuffer(buffer, numOfChunks)
             && ReadFromBuffer(buffer, chunkNumber)
             && ReadFromBuffer(buffer, chunkDataSize)
-            && ReadFromBuffer(buffer, chunkData, chunkDataSize));
+            && ReadFromBuffer(buffer, compressionId)
+            && ReadFromBuffer(buffer, packedSize)
+            && ReadChunkData(buffer, chunkData, chunkDataSize, static_cast<Compressor::Type>(compressionId), packedSize));
 }
 
 //////////////////////////////////////////////////////////////////////////
-AddChunkRequestPacket::AddChunkRequestPacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
-    : DataChunkPacket(PACKET_ADD_CHUNK_REQUEST, key, dataSize, numOfChunks, chunkNumber, chunkData)
+AddChunkRequestPacket::AddChunkRequestPacket(const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression)
+    : DataChunkPacket(PACKET_ADD_CHUNK_REQUEST, key, reader, chunkNumber, compression)
 {
 }
 
@@ -225,13 +328,15 @@ bool AddResponsePacket::DeserializeFromBuffer(File* file)
 }
 
 //////////////////////////////////////////////////////////////////////////
-GetChunkRequestPacket::GetChunkRequestPacket(const CacheItemKey& key_, uint32 chunkNumber)
+GetChunkRequestPacket::GetChunkRequestPacket(const CacheItemKey& key_, uint32 chunkNumber, Compressor::Type compression)
     : CachePacket(PACKET_GET_CHUNK_REQUEST, CREATE_SENDING_BUFFER)
 {
     WriteHeader(serializationBuffer);
 
+    uint8 compressionId = static_cast<uint8>(compression);
     serializationBuffer->Write(key_.data(), static_cast<uint32>(key_.size()));
     serializationBuffer->Write(&chunkNumber, sizeof(chunkNumber));
+    serializationBuffer->Write(&compressionId, sizeof(compressionId));
 }
 
 GetChunkRequestPacket::GetChunkRequestPacket()
@@ -242,12 +347,25 @@ GetChunkRequestPacket::GetChunkRequestPacket()
 bool GetChunkRequestPacket::DeserializeFromBuffer(File* buffer)
 {
     using namespace CachePacketDetails;
-    return ReadFromBuffer(buffer, key) && ReadFromBuffer(buffer, chunkNumber);
+
+    uint8 compressionId = 0;
+    if (ReadFromBuffer(buffer, key) && ReadFromBuffer(buffer, chunkNumber) && ReadFromBuffer(buffer, compressionId))
+    {
+        compression = static_cast<Compressor::Type>(compressionId);
+        return true;
+    }
+
+    return false;
 }
 
 //////////////////////////////////////////////////////////////////////////
-GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
-    : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE, key, dataSize, numOfChunks, chunkNumber, chunkData)
+GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression)
+    : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE, key, dataSize, numOfChunks, chunkNumber, chunkData, chunkDataSize, compression)
+{
+}
+
+GetChunkResponsePacket::GetChunkResponsePacket(const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression)
+    : DataChunkPacket(PACKET_GET_CHUNK_RESPONSE, key, reader, chunkNumber, compression)
 {
 }
 
@@ -0,0 +1,155 @@
+#include "AssetCache/CachedItemValueReader.h"
+
+#include <Debug/DVAssert.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+CachedItemValueReader::CachedItemValueReader(const CachedItemValue& value, const FilePath& folder)
+{
+    AppendBytes(&value.size, sizeof(value.size));
+
+    uint64 count = value.dataContainer.size();
+    AppendBytes(&count, sizeof(count));
+
+    for (const auto& entry : value.dataContainer)
+    {
+        AppendString(entry.first);
+
+        Segment segment;
+        if (value.IsDataLoaded(entry.second))
+        {
+            segment.data = entry.second;
+            segment.size = entry.second->size();
+        }
+        else if (!folder.IsEmpty())
+        {
+            segment.path = folder + entry.first;
+            if (!FileSystem::Instance()->GetFileSize(segment.path, segment.size))
+            {
+                Logger::Error("[CachedItemValueReader::%s] Cannot get size of %s", __FUNCTION__, segment.path.GetStringValue().c_str());
+                return;
+            }
+        }
+
+        uint32 dataSize = static_cast<uint32>(segment.size);
+        AppendBytes(&dataSize, sizeof(dataSize));
+        if (dataSize > 0)
+        {
+            AppendSegment(std::move(segment));
+        }
+    }
+
+    //Description
+    AppendString(value.description.machineName);
+    AppendString(value.description.creationDate);
+    AppendString(value.description.addingChain);
+    AppendString(value.description.receivingChain);
+    AppendString(value.description.comment);
+
+    //Validation
+    AppendBytes(&value.validationDetails.filesCount, sizeof(value.validationDetails.filesCount));
+    AppendBytes(&value.validationDetails.filesDataSize, sizeof(value.validationDetails.filesDataSize));
+
+    valid = true;
+}
+
+void CachedItemValueReader::AppendBytes(const void* bytes, uint32 bytesCount)
+{
+    if (segments.empty() || segments.back().bytes.empty())
+    {
+        Segment segment;
+        segment.offset = size;
+        segments.push_back(std::move(segment));
+    }
+
+    Segment& segment = segments.back();
+    const uint8* begin = static_cast<const uint8*>(bytes);
+    segment.bytes.insert(segment.bytes.end(), begin, begin + bytesCount);
+    segment.size += bytesCount;
+    size += bytesCount;
+}
+
+void CachedItemValueReader::AppendString(const String& string)
+{
+    // with terminating null, as File::WriteString does
+    AppendBytes(string.c_str(), static_cast<uint32>(string.length() + 1));
+}
+
+void CachedItemValueReader::AppendSegment(Segment&& segment)
+{
+    segment.offset = size;
+    size += segment.size;
+    segments.push_back(std::move(segment));
+}
+
+bool CachedItemValueReader::Read(uint64 offset, uint32 readSize, const Consumer& consumer) const
+{
+    DVASSERT(valid);
+
+    if (offset + readSize > size)
+    {
+        return false;
+    }
+
+    auto it = std::upper_bound(segments.begin(), segments.end(), offset, [](uint64 position, const Segment& segment)
+                               {
+                                   return position < segment.offset;
+                               });
+    DVASSERT(it != segments.begin());
+    --it;
+
+    while (readSize > 0)
+    {
+        DVASSERT(it != segments.end());
+
+        const Segment& segment = *it;
+        uint64 segmentOffset = offset - segment.offset;
+        uint32 segmentReadSize = static_cast<uint32>(std::min(static_cast<uint64>(readSize), segment.size - segmentOffset));
+        if (!ReadSegment(segment, segmentOffset, segmentReadSize, consumer))
+        {
+            return false;
+        }
+
+        offset += segmentReadSize;
+        readSize -= segmentReadSize;
+        ++it;
+    }
+
+    return true;
+}
+
+bool CachedItemValueReader::ReadSegment(const Segment& segment, uint64 offset, uint32 readSize, const Consumer& consumer) const
+{
+    if (!segment.bytes.empty())
+    {
+        return consumer(segment.bytes.data() + offset, readSize);
+    }
+    else if (segment.data)
+    {
+        return consumer(segment.data->data() + offset, readSize);
+    }
+
+    ScopedPtr<File> file(File::Create(segment.path, File::OPEN | File::READ));
+    if (!file || !file->Seek(offset, File::SEEK_FROM_START))
+    {
+        Logger::Error("[CachedItemValueReader::%s] Cannot open %s", __FUNCTION__, segment.path.GetStringValue().c_str());
+        return false;
+    }
+
+    Vector<uint8> buffer(readSize);
+    if (file->Read(buffer.data(), readSize) != readSize)
+    {
+        Logger::Error("[CachedItemValueReader::%s] Cannot read %u bytes from %s", __FUNCTION__, readSize, segment.path.GetStringValue().c_str());
+        return false;
+    }
+
+    return consumer(buffer.data(), readSize);
+}
+
+} // end of namespace AssetCache
+} // end of namespace DAVA
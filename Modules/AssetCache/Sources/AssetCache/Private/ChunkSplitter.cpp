@@ -13,17 +13,26 @@ uint32 GetNumberOfChunks(uint64 overallSize)
     return static_cast<uint32>((overallSize + CHUNK_SIZE_IN_BYTES - 1) / CHUNK_SIZE_IN_BYTES);
 }
 
-Vector<uint8> GetChunk(const Vector<uint8>& dataVector, uint32 chunkNumber)
+uint32 GetMaxChunkSize()
 {
-    size_t firstByte = static_cast<size_t>(chunkNumber * CHUNK_SIZE_IN_BYTES);
-    if (firstByte < dataVector.size())
+    return CHUNK_SIZE_IN_BYTES;
+}
+
+uint64 GetChunkOffset(uint32 chunkNumber)
+{
+    return static_cast<uint64>(chunkNumber) * CHUNK_SIZE_IN_BYTES;
+}
+
+uint32 GetChunkSize(uint64 overallSize, uint32 chunkNumber)
+{
+    uint64 firstByte = GetChunkOffset(chunkNumber);
+    if (firstByte < overallSize)
     {
-        size_t beyondLastByte = std::min(dataVector.size(), static_cast<size_t>(firstByte + CHUNK_SIZE_IN_BYTES));
-        return Vector<uint8>(dataVector.begin() + firstByte, dataVector.begin() + beyondLastByte);
+        return static_cast<uint32>(std::min(overallSize - firstByte, static_cast<uint64>(CHUNK_SIZE_IN_BYTES)));
     }
     else
     {
-        return Vector<uint8>();
+        return 0;
     }
 }
 }
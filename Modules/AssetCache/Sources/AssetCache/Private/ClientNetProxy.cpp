@@ -1,6 +1,7 @@
 #include "AssetCache/ClientNetProxy.h"
 #include "AssetCache/AssetCacheConstants.h"
 #include "AssetCache/CachedItemValue.h"
+#include "AssetCache/CachedItemValueReader.h"
 #include "AssetCache/CachePacket.h"
 
 #include <NetworkHelpers/ResolverCallbackDispatched.h>
@@ -96,24 +97,24 @@ bool ClientNetProxy::RequestServerStatus()
     return false;
 }
 
-bool ClientNetProxy::RequestAddNextChunk(const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
+bool ClientNetProxy::RequestAddNextChunk(const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression)
 {
     if (openedChannel)
     {
         //Logger::FrameworkDebug("Requesting to add next chunk");
-        AddChunkRequestPacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData);
-        return packet.SendTo(openedChannel);
+        AddChunkRequestPacket packet(key, reader, chunkNumber, compression);
+        return packet.chunkDataIsRead && packet.SendTo(openedChannel);
     }
 
     return false;
 }
 
-bool ClientNetProxy::RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber)
+bool ClientNetProxy::RequestGetNextChunk(const CacheItemKey& key, uint32 chunkNumber, Compressor::Type compression)
 {
     //Logger::FrameworkDebug("Requesting chunk #%u", chunkNumber);
     if (openedChannel)
     {
-        GetChunkRequestPacket packet(key, chunkNumber);
+        GetChunkRequestPacket packet(key, chunkNumber, compression);
         return packet.SendTo(openedChannel);
     }
 
@@ -0,0 +1,94 @@
+#include "AssetCache/ReceivedValueFile.h"
+
+#include <Debug/DVAssert.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+ReceivedValueFile::ReceivedValueFile(const FilePath& path_)
+    : path(path_)
+    , tmpPath(path_.GetAbsolutePathname() + ".tmp")
+{
+    FileSystem::Instance()->CreateDirectory(path.GetDirectory(), true);
+    writer.reset(File::Create(tmpPath, File::CREATE | File::WRITE));
+    if (!writer)
+    {
+        Logger::Error("[ReceivedValueFile::%s] Cannot create file %s", __FUNCTION__, tmpPath.GetStringValue().c_str());
+    }
+}
+
+ReceivedValueFile::~ReceivedValueFile()
+{
+    writer.reset();
+    FileSystem::Instance()->DeleteFile(GetCurrentPath());
+}
+
+bool ReceivedValueFile::Append(const void* data, uint32 dataSize)
+{
+    DVASSERT(completed == false);
+
+    if (!writer || writer->Write(data, dataSize) != dataSize)
+    {
+        return false;
+    }
+
+    size += dataSize;
+    return true;
+}
+
+bool ReceivedValueFile::Read(uint64 offset, uint32 dataSize, Vector<uint8>& data)
+{
+    if (offset + dataSize > size)
+    {
+        return false;
+    }
+
+    if (writer)
+    {
+        writer->Flush();
+    }
+
+    ScopedPtr<File> reader(File::Create(GetCurrentPath(), File::OPEN | File::READ));
+    if (!reader || !reader->Seek(static_cast<int64>(offset), File::SEEK_FROM_START))
+    {
+        return false;
+    }
+
+    data.resize(dataSize);
+    return reader->Read(data.data(), dataSize) == dataSize;
+}
+
+bool ReceivedValueFile::Complete()
+{
+    DVASSERT(completed == false);
+
+    if (!writer)
+    {
+        return false;
+    }
+
+    writer.reset();
+    if (!FileSystem::Instance()->MoveFile(tmpPath, path, true))
+    {
+        Logger::Error("[ReceivedValueFile::%s] Cannot rename %s", __FUNCTION__, tmpPath.GetStringValue().c_str());
+        FileSystem::Instance()->DeleteFile(tmpPath);
+        return false;
+    }
+
+    completed = true;
+    return true;
+}
+
+bool ReceivedValueFile::Deserialize(CachedItemValue& value) const
+{
+    DVASSERT(completed);
+
+    ScopedPtr<File> reader(File::Create(path, File::OPEN | File::READ));
+    return reader && value.Deserialize(reader);
+}
+
+} // end of namespace AssetCache
+} // end of namespace DAVA
@@ -1,6 +1,7 @@
 #include "AssetCache/ServerNetProxy.h"
 #include "AssetCache/AssetCacheConstants.h"
 #include "AssetCache/CachedItemValue.h"
+#include "AssetCache/CachedItemValueReader.h"
 #include "AssetCache/CachePacket.h"
 
 #include <Debug/DVAssert.h>
@@ -64,7 +65,7 @@ void ServerNetProxy::OnPacketReceived(const std::shared_ptr<Net::IChannel>& chan
             case PACKET_GET_CHUNK_REQUEST:
             {
                 GetChunkRequestPacket* p = static_cast<GetChunkRequestPacket*>(packet.get());
-                listener->OnChunkRequestedFromCache(channel, p->key, p->chunkNumber);
+                listener->OnChunkRequestedFromCache(channel, p->key, p->chunkNumber, p->compression);
                 return;
             }
             case PACKET_REMOVE_REQUEST:
@@ -149,17 +150,28 @@ bool ServerNetProxy::SendCleared(const std::shared_ptr<Net::IChannel>& channel,
     return false;
 }
 
-bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData)
+bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression)
 {
     if (channel)
     {
-        GetChunkResponsePacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData);
+        GetChunkResponsePacket packet(key, dataSize, numOfChunks, chunkNumber, chunkData, chunkDataSize, compression);
         return packet.SendTo(channel);
     }
 
     return false;
 }
 
+bool ServerNetProxy::SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression)
+{
+    if (channel)
+    {
+        GetChunkResponsePacket packet(key, reader, chunkNumber, compression);
+        return packet.chunkDataIsRead && packet.SendTo(channel);
+    }
+
+    return false;
+}
+
 bool ServerNetProxy::SendStatus(const std::shared_ptr<Net::IChannel>& channel)
 {
     if (channel)
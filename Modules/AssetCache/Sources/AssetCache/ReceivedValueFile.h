@@ -0,0 +1,77 @@
+#pragma once
+
+#include "AssetCache/CachedItemValue.h"
+
+#include <Base/BaseTypes.h>
+#include <Base/ScopedPtr.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FilePath.h>
+
+namespace DAVA
+{
+namespace AssetCache
+{
+/**
+    Serialized CachedItemValue received by chunks, which is streamed into file instead of memory.
+
+    Chunks are appended to temporary file `<path>.tmp`, which is renamed into `path` when all data is received,
+    so incomplete data is never found at `path`. Received file is deleted on destruction.
+*/
+class ReceivedValueFile final
+{
+public:
+    explicit ReceivedValueFile(const FilePath& path);
+    ~ReceivedValueFile();
+
+    ReceivedValueFile(const ReceivedValueFile&) = delete;
+    ReceivedValueFile& operator=(const ReceivedValueFile&) = delete;
+
+    /** Return false if temporary file can't be created. */
+    bool IsValid() const;
+    uint64 GetSize() const;
+    bool IsCompleted() const;
+
+    /** Append chunk to the end of received data. */
+    bool Append(const void* data, uint32 size);
+
+    /** Read `size` bytes starting from `offset` of already received data into `data`. */
+    bool Read(uint64 offset, uint32 size, Vector<uint8>& data);
+
+    /** Close temporary file and rename it into final file. */
+    bool Complete();
+
+    /** Deserialize value from completed file. */
+    bool Deserialize(CachedItemValue& value) const;
+
+private:
+    const FilePath& GetCurrentPath() const;
+
+    FilePath path;
+    FilePath tmpPath;
+    ScopedPtr<File> writer;
+    uint64 size = 0;
+    bool completed = false;
+};
+
+inline bool ReceivedValueFile::IsValid() const
+{
+    return completed || writer;
+}
+
+inline uint64 ReceivedValueFile::GetSize() const
+{
+    return size;
+}
+
+inline bool ReceivedValueFile::IsCompleted() const
+{
+    return completed;
+}
+
+inline const FilePath& ReceivedValueFile::GetCurrentPath() const
+{
+    return completed ? path : tmpPath;
+}
+
+} // end of namespace AssetCache
+} // end of namespace DAVA
@@ -6,6 +6,7 @@
 #include "AssetCache/CacheItemKey.h"
 
 #include <Base/BaseTypes.h>
+#include <Compression/Compressor.h>
 #include <Network/IChannel.h>
 
 namespace DAVA
@@ -13,6 +14,7 @@ namespace DAVA
 namespace AssetCache
 {
 class CachedItemValue;
+class CachedItemValueReader;
 
 class ServerNetProxyListener
 {
@@ -20,7 +22,7 @@ public:
     virtual ~ServerNetProxyListener() = default;
 
     virtual void OnAddChunkToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData) = 0;
-    virtual void OnChunkRequestedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint32 chunkNumber) = 0;
+    virtual void OnChunkRequestedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint32 chunkNumber, Compressor::Type compression) = 0;
     virtual void OnRemoveFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key) = 0;
     virtual void OnClearCache(const std::shared_ptr<Net::IChannel>& channel) = 0;
     virtual void OnWarmingUp(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key) = 0;
@@ -46,7 +48,8 @@ public:
     bool SendAddedToCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool added);
     bool SendRemovedFromCache(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, bool removed);
     bool SendCleared(const std::shared_ptr<Net::IChannel>& channel, bool cleared);
-    bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const Vector<uint8>& chunkData);
+    bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, uint64 dataSize, uint32 numOfChunks, uint32 chunkNumber, const uint8* chunkData, uint32 chunkDataSize, Compressor::Type compression);
+    bool SendChunk(const std::shared_ptr<Net::IChannel>& channel, const CacheItemKey& key, const CachedItemValueReader& reader, uint32 chunkNumber, Compressor::Type compression);
     bool SendStatus(const std::shared_ptr<Net::IChannel>& channel);
 
     //Net::IChannelListener
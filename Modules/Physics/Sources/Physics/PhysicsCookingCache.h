@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+#include <Utils/MD5.h>
+
+namespace DAVA
+{
+/**
+    On-disk cache of cooked PhysX geometry (triangle meshes, convex hulls and height fields).
+
+    Cooked data is keyed by hash of cooking input, so cache doesn't depend on addresses of geometry objects
+    and can be built offline (e.g. by ResourceEditor into project Data folder) and shipped with resources.
+    Cache is searched in read-only folders first, newly cooked geometry is saved into writable folder.
+    Writable folder is limited by size: when it grows over the limit, entries not used since cache creation are evicted.
+*/
+class PhysicsCookingCache final
+{
+public:
+    enum eGeometryType : uint32
+    {
+        TRIANGLE_MESH = 0,
+        CONVEX_MESH,
+        HEIGHT_FIELD
+    };
+
+    /** Accumulates cooking input into cache key. */
+    class KeyBuilder
+    {
+    public:
+        KeyBuilder(eGeometryType type);
+
+        void Add(const void* data, size_t size);
+        template <typename T>
+        void Add(const Vector<T>& data);
+
+        MD5::MD5Digest GetKey();
+
+    private:
+        MD5 md5;
+    };
+
+    PhysicsCookingCache();
+
+    void SetReadOnlyFolders(const Vector<FilePath>& folders);
+    const Vector<FilePath>& GetReadOnlyFolders() const;
+
+    /** Set folder to save newly cooked geometry into. Empty path disables saving. */
+    void SetWritableFolder(const FilePath& folder);
+    const FilePath& GetWritableFolder() const;
+
+    /** Set size limit of writable folder in bytes. Zero disables eviction. */
+    void SetWritableFolderLimit(uint64 limit);
+    uint64 GetWritableFolderLimit() const;
+
+    bool Load(const MD5::MD5Digest& key, Vector<uint8>& cookedData) const;
+    void Save(const MD5::MD5Digest& key, const uint8* cookedData, uint32 size) const;
+
+    /** Delete entries of writable folder which were neither loaded nor saved since cache creation. Returns count of deleted entries. */
+    uint32 RemoveUnusedEntries() const;
+
+private:
+    bool LoadFromFolder(const FilePath& folder, const MD5::MD5Digest& key, Vector<uint8>& cookedData) const;
+    void EvictUnusedEntries() const;
+    bool IsUsedEntry(const FilePath& path) const;
+
+    Vector<FilePath> readOnlyFolders;
+    FilePath writableFolder;
+    uint64 writableFolderLimit = 0;
+    mutable UnorderedSet<String> usedKeys;
+};
+
+template <typename T>
+void PhysicsCookingCache::KeyBuilder::Add(const Vector<T>& data)
+{
+    Add(data.data(), data.size() * sizeof(T));
+}
+
+inline const Vector<FilePath>& PhysicsCookingCache::GetReadOnlyFolders() const
+{
+    return readOnlyFolders;
+}
+
+inline const FilePath& PhysicsCookingCache::GetWritableFolder() const
+{
+    return writableFolder;
+}
+
+inline uint64 PhysicsCookingCache::GetWritableFolderLimit() const
+{
+    return writableFolderLimit;
+}
+} // namespace DAVA
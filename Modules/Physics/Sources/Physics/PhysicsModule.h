@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Physics/PhysicsConfigs.h"
+#include "Physics/PhysicsCookingCache.h"
 
 #include <ModuleManager/IModule.h>
 #include <ModuleManager/ModuleManager.h>
@@ -8,6 +9,7 @@
 #include <Math/Vector.h>
 #include <Base/BaseTypes.h>
 #include <Base/Type.h>
+#include <Functional/Function.h>
 
 #include <physx/PxFiltering.h>
 
@@ -23,6 +25,7 @@ class PxMaterial;
 class PxSimulationEventCallback;
 class PxDefaultCpuDispatcher;
 class PxAllocatorCallback;
+class PxOutputStream;
 }
 
 namespace DAVA
@@ -31,6 +34,7 @@ class PolygonGroup;
 class Landscape;
 class PhysicsGeometryCache;
 class PhysicsVehiclesSubsystem;
+class PhysicsJobDispatcher;
 struct Matrix4;
 
 class PhysicsModule : public IModule
@@ -69,7 +73,12 @@ public:
 
     physx::PxAllocatorCallback* GetAllocator() const;
 
+    /** On-disk cache of cooked meshes and height fields. */
+    PhysicsCookingCache* GetCookingCache() const;
+
 private:
+    bool GetCookedData(const MD5::MD5Digest& key, const Function<bool(physx::PxOutputStream&)>& cook, Vector<uint8>& cookedData) const;
+
     void LazyLoadMaterials() const;
     void LoadMaterials();
 
@@ -77,8 +86,10 @@ private:
     physx::PxFoundation* foundation = nullptr;
     physx::PxPhysics* physics = nullptr;
     physx::PxCooking* cooking = nullptr;
+    PhysicsCookingCache* cookingCache = nullptr;
 
-    mutable physx::PxDefaultCpuDispatcher* cpuDispatcher = nullptr;
+    mutable PhysicsJobDispatcher* jobDispatcher = nullptr;
+    mutable physx::PxDefaultCpuDispatcher* defaultCpuDispatcher = nullptr; // used if engine job system isn't available
     physx::PxMaterial* defaultMaterial = nullptr;
     UnorderedMap<FastName, physx::PxMaterial*> materials;
 
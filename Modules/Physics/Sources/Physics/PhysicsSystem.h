@@ -50,6 +50,17 @@ public:
     void SetDebugDrawEnabled(bool drawDebugInfo);
     bool IsDebugDrawEnabled() const;
 
+    /**
+        If enabled, simulation started in Process runs in parallel with the rest of scene systems
+        and its results are fetched at the end of Scene::Update, so every frame makes a simulation step.
+        Otherwise results are fetched at the beginning of next Process and step is skipped if simulation isn't finished yet.
+    */
+    void SetLateFetchEnabled(bool enabled);
+    bool IsLateFetchEnabled() const;
+
+    /** Called by Scene after all systems are processed. */
+    void ProcessLateFetch();
+
     void ScheduleUpdate(PhysicsComponent* component);
     void ScheduleUpdate(CollisionShapeComponent* component);
     void ScheduleUpdate(CharacterControllerComponent* component);
@@ -102,6 +113,7 @@ private:
 
     bool isSimulationEnabled = true;
     bool isSimulationRunning = false;
+    bool isLateFetchEnabled = false;
     physx::PxScene* physicsScene = nullptr;
     physx::PxControllerManager* controllerManager = nullptr;
     PhysicsGeometryCache* geometryCache = nullptr;
@@ -0,0 +1,226 @@
+#include "Physics/PhysicsCookingCache.h"
+
+#include <Debug/DVAssert.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Utils/CRC32.h>
+
+#include <physx/PxPhysicsVersion.h>
+
+namespace DAVA
+{
+namespace PhysicsCookingCacheDetail
+{
+// Increase when cooking parameters are changed to invalidate cooked geometry
+const uint32 COOKING_VERSION = 1;
+
+const uint32 FILE_SIGNATURE = DAVA_MAKEFOURCC('P', 'X', 'C', 'C');
+const char* FILE_EXTENSION = ".pxcooked";
+
+// Limit of cache in ~doc:, it is filled only by geometry which isn't shipped with resources
+const uint64 DEFAULT_WRITABLE_FOLDER_LIMIT = 64 * 1024 * 1024;
+
+struct FileHeader
+{
+    uint32 signature = FILE_SIGNATURE;
+    uint32 dataSize = 0;
+    uint32 dataCrc = 0;
+};
+
+FilePath GetCachePath(const FilePath& folder, const MD5::MD5Digest& key)
+{
+    return folder + (MD5::HashToString(key) + FILE_EXTENSION);
+}
+}
+
+PhysicsCookingCache::KeyBuilder::KeyBuilder(eGeometryType type)
+{
+    const uint32 header[] = { PhysicsCookingCacheDetail::COOKING_VERSION, PX_PHYSICS_VERSION, type };
+
+    md5.Init();
+    Add(header, sizeof(header));
+}
+
+void PhysicsCookingCache::KeyBuilder::Add(const void* data, size_t size)
+{
+    md5.Update(static_cast<const uint8*>(data), static_cast<uint32>(size));
+}
+
+MD5::MD5Digest PhysicsCookingCache::KeyBuilder::GetKey()
+{
+    md5.Final();
+    return md5.GetDigest();
+}
+
+PhysicsCookingCache::PhysicsCookingCache()
+    : readOnlyFolders({ FilePath("~res:/PhysicsCache/") })
+    , writableFolder("~doc:/PhysicsCache/")
+    , writableFolderLimit(PhysicsCookingCacheDetail::DEFAULT_WRITABLE_FOLDER_LIMIT)
+{
+}
+
+void PhysicsCookingCache::SetReadOnlyFolders(const Vector<FilePath>& folders)
+{
+    readOnlyFolders = folders;
+}
+
+void PhysicsCookingCache::SetWritableFolder(const FilePath& folder)
+{
+    writableFolder = folder;
+}
+
+void PhysicsCookingCache::SetWritableFolderLimit(uint64 limit)
+{
+    writableFolderLimit = limit;
+}
+
+bool PhysicsCookingCache::Load(const MD5::MD5Digest& key, Vector<uint8>& cookedData) const
+{
+    usedKeys.insert(MD5::HashToString(key));
+
+    for (const FilePath& folder : readOnlyFolders)
+    {
+        if (LoadFromFolder(folder, key, cookedData))
+        {
+            return true;
+        }
+    }
+
+    return writableFolder.IsEmpty() == false && LoadFromFolder(writableFolder, key, cookedData);
+}
+
+bool PhysicsCookingCache::LoadFromFolder(const FilePath& folder, const MD5::MD5Digest& key, Vector<uint8>& cookedData) const
+{
+    using namespace PhysicsCookingCacheDetail;
+
+    FilePath path = GetCachePath(folder, key);
+    FileSystem* fs = FileSystem::Instance();
+    if (fs->IsFile(path) == false || fs->ReadFileContents(path, cookedData) == false)
+    {
+        return false;
+    }
+
+    FileHeader header;
+    if (cookedData.size() < sizeof(FileHeader))
+    {
+        Logger::Warning("[PhysicsCookingCache] Broken cooked geometry %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    Memcpy(&header, cookedData.data(), sizeof(FileHeader));
+    if (header.signature != FILE_SIGNATURE || header.dataSize != cookedData.size() - sizeof(FileHeader) ||
+        header.dataCrc != CRC32::ForBuffer(cookedData.data() + sizeof(FileHeader), header.dataSize))
+    {
+        Logger::Warning("[PhysicsCookingCache] Broken cooked geometry %s", path.GetStringValue().c_str());
+        return false;
+    }
+
+    cookedData.erase(cookedData.begin(), cookedData.begin() + sizeof(FileHeader));
+    return true;
+}
+
+void PhysicsCookingCache::Save(const MD5::MD5Digest& key, const uint8* cookedData, uint32 size) const
+{
+    using namespace PhysicsCookingCacheDetail;
+
+    if (writableFolder.IsEmpty())
+    {
+        return;
+    }
+
+    usedKeys.insert(MD5::HashToString(key));
+
+    FileSystem* fs = FileSystem::Instance();
+    if (fs->CreateDirectory(writableFolder, true) == FileSystem::DIRECTORY_CANT_CREATE)
+    {
+        Logger::Warning("[PhysicsCookingCache] Can't create folder %s", writableFolder.GetStringValue().c_str());
+        return;
+    }
+
+    FileHeader header;
+    header.dataSize = size;
+    header.dataCrc = CRC32::ForBuffer(cookedData, size);
+
+    // Write into temporary file first, so broken file never appears under cache name
+    FilePath path = GetCachePath(writableFolder, key);
+    FilePath tempPath = path + ".tmp";
+    {
+        ScopedPtr<File> file(File::Create(tempPath, File::CREATE | File::WRITE));
+        if (!file || file->Write(&header, sizeof(FileHeader)) != sizeof(FileHeader) || file->Write(cookedData, size) != size)
+        {
+            Logger::Warning("[PhysicsCookingCache] Can't write cooked geometry %s", tempPath.GetStringValue().c_str());
+            return;
+        }
+    }
+
+    if (fs->MoveFile(tempPath, path, true) == false)
+    {
+        Logger::Warning("[PhysicsCookingCache] Can't write cooked geometry %s", path.GetStringValue().c_str());
+        fs->DeleteFile(tempPath);
+        return;
+    }
+
+    if (writableFolderLimit > 0)
+    {
+        EvictUnusedEntries();
+    }
+}
+
+bool PhysicsCookingCache::IsUsedEntry(const FilePath& path) const
+{
+    return usedKeys.count(path.GetBasename()) > 0;
+}
+
+void PhysicsCookingCache::EvictUnusedEntries() const
+{
+    using namespace PhysicsCookingCacheDetail;
+
+    FileSystem* fs = FileSystem::Instance();
+
+    uint64 totalSize = 0;
+    Vector<std::pair<FilePath, uint64>> unusedEntries;
+    for (const FilePath& path : fs->EnumerateFilesInDirectory(writableFolder, false))
+    {
+        uint64 size = 0;
+        if (path.IsEqualToExtension(FILE_EXTENSION) && fs->GetFileSize(path, size))
+        {
+            totalSize += size;
+            if (IsUsedEntry(path) == false)
+            {
+                unusedEntries.emplace_back(path, size);
+            }
+        }
+    }
+
+    // Entries used by current session are kept even if limit is exceeded, they are needed by loaded geometry
+    for (auto it = unusedEntries.begin(); it != unusedEntries.end() && totalSize > writableFolderLimit; ++it)
+    {
+        if (fs->DeleteFile(it->first))
+        {
+            totalSize -= it->second;
+        }
+    }
+}
+
+uint32 PhysicsCookingCache::RemoveUnusedEntries() const
+{
+    using namespace PhysicsCookingCacheDetail;
+
+    if (writableFolder.IsEmpty())
+    {
+        return 0;
+    }
+
+    uint32 removedCount = 0;
+    FileSystem* fs = FileSystem::Instance();
+    for (const FilePath& path : fs->EnumerateFilesInDirectory(writableFolder, false))
+    {
+        if (path.IsEqualToExtension(FILE_EXTENSION) && IsUsedEntry(path) == false && fs->DeleteFile(path))
+        {
+            ++removedCount;
+        }
+    }
+    return removedCount;
+}
+} // namespace DAVA
@@ -0,0 +1,42 @@
+#include "Physics/Private/PhysicsJobDispatcher.h"
+
+#include <Debug/DVAssert.h>
+#include <Job/JobScheduler.h>
+
+#include <PxShared/task/PxTask.h>
+
+namespace DAVA
+{
+namespace PhysicsJobDispatcherDetail
+{
+void RunTask(physx::PxBaseTask* task)
+{
+    task->run();
+    task->release();
+}
+}
+
+PhysicsJobDispatcher::PhysicsJobDispatcher(JobScheduler* scheduler_)
+    : scheduler(scheduler_)
+{
+    DVASSERT(scheduler != nullptr);
+}
+
+void PhysicsJobDispatcher::submitTask(physx::PxBaseTask& task)
+{
+    if (scheduler->GetWorkersCount() == 0)
+    {
+        // Nobody would pick the task up, run it in place like PxDefaultCpuDispatcher without threads does
+        PhysicsJobDispatcherDetail::RunTask(&task);
+        return;
+    }
+
+    physx::PxBaseTask* taskPtr = &task;
+    scheduler->Schedule([taskPtr]() { PhysicsJobDispatcherDetail::RunTask(taskPtr); });
+}
+
+uint32_t PhysicsJobDispatcher::getWorkerCount() const
+{
+    return scheduler->GetWorkersCount();
+}
+}
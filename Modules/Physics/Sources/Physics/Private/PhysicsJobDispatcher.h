@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+
+#include <PxShared/task/PxCpuDispatcher.h>
+
+namespace DAVA
+{
+class JobScheduler;
+
+/**
+    PhysX task dispatcher which executes physics tasks on engine worker threads,
+    so physics doesn't compete with engine jobs for cores.
+*/
+class PhysicsJobDispatcher final : public physx::PxCpuDispatcher
+{
+public:
+    PhysicsJobDispatcher(JobScheduler* scheduler);
+
+    void submitTask(physx::PxBaseTask& task) override;
+    uint32_t getWorkerCount() const override;
+
+private:
+    JobScheduler* scheduler = nullptr;
+};
+}
@@ -16,6 +16,7 @@
 #include "Physics/CapsuleCharacterControllerComponent.h"
 #include "Physics/WASDPhysicsControllerComponent.h"
 #include "Physics/PhysicsGeometryCache.h"
+#include "Physics/Private/PhysicsJobDispatcher.h"
 #include "Physics/Private/PhysicsMath.h"
 
 #include <Engine/Engine.h>
@@ -24,6 +25,7 @@
 #include <FileSystem/YamlParser.h>
 #include <FileSystem/YamlNode.h>
 #include <FileSystem/FileSystem.h>
+#include <Job/JobManager.h>
 #include <Logger/Logger.h>
 #include <Render/3D/PolygonGroup.h>
 #include <Render/Highlevel/Landscape.h>
@@ -217,6 +219,7 @@ void PhysicsModule::Init()
     PxCookingParams cookingParams(toleranceScale);
     cooking = PxCreateCooking(PX_PHYSICS_VERSION, *foundation, cookingParams);
     DVASSERT(cooking);
+    cookingCache = new PhysicsCookingCache();
 
     PxInitVehicleSDK(*physics);
     PxVehicleSetBasisVectors(PxVec3(0.0f, 0.0f, 1.0f), PxVec3(1.0f, 0.0f, 0.0f));
@@ -252,11 +255,13 @@ void PhysicsModule::Shutdown()
     physx::PxCloseVehicleSDK();
 
     ReleaseMaterials();
-    if (cpuDispatcher != nullptr)
+    SafeDelete(jobDispatcher);
+    if (defaultCpuDispatcher != nullptr)
     {
-        cpuDispatcher->release();
+        defaultCpuDispatcher->release();
     }
 
+    SafeDelete(cookingCache);
     cooking->release();
     physics->release();
     PhysicsModuleDetail::ReleasePvd(); // PxPvd should be released between PxPhysics and PxFoundation
@@ -293,12 +298,25 @@ physx::PxScene* PhysicsModule::CreateScene(const PhysicsSceneConfig& config, phy
     sceneDesc.filterShader = filterShader;
     sceneDesc.simulationEventCallback = callback;
 
-    if (cpuDispatcher == nullptr)
+    // Physics tasks share worker threads with engine jobs to avoid oversubscription
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr)
     {
-        cpuDispatcher = PxDefaultCpuDispatcherCreate(config.threadCount);
+        if (jobDispatcher == nullptr)
+        {
+            jobDispatcher = new PhysicsJobDispatcher(jobManager->GetScheduler());
+        }
+        sceneDesc.cpuDispatcher = jobDispatcher;
+    }
+    else
+    {
+        if (defaultCpuDispatcher == nullptr)
+        {
+            defaultCpuDispatcher = PxDefaultCpuDispatcherCreate(config.threadCount);
+        }
+        DVASSERT(defaultCpuDispatcher);
+        sceneDesc.cpuDispatcher = defaultCpuDispatcher;
     }
-    DVASSERT(cpuDispatcher);
-    sceneDesc.cpuDispatcher = cpuDispatcher;
 
     PxScene* scene = physics->createScene(sceneDesc);
     DVASSERT(scene);
@@ -360,15 +378,28 @@ physx::PxShape* PhysicsModule::CreateMeshShape(Vector<PolygonGroup*>&& polygons,
         desc.triangles.data = indices.data();
         desc.flags = PxMeshFlags(0);
 
-        physx::PxTriangleMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
-        if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+        PhysicsCookingCache::KeyBuilder keyBuilder(PhysicsCookingCache::TRIANGLE_MESH);
+        keyBuilder.Add(vertices);
+        keyBuilder.Add(indices);
+        keyBuilder.Add(&desc.flags, sizeof(desc.flags));
+
+        Vector<uint8> cookedData;
+        bool cooked = GetCookedData(keyBuilder.GetKey(), [&](PxOutputStream& outStream) {
+            physx::PxTriangleMeshCookingResult::Enum condition;
+            if (cooking->cookTriangleMesh(desc, outStream, &condition) == false)
+            {
+                Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+                return false;
+            }
+            return true;
+        },
+                                    cookedData);
+        if (cooked == false)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
             return nullptr;
         }
 
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
+        physx::PxDefaultMemoryInputData inputStream(cookedData.data(), static_cast<PxU32>(cookedData.size()));
         mesh = physics->createTriangleMesh(inputStream);
         DVASSERT(mesh != nullptr);
         cache->AddEntry(polygons, mesh);
@@ -407,15 +438,28 @@ physx::PxShape* PhysicsModule::CreateConvexHullShape(Vector<PolygonGroup*>&& pol
         desc.indices.data = indices.data();
         desc.flags = PxConvexFlag::eCOMPUTE_CONVEX;
 
-        PxConvexMeshCookingResult::Enum condition;
-        PxDefaultMemoryOutputStream outStream;
-        if (cooking->cookConvexMesh(desc, outStream, &condition) == false)
+        PhysicsCookingCache::KeyBuilder keyBuilder(PhysicsCookingCache::CONVEX_MESH);
+        keyBuilder.Add(vertices);
+        keyBuilder.Add(indices);
+        keyBuilder.Add(&desc.flags, sizeof(desc.flags));
+
+        Vector<uint8> cookedData;
+        bool cooked = GetCookedData(keyBuilder.GetKey(), [&](PxOutputStream& outStream) {
+            PxConvexMeshCookingResult::Enum condition;
+            if (cooking->cookConvexMesh(desc, outStream, &condition) == false)
+            {
+                Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
+                return false;
+            }
+            return true;
+        },
+                                    cookedData);
+        if (cooked == false)
         {
-            Logger::Error("[Physics::CreateMeshShape] Mesh creation failure for polygon group with code: %u", static_cast<uint32>(condition));
             return nullptr;
         }
 
-        physx::PxDefaultMemoryInputData inputStream(outStream.getData(), outStream.getSize());
+        physx::PxDefaultMemoryInputData inputStream(cookedData.data(), static_cast<PxU32>(cookedData.size()));
         mesh = physics->createConvexMesh(inputStream);
         DVASSERT(mesh != nullptr);
         cache->AddEntry(polygons, mesh);
@@ -459,14 +503,26 @@ physx::PxShape* PhysicsModule::CreateHeightField(Landscape* landscape, const Fas
     desc.samples.data = pxData.data();
     desc.samples.stride = sizeof(PxHeightFieldSample);
 
-    physx::PxDefaultMemoryOutputStream outStream;
-    if (cooking->cookHeightField(desc, outStream) == false)
+    PhysicsCookingCache::KeyBuilder keyBuilder(PhysicsCookingCache::HEIGHT_FIELD);
+    keyBuilder.Add(&size, sizeof(size));
+    keyBuilder.Add(pxData);
+
+    Vector<uint8> cookedData;
+    bool cooked = GetCookedData(keyBuilder.GetKey(), [&](PxOutputStream& outStream) {
+        if (cooking->cookHeightField(desc, outStream) == false)
+        {
+            Logger::Error("[Physics::CreateHeightField] HeightField creation failure");
+            return false;
+        }
+        return true;
+    },
+                                cookedData);
+    if (cooked == false)
     {
-        Logger::Error("[Physics::CreateHeightField] HeightField creation failure");
         return nullptr;
     }
 
-    physx::PxDefaultMemoryInputData data(outStream.getData(), outStream.getSize());
+    physx::PxDefaultMemoryInputData data(cookedData.data(), static_cast<PxU32>(cookedData.size()));
     PxHeightField* heightfield = physics->createHeightField(data);
 
     float32 landscapeSize = landscape->GetLandscapeSize();
@@ -488,6 +544,29 @@ physx::PxAllocatorCallback* PhysicsModule::GetAllocator() const
     return allocator;
 }
 
+PhysicsCookingCache* PhysicsModule::GetCookingCache() const
+{
+    return cookingCache;
+}
+
+bool PhysicsModule::GetCookedData(const MD5::MD5Digest& key, const Function<bool(physx::PxOutputStream&)>& cook, Vector<uint8>& cookedData) const
+{
+    if (cookingCache->Load(key, cookedData))
+    {
+        return true;
+    }
+
+    physx::PxDefaultMemoryOutputStream outStream;
+    if (cook(outStream) == false)
+    {
+        return false;
+    }
+
+    cookedData.assign(outStream.getData(), outStream.getData() + outStream.getSize());
+    cookingCache->Save(key, cookedData.data(), outStream.getSize());
+    return true;
+}
+
 const Vector<const Type*>& PhysicsModule::GetBodyComponentTypes() const
 {
     return bodyComponents;
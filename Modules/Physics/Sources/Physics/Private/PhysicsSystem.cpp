@@ -29,8 +29,11 @@
 #include <Entity/Component.h>
 
 #include <Base/Type.h>
+#include <Concurrency/Thread.h>
 #include <Engine/Engine.h>
 #include <Engine/EngineContext.h>
+#include <Job/JobManager.h>
+#include <Job/JobScheduler.h>
 #include <ModuleManager/ModuleManager.h>
 #include <Scene3D/Scene.h>
 #include <Scene3D/Components/SingleComponents/TransformSingleComponent.h>
@@ -305,6 +308,7 @@ PhysicsSystem::PhysicsSystem(Scene* scene)
 
         gravity = options->GetVector3("physics.gravity", gravity);
         threadCount = options->GetUInt32("physics.threadCount", threadCount);
+        isLateFetchEnabled = options->GetBool("physics.lateFetch", isLateFetchEnabled);
     }
 
     const EngineContext* ctx = GetEngineContext();
@@ -656,9 +660,43 @@ bool PhysicsSystem::IsDebugDrawEnabled() const
     return drawDebugInfo;
 }
 
+void PhysicsSystem::SetLateFetchEnabled(bool enabled)
+{
+    isLateFetchEnabled = enabled;
+}
+
+bool PhysicsSystem::IsLateFetchEnabled() const
+{
+    return isLateFetchEnabled;
+}
+
+void PhysicsSystem::ProcessLateFetch()
+{
+    if (isLateFetchEnabled && isSimulationRunning)
+    {
+        bool success = FetchResults(true);
+        DVASSERT(success == true);
+    }
+}
+
 bool PhysicsSystem::FetchResults(bool waitForFetchFinish)
 {
     DVASSERT(isSimulationRunning);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (waitForFetchFinish && jobManager != nullptr)
+    {
+        // Physics tasks run on engine workers, help them instead of blocking in fetchResults
+        JobScheduler* scheduler = jobManager->GetScheduler();
+        while (physicsScene->checkResults(false) == false)
+        {
+            if (scheduler->TryExecuteOne() == false)
+            {
+                Thread::Yield();
+            }
+        }
+    }
+
     bool isFetched = physicsScene->fetchResults(waitForFetchFinish);
     if (isFetched == true)
     {
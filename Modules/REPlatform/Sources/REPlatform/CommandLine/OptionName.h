@@ -40,6 +40,7 @@ public:
     static const String Yaml;
 
     static const String GPU;
+    static const String Api;
     static const String Quality;
     static const String Force;
     static const String Mipmaps;
@@ -34,6 +34,7 @@ const String OptionName::Texture("-texture");
 const String OptionName::Yaml("-yaml");
 
 const String OptionName::GPU("-gpu");
+const String OptionName::Api("-api");
 const String OptionName::Quality("-quality");
 const String OptionName::Force("-f");
 const String OptionName::Mipmaps("-m");
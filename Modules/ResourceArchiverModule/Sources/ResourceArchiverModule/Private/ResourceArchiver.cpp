@@ -28,6 +28,7 @@ ENUM_DECLARE(DAVA::Compressor::Type)
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4), "lz4");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4HC), "lz4hc");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::RFC1951), "rfc1951");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4Dict), "lz4dict");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::None), "none");
 };
 
@@ -442,6 +443,44 @@ const Compressor* GetCompressor(Compressor::Type compressorType)
     }
 }
 
+Vector<uint8> TrainDictionary(const Vector<CollectedFile>& collectedFiles)
+{
+    // dictionary helps small files only, big ones are compressed well without it
+    const uint64 maxSampleFileSize = 128 * 1024;
+    const uint64 maxSamplesSize = 16 * 1024 * 1024;
+
+    FileSystem* fs = FileSystem::Instance();
+
+    Vector<const CollectedFile*> candidates;
+    uint64 candidatesSize = 0;
+    for (const CollectedFile& collectedFile : collectedFiles)
+    {
+        uint64 fileSize = 0;
+        if (fs->GetFileSize(collectedFile.absPath, fileSize) && fileSize > 0 && fileSize <= maxSampleFileSize)
+        {
+            candidates.push_back(&collectedFile);
+            candidatesSize += fileSize;
+        }
+    }
+
+    // take files evenly from whole (sorted by path) list to cover all kinds of content
+    const size_t step = static_cast<size_t>(candidatesSize / maxSamplesSize + 1);
+
+    Vector<Vector<uint8>> samples;
+    for (size_t i = 0; i < candidates.size(); i += step)
+    {
+        Vector<uint8> content;
+        if (fs->ReadFileContents(candidates[i]->absPath, content))
+        {
+            samples.push_back(std::move(content));
+        }
+    }
+
+    Vector<uint8> dictionary = LZ4DictCompressor::TrainDictionary(samples);
+    Logger::Info("Dictionary trained: %u bytes from %u samples", static_cast<uint32>(dictionary.size()), static_cast<uint32>(samples.size()));
+    return dictionary;
+}
+
 bool Pack(const Vector<CollectedFile>& collectedFiles,
           const DAVA::Compressor::Type compressionType,
           const FilePath& metaDb,
@@ -456,7 +495,16 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     }
 
     const Compressor* compressor = nullptr;
-    if (compressionType != Compressor::Type::None)
+    std::unique_ptr<LZ4DictCompressor> dictCompressor;
+    if (compressionType == Compressor::Type::Lz4Dict)
+    {
+        if (!dummyFileData)
+        {
+            dictCompressor.reset(new LZ4DictCompressor(TrainDictionary(collectedFiles)));
+        }
+        compressor = dictCompressor.get();
+    }
+    else if (compressionType != Compressor::Type::None)
     {
         compressor = GetCompressor(compressionType);
         if (compressor == nullptr)
@@ -626,6 +674,15 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     useBuffers.clear();
     useBuffers.shrink_to_fit(); // free memory
 
+    if (dictCompressor)
+    {
+        if (!WriteRawData(outputFile, dictCompressor->GetDictionary()))
+        {
+            Logger::Error("can't write dictionary");
+            return false;
+        }
+    }
+
     Vector<uint8> metaBytes;
     if (meta)
     {
@@ -709,6 +766,12 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
         footerBlock.metaDataSize = 0;
     }
 
+    if (dictCompressor)
+    {
+        footerBlock.dictionarySize = static_cast<uint32>(dictCompressor->GetDictionary().size());
+        footerBlock.dictionaryCrc32 = dictCompressor->GetDictionaryId();
+    }
+
     if (!WriteHeaderBlock(outputFile, footerBlock))
     {
         Logger::Error("Can't write footerBlock");
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Animation/AnimationClipCompressor.h>
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+
+/**
+    Measures sampling throughput of animation clip before and after compression.
+
+    Clip from `clipPath` is compressed with default parameters to documents folder, then every channel of
+    both clips is sampled `framesCount` times with 30 fps step, same way as skeleton animation samples playing clip.
+    Result contains compression report (sizes and max errors against original clip) and samples per millisecond.
+*/
+struct AnimationClipTestResult
+{
+    DAVA::FilePath clipPath;
+    DAVA::AnimationClipCompressor::Report report;
+    DAVA::float32 originalSamplesPerMs = 0.f;
+    DAVA::float32 compressedSamplesPerMs = 0.f;
+};
+
+class AnimationClipTest final
+{
+public:
+    static AnimationClipTestResult Run(const DAVA::FilePath& clipPath, DAVA::uint32 framesCount = 10000);
+
+    // runs test for every '.anim' file in `folder` and logs results
+    static DAVA::Vector<AnimationClipTestResult> RunAll(const DAVA::FilePath& folder, DAVA::uint32 framesCount = 10000);
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "FrameTimeStats.h"
+
+#include <Base/BaseTypes.h>
+
+/**
+    Measures time of render hierarchy clipping (QuadTree::Clip) for synthetic scenes.
+
+    Scene of `objectCount` boxes randomly spread over square world is clipped by camera
+    rotating around world center. Test does not draw anything, so it can be run under
+    NullRenderer to measure culling cost only.
+*/
+struct ClippingTestResult
+{
+    DAVA::uint32 objectCount = 0;
+    DAVA::uint32 avgVisibleCount = 0;
+    FrameTimeStats clipTime;
+};
+
+class ClippingTest final
+{
+public:
+    static ClippingTestResult Run(DAVA::uint32 objectCount, DAVA::uint32 framesCount = 100);
+
+    // runs test for 10k, 25k, 50k and 100k objects and logs results
+    static DAVA::Vector<ClippingTestResult> RunAll(DAVA::uint32 framesCount = 100);
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+
+/**
+    Min, max and average time of measured frames, shared by scene performance tests.
+
+    Typical usage:
+    \code
+    FrameTimeStats stats;
+    for (uint32 frame = 0; frame < framesCount; ++frame)
+    {
+        int64 startUs = SystemTimer::GetUs();
+        scene->Update(FRAME_TIME);
+        stats.AddFrame(SystemTimer::GetUs() - startUs);
+    }
+    Logger::Info("frame %s", stats.ToString().c_str());
+    \endcode
+*/
+struct FrameTimeStats
+{
+    DAVA::uint32 framesCount = 0;
+    DAVA::float32 avgMs = 0.f;
+    DAVA::float32 minMs = 0.f;
+    DAVA::float32 maxMs = 0.f;
+
+    void AddFrame(DAVA::int64 frameUs);
+
+    // returns "avg %.3f ms, min %.3f ms, max %.3f ms"
+    DAVA::String ToString() const;
+};
+
+// returns how many times `measured` is faster than `reference`, or 0 if `measured` took no time
+DAVA::float32 GetSpeedup(const FrameTimeStats& reference, const FrameTimeStats& measured);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "FrameTimeStats.h"
+
+#include <Base/BaseTypes.h>
+
+/**
+    Measures time of scene update for synthetic scene with many particle effects.
+
+    Scene of `effectsCount` effects spread over square world is updated with fixed time step, particle
+    effects are simulated on up to `workersCount` job workers or on main thread if `workersCount` is zero.
+    Measured frame includes waiting for simulation. Test does not draw anything, so it can be run
+    under NullRenderer to measure simulation cost only.
+*/
+struct ParticlesTestResult
+{
+    DAVA::uint32 effectsCount = 0;
+    DAVA::uint32 workersCount = 0;
+    DAVA::uint32 avgParticlesCount = 0;
+    FrameTimeStats frameTime;
+};
+
+class ParticlesTest final
+{
+public:
+    static ParticlesTestResult Run(DAVA::uint32 effectsCount, DAVA::uint32 workersCount, DAVA::uint32 framesCount = 100);
+
+    // runs test for 100, 250 and 500 effects on main thread and on 1 to all job workers and logs results
+    static DAVA::Vector<ParticlesTestResult> RunAll(DAVA::uint32 framesCount = 100);
+};
@@ -0,0 +1,100 @@
+#include "AnimationClipTest.h"
+
+#include <Animation/AnimationClip.h>
+#include <Animation/AnimationTrack.h>
+#include <Base/ScopedPtr.h>
+#include <FileSystem/FileList.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+
+namespace AnimationClipTestDetails
+{
+using namespace DAVA;
+
+const float32 FRAME_TIME = 1.f / 30.f;
+const FilePath COMPRESSED_CLIP_PATH = "~doc:/AnimationClipTest/compressed.anim";
+
+float32 MeasureSamplesPerMs(const AnimationClip* clip, uint32 framesCount)
+{
+    Vector<uint32> keyCursors;
+    for (uint32 t = 0; t < clip->GetTrackCount(); ++t)
+    {
+        keyCursors.resize(keyCursors.size() + clip->GetTrack(t)->GetChannelsCount(), 0);
+    }
+
+    float32 duration = Max(clip->GetDuration(), FRAME_TIME);
+    float32 value[AnimationChannel::MAX_QUANTIZED_DIMENSION];
+    float32 checksum = 0.f; // keeps optimizer from removing evaluation
+
+    int64 startUs = SystemTimer::GetUs();
+    for (uint32 frame = 0; frame < framesCount; ++frame)
+    {
+        float32 time = std::fmod(frame * FRAME_TIME, duration);
+        uint32 cursor = 0;
+        for (uint32 t = 0; t < clip->GetTrackCount(); ++t)
+        {
+            const AnimationTrack* track = clip->GetTrack(t);
+            for (uint32 c = 0; c < track->GetChannelsCount(); ++c, ++cursor)
+            {
+                track->Evaluate(time, c, value, AnimationChannel::MAX_QUANTIZED_DIMENSION, &keyCursors[cursor]);
+                checksum += value[0];
+            }
+        }
+    }
+    int64 totalUs = SystemTimer::GetUs() - startUs;
+
+    Logger::Debug("AnimationClipTest: checksum %f", checksum);
+    return (totalUs > 0) ? float32(keyCursors.size()) * framesCount * 1000.f / totalUs : 0.f;
+}
+}
+
+AnimationClipTestResult AnimationClipTest::Run(const DAVA::FilePath& clipPath, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+    using namespace AnimationClipTestDetails;
+
+    AnimationClipTestResult result;
+    result.clipPath = clipPath;
+
+    FileSystem::Instance()->CreateDirectory(COMPRESSED_CLIP_PATH.GetDirectory(), true);
+    if (!AnimationClipCompressor::Compress(clipPath, COMPRESSED_CLIP_PATH, AnimationClipCompressor::Params(), &result.report))
+    {
+        return result;
+    }
+
+    ScopedPtr<AnimationClip> original(AnimationClip::Load(clipPath));
+    ScopedPtr<AnimationClip> compressed(AnimationClip::Load(COMPRESSED_CLIP_PATH));
+    if (original && compressed)
+    {
+        result.originalSamplesPerMs = MeasureSamplesPerMs(original, framesCount);
+        result.compressedSamplesPerMs = MeasureSamplesPerMs(compressed, framesCount);
+    }
+
+    FileSystem::Instance()->DeleteFile(COMPRESSED_CLIP_PATH);
+    return result;
+}
+
+DAVA::Vector<AnimationClipTestResult> AnimationClipTest::RunAll(const DAVA::FilePath& folder, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+
+    Vector<AnimationClipTestResult> results;
+    ScopedPtr<FileList> fileList(new FileList(folder));
+    for (uint32 i = 0; i < fileList->GetCount(); ++i)
+    {
+        const FilePath& path = fileList->GetPathname(i);
+        if (fileList->IsDirectory(i) || !path.IsEqualToExtension(".anim"))
+            continue;
+
+        results.push_back(Run(path, framesCount));
+
+        const AnimationClipTestResult& r = results.back();
+        const AnimationClipCompressor::Report& report = r.report;
+        float32 ratio = (report.compressedSize > 0) ? float32(report.originalSize) / report.compressedSize : 0.f;
+        Logger::Info("AnimationClipTest: %s, size %u -> %u bytes (%.2fx), channels %u (constant %u, quantized %u), max error: position %f, orientation %f rad, scale %f, samples per ms %.0f -> %.0f",
+                     path.GetFilename().c_str(), report.originalSize, report.compressedSize, ratio, report.channelsCount, report.constantChannelsCount, report.quantizedChannelsCount,
+                     report.maxPositionError, report.maxOrientationError, report.maxScaleError, r.originalSamplesPerMs, r.compressedSamplesPerMs);
+    }
+    return results;
+}
@@ -0,0 +1,113 @@
+#include "ClippingTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Logger/Logger.h>
+#include <Math/MathHelpers.h>
+#include <Render/Highlevel/Camera.h>
+#include <Render/Highlevel/RenderObject.h>
+#include <Render/Highlevel/VisibilityQuadTree.h>
+#include <Time/SystemTimer.h>
+#include <Utils/Random.h>
+
+namespace ClippingTestDetails
+{
+using namespace DAVA;
+
+const float32 WORLD_SIZE = 2000.f;
+const float32 MIN_OBJECT_SIZE = 1.f;
+const float32 MAX_OBJECT_SIZE = 10.f;
+const float32 CAMERA_HEIGHT = 20.f;
+const int32 QUAD_TREE_DEPTH = 10;
+const uint32 OBJECT_COUNTS[] = { 10000, 25000, 50000, 100000 };
+
+class BoxRenderObject : public RenderObject
+{
+public:
+    BoxRenderObject(const AABBox3& box, Matrix4* worldTransform)
+    {
+        bbox = box;
+        SetWorldMatrixPtr(worldTransform);
+        RecalculateWorldBoundingBox();
+    }
+};
+}
+
+ClippingTestResult ClippingTest::Run(DAVA::uint32 objectCount, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+    using namespace ClippingTestDetails;
+
+    Random* random = Random::Instance();
+    random->Seed(objectCount);
+
+    // world transforms have to outlive render objects as objects keep pointer to it
+    Vector<Matrix4> transforms(objectCount);
+    Vector<RenderObject*> objects;
+    objects.reserve(objectCount);
+
+    QuadTree quadTree(QUAD_TREE_DEPTH);
+    for (uint32 i = 0; i < objectCount; ++i)
+    {
+        Vector3 position(random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), 0.f);
+        transforms[i] = Matrix4::MakeTranslation(position);
+
+        float32 size = random->RandFloat32InBounds(MIN_OBJECT_SIZE, MAX_OBJECT_SIZE);
+        RenderObject* object = new BoxRenderObject(AABBox3(Vector3(0.f, 0.f, size / 2), size), &transforms[i]);
+        objects.push_back(object);
+        quadTree.AddRenderObject(object);
+    }
+    quadTree.Initialize();
+
+    ScopedPtr<Camera> camera(new Camera());
+    camera->SetupPerspective(70.f, 1.f, 1.f, WORLD_SIZE / 2);
+    camera->SetUp(Vector3(0.f, 0.f, 1.f));
+    camera->SetPosition(Vector3(0.f, 0.f, CAMERA_HEIGHT));
+
+    ClippingTestResult result;
+    result.objectCount = objectCount;
+
+    uint64 visibleCount = 0;
+    Vector<RenderObject*> visibilityArray;
+    visibilityArray.reserve(objectCount);
+    for (uint32 frame = 0; frame < framesCount; ++frame)
+    {
+        float32 angle = PI_2 * frame / framesCount;
+        camera->SetDirection(Vector3(std::cos(angle), std::sin(angle), -0.1f));
+        camera->PrepareDynamicParameters(false);
+
+        visibilityArray.clear();
+        int64 startUs = SystemTimer::GetUs();
+        quadTree.Clip(camera.get(), visibilityArray, RenderObject::CLIPPING_VISIBILITY_CRITERIA);
+        result.clipTime.AddFrame(SystemTimer::GetUs() - startUs);
+
+        visibleCount += visibilityArray.size();
+    }
+
+    if (framesCount > 0)
+    {
+        result.avgVisibleCount = static_cast<uint32>(visibleCount / framesCount);
+    }
+
+    quadTree.PrepareForShutdown();
+    for (RenderObject* object : objects)
+    {
+        SafeRelease(object);
+    }
+
+    return result;
+}
+
+DAVA::Vector<ClippingTestResult> ClippingTest::RunAll(DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+
+    Vector<ClippingTestResult> results;
+    for (uint32 objectCount : ClippingTestDetails::OBJECT_COUNTS)
+    {
+        results.push_back(Run(objectCount, framesCount));
+
+        const ClippingTestResult& r = results.back();
+        Logger::Info("ClippingTest: %u objects, %u visible, clip %s", r.objectCount, r.avgVisibleCount, r.clipTime.ToString().c_str());
+    }
+    return results;
+}
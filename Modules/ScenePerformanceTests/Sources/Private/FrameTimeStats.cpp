@@ -0,0 +1,31 @@
+#include "FrameTimeStats.h"
+
+#include <Utils/StringFormat.h>
+
+void FrameTimeStats::AddFrame(DAVA::int64 frameUs)
+{
+    DAVA::float32 frameMs = frameUs / 1000.f;
+    if (framesCount == 0)
+    {
+        minMs = frameMs;
+        maxMs = frameMs;
+    }
+    else
+    {
+        minMs = std::min(minMs, frameMs);
+        maxMs = std::max(maxMs, frameMs);
+    }
+
+    ++framesCount;
+    avgMs += (frameMs - avgMs) / framesCount;
+}
+
+DAVA::String FrameTimeStats::ToString() const
+{
+    return DAVA::Format("avg %.3f ms, min %.3f ms, max %.3f ms", avgMs, minMs, maxMs);
+}
+
+DAVA::float32 GetSpeedup(const FrameTimeStats& reference, const FrameTimeStats& measured)
+{
+    return (measured.avgMs > 0.f) ? reference.avgMs / measured.avgMs : 0.f;
+}
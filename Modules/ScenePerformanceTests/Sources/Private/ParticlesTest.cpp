@@ -0,0 +1,149 @@
+#include "ParticlesTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <Job/JobManager.h>
+#include <Job/JobScheduler.h>
+#include <Logger/Logger.h>
+#include <Particles/ParticleEmitter.h>
+#include <Particles/ParticleLayer.h>
+#include <Scene3D/Components/ParticleEffectComponent.h>
+#include <Scene3D/Components/TransformComponent.h>
+#include <Scene3D/Entity.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/Systems/ParticleEffectSystem.h>
+#include <Time/SystemTimer.h>
+#include <Utils/Random.h>
+
+namespace ParticlesTestDetails
+{
+using namespace DAVA;
+
+const float32 WORLD_SIZE = 200.f;
+const float32 FRAME_TIME = 1.f / 60.f;
+const uint32 WARMUP_FRAMES = 120; // particles live 2 seconds, so effects reach steady state after warmup
+const uint32 EFFECT_COUNTS[] = { 100, 250, 500 };
+
+template <typename T>
+RefPtr<PropertyLine<T>> MakeKeyframes(const T& begin, const T& end)
+{
+    PropertyLineKeyframes<T>* line = new PropertyLineKeyframes<T>();
+    line->AddValue(0.f, begin);
+    line->AddValue(1.f, end);
+    return RefPtr<PropertyLine<T>>(line);
+}
+
+// emitter is shared by all effects of the scene, same as emitters loaded from one file
+ParticleEmitter* CreateEmitter()
+{
+    ParticleEmitter* emitter = new ParticleEmitter();
+    emitter->emitterType = ParticleEmitter::EMITTER_ONCIRCLE_VOLUME;
+    emitter->radius.Set(new PropertyLineValue<float32>(1.f));
+    emitter->emissionRange.Set(new PropertyLineValue<float32>(60.f));
+
+    ScopedPtr<ParticleLayer> layer(new ParticleLayer());
+    layer->life.Set(new PropertyLineValue<float32>(2.f));
+    layer->lifeVariation.Set(new PropertyLineValue<float32>(0.5f));
+    layer->number.Set(new PropertyLineValue<float32>(100.f));
+    layer->size.Set(new PropertyLineValue<Vector2>(Vector2(0.2f, 0.2f)));
+    layer->sizeOverLifeXY = MakeKeyframes(Vector2(1.f, 1.f), Vector2(3.f, 3.f));
+    layer->velocity.Set(new PropertyLineValue<float32>(3.f));
+    layer->velocityVariation.Set(new PropertyLineValue<float32>(1.f));
+    layer->velocityOverLife = MakeKeyframes(1.f, 0.2f);
+    layer->spin.Set(new PropertyLineValue<float32>(90.f));
+    layer->spinVariation.Set(new PropertyLineValue<float32>(45.f));
+    layer->isLooped = true;
+    emitter->AddLayer(layer);
+
+    return emitter;
+}
+}
+
+ParticlesTestResult ParticlesTest::Run(DAVA::uint32 effectsCount, DAVA::uint32 workersCount, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+    using namespace ParticlesTestDetails;
+
+    Random* random = Random::Instance();
+    random->Seed(effectsCount);
+
+    ScopedPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG | Scene::SCENE_SYSTEM_PARTICLE_EFFECT_FLAG));
+    scene->SetSystemsProcessMode(workersCount > 0 ? Scene::eSystemsProcessMode::PARALLEL : Scene::eSystemsProcessMode::SEQUENTIAL);
+    scene->particleEffectSystem->SetMaxSimulationThreads(workersCount);
+
+    ScopedPtr<ParticleEmitter> emitter(CreateEmitter());
+    Vector<ParticleEffectComponent*> effects;
+    effects.reserve(effectsCount);
+    for (uint32 i = 0; i < effectsCount; ++i)
+    {
+        ScopedPtr<Entity> entity(new Entity());
+        Vector3 position(random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), 0.f);
+        entity->GetComponent<TransformComponent>()->SetLocalTranslation(position);
+
+        ParticleEffectComponent* effect = new ParticleEffectComponent();
+        effect->AddEmitterInstance(emitter);
+        entity->AddComponent(effect);
+        scene->AddNode(entity);
+
+        effect->Start();
+        effects.push_back(effect);
+    }
+
+    for (uint32 frame = 0; frame < WARMUP_FRAMES; ++frame)
+    {
+        scene->Update(FRAME_TIME);
+    }
+
+    ParticlesTestResult result;
+    result.effectsCount = effectsCount;
+    result.workersCount = workersCount;
+
+    uint64 particlesCount = 0;
+    for (uint32 frame = 0; frame < framesCount; ++frame)
+    {
+        int64 startUs = SystemTimer::GetUs();
+        scene->Update(FRAME_TIME);
+        scene->particleEffectSystem->WaitSimulation();
+        result.frameTime.AddFrame(SystemTimer::GetUs() - startUs);
+
+        for (ParticleEffectComponent* effect : effects)
+        {
+            particlesCount += effect->GetActiveParticlesCount();
+        }
+    }
+
+    if (framesCount > 0)
+    {
+        result.avgParticlesCount = static_cast<uint32>(particlesCount / framesCount);
+    }
+
+    return result;
+}
+
+DAVA::Vector<ParticlesTestResult> ParticlesTest::RunAll(DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+
+    uint32 maxWorkersCount = 0;
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr)
+    {
+        maxWorkersCount = jobManager->GetScheduler()->GetWorkersCount();
+    }
+
+    Vector<ParticlesTestResult> results;
+    for (uint32 effectsCount : ParticlesTestDetails::EFFECT_COUNTS)
+    {
+        size_t mainThreadIndex = results.size();
+        for (uint32 workersCount = 0; workersCount <= maxWorkersCount; ++workersCount)
+        {
+            results.push_back(Run(effectsCount, workersCount, framesCount));
+
+            const ParticlesTestResult& r = results.back();
+            Logger::Info("ParticlesTest: %u effects, %u particles, %u workers, frame %s, speedup %.2fx",
+                         r.effectsCount, r.avgParticlesCount, r.workersCount, r.frameTime.ToString().c_str(), GetSpeedup(results[mainThreadIndex].frameTime, r.frameTime));
+        }
+    }
+    return results;
+}
@@ -0,0 +1,160 @@
+#include "RenderPassTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Base/TemplateHelpers.h>
+#include <Logger/Logger.h>
+#include <Render/3D/PolygonGroup.h>
+#include <Render/Highlevel/Camera.h>
+#include <Render/Highlevel/RenderBatch.h>
+#include <Render/Highlevel/RenderObject.h>
+#include <Render/Material/NMaterial.h>
+#include <Render/Material/NMaterialNames.h>
+#include <Render/RenderOptions.h>
+#include <Render/Renderer.h>
+#include <Scene3D/Components/RenderComponent.h>
+#include <Scene3D/Components/TransformComponent.h>
+#include <Scene3D/Entity.h>
+#include <Scene3D/Scene.h>
+#include <Time/SystemTimer.h>
+#include <Utils/Random.h>
+#include <Utils/StringFormat.h>
+
+namespace RenderPassTestDetails
+{
+using namespace DAVA;
+
+const float32 WORLD_SIZE = 200.f;
+const float32 FRAME_TIME = 1.f / 60.f;
+const uint32 OBJECT_COUNTS[] = { 1000, 5000, 10000 };
+
+// unit box, shared by all render batches
+PolygonGroup* CreateBox()
+{
+    const Vector3 corners[] =
+    {
+      Vector3(-.5f, -.5f, -.5f), Vector3(.5f, -.5f, -.5f), Vector3(.5f, .5f, -.5f), Vector3(-.5f, .5f, -.5f),
+      Vector3(-.5f, -.5f, .5f), Vector3(.5f, -.5f, .5f), Vector3(.5f, .5f, .5f), Vector3(-.5f, .5f, .5f)
+    };
+    const int16 indices[] =
+    {
+      0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+      1, 2, 6, 1, 6, 5, 2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7
+    };
+
+    PolygonGroup* box = new PolygonGroup();
+    box->AllocateData(EVF_VERTEX, static_cast<int32>(COUNT_OF(corners)), static_cast<int32>(COUNT_OF(indices)));
+    for (uint32 i = 0; i < COUNT_OF(corners); ++i)
+    {
+        box->SetCoord(i, corners[i]);
+    }
+    for (uint32 i = 0; i < COUNT_OF(indices); ++i)
+    {
+        box->SetIndex(i, indices[i]);
+    }
+    box->BuildBuffers();
+    return box;
+}
+
+NMaterial* CreateMaterial(uint32 index)
+{
+    NMaterial* material = new NMaterial();
+    material->SetMaterialName(FastName(Format("RenderPassTestMaterial%u", index)));
+    material->SetFXName((index % 4 == 0) ? NMaterialName::TEXTURED_ALPHABLEND : NMaterialName::TEXTURED_OPAQUE);
+    return material;
+}
+}
+
+const DAVA::uint32 RenderPassTest::MATERIALS_COUNT;
+
+RenderPassTestResult RenderPassTest::Run(DAVA::uint32 objectsCount, bool parallel, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+    using namespace RenderPassTestDetails;
+
+    Random* random = Random::Instance();
+    random->Seed(objectsCount);
+
+    ScopedPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG | Scene::SCENE_SYSTEM_RENDER_UPDATE_FLAG));
+
+    ScopedPtr<Camera> camera(new Camera());
+    camera->SetupPerspective(90.f, 1.f, 1.f, 1000.f);
+    camera->SetUp(Vector3(0.f, 0.f, 1.f));
+    camera->SetPosition(Vector3(0.f, -WORLD_SIZE, WORLD_SIZE / 2));
+    camera->SetTarget(Vector3(0.f, 0.f, 0.f));
+    scene->AddCamera(camera);
+    scene->SetCurrentCamera(camera);
+
+    ScopedPtr<PolygonGroup> box(CreateBox());
+    Vector<ScopedPtr<NMaterial>> materials;
+    for (uint32 i = 0; i < MATERIALS_COUNT; ++i)
+    {
+        materials.emplace_back(CreateMaterial(i));
+    }
+
+    for (uint32 i = 0; i < objectsCount; ++i)
+    {
+        ScopedPtr<Entity> entity(new Entity());
+        Vector3 position(random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), 0.f);
+        entity->GetComponent<TransformComponent>()->SetLocalTranslation(position);
+
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        batch->SetPolygonGroup(box);
+        batch->SetMaterial(materials[random->Rand(MATERIALS_COUNT)]);
+
+        ScopedPtr<RenderObject> renderObject(new RenderObject());
+        renderObject->AddRenderBatch(batch);
+
+        RenderComponent* renderComponent = new RenderComponent();
+        renderComponent->SetRenderObject(renderObject);
+        entity->AddComponent(renderComponent);
+        scene->AddNode(entity);
+    }
+
+    RenderOptions* options = Renderer::GetOptions();
+    bool parallelPrepare = options->IsOptionEnabled(RenderOptions::PARALLEL_RENDER_PREPARE);
+    options->SetOption(RenderOptions::PARALLEL_RENDER_PREPARE, parallel);
+
+    // first frame builds materials and shaders
+    scene->Update(FRAME_TIME);
+    scene->Draw();
+    Renderer::EndFrame();
+    Renderer::BeginFrame();
+
+    RenderPassTestResult result;
+    result.objectsCount = objectsCount;
+    result.parallel = parallel;
+
+    for (uint32 frame = 0; frame < framesCount; ++frame)
+    {
+        scene->Update(FRAME_TIME);
+
+        int64 startUs = SystemTimer::GetUs();
+        scene->Draw();
+        result.frameTime.AddFrame(SystemTimer::GetUs() - startUs);
+
+        // every frame is presented, so dynamic buffers and packet lists are not accumulated
+        Renderer::EndFrame();
+        Renderer::BeginFrame();
+    }
+
+    options->SetOption(RenderOptions::PARALLEL_RENDER_PREPARE, parallelPrepare);
+    return result;
+}
+
+DAVA::Vector<RenderPassTestResult> RenderPassTest::RunAll(DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+
+    Vector<RenderPassTestResult> results;
+    for (uint32 objectsCount : RenderPassTestDetails::OBJECT_COUNTS)
+    {
+        results.push_back(Run(objectsCount, false, framesCount));
+        results.push_back(Run(objectsCount, true, framesCount));
+
+        const RenderPassTestResult& sequential = results[results.size() - 2];
+        const RenderPassTestResult& parallel = results.back();
+        Logger::Info("RenderPassTest: %u objects, sequential draw %s, parallel draw %s, speedup %.2fx",
+                     objectsCount, sequential.frameTime.ToString().c_str(), parallel.frameTime.ToString().c_str(), GetSpeedup(sequential.frameTime, parallel.frameTime));
+    }
+    return results;
+}
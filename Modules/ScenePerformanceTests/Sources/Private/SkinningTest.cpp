@@ -0,0 +1,151 @@
+#include "SkinningTest.h"
+
+#include <Base/ScopedPtr.h>
+#include <Logger/Logger.h>
+#include <Render/Highlevel/RenderBatch.h>
+#include <Render/Highlevel/SkinnedMesh.h>
+#include <Scene3D/Components/RenderComponent.h>
+#include <Scene3D/Components/SkeletonComponent.h>
+#include <Scene3D/Components/TransformComponent.h>
+#include <Scene3D/Entity.h>
+#include <Scene3D/Scene.h>
+#include <Time/SystemTimer.h>
+#include <Utils/Random.h>
+#include <Utils/StringFormat.h>
+
+namespace SkinningTestDetails
+{
+using namespace DAVA;
+
+const float32 WORLD_SIZE = 200.f;
+const float32 FRAME_TIME = 1.f / 60.f;
+const float32 BONE_LENGTH = 0.1f;
+const uint32 CHARACTER_COUNTS[] = { 100, 250, 500 };
+
+// binary tree of joints, parent always goes before its children
+Vector<SkeletonComponent::Joint> CreateJoints()
+{
+    Vector<SkeletonComponent::Joint> joints(SkinningTest::JOINTS_COUNT);
+    Vector<Vector3> positions(SkinningTest::JOINTS_COUNT);
+    for (uint32 i = 0; i < SkinningTest::JOINTS_COUNT; ++i)
+    {
+        SkeletonComponent::Joint& joint = joints[i];
+        joint.name = FastName(Format("joint%u", i));
+        joint.uid = joint.name;
+        joint.bbox = AABBox3(Vector3(), BONE_LENGTH);
+
+        if (i > 0)
+        {
+            joint.parentIndex = (i - 1) / 2;
+            positions[i] = positions[joint.parentIndex] + Vector3(0.f, 0.f, BONE_LENGTH);
+        }
+
+        joint.bindTransform = Matrix4::MakeTranslation(positions[i]);
+        joint.bindTransformInv = Matrix4::MakeTranslation(-positions[i]);
+    }
+    return joints;
+}
+
+SkinnedMesh* CreateSkinnedMesh()
+{
+    SkinnedMesh* mesh = new SkinnedMesh();
+    for (uint32 firstJoint = 0; firstJoint < SkinningTest::JOINTS_COUNT; firstJoint += SkinnedMesh::MAX_TARGET_JOINTS)
+    {
+        SkinnedMesh::JointTargets targets;
+        for (uint32 j = firstJoint; j < std::min(firstJoint + SkinnedMesh::MAX_TARGET_JOINTS, SkinningTest::JOINTS_COUNT); ++j)
+        {
+            targets.push_back(static_cast<int32>(j));
+        }
+
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        mesh->AddRenderBatch(batch);
+        mesh->SetJointTargets(batch, targets);
+    }
+    return mesh;
+}
+
+void AnimateSkeleton(SkeletonComponent* skeleton, float32 time)
+{
+    for (uint32 i = 1; i < skeleton->GetJointsCount(); ++i)
+    {
+        float32 angle = std::sin(time + i * 0.1f) * 0.25f;
+        skeleton->SetJointOrientation(i, Quaternion::MakeRotation(Vector3(1.f, 0.f, 0.f), angle));
+    }
+}
+}
+
+const DAVA::uint32 SkinningTest::JOINTS_COUNT;
+
+SkinningTestResult SkinningTest::Run(DAVA::uint32 charactersCount, bool parallel, DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+    using namespace SkinningTestDetails;
+
+    Random* random = Random::Instance();
+    random->Seed(charactersCount);
+
+    ScopedPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG | Scene::SCENE_SYSTEM_SKELETON_FLAG));
+    scene->SetSystemsProcessMode(parallel ? Scene::eSystemsProcessMode::PARALLEL : Scene::eSystemsProcessMode::SEQUENTIAL);
+
+    Vector<SkeletonComponent::Joint> joints = CreateJoints();
+    Vector<SkeletonComponent*> skeletons;
+    skeletons.reserve(charactersCount);
+    for (uint32 i = 0; i < charactersCount; ++i)
+    {
+        ScopedPtr<Entity> entity(new Entity());
+        Vector3 position(random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), random->RandFloat32InBounds(-WORLD_SIZE / 2, WORLD_SIZE / 2), 0.f);
+        entity->GetComponent<TransformComponent>()->SetLocalTranslation(position);
+
+        ScopedPtr<SkinnedMesh> mesh(CreateSkinnedMesh());
+        RenderComponent* renderComponent = new RenderComponent();
+        renderComponent->SetRenderObject(mesh);
+        entity->AddComponent(renderComponent);
+
+        SkeletonComponent* skeleton = new SkeletonComponent();
+        skeleton->SetJoints(joints);
+        entity->AddComponent(skeleton);
+        scene->AddNode(entity);
+
+        skeletons.push_back(skeleton);
+    }
+
+    // first update rebuilds skeletons
+    scene->Update(FRAME_TIME);
+
+    SkinningTestResult result;
+    result.charactersCount = charactersCount;
+    result.parallel = parallel;
+
+    for (uint32 frame = 0; frame < framesCount; ++frame)
+    {
+        float32 time = frame * FRAME_TIME;
+        for (uint32 i = 0; i < charactersCount; ++i)
+        {
+            AnimateSkeleton(skeletons[i], time + i);
+        }
+
+        int64 startUs = SystemTimer::GetUs();
+        scene->Update(FRAME_TIME);
+        result.frameTime.AddFrame(SystemTimer::GetUs() - startUs);
+    }
+
+    return result;
+}
+
+DAVA::Vector<SkinningTestResult> SkinningTest::RunAll(DAVA::uint32 framesCount)
+{
+    using namespace DAVA;
+
+    Vector<SkinningTestResult> results;
+    for (uint32 charactersCount : SkinningTestDetails::CHARACTER_COUNTS)
+    {
+        results.push_back(Run(charactersCount, false, framesCount));
+        results.push_back(Run(charactersCount, true, framesCount));
+
+        const SkinningTestResult& sequential = results[results.size() - 2];
+        const SkinningTestResult& parallel = results.back();
+        Logger::Info("SkinningTest: %u characters, %u joints, sequential frame %s, parallel frame %s, speedup %.2fx",
+                     charactersCount, JOINTS_COUNT, sequential.frameTime.ToString().c_str(), parallel.frameTime.ToString().c_str(), GetSpeedup(sequential.frameTime, parallel.frameTime));
+    }
+    return results;
+}
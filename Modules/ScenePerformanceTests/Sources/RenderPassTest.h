@@ -0,0 +1,35 @@
+#pragma once
+
+#include "FrameTimeStats.h"
+
+#include <Base/BaseTypes.h>
+
+/**
+    Measures CPU time of scene draw for synthetic scene with many render objects.
+
+    Objects of `objectsCount` are spread over square world in front of the camera, every object has one render batch
+    with one of `RenderPassTest::MATERIALS_COUNT` materials, quarter of materials are alpha blended. Render passes
+    sort layers in jobs when `parallel` is set (see RenderOptions::PARALLEL_RENDER_PREPARE), packets are recorded
+    on calling thread in both modes. Test is intended to be run under NullRenderer to measure cost of render prepare
+    and packets submission without GPU.
+
+    Test should be run inside renderer frame (between Renderer::BeginFrame and Renderer::EndFrame, e.g. from screen update):
+    it ends current frame after every drawn frame and begins new one.
+*/
+struct RenderPassTestResult
+{
+    DAVA::uint32 objectsCount = 0;
+    bool parallel = false;
+    FrameTimeStats frameTime;
+};
+
+class RenderPassTest final
+{
+public:
+    static const DAVA::uint32 MATERIALS_COUNT = 32;
+
+    static RenderPassTestResult Run(DAVA::uint32 objectsCount, bool parallel, DAVA::uint32 framesCount = 100);
+
+    // runs test for 1000, 5000 and 10000 objects with sequential and parallel render prepare and logs results
+    static DAVA::Vector<RenderPassTestResult> RunAll(DAVA::uint32 framesCount = 100);
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "FrameTimeStats.h"
+
+#include <Base/BaseTypes.h>
+
+/**
+    Measures time of scene update for synthetic scene with many skinned characters.
+
+    Every character has skeleton of `SkinningTest::JOINTS_COUNT` joints and skinned mesh with two render batches.
+    Joints orientations are changed every frame (outside of measured time), so skeleton system recalculates
+    all poses and skinning data each update. Systems are processed in PARALLEL mode if `parallel` is set and
+    in SEQUENTIAL mode otherwise (see Scene::eSystemsProcessMode). Test does not draw anything and can be run
+    under NullRenderer.
+*/
+struct SkinningTestResult
+{
+    DAVA::uint32 charactersCount = 0;
+    bool parallel = false;
+    FrameTimeStats frameTime;
+};
+
+class SkinningTest final
+{
+public:
+    static const DAVA::uint32 JOINTS_COUNT = 64;
+
+    static SkinningTestResult Run(DAVA::uint32 charactersCount, bool parallel, DAVA::uint32 framesCount = 100);
+
+    // runs test for 100, 250 and 500 characters with sequential and parallel systems processing and logs results
+    static DAVA::Vector<SkinningTestResult> RunAll(DAVA::uint32 framesCount = 100);
+};
@@ -5,6 +5,7 @@
 #include <AssetCache/CachedItemValue.h>
 
 #include <FileSystem/File.h>
+#include <FileSystem/FileList.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/KeyedArchive.h>
 #include <Debug/DVAssert.h>
@@ -14,6 +15,7 @@
 
 const DAVA::String CacheDB::DB_FILE_NAME = "cache.dat";
 const DAVA::uint32 CacheDB::VERSION = 1;
+const DAVA::uint64 CacheDB::MAX_FAST_CACHE_ITEM_SIZE = 64 * 1024 * 1024;
 
 CacheDB::CacheDB(CacheDBOwner& _owner)
     : owner(_owner)
@@ -48,6 +50,7 @@ void CacheDB::UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint6
 
         cacheRootFolder = newCacheRootFolder;
         cacheSettings = cacheRootFolder + DB_FILE_NAME;
+        journal.SetFolder(cacheRootFolder);
 
         Load();
         fullCacheChanged = true;
@@ -87,6 +90,104 @@ void CacheDB::Load()
     DVASSERT(fastCache.empty());
     DVASSERT(fullCache.empty());
 
+    if (journal.Exists())
+    {
+        auto onInsert = [this](const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry)
+        {
+            fullCache[key] = std::move(entry);
+        };
+
+        auto onAccess = [this](const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp)
+        {
+            ServerCacheEntry* entry = FindInFullCache(key);
+            if (nullptr != entry)
+            {
+                entry->SetTimestamp(timestamp);
+            }
+        };
+
+        auto onRemove = [this](const DAVA::AssetCache::CacheItemKey& key)
+        {
+            fullCache.erase(key);
+        };
+
+        if (journal.Load(onInsert, onAccess, onRemove) == false)
+        {
+            // Items lost with broken snapshot are not known anymore, their data folders are never reused or evicted
+            RemoveOrphanedFolders();
+        }
+    }
+    else
+    {
+        LoadLegacyArchive();
+        if (journal.Compact(fullCache))
+        {
+            DAVA::FileSystem::Instance()->DeleteFile(cacheSettings);
+        }
+    }
+
+    occupiedSize = 0;
+    for (auto& item : fullCache)
+    {
+        occupiedSize += item.second.GetValue().GetSize();
+        fullCacheLRU.Add(item.first, item.second.GetTimestamp());
+    }
+
+    if (journal.IsCompactionRequired(fullCache.size()))
+    {
+        journal.Compact(fullCache);
+    }
+
+    NotifySizeChanged();
+    dbStateChanged = false;
+    lastSaveTime = DAVA::SystemTimer::GetMs();
+}
+
+void CacheDB::RemoveOrphanedFolders()
+{
+    DAVA::UnorderedSet<DAVA::String> itemFolders;
+    itemFolders.reserve(fullCache.size());
+    for (const auto& item : fullCache)
+    {
+        itemFolders.insert(CreateFolderPath(item.first).GetAbsolutePathname());
+    }
+
+    // Item folders are placed in two levels: <first 2 chars of key>/<rest of key>/
+    DAVA::uint32 removedCount = 0;
+    DAVA::FileSystem* fs = DAVA::FileSystem::Instance();
+    DAVA::ScopedPtr<DAVA::FileList> rootList(new DAVA::FileList(cacheRootFolder));
+    for (DAVA::uint32 i = 0; i < rootList->GetCount(); ++i)
+    {
+        if (!rootList->IsDirectory(i) || rootList->IsNavigationDirectory(i) || rootList->GetFilename(i).size() != 2)
+        {
+            continue;
+        }
+
+        DAVA::FilePath prefixFolder = rootList->GetPathname(i);
+        prefixFolder.MakeDirectoryPathname();
+
+        DAVA::ScopedPtr<DAVA::FileList> prefixList(new DAVA::FileList(prefixFolder));
+        for (DAVA::uint32 j = 0; j < prefixList->GetCount(); ++j)
+        {
+            if (!prefixList->IsDirectory(j) || prefixList->IsNavigationDirectory(j))
+            {
+                continue;
+            }
+
+            DAVA::FilePath itemFolder = prefixList->GetPathname(j);
+            itemFolder.MakeDirectoryPathname();
+            if (itemFolders.count(itemFolder.GetAbsolutePathname()) == 0 && fs->DeleteDirectory(itemFolder))
+            {
+                ++removedCount;
+            }
+        }
+    }
+
+    DAVA::Logger::Info("[CacheDB::%s] Removed %u folders of items lost with broken snapshot", __FUNCTION__, removedCount);
+}
+
+void CacheDB::LoadLegacyArchive()
+{
     DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::OPEN | DAVA::File::READ));
     if (!file)
     {
@@ -118,7 +219,6 @@ void CacheDB::Load()
         return;
     }
 
-    occupiedSize = 0;
     for (DAVA::uint64 index = 0; index < cacheSize; ++index)
     {
         DAVA::KeyedArchive* itemArchieve = cache->GetArchive(DAVA::Format("item_%d", index));
@@ -130,17 +230,17 @@ void CacheDB::Load()
         ServerCacheEntry entry;
         entry.Deserialize(itemArchieve);
 
-        occupiedSize += entry.GetValue().GetSize();
         fullCache[key] = std::move(entry);
     }
-
-    NotifySizeChanged();
-    dbStateChanged = false;
 }
 
 void CacheDB::Unload()
 {
-    Save();
+    if (!cacheRootFolder.IsEmpty())
+    {
+        journal.Compact(fullCache);
+        journal.Close();
+    }
 
     for (auto& entry : fastCache)
     {
@@ -149,38 +249,22 @@ void CacheDB::Unload()
 
     fastCache.clear();
     fullCache.clear();
+    fastCacheLRU.Clear();
+    fullCacheLRU.Clear();
     occupiedSize = 0;
     NotifySizeChanged();
 }
 
 void CacheDB::Save()
 {
-    DAVA::FileSystem::Instance()->CreateDirectory(cacheRootFolder, true);
-
-    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::CREATE | DAVA::File::WRITE));
-    if (!file)
+    if (journal.IsCompactionRequired(fullCache.size()))
     {
-        DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
-        return;
+        journal.Compact(fullCache);
     }
-
-    DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
-    header->SetString("signature", "cache");
-    header->SetUInt32("version", VERSION);
-    header->SetUInt64("itemsCount", fullCache.size());
-    header->Save(file);
-
-    DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
-    DAVA::uint64 index = 0;
-    for (auto& item : fullCache)
+    else
     {
-        DAVA::ScopedPtr<DAVA::KeyedArchive> itemArchieve(new DAVA::KeyedArchive());
-        item.first.Serialize(itemArchieve);
-        item.second.Serialize(itemArchieve);
-
-        cache->SetArchive(DAVA::Format("item_%d", index++), itemArchieve);
+        journal.Flush();
     }
-    cache->Save(file);
 
     dbStateChanged = false;
     lastSaveTime = DAVA::SystemTimer::GetMs();
@@ -190,12 +274,10 @@ void CacheDB::ReduceFullCacheToSize(DAVA::uint64 toSize)
 {
     while (occupiedSize > toSize)
     {
-        const auto& found = std::min_element(fullCache.begin(), fullCache.end(), [](const CacheMap::value_type& left, const CacheMap::value_type& right) -> bool
-                                             {
-                                                 return left.second.GetTimestamp() < right.second.GetTimestamp();
-                                             });
-        if (found != fullCache.end())
+        if (fullCacheLRU.IsEmpty() == false)
         {
+            auto found = fullCache.find(fullCacheLRU.GetOldest());
+            DVASSERT(found != fullCache.end());
             Remove(found);
         }
         else
@@ -215,13 +297,10 @@ void CacheDB::ReduceFastCacheByCount(DAVA::uint32 countToRemove)
 {
     for (; countToRemove > 0; --countToRemove)
     {
-        const auto& oldestFound = std::min_element(fastCache.begin(), fastCache.end(), [](const FastCacheMap::value_type& left, const FastCacheMap::value_type& right) -> bool
-                                                   {
-                                                       return left.second->GetTimestamp() < right.second->GetTimestamp();
-                                                   });
-
-        if (oldestFound != fastCache.end())
+        if (fastCacheLRU.IsEmpty() == false)
         {
+            auto oldestFound = fastCache.find(fastCacheLRU.GetOldest());
+            DVASSERT(oldestFound != fastCache.end());
             RemoveFromFastCache(oldestFound);
         }
         else
@@ -238,7 +317,7 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
     if (nullptr == entry)
     {
         entry = FindInFullCache(key);
-        if (nullptr != entry)
+        if (nullptr != entry && entry->GetValue().GetSize() <= MAX_FAST_CACHE_ITEM_SIZE)
         {
             const DAVA::FilePath path = CreateFolderPath(key);
 
@@ -258,7 +337,7 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
         }
     }
 
-    UpdateAccessTimestamp(entry);
+    UpdateAccessTimestamp(key, entry);
 
     return entry;
 }
@@ -330,10 +409,19 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     DAVA::FilePath savedPath = CreateFolderPath(key);
     insertedEntry->GetValue().ExportToFolder(savedPath);
     insertedEntry->UpdateAccessTimestamp();
+    fullCacheLRU.Add(key, insertedEntry->GetTimestamp());
+    journal.AppendInsert(key, *insertedEntry);
     occupiedSize += insertedEntry->GetValue().GetSize();
     NotifySizeChanged();
 
-    InsertInFastCache(key, insertedEntry);
+    if (insertedEntry->GetValue().GetSize() <= MAX_FAST_CACHE_ITEM_SIZE)
+    {
+        InsertInFastCache(key, insertedEntry);
+    }
+    else if (insertedEntry->GetValue().IsFetched())
+    {
+        insertedEntry->Free();
+    }
 
     if (occupiedSize > maxStorageSize)
     {
@@ -359,6 +447,7 @@ void CacheDB::InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, Serve
     DVASSERT(entry->GetValue().IsFetched() == true);
 
     fastCache[key] = entry;
+    fastCacheLRU.Add(key, entry->GetTimestamp());
 }
 
 void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key)
@@ -369,14 +458,22 @@ void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key)
         entry = FindInFullCache(key);
     }
 
-    UpdateAccessTimestamp(entry);
+    UpdateAccessTimestamp(key, entry);
 }
 
-void CacheDB::UpdateAccessTimestamp(ServerCacheEntry* entry)
+void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry)
 {
     if (nullptr != entry)
     {
+        DAVA::uint64 oldTimestamp = entry->GetTimestamp();
         entry->UpdateAccessTimestamp();
+
+        fullCacheLRU.Touch(key, oldTimestamp, entry->GetTimestamp());
+        if (fastCache.count(key) != 0)
+        {
+            fastCacheLRU.Touch(key, oldTimestamp, entry->GetTimestamp());
+        }
+        journal.AppendAccess(key, entry->GetTimestamp());
         dbStateChanged = true;
     }
 }
@@ -416,6 +513,8 @@ void CacheDB::RemoveFromFullCache(const CacheMap::iterator& it)
     DVASSERT(itemSize <= occupiedSize);
     occupiedSize -= itemSize;
     DAVA::Logger::Debug("Removing from full cache: key %s", Brief(it->first).c_str());
+    fullCacheLRU.Remove(it->first, it->second.GetTimestamp());
+    journal.AppendRemove(it->first);
     fullCache.erase(it);
     NotifySizeChanged();
 }
@@ -426,6 +525,7 @@ void CacheDB::RemoveFromFastCache(const FastCacheMap::iterator& it)
 
     DVASSERT(it->second->GetValue().IsFetched() == true);
     it->second->Free();
+    fastCacheLRU.Remove(it->first, it->second->GetTimestamp());
     fastCache.erase(it);
 }
 
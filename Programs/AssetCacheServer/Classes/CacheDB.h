@@ -1,5 +1,8 @@
 #pragma once
 
+#include "CacheDBJournal.h"
+#include "CacheLRUIndex.h"
+
 #include <AssetCache/CacheItemKey.h>
 
 #include <Base/BaseTypes.h>
@@ -26,8 +29,9 @@ class CacheDB final
 {
     static const DAVA::String DB_FILE_NAME;
     static const DAVA::uint32 VERSION;
+    static const DAVA::uint64 MAX_FAST_CACHE_ITEM_SIZE; //bigger items are not kept in memory and are read from files while sending
 
-    using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
+    using CacheMap = CacheDBJournal::CacheMap;
     using FastCacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry*>;
 
 public:
@@ -39,6 +43,7 @@ public:
     void Save();
     void Load();
 
+    /** Return entry of item. Data of item bigger than MAX_FAST_CACHE_ITEM_SIZE is not fetched and remains in folder of item. */
     ServerCacheEntry* Get(const DAVA::AssetCache::CacheItemKey& key);
 
     void Insert(const DAVA::AssetCache::CacheItemKey& key, const DAVA::AssetCache::CachedItemValue& value);
@@ -46,6 +51,8 @@ public:
     void ClearStorage();
     void UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key);
 
+    DAVA::FilePath CreateFolderPath(const DAVA::AssetCache::CacheItemKey& key) const;
+
     const DAVA::FilePath& GetPath() const;
     const DAVA::uint64 GetStorageSize() const;
     const DAVA::uint64 GetAvailableSize() const;
@@ -56,9 +63,9 @@ public:
 private:
     void Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry&& entry);
 
-    DAVA::FilePath CreateFolderPath(const DAVA::AssetCache::CacheItemKey& key) const;
-
     void Unload();
+    void LoadLegacyArchive();
+    void RemoveOrphanedFolders();
 
     ServerCacheEntry* FindInFastCache(const DAVA::AssetCache::CacheItemKey& key) const;
     ServerCacheEntry* FindInFullCache(const DAVA::AssetCache::CacheItemKey& key);
@@ -66,7 +73,7 @@ private:
 
     void InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry);
 
-    void UpdateAccessTimestamp(ServerCacheEntry* entry);
+    void UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry);
 
     void ReduceFullCacheToSize(DAVA::uint64 toSize);
     void ReduceFastCacheByCount(DAVA::uint32 countToRemove);
@@ -82,7 +89,7 @@ private:
     CacheDBOwner& owner;
 
     DAVA::FilePath cacheRootFolder; //path to folder with settings and cache of files
-    DAVA::FilePath cacheSettings; //path to settings
+    DAVA::FilePath cacheSettings; //path to settings in legacy KeyedArchive format, converted into journal on load
 
     DAVA::uint64 maxStorageSize = 0; //maximum cache size
     DAVA::uint32 maxItemsInMemory = 0; //count of items in memory, to use for fast access
@@ -96,7 +103,12 @@ private:
     FastCacheMap fastCache; //runtime, week storage
     CacheMap fullCache; //stored on disk, strong storage
 
-    std::atomic<bool> dbStateChanged; //flag about changes in db
+    CacheLRUIndex fastCacheLRU; //eviction order of fastCache
+    CacheLRUIndex fullCacheLRU; //eviction order of fullCache
+
+    CacheDBJournal journal; //snapshot and journal of fullCache changes on disk
+
+    std::atomic<bool> dbStateChanged; //flag about changes in db not flushed to journal
 };
 
 inline const DAVA::FilePath& CacheDB::GetPath() const
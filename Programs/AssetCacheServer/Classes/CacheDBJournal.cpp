@@ -0,0 +1,441 @@
+#include "CacheDBJournal.h"
+#include "ServerCacheEntry.h"
+
+#include <FileSystem/DynamicMemoryFile.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/MemoryMappedFile.h>
+#include <FileSystem/UnmanagedMemoryFile.h>
+#include <Debug/DVAssert.h>
+#include <Logger/Logger.h>
+#include <Utils/CRC32.h>
+
+namespace CacheDBJournalDetails
+{
+const DAVA::String SNAPSHOT_FILE_NAME = "cache.idx";
+const DAVA::String JOURNAL_FILE_NAME = "cache.journal";
+
+const DAVA::uint32 SNAPSHOT_SIGNATURE = 0x42444341; // "ACDB"
+const DAVA::uint32 JOURNAL_SIGNATURE = 0x4A444341; // "ACDJ"
+const DAVA::uint32 VERSION = 1;
+
+// Journal is compacted when it has more records than snapshot has items, but not too often for small caches
+const DAVA::uint64 MIN_RECORDS_TO_COMPACT = 4096;
+
+struct Header
+{
+    DAVA::uint32 signature = 0;
+    DAVA::uint32 version = 0;
+    DAVA::uint64 generation = 0;
+};
+
+struct Record
+{
+    DAVA::uint8 type = 0;
+    DAVA::uint32 payloadSize = 0;
+    const DAVA::uint8* payload = nullptr;
+};
+
+template <typename T>
+bool ReadValue(const DAVA::uint8* data, DAVA::uint64 size, DAVA::uint64& offset, T& value)
+{
+    if (offset + sizeof(T) > size)
+    {
+        return false;
+    }
+
+    Memcpy(&value, data + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+bool ReadHeader(const DAVA::uint8* data, DAVA::uint64 size, DAVA::uint64& offset, Header& header)
+{
+    return ReadValue(data, size, offset, header.signature) && ReadValue(data, size, offset, header.version) && ReadValue(data, size, offset, header.generation);
+}
+
+bool WriteHeader(DAVA::File* file, const Header& header)
+{
+    return (file->Write(&header.signature) == sizeof(header.signature)) && (file->Write(&header.version) == sizeof(header.version)) && (file->Write(&header.generation) == sizeof(header.generation));
+}
+
+bool ReadRecord(const DAVA::uint8* data, DAVA::uint64 size, DAVA::uint64& offset, Record& record)
+{
+    DAVA::uint64 position = offset;
+    DAVA::uint32 crc = 0;
+    if (!ReadValue(data, size, position, record.type) || !ReadValue(data, size, position, record.payloadSize) || !ReadValue(data, size, position, crc))
+    {
+        return false;
+    }
+
+    if (position + record.payloadSize > size)
+    {
+        return false;
+    }
+
+    record.payload = data + position;
+    if (DAVA::CRC32::ForBuffer(record.payload, record.payloadSize) != crc)
+    {
+        return false;
+    }
+
+    offset = position + record.payloadSize;
+    return true;
+}
+
+bool WriteRecord(DAVA::File* file, DAVA::uint8 type, const DAVA::Vector<DAVA::uint8>& payload)
+{
+    DAVA::uint32 payloadSize = static_cast<DAVA::uint32>(payload.size());
+    DAVA::uint32 crc = DAVA::CRC32::ForBuffer(payload);
+
+    return (file->Write(&type) == sizeof(type)) && (file->Write(&payloadSize) == sizeof(payloadSize)) && (file->Write(&crc) == sizeof(crc)) && (file->Write(payload.data(), payloadSize) == payloadSize);
+}
+
+void SerializeInsert(DAVA::File* payload, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry& entry)
+{
+    payload->Write(key.data(), static_cast<DAVA::uint32>(key.size()));
+    entry.Serialize(payload);
+}
+
+bool ReadKey(DAVA::File* payload, DAVA::AssetCache::CacheItemKey& key)
+{
+    return payload->Read(key.data(), static_cast<DAVA::uint32>(key.size())) == key.size();
+}
+}
+
+CacheDBJournal::~CacheDBJournal()
+{
+    Close();
+}
+
+void CacheDBJournal::SetFolder(const DAVA::FilePath& folder)
+{
+    using namespace CacheDBJournalDetails;
+
+    Close();
+
+    snapshotPath = folder + SNAPSHOT_FILE_NAME;
+    journalPath = folder + JOURNAL_FILE_NAME;
+}
+
+void CacheDBJournal::Close()
+{
+    journal = nullptr;
+}
+
+bool CacheDBJournal::Exists() const
+{
+    DAVA::FileSystem* fs = DAVA::FileSystem::Instance();
+    return fs->Exists(snapshotPath) || fs->Exists(journalPath);
+}
+
+bool CacheDBJournal::Load(const InsertCallback& onInsert, const AccessCallback& onAccess, const RemoveCallback& onRemove)
+{
+    Close();
+
+    generation = 0;
+    journalRecordsCount = 0;
+    bool snapshotLoaded = LoadSnapshot(onInsert);
+    journalBroken = !snapshotLoaded;
+
+    DAVA::uint64 journalSize = ReplayJournal(onInsert, onAccess, onRemove);
+    if (journalSize == 0 || OpenJournal(journalSize) == false)
+    {
+        CreateJournal();
+    }
+
+    return snapshotLoaded;
+}
+
+bool CacheDBJournal::LoadSnapshot(const InsertCallback& onInsert)
+{
+    using namespace CacheDBJournalDetails;
+
+    DAVA::MemoryMappedFile snapshot;
+    if (!snapshot.Open(snapshotPath))
+    {
+        return DAVA::FileSystem::Instance()->Exists(snapshotPath) == false;
+    }
+
+    const DAVA::uint8* data = snapshot.GetData();
+    const DAVA::uint64 size = snapshot.GetSize();
+    DAVA::uint64 offset = 0;
+
+    Header header;
+    DAVA::uint64 itemsCount = 0;
+    if (!ReadHeader(data, size, offset, header) || !ReadValue(data, size, offset, itemsCount) || header.signature != SNAPSHOT_SIGNATURE)
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Wrong header of %s", __FUNCTION__, snapshotPath.GetStringValue().c_str());
+        return false;
+    }
+
+    if (header.version != VERSION)
+    {
+        DVASSERT(false, "cachedb snapshot version is changed. Versions load functions should be implemented");
+        return false;
+    }
+
+    generation = header.generation;
+
+    for (DAVA::uint64 index = 0; index < itemsCount; ++index)
+    {
+        Record record;
+        if (!ReadRecord(data, size, offset, record) || record.type != RECORD_INSERT)
+        {
+            DAVA::Logger::Error("[CacheDBJournal::%s] Snapshot is corrupted, %llu of %llu items are loaded", __FUNCTION__, index, itemsCount);
+            return false;
+        }
+
+        DAVA::ScopedPtr<DAVA::UnmanagedMemoryFile> payload(new DAVA::UnmanagedMemoryFile(record.payload, record.payloadSize));
+
+        DAVA::AssetCache::CacheItemKey key;
+        ServerCacheEntry entry;
+        if (!ReadKey(payload, key) || !entry.Deserialize(payload))
+        {
+            DAVA::Logger::Error("[CacheDBJournal::%s] Snapshot item %llu can't be parsed", __FUNCTION__, index);
+            return false;
+        }
+
+        onInsert(key, std::move(entry));
+    }
+
+    return true;
+}
+
+DAVA::uint64 CacheDBJournal::ReplayJournal(const InsertCallback& onInsert, const AccessCallback& onAccess, const RemoveCallback& onRemove)
+{
+    using namespace CacheDBJournalDetails;
+
+    DAVA::MemoryMappedFile journalFile;
+    if (!journalFile.Open(journalPath))
+    {
+        return 0;
+    }
+
+    const DAVA::uint8* data = journalFile.GetData();
+    const DAVA::uint64 size = journalFile.GetSize();
+    DAVA::uint64 offset = 0;
+
+    Header header;
+    if (!ReadHeader(data, size, offset, header) || header.signature != JOURNAL_SIGNATURE || header.version != VERSION)
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Wrong header of %s", __FUNCTION__, journalPath.GetStringValue().c_str());
+        return 0;
+    }
+
+    if (header.generation != generation)
+    {
+        // Crash happened after new snapshot had been written, but before journal was restarted. Snapshot already has all its changes
+        DAVA::Logger::Info("[CacheDBJournal::%s] Journal is outdated and will be dropped", __FUNCTION__);
+        return 0;
+    }
+
+    Record record;
+    while (offset < size && ReadRecord(data, size, offset, record))
+    {
+        DAVA::ScopedPtr<DAVA::UnmanagedMemoryFile> payload(new DAVA::UnmanagedMemoryFile(record.payload, record.payloadSize));
+
+        DAVA::AssetCache::CacheItemKey key;
+        if (!ReadKey(payload, key))
+        {
+            break;
+        }
+
+        if (record.type == RECORD_INSERT)
+        {
+            ServerCacheEntry entry;
+            if (!entry.Deserialize(payload))
+            {
+                break;
+            }
+            onInsert(key, std::move(entry));
+        }
+        else if (record.type == RECORD_ACCESS)
+        {
+            DAVA::uint64 timestamp = 0;
+            if (payload->Read(&timestamp, sizeof(timestamp)) != sizeof(timestamp))
+            {
+                break;
+            }
+            onAccess(key, timestamp);
+        }
+        else if (record.type == RECORD_REMOVE)
+        {
+            onRemove(key);
+        }
+        else
+        {
+            break;
+        }
+
+        ++journalRecordsCount;
+    }
+
+    if (offset < size)
+    {
+        DAVA::Logger::Warning("[CacheDBJournal::%s] Journal is cut off after %llu records (%llu of %llu bytes)", __FUNCTION__, journalRecordsCount, offset, size);
+    }
+
+    return offset;
+}
+
+bool CacheDBJournal::OpenJournal(DAVA::uint64 validSize)
+{
+    journal.Set(DAVA::File::Create(journalPath, DAVA::File::APPEND | DAVA::File::WRITE));
+    if (!journal)
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Cannot open file %s", __FUNCTION__, journalPath.GetStringValue().c_str());
+        return false;
+    }
+
+    if (journal->GetSize() > validSize && journal->Truncate(validSize) == false)
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Cannot cut off broken records of %s", __FUNCTION__, journalPath.GetStringValue().c_str());
+        journal = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+bool CacheDBJournal::CreateJournal()
+{
+    using namespace CacheDBJournalDetails;
+
+    journalRecordsCount = 0;
+
+    journal.Set(DAVA::File::Create(journalPath, DAVA::File::CREATE | DAVA::File::WRITE));
+    if (!journal)
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Cannot create file %s", __FUNCTION__, journalPath.GetStringValue().c_str());
+        return false;
+    }
+
+    Header header;
+    header.signature = JOURNAL_SIGNATURE;
+    header.version = VERSION;
+    header.generation = generation;
+    if (!WriteHeader(journal.Get(), header) || !journal->Flush())
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Cannot write header of %s", __FUNCTION__, journalPath.GetStringValue().c_str());
+        journal = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void CacheDBJournal::AppendInsert(const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry& entry)
+{
+    AppendRecord(RECORD_INSERT, key, &entry, 0);
+}
+
+void CacheDBJournal::AppendAccess(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp)
+{
+    AppendRecord(RECORD_ACCESS, key, nullptr, timestamp);
+}
+
+void CacheDBJournal::AppendRemove(const DAVA::AssetCache::CacheItemKey& key)
+{
+    AppendRecord(RECORD_REMOVE, key, nullptr, 0);
+}
+
+void CacheDBJournal::AppendRecord(RecordType type, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry* entry, DAVA::uint64 timestamp)
+{
+    using namespace CacheDBJournalDetails;
+
+    if (!journal)
+    {
+        // Journal can't be written, changes will be stored by next compaction
+        journalBroken = true;
+        return;
+    }
+
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> payload(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+    if (type == RECORD_INSERT)
+    {
+        DVASSERT(nullptr != entry);
+        SerializeInsert(payload, key, *entry);
+    }
+    else
+    {
+        payload->Write(key.data(), static_cast<DAVA::uint32>(key.size()));
+        if (type == RECORD_ACCESS)
+        {
+            payload->Write(&timestamp, sizeof(timestamp));
+        }
+    }
+
+    if (WriteRecord(journal.Get(), type, payload->GetDataVector()))
+    {
+        ++journalRecordsCount;
+    }
+    else
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Cannot write to %s", __FUNCTION__, journalPath.GetStringValue().c_str());
+        journal = nullptr;
+        journalBroken = true;
+    }
+}
+
+void CacheDBJournal::Flush()
+{
+    if (journal)
+    {
+        journal->Flush();
+    }
+}
+
+bool CacheDBJournal::IsCompactionRequired(size_t itemsCount) const
+{
+    using namespace CacheDBJournalDetails;
+    return journalBroken || journalRecordsCount > std::max(static_cast<DAVA::uint64>(itemsCount), MIN_RECORDS_TO_COMPACT);
+}
+
+bool CacheDBJournal::Compact(const CacheMap& items)
+{
+    using namespace CacheDBJournalDetails;
+
+    DAVA::FileSystem* fs = DAVA::FileSystem::Instance();
+    fs->CreateDirectory(snapshotPath.GetDirectory(), true);
+
+    Close();
+
+    Header header;
+    header.signature = SNAPSHOT_SIGNATURE;
+    header.version = VERSION;
+    header.generation = generation + 1;
+
+    DAVA::FilePath tempPath = snapshotPath + ".tmp";
+    bool written = false;
+    {
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(tempPath, DAVA::File::CREATE | DAVA::File::WRITE));
+        if (file)
+        {
+            DAVA::uint64 itemsCount = items.size();
+            written = WriteHeader(file, header) && (file->Write(&itemsCount) == sizeof(itemsCount));
+
+            for (auto it = items.begin(); written && it != items.end(); ++it)
+            {
+                DAVA::ScopedPtr<DAVA::DynamicMemoryFile> payload(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE));
+                SerializeInsert(payload, it->first, it->second);
+                written = WriteRecord(file, RECORD_INSERT, payload->GetDataVector());
+            }
+
+            written = written && file->Flush();
+        }
+    }
+
+    if (!written || fs->MoveFile(tempPath, snapshotPath, true) == false)
+    {
+        DAVA::Logger::Error("[CacheDBJournal::%s] Cannot write snapshot %s", __FUNCTION__, snapshotPath.GetStringValue().c_str());
+        fs->DeleteFile(tempPath);
+        journal.Set(DAVA::File::Create(journalPath, DAVA::File::APPEND | DAVA::File::WRITE));
+        journalBroken = true;
+        return false;
+    }
+
+    generation = header.generation;
+    journalBroken = (CreateJournal() == false);
+    return true;
+}
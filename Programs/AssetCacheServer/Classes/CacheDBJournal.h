@@ -0,0 +1,83 @@
+#pragma once
+
+#include <AssetCache/CacheItemKey.h>
+
+#include <Base/BaseTypes.h>
+#include <Base/RefPtr.h>
+#include <FileSystem/FilePath.h>
+#include <Functional/Function.h>
+
+namespace DAVA
+{
+class File;
+}
+
+class ServerCacheEntry;
+
+/**
+    Binary storage of CacheDB items: snapshot with all items and append-only journal of changes made after snapshot was written.
+
+    Insert, access and remove of item append small record to journal instead of rewriting whole database.
+    Compaction writes current items into new snapshot and starts empty journal.
+    Both files are memory mapped on load and parsed in place.
+    Every record has CRC32 of its payload, so record torn by crash stops journal replay and is cut off.
+*/
+class CacheDBJournal final
+{
+public:
+    using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
+
+    using InsertCallback = DAVA::Function<void(const DAVA::AssetCache::CacheItemKey&, ServerCacheEntry&&)>;
+    using AccessCallback = DAVA::Function<void(const DAVA::AssetCache::CacheItemKey&, DAVA::uint64)>;
+    using RemoveCallback = DAVA::Function<void(const DAVA::AssetCache::CacheItemKey&)>;
+
+    ~CacheDBJournal();
+
+    /** Set folder with snapshot and journal files, previously opened journal is closed. */
+    void SetFolder(const DAVA::FilePath& folder);
+    void Close();
+
+    /** Return true if snapshot or journal exists in folder. */
+    bool Exists() const;
+
+    /**
+        Read snapshot and replay journal through callbacks, then open journal for appending.
+        Broken snapshot makes compaction required, torn tail of journal is cut off.
+        Return false if snapshot is broken, so some items may be lost.
+    */
+    bool Load(const InsertCallback& onInsert, const AccessCallback& onAccess, const RemoveCallback& onRemove);
+
+    void AppendInsert(const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry& entry);
+    void AppendAccess(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp);
+    void AppendRemove(const DAVA::AssetCache::CacheItemKey& key);
+    void Flush();
+
+    /** Return true if journal has more records than it is worth to replay for `itemsCount` items. */
+    bool IsCompactionRequired(size_t itemsCount) const;
+
+    /** Write `items` into new snapshot and start new empty journal. */
+    bool Compact(const CacheMap& items);
+
+private:
+    enum RecordType : DAVA::uint8
+    {
+        RECORD_INSERT = 0,
+        RECORD_ACCESS,
+        RECORD_REMOVE
+    };
+
+    bool LoadSnapshot(const InsertCallback& onInsert);
+    DAVA::uint64 ReplayJournal(const InsertCallback& onInsert, const AccessCallback& onAccess, const RemoveCallback& onRemove);
+    bool OpenJournal(DAVA::uint64 validSize);
+    bool CreateJournal();
+
+    void AppendRecord(RecordType type, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry* entry, DAVA::uint64 timestamp);
+
+    DAVA::FilePath snapshotPath;
+    DAVA::FilePath journalPath;
+
+    DAVA::RefPtr<DAVA::File> journal;
+    DAVA::uint64 generation = 0; //id of snapshot which is followed by journal
+    DAVA::uint64 journalRecordsCount = 0;
+    bool journalBroken = false;
+};
@@ -0,0 +1,126 @@
+#include "CacheEvictionBenchmark.h"
+#include "CacheLRUIndex.h"
+
+#include <AssetCache/CacheItemKey.h>
+
+#include <Base/BaseTypes.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+
+#include <random>
+
+namespace CacheEvictionBenchmarkDetails
+{
+using namespace DAVA;
+
+const uint32 KEYS_COUNT = 1000000;
+const uint64 ITEM_SIZE_MIN = 1024;
+const uint64 ITEM_SIZE_MAX = 64 * 1024;
+const uint64 STORAGE_SIZE = 100000 * (ITEM_SIZE_MIN + ITEM_SIZE_MAX) / 2; // about 100000 items
+const uint32 ACCESSES_PER_INSERT = 1;
+
+// Linear search takes too long for all keys
+const uint32 LINEAR_SEARCH_EVICTIONS_COUNT = 2000;
+
+struct Item
+{
+    uint64 size = 0;
+    uint64 timestamp = 0;
+};
+
+struct Result
+{
+    uint64 evictionsCount = 0;
+    int64 evictionTotalUs = 0;
+    int64 evictionMaxUs = 0;
+};
+
+AssetCache::CacheItemKey MakeKey(uint32 index)
+{
+    AssetCache::CacheItemKey key;
+    key.fill(0);
+    Memcpy(key.data(), &index, sizeof(index));
+    return key;
+}
+
+template <typename EvictFn>
+Result Run(uint32 evictionsLimit, EvictFn evict)
+{
+    UnorderedMap<AssetCache::CacheItemKey, Item> items;
+    CacheLRUIndex lru;
+    Vector<AssetCache::CacheItemKey> keys;
+    uint64 occupiedSize = 0;
+    uint64 timestamp = 0;
+
+    std::mt19937 random(0);
+    std::uniform_int_distribution<uint64> sizeDistribution(ITEM_SIZE_MIN, ITEM_SIZE_MAX);
+
+    Result result;
+    for (uint32 i = 0; i < KEYS_COUNT && result.evictionsCount < evictionsLimit; ++i)
+    {
+        AssetCache::CacheItemKey key = MakeKey(i);
+        Item& item = items[key];
+        item.size = sizeDistribution(random);
+        item.timestamp = ++timestamp;
+        lru.Add(key, item.timestamp);
+        keys.push_back(key);
+        occupiedSize += item.size;
+
+        // Clients request random items which are still in cache
+        for (uint32 j = 0; j < ACCESSES_PER_INSERT; ++j)
+        {
+            auto found = items.find(keys[std::uniform_int_distribution<size_t>(0, keys.size() - 1)(random)]);
+            if (found != items.end())
+            {
+                uint64 newTimestamp = ++timestamp;
+                lru.Touch(found->first, found->second.timestamp, newTimestamp);
+                found->second.timestamp = newTimestamp;
+            }
+        }
+
+        while (occupiedSize > STORAGE_SIZE)
+        {
+            int64 startTime = SystemTimer::GetUs();
+            auto victim = evict(items, lru);
+            occupiedSize -= victim->second.size;
+            lru.Remove(victim->first, victim->second.timestamp);
+            items.erase(victim);
+            int64 evictionTime = SystemTimer::GetUs() - startTime;
+
+            result.evictionsCount++;
+            result.evictionTotalUs += evictionTime;
+            result.evictionMaxUs = std::max(result.evictionMaxUs, evictionTime);
+        }
+    }
+
+    return result;
+}
+
+void Report(const char* name, const Result& result)
+{
+    float64 averageUs = result.evictionsCount > 0 ? static_cast<float64>(result.evictionTotalUs) / result.evictionsCount : 0.0;
+    Logger::Info("%s: %llu evictions, average %.3f us, max %lld us", name, result.evictionsCount, averageUs, result.evictionMaxUs);
+}
+}
+
+void RunCacheEvictionBenchmark()
+{
+    using namespace DAVA;
+    using namespace CacheEvictionBenchmarkDetails;
+
+    using ItemsMap = UnorderedMap<AssetCache::CacheItemKey, Item>;
+
+    Logger::Info("Cache eviction benchmark: %u keys, storage size %llu", KEYS_COUNT, STORAGE_SIZE);
+
+    Result lruResult = Run(std::numeric_limits<uint32>::max(), [](ItemsMap& items, const CacheLRUIndex& lru) {
+        return items.find(lru.GetOldest());
+    });
+    Report("LRU index", lruResult);
+
+    Result linearResult = Run(LINEAR_SEARCH_EVICTIONS_COUNT, [](ItemsMap& items, const CacheLRUIndex&) {
+        return std::min_element(items.begin(), items.end(), [](const ItemsMap::value_type& left, const ItemsMap::value_type& right) {
+            return left.second.timestamp < right.second.timestamp;
+        });
+    });
+    Report("Linear search", linearResult);
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+/**
+    Measures latency of eviction from size-capped cache: one million keys are inserted into cache,
+    which can hold only part of them, so the least recently used keys are evicted on every insertion.
+    LRU index used by CacheDB is compared with linear search of the oldest item.
+*/
+void RunCacheEvictionBenchmark();
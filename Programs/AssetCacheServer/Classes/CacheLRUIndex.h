@@ -0,0 +1,66 @@
+#pragma once
+
+#include <AssetCache/CacheItemKey.h>
+
+#include <Base/BaseTypes.h>
+#include <Debug/DVAssert.h>
+
+/**
+    Keys of cache items ordered by last access timestamp.
+    The least recently used key is found in O(1), adding, removing and touching of key take O(log n).
+*/
+class CacheLRUIndex final
+{
+public:
+    void Add(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp);
+    void Remove(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp);
+    void Touch(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 oldTimestamp, DAVA::uint64 newTimestamp);
+    void Clear();
+
+    bool IsEmpty() const;
+    size_t GetSize() const;
+
+    /** Return the least recently used key. Index shouldn't be empty. */
+    const DAVA::AssetCache::CacheItemKey& GetOldest() const;
+
+private:
+    // Keys are compared after timestamps, so items with equal timestamps are kept
+    DAVA::Set<std::pair<DAVA::uint64, DAVA::AssetCache::CacheItemKey>> items;
+};
+
+inline void CacheLRUIndex::Add(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp)
+{
+    items.emplace(timestamp, key);
+}
+
+inline void CacheLRUIndex::Remove(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp)
+{
+    items.erase(std::make_pair(timestamp, key));
+}
+
+inline void CacheLRUIndex::Touch(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 oldTimestamp, DAVA::uint64 newTimestamp)
+{
+    Remove(key, oldTimestamp);
+    Add(key, newTimestamp);
+}
+
+inline void CacheLRUIndex::Clear()
+{
+    items.clear();
+}
+
+inline bool CacheLRUIndex::IsEmpty() const
+{
+    return items.empty();
+}
+
+inline size_t CacheLRUIndex::GetSize() const
+{
+    return items.size();
+}
+
+inline const DAVA::AssetCache::CacheItemKey& CacheLRUIndex::GetOldest() const
+{
+    DVASSERT(items.empty() == false);
+    return items.begin()->second;
+}
@@ -1,5 +1,6 @@
 #include "ServerCacheEntry.h"
 
+#include "FileSystem/File.h"
 #include "FileSystem/KeyedArchive.h"
 
 #include "Debug/DVAssert.h"
@@ -57,6 +58,26 @@ void ServerCacheEntry::Deserialize(DAVA::KeyedArchive* archieve)
     value.Deserialize(valueArchieve);
 }
 
+bool ServerCacheEntry::Serialize(DAVA::File* file) const
+{
+    DVASSERT(nullptr != file);
+
+    if (file->Write(&accessTimestamp) != sizeof(accessTimestamp))
+        return false;
+
+    return value.Serialize(file, false);
+}
+
+bool ServerCacheEntry::Deserialize(DAVA::File* file)
+{
+    DVASSERT(nullptr != file);
+
+    if (file->Read(&accessTimestamp) != sizeof(accessTimestamp))
+        return false;
+
+    return value.Deserialize(file);
+}
+
 bool ServerCacheEntry::Fetch(const DAVA::FilePath& folder)
 {
     return value.Fetch(folder);
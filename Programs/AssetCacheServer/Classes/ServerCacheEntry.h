@@ -7,6 +7,7 @@
 namespace DAVA
 {
 class KeyedArchive;
+class File;
 }
 
 class ServerCacheEntry final
@@ -28,7 +29,11 @@ public:
     void Serialize(DAVA::KeyedArchive* archieve) const;
     void Deserialize(DAVA::KeyedArchive* archieve);
 
+    bool Serialize(DAVA::File* file) const;
+    bool Deserialize(DAVA::File* file);
+
     void UpdateAccessTimestamp();
+    void SetTimestamp(DAVA::uint64 timestamp);
     DAVA::uint64 GetTimestamp() const;
 
     DAVA::AssetCache::CachedItemValue& GetValue();
@@ -48,6 +53,11 @@ inline void ServerCacheEntry::UpdateAccessTimestamp()
     accessTimestamp = std::chrono::steady_clock::now().time_since_epoch().count();
 }
 
+inline void ServerCacheEntry::SetTimestamp(DAVA::uint64 timestamp)
+{
+    accessTimestamp = timestamp;
+}
+
 inline DAVA::uint64 ServerCacheEntry::GetTimestamp() const
 {
     return accessTimestamp;
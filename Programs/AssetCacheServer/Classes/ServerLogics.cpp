@@ -22,6 +22,13 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
 
     using namespace DAVA;
 
+    if (chunkNumber > 0 && FindAddTask(channel, key) == dataAddTasks.end())
+    {
+        // Task was discarded on failed chunk and client is already notified, chunks sent before it got response are dropped silently
+        Logger::Debug("Ignoring chunk #%u of discarded add request: client %p, key %s", chunkNumber, channel.get(), Brief(key).c_str());
+        return;
+    }
+
     DAVA::List<DataAddTask>::iterator it = GetOrCreateAddTask(channel, key);
     DataAddTask& task = *it;
 
@@ -74,8 +81,7 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
     }
 
     uint32 chunkSize = static_cast<uint32>(chunkData.size());
-    uint32 written = task.receivedData->Write(chunkData.data(), chunkSize);
-    if (written != chunkSize)
+    if (task.receivedData->Append(chunkData.data(), chunkSize) == false)
     {
         Error(Format("can't append %u bytes", chunkSize).c_str());
         return;
@@ -92,9 +98,14 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
             return;
         }
 
+        if (task.receivedData->Complete() == false)
+        {
+            Error("can't complete received data file");
+            return;
+        }
+
         AssetCache::CachedItemValue value;
-        task.receivedData->Seek(0, File::SEEK_FROM_START);
-        value.Deserialize(task.receivedData);
+        task.receivedData->Deserialize(value);
         if (value.IsEmpty() || !value.IsValid())
         {
             Error("Received data is empty or invalid");
@@ -122,26 +133,31 @@ void ServerLogics::OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>&
     serverProxy->SendAddedToCache(channel, key, true);
 }
 
+DAVA::List<ServerLogics::DataAddTask>::iterator ServerLogics::FindAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key)
+{
+    return std::find_if(dataAddTasks.begin(), dataAddTasks.end(), [&](const DataAddTask& task)
+                        {
+                            return (task.channel == channel && task.key == key);
+                        });
+}
+
 DAVA::List<ServerLogics::DataAddTask>::iterator ServerLogics::GetOrCreateAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key)
 {
     using namespace DAVA;
-    List<ServerLogics::DataAddTask>::iterator it = std::find_if(dataAddTasks.begin(), dataAddTasks.end(), [&](const DataAddTask& task)
-                                                                {
-                                                                    return (task.channel == channel && task.key == key);
-                                                                });
+    List<ServerLogics::DataAddTask>::iterator it = FindAddTask(channel, key);
 
     if (it == dataAddTasks.end())
     {
         it = dataAddTasks.emplace(dataAddTasks.end(), DataAddTask());
         it->channel = channel;
         it->key = key;
-        it->receivedData = DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ);
+        it->receivedData = std::make_unique<AssetCache::ReceivedValueFile>(dataBase->CreateFolderPath(key) + Format("%p.received", channel.get()));
     }
 
     return it;
 }
 
-ServerLogics::DataGetMap::iterator ServerLogics::GetOrCreateGetTask(const DAVA::AssetCache::CacheItemKey& key)
+ServerLogics::DataGetMap::iterator ServerLogics::GetOrCreateGetTask(const DAVA::AssetCache::CacheItemKey& key, DAVA::Compressor::Type compression)
 {
     using namespace DAVA;
 
@@ -152,33 +168,43 @@ ServerLogics::DataGetMap::iterator ServerLogics::GetOrCreateGetTask(const DAVA::
         if (nullptr != entry)
         { // Found in db.
             Logger::Debug("Creating get task using local data");
-            taskIter = dataGetTasks.emplace(key, DataGetTask()).first;
-            DataGetTask& task = taskIter->second;
-            task.serializedData = DynamicMemoryFile::Create(File::CREATE | File::READ | File::WRITE);
-
             AssetCache::CachedItemValue& value = entry->GetValue();
             AssetCache::CachedItemValue::Description description = value.GetDescription();
             description.receivingChain += "/" + serverName;
             value.SetDescription(description);
-            value.Serialize(task.serializedData);
-            task.dataStatus = DataGetTask::READY;
-            task.bytesOverall = task.bytesReady = task.serializedData->GetSize();
-            task.chunksOverall = task.chunksReady = AssetCache::ChunkSplitter::GetNumberOfChunks(task.bytesOverall);
+
+            // chunks are read from value buffers or from files of item on sending, value isn't serialized into memory
+            AssetCache::CachedItemValueReader reader(value, dataBase->CreateFolderPath(key));
+            if (reader.IsValid())
+            {
+                taskIter = dataGetTasks.emplace(key, DataGetTask()).first;
+                DataGetTask& task = taskIter->second;
+                task.reader = std::move(reader);
+                task.dataStatus = DataGetTask::READY;
+                task.bytesOverall = task.bytesReady = task.reader.GetSize();
+                task.chunksOverall = task.chunksReady = AssetCache::ChunkSplitter::GetNumberOfChunks(task.bytesOverall);
+            }
+            else
+            {
+                Logger::Error("Files of item %s can't be read", Brief(key).c_str());
+            }
         }
-        else if (IsRemoteServerConnected() && clientProxy->RequestGetNextChunk(key, 0))
+        else if (IsRemoteServerConnected() && clientProxy->RequestGetNextChunk(key, 0, compression))
         { // Not found in db. Ask from remote cache.
             Logger::Debug("Creating get task. Requesting data from remote");
             taskIter = dataGetTasks.emplace(key, DataGetTask()).first;
             DataGetTask& task = taskIter->second;
-            task.serializedData = DynamicMemoryFile::Create(File::CREATE | File::READ | File::WRITE);
+            task.receivedData = std::make_unique<AssetCache::ReceivedValueFile>(dataBase->CreateFolderPath(key) + "remote.received");
             task.dataStatus = DataGetTask::WAITING_NEXT_CHUNK;
+            task.remoteCompression = compression;
+            task.chunksRequested = 1;
         }
     }
 
     return taskIter;
 }
 
-void ServerLogics::OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkNumber)
+void ServerLogics::OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkNumber, DAVA::Compressor::Type compression)
 {
     hasIncomingRequestsRecently = true;
 
@@ -188,31 +214,29 @@ void ServerLogics::OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IC
     auto Error = [&](const char* err)
     {
         Logger::Error("Wrong chunk request: %s. Client %p, key %s, chunk %u", err, clientChannel.get(), Brief(key).c_str(), chunkNumber);
-        Vector<uint8> empty;
-        serverProxy->SendChunk(clientChannel, key, 0, 0, 0, empty);
+        serverProxy->SendChunk(clientChannel, key, 0, 0, 0, nullptr, 0, Compressor::Type::None);
     };
 
-    DataGetMap::iterator taskIter = GetOrCreateGetTask(key);
+    DataGetMap::iterator taskIter = GetOrCreateGetTask(key, compression);
     if (taskIter != dataGetTasks.end())
     {
         DataGetTask& task = taskIter->second;
         DataGetTask::ClientStatus& client = task.clients[clientChannel];
+        client.compression = compression;
 
         if (task.chunksReady > chunkNumber) // task has such chunk
         {
-            Vector<uint8> chunk = AssetCache::ChunkSplitter::GetChunk(task.serializedData->GetDataVector(), chunkNumber);
-            if (chunk.empty())
+            if (chunkNumber == 0)
             {
-                Error("can't get valid range for given chunk");
-                return;
+                DAVA::Logger::Debug("Requested data will be sent: %u chunks, %u bytes", task.chunksOverall, task.bytesOverall);
             }
 
-            if (chunkNumber == 0)
+            if (SendChunkToClient(taskIter, clientChannel, chunkNumber) == false)
             {
-                DAVA::Logger::Debug("Requested data will be sent: %u chunks, %u bytes", task.chunksOverall, task.bytesOverall);
+                Error("can't read given chunk");
+                return;
             }
 
-            SendChunkToClient(taskIter, clientChannel, chunkNumber, chunk);
             RemoveTaskIfChunksAreSent(taskIter);
         }
         else // task hasn't such chunk yet
@@ -224,16 +248,14 @@ void ServerLogics::OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IC
             }
             else
             {
-                client.status = DataGetTask::WAITING_NEXT_CHUNK;
-                client.waitingChunk = chunkNumber;
+                client.waitingChunks.insert(chunkNumber);
             }
         }
     }
     else
     { // Not found in db. Remote server isn't connected.
-        Vector<uint8> empty;
         DAVA::Logger::Debug("Sending empty chunk");
-        serverProxy->SendChunk(clientChannel, key, 0, 0, 0, empty);
+        serverProxy->SendChunk(clientChannel, key, 0, 0, 0, nullptr, 0, Compressor::Type::None);
     }
 }
 
@@ -327,7 +349,7 @@ void ServerLogics::OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key
             return;
         }
 
-        DVASSERT(task.bytesReady == 0 && task.chunksReady == 0 && task.serializedData->GetSize() == 0);
+        DVASSERT(task.bytesReady == 0 && task.chunksReady == 0 && task.receivedData->GetSize() == 0);
 
         if (dataSize == 0 || numOfChunks == 0)
         {
@@ -369,8 +391,7 @@ void ServerLogics::OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key
     }
 
     uint32 chunkSize = static_cast<uint32>(chunkData.size());
-    uint32 written = task.serializedData->Write(chunkData.data(), chunkSize);
-    if (written != chunkSize)
+    if (task.receivedData->Append(chunkData.data(), chunkSize) == false)
     {
         Error(Format("can't append %u bytes", chunkSize).c_str(), taskIter);
         return;
@@ -389,9 +410,14 @@ void ServerLogics::OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key
 
         task.dataStatus = DataGetTask::READY;
 
+        if (task.receivedData->Complete() == false)
+        {
+            Error("can't complete received data file", taskIter);
+            return;
+        }
+
         AssetCache::CachedItemValue value;
-        task.serializedData->Seek(0, File::SEEK_FROM_START);
-        value.Deserialize(task.serializedData);
+        task.receivedData->Deserialize(value);
         if (value.IsEmpty() || !value.IsValid())
         {
             Logger::Debug("Received data is empty or invalid");
@@ -403,10 +429,10 @@ void ServerLogics::OnReceivedFromCache(const DAVA::AssetCache::CacheItemKey& key
     }
     else
     {
-        RequestNextChunk(taskIter);
+        RequestNextChunks(taskIter);
     }
 
-    SendChunkToClients(taskIter, chunkNumber, chunkData);
+    SendChunkToClients(taskIter, chunkNumber);
 }
 
 void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, bool received)
@@ -419,7 +445,8 @@ void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, boo
 
         if (received)
         {
-            if (task.chunksSent == task.chunksOverall)
+            ++task.chunksAcknowledged;
+            if (task.chunksAcknowledged == task.chunksOverall)
             {
                 DAVA::Logger::Debug("All chunks are sent. Removing remote add task. Tasks remaining: %u", dataRemoteAddTasks.size() - 1);
                 dataRemoteAddTasks.erase(itTask);
@@ -428,7 +455,7 @@ void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, boo
             }
             else
             {
-                bool sentOk = SendChunkToRemote(itTask);
+                bool sentOk = SendChunksToRemote(itTask);
                 if (!sentOk)
                 {
                     dataRemoteAddTasks.erase(itTask);
@@ -451,7 +478,7 @@ void ServerLogics::OnAddedToCache(const DAVA::AssetCache::CacheItemKey& key, boo
     }
 }
 
-void ServerLogics::RequestNextChunk(ServerLogics::DataGetMap::iterator it)
+void ServerLogics::RequestNextChunks(ServerLogics::DataGetMap::iterator it)
 {
     DVASSERT(it != dataGetTasks.end());
 
@@ -460,38 +487,63 @@ void ServerLogics::RequestNextChunk(ServerLogics::DataGetMap::iterator it)
     DVASSERT(task.dataStatus != DataGetTask::READY);
     DVASSERT(task.chunksReady < task.chunksOverall);
 
-    DAVA::Logger::Debug("Sending request for chunk #%u", task.chunksReady);
-    clientProxy->RequestGetNextChunk(key, task.chunksReady);
+    // several chunks are requested ahead to not wait for remote after each of them
+    while (task.chunksRequested < task.chunksOverall && (task.chunksRequested - task.chunksReady) < DAVA::AssetCache::MAX_CHUNKS_IN_FLIGHT)
+    {
+        DAVA::Logger::Debug("Sending request for chunk #%u", task.chunksRequested);
+        clientProxy->RequestGetNextChunk(key, task.chunksRequested++, task.remoteCompression);
+    }
     task.dataStatus = DataGetTask::WAITING_NEXT_CHUNK;
 }
 
-void ServerLogics::SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk)
+bool ServerLogics::SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber)
 {
+    using namespace DAVA;
+
     DataGetTask& task = taskIt->second;
     DataGetTask::ClientStatus& client = task.clients[clientChannel];
 
-    DAVA::Logger::Debug("Sending chunk #%u: %u bytes", chunkNumber, chunk.size());
-    serverProxy->SendChunk(clientChannel, taskIt->first, task.bytesOverall, task.chunksOverall, chunkNumber, chunk);
-    client.status = DataGetTask::READY;
+    bool sent = false;
+    if (task.reader.IsValid())
+    {
+        DAVA::Logger::Debug("Sending chunk #%u from local data", chunkNumber);
+        sent = serverProxy->SendChunk(clientChannel, taskIt->first, task.reader, chunkNumber, client.compression);
+    }
+    else
+    {
+        const uint64 chunkOffset = AssetCache::ChunkSplitter::GetChunkOffset(chunkNumber);
+        const uint32 chunkSize = AssetCache::ChunkSplitter::GetChunkSize(task.bytesOverall, chunkNumber);
+        DVASSERT(chunkOffset + chunkSize <= task.receivedData->GetSize());
 
+        // data received from remote isn't kept in memory, chunk is read back from file
+        Vector<uint8> chunk;
+        if (task.receivedData->Read(chunkOffset, chunkSize, chunk))
+        {
+            DAVA::Logger::Debug("Sending chunk #%u: %u bytes", chunkNumber, chunkSize);
+            sent = serverProxy->SendChunk(clientChannel, taskIt->first, task.bytesOverall, task.chunksOverall, chunkNumber, chunk.data(), chunkSize, client.compression);
+        }
+    }
+
+    client.waitingChunks.erase(chunkNumber);
     if (chunkNumber + 1 == task.chunksOverall)
     {
         client.lastChunkWasSent = true;
     }
+
+    return sent;
 }
 
-void ServerLogics::SendChunkToClients(ServerLogics::DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk)
+void ServerLogics::SendChunkToClients(ServerLogics::DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber)
 {
     DVASSERT(taskIt != dataGetTasks.end());
 
-    const DAVA::AssetCache::CacheItemKey& key = taskIt->first;
     DataGetTask& task = taskIt->second;
 
     for (std::pair<std::shared_ptr<DAVA::Net::IChannel> const, DataGetTask::ClientStatus>& client : task.clients)
     {
-        if (client.second.status == DataGetTask::WAITING_NEXT_CHUNK && client.second.waitingChunk == chunkNumber)
+        if (client.second.waitingChunks.count(chunkNumber) != 0)
         {
-            SendChunkToClient(taskIt, client.first, chunkNumber, chunk);
+            SendChunkToClient(taskIt, client.first, chunkNumber);
         }
     }
 
@@ -525,13 +577,17 @@ bool ServerLogics::SendFirstChunkToRemote(DataRemoteAddMap::iterator taskIt)
     ServerCacheEntry* entry = dataBase->Get(key);
     if (entry)
     {
-        task.serializedData = DynamicMemoryFile::Create(File::CREATE | File::READ | File::WRITE);
-        AssetCache::CachedItemValue& value = entry->GetValue();
-        value.Serialize(task.serializedData);
-        task.bytesOverall = task.serializedData->GetSize();
-        task.chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(task.bytesOverall);
+        task.reader = AssetCache::CachedItemValueReader(entry->GetValue(), dataBase->CreateFolderPath(key));
+        if (task.reader.IsValid() == false)
+        {
+            Logger::Warning("Files of item %s can't be read", Brief(key).c_str());
+            return false;
+        }
+
+        task.chunksOverall = AssetCache::ChunkSplitter::GetNumberOfChunks(task.reader.GetSize());
         task.chunksSent = 0;
-        return SendChunkToRemote(taskIt);
+        task.chunksAcknowledged = 0;
+        return SendChunksToRemote(taskIt);
     }
     else
     {
@@ -540,7 +596,7 @@ bool ServerLogics::SendFirstChunkToRemote(DataRemoteAddMap::iterator taskIt)
     }
 }
 
-bool ServerLogics::SendChunkToRemote(DataRemoteAddMap::iterator taskIt)
+bool ServerLogics::SendChunksToRemote(DataRemoteAddMap::iterator taskIt)
 {
     using namespace DAVA;
 
@@ -549,9 +605,17 @@ bool ServerLogics::SendChunkToRemote(DataRemoteAddMap::iterator taskIt)
     const AssetCache::CacheItemKey& key = taskIt->first;
     DataRemoteAddTask& task = taskIt->second;
 
-    Vector<uint8> chunk = AssetCache::ChunkSplitter::GetChunk(task.serializedData->GetDataVector(), task.chunksSent);
-    DAVA::Logger::Debug("Sending add chunk %u/%u to remote, key %s", task.chunksSent, task.chunksOverall, Brief(key).c_str());
-    return clientProxy->RequestAddNextChunk(key, task.bytesOverall, task.chunksOverall, task.chunksSent++, chunk);
+    while (task.chunksSent < task.chunksOverall && (task.chunksSent - task.chunksAcknowledged) < AssetCache::MAX_CHUNKS_IN_FLIGHT)
+    {
+        DAVA::Logger::Debug("Sending add chunk %u/%u to remote, key %s", task.chunksSent, task.chunksOverall, Brief(key).c_str());
+        if (clientProxy->RequestAddNextChunk(key, task.reader, task.chunksSent, remoteAddCompression) == false)
+        {
+            return false;
+        }
+        ++task.chunksSent;
+    }
+
+    return true;
 }
 
 void ServerLogics::CancelGetTask(ServerLogics::DataGetMap::iterator it)
@@ -567,17 +631,10 @@ void ServerLogics::CancelGetTask(ServerLogics::DataGetMap::iterator it)
 
         for (const std::pair<std::shared_ptr<DAVA::Net::IChannel>, DataGetTask::ClientStatus>& client : task.clients)
         {
-            switch (client.second.status)
+            if (client.second.waitingChunks.empty() == false)
             {
-            case DataGetTask::READY:
-                break;
-            case DataGetTask::WAITING_NEXT_CHUNK:
                 DAVA::Logger::Debug("Sending empty chunk");
-                serverProxy->SendChunk(client.first, key, 0, 0, 0, Vector<uint8>());
-                break;
-            default:
-                DVASSERT(false, Format("Incorrect data status: %u", task.dataStatus).c_str());
-                break;
+                serverProxy->SendChunk(client.first, key, 0, 0, 0, nullptr, 0, Compressor::Type::None);
             }
         }
 
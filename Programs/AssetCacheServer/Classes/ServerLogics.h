@@ -3,8 +3,8 @@
 #include "CacheDB.h"
 
 #include <AssetCache/AssetCache.h>
-
-#include <FileSystem/DynamicMemoryFile.h>
+#include <AssetCache/CachedItemValueReader.h>
+#include <AssetCache/ReceivedValueFile.h>
 
 class ServerLogics : public DAVA::AssetCache::ServerNetProxyListener,
                      public DAVA::AssetCache::ClientNetProxyListener
@@ -18,7 +18,7 @@ public:
 
     //ServerNetProxyListener
     void OnAddChunkToCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 dataSize, DAVA::uint32 numOfChunks, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunkData) override;
-    void OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkNumber) override;
+    void OnChunkRequestedFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key, DAVA::uint32 chunkNumber, DAVA::Compressor::Type compression) override;
     void OnRemoveFromCache(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key) override;
     void OnClearCache(const std::shared_ptr<DAVA::Net::IChannel>& channel) override;
     void OnWarmingUp(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key) override;
@@ -41,22 +41,21 @@ private:
 
         struct ClientStatus
         {
-            ClientStatus(DataRequestStatus status = DataRequestStatus::READY)
-                : status(status)
-            {
-            }
-            DataRequestStatus status = DataRequestStatus::READY;
-            DAVA::uint32 waitingChunk = 0;
+            DAVA::Set<DAVA::uint32> waitingChunks; //requested chunks which are not received from remote yet
+            DAVA::Compressor::Type compression = DAVA::Compressor::Type::None;
             bool lastChunkWasSent = false;
         };
 
         DAVA::UnorderedMap<std::shared_ptr<DAVA::Net::IChannel>, ClientStatus> clients;
-        DAVA::ScopedPtr<DAVA::DynamicMemoryFile> serializedData;
+        DAVA::AssetCache::CachedItemValueReader reader; //local data, chunks are read from it on sending
+        std::unique_ptr<DAVA::AssetCache::ReceivedValueFile> receivedData; //data received from remote, streamed into item folder
         DataRequestStatus dataStatus = READY;
+        DAVA::Compressor::Type remoteCompression = DAVA::Compressor::Type::None;
 
         DAVA::uint64 bytesReady = 0;
         DAVA::uint64 bytesOverall = 0;
         DAVA::uint32 chunksReady = 0;
+        DAVA::uint32 chunksRequested = 0;
         DAVA::uint32 chunksOverall = 0;
     };
     using DataGetMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, DataGetTask>;
@@ -65,7 +64,7 @@ private:
     {
         DAVA::AssetCache::CacheItemKey key;
         std::shared_ptr<DAVA::Net::IChannel> channel;
-        DAVA::ScopedPtr<DAVA::DynamicMemoryFile> receivedData;
+        std::unique_ptr<DAVA::AssetCache::ReceivedValueFile> receivedData; //streamed into item folder
 
         size_t bytesReceived = 0;
         size_t bytesOverall = 0;
@@ -75,10 +74,10 @@ private:
 
     struct DataRemoteAddTask
     {
-        DAVA::ScopedPtr<DAVA::DynamicMemoryFile> serializedData;
+        DAVA::AssetCache::CachedItemValueReader reader;
         DAVA::uint32 chunksSent = 0;
+        DAVA::uint32 chunksAcknowledged = 0;
         DAVA::uint32 chunksOverall = 0;
-        DAVA::uint64 bytesOverall = 0;
     };
     using DataRemoteAddMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, DataRemoteAddTask>;
 
@@ -94,13 +93,14 @@ private:
 private:
     bool IsRemoteServerConnected() const;
 
+    DAVA::List<DataAddTask>::iterator FindAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key);
     DAVA::List<DataAddTask>::iterator GetOrCreateAddTask(const std::shared_ptr<DAVA::Net::IChannel>& channel, const DAVA::AssetCache::CacheItemKey& key);
-    DataGetMap::iterator GetOrCreateGetTask(const DAVA::AssetCache::CacheItemKey& key);
-    void RequestNextChunk(DataGetMap::iterator it);
-    void SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk);
-    void SendChunkToClients(DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber, const DAVA::Vector<DAVA::uint8>& chunk);
+    DataGetMap::iterator GetOrCreateGetTask(const DAVA::AssetCache::CacheItemKey& key, DAVA::Compressor::Type compression);
+    void RequestNextChunks(DataGetMap::iterator it);
+    bool SendChunkToClient(DataGetMap::iterator taskIt, const std::shared_ptr<DAVA::Net::IChannel>& clientChannel, DAVA::uint32 chunkNumber);
+    void SendChunkToClients(DataGetMap::iterator taskIt, DAVA::uint32 chunkNumber);
     bool SendFirstChunkToRemote(DataRemoteAddMap::iterator taskIt);
-    bool SendChunkToRemote(DataRemoteAddMap::iterator taskIt);
+    bool SendChunksToRemote(DataRemoteAddMap::iterator taskIt);
     void CancelGetTask(DataGetMap::iterator it);
     void CancelRemoteTasks();
     void RemoveClientFromTasks(const std::shared_ptr<DAVA::Net::IChannel>& clientChannel);
@@ -120,5 +120,6 @@ private:
     DAVA::List<DataWarmupTask> dataWarmupTasks;
     DataRemoteAddMap dataRemoteAddTasks;
     DAVA::String serverName;
+    DAVA::Compressor::Type remoteAddCompression = DAVA::Compressor::Type::Lz4; // each chunk is sent compressed only if it gets smaller
     bool hasIncomingRequestsRecently = false; // any incoming request has been received after last lazy update
 };
@@ -1,4 +1,5 @@
 #include "UI/AssetCacheServerWindow.h"
+#include "CacheEvictionBenchmark.h"
 #include "ServerCore.h"
 #include "Logger/RotationLogger.h"
 
@@ -134,9 +135,18 @@ int DAVAMain(DAVA::Vector<DAVA::String> cmdLine)
     Engine e;
     e.Init(eEngineRunMode::CONSOLE_MODE, modules, options);
 
-    e.update.Connect([&e](float32)
+    bool runBenchmark = std::find(cmdLine.begin(), cmdLine.end(), "--benchmark-eviction") != cmdLine.end();
+    e.update.Connect([&e, runBenchmark](float32)
                      {
-                         int result = Process(e);
+                         int result = 0;
+                         if (runBenchmark)
+                         {
+                             RunCacheEvictionBenchmark();
+                         }
+                         else
+                         {
+                             result = Process(e);
+                         }
                          e.QuitAsync(result);
                      });
 
@@ -10,6 +10,14 @@
 #include "Tests/UniversalTest.h"
 #include "Tests/MaterialsTest.h"
 #include "Tests/LoadingTest.h"
+#include "Tests/JobSystemTest.h"
+#include "Tests/UILayoutTest.h"
+#include "Tests/ScenePerformanceTest.h"
+
+#include <ClippingTest.h>
+#include <ParticlesTest.h>
+#include <RenderPassTest.h>
+#include <SkinningTest.h>
 
 #include <Version/Version.h>
 
@@ -133,6 +141,75 @@ void GameCore::RegisterTests()
 
         testChain.push_back(new LoadingTest(params));
     }
+
+    // job system test, doesn't need any map
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = JobSystemTest::TEST_NAME;
+
+        testChain.push_back(new JobSystemTest(params));
+    }
+
+    // UI layout test, doesn't need any map
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = UILayoutTest::TEST_NAME;
+
+        testChain.push_back(new UILayoutTest(params));
+    }
+
+    // clipping test, builds synthetic scene itself
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "ClippingTest";
+
+        testChain.push_back(new ScenePerformanceTest(params, [](ScenePerformanceTest::Results& results) {
+            for (const ClippingTestResult& r : ClippingTest::RunAll())
+            {
+                results.emplace_back(Format("Clip%uObjectsAvgMs", r.objectCount), r.clipTime.avgMs);
+                results.emplace_back(Format("Clip%uObjectsMaxMs", r.objectCount), r.clipTime.maxMs);
+            }
+        }));
+    }
+
+    // particles test, builds synthetic scene itself
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "ParticlesTest";
+
+        testChain.push_back(new ScenePerformanceTest(params, [](ScenePerformanceTest::Results& results) {
+            for (const ParticlesTestResult& r : ParticlesTest::RunAll())
+            {
+                results.emplace_back(Format("Particles%uEffects%uWorkersAvgMs", r.effectsCount, r.workersCount), r.frameTime.avgMs);
+            }
+        }));
+    }
+
+    // skinning test, builds synthetic scene itself
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "SkinningTest";
+
+        testChain.push_back(new ScenePerformanceTest(params, [](ScenePerformanceTest::Results& results) {
+            for (const SkinningTestResult& r : SkinningTest::RunAll())
+            {
+                results.emplace_back(Format("Skinning%uCharacters%sAvgMs", r.charactersCount, r.parallel ? "Parallel" : "Sequential"), r.frameTime.avgMs);
+            }
+        }));
+    }
+
+    // render pass test, builds synthetic scene itself and draws it from screen update
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "RenderPassTest";
+
+        testChain.push_back(new ScenePerformanceTest(params, [](ScenePerformanceTest::Results& results) {
+            for (const RenderPassTestResult& r : RenderPassTest::RunAll())
+            {
+                results.emplace_back(Format("RenderPass%uObjects%sAvgMs", r.objectsCount, r.parallel ? "Parallel" : "Sequential"), r.frameTime.avgMs);
+            }
+        }));
+    }
 }
 
 void GameCore::LoadMaps(const String& testName, Vector<std::pair<String, String>>& mapsVector)
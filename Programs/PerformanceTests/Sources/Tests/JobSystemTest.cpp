@@ -0,0 +1,255 @@
+#include "JobSystemTest.h"
+
+#include <Job/JobScheduler.h>
+
+#include <atomic>
+
+const String JobSystemTest::TEST_NAME = "JobSystemTest";
+
+namespace JobSystemTestDetails
+{
+const uint32 START_DELAY_FRAMES = 20;
+
+const uint32 EMPTY_JOBS_COUNT = 200000;
+const uint32 FANOUT_ITERATIONS = 2000;
+const uint32 FANOUT_WIDTH = 64;
+
+/**
+    Reproduction of the single-queue worker pool JobManager used before JobScheduler:
+    every job goes through one mutex-protected queue and workers are woken by a condition variable.
+*/
+class SingleQueueWorkerPool
+{
+public:
+    SingleQueueWorkerPool(uint32 threadsCount)
+    {
+        for (uint32 i = 0; i < threadsCount; ++i)
+        {
+            Thread* thread = Thread::Create([this]() { ThreadFunc(); });
+            thread->Start();
+            threads.push_back(thread);
+        }
+    }
+
+    ~SingleQueueWorkerPool()
+    {
+        {
+            LockGuard<Mutex> guard(mutex);
+            cancel = true;
+            jobsCV.NotifyAll();
+        }
+
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+    }
+
+    void Push(const Function<void()>& fn)
+    {
+        LockGuard<Mutex> guard(mutex);
+        jobs.push_back(fn);
+        ++unfinished;
+        jobsCV.NotifyOne();
+    }
+
+    void WaitAll()
+    {
+        UniqueLock<Mutex> lock(mutex);
+        while (unfinished > 0)
+        {
+            doneCV.Wait(lock);
+        }
+    }
+
+private:
+    void ThreadFunc()
+    {
+        UniqueLock<Mutex> lock(mutex);
+        while (!cancel)
+        {
+            if (jobs.empty())
+            {
+                jobsCV.Wait(lock);
+                continue;
+            }
+
+            Function<void()> fn = std::move(jobs.front());
+            jobs.pop_front();
+
+            lock.Unlock();
+            fn();
+            lock.Lock();
+
+            if (--unfinished == 0)
+            {
+                doneCV.NotifyAll();
+            }
+        }
+    }
+
+    Vector<Thread*> threads;
+    Deque<Function<void()>> jobs;
+    uint32 unfinished = 0;
+    bool cancel = false;
+
+    Mutex mutex;
+    ConditionVariable jobsCV;
+    ConditionVariable doneCV;
+};
+
+float64 ToMs(int64 us)
+{
+    return static_cast<float64>(us) / 1000.0;
+}
+}
+
+JobSystemTest::JobSystemTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void JobSystemTest::LoadResources()
+{
+    ScopedPtr<Font> font(FTFont::Create("~res:/Fonts/korinna.ttf"));
+
+    infoText = new UIStaticText();
+    infoText->SetFont(font);
+    infoText->SetFontSize(18.f);
+    infoText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    infoText->SetTextAlign(ALIGN_HCENTER | ALIGN_VCENTER);
+    infoText->SetRect(DAVA::GetEngineContext()->uiControlSystem->vcs->GetFullScreenVirtualRect());
+    infoText->SetText(UTF8Utils::EncodeToWideString("Running job system benchmarks..."));
+    AddControl(infoText);
+
+    delayFrames = JobSystemTestDetails::START_DELAY_FRAMES;
+}
+
+void JobSystemTest::UnloadResources()
+{
+    SafeRelease(infoText);
+}
+
+void JobSystemTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (!finished)
+    {
+        // let the application settle down before measuring
+        if (delayFrames > 0)
+        {
+            --delayFrames;
+            return;
+        }
+
+        RunBenchmarks();
+        finished = true;
+    }
+}
+
+void JobSystemTest::RunBenchmarks()
+{
+    using namespace JobSystemTestDetails;
+
+    JobScheduler* scheduler = GetEngineContext()->jobManager->GetScheduler();
+    uint32 workersCount = scheduler->GetWorkersCount();
+
+    // Empty jobs throughput
+    {
+        SingleQueueWorkerPool pool(workersCount);
+
+        int64 startTime = SystemTimer::GetUs();
+        for (uint32 i = 0; i < EMPTY_JOBS_COUNT; ++i)
+        {
+            pool.Push([]() {});
+        }
+        pool.WaitAll();
+        results.emplace_back("SingleQueueEmptyJobs", ToMs(SystemTimer::GetUs() - startTime));
+    }
+
+    {
+        int64 startTime = SystemTimer::GetUs();
+        JobHandle group = scheduler->CreateGroup();
+        for (uint32 i = 0; i < EMPTY_JOBS_COUNT; ++i)
+        {
+            scheduler->Schedule([]() {}, group);
+        }
+        scheduler->SealGroup(group);
+        scheduler->Wait(group);
+        results.emplace_back("SchedulerEmptyJobs", ToMs(SystemTimer::GetUs() - startTime));
+    }
+
+    {
+        // Jobs spawned from worker go to its own deque and are distributed by stealing
+        int64 startTime = SystemTimer::GetUs();
+        JobHandle group = scheduler->CreateGroup();
+        uint32 spawnersCount = workersCount * 4;
+        for (uint32 i = 0; i < spawnersCount; ++i)
+        {
+            scheduler->Schedule([scheduler, group, spawnersCount]() {
+                for (uint32 j = 0; j < EMPTY_JOBS_COUNT / spawnersCount; ++j)
+                {
+                    scheduler->Schedule([]() {}, group);
+                }
+            },
+                                group);
+        }
+        scheduler->SealGroup(group);
+        scheduler->Wait(group);
+        results.emplace_back("SchedulerEmptyJobsSpawnedFromWorkers", ToMs(SystemTimer::GetUs() - startTime));
+    }
+
+    // Fan-out latency: time from submitting FANOUT_WIDTH small jobs until all of them are finished
+    {
+        SingleQueueWorkerPool pool(workersCount);
+        std::atomic<uint32> sink(0);
+
+        int64 totalTime = 0;
+        for (uint32 i = 0; i < FANOUT_ITERATIONS; ++i)
+        {
+            int64 startTime = SystemTimer::GetUs();
+            for (uint32 j = 0; j < FANOUT_WIDTH; ++j)
+            {
+                pool.Push([&sink]() { sink++; });
+            }
+            pool.WaitAll();
+            totalTime += SystemTimer::GetUs() - startTime;
+        }
+        results.emplace_back("SingleQueueFanOutLatency", ToMs(totalTime) / FANOUT_ITERATIONS);
+    }
+
+    {
+        std::atomic<uint32> sink(0);
+
+        int64 totalTime = 0;
+        for (uint32 i = 0; i < FANOUT_ITERATIONS; ++i)
+        {
+            int64 startTime = SystemTimer::GetUs();
+            scheduler->ParallelFor(0, FANOUT_WIDTH, 1, [&sink](uint32, uint32) { sink++; });
+            totalTime += SystemTimer::GetUs() - startTime;
+        }
+        results.emplace_back("SchedulerFanOutLatency", ToMs(totalTime) / FANOUT_ITERATIONS);
+    }
+}
+
+void JobSystemTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void JobSystemTest::OnFinish()
+{
+    for (const auto& result : results)
+    {
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(result.first, DAVA::Format("%f", result.second)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool JobSystemTest::IsFinished() const
+{
+    return finished;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "BaseTest.h"
+
+/**
+    CPU benchmark of worker jobs execution.
+    Compares work-stealing JobScheduler with a single mutex-protected queue, which JobManager used before.
+    Measures throughput of empty jobs and latency of fan-out of small jobs.
+*/
+class JobSystemTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    JobSystemTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    void RunBenchmarks();
+
+    bool finished = false;
+    uint32 delayFrames = 0;
+
+    Vector<std::pair<String, float64>> results;
+    UIStaticText* infoText = nullptr;
+};
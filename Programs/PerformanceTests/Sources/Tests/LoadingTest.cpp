@@ -1,5 +1,7 @@
 #include "LoadingTest.h"
 
+#include "Scene3D/SceneFile/BinarySceneFormat.h"
+
 static const uint32 LOADING_DELAY_FRAMES = 20;
 static const uint32 LOADING_THREAD_STACK_SIZE = 1024 * 1024; // 1 mb
 
@@ -22,11 +24,18 @@ void LoadingTest::LoadJob::Excecute()
     excecuted = true;
 
     uint64 time = SystemTimer::GetMs();
+#if defined(DAVA_MEMORY_PROFILING_ENABLE)
+    uint32 allocations = MemoryManager::Instance()->GetAllocationCount();
+#endif
 
     ScopedPtr<Scene> scene(new Scene());
     scene->LoadScene(scenePath);
 
     loadingTime = SystemTimer::GetMs() - time;
+#if defined(DAVA_MEMORY_PROFILING_ENABLE)
+    // Allocations of other threads are counted too, so value is precise only for main thread jobs
+    allocationsCount = MemoryManager::Instance()->GetAllocationCount() - allocations;
+#endif
 }
 
 bool LoadingTest::LoadJob::IsFinished()
@@ -44,6 +53,11 @@ uint64 LoadingTest::LoadJob::GetLoadTime()
     return loadingTime;
 }
 
+uint32 LoadingTest::LoadJob::GetAllocationsCount()
+{
+    return allocationsCount;
+}
+
 const String& LoadingTest::LoadJob::GetJobText()
 {
     return jobText;
@@ -121,11 +135,43 @@ void LoadingTest::LoadResources()
     for (int32 i = 0; i < 5; ++i)
         loadJobs.push_back(new LoadThreadJob(scenePath, Format("Loading map '%s' on loading thread (%d)...", GetParams().sceneName.c_str(), i + 1), 3));
 
+    // The same map in binary format, see SceneFileV2::SaveSceneBinary
+    FilePath binaryScenePath = PrepareBinaryScene(scenePath);
+    if (!binaryScenePath.IsEmpty())
+    {
+        loadJobs.push_back(new LoadJob(binaryScenePath, Format("Loading binary map '%s' on main thread (0)...", GetParams().sceneName.c_str()), 4));
+        for (int32 i = 0; i < 5; ++i)
+            loadJobs.push_back(new LoadJob(binaryScenePath, Format("Loading binary map '%s' on main thread (%d)...", GetParams().sceneName.c_str(), i + 1), 5));
+    }
+
     loadingText->SetText(UTF8Utils::EncodeToWideString(loadJobs.front()->GetJobText()));
 
     loadingDelayFrames = LOADING_DELAY_FRAMES;
 }
 
+FilePath LoadingTest::PrepareBinaryScene(const FilePath& scenePath)
+{
+    FilePath binaryScenePath = FilePath::CreateWithNewExtension(scenePath, BinarySceneFormat::FILE_EXTENSION);
+    if (GetEngineContext()->fileSystem->Exists(binaryScenePath))
+    {
+        return binaryScenePath;
+    }
+
+    // Map is converted once, resources folder is read-only so binary file is placed into documents
+    FilePath documentsFolder("~doc:/PerformanceTests/");
+    GetEngineContext()->fileSystem->CreateDirectory(documentsFolder, true);
+    binaryScenePath = documentsFolder + binaryScenePath.GetFilename();
+
+    ScopedPtr<Scene> scene(new Scene());
+    if (scene->LoadScene(scenePath) != SceneFileV2::ERROR_NO_ERROR || scene->SaveScene(binaryScenePath) != SceneFileV2::ERROR_NO_ERROR)
+    {
+        Logger::Error("Failed to convert %s into binary scene format", scenePath.GetStringValue().c_str());
+        return FilePath();
+    }
+
+    return binaryScenePath;
+}
+
 void LoadingTest::UnloadResources()
 {
     SafeRelease(loadingText);
@@ -166,6 +212,7 @@ void LoadingTest::Update(float32 timeElapsed)
             DVASSERT(loadJobs.front()->GetGroupIndex() < JOB_GROUP_MAX_COUNT && loadJobs.front()->GetGroupIndex() < JOB_GROUP_MAX_COUNT);
 
             loadResults[loadJobs.front()->GetGroupIndex()] += loadJobs.front()->GetLoadTime();
+            loadAllocations[loadJobs.front()->GetGroupIndex()] += loadJobs.front()->GetAllocationsCount();
             ++loadGroupSize[loadJobs.front()->GetGroupIndex()];
 
             SafeDelete(loadJobs.front());
@@ -188,6 +235,9 @@ void LoadingTest::OnFinish()
         if (loadGroupSize[i])
         {
             Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(DAVA::Format("Loading%d", i), DAVA::Format("%lld", loadResults[i] / loadGroupSize[i])).c_str());
+#if defined(DAVA_MEMORY_PROFILING_ENABLE)
+            Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(DAVA::Format("LoadingAllocations%d", i), DAVA::Format("%lld", loadAllocations[i] / loadGroupSize[i])).c_str());
+#endif
         }
     }
 
@@ -38,6 +38,8 @@ private:
 
     uint32 loadingDelayFrames = 0U;
 
+    FilePath PrepareBinaryScene(const FilePath& scenePath);
+
     class LoadJob
     {
     public:
@@ -49,6 +51,7 @@ private:
         bool IsExcecuted();
 
         uint64 GetLoadTime();
+        uint32 GetAllocationsCount();
         const String& GetJobText();
 
         uint32 GetGroupIndex();
@@ -57,6 +60,7 @@ private:
         FilePath scenePath;
         String jobText;
         uint64 loadingTime = 0U; //ms
+        uint32 allocationsCount = 0U;
         uint32 groupIndex = 0;
         bool excecuted = false;
     };
@@ -77,6 +81,7 @@ private:
     List<LoadJob*> loadJobs;
     Array<uint64, JOB_GROUP_MAX_COUNT> loadResults = {};
     Array<uint32, JOB_GROUP_MAX_COUNT> loadGroupSize = {};
+    Array<uint64, JOB_GROUP_MAX_COUNT> loadAllocations = {};
 
     UIStaticText* loadingText;
     UIStaticText* testText;
@@ -0,0 +1,71 @@
+#include "ScenePerformanceTest.h"
+
+namespace ScenePerformanceTestDetails
+{
+const uint32 START_DELAY_FRAMES = 20;
+}
+
+ScenePerformanceTest::ScenePerformanceTest(const TestParams& testParams, const Function<void(Results&)>& benchmark_)
+    : BaseTest(testParams.sceneName, testParams)
+    , benchmark(benchmark_)
+{
+}
+
+void ScenePerformanceTest::LoadResources()
+{
+    ScopedPtr<Font> font(FTFont::Create("~res:/Fonts/korinna.ttf"));
+
+    infoText = new UIStaticText();
+    infoText->SetFont(font);
+    infoText->SetFontSize(18.f);
+    infoText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    infoText->SetTextAlign(ALIGN_HCENTER | ALIGN_VCENTER);
+    infoText->SetRect(DAVA::GetEngineContext()->uiControlSystem->vcs->GetFullScreenVirtualRect());
+    infoText->SetText(UTF8Utils::EncodeToWideString("Running " + GetSceneName() + "..."));
+    AddControl(infoText);
+
+    delayFrames = ScenePerformanceTestDetails::START_DELAY_FRAMES;
+}
+
+void ScenePerformanceTest::UnloadResources()
+{
+    SafeRelease(infoText);
+}
+
+void ScenePerformanceTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (!finished)
+    {
+        // let the application settle down before measuring
+        if (delayFrames > 0)
+        {
+            --delayFrames;
+            return;
+        }
+
+        benchmark(results);
+        finished = true;
+    }
+}
+
+void ScenePerformanceTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void ScenePerformanceTest::OnFinish()
+{
+    for (const auto& result : results)
+    {
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(result.first, DAVA::Format("%f", result.second)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool ScenePerformanceTest::IsFinished() const
+{
+    return finished;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "BaseTest.h"
+
+/**
+    Runs benchmark from ScenePerformanceTests module (ClippingTest, ParticlesTest, etc.) and reports its results.
+    `benchmark` is called once, after application settles down, and fills named statistics in milliseconds.
+*/
+class ScenePerformanceTest : public BaseTest
+{
+public:
+    using Results = Vector<std::pair<String, float64>>;
+
+    ScenePerformanceTest(const TestParams& testParams, const Function<void(Results&)>& benchmark);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    Function<void(Results&)> benchmark;
+
+    bool finished = false;
+    uint32 delayFrames = 0;
+
+    Results results;
+    UIStaticText* infoText = nullptr;
+};
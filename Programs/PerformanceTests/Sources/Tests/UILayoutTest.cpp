@@ -0,0 +1,181 @@
+#include "UILayoutTest.h"
+
+#include <UI/Layouts/UILayoutSystem.h>
+#include <UI/Layouts/UILinearLayoutComponent.h>
+#include <UI/Layouts/UISizePolicyComponent.h>
+
+const String UILayoutTest::TEST_NAME = "UILayoutTest";
+
+namespace UILayoutTestDetails
+{
+const uint32 START_DELAY_FRAMES = 20;
+
+// Every item has 4 children, so screen has 5000 controls
+const uint32 ITEMS_COUNT = 1000;
+const uint32 RELAYOUT_ITERATIONS = 200;
+
+const float32 ITEM_HEIGHT = 40.f;
+const float32 ICON_SIZE = 32.f;
+
+float64 ToMs(int64 us)
+{
+    return static_cast<float64>(us) / 1000.0;
+}
+
+UIControl* CreateControl(UIControl* parent, float32 width, float32 height)
+{
+    UIControl* control = new UIControl(Rect(0.f, 0.f, width, height));
+    parent->AddControl(control);
+    control->Release();
+    return control;
+}
+}
+
+UILayoutTest::UILayoutTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void UILayoutTest::LoadResources()
+{
+    ScopedPtr<Font> font(FTFont::Create("~res:/Fonts/korinna.ttf"));
+
+    CreateLayoutScreen(font);
+
+    infoText = new UIStaticText();
+    infoText->SetFont(font);
+    infoText->SetFontSize(18.f);
+    infoText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    infoText->SetTextAlign(ALIGN_HCENTER | ALIGN_VCENTER);
+    infoText->SetRect(DAVA::GetEngineContext()->uiControlSystem->vcs->GetFullScreenVirtualRect());
+    infoText->SetText(UTF8Utils::EncodeToWideString("Running UI layout benchmarks..."));
+    AddControl(infoText);
+
+    delayFrames = UILayoutTestDetails::START_DELAY_FRAMES;
+}
+
+void UILayoutTest::UnloadResources()
+{
+    itemTexts.clear();
+    SafeRelease(layoutRoot);
+    SafeRelease(infoText);
+}
+
+void UILayoutTest::CreateLayoutScreen(Font* font)
+{
+    using namespace UILayoutTestDetails;
+
+    Rect screenRect = DAVA::GetEngineContext()->uiControlSystem->vcs->GetFullScreenVirtualRect();
+
+    // List of items: [icon][text][badge[badge icon]], item width follows width of list
+    layoutRoot = new UIControl(screenRect);
+    layoutRoot->SetVisibilityFlag(false);
+    UILinearLayoutComponent* listLayout = layoutRoot->GetOrCreateComponent<UILinearLayoutComponent>();
+    listLayout->SetOrientation(UILinearLayoutComponent::TOP_DOWN);
+    AddControl(layoutRoot);
+
+    for (uint32 i = 0; i < ITEMS_COUNT; ++i)
+    {
+        UIControl* item = CreateControl(layoutRoot, screenRect.dx, ITEM_HEIGHT);
+        UISizePolicyComponent* itemPolicy = item->GetOrCreateComponent<UISizePolicyComponent>();
+        itemPolicy->SetHorizontalPolicy(UISizePolicyComponent::PERCENT_OF_PARENT);
+        itemPolicy->SetHorizontalValue(100.f);
+        UILinearLayoutComponent* itemLayout = item->GetOrCreateComponent<UILinearLayoutComponent>();
+        itemLayout->SetOrientation(UILinearLayoutComponent::LEFT_TO_RIGHT);
+        itemLayout->SetPadding(4.f);
+        itemLayout->SetSpacing(4.f);
+
+        CreateControl(item, ICON_SIZE, ICON_SIZE);
+
+        UIStaticText* text = new UIStaticText(Rect(0.f, 0.f, 0.f, ITEM_HEIGHT));
+        text->SetFont(font);
+        text->SetFontSize(14.f);
+        text->SetText(UTF8Utils::EncodeToWideString(Format("Item %u", i)));
+        UISizePolicyComponent* textPolicy = text->GetOrCreateComponent<UISizePolicyComponent>();
+        textPolicy->SetHorizontalPolicy(UISizePolicyComponent::PERCENT_OF_CONTENT);
+        item->AddControl(text);
+        itemTexts.push_back(text);
+        text->Release();
+
+        UIControl* badge = CreateControl(item, ICON_SIZE, ICON_SIZE);
+        UISizePolicyComponent* badgePolicy = badge->GetOrCreateComponent<UISizePolicyComponent>();
+        badgePolicy->SetHorizontalPolicy(UISizePolicyComponent::PERCENT_OF_PARENT);
+        badgePolicy->SetHorizontalValue(20.f);
+        CreateControl(badge, ICON_SIZE, ICON_SIZE);
+    }
+}
+
+void UILayoutTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (!finished)
+    {
+        // let the application settle down and lay out screen before measuring
+        if (delayFrames > 0)
+        {
+            --delayFrames;
+            return;
+        }
+
+        RunBenchmarks();
+        finished = true;
+    }
+}
+
+float64 UILayoutTest::MeasureRelayout(const Function<void(uint32)>& change)
+{
+    using namespace UILayoutTestDetails;
+
+    UIControlSystem* controlSystem = GetEngineContext()->uiControlSystem;
+
+    int64 totalTime = 0;
+    for (uint32 i = 0; i < RELAYOUT_ITERATIONS; ++i)
+    {
+        change(i);
+
+        int64 startTime = SystemTimer::GetUs();
+        controlSystem->GetLayoutSystem()->SetDirty();
+        controlSystem->ForceUpdateControl(0.f, layoutRoot);
+        totalTime += SystemTimer::GetUs() - startTime;
+    }
+    return ToMs(totalTime) / RELAYOUT_ITERATIONS;
+}
+
+void UILayoutTest::RunBenchmarks()
+{
+    using namespace UILayoutTestDetails;
+
+    Rect screenRect = DAVA::GetEngineContext()->uiControlSystem->vcs->GetFullScreenVirtualRect();
+
+    // Every item and badge depend on width of list
+    results.emplace_back("UILayoutWholeScreenResize", MeasureRelayout([&](uint32 i) {
+                             layoutRoot->SetSize(Vector2(screenRect.dx - static_cast<float32>(i % 2), screenRect.dy));
+                         }));
+
+    results.emplace_back("UILayoutSingleItemChange", MeasureRelayout([&](uint32 i) {
+                             itemTexts[ITEMS_COUNT / 2]->SetText(UTF8Utils::EncodeToWideString(Format("Changed item %u", i)));
+                         }));
+
+    results.emplace_back("UILayoutNoChanges", MeasureRelayout([](uint32) {}));
+}
+
+void UILayoutTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void UILayoutTest::OnFinish()
+{
+    for (const auto& result : results)
+    {
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(result.first, DAVA::Format("%f", result.second)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool UILayoutTest::IsFinished() const
+{
+    return finished;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "BaseTest.h"
+
+/**
+    CPU benchmark of UI layout system on screen with 5000 controls.
+    Measures time of relayout after resize of whole screen, after change of single item and when nothing is changed.
+*/
+class UILayoutTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    UILayoutTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    void CreateLayoutScreen(Font* font);
+    void RunBenchmarks();
+    float64 MeasureRelayout(const Function<void(uint32)>& change);
+
+    bool finished = false;
+    uint32 delayFrames = 0;
+
+    Vector<std::pair<String, float64>> results;
+    UIStaticText* infoText = nullptr;
+    UIControl* layoutRoot = nullptr;
+    Vector<UIStaticText*> itemTexts;
+};
@@ -14,6 +14,7 @@
 static int UnpackFile(const DAVA::FilePath& archivePath,
                       const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& fileInfo,
                       const DAVA::String& relativeFilePath,
+                      const DAVA::LZ4DictCompressor* dictCompressor,
                       const bool extractInDvplFormat);
 
 ArchiveUnpackTool::ArchiveUnpackTool()
@@ -99,7 +100,7 @@ int ArchiveUnpackTool::ProcessInternal()
                                             const auto& fileInfoFromArchive = packFile.filesTable.data.files[i];
                                             const auto& fileInfo = fileInfoBase[i];
 
-                                            if (UnpackFile(packFilename, fileInfoFromArchive, fileInfo.relativeFilePath, extractInDvplFormat) == OK)
+                                            if (UnpackFile(packFilename, fileInfoFromArchive, fileInfo.relativeFilePath, packArchive.GetDictCompressor(), extractInDvplFormat) == OK)
                                             {
                                                 ++countExtractedFiles;
                                             }
@@ -135,6 +136,7 @@ int ArchiveUnpackTool::ProcessInternal()
 static int UnpackFile(const DAVA::FilePath& archivePath,
                       const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& fileInfo,
                       const DAVA::String& relativeFilePath,
+                      const DAVA::LZ4DictCompressor* dictCompressor,
                       const bool extractInDvplFormat)
 {
     using namespace DAVA;
@@ -234,6 +236,13 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
             return ERROR_CANT_EXTRACT_FILE;
         }
         break;
+    case Compressor::Type::Lz4Dict:
+        content.resize(fileInfo.originalSize);
+        if (!dictCompressor->Decompress(compressedContent, content))
+        {
+            return ERROR_CANT_EXTRACT_FILE;
+        }
+        break;
     default:
         Logger::Error("unknown compression type: %d", fileInfo.type);
         return ERROR_CANT_EXTRACT_FILE;
@@ -15,6 +15,7 @@
 #include "Classes/CommandLine/SceneSaverTool.h"
 #include "Classes/CommandLine/SceneExporterTool.h"
 #include "Classes/CommandLine/SceneValidationTool.h"
+#include "Classes/CommandLine/ShaderCacheTool.h"
 #include "Classes/DevFuncs/TestUIModuleData.h"
 
 #include <REPlatform/DataNodes/Settings/RESettings.h>
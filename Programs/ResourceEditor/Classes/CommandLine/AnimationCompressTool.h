@@ -0,0 +1,32 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class AnimationCompressTool : public DAVA::CommandLineModule
+{
+public:
+    AnimationCompressTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void ShowHelpInternal() override;
+
+    bool CompressClip(const DAVA::FilePath& sourcePath, const DAVA::FilePath& destinationPath);
+
+    DAVA::FilePath inFolder;
+    DAVA::FilePath outFolder;
+    DAVA::FilePath inFile;
+    DAVA::FilePath outFile;
+
+    DAVA::uint32 compressedCount = 0;
+    DAVA::uint32 failedCount = 0;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(AnimationCompressTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<AnimationCompressTool>::Begin()[DAVA::M::CommandName("-animationcompress")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class BinarySceneTool : public DAVA::CommandLineModule
+{
+public:
+    BinarySceneTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void BeforeDestroyedInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::FilePath inFolder;
+    DAVA::FilePath dataSourceFolder;
+    DAVA::FilePath scenePathname;
+    DAVA::FilePath binaryScenePathname;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(BinarySceneTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<BinarySceneTool>::Begin()[DAVA::M::CommandName("-binaryscene")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+#include <Reflection/ReflectionRegistrator.h>
+
+class PhysicsCookTool : public DAVA::CommandLineModule
+{
+public:
+    PhysicsCookTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+private:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void ShowHelpInternal() override;
+
+    bool CookScene(const DAVA::FilePath& scenePath);
+
+    DAVA::FilePath inFolder;
+    DAVA::FilePath inFile;
+    DAVA::FilePath cacheFolder;
+    bool removeUnused = false;
+
+    DAVA::Vector<DAVA::FilePath> prevReadOnlyFolders;
+    DAVA::FilePath prevWritableFolder;
+    DAVA::uint64 prevWritableFolderLimit = 0;
+
+    DAVA::uint32 cookedCount = 0;
+    DAVA::uint32 failedCount = 0;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(PhysicsCookTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<PhysicsCookTool>::Begin()[DAVA::M::CommandName("-physicscook")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
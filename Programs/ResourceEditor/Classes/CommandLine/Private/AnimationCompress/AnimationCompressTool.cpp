@@ -0,0 +1,135 @@
+#include "Classes/CommandLine/AnimationCompressTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Animation/AnimationClipCompressor.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+
+namespace AnimationCompressToolDetails
+{
+const DAVA::String ANIMATION_EXTENSION = ".anim";
+}
+
+AnimationCompressTool::AnimationCompressTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-animationcompress")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::InDir, VariantType(String("")), "Full path to folder with source .anim files, subfolders are processed too");
+    options.AddOption(OptionName::OutDir, VariantType(String("")), "Full path to folder for compressed .anim files, folder structure of -indir is kept");
+    options.AddOption(OptionName::File, VariantType(String("")), "Full path to source .anim file");
+    options.AddOption(OptionName::OutFile, VariantType(String("")), "Full path for compressed .anim file");
+}
+
+bool AnimationCompressTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    inFolder = options.GetOption(OptionName::InDir).AsString();
+    outFolder = options.GetOption(OptionName::OutDir).AsString();
+    inFile = options.GetOption(OptionName::File).AsString();
+    outFile = options.GetOption(OptionName::OutFile).AsString();
+
+    if (!inFolder.IsEmpty())
+    {
+        if (outFolder.IsEmpty())
+        {
+            Logger::Error("Output folder was not selected");
+            return false;
+        }
+
+        inFolder.MakeDirectoryPathname();
+        outFolder.MakeDirectoryPathname();
+        if (inFolder == outFolder)
+        {
+            Logger::Error("Output folder should differ from input folder");
+            return false;
+        }
+    }
+    else if (!inFile.IsEmpty())
+    {
+        if (outFile.IsEmpty())
+        {
+            Logger::Error("Output file was not selected");
+            return false;
+        }
+
+        if (inFile == outFile)
+        {
+            Logger::Error("Output file should differ from input file");
+            return false;
+        }
+    }
+    else
+    {
+        Logger::Error("Neither input folder nor input file was selected");
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult AnimationCompressTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    if (!inFolder.IsEmpty())
+    {
+        Vector<FilePath> files = FileSystem::Instance()->EnumerateFilesInDirectory(inFolder, true);
+        for (const FilePath& sourcePath : files)
+        {
+            if (sourcePath.IsEqualToExtension(AnimationCompressToolDetails::ANIMATION_EXTENSION))
+            {
+                FilePath destinationPath = outFolder + sourcePath.GetRelativePathname(inFolder);
+                CompressClip(sourcePath, destinationPath);
+            }
+        }
+    }
+    else
+    {
+        CompressClip(inFile, outFile);
+    }
+
+    Logger::Info("Compressed %u animation clips, failed %u", compressedCount, failedCount);
+    if (failedCount > 0)
+    {
+        result = Result::RESULT_ERROR;
+    }
+
+    return ConsoleModule::eFrameResult::FINISHED;
+}
+
+bool AnimationCompressTool::CompressClip(const DAVA::FilePath& sourcePath, const DAVA::FilePath& destinationPath)
+{
+    using namespace DAVA;
+
+    FileSystem::Instance()->CreateDirectory(destinationPath.GetDirectory(), true);
+
+    AnimationClipCompressor::Report report;
+    if (!AnimationClipCompressor::Compress(sourcePath, destinationPath, AnimationClipCompressor::Params(), &report))
+    {
+        Logger::Error("Cannot compress animation clip %s", sourcePath.GetAbsolutePathname().c_str());
+        ++failedCount;
+        return false;
+    }
+
+    ++compressedCount;
+    Logger::Info("%s: %u -> %u bytes, channels %u (constant %u, quantized %u), max error: position %f, orientation %f rad, scale %f",
+                 sourcePath.GetAbsolutePathname().c_str(), report.originalSize, report.compressedSize, report.channelsCount, report.constantChannelsCount,
+                 report.quantizedChannelsCount, report.maxPositionError, report.maxOrientationError, report.maxScaleError);
+    return true;
+}
+
+void AnimationCompressTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-animationcompress -indir /Users/SmokeTest/DataSource/3d/animations/ -outdir /Users/SmokeTest/Data/3d/animations/");
+    DAVA::Logger::Info("\t-animationcompress -file /Users/SmokeTest/DataSource/3d/animations/run.anim -outfile /Users/SmokeTest/Data/3d/animations/run.anim");
+}
+
+DECL_TARC_MODULE(AnimationCompressTool);
@@ -0,0 +1,111 @@
+#include "Classes/CommandLine/BinarySceneTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+#include <REPlatform/CommandLine/SceneConsoleHelper.h>
+#include <REPlatform/DataNodes/ProjectManagerData.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Base/ScopedPtr.h>
+#include <Logger/Logger.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/SceneFile/BinarySceneFormat.h>
+
+BinarySceneTool::BinarySceneTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-binaryscene")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::InDir, VariantType(String("")), "Path for Project/DataSource/3d/ folder");
+    options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Filename from DataSource/3d/ for converting");
+    options.AddOption(OptionName::OutFile, VariantType(String("")), "Full path for binary scene file. If not set, scene is saved next to source file with .sc2b extension");
+    options.AddOption(OptionName::QualityConfig, VariantType(String("")), "Full path for quality.yaml file");
+}
+
+bool BinarySceneTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    inFolder = options.GetOption(OptionName::InDir).AsString();
+    if (inFolder.IsEmpty())
+    {
+        Logger::Error("Input folder was not selected");
+        return false;
+    }
+    inFolder.MakeDirectoryPathname();
+
+    dataSourceFolder = ProjectManagerData::GetDataSourcePath(inFolder);
+    if (dataSourceFolder.IsEmpty())
+    {
+        Logger::Error("DataSource folder was not found");
+        return false;
+    }
+
+    String filename = options.GetOption(OptionName::ProcessFile).AsString();
+    if (filename.empty())
+    {
+        Logger::Error("Filename was not selected");
+        return false;
+    }
+    scenePathname = inFolder + filename;
+
+    binaryScenePathname = options.GetOption(OptionName::OutFile).AsString();
+    if (binaryScenePathname.IsEmpty())
+    {
+        binaryScenePathname = FilePath::CreateWithNewExtension(scenePathname, BinarySceneFormat::FILE_EXTENSION);
+    }
+    else if (!binaryScenePathname.IsEqualToExtension(BinarySceneFormat::FILE_EXTENSION))
+    {
+        Logger::Error("Output file should have %s extension", BinarySceneFormat::FILE_EXTENSION);
+        return false;
+    }
+
+    bool qualityInitialized = SceneConsoleHelper::InitializeQualitySystem(options, inFolder);
+    if (!qualityInitialized)
+    {
+        Logger::Error("Cannot create path to quality.yaml from %s", inFolder.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult BinarySceneTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    FilePath::AddResourcesFolder(dataSourceFolder);
+
+    ScopedPtr<Scene> scene(new Scene());
+    if (scene->LoadScene(scenePathname) == SceneFileV2::ERROR_NO_ERROR)
+    {
+        if (scene->SaveScene(binaryScenePathname) != SceneFileV2::ERROR_NO_ERROR)
+        {
+            Logger::Error("Cannot save binary scene %s", binaryScenePathname.GetAbsolutePathname().c_str());
+        }
+    }
+    else
+    {
+        Logger::Error("Cannot load scene %s", scenePathname.GetAbsolutePathname().c_str());
+    }
+
+    FilePath::RemoveResourcesFolder(dataSourceFolder);
+
+    return ConsoleModule::eFrameResult::FINISHED;
+}
+
+void BinarySceneTool::BeforeDestroyedInternal()
+{
+    DAVA::SceneConsoleHelper::FlushRHI();
+}
+
+void BinarySceneTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-binaryscene -indir /Users/SmokeTest/DataSource/3d/ -processfile Maps/scene.sc2 -qualitycfgpath Users/SmokeTest/Data/quality.yaml");
+    DAVA::Logger::Info("\t-binaryscene -indir /Users/SmokeTest/DataSource/3d/ -processfile Maps/scene.sc2 -outfile /Users/SmokeTest/Data/3d/Maps/scene.sc2b");
+}
+
+DECL_TARC_MODULE(BinarySceneTool);
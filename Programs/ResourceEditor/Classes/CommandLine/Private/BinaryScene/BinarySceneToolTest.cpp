@@ -0,0 +1,98 @@
+#include "Classes/CommandLine/BinarySceneTool.h"
+
+#include <REPlatform/CommandLine/CommandLineModuleTestUtils.h>
+
+#include <TArc/Testing/ConsoleModuleTestExecution.h>
+#include <TArc/Testing/TArcUnitTests.h>
+
+#include <Base/BaseTypes.h>
+#include <Base/ScopedPtr.h>
+#include <Engine/Engine.h>
+#include <FileSystem/FileSystem.h>
+#include <Scene3D/Components/TransformComponent.h>
+#include <Scene3D/Entity.h>
+#include <Scene3D/Scene.h>
+
+namespace BSTestDetail
+{
+const DAVA::String projectStr = "~doc:/Test/BinarySceneTool/";
+const DAVA::String scenePathnameStr = projectStr + "DataSource/3d/Scene/testScene.sc2";
+const DAVA::String binaryScenePathnameStr = projectStr + "DataSource/3d/Scene/testScene.sc2b";
+}
+
+DAVA_TARC_TESTCLASS(BinarySceneToolTest)
+{
+    bool IsSameHierarchy(DAVA::Entity * left, DAVA::Entity * right)
+    {
+        using namespace DAVA;
+
+        if (left->GetName() != right->GetName() || left->GetComponentCount() != right->GetComponentCount() || left->GetChildrenCount() != right->GetChildrenCount())
+        {
+            return false;
+        }
+
+        // transforms are stored as fixed records in binary scene
+        TransformComponent* leftTransform = left->GetComponent<TransformComponent>();
+        TransformComponent* rightTransform = right->GetComponent<TransformComponent>();
+        if ((leftTransform == nullptr) != (rightTransform == nullptr))
+        {
+            return false;
+        }
+        if (leftTransform != nullptr)
+        {
+            const Transform& l = leftTransform->GetLocalTransform();
+            const Transform& r = rightTransform->GetLocalTransform();
+            if (l.GetTranslation() != r.GetTranslation() || l.GetScale() != r.GetScale() || l.GetRotation() != r.GetRotation())
+            {
+                return false;
+            }
+        }
+
+        for (int32 i = 0; i < left->GetChildrenCount(); ++i)
+        {
+            if (!IsSameHierarchy(left->GetChild(i), right->GetChild(i)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    DAVA_TEST (ConvertSceneTest)
+    {
+        using namespace DAVA;
+
+        std::unique_ptr<CommandLineModuleTestUtils::TextureLoadingGuard> guard = CommandLineModuleTestUtils::CreateTextureGuard({ eGPUFamily::GPU_ORIGIN });
+        CommandLineModuleTestUtils::CreateProjectInfrastructure(BSTestDetail::projectStr);
+        CommandLineModuleTestUtils::SceneBuilder::CreateFullScene(BSTestDetail::scenePathnameStr, BSTestDetail::projectStr);
+
+        FilePath dataSourcePath = BSTestDetail::projectStr + "DataSource/3d/";
+        Vector<String> cmdLine =
+        {
+          "ResourceEditor",
+          "-binaryscene",
+          "-indir",
+          dataSourcePath.GetAbsolutePathname(),
+          "-processfile",
+          FilePath(BSTestDetail::scenePathnameStr).GetRelativePathname(dataSourcePath)
+        };
+
+        std::unique_ptr<CommandLineModule> tool = std::make_unique<BinarySceneTool>(cmdLine);
+        DAVA::ConsoleModuleTestExecution::ExecuteModule(tool.get());
+
+        TEST_VERIFY(GetEngineContext()->fileSystem->Exists(BSTestDetail::binaryScenePathnameStr));
+
+        {
+            ScopedPtr<Scene> scene(new Scene());
+            TEST_VERIFY(scene->LoadScene(BSTestDetail::scenePathnameStr) == SceneFileV2::ERROR_NO_ERROR);
+
+            ScopedPtr<Scene> binaryScene(new Scene());
+            TEST_VERIFY(binaryScene->LoadScene(BSTestDetail::binaryScenePathnameStr) == SceneFileV2::ERROR_NO_ERROR);
+
+            TEST_VERIFY(scene->GetChildrenCount() > 0);
+            TEST_VERIFY(IsSameHierarchy(scene, binaryScene));
+        }
+
+        CommandLineModuleTestUtils::ClearTestFolder(BSTestDetail::projectStr);
+    }
+};
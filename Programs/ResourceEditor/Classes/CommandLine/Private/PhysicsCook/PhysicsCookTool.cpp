@@ -0,0 +1,161 @@
+#include "Classes/CommandLine/PhysicsCookTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+#include <REPlatform/CommandLine/SceneConsoleHelper.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Physics/PhysicsCookingCache.h>
+#include <Physics/PhysicsModule.h>
+
+#include <Base/ScopedPtr.h>
+#include <Engine/Engine.h>
+#include <Engine/EngineContext.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <ModuleManager/ModuleManager.h>
+#include <Scene3D/Scene.h>
+
+namespace PhysicsCookToolDetails
+{
+const DAVA::String SCENE_EXTENSION = ".sc2";
+const DAVA::String REMOVE_UNUSED_OPTION = "-removeunused";
+
+DAVA::PhysicsCookingCache* GetCookingCache()
+{
+    return DAVA::GetEngineContext()->moduleManager->GetModule<DAVA::PhysicsModule>()->GetCookingCache();
+}
+}
+
+PhysicsCookTool::PhysicsCookTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-physicscook")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::InDir, VariantType(String("")), "Full path to folder with *.sc2 files, subfolders are processed too");
+    options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Full path to scene file *.sc2");
+    options.AddOption(OptionName::OutDir, VariantType(String("")), "Full path to folder for cooked geometry, e.g. Data/PhysicsCache/ of project");
+    options.AddOption(OptionName::QualityConfig, VariantType(String("")), "Full path for quality.yaml file");
+    options.AddOption(PhysicsCookToolDetails::REMOVE_UNUSED_OPTION, VariantType(false), "Delete cooked geometry which isn't used by processed scenes");
+}
+
+bool PhysicsCookTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    inFolder = options.GetOption(OptionName::InDir).AsString();
+    inFile = options.GetOption(OptionName::ProcessFile).AsString();
+    cacheFolder = options.GetOption(OptionName::OutDir).AsString();
+    removeUnused = options.GetOption(PhysicsCookToolDetails::REMOVE_UNUSED_OPTION).AsBool();
+
+    if (cacheFolder.IsEmpty())
+    {
+        Logger::Error("Output folder was not selected");
+        return false;
+    }
+    cacheFolder.MakeDirectoryPathname();
+
+    FilePath qualityTarget;
+    if (!inFolder.IsEmpty())
+    {
+        inFolder.MakeDirectoryPathname();
+        qualityTarget = inFolder;
+    }
+    else if (!inFile.IsEmpty())
+    {
+        qualityTarget = inFile;
+    }
+    else
+    {
+        Logger::Error("Neither input folder nor scene file was selected");
+        return false;
+    }
+
+    if (!SceneConsoleHelper::InitializeQualitySystem(options, qualityTarget))
+    {
+        Logger::Error("Cannot create path to quality.yaml from %s", qualityTarget.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    // Geometry is cooked again only if it is missing in output folder, so only output folder is searched
+    PhysicsCookingCache* cookingCache = PhysicsCookToolDetails::GetCookingCache();
+    prevReadOnlyFolders = cookingCache->GetReadOnlyFolders();
+    prevWritableFolder = cookingCache->GetWritableFolder();
+    prevWritableFolderLimit = cookingCache->GetWritableFolderLimit();
+    cookingCache->SetReadOnlyFolders(Vector<FilePath>());
+    cookingCache->SetWritableFolder(cacheFolder);
+    cookingCache->SetWritableFolderLimit(0);
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult PhysicsCookTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    if (!inFolder.IsEmpty())
+    {
+        Vector<FilePath> files = FileSystem::Instance()->EnumerateFilesInDirectory(inFolder, true);
+        for (const FilePath& scenePath : files)
+        {
+            if (scenePath.IsEqualToExtension(PhysicsCookToolDetails::SCENE_EXTENSION))
+            {
+                CookScene(scenePath);
+            }
+        }
+    }
+    else
+    {
+        CookScene(inFile);
+    }
+
+    PhysicsCookingCache* cookingCache = PhysicsCookToolDetails::GetCookingCache();
+    Logger::Info("Processed %u scenes, failed %u", cookedCount, failedCount);
+    if (failedCount > 0)
+    {
+        result = Result::RESULT_ERROR;
+    }
+    else if (removeUnused)
+    {
+        // scenes which failed to load may still need their geometry, so nothing is removed after failures
+        uint32 removedCount = cookingCache->RemoveUnusedEntries();
+        Logger::Info("Removed %u unused cooked geometry files", removedCount);
+    }
+
+    cookingCache->SetReadOnlyFolders(prevReadOnlyFolders);
+    cookingCache->SetWritableFolder(prevWritableFolder);
+    cookingCache->SetWritableFolderLimit(prevWritableFolderLimit);
+
+    return ConsoleModule::eFrameResult::FINISHED;
+}
+
+bool PhysicsCookTool::CookScene(const DAVA::FilePath& scenePath)
+{
+    using namespace DAVA;
+
+    ScopedPtr<Scene> scene(new Scene());
+    if (scene->LoadScene(scenePath) != SceneFileV2::eError::ERROR_NO_ERROR)
+    {
+        Logger::Error("Cannot load scene %s", scenePath.GetAbsolutePathname().c_str());
+        ++failedCount;
+        return false;
+    }
+
+    // PhysicsSystem creates shapes of new objects on update, cooked geometry is saved into cache
+    scene->Update(0.0f);
+
+    ++cookedCount;
+    Logger::Info("%s is cooked", scenePath.GetAbsolutePathname().c_str());
+    return true;
+}
+
+void PhysicsCookTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-physicscook -indir /Users/SmokeTest/Data/3d/Maps/ -outdir /Users/SmokeTest/Data/PhysicsCache/ -removeunused");
+    DAVA::Logger::Info("\t-physicscook -processfile /Users/SmokeTest/Data/3d/Maps/scene.sc2 -outdir /Users/SmokeTest/Data/PhysicsCache/");
+}
+
+DECL_TARC_MODULE(PhysicsCookTool);
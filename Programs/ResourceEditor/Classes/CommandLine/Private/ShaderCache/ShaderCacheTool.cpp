@@ -0,0 +1,199 @@
+#include "Classes/CommandLine/ShaderCacheTool.h"
+
+#include <REPlatform/CommandLine/OptionName.h>
+#include <REPlatform/CommandLine/SceneConsoleHelper.h>
+#include <REPlatform/Scene/SceneHelper.h>
+
+#include <TArc/Utils/ModuleCollection.h>
+
+#include <Base/ScopedPtr.h>
+#include <Engine/Engine.h>
+#include <FileSystem/FileList.h>
+#include <FileSystem/FileSystem.h>
+#include <Logger/Logger.h>
+#include <Render/Material/NMaterial.h>
+#include <Render/RHI/rhi_ShaderSource.h>
+#include <Render/ShaderCache.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/Systems/QualitySettingsSystem.h>
+#include <Time/SystemTimer.h>
+
+namespace ShaderCacheToolDetails
+{
+using namespace DAVA;
+
+void CollectScenes(const FilePath& folderPathname, Vector<FilePath>& scenes)
+{
+    ScopedPtr<FileList> fileList(new FileList(folderPathname));
+    for (int32 i = 0, count = fileList->GetCount(); i < count; ++i)
+    {
+        const FilePath& pathname = fileList->GetPathname(i);
+        if (fileList->IsDirectory(i))
+        {
+            if (!fileList->IsNavigationDirectory(i))
+            {
+                CollectScenes(pathname, scenes);
+            }
+        }
+        else if (pathname.IsEqualToExtension(".sc2"))
+        {
+            scenes.push_back(pathname);
+        }
+    }
+}
+
+// permutations are collected for every quality of material quality group, so cache fits any quality settings
+void CollectShaderPermutations(NMaterial* material, Vector<ShaderDescriptorCache::ShaderPermutation>& permutations)
+{
+    QualitySettingsSystem* qualitySystem = QualitySettingsSystem::Instance();
+
+    const FastName& qualityGroup = material->GetQualityGroup();
+    size_t qualityCount = qualitySystem->GetMaterialQualityCount(qualityGroup);
+    if (qualityCount == 0)
+    {
+        material->CollectShaderPermutations(qualitySystem->GetCurMaterialQuality(qualityGroup), permutations);
+    }
+
+    for (size_t i = 0; i < qualityCount; ++i)
+    {
+        material->CollectShaderPermutations(qualitySystem->GetMaterialQualityName(qualityGroup, i), permutations);
+    }
+}
+
+bool ParseApi(const String& apiName, rhi::Api& api)
+{
+    const std::pair<const char*, rhi::Api> apis[] =
+    {
+      { "gles2", rhi::RHI_GLES2 },
+      { "metal", rhi::RHI_METAL },
+      { "dx9", rhi::RHI_DX9 },
+      { "dx11", rhi::RHI_DX11 }
+    };
+
+    for (const auto& a : apis)
+    {
+        if (apiName == a.first)
+        {
+            api = a.second;
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+ShaderCacheTool::ShaderCacheTool(const DAVA::Vector<DAVA::String>& commandLine)
+    : CommandLineModule(commandLine, "-shadercache")
+{
+    using namespace DAVA;
+
+    options.AddOption(OptionName::Build, VariantType(false), "Enables build of shader source cache");
+    options.AddOption(OptionName::ProcessDir, VariantType(String("")), "Full path to folder with scenes *.sc2, scenes are searched recursively");
+    options.AddOption(OptionName::Output, VariantType(String("")), "Full pathname to output cache file");
+    options.AddOption(OptionName::Api, VariantType(String("gles2")), "Target rendering api: gles2, metal, dx9, dx11");
+    options.AddOption(OptionName::QualityConfig, VariantType(String("")), "Full path for quality.yaml file");
+}
+
+bool ShaderCacheTool::PostInitInternal()
+{
+    using namespace DAVA;
+
+    if (options.GetOption(OptionName::Build).AsBool())
+    {
+        commandAction = ACTION_BUILD;
+    }
+    else
+    {
+        Logger::Error("Wrong action was selected");
+        return false;
+    }
+
+    scenesFolder = options.GetOption(OptionName::ProcessDir).AsString();
+    if (scenesFolder.IsEmpty())
+    {
+        Logger::Error("Scenes folder was not set");
+        return false;
+    }
+    scenesFolder.MakeDirectoryPathname();
+
+    outputPathname = options.GetOption(OptionName::Output).AsString();
+    if (outputPathname.IsEmpty())
+    {
+        Logger::Error("Output file was not set");
+        return false;
+    }
+
+    String apiName = options.GetOption(OptionName::Api).AsString();
+    if (!ShaderCacheToolDetails::ParseApi(apiName, api))
+    {
+        Logger::Error("Unknown api %s", apiName.c_str());
+        return false;
+    }
+
+    bool qualityInitialized = SceneConsoleHelper::InitializeQualitySystem(options, scenesFolder);
+    if (!qualityInitialized)
+    {
+        Logger::Error("Cannot create path to quality.yaml from %s", scenesFolder.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+DAVA::ConsoleModule::eFrameResult ShaderCacheTool::OnFrameInternal()
+{
+    using namespace DAVA;
+
+    if (commandAction == ACTION_BUILD)
+    {
+        Vector<FilePath> scenes;
+        ShaderCacheToolDetails::CollectScenes(scenesFolder, scenes);
+
+        Vector<ShaderDescriptorCache::ShaderPermutation> permutations;
+        for (const FilePath& scenePathname : scenes)
+        {
+            ScopedPtr<Scene> scene(new Scene());
+            if (scene->LoadScene(scenePathname) != SceneFileV2::eError::ERROR_NO_ERROR)
+            {
+                Logger::Error("Cannot load scene %s", scenePathname.GetAbsolutePathname().c_str());
+                result = Result::RESULT_ERROR;
+                continue;
+            }
+
+            Set<NMaterial*> materials;
+            SceneHelper::BuildMaterialList(scene, materials);
+            for (NMaterial* material : materials)
+            {
+                ShaderCacheToolDetails::CollectShaderPermutations(material, permutations);
+            }
+        }
+
+        // output contains permutations of processed scenes only, not shaders compiled by editor itself
+        rhi::ShaderSourceCache::Clear();
+
+        int64 startUs = SystemTimer::GetUs();
+        uint32 compiledCount = ShaderDescriptorCache::PrecompileShaderSources(permutations, api);
+        int64 compileUs = SystemTimer::GetUs() - startUs;
+        Logger::Info("Precompiled %u shader permutations of %u scenes in %.2f s", compiledCount, static_cast<uint32>(scenes.size()), compileUs / 1000000.f);
+
+        GetEngineContext()->fileSystem->CreateDirectory(outputPathname.GetDirectory(), true);
+        rhi::ShaderSourceCache::Save(outputPathname.GetAbsolutePathname().c_str());
+    }
+
+    return DAVA::ConsoleModule::eFrameResult::FINISHED;
+}
+
+void ShaderCacheTool::BeforeDestroyedInternal()
+{
+    DAVA::SceneConsoleHelper::FlushRHI();
+}
+
+void ShaderCacheTool::ShowHelpInternal()
+{
+    CommandLineModule::ShowHelpInternal();
+
+    DAVA::Logger::Info("Examples:");
+    DAVA::Logger::Info("\t-shadercache -build -processdir /Users/Test/DataSource/3d/Maps/ -output /Users/Test/Data/ShaderSource.bin -api gles2");
+}
+
+DECL_TARC_MODULE(ShaderCacheTool);
@@ -0,0 +1,58 @@
+#include "Classes/CommandLine/ShaderCacheTool.h"
+
+#include <REPlatform/CommandLine/CommandLineModuleTestUtils.h>
+
+#include <TArc/Testing/ConsoleModuleTestExecution.h>
+#include <TArc/Testing/TArcUnitTests.h>
+
+#include <Base/BaseTypes.h>
+#include <Engine/Engine.h>
+#include <Render/RHI/rhi_ShaderSource.h>
+
+namespace SCTestDetail
+{
+const DAVA::String projectStr = "~doc:/Test/ShaderCacheTool/";
+const DAVA::String scenePathnameStr = projectStr + "DataSource/3d/Scene/testScene.sc2";
+const DAVA::String cachePathnameStr = projectStr + "Data/ShaderSource.bin";
+}
+
+DAVA_TARC_TESTCLASS(ShaderCacheToolTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(TArc)
+    DECLARE_COVERED_FILES("ShaderCacheTool.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    DAVA_TEST (BuildCache)
+    {
+        using namespace DAVA;
+
+        std::unique_ptr<CommandLineModuleTestUtils::TextureLoadingGuard> guard = CommandLineModuleTestUtils::CreateTextureGuard({ eGPUFamily::GPU_ORIGIN });
+        CommandLineModuleTestUtils::CreateProjectInfrastructure(SCTestDetail::projectStr);
+        CommandLineModuleTestUtils::SceneBuilder::CreateFullScene(SCTestDetail::scenePathnameStr, SCTestDetail::projectStr);
+
+        Vector<String> cmdLine =
+        {
+          "ResourceEditor",
+          "-shadercache",
+          "-build",
+          "-processdir",
+          FilePath(SCTestDetail::projectStr + "DataSource/3d/").GetAbsolutePathname(),
+          "-output",
+          FilePath(SCTestDetail::cachePathnameStr).GetAbsolutePathname(),
+          "-api",
+          "gles2"
+        };
+
+        std::unique_ptr<CommandLineModule> tool = std::make_unique<ShaderCacheTool>(cmdLine);
+        DAVA::ConsoleModuleTestExecution::ExecuteModule(tool.get());
+
+        TEST_VERIFY(GetEngineContext()->fileSystem->Exists(SCTestDetail::cachePathnameStr));
+
+        rhi::ShaderSourceCache::Load(FilePath(SCTestDetail::cachePathnameStr).GetAbsolutePathname().c_str());
+        TEST_VERIFY(rhi::ShaderSourceCache::GetEntryCount() > 0);
+
+        CommandLineModuleTestUtils::ClearTestFolder(SCTestDetail::projectStr);
+    }
+}
+;
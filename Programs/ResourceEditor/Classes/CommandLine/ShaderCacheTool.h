@@ -0,0 +1,37 @@
+#pragma once
+
+#include <REPlatform/Global/CommandLineModule.h>
+
+#include <FileSystem/FilePath.h>
+#include <Reflection/ReflectionRegistrator.h>
+#include <Render/RHI/rhi_Type.h>
+
+class ShaderCacheTool : public DAVA::CommandLineModule
+{
+public:
+    ShaderCacheTool(const DAVA::Vector<DAVA::String>& commandLine);
+
+protected:
+    bool PostInitInternal() override;
+    eFrameResult OnFrameInternal() override;
+    void BeforeDestroyedInternal() override;
+    void ShowHelpInternal() override;
+
+    DAVA::FilePath scenesFolder;
+    DAVA::FilePath outputPathname;
+    rhi::Api api = rhi::RHI_GLES2;
+
+    enum eAction : DAVA::int32
+    {
+        ACTION_NONE = -1,
+        ACTION_BUILD,
+    };
+    eAction commandAction = ACTION_NONE;
+
+    DAVA_VIRTUAL_REFLECTION_IN_PLACE(ShaderCacheTool, DAVA::CommandLineModule)
+    {
+        DAVA::ReflectionRegistrator<ShaderCacheTool>::Begin()[DAVA::M::CommandName("-shadercache")]
+        .ConstructorByPointer<DAVA::Vector<DAVA::String>>()
+        .End();
+    }
+};
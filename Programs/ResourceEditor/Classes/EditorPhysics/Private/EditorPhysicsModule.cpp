@@ -436,9 +436,23 @@ void EditorPhysicsModule::PostInit()
         FieldDescriptor descr;
         descr.type = ReflectedTypeDB::Get<ProjectManagerData>();
         descr.fieldName = FastName(ProjectManagerData::ProjectPathProperty);
-        binder->BindField(descr, [](const Any& v) {
+        binder->BindField(descr, [this](const Any& v) {
             PhysicsModule* module = DAVA::GetEngineContext()->moduleManager->GetModule<DAVA::PhysicsModule>();
             module->ReleaseMaterials();
+
+            // Editor only reads cache of project, geometry changed while editing is cooked in memory.
+            // Cache in project Data folder is built by -physicscook command line tool
+            PhysicsCookingCache* cookingCache = module->GetCookingCache();
+            cookingCache->SetWritableFolder(FilePath());
+            ProjectManagerData* projectData = GetAccessor()->GetGlobalContext()->GetData<ProjectManagerData>();
+            if (projectData != nullptr && projectData->GetProjectPath().IsEmpty() == false)
+            {
+                cookingCache->SetReadOnlyFolders({ projectData->GetDataPath() + "PhysicsCache/" });
+            }
+            else
+            {
+                cookingCache->SetReadOnlyFolders(Vector<FilePath>());
+            }
         });
     }
 
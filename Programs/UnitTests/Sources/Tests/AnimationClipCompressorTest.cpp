@@ -0,0 +1,162 @@
+#include "UnitTests/UnitTests.h"
+#include "Animation/AnimationClip.h"
+#include "Animation/AnimationClipCompressor.h"
+#include "Animation/AnimationTrack.h"
+#include "Base/BaseMath.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Utils/CRC32.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (AnimationClipCompressorTest)
+{
+    const FilePath testFolder = "~doc:/TestData/AnimationClipCompressorTest/";
+    const uint32 keysCount = 61;
+
+    template <class T>
+    void Write(Vector<uint8> & buffer, const T& value)
+    {
+        const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+    }
+
+    void WriteString(Vector<uint8> & buffer, const char* string)
+    {
+        buffer.insert(buffer.end(), string, string + strlen(string) + 1);
+        buffer.resize((buffer.size() + 3) & ~size_t(3), 0);
+    }
+
+    void WriteChannel(Vector<uint8> & buffer, AnimationTrack::eChannelTarget target, AnimationChannel::eInterpolation interpolation, uint8 dimension, const Function<void(float32, float32*)>& value, uint32 channelKeysCount)
+    {
+        Write(buffer, uint32(target));
+        Write(buffer, AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE);
+        Write(buffer, dimension);
+        Write(buffer, uint8(interpolation));
+        Write(buffer, uint16(AnimationChannel::COMPRESSION_NONE));
+        Write(buffer, channelKeysCount);
+        for (uint32 k = 0; k < channelKeysCount; ++k)
+        {
+            float32 time = k / 30.f;
+            float32 data[4];
+            value(time, data);
+
+            Write(buffer, time);
+            buffer.insert(buffer.end(), reinterpret_cast<uint8*>(data), reinterpret_cast<uint8*>(data + dimension));
+        }
+    }
+
+    // clip of one track with moving position, rotating orientation and constant scale,
+    // `withEmptyChannel` adds scale channel without keys
+    void WriteSourceClip(const FilePath& path, bool withEmptyChannel = false)
+    {
+        Vector<uint8> data;
+        Write(data, float32(keysCount - 1) / 30.f);
+        Write(data, uint32(1));
+        WriteString(data, "joint_uid");
+        WriteString(data, "joint");
+        Write(data, AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE);
+        Write(data, uint32(withEmptyChannel ? 4 : 3));
+        WriteChannel(data, AnimationTrack::CHANNEL_TARGET_POSITION, AnimationChannel::INTERPOLATION_LINEAR, 3, [](float32 t, float32* out) {
+            Vector3 position(std::sin(t) * 10.f, t * 2.f, -1.f);
+            Memcpy(out, position.data, sizeof(position.data));
+        }, keysCount);
+        WriteChannel(data, AnimationTrack::CHANNEL_TARGET_ORIENTATION, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR, 4, [](float32 t, float32* out) {
+            Quaternion orientation = Quaternion::MakeRotation(Vector3(0.f, 0.6f, 0.8f), t * 3.f);
+            Memcpy(out, orientation.data, sizeof(orientation.data));
+        }, keysCount);
+        WriteChannel(data, AnimationTrack::CHANNEL_TARGET_SCALE, AnimationChannel::INTERPOLATION_LINEAR, 1, [](float32 t, float32* out) {
+            *out = 1.5f;
+        }, keysCount);
+        if (withEmptyChannel)
+        {
+            WriteChannel(data, AnimationTrack::CHANNEL_TARGET_SCALE, AnimationChannel::INTERPOLATION_LINEAR, 1, [](float32 t, float32* out) {}, 0);
+        }
+        Write(data, uint32(1));
+        WriteString(data, "marker");
+        Write(data, 0.5f);
+
+        AnimationClip::FileHeader header;
+        header.signature = AnimationClip::ANIMATION_CLIP_FILE_SIGNATURE;
+        header.version = 1;
+        header.crc32 = CRC32::ForBuffer(data.data(), data.size());
+        header.dataSize = uint32(data.size());
+
+        ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+        file->Write(&header);
+        file->Write(data.data(), header.dataSize);
+    }
+
+    AnimationClipCompressorTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(testFolder, true);
+        FileSystem::Instance()->CreateDirectory(testFolder, true);
+    }
+
+    ~AnimationClipCompressorTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(testFolder, true);
+    }
+
+    DAVA_TEST (CompressedClipMatchesOriginal)
+    {
+        FilePath sourcePath = testFolder + "source.anim";
+        FilePath compressedPath = testFolder + "compressed.anim";
+        WriteSourceClip(sourcePath);
+
+        AnimationClipCompressor::Report report;
+        TEST_VERIFY(AnimationClipCompressor::Compress(sourcePath, compressedPath, AnimationClipCompressor::Params(), &report));
+        TEST_VERIFY(report.channelsCount == 3);
+        TEST_VERIFY(report.constantChannelsCount == 1);
+        TEST_VERIFY(report.quantizedChannelsCount == 2);
+        TEST_VERIFY(report.compressedSize * 2 < report.originalSize);
+        TEST_VERIFY(report.maxPositionError < 1e-3f);
+        TEST_VERIFY(report.maxOrientationError < 2e-3f);
+        TEST_VERIFY(report.maxScaleError < 1e-6f);
+
+        ScopedPtr<AnimationClip> clip(AnimationClip::Load(compressedPath));
+        TEST_VERIFY(clip);
+        if (clip)
+        {
+            const AnimationTrack* track = clip->FindTrack("joint_uid");
+            TEST_VERIFY(track != nullptr && track->GetChannelsCount() == 3);
+            TEST_VERIFY(track->GetChannel(0).GetCompression() == AnimationChannel::COMPRESSION_QUANTIZED);
+            TEST_VERIFY(track->GetChannel(1).GetCompression() == AnimationChannel::COMPRESSION_QUANTIZED);
+            TEST_VERIFY(track->GetChannel(2).GetKeysCount() == 1);
+            TEST_VERIFY(clip->GetMarkerCount() == 1 && strcmp(clip->GetMarkerName(0), "marker") == 0);
+
+            // random access and sequential evaluation must find same keys
+            float32 sequential[4];
+            float32 random[4];
+            uint32 cursor = 0;
+            for (uint32 s = 0; s < 100; ++s)
+            {
+                float32 time = s * 0.021f;
+                uint32 randomCursor = (s * 37) % keysCount;
+                track->Evaluate(time, 0, sequential, 4, &cursor);
+                track->Evaluate(time, 0, random, 4, &randomCursor);
+                TEST_VERIFY(Vector3(sequential) == Vector3(random));
+            }
+        }
+    }
+
+    DAVA_TEST (EmptyChannelIsSkipped)
+    {
+        FilePath sourcePath = testFolder + "empty_channel.anim";
+        FilePath compressedPath = testFolder + "empty_channel_compressed.anim";
+        WriteSourceClip(sourcePath, true);
+
+        ScopedPtr<AnimationClip> clip(AnimationClip::Load(sourcePath));
+        TEST_VERIFY(clip);
+        if (clip)
+        {
+            const AnimationTrack* track = clip->FindTrack("joint_uid");
+            TEST_VERIFY(track != nullptr && track->GetChannelsCount() == 3);
+            TEST_VERIFY(clip->GetMarkerCount() == 1);
+        }
+
+        AnimationClipCompressor::Report report;
+        TEST_VERIFY(AnimationClipCompressor::Compress(sourcePath, compressedPath, AnimationClipCompressor::Params(), &report));
+        TEST_VERIFY(report.channelsCount == 3);
+    }
+};
@@ -2,6 +2,7 @@
 #include <FileSystem/Private/PackArchive.h>
 #include <FileSystem/Private/ZipArchive.h>
 #include <FileSystem/FileSystem.h>
+#include <Concurrency/Thread.h>
 #include <Logger/Logger.h>
 
 #include <cstring>
@@ -58,6 +59,168 @@ DAVA_TESTCLASS (ArchiveTest)
 #endif // __DAVAENGINE_IPHONE__
     }
 
+    DAVA_TEST (TestDavaArchiveConcurrentLoad)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        try
+        {
+            RefPtr<File> fileDvpk(File::Create("~res:/TestData/ArchiveTest/archive.dvpk", File::OPEN | File::READ));
+            PackArchive archive(fileDvpk, "~res:/TestData/ArchiveTest/archive.dvpk");
+
+            const Vector<ResourceArchive::FileInfo>& filesInfo = archive.GetFilesInfo();
+            Vector<Vector<uint8>> expected(filesInfo.size());
+            for (size_t i = 0; i < filesInfo.size(); ++i)
+            {
+                TEST_VERIFY(archive.LoadFile(filesInfo[i].relativeFilePath, expected[i]));
+            }
+
+            const uint32 threadsCount = 4;
+            Array<bool, threadsCount> results;
+            Vector<Thread*> threads;
+            for (uint32 t = 0; t < threadsCount; ++t)
+            {
+                results[t] = true;
+                threads.push_back(Thread::Create([&, t]() {
+                    Vector<uint8> content;
+                    for (uint32 pass = 0; pass < 10; ++pass)
+                    {
+                        for (size_t i = 0; i < filesInfo.size(); ++i)
+                        {
+                            results[t] = results[t] && archive.LoadFile(filesInfo[i].relativeFilePath, content) && content == expected[i];
+                        }
+                    }
+                }));
+                threads.back()->Start();
+            }
+
+            for (Thread* thread : threads)
+            {
+                thread->Join();
+                thread->Release();
+            }
+
+            for (bool result : results)
+            {
+                TEST_VERIFY(result);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Info(ex.what());
+        }
+#endif // __DAVAENGINE_IPHONE__
+    }
+
+    DAVA_TEST (TestDavaArchiveConcurrentFileView)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        try
+        {
+            const FilePath archivePath("~res:/TestData/ArchiveTest/archive.dvpk");
+
+            RefPtr<File> fileDvpk(File::Create(archivePath, File::OPEN | File::READ));
+            PackArchive archive(fileDvpk, archivePath);
+
+            const Vector<ResourceArchive::FileInfo>& filesInfo = archive.GetFilesInfo();
+            Vector<Vector<uint8>> expected(filesInfo.size());
+            for (size_t i = 0; i < filesInfo.size(); ++i)
+            {
+                TEST_VERIFY(archive.LoadFile(filesInfo[i].relativeFilePath, expected[i]));
+            }
+
+            // views and decompressed copies are requested from same archive simultaneously,
+            // first view request of every file also verifies its crc32
+            const uint32 threadsCount = 4;
+            Array<bool, threadsCount> results;
+            Vector<Thread*> threads;
+            for (uint32 t = 0; t < threadsCount; ++t)
+            {
+                results[t] = true;
+                threads.push_back(Thread::Create([&, t]() {
+                    Vector<uint8> content;
+                    for (uint32 pass = 0; pass < 10; ++pass)
+                    {
+                        for (size_t i = 0; i < filesInfo.size(); ++i)
+                        {
+                            const String& relativePath = filesInfo[i].relativeFilePath;
+                            ResourceArchive::FileView view;
+                            if (archive.GetFileView(relativePath, view))
+                            {
+                                results[t] = results[t] && view.size == expected[i].size() && std::equal(view.data, view.data + view.size, expected[i].begin());
+                            }
+                            else
+                            {
+                                results[t] = results[t] && archive.LoadFile(relativePath, content) && content == expected[i];
+                            }
+                        }
+                    }
+                }));
+                threads.back()->Start();
+            }
+
+            for (Thread* thread : threads)
+            {
+                thread->Join();
+                thread->Release();
+            }
+
+            for (bool result : results)
+            {
+                TEST_VERIFY(result);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Info(ex.what());
+        }
+#endif // __DAVAENGINE_IPHONE__
+    }
+
+    DAVA_TEST (TestDavaArchiveFileView)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        try
+        {
+            ResourceArchive::FileView view;
+            Vector<uint8> viewContent;
+            {
+                RefPtr<File> fileDvpk(File::Create("~res:/TestData/ArchiveTest/archive.dvpk", File::OPEN | File::READ));
+                PackArchive archive(fileDvpk, "~res:/TestData/ArchiveTest/archive.dvpk");
+
+                for (const ResourceArchive::FileInfo& info : archive.GetFilesInfo())
+                {
+                    Vector<uint8> content;
+                    TEST_VERIFY(archive.LoadFile(info.relativeFilePath, content));
+
+                    ResourceArchive::FileView fileView;
+                    if (archive.GetFileView(info.relativeFilePath, fileView))
+                    {
+                        TEST_VERIFY(info.compressionType == Compressor::Type::None);
+                        TEST_VERIFY(fileView.size == content.size());
+                        TEST_VERIFY(std::equal(content.begin(), content.end(), fileView.data));
+                        view = fileView;
+                        viewContent = content;
+                    }
+                    else
+                    {
+                        TEST_VERIFY(info.compressionType != Compressor::Type::None);
+                    }
+                }
+            }
+
+            // view keeps content mapped after archive is destroyed
+            if (view.data != nullptr)
+            {
+                TEST_VERIFY(std::equal(viewContent.begin(), viewContent.end(), view.data));
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Info(ex.what());
+        }
+#endif // __DAVAENGINE_IPHONE__
+    }
+
     DAVA_TEST (TestZipArchive)
     {
         try
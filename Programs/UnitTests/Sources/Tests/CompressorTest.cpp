@@ -1,5 +1,6 @@
 #include <Compression/ZipCompressor.h>
 #include <Compression/LZ4Compressor.h>
+#include <Utils/StringFormat.h>
 
 #include "UnitTests/UnitTests.h"
 
@@ -60,4 +61,43 @@ DAVA_TESTCLASS (CompressorTest)
             TEST_VERIFY(uncompressedZip == in);
         }
     }
+
+    DAVA_TEST (TestLZ4Dict)
+    {
+        Vector<Vector<uint8>> samples;
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            String sample = Format("material:\n  name: mat_%u\n  shader: ~res:/Materials/Shaders/Default/materials\n  textures:\n    albedo: ~res:/3d/tex_%u.tex\n", i, i * 7);
+            samples.emplace_back(sample.begin(), sample.end());
+        }
+
+        Vector<uint8> dictionary = LZ4DictCompressor::TrainDictionary(samples);
+        TEST_VERIFY(!dictionary.empty());
+        TEST_VERIFY(dictionary.size() <= LZ4DictCompressor::MAX_DICTIONARY_SIZE);
+
+        LZ4DictCompressor lz4dict(dictionary);
+        LZ4HCCompressor lz4hc;
+
+        const Vector<uint8>& in = samples.back();
+
+        Vector<uint8> compressedLz4dict;
+        TEST_VERIFY(lz4dict.Compress(in, compressedLz4dict));
+
+        Vector<uint8> compressedLz4hc;
+        TEST_VERIFY(lz4hc.Compress(in, compressedLz4hc));
+
+        TEST_VERIFY(compressedLz4hc.size() > compressedLz4dict.size());
+
+        Vector<uint8> uncompressedLz4dict(in.size(), '\0');
+        TEST_VERIFY(lz4dict.Decompress(compressedLz4dict, uncompressedLz4dict));
+        TEST_VERIFY(uncompressedLz4dict == in);
+
+        // content compressed with one dictionary can't be decompressed with another
+        LZ4DictCompressor emptyDict(Vector<uint8>{});
+        TEST_VERIFY(!emptyDict.Decompress(compressedLz4dict, uncompressedLz4dict));
+
+        LZ4DictCompressor::RegisterDictionary(dictionary);
+        std::shared_ptr<const LZ4DictCompressor> registered = LZ4DictCompressor::GetRegistered(LZ4DictCompressor::GetDictionaryId(compressedLz4dict));
+        TEST_VERIFY(registered != nullptr && registered->GetDictionary() == dictionary);
+    }
 };
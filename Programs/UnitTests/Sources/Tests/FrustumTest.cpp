@@ -0,0 +1,41 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/Highlevel/Frustum.h"
+#include "Math/AABBox3x4.h"
+#include "Utils/Random.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FrustumTest)
+{
+    DAVA_TEST (BoxesSoATest)
+    {
+        Matrix4 view;
+        view.BuildLookAtMatrix(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+        Matrix4 projection;
+        projection.BuildPerspective(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 100.0f, false);
+
+        ScopedPtr<Frustum> frustum(new Frustum());
+        frustum->Build(view * projection, false);
+
+        Random* random = Random::Instance();
+        for (uint32 iteration = 0; iteration < 1000; ++iteration)
+        {
+            AABBox3 boxes[AABBox3x4::BOX_COUNT];
+            AABBox3x4 boxesSoA;
+            for (uint32 i = 0; i < AABBox3x4::BOX_COUNT; ++i)
+            {
+                Vector3 center(random->RandFloat32InBounds(-150.0f, 150.0f), random->RandFloat32InBounds(-150.0f, 150.0f), random->RandFloat32InBounds(-150.0f, 150.0f));
+                boxes[i] = AABBox3(center, random->RandFloat32InBounds(0.1f, 20.0f));
+                boxesSoA.Set(i, boxes[i]);
+            }
+
+            const uint8 planeMask = 0x3f;
+            uint32 insideMask = frustum->IsInside(boxesSoA, planeMask);
+            for (uint32 i = 0; i < AABBox3x4::BOX_COUNT; ++i)
+            {
+                bool inside = (insideMask & (1 << i)) != 0;
+                TEST_VERIFY(inside == frustum->IsInside(boxes[i]));
+            }
+        }
+    }
+};
@@ -83,8 +83,37 @@ DAVA_TESTCLASS (JobManagerTest)
 
     DAVA_TEST (TestWorkerJobs)
     {
-        // TODO:
-        // ...
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> counter(0);
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            jobManager->CreateWorkerJob([&counter]() { counter++; });
+        }
+        jobManager->WaitWorkerJobs();
+
+        TEST_VERIFY(!jobManager->HasWorkerJobs());
+        TEST_VERIFY(counter == JOBS_COUNT);
+    }
+
+    DAVA_TEST (TestWorkerJobHandles)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> counter(0);
+        uint32 counterInDependentJob = 0;
+
+        JobHandle group = jobManager->CreateWorkerJobGroup();
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            jobManager->CreateWorkerJob([&counter]() { counter++; }, group);
+        }
+        JobHandle dependent = jobManager->CreateWorkerJobAfter(group, [&]() { counterInDependentJob = counter; });
+        jobManager->SealWorkerJobGroup(group);
+        jobManager->WaitWorkerJob(dependent);
+
+        TEST_VERIFY(group->IsDone());
+        TEST_VERIFY(counterInDependentJob == JOBS_COUNT);
     }
 
     void ThreadFunc(JobManagerTestData * data)
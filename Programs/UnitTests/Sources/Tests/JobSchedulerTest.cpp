@@ -0,0 +1,154 @@
+#include "DAVAEngine.h"
+#include "Job/JobScheduler.h"
+#include "Job/WorkStealingDeque.h"
+#include "UnitTests/UnitTests.h"
+
+#include <atomic>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (JobSchedulerTest)
+{
+    DAVA_TEST (WorkStealingDequeTest)
+    {
+        WorkStealingDeque<int32> deque(4);
+        int32 values[5] = { 0, 1, 2, 3, 4 };
+
+        TEST_VERIFY(deque.Pop() == nullptr);
+        TEST_VERIFY(deque.Steal() == nullptr);
+
+        for (int32 i = 0; i < 4; ++i)
+        {
+            TEST_VERIFY(deque.Push(&values[i]));
+        }
+        TEST_VERIFY(!deque.Push(&values[4]));
+        TEST_VERIFY(deque.GetApproxSize() == 4);
+
+        // owner takes from the bottom, thieves from the top
+        TEST_VERIFY(deque.Pop() == &values[3]);
+        TEST_VERIFY(deque.Steal() == &values[0]);
+        TEST_VERIFY(deque.Pop() == &values[2]);
+        TEST_VERIFY(deque.Steal() == &values[1]);
+        TEST_VERIFY(deque.Pop() == nullptr);
+        TEST_VERIFY(deque.Steal() == nullptr);
+    }
+
+    DAVA_TEST (ManyJobsTest)
+    {
+        JobScheduler scheduler(4);
+
+        const int32 jobsCount = 10000;
+        std::atomic<int32> counter(0);
+
+        JobHandle group = scheduler.CreateGroup();
+        for (int32 i = 0; i < jobsCount; ++i)
+        {
+            scheduler.Schedule([&counter]() { counter++; }, group);
+        }
+        scheduler.SealGroup(group);
+        scheduler.Wait(group);
+
+        TEST_VERIFY(group->IsDone());
+        TEST_VERIFY(counter == jobsCount);
+    }
+
+    DAVA_TEST (HierarchyAndDependencyTest)
+    {
+        JobScheduler scheduler(4);
+
+        const int32 childrenCount = 100;
+        const int32 grandChildrenCount = 10;
+        std::atomic<int32> counter(0);
+        int32 counterInContinuation = -1;
+
+        // children are spawned from worker threads and should be pushed into worker deques
+        JobHandle root = scheduler.CreateGroup();
+        for (int32 i = 0; i < childrenCount; ++i)
+        {
+            scheduler.Schedule([&]() {
+                for (int32 j = 0; j < grandChildrenCount; ++j)
+                {
+                    scheduler.Schedule([&counter]() { counter++; }, root);
+                }
+            },
+                               root);
+        }
+
+        JobHandle continuation = scheduler.ScheduleAfter(root, [&]() { counterInContinuation = counter; });
+        scheduler.SealGroup(root);
+        scheduler.Wait(continuation);
+
+        TEST_VERIFY(root->IsDone());
+        TEST_VERIFY(counterInContinuation == childrenCount * grandChildrenCount);
+    }
+
+    DAVA_TEST (ContinuationScheduledBeforeChildrenTest)
+    {
+        JobScheduler scheduler(4);
+
+        const int32 childrenCount = 100;
+        std::atomic<int32> counter(0);
+        int32 counterInContinuation = -1;
+
+        // Continuation is scheduled while the group is still empty and must not run until the group is sealed
+        JobHandle group = scheduler.CreateGroup();
+        JobHandle continuation = scheduler.ScheduleAfter(group, [&]() { counterInContinuation = counter; });
+        TEST_VERIFY(!group->IsDone());
+        TEST_VERIFY(!continuation->IsDone());
+
+        for (int32 i = 0; i < childrenCount; ++i)
+        {
+            scheduler.Schedule([&counter]() {
+                Thread::Sleep(1);
+                counter++;
+            },
+                               group);
+        }
+        TEST_VERIFY(!continuation->IsDone());
+
+        scheduler.SealGroup(group);
+        scheduler.Wait(continuation);
+
+        TEST_VERIFY(group->IsDone());
+        TEST_VERIFY(counter == childrenCount);
+        TEST_VERIFY(counterInContinuation == childrenCount);
+    }
+
+    DAVA_TEST (EmptySealedGroupTest)
+    {
+        JobScheduler scheduler(2);
+
+        JobHandle group = scheduler.CreateGroup();
+        TEST_VERIFY(!group->IsDone());
+
+        scheduler.SealGroup(group);
+        TEST_VERIFY(group->IsDone());
+    }
+
+    DAVA_TEST (ParallelForTest)
+    {
+        JobScheduler scheduler(4);
+
+        const uint32 count = 100000;
+        Vector<uint32> data(count, 0);
+
+        scheduler.ParallelFor(0, count, 0, [&data](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                data[i] += i;
+            }
+        });
+
+        bool allProcessedOnce = true;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            allProcessedOnce &= (data[i] == i);
+        }
+        TEST_VERIFY(allProcessedOnce);
+
+        uint32 calls = 0;
+        scheduler.ParallelFor(10, 10, 1, [&calls](uint32, uint32) { calls++; });
+        TEST_VERIFY(calls == 0);
+    }
+}
+;
@@ -0,0 +1,67 @@
+#include "UnitTests/UnitTests.h"
+#include "Scene3D/SkeletonAnimation/JointTransform.h"
+#include "Utils/Random.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (JointTransformTest)
+{
+    JointTransform MakeRandomTransform()
+    {
+        Random* random = Random::Instance();
+
+        Vector3 axis(random->RandFloat32InBounds(-1.0f, 1.0f), random->RandFloat32InBounds(-1.0f, 1.0f), random->RandFloat32InBounds(-1.0f, 1.0f));
+        axis.Normalize();
+        Quaternion orientation = Quaternion::MakeRotation(axis, random->RandFloat32InBounds(-PI, PI));
+
+        JointTransform transform;
+        transform.SetPosition(Vector3(random->RandFloat32InBounds(-10.0f, 10.0f), random->RandFloat32InBounds(-10.0f, 10.0f), random->RandFloat32InBounds(-10.0f, 10.0f)));
+        transform.SetOrientation(orientation);
+        transform.SetScale(random->RandFloat32InBounds(0.5f, 2.0f));
+        return transform;
+    }
+
+    bool IsEqual(const Vector4& v0, const Vector4& v1)
+    {
+        const float32 eps = 1e-4f;
+        return FLOAT_EQUAL_EPS(v0.x, v1.x, eps) && FLOAT_EQUAL_EPS(v0.y, v1.y, eps) && FLOAT_EQUAL_EPS(v0.z, v1.z, eps) && FLOAT_EQUAL_EPS(v0.w, v1.w, eps);
+    }
+
+    DAVA_TEST (AppendTransformMatchesScalarComposition)
+    {
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            JointTransform t0 = MakeRandomTransform();
+            JointTransform t1 = MakeRandomTransform();
+
+            Vector3 expectedPosition = t0.GetPosition() + t0.GetOrientation().ApplyToVectorFast(t1.GetPosition()) * t0.GetScale();
+            Quaternion expectedOrientation = t0.GetOrientation() * t1.GetOrientation();
+            float32 expectedScale = t0.GetScale() * t1.GetScale();
+
+            JointTransform result = t0.AppendTransform(t1);
+            TEST_VERIFY(IsEqual(Vector4(result.GetPosition(), result.GetScale()), Vector4(expectedPosition, expectedScale)));
+            TEST_VERIFY(IsEqual(Vector4(result.GetOrientation().data), Vector4(expectedOrientation.data)));
+            TEST_VERIFY(result.HasPosition() && result.HasOrientation() && result.HasScale());
+
+            Vector4 packedPosition;
+            Vector4 packedOrientation;
+            t0.AppendTransform(t1, packedPosition, packedOrientation);
+            TEST_VERIFY(IsEqual(packedPosition, Vector4(result.GetPosition(), result.GetScale())));
+            TEST_VERIFY(IsEqual(packedOrientation, Vector4(result.GetOrientation().data)));
+        }
+    }
+
+    DAVA_TEST (AppendTransformKeepsMissingOrientation)
+    {
+        JointTransform t0;
+        t0.SetPosition(Vector3(1.0f, 2.0f, 3.0f));
+
+        JointTransform t1 = MakeRandomTransform();
+        JointTransform result = t0.AppendTransform(t1);
+        TEST_VERIFY(result.GetOrientation() == t1.GetOrientation());
+        TEST_VERIFY(IsEqual(Vector4(result.GetPosition(), result.GetScale()), Vector4(t0.GetPosition() + t1.GetPosition(), t1.GetScale())));
+
+        result = t1.AppendTransform(t0);
+        TEST_VERIFY(result.GetOrientation() == t1.GetOrientation());
+    }
+};
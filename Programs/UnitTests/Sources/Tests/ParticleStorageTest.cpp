@@ -0,0 +1,122 @@
+#include "UnitTests/UnitTests.h"
+#include "Particles/ParticleStorage.h"
+#include "Utils/Random.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (ParticleStorageTest)
+{
+    void FillRandom(ParticleStorage& particles, uint32 count)
+    {
+        Random* random = Random::Instance();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            uint32 index = particles.Add();
+            particles.SetPosition(index, Vector3(random->RandFloat32InBounds(-50.0f, 50.0f), random->RandFloat32InBounds(-50.0f, 50.0f), random->RandFloat32InBounds(-50.0f, 50.0f)));
+            particles.SetSpeed(index, Vector3(random->RandFloat32InBounds(-5.0f, 5.0f), random->RandFloat32InBounds(-5.0f, 5.0f), random->RandFloat32InBounds(-5.0f, 5.0f)));
+            particles.life[index] = random->RandFloat32InBounds(0.0f, 2.0f);
+            particles.lifeTime[index] = 1.0f;
+            particles.spin[index] = random->RandFloat32InBounds(-1.0f, 1.0f);
+            particles.currRadius[index] = random->RandFloat32InBounds(0.0f, 3.0f);
+            particles.seed[index] = i;
+        }
+    }
+
+    DAVA_TEST (RemoveKeepsAttributesTogether)
+    {
+        ParticleStorage particles;
+        FillRandom(particles, 37);
+
+        uint32 deadCount = 0;
+        for (uint32 i = 0; i < particles.GetCount(); ++i)
+            deadCount += (particles.life[i] >= particles.lifeTime[i]) ? 1 : 0;
+
+        Vector<Vector3> positionBySeed(particles.GetCount());
+        for (uint32 i = 0; i < particles.GetCount(); ++i)
+            positionBySeed[particles.seed[i]] = particles.GetPosition(i);
+
+        TEST_VERIFY(particles.RemoveDead(false) == deadCount);
+        TEST_VERIFY(particles.GetCount() == 37 - deadCount);
+        TEST_VERIFY(particles.positionX.size() == particles.GetCount());
+        TEST_VERIFY(particles.color.size() == particles.GetCount());
+        for (uint32 i = 0; i < particles.GetCount(); ++i)
+        {
+            TEST_VERIFY(particles.life[i] < particles.lifeTime[i]);
+            TEST_VERIFY(particles.GetPosition(i) == positionBySeed[particles.seed[i]]);
+        }
+
+        particles.Clear();
+        TEST_VERIFY(particles.IsEmpty());
+    }
+
+    DAVA_TEST (RemoveDeadKeepsOrder)
+    {
+        ParticleStorage particles;
+        FillRandom(particles, 37);
+
+        Vector<uint32> expectedSeeds;
+        Vector<Vector3> expectedPositions;
+        for (uint32 i = 0; i < particles.GetCount(); ++i)
+        {
+            if (particles.life[i] < particles.lifeTime[i])
+            {
+                expectedSeeds.push_back(particles.seed[i]);
+                expectedPositions.push_back(particles.GetPosition(i));
+            }
+        }
+
+        TEST_VERIFY(particles.RemoveDead(true) == 37 - expectedSeeds.size());
+        TEST_VERIFY(particles.GetCount() == expectedSeeds.size());
+        TEST_VERIFY(particles.color.size() == particles.GetCount());
+        TEST_VERIFY(particles.seed == expectedSeeds);
+        for (uint32 i = 0; i < particles.GetCount(); ++i)
+        {
+            TEST_VERIFY(particles.GetPosition(i) == expectedPositions[i]);
+        }
+
+        TEST_VERIFY(particles.RemoveDead(true) == 0);
+        TEST_VERIFY(particles.GetCount() == expectedSeeds.size());
+    }
+
+    DAVA_TEST (KernelsMatchScalarUpdate)
+    {
+        // 4n + 3 particles to cover both vector and tail loops
+        const uint32 count = 103;
+        const float32 dt = 0.033f;
+        ParticleStorage particles;
+        FillRandom(particles, count);
+        ParticleStorage expected = particles;
+
+        Vector<float32> scale(count);
+        for (float32& s : scale)
+            s = Random::Instance()->RandFloat32InBounds(0.0f, 2.0f);
+        Vector3 acceleration(0.0f, 0.0f, -9.8f);
+
+        particles.IntegratePositions(scale.data(), dt);
+        particles.IntegrateAngles(nullptr, dt);
+        particles.Accelerate(acceleration, scale.data(), dt);
+        particles.AddLife(dt);
+        Vector<float32> overLife(count);
+        particles.ComputeOverLife(overLife.data());
+
+        AABBox3 expectedBox;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            Vector3 position = expected.GetPosition(i) + expected.GetSpeed(i) * (scale[i] * dt);
+            Vector3 speed = expected.GetSpeed(i) + acceleration * (scale[i] * dt);
+            TEST_VERIFY(FLOAT_EQUAL_EPS(Distance(position, particles.GetPosition(i)), 0.0f, 1e-4f));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(Distance(speed, particles.GetSpeed(i)), 0.0f, 1e-4f));
+            TEST_VERIFY(FLOAT_EQUAL_EPS(expected.angle[i] + expected.spin[i] * dt, particles.angle[i], 1e-5f));
+            TEST_VERIFY(FLOAT_EQUAL_EPS((expected.life[i] + dt) / expected.lifeTime[i], overLife[i], 1e-5f));
+
+            Vector3 radius(particles.currRadius[i], particles.currRadius[i], particles.currRadius[i]);
+            expectedBox.AddPoint(particles.GetPosition(i) - radius);
+            expectedBox.AddPoint(particles.GetPosition(i) + radius);
+        }
+
+        AABBox3 box;
+        particles.AddToBBox(Vector3(0.0f, 0.0f, 0.0f), box);
+        TEST_VERIFY(box.min == expectedBox.min);
+        TEST_VERIFY(box.max == expectedBox.max);
+    }
+};
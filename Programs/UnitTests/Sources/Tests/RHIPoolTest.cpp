@@ -0,0 +1,115 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+#include "Render/RHI/Common/rhi_Pool.h"
+
+#include <algorithm>
+
+// resource layout matches NullRenderer buffers, pool is separate so test doesn't depend on active backend
+namespace rhi
+{
+struct RHIPoolTestResource_t : public ResourceImpl<RHIPoolTestResource_t, VertexBuffer::Descriptor>
+{
+    DAVA::uint32 payload = 0;
+};
+RHI_IMPL_RESOURCE(RHIPoolTestResource_t, VertexBuffer::Descriptor)
+
+using RHIPoolTestPool = ResourcePool<RHIPoolTestResource_t, RESOURCE_VERTEX_BUFFER, VertexBuffer::Descriptor>;
+RHI_IMPL_POOL(RHIPoolTestResource_t, RESOURCE_VERTEX_BUFFER, VertexBuffer::Descriptor, false);
+}
+
+using namespace DAVA;
+
+namespace RHIPoolTestDetails
+{
+const uint32 ThreadCount = 4;
+const uint32 HandlesPerThread = 256;
+const uint32 IterationsPerThread = 20000;
+
+uint32 HandleIndex(rhi::Handle h)
+{
+    using namespace rhi;
+    return RHI_HANDLE_INDEX(h);
+}
+}
+
+DAVA_TESTCLASS (RHIPoolTest)
+{
+    DAVA_TEST (AllocFreeGenerations)
+    {
+        rhi::Handle h = rhi::RHIPoolTestPool::Alloc();
+        TEST_VERIFY(h != rhi::InvalidHandle);
+        TEST_VERIFY(rhi::RHIPoolTestPool::IsAlive(h));
+        rhi::RHIPoolTestPool::Get(h)->payload = 42;
+        TEST_VERIFY(rhi::RHIPoolTestPool::Get(h)->payload == 42);
+
+        rhi::RHIPoolTestPool::Free(h);
+        TEST_VERIFY(!rhi::RHIPoolTestPool::IsAlive(h));
+
+        // freed entry goes to free list head, so it is reused with next generation
+        rhi::Handle reused = rhi::RHIPoolTestPool::Alloc();
+        TEST_VERIFY(RHIPoolTestDetails::HandleIndex(reused) == RHIPoolTestDetails::HandleIndex(h));
+        TEST_VERIFY(reused != h);
+        TEST_VERIFY(rhi::RHIPoolTestPool::IsAlive(reused));
+        TEST_VERIFY(!rhi::RHIPoolTestPool::IsAlive(h));
+        rhi::RHIPoolTestPool::Free(reused);
+    }
+
+    DAVA_TEST (ContendedAllocFree)
+    {
+        using namespace RHIPoolTestDetails;
+
+        Vector<Vector<rhi::Handle>> liveHandles(ThreadCount);
+        std::atomic<uint32> failures(0);
+
+        Vector<Thread*> threads;
+        for (uint32 t = 0; t < ThreadCount; ++t)
+        {
+            Vector<rhi::Handle>& handles = liveHandles[t];
+            threads.push_back(Thread::Create([t, &handles, &failures]() {
+                handles.resize(HandlesPerThread, rhi::InvalidHandle);
+                for (uint32 i = 0; i < IterationsPerThread; ++i)
+                {
+                    rhi::Handle& h = handles[i % HandlesPerThread];
+                    if (h != rhi::InvalidHandle)
+                    {
+                        if (!rhi::RHIPoolTestPool::IsAlive(h) || rhi::RHIPoolTestPool::Get(h)->payload != (t << 16 | (i % HandlesPerThread)))
+                            ++failures;
+                        rhi::RHIPoolTestPool::Free(h);
+                    }
+
+                    h = rhi::RHIPoolTestPool::Alloc();
+                    rhi::RHIPoolTestPool::Get(h)->payload = t << 16 | (i % HandlesPerThread);
+                }
+            }));
+        }
+
+        int64 startTime = SystemTimer::GetUs();
+        for (Thread* thread : threads)
+        {
+            thread->Start();
+        }
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+        int64 elapsedUs = SystemTimer::GetUs() - startTime;
+        Logger::Info("RHIPoolTest: %u threads made %u alloc/get/free cycles in %lld us", ThreadCount, ThreadCount * IterationsPerThread, static_cast<long long>(elapsedUs));
+
+        TEST_VERIFY(failures == 0);
+
+        // every live handle must point to its own entry
+        Vector<uint32> indices;
+        for (const Vector<rhi::Handle>& handles : liveHandles)
+        {
+            for (rhi::Handle h : handles)
+            {
+                TEST_VERIFY(rhi::RHIPoolTestPool::IsAlive(h));
+                indices.push_back(HandleIndex(h));
+                rhi::RHIPoolTestPool::Free(h);
+            }
+        }
+        std::sort(indices.begin(), indices.end());
+        TEST_VERIFY(std::adjacent_find(indices.begin(), indices.end()) == indices.end());
+    }
+};
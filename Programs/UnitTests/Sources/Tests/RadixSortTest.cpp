@@ -0,0 +1,83 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/Radix/Radix.h"
+
+#include <algorithm>
+
+DAVA_TESTCLASS (RadixSortTest)
+{
+    void SortAndVerify(const DAVA::Vector<DAVA::uint64>& source)
+    {
+        using namespace DAVA;
+
+        uint32 count = static_cast<uint32>(source.size());
+        Vector<uint64> keys = source;
+        Vector<uint32> values(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            values[i] = i;
+        }
+        Vector<uint64> tempKeys(count);
+        Vector<uint32> tempValues(count);
+
+        RadixSort64(keys.data(), values.data(), tempKeys.data(), tempValues.data(), count);
+
+        Vector<std::pair<uint64, uint32>> expected(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            expected[i] = std::make_pair(source[i], i);
+        }
+        std::stable_sort(expected.begin(), expected.end(), [](const std::pair<uint64, uint32>& a, const std::pair<uint64, uint32>& b) { return a.first < b.first; });
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            TEST_VERIFY(keys[i] == expected[i].first);
+            TEST_VERIFY(values[i] == expected[i].second);
+        }
+    }
+
+    DAVA_TEST (SortsRandomKeys)
+    {
+        using namespace DAVA;
+
+        uint64 seed = 0x9E3779B97F4A7C15ULL;
+        for (uint32 count : { 0u, 1u, 7u, 32u, 33u, 1000u, 10000u })
+        {
+            Vector<uint64> keys(count);
+            for (uint64& key : keys)
+            {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                key = seed;
+            }
+            SortAndVerify(keys);
+        }
+    }
+
+    DAVA_TEST (IsStableForEqualKeys)
+    {
+        using namespace DAVA;
+
+        // few distinct keys with differences in high and low bytes only
+        Vector<uint64> keys(5000);
+        for (uint32 i = 0; i < 5000; ++i)
+        {
+            keys[i] = (uint64(i % 3) << 60) | uint64((i * 7) % 5);
+        }
+        SortAndVerify(keys);
+    }
+
+    DAVA_TEST (KeepsSortedInput)
+    {
+        using namespace DAVA;
+
+        Vector<uint64> keys(1000);
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            keys[i] = uint64(i / 10) << 32;
+        }
+        SortAndVerify(keys);
+
+        std::reverse(keys.begin(), keys.end());
+        SortAndVerify(keys);
+    }
+};
@@ -3,6 +3,8 @@
 #include "UI/UIControl.h"
 #include "UI/Layouts/UILayoutSystem.h"
 #include "UI/Layouts/UIAnchorComponent.h"
+#include "UI/Layouts/UILinearLayoutComponent.h"
+#include "UI/Layouts/Private/Layouter.h"
 #include "UI/Layouts/UISizePolicyComponent.h"
 
 #include "UnitTests/UnitTests.h"
@@ -55,4 +57,89 @@ DAVA_TESTCLASS (UILayoutSystemTest)
         SafeRelease(parent);
         SafeRelease(child);
     }
+
+    DAVA_TEST (DirtySubtreeLayout_LaysOutSkippedSubtreeAfterResize)
+    {
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+        layoutSystem->fullLayoutRequired = false;
+
+        UIControl* screen = MakeRoot("screen");
+        screen->SetSize(Vector2(200.0f, 200.0f));
+
+        UIControl* parent = MakeChild(screen, "parent");
+        UISizePolicyComponent* parentSizePolicy = parent->GetOrCreateComponent<UISizePolicyComponent>();
+        parentSizePolicy->SetHorizontalPolicy(UISizePolicyComponent::PERCENT_OF_PARENT);
+        parentSizePolicy->SetHorizontalValue(100.0f);
+
+        UIControl* child = MakeChild(parent, "child");
+        UISizePolicyComponent* childSizePolicy = child->GetOrCreateComponent<UISizePolicyComponent>();
+        childSizePolicy->SetHorizontalPolicy(UISizePolicyComponent::PERCENT_OF_PARENT);
+        childSizePolicy->SetHorizontalValue(50.0f);
+
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(parent->GetSize().dx, 200.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(child->GetSize().dx, 100.0f, 0.01f));
+        TEST_VERIFY(!screen->IsLayoutSubtreeDirty());
+        TEST_VERIFY(!parent->IsLayoutSubtreeDirty());
+
+        // parent subtree is clean and skipped, but it has to be laid out because parent is resized
+        screen->SetSize(Vector2(300.0f, 200.0f));
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(parent->GetSize().dx, 300.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(child->GetSize().dx, 150.0f, 0.01f));
+
+        childSizePolicy->SetHorizontalValue(10.0f);
+        TEST_VERIFY(screen->IsLayoutSubtreeDirty());
+        TEST_VERIFY(parent->IsLayoutSubtreeDirty());
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(child->GetSize().dx, 30.0f, 0.01f));
+        TEST_VERIFY(!screen->IsLayoutSubtreeDirty());
+
+        SafeRelease(screen);
+        SafeRelease(parent);
+        SafeRelease(child);
+    }
+
+    DAVA_TEST (DirtySubtreeLayout_UpdatesVisibilityMarginsOfMovedSkippedSubtree)
+    {
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+        Rect visibilityRect = layoutSystem->sharedLayouter->GetVisibilityRect();
+        layoutSystem->sharedLayouter->SetVisibilityRect(Rect(0.0f, 0.0f, 150.0f, 200.0f));
+        layoutSystem->fullLayoutRequired = false;
+
+        UIControl* screen = MakeRoot("screen");
+        screen->SetSize(Vector2(200.0f, 200.0f));
+        screen->GetOrCreateComponent<UILinearLayoutComponent>()->SetOrientation(UILinearLayoutComponent::LEFT_TO_RIGHT);
+
+        UIControl* spacer = MakeChild(screen, "spacer");
+        UISizePolicyComponent* spacerSizePolicy = spacer->GetOrCreateComponent<UISizePolicyComponent>();
+        spacerSizePolicy->SetHorizontalPolicy(UISizePolicyComponent::FIXED_SIZE);
+        spacerSizePolicy->SetHorizontalValue(0.0f);
+
+        UIControl* panel = MakeChild(screen, "panel");
+        panel->SetSize(Vector2(100.0f, 100.0f));
+
+        // item is cut by right edge of visibility rect
+        UIControl* item = MakeChild(panel, "item");
+        UISizePolicyComponent* itemSizePolicy = item->GetOrCreateComponent<UISizePolicyComponent>();
+        itemSizePolicy->SetHorizontalPolicy(UISizePolicyComponent::FORMULA);
+        itemSizePolicy->SetHorizontalFormula("parent - visibilityMargins.left - visibilityMargins.right");
+
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(panel->GetPosition().x, 0.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(item->GetSize().dx, 100.0f, 0.01f));
+
+        // panel subtree is clean and skipped, but it is moved by linear layout and item depends on visibility margins
+        spacerSizePolicy->SetHorizontalValue(100.0f);
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(panel->GetPosition().x, 100.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(item->GetSize().dx, 50.0f, 0.01f));
+
+        layoutSystem->sharedLayouter->SetVisibilityRect(visibilityRect);
+
+        SafeRelease(screen);
+        SafeRelease(spacer);
+        SafeRelease(panel);
+        SafeRelease(item);
+    }
 };
@@ -0,0 +1,174 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "UI/UIControlPackageContext.h"
+#include "UI/UIControlSystem.h"
+#include "UI/Styles/UIStyleSheet.h"
+#include "UI/Styles/UIStyleSheetSystem.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIStyleSheetSystemTest)
+{
+    RefPtr<UIControl> root;
+    RefPtr<UIControl> child;
+    RefPtr<UIControl> grandChild;
+
+    void SetUp(const String& testName) override
+    {
+        // root
+        // |-child
+        //   |-grandChild
+        root = MakeRef<UIControl>();
+        child = MakeRef<UIControl>();
+        grandChild = MakeRef<UIControl>();
+        root->SetName("root");
+        child->SetName("child");
+        grandChild->SetName("grandChild");
+        root->AddControl(child.Get());
+        child->AddControl(grandChild.Get());
+
+        // selector chain is matched against control and its direct parents
+        RefPtr<UIControlPackageContext> context = MakeRef<UIControlPackageContext>();
+        AddStyleSheet(context.Get(), ".hidden", false);
+        AddStyleSheet(context.Get(), ".shown .hidden", true);
+        AddStyleSheet(context.Get(), ".gone ? .hidden", false);
+        AddStyleSheet(context.Get(), "#other", false);
+        root->SetPackageContext(context);
+    }
+
+    void TearDown(const String& testName) override
+    {
+        grandChild = nullptr;
+        child = nullptr;
+        root = nullptr;
+    }
+
+    void AddStyleSheet(UIControlPackageContext * context, const String& selector, bool visible)
+    {
+        const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+
+        ScopedPtr<UIStyleSheetPropertyTable> propertyTable(new UIStyleSheetPropertyTable());
+        propertyTable->SetProperties({ UIStyleSheetProperty(propertyDB->GetStyleSheetVisiblePropertyIndex(), Any(visible)) });
+
+        ScopedPtr<UIStyleSheet> styleSheet(new UIStyleSheet());
+        styleSheet->SetSelectorChain(UIStyleSheetSelectorChain(selector));
+        styleSheet->SetPropertyTable(propertyTable);
+        context->AddStyleSheet(UIPriorityStyleSheet(styleSheet));
+    }
+
+    void Process()
+    {
+        GetEngineContext()->uiControlSystem->GetStyleSheetSystem()->ProcessControl(root.Get());
+    }
+
+    DAVA_TEST (MatchRightmostSelector)
+    {
+        Process();
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+
+        grandChild->AddClass(FastName("hidden"));
+        Process();
+        TEST_VERIFY(!grandChild->GetVisibilityFlag());
+
+        grandChild->RemoveClass(FastName("hidden"));
+        Process();
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+    }
+
+    DAVA_TEST (ParentChangeInvalidatesChildren)
+    {
+        grandChild->AddClass(FastName("hidden"));
+        Process();
+        TEST_VERIFY(!grandChild->GetVisibilityFlag());
+
+        // ".shown .hidden" has better score than ".hidden"
+        child->AddClass(FastName("shown"));
+        Process();
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+
+        // class which isn't used by selectors doesn't change matching
+        child->AddClass(FastName("unused"));
+        Process();
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+
+        child->RemoveClass(FastName("shown"));
+        Process();
+        TEST_VERIFY(!grandChild->GetVisibilityFlag());
+    }
+
+    DAVA_TEST (GrandparentChangeInvalidatesGrandchildren)
+    {
+        grandChild->AddClass(FastName("hidden"));
+        child->AddClass(FastName("shown"));
+        Process();
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+
+        // child itself doesn't change, but ".gone ? .hidden" depends on root
+        root->AddClass(FastName("gone"));
+        Process();
+        TEST_VERIFY(!grandChild->GetVisibilityFlag());
+
+        root->RemoveClass(FastName("gone"));
+        Process();
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+    }
+
+    DAVA_TEST (ControlsWithSameClassesHaveOwnAncestors)
+    {
+        RefPtr<UIControl> sibling = MakeRef<UIControl>();
+        root->AddControl(sibling.Get());
+
+        sibling->AddClass(FastName("hidden"));
+        grandChild->AddClass(FastName("hidden"));
+        child->AddClass(FastName("shown"));
+        Process();
+        TEST_VERIFY(!sibling->GetVisibilityFlag());
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+
+        root->AddClass(FastName("shown"));
+        Process();
+        TEST_VERIFY(sibling->GetVisibilityFlag());
+        TEST_VERIFY(grandChild->GetVisibilityFlag());
+    }
+
+    DAVA_TEST (NestedPackageSeesAncestorsFromOuterPackage)
+    {
+        // root
+        // |-child
+        //   |-grandChild
+        //   |-nestedRoot (own package context)
+        //     |-nestedChild
+        RefPtr<UIControl> nestedRoot = MakeRef<UIControl>();
+        RefPtr<UIControl> nestedChild = MakeRef<UIControl>();
+        nestedRoot->AddControl(nestedChild.Get());
+        child->AddControl(nestedRoot.Get());
+
+        // "night" and "dark" are used only by selectors of nested package, so they don't change matching in outer one
+        RefPtr<UIControlPackageContext> nestedContext = MakeRef<UIControlPackageContext>();
+        AddStyleSheet(nestedContext.Get(), ".night ? .panel", false);
+        AddStyleSheet(nestedContext.Get(), ".dark ? ? .panel", false);
+        nestedRoot->SetPackageContext(nestedContext);
+
+        nestedChild->AddClass(FastName("panel"));
+        Process();
+        TEST_VERIFY(nestedChild->GetVisibilityFlag());
+
+        child->AddClass(FastName("night"));
+        Process();
+        TEST_VERIFY(!nestedChild->GetVisibilityFlag());
+
+        child->RemoveClass(FastName("night"));
+        Process();
+        TEST_VERIFY(nestedChild->GetVisibilityFlag());
+
+        // nested package is deeper than children of unchanged root
+        root->AddClass(FastName("dark"));
+        Process();
+        TEST_VERIFY(!nestedChild->GetVisibilityFlag());
+
+        root->RemoveClass(FastName("dark"));
+        Process();
+        TEST_VERIFY(nestedChild->GetVisibilityFlag());
+    }
+};
@@ -270,7 +270,7 @@ typedef struct {
 typedef enum { notLimited = 0, limited = 1 } limitedOutput_directive;
 typedef enum { byPtr, byU32, byU16 } tableType_t;
 
-typedef enum { noPrefix = 0, withPrefix = 1 } prefix64k_directive;
+typedef enum { noPrefix = 0, withPrefix = 1, usingExtDict = 2 } prefix64k_directive;
 
 typedef enum { endOnOutputSize = 0, endOnInputSize = 1 } endCondition_directive;
 typedef enum { full = 0, partial = 1 } earlyEnd_directive;
@@ -730,9 +730,11 @@ FORCE_INLINE int LZ4_decompress_generic(
                  int outputSize,         /* If endOnInput==endOnInputSize, this value is the max size of Output Buffer. */
 
                  int endOnInput,         /* endOnOutputSize, endOnInputSize */
-                 int prefix64k,          /* noPrefix, withPrefix */
+                 int prefix64k,          /* noPrefix, withPrefix, usingExtDict */
                  int partialDecoding,    /* full, partial */
-                 int targetOutputSize    /* only used if partialDecoding==partial */
+                 int targetOutputSize,   /* only used if partialDecoding==partial */
+                 const char* dictStart,  /* only used if prefix64k==usingExtDict */
+                 size_t dictSize         /* only used if prefix64k==usingExtDict */
                  )
 {
     /* Local Variables */
@@ -799,6 +801,7 @@ FORCE_INLINE int LZ4_decompress_generic(
         /* get offset */
         LZ4_READ_LITTLEENDIAN_16(ref,cpy,ip); ip+=2;
         if ((prefix64k==noPrefix) && (unlikely(ref < (BYTE* const)dest))) goto _output_error;   /* Error : offset outside destination buffer */
+        if ((prefix64k==usingExtDict) && (unlikely((size_t)(op-ref) > (size_t)(op-(BYTE*)dest) + dictSize))) goto _output_error;   /* Error : offset outside dictionary */
 
         /* get matchlength */
         if ((length=(token&ML_MASK)) == ML_MASK)
@@ -812,6 +815,30 @@ FORCE_INLINE int LZ4_decompress_generic(
             }
         }
 
+        /* copy match starting in external dictionary */
+        if ((prefix64k==usingExtDict) && ((size_t)(op-ref) > (size_t)(op-(BYTE*)dest)))
+        {
+            const size_t matchLength = length + MINMATCH;
+            const size_t fromDict = (size_t)(op-ref) - (size_t)(op-(BYTE*)dest);
+            const BYTE* const dictEnd = (const BYTE*)dictStart + dictSize;
+            if (unlikely(op+matchLength > oend-LASTLITERALS)) goto _output_error;   /* Error : last 5 bytes must be literals */
+            if (matchLength <= fromDict)
+            {
+                memcpy(op, dictEnd - fromDict, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                /* match continues from beginning of output, which may overlap with bytes being written */
+                BYTE* const endOfMatch = op + matchLength;
+                const BYTE* copyFrom = (const BYTE*)dest;
+                memcpy(op, dictEnd - fromDict, fromDict);
+                op += fromDict;
+                while (op < endOfMatch) *op++ = *copyFrom++;
+            }
+            continue;
+        }
+
         /* copy repeated sequence */
         if (unlikely((op-ref)<(int)STEPSIZE))
         {
@@ -855,30 +882,35 @@ _output_error:
 
 int LZ4_decompress_safe(const char* source, char* dest, int inputSize, int maxOutputSize)
 {
-    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, noPrefix, full, 0);
+    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, noPrefix, full, 0, NULL, 0);
 }
 
 int LZ4_decompress_safe_withPrefix64k(const char* source, char* dest, int inputSize, int maxOutputSize)
 {
-    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, withPrefix, full, 0);
+    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, withPrefix, full, 0, NULL, 0);
+}
+
+int LZ4_decompress_safe_usingDict(const char* source, char* dest, int inputSize, int maxOutputSize, const char* dictStart, int dictSize)
+{
+    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, usingExtDict, full, 0, dictStart, (size_t)dictSize);
 }
 
 int LZ4_decompress_safe_partial(const char* source, char* dest, int inputSize, int targetOutputSize, int maxOutputSize)
 {
-    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, noPrefix, partial, targetOutputSize);
+    return LZ4_decompress_generic(source, dest, inputSize, maxOutputSize, endOnInputSize, noPrefix, partial, targetOutputSize, NULL, 0);
 }
 
 int LZ4_decompress_fast_withPrefix64k(const char* source, char* dest, int outputSize)
 {
-    return LZ4_decompress_generic(source, dest, 0, outputSize, endOnOutputSize, withPrefix, full, 0);
+    return LZ4_decompress_generic(source, dest, 0, outputSize, endOnOutputSize, withPrefix, full, 0, NULL, 0);
 }
 
 int LZ4_decompress_fast(const char* source, char* dest, int outputSize)
 {
 #ifdef _MSC_VER   /* This version is faster with Visual */
-    return LZ4_decompress_generic(source, dest, 0, outputSize, endOnOutputSize, noPrefix, full, 0);
+    return LZ4_decompress_generic(source, dest, 0, outputSize, endOnOutputSize, noPrefix, full, 0, NULL, 0);
 #else
-    return LZ4_decompress_generic(source, dest, 0, outputSize, endOnOutputSize, withPrefix, full, 0);
+    return LZ4_decompress_generic(source, dest, 0, outputSize, endOnOutputSize, withPrefix, full, 0, NULL, 0);
 #endif
 }
 
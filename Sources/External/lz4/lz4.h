@@ -232,6 +232,15 @@ int LZ4_decompress_fast_withPrefix64k (const char* source, char* dest, int outpu
 */
 
 
+int LZ4_decompress_safe_usingDict (const char* source, char* dest, int inputSize, int maxOutputSize, const char* dictStart, int dictSize);
+
+/*
+LZ4_decompress_safe_usingDict() :
+    Works the same as LZ4_decompress_safe(), but matches can reference up to 64KB of 'dictStart',
+    as if dictionary was placed right in front of 'char* dest'. Dictionary may be located anywhere in memory.
+*/
+
+
 /**************************************
    Obsolete Functions
 **************************************/
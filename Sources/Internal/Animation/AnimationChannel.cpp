@@ -4,89 +4,160 @@
 
 namespace DAVA
 {
+namespace AnimationChannelDetails
+{
+//sequential playback usually moves by zero or one key, longer jumps are searched with bisection
+const uint32 LINEAR_SEARCH_KEYS = 4;
+
+const uint32 QUATERNION_COMPONENT_BITS = 15;
+const float32 QUATERNION_COMPONENT_MAX = float32((1 << QUATERNION_COMPONENT_BITS) - 1);
+const uint16 QUATERNION_COMPONENT_MASK = uint16((1 << QUATERNION_COMPONENT_BITS) - 1);
+const float32 QUATERNION_COMPONENT_RANGE = 0.70710678f; //1 / sqrt(2)
+
+//smallest-three form: three smallest components are in [-1/sqrt(2), 1/sqrt(2)],
+//index of largest (always positive) component is stored in high bits of first two values
+void DecodeQuaternion(const uint16* quantized, float32* outData)
+{
+    uint32 largest = uint32(quantized[0] >> QUATERNION_COMPONENT_BITS) | (uint32(quantized[1] >> QUATERNION_COMPONENT_BITS) << 1);
+
+    float32 sum = 0.f;
+    for (uint32 c = 0, q = 0; c < 4; ++c)
+    {
+        if (c != largest)
+        {
+            float32 value = (float32(quantized[q] & QUATERNION_COMPONENT_MASK) / QUATERNION_COMPONENT_MAX * 2.f - 1.f) * QUATERNION_COMPONENT_RANGE;
+            outData[c] = value;
+            sum += value * value;
+            ++q;
+        }
+    }
+    outData[largest] = std::sqrt(Max(0.f, 1.f - sum));
+}
+}
+
 uint32 AnimationChannel::Bind(const uint8* _data)
 {
-    keysData = nullptr;
+    keyTimes = keyValues = nullptr;
+    valueRange = nullptr;
     dimension = 0;
-    keyStride = keysCount = 0;
+    keysCount = keyTimeStride = keyValueStride = 0;
+    startKey = 0;
 
     const uint8* dataptr = _data;
-    if (_data != nullptr && *reinterpret_cast<const uint32*>(_data) == ANIMATION_CHANNEL_DATA_SIGNATURE)
-    {
-        dataptr += 4; //skip signature
+    if (_data == nullptr || *reinterpret_cast<const uint32*>(_data) != ANIMATION_CHANNEL_DATA_SIGNATURE)
+        return 0;
 
-        dimension = *dataptr;
-        dataptr += 1;
+    dataptr += 4; //skip signature
 
-        interpolation = eInterpolation(*dataptr);
-        dataptr += 1;
+    dimension = *dataptr;
+    dataptr += 1;
 
-        compression = *reinterpret_cast<const uint16*>(dataptr);
-        dataptr += 2;
+    interpolation = eInterpolation(*dataptr);
+    dataptr += 1;
 
-        keysCount = *reinterpret_cast<const uint32*>(dataptr);
-        dataptr += 4;
+    compression = *reinterpret_cast<const uint16*>(dataptr);
+    dataptr += 2;
 
-        keysData = dataptr;
+    keysCount = *reinterpret_cast<const uint32*>(dataptr);
+    dataptr += 4;
 
-        keyStride = uint32(sizeof(float32)) * (dimension + 1);
+    if (compression == COMPRESSION_NONE)
+    {
+        uint32 keyStride = uint32(sizeof(float32)) * (dimension + 1);
         if (interpolation == INTERPOLATION_BEZIER)
             keyStride += uint32(sizeof(float32) * 4); //four float32 as tangents
+
+        keyTimes = dataptr;
+        keyValues = dataptr + sizeof(float32);
+        keyTimeStride = keyValueStride = keyStride;
+        dataptr += keysCount * keyStride;
     }
+    else if (compression == COMPRESSION_QUANTIZED && dimension <= MAX_QUANTIZED_DIMENSION && interpolation != INTERPOLATION_BEZIER)
+    {
+        uint32 quantizedDimension = uint32(dimension);
+        if (IsSmallestThreeQuaternion())
+        {
+            quantizedDimension = 3;
+        }
+        else
+        {
+            valueRange = reinterpret_cast<const float32*>(dataptr);
+            dataptr += 2 * sizeof(float32) * dimension;
+        }
 
-    return uint32(keysData - _data) + keysCount * keyStride;
-}
+        keyTimes = dataptr;
+        keyTimeStride = uint32(sizeof(float32));
+        dataptr += keysCount * keyTimeStride;
+
+        keyValues = dataptr;
+        keyValueStride = uint32(sizeof(uint16)) * quantizedDimension;
+        dataptr += keysCount * keyValueStride;
+
+        //keep next channel aligned
+        dataptr += (4 - (uint32(dataptr - _data) & 0x3)) & 0x3;
+    }
+    else
+    {
+        DVASSERT(false, "Unsupported animation channel compression");
+        keysCount = 0;
+        return 0;
+    }
 
-#define KEY_DATA_SIZE (dimension * sizeof(float32))
-#define KEY_TIME(keyIndex) (*reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride))
-#define KEY_DATA(keyIndex) (reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride + sizeof(float32)))
-#define KEY_META(keyIndex) (KEY_DATA(keyIndex) + KEY_DATA_SIZE) //tangents for bezier interpolation
+    //channel without keys is still valid, it is skipped by AnimationTrack
+    return uint32(dataptr - _data);
+}
 
 void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize) const
 {
-    DVASSERT(dataSize >= GetDimension());
-
-    uint32 k = startKey;
+    Evaluate(time, outData, dataSize, &startKey);
+}
 
-    if (KEY_TIME(k) > time)
-    {
-        k = 0;
-    }
+void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize, uint32* keyCursor) const
+{
+    DVASSERT(dataSize >= GetDimension());
 
-    for (; k < keysCount; ++k)
-    {
-        if (KEY_TIME(k) > time)
-            break;
+    if (keysCount == 0)
+        return;
 
-        startKey = k;
-    }
+    uint32 k = FindKey(time, keyCursor);
 
     if (k == 0)
     {
-        Memcpy(outData, KEY_DATA(0), KEY_DATA_SIZE);
+        DecodeValue(0, outData);
         return;
     }
 
     if (k == keysCount)
     {
-        Memcpy(outData, KEY_DATA(keysCount - 1), KEY_DATA_SIZE);
+        DecodeValue(keysCount - 1, outData);
         return;
     }
 
     uint32 k0 = k - 1;
-    float32 time0 = KEY_TIME(k0);
-    float32 time1 = KEY_TIME(k);
+    float32 time0 = GetKeyTime(k0);
+    float32 time1 = GetKeyTime(k);
     float32 t = (time - time0) / (time1 - time0);
 
     switch (interpolation)
     {
     case INTERPOLATION_LINEAR:
     {
-        for (uint32 d = 0; d < uint32(dimension); ++d)
+        DVASSERT(dimension <= MAX_QUANTIZED_DIMENSION || compression == COMPRESSION_NONE);
+
+        if (compression == COMPRESSION_NONE)
         {
-            float32 v0 = *(KEY_DATA(k0) + d);
-            float32 v1 = *(KEY_DATA(k) + d);
-            *(outData + d) = Lerp(v0, v1, t);
+            const float32* v0 = reinterpret_cast<const float32*>(keyValues + k0 * keyValueStride);
+            const float32* v1 = reinterpret_cast<const float32*>(keyValues + k * keyValueStride);
+            for (uint32 d = 0; d < uint32(dimension); ++d)
+                outData[d] = Lerp(v0[d], v1[d], t);
+        }
+        else
+        {
+            float32 v1[MAX_QUANTIZED_DIMENSION];
+            DecodeValue(k0, outData);
+            DecodeValue(k, v1);
+            for (uint32 d = 0; d < uint32(dimension); ++d)
+                outData[d] = Lerp(outData[d], v1[d], t);
         }
     }
     break;
@@ -95,12 +166,13 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
     {
         DVASSERT(dimension == 4); //should be quaternion
 
-        Quaternion q0(KEY_DATA(k0));
-        Quaternion q(KEY_DATA(k));
+        Quaternion q0, q;
+        DecodeValue(k0, q0.data);
+        DecodeValue(k, q.data);
         q.Slerp(q0, q, t);
         q.Normalize();
 
-        Memcpy(outData, q.data, KEY_DATA_SIZE);
+        Memcpy(outData, q.data, sizeof(q.data));
     }
     break;
 
@@ -115,8 +187,79 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
     }
 }
 
-#undef KEY_DATA_SIZE
-#undef KEY_TIME
-#undef KEY_DATA
-#undef KEY_META
+void AnimationChannel::GetKeyValue(uint32 key, float32* outData, uint32 dataSize) const
+{
+    DVASSERT(key < keysCount);
+    DVASSERT(dataSize >= GetDimension());
+
+    DecodeValue(key, outData);
+}
+
+uint32 AnimationChannel::FindKey(float32 time, uint32* keyCursor) const
+{
+    DVASSERT(keyCursor != nullptr);
+
+    //find first key with time greater than `time`
+    uint32 begin = 0;
+    uint32 k = *keyCursor;
+    if (k < keysCount && GetKeyTime(k) <= time)
+    {
+        uint32 end = Min(k + AnimationChannelDetails::LINEAR_SEARCH_KEYS, keysCount);
+        for (++k; k < end && GetKeyTime(k) <= time; ++k)
+        {
+        }
+
+        if (k < end || k == keysCount)
+        {
+            *keyCursor = k - 1;
+            return k;
+        }
+
+        begin = k;
+    }
+
+    uint32 count = keysCount - begin;
+    while (count > 0)
+    {
+        uint32 step = count / 2;
+        uint32 middle = begin + step;
+        if (GetKeyTime(middle) <= time)
+        {
+            begin = middle + 1;
+            count -= step + 1;
+        }
+        else
+        {
+            count = step;
+        }
+    }
+    k = begin;
+
+    *keyCursor = (k > 0) ? k - 1 : 0;
+    return k;
+}
+
+void AnimationChannel::DecodeValue(uint32 key, float32* outData) const
+{
+    const uint8* value = keyValues + key * keyValueStride;
+    if (compression == COMPRESSION_NONE)
+    {
+        Memcpy(outData, value, dimension * sizeof(float32));
+    }
+    else if (IsSmallestThreeQuaternion())
+    {
+        AnimationChannelDetails::DecodeQuaternion(reinterpret_cast<const uint16*>(value), outData);
+    }
+    else
+    {
+        const uint16* quantized = reinterpret_cast<const uint16*>(value);
+        for (uint32 d = 0; d < uint32(dimension); ++d)
+            outData[d] = valueRange[d] + float32(quantized[d]) * valueRange[dimension + d];
+    }
+}
+
+bool AnimationChannel::IsSmallestThreeQuaternion() const
+{
+    return compression == COMPRESSION_QUANTIZED && interpolation == INTERPOLATION_SPHERICAL_LINEAR && dimension == 4;
 }
+}
\ No newline at end of file
@@ -8,6 +8,7 @@ class AnimationChannel
 {
 public:
     static const uint32 ANIMATION_CHANNEL_DATA_SIGNATURE = DAVA_MAKEFOURCC('D', 'V', 'A', 'C');
+    static const uint32 MAX_QUANTIZED_DIMENSION = 4;
 
     enum eInterpolation : uint8
     {
@@ -18,19 +19,46 @@ public:
         INTERPOLATION_COUNT
     };
 
+    enum eCompression : uint16
+    {
+        COMPRESSION_NONE = 0, //keys are stored as raw float32 time and values
+        COMPRESSION_QUANTIZED, //values are quantized to 16 bits: quaternions in smallest-three form, other values in channel range
+
+        COMPRESSION_COUNT
+    };
+
     AnimationChannel() = default;
 
     uint32 Bind(const uint8* data);
     void Evaluate(float32 time, float32* outData, uint32 dataSize) const;
 
+    /**
+        Evaluate channel starting keys search from `keyCursor`, and store found key to it.
+        Sequential playback with own cursor takes O(1) per evaluation, and channel can be evaluated from several threads.
+    */
+    void Evaluate(float32 time, float32* outData, uint32 dataSize, uint32* keyCursor) const;
+
     uint32 GetDimension() const;
+    eInterpolation GetInterpolation() const;
+    eCompression GetCompression() const;
+
+    uint32 GetKeysCount() const;
+    float32 GetKeyTime(uint32 key) const;
+    void GetKeyValue(uint32 key, float32* outData, uint32 dataSize) const;
 
 private:
-    const DAVA::uint8* keysData = nullptr;
+    uint32 FindKey(float32 time, uint32* keyCursor) const;
+    void DecodeValue(uint32 key, float32* outData) const;
+    bool IsSmallestThreeQuaternion() const;
+
+    const uint8* keyTimes = nullptr;
+    const uint8* keyValues = nullptr;
+    const float32* valueRange = nullptr; //min[dimension] and step[dimension] of quantized values
     mutable uint32 startKey = 0;
     uint32 keysCount = 0;
-    uint32 keyStride = 0;
-    uint16 compression = 0;
+    uint32 keyTimeStride = 0;
+    uint32 keyValueStride = 0;
+    uint16 compression = COMPRESSION_NONE;
     uint8 dimension = 0;
     eInterpolation interpolation = INTERPOLATION_COUNT;
 };
@@ -39,4 +67,24 @@ inline uint32 AnimationChannel::GetDimension() const
 {
     return uint32(dimension);
 }
+
+inline AnimationChannel::eInterpolation AnimationChannel::GetInterpolation() const
+{
+    return interpolation;
+}
+
+inline AnimationChannel::eCompression AnimationChannel::GetCompression() const
+{
+    return eCompression(compression);
+}
+
+inline uint32 AnimationChannel::GetKeysCount() const
+{
+    return keysCount;
+}
+
+inline float32 AnimationChannel::GetKeyTime(uint32 key) const
+{
+    return *reinterpret_cast<const float32*>(keyTimes + key * keyTimeStride);
+}
 }
\ No newline at end of file
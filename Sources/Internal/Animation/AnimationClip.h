@@ -14,6 +14,7 @@ class AnimationClip : public BaseObject
 {
 public:
     static const uint32 ANIMATION_CLIP_FILE_SIGNATURE = DAVA_MAKEFOURCC('D', 'V', 'A', 'F');
+    static const uint32 ANIMATION_CLIP_FILE_VERSION = 2; //version 2 allows quantized channels
 
     struct FileHeader
     {
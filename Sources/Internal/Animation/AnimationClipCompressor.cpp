@@ -0,0 +1,388 @@
+#include "AnimationClipCompressor.h"
+#include "AnimationClip.h"
+#include "AnimationTrack.h"
+
+#include "Base/BaseMath.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "Logger/Logger.h"
+#include "Math/Math2D.h"
+#include "Utils/CRC32.h"
+
+namespace DAVA
+{
+namespace AnimationClipCompressorDetails
+{
+const uint32 MAX_DIMENSION = AnimationChannel::MAX_QUANTIZED_DIMENSION;
+const float32 QUANTIZED_VALUE_MAX = 65535.f;
+const uint32 QUATERNION_COMPONENT_BITS = 15;
+const float32 QUATERNION_COMPONENT_MAX = float32((1 << QUATERNION_COMPONENT_BITS) - 1);
+const float32 QUATERNION_COMPONENT_RANGE = 0.70710678f; //1 / sqrt(2)
+
+struct ChannelKeys
+{
+    Vector<float32> times;
+    Vector<float32> values; //[key][dimension]
+};
+
+void WriteToBuffer(Vector<uint8>& buffer, const void* data, uint32 size)
+{
+    DVASSERT(data != nullptr && size != 0);
+
+    const uint8* bytes = reinterpret_cast<const uint8*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+template <class T>
+void WriteToBuffer(Vector<uint8>& buffer, const T* value)
+{
+    WriteToBuffer(buffer, value, sizeof(T));
+}
+
+void AlignBuffer(Vector<uint8>& buffer)
+{
+    buffer.resize((buffer.size() + 0x3) & ~size_t(0x3), 0);
+}
+
+void WriteToBuffer(Vector<uint8>& buffer, const char* string)
+{
+    //strings are aligned, as animation data is used in memory without any processing
+    WriteToBuffer(buffer, string, uint32(strlen(string) + 1));
+    AlignBuffer(buffer);
+}
+
+ChannelKeys ReadKeys(const AnimationChannel& channel)
+{
+    uint32 dimension = channel.GetDimension();
+    uint32 keysCount = channel.GetKeysCount();
+
+    ChannelKeys keys;
+    keys.times.resize(keysCount);
+    keys.values.resize(keysCount * dimension);
+    for (uint32 k = 0; k < keysCount; ++k)
+    {
+        keys.times[k] = channel.GetKeyTime(k);
+        channel.GetKeyValue(k, keys.values.data() + k * dimension, dimension);
+    }
+    return keys;
+}
+
+bool IsConstant(const ChannelKeys& keys, uint32 dimension, bool isQuaternion, float32 tolerance)
+{
+    const float32* first = keys.values.data();
+    for (uint32 k = 1; k < uint32(keys.times.size()); ++k)
+    {
+        const float32* value = keys.values.data() + k * dimension;
+
+        //q and -q are the same rotation
+        float32 sign = 1.f;
+        if (isQuaternion && Quaternion(first).DotProduct(Quaternion(value)) < 0.f)
+            sign = -1.f;
+
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            if (std::abs(first[d] - sign * value[d]) > tolerance)
+                return false;
+        }
+    }
+    return true;
+}
+
+void EncodeQuaternion(const float32* data, uint16* outQuantized)
+{
+    Quaternion q(data);
+    q.Normalize();
+
+    uint32 largest = 0;
+    for (uint32 c = 1; c < 4; ++c)
+    {
+        if (std::abs(q.data[c]) > std::abs(q.data[largest]))
+            largest = c;
+    }
+
+    //largest component is restored as positive one
+    float32 sign = (q.data[largest] < 0.f) ? -1.f : 1.f;
+    for (uint32 c = 0, i = 0; c < 4; ++c)
+    {
+        if (c != largest)
+        {
+            float32 value = FloatClamp(-1.f, 1.f, sign * q.data[c] / QUATERNION_COMPONENT_RANGE);
+            outQuantized[i] = uint16(std::round((value + 1.f) * 0.5f * QUATERNION_COMPONENT_MAX));
+            ++i;
+        }
+    }
+
+    outQuantized[0] |= uint16((largest & 0x1) << QUATERNION_COMPONENT_BITS);
+    outQuantized[1] |= uint16((largest >> 1) << QUATERNION_COMPONENT_BITS);
+}
+
+void WriteQuantizedKeys(Vector<uint8>& buffer, const ChannelKeys& keys, uint32 dimension, bool isQuaternion)
+{
+    uint32 keysCount = uint32(keys.times.size());
+
+    float32 minValue[MAX_DIMENSION];
+    float32 step[MAX_DIMENSION];
+    if (!isQuaternion)
+    {
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            float32 maxValue = minValue[d] = keys.values[d];
+            for (uint32 k = 1; k < keysCount; ++k)
+            {
+                minValue[d] = Min(minValue[d], keys.values[k * dimension + d]);
+                maxValue = Max(maxValue, keys.values[k * dimension + d]);
+            }
+            step[d] = (maxValue - minValue[d]) / QUANTIZED_VALUE_MAX;
+        }
+
+        WriteToBuffer(buffer, minValue, dimension * sizeof(float32));
+        WriteToBuffer(buffer, step, dimension * sizeof(float32));
+    }
+
+    WriteToBuffer(buffer, keys.times.data(), keysCount * sizeof(float32));
+
+    for (uint32 k = 0; k < keysCount; ++k)
+    {
+        const float32* value = keys.values.data() + k * dimension;
+
+        uint16 quantized[MAX_DIMENSION] = {};
+        uint32 quantizedDimension = dimension;
+        if (isQuaternion)
+        {
+            EncodeQuaternion(value, quantized);
+            quantizedDimension = 3;
+        }
+        else
+        {
+            for (uint32 d = 0; d < dimension; ++d)
+            {
+                float32 q = (step[d] > 0.f) ? std::round((value[d] - minValue[d]) / step[d]) : 0.f;
+                quantized[d] = uint16(FloatClamp(0.f, QUANTIZED_VALUE_MAX, q));
+            }
+        }
+
+        WriteToBuffer(buffer, quantized, quantizedDimension * sizeof(uint16));
+    }
+
+    AlignBuffer(buffer);
+}
+
+//binary format described in 'AnimationBinaryFormat.md'
+bool WriteChannel(Vector<uint8>& buffer, AnimationTrack::eChannelTarget target, const AnimationChannel& channel, const AnimationClipCompressor::Params& params, AnimationClipCompressor::Report* report)
+{
+    AnimationChannel::eInterpolation interpolation = channel.GetInterpolation();
+    if (interpolation == AnimationChannel::INTERPOLATION_BEZIER)
+    {
+        Logger::Error("[AnimationClipCompressor] Bezier channels are not supported");
+        return false;
+    }
+
+    uint32 dimension = channel.GetDimension();
+    bool isQuaternion = (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR && dimension == 4);
+    ChannelKeys keys = ReadKeys(channel);
+
+    uint16 compression = AnimationChannel::COMPRESSION_NONE;
+    if (params.removeConstantKeys && IsConstant(keys, dimension, isQuaternion, params.constantTolerance))
+    {
+        keys.times.resize(1);
+        keys.values.resize(dimension);
+        ++report->constantChannelsCount;
+    }
+    else if (params.quantize && dimension <= MAX_DIMENSION)
+    {
+        compression = AnimationChannel::COMPRESSION_QUANTIZED;
+        ++report->quantizedChannelsCount;
+    }
+    ++report->channelsCount;
+
+    uint8 channelTarget[4] = { uint8(target), 0, 0, 0 }; //target and pad
+    WriteToBuffer(buffer, channelTarget, sizeof(channelTarget));
+
+    uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+    uint8 channelDimension = uint8(dimension);
+    uint8 channelInterpolation = uint8(interpolation);
+    uint32 keysCount = uint32(keys.times.size());
+    WriteToBuffer(buffer, &signature);
+    WriteToBuffer(buffer, &channelDimension);
+    WriteToBuffer(buffer, &channelInterpolation);
+    WriteToBuffer(buffer, &compression);
+    WriteToBuffer(buffer, &keysCount);
+
+    if (compression == AnimationChannel::COMPRESSION_QUANTIZED)
+    {
+        WriteQuantizedKeys(buffer, keys, dimension, isQuaternion);
+    }
+    else
+    {
+        for (uint32 k = 0; k < keysCount; ++k)
+        {
+            WriteToBuffer(buffer, &keys.times[k]);
+            WriteToBuffer(buffer, keys.values.data() + k * dimension, dimension * sizeof(float32));
+        }
+    }
+
+    return true;
+}
+
+void UpdateError(AnimationTrack::eChannelTarget target, const float32* original, const float32* compressed, AnimationClipCompressor::Report* report)
+{
+    switch (target)
+    {
+    case AnimationTrack::CHANNEL_TARGET_POSITION:
+        report->maxPositionError = Max(report->maxPositionError, Distance(Vector3(original), Vector3(compressed)));
+        break;
+
+    case AnimationTrack::CHANNEL_TARGET_ORIENTATION:
+    {
+        float32 dot = Min(1.f, std::abs(Quaternion(original).DotProduct(Quaternion(compressed))));
+        report->maxOrientationError = Max(report->maxOrientationError, 2.f * std::acos(dot));
+    }
+    break;
+
+    case AnimationTrack::CHANNEL_TARGET_SCALE:
+        report->maxScaleError = Max(report->maxScaleError, std::abs(original[0] - compressed[0]));
+        break;
+
+    default:
+        break;
+    }
+}
+}
+
+bool AnimationClipCompressor::Compress(const FilePath& sourcePath, const FilePath& destinationPath, const Params& params, Report* report)
+{
+    using namespace AnimationClipCompressorDetails;
+
+    DVASSERT(sourcePath != destinationPath);
+
+    ScopedPtr<AnimationClip> clip(AnimationClip::Load(sourcePath));
+    if (!clip)
+        return false;
+
+    Report localReport;
+    if (report == nullptr)
+        report = &localReport;
+    *report = Report();
+
+    Vector<uint8> animationData;
+
+    float32 duration = clip->GetDuration();
+    WriteToBuffer(animationData, &duration);
+
+    uint32 nodeCount = clip->GetTrackCount();
+    WriteToBuffer(animationData, &nodeCount);
+
+    for (uint32 n = 0; n < nodeCount; ++n)
+    {
+        WriteToBuffer(animationData, clip->GetTrackUID(n));
+        WriteToBuffer(animationData, clip->GetTrackName(n));
+
+        const AnimationTrack* track = clip->GetTrack(n);
+
+        uint32 signature = AnimationTrack::ANIMATION_TRACK_DATA_SIGNATURE;
+        uint32 channelsCount = track->GetChannelsCount();
+        WriteToBuffer(animationData, &signature);
+        WriteToBuffer(animationData, &channelsCount);
+
+        for (uint32 c = 0; c < channelsCount; ++c)
+        {
+            if (!WriteChannel(animationData, track->GetChannelTarget(c), track->GetChannel(c), params, report))
+            {
+                Logger::Error("[AnimationClipCompressor] Failed to compress track '%s'. File: %s", clip->GetTrackName(n), sourcePath.GetAbsolutePathname().c_str());
+                return false;
+            }
+        }
+    }
+
+    uint32 markerCount = clip->GetMarkerCount();
+    WriteToBuffer(animationData, &markerCount);
+    for (uint32 m = 0; m < markerCount; ++m)
+    {
+        float32 markerTime = clip->GetMarkerTime(m);
+        WriteToBuffer(animationData, clip->GetMarkerName(m));
+        WriteToBuffer(animationData, &markerTime);
+    }
+
+    ScopedPtr<File> sourceFile(File::Create(sourcePath, File::OPEN | File::READ));
+    AnimationClip::FileHeader sourceHeader;
+    if (sourceFile && sourceFile->Read(&sourceHeader) == sizeof(sourceHeader))
+    {
+        report->originalSize = sourceHeader.dataSize;
+    }
+
+    AnimationClip::FileHeader header;
+    header.signature = AnimationClip::ANIMATION_CLIP_FILE_SIGNATURE;
+    header.version = AnimationClip::ANIMATION_CLIP_FILE_VERSION;
+    header.dataSize = uint32(animationData.size());
+    header.crc32 = CRC32::ForBuffer(animationData.data(), header.dataSize);
+    report->compressedSize = header.dataSize;
+
+    {
+        ScopedPtr<File> file(File::Create(destinationPath, File::CREATE | File::WRITE));
+        if (!file || file->Write(&header) != sizeof(header) || file->Write(animationData.data(), header.dataSize) != header.dataSize)
+        {
+            Logger::Error("[AnimationClipCompressor] Failed to write file: %s", destinationPath.GetAbsolutePathname().c_str());
+            return false;
+        }
+    }
+
+    ScopedPtr<AnimationClip> compressedClip(AnimationClip::Load(destinationPath));
+    if (!compressedClip)
+        return false;
+
+    CompareClips(clip, compressedClip, 60.f, report);
+    return true;
+}
+
+void AnimationClipCompressor::CompareClips(const AnimationClip* original, const AnimationClip* compressed, float32 samplesPerSecond, Report* report)
+{
+    using namespace AnimationClipCompressorDetails;
+
+    DVASSERT(original != nullptr && compressed != nullptr && report != nullptr);
+    DVASSERT(samplesPerSecond > 0.f);
+
+    uint32 samplesCount = uint32(original->GetDuration() * samplesPerSecond) + 1;
+    for (uint32 t = 0; t < original->GetTrackCount(); ++t)
+    {
+        const AnimationTrack* originalTrack = original->GetTrack(t);
+        const AnimationTrack* compressedTrack = compressed->FindTrack(original->GetTrackUID(t));
+        if (compressedTrack == nullptr || compressedTrack->GetChannelsCount() != originalTrack->GetChannelsCount())
+        {
+            Logger::Warning("[AnimationClipCompressor] Track '%s' mismatch in compared clips", original->GetTrackName(t));
+            continue;
+        }
+
+        for (uint32 c = 0; c < originalTrack->GetChannelsCount(); ++c)
+        {
+            const AnimationChannel& originalChannel = originalTrack->GetChannel(c);
+            const AnimationChannel& compressedChannel = compressedTrack->GetChannel(c);
+            DVASSERT(originalChannel.GetDimension() == compressedChannel.GetDimension());
+            if (originalChannel.GetDimension() > MAX_DIMENSION)
+                continue;
+
+            AnimationTrack::eChannelTarget target = originalTrack->GetChannelTarget(c);
+            float32 originalValue[MAX_DIMENSION];
+            float32 compressedValue[MAX_DIMENSION];
+
+            //both uniform samples and keys are evaluated in time order, so key cursors are used
+            uint32 originalCursor = 0;
+            uint32 compressedCursor = 0;
+            for (uint32 s = 0; s < samplesCount; ++s)
+            {
+                float32 time = float32(s) / samplesPerSecond;
+                originalChannel.Evaluate(time, originalValue, MAX_DIMENSION, &originalCursor);
+                compressedChannel.Evaluate(time, compressedValue, MAX_DIMENSION, &compressedCursor);
+                UpdateError(target, originalValue, compressedValue, report);
+            }
+
+            for (uint32 k = 0; k < originalChannel.GetKeysCount(); ++k)
+            {
+                float32 time = originalChannel.GetKeyTime(k);
+                originalChannel.Evaluate(time, originalValue, MAX_DIMENSION, &originalCursor);
+                compressedChannel.Evaluate(time, compressedValue, MAX_DIMENSION, &compressedCursor);
+                UpdateError(target, originalValue, compressedValue, report);
+            }
+        }
+    }
+}
+}
\ No newline at end of file
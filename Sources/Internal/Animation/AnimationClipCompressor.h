@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+class AnimationClip;
+class FilePath;
+
+/**
+    Converts animation clips to compact encoding (see 'AnimationBinaryFormat.md').
+
+    Channels with all keys equal within `constantTolerance` are reduced to single key.
+    Other linear and spherical channels are quantized to 16 bits: quaternions are stored in smallest-three form,
+    positions and scales are stored relative to channel value range.
+*/
+class AnimationClipCompressor final
+{
+public:
+    struct Params
+    {
+        bool quantize = true;
+        bool removeConstantKeys = true;
+        float32 constantTolerance = 1e-5f;
+    };
+
+    struct Report
+    {
+        uint32 originalSize = 0; //bytes of animation data
+        uint32 compressedSize = 0;
+
+        uint32 channelsCount = 0;
+        uint32 constantChannelsCount = 0;
+        uint32 quantizedChannelsCount = 0;
+
+        float32 maxPositionError = 0.f;
+        float32 maxOrientationError = 0.f; //radians
+        float32 maxScaleError = 0.f;
+    };
+
+    /** Compress clip from `sourcePath` and write it to `destinationPath`, errors of compressed clip are written to `report`. */
+    static bool Compress(const FilePath& sourcePath, const FilePath& destinationPath, const Params& params, Report* report = nullptr);
+
+    /** Sample both clips `samplesPerSecond` times per second and at every key and write max errors to `report`. */
+    static void CompareClips(const AnimationClip* original, const AnimationClip* compressed, float32 samplesPerSecond, Report* report);
+};
+}
\ No newline at end of file
@@ -18,16 +18,17 @@ uint32 AnimationTrack::Bind(const uint8* _data)
         uint32 channelsCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
-        channels.resize(channelsCount);
+        channels.reserve(channelsCount);
 
         for (uint32 c = 0; c < channelsCount; ++c)
         {
-            channels[c].target = eChannelTarget(*dataptr);
+            Channel channel;
+            channel.target = eChannelTarget(*dataptr);
             dataptr += 1;
 
             dataptr += 3; //pad
 
-            uint32 boundData = channels[c].channel.Bind(dataptr);
+            uint32 boundData = channel.channel.Bind(dataptr);
             if (boundData == 0)
             {
                 channels.clear();
@@ -35,6 +36,10 @@ uint32 AnimationTrack::Bind(const uint8* _data)
             }
 
             dataptr += boundData;
+
+            //channels without keys don't affect target value
+            if (channel.channel.GetKeysCount() > 0)
+                channels.push_back(channel);
         }
     }
 
@@ -47,6 +52,12 @@ void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, ui
     channels[channel].channel.Evaluate(time, outData, dataSize);
 }
 
+void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize, uint32* keyCursor) const
+{
+    DVASSERT(channel < GetChannelsCount());
+    channels[channel].channel.Evaluate(time, outData, dataSize, keyCursor);
+}
+
 uint32 AnimationTrack::GetChannelsCount() const
 {
     return uint32(channels.size());
@@ -58,6 +69,12 @@ AnimationTrack::eChannelTarget AnimationTrack::GetChannelTarget(uint32 channel)
     return channels[channel].target;
 }
 
+const AnimationChannel& AnimationTrack::GetChannel(uint32 channel) const
+{
+    DVASSERT(channel < GetChannelsCount());
+    return channels[channel].channel;
+}
+
 uint32 AnimationTrack::GetChannelValueSize(uint32 channel) const
 {
     DVASSERT(channel < GetChannelsCount());
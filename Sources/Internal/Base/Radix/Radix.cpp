@@ -102,4 +102,83 @@ void RadixSortImpl(intptr_t* array, int offset, int end, int shift)
         }
     }
 }
+
+void RadixSort64(uint64* keys, uint32* values, uint64* tempKeys, uint32* tempValues, uint32 count)
+{
+    static const uint32 BYTES_COUNT = sizeof(uint64);
+    static const uint32 INSERTION_SORT_THRESHOLD = 32;
+
+    if (count < 2)
+        return;
+
+    if (count <= INSERTION_SORT_THRESHOLD)
+    {
+        for (uint32 x = 1; x < count; ++x)
+        {
+            uint64 key = keys[x];
+            uint32 value = values[x];
+            uint32 y = x;
+            for (; y > 0 && keys[y - 1] > key; --y)
+            {
+                keys[y] = keys[y - 1];
+                values[y] = values[y - 1];
+            }
+            keys[y] = key;
+            values[y] = value;
+        }
+        return;
+    }
+
+    uint32 histogram[BYTES_COUNT][256] = {};
+    bool sorted = true;
+    for (uint32 x = 0; x < count; ++x)
+    {
+        uint64 key = keys[x];
+        sorted &= (x == 0) || (keys[x - 1] <= key);
+        for (uint32 b = 0; b < BYTES_COUNT; ++b)
+        {
+            ++histogram[b][(key >> (b * 8)) & 0xFF];
+        }
+    }
+
+    if (sorted)
+        return;
+
+    uint64* srcKeys = keys;
+    uint32* srcValues = values;
+    uint64* dstKeys = tempKeys;
+    uint32* dstValues = tempValues;
+
+    for (uint32 b = 0; b < BYTES_COUNT; ++b)
+    {
+        uint32 shift = b * 8;
+        uint32* counts = histogram[b];
+        if (counts[(srcKeys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < 256; ++x)
+        {
+            uint32 c = counts[x];
+            counts[x] = offset;
+            offset += c;
+        }
+
+        for (uint32 x = 0; x < count; ++x)
+        {
+            uint32 pos = counts[(srcKeys[x] >> shift) & 0xFF]++;
+            dstKeys[pos] = srcKeys[x];
+            dstValues[pos] = srcValues[x];
+        }
+
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    if (srcKeys != keys)
+    {
+        std::copy(srcKeys, srcKeys + count, keys);
+        std::copy(srcValues, srcValues + count, values);
+    }
+}
 }
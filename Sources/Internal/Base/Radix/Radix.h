@@ -40,6 +40,14 @@ inline void RadixSort(void* array, int offset, int end, int shift)
 
     RadixSortImpl(static_cast<intptr_t*>(array), offset, end, shift);
 }
+
+/**
+    Stable LSD radix sort of `count` 64-bit `keys` in ascending order, `values` are moved along with their keys.
+    `tempKeys` and `tempValues` are scratch buffers of at least `count` elements.
+    Byte passes where all keys have the same byte are skipped and already sorted input is detected in one pass,
+    so keys which differ in few bytes or come in nearly the same order every frame are sorted cheaply.
+*/
+void RadixSort64(uint64* keys, uint32* values, uint64* tempKeys, uint32* tempValues, uint32 count);
 };
 
 #endif // __DAVAENGINE_BASE_RADIX_RADIX__
\ No newline at end of file
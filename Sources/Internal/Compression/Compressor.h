@@ -13,13 +13,21 @@ public:
         Lz4,
         Lz4HC,
         RFC1951, // deflate, inflate
+        Lz4Dict, // lz4hc with dictionary trained on pack content
     };
 
     virtual ~Compressor();
 
     virtual bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
     // you should resize output to correct size before call this method
-    virtual bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
+    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const;
+    // same as above for `inSize` bytes at `in`, so compressed content can be read in place (e.g. from memory-mapped file)
+    virtual bool Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const = 0;
 };
 
+inline bool Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    return Decompress(in.data(), static_cast<uint32>(in.size()), out);
+}
+
 } // end namespace DAVA
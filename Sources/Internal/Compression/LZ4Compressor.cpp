@@ -1,9 +1,15 @@
 #include "Compression/LZ4Compressor.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
+#include "Debug/DVAssert.h"
 #include "Logger/Logger.h"
+#include "Utils/CRC32.h"
 
 #include <lz4/lz4.h>
 #include <lz4/lz4hc.h>
 
+#include <queue>
+
 namespace DAVA
 {
 Compressor::~Compressor() = default; // only one virtual table(fix warning)
@@ -29,9 +35,9 @@ bool LZ4Compressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
     return true;
 }
 
-bool LZ4Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+bool LZ4Compressor::Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const
 {
-    int32 decompressResult = LZ4_decompress_fast(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), static_cast<uint32>(out.size()));
+    int32 decompressResult = LZ4_decompress_fast(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out.data()), static_cast<uint32>(out.size()));
     if (decompressResult < 0)
     {
         Logger::Error("LZ4 decompress failed");
@@ -66,4 +72,261 @@ bool LZ4HCCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) cons
     return true;
 }
 
+namespace LZ4DictCompressorDetails
+{
+// lz4hc streaming requires input buffer not less then 192Kb
+const size_t MIN_STREAM_BUFFER_SIZE = 192 * 1024;
+// length of sequence used to find repeating content during dictionary training
+const size_t DMER_SIZE = 8;
+// dictionary is built from segments of this size
+const size_t SEGMENT_SIZE = 128;
+const size_t SEGMENT_STEP = 32;
+
+struct DmerStat
+{
+    uint32 numSamples = 0;
+    uint32 lastSample = 0;
+};
+
+struct Segment
+{
+    uint64 score;
+    uint32 sampleIndex;
+    uint32 offset;
+
+    bool operator<(const Segment& other) const
+    {
+        return score < other.score;
+    }
+};
+
+uint64 ReadDmer(const uint8* data)
+{
+    uint64 dmer = 0;
+    Memcpy(&dmer, data, DMER_SIZE);
+    return dmer;
+}
+
+uint64 ComputeScore(const Vector<uint8>& sample, uint32 offset, const UnorderedMap<uint64, DmerStat>& stats)
+{
+    uint64 score = 0;
+    const size_t end = std::min(sample.size(), offset + SEGMENT_SIZE) - DMER_SIZE;
+    for (size_t i = offset; i <= end; ++i)
+    {
+        auto it = stats.find(ReadDmer(&sample[i]));
+        if (it != stats.end() && it->second.numSamples > 1)
+        {
+            score += it->second.numSamples;
+        }
+    }
+    return score;
+}
+
+Mutex registryMutex;
+UnorderedMap<uint32, std::shared_ptr<const LZ4DictCompressor>> registry;
+} // namespace LZ4DictCompressorDetails
+
+const uint32 LZ4DictCompressor::MAX_DICTIONARY_SIZE;
+
+LZ4DictCompressor::LZ4DictCompressor(Vector<uint8> dictionary_)
+    : dictionary(std::move(dictionary_))
+{
+    DVASSERT(dictionary.size() <= MAX_DICTIONARY_SIZE);
+    dictionaryId = CRC32::ForBuffer(dictionary);
+}
+
+const Vector<uint8>& LZ4DictCompressor::GetDictionary() const
+{
+    return dictionary;
+}
+
+uint32 LZ4DictCompressor::GetDictionaryId() const
+{
+    return dictionaryId;
+}
+
+uint32 LZ4DictCompressor::GetDictionaryId(const Vector<uint8>& compressed)
+{
+    return GetDictionaryId(compressed.data(), static_cast<uint32>(compressed.size()));
+}
+
+uint32 LZ4DictCompressor::GetDictionaryId(const uint8* compressed, uint32 compressedSize)
+{
+    uint32 id = 0;
+    if (compressedSize >= sizeof(id))
+    {
+        Memcpy(&id, compressed, sizeof(id));
+    }
+    return id;
+}
+
+bool LZ4DictCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    using namespace LZ4DictCompressorDetails;
+
+    if (in.size() > LZ4_MAX_INPUT_SIZE - dictionary.size())
+    {
+        Logger::Error("LZ4 compress failed too big input buffer");
+        return false;
+    }
+    if (in.empty())
+    {
+        Logger::Error("LZ4 can't compress empty buffer");
+        return false;
+    }
+
+    // dictionary and input have to lay next to each other, so matches in input can reference dictionary
+    Vector<uint8> window(std::max(dictionary.size() + in.size(), MIN_STREAM_BUFFER_SIZE));
+    std::copy(dictionary.begin(), dictionary.end(), window.begin());
+    std::copy(in.begin(), in.end(), window.begin() + dictionary.size());
+
+    char* windowStart = reinterpret_cast<char*>(window.data());
+    void* stream = LZ4_createHC(windowStart);
+    if (stream == nullptr)
+    {
+        Logger::Error("LZ4 can't create compression stream");
+        return false;
+    }
+
+    bool isOk = true;
+    if (!dictionary.empty())
+    {
+        // compress dictionary only to fill stream history, output is dropped
+        Vector<uint8> dictionaryCompressed(LZ4_compressBound(static_cast<int32>(dictionary.size())));
+        isOk = LZ4_compressHC_continue(stream, windowStart, reinterpret_cast<char*>(dictionaryCompressed.data()), static_cast<int32>(dictionary.size())) > 0;
+    }
+
+    int32 compressedSize = 0;
+    if (isOk)
+    {
+        uint32 maxSize = static_cast<uint32>(LZ4_compressBound(static_cast<int32>(in.size())));
+        out.resize(sizeof(dictionaryId) + maxSize);
+        Memcpy(out.data(), &dictionaryId, sizeof(dictionaryId));
+        compressedSize = LZ4_compressHC_continue(stream, windowStart + dictionary.size(), reinterpret_cast<char*>(out.data() + sizeof(dictionaryId)), static_cast<int32>(in.size()));
+    }
+    LZ4_freeHC(stream);
+
+    if (compressedSize <= 0)
+    {
+        return false;
+    }
+    out.resize(sizeof(dictionaryId) + static_cast<uint32>(compressedSize));
+    return true;
+}
+
+bool LZ4DictCompressor::Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const
+{
+    if (inSize <= sizeof(dictionaryId) || GetDictionaryId(in, inSize) != dictionaryId)
+    {
+        Logger::Error("LZ4 decompress failed, dictionary not match");
+        return false;
+    }
+
+    // matches referencing dictionary are read from it in place, content is decompressed straight into output
+    const char* source = reinterpret_cast<const char*>(in + sizeof(dictionaryId));
+    char* dest = reinterpret_cast<char*>(out.data());
+    const char* dictStart = reinterpret_cast<const char*>(dictionary.data());
+    int32 inputSize = static_cast<int32>(inSize - sizeof(dictionaryId));
+    int32 decompressResult = LZ4_decompress_safe_usingDict(source, dest, inputSize, static_cast<int32>(out.size()), dictStart, static_cast<int32>(dictionary.size()));
+    if (decompressResult < 0 || static_cast<size_t>(decompressResult) != out.size())
+    {
+        Logger::Error("LZ4 decompress failed");
+        return false;
+    }
+    return true;
+}
+
+Vector<uint8> LZ4DictCompressor::TrainDictionary(const Vector<Vector<uint8>>& samples, uint32 dictionaryCapacity)
+{
+    using namespace LZ4DictCompressorDetails;
+
+    dictionaryCapacity = std::min(dictionaryCapacity, MAX_DICTIONARY_SIZE);
+
+    // count in how many samples every dmer occurs, content repeated in single file is handled by lz4 itself
+    UnorderedMap<uint64, DmerStat> stats;
+    for (uint32 sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const Vector<uint8>& sample = samples[sampleIndex];
+        for (size_t i = 0; i + DMER_SIZE <= sample.size(); ++i)
+        {
+            DmerStat& stat = stats[ReadDmer(&sample[i])];
+            if (stat.numSamples == 0 || stat.lastSample != sampleIndex)
+            {
+                ++stat.numSamples;
+                stat.lastSample = sampleIndex;
+            }
+        }
+    }
+
+    std::priority_queue<Segment> segments;
+    for (uint32 sampleIndex = 0; sampleIndex < samples.size(); ++sampleIndex)
+    {
+        const Vector<uint8>& sample = samples[sampleIndex];
+        for (size_t offset = 0; offset + DMER_SIZE <= sample.size(); offset += SEGMENT_STEP)
+        {
+            uint64 score = ComputeScore(sample, static_cast<uint32>(offset), stats);
+            if (score > 0)
+            {
+                segments.push(Segment{ score, sampleIndex, static_cast<uint32>(offset) });
+            }
+        }
+    }
+
+    // greedy select best segments, content of selected segment does not add score to others
+    Vector<std::pair<const uint8*, size_t>> selected;
+    size_t dictionarySize = 0;
+    while (!segments.empty() && dictionarySize < dictionaryCapacity)
+    {
+        Segment segment = segments.top();
+        segments.pop();
+
+        const Vector<uint8>& sample = samples[segment.sampleIndex];
+        segment.score = ComputeScore(sample, segment.offset, stats);
+        if (segment.score == 0)
+        {
+            continue;
+        }
+        if (!segments.empty() && segment.score < segments.top().score)
+        {
+            segments.push(segment);
+            continue;
+        }
+
+        const size_t segmentSize = std::min(std::min(SEGMENT_SIZE, sample.size() - segment.offset), dictionaryCapacity - dictionarySize);
+        for (size_t i = segment.offset; i + DMER_SIZE <= segment.offset + segmentSize; ++i)
+        {
+            stats[ReadDmer(&sample[i])].numSamples = 0;
+        }
+
+        selected.emplace_back(&sample[segment.offset], segmentSize);
+        dictionarySize += segmentSize;
+    }
+
+    Vector<uint8> dictionary;
+    dictionary.reserve(dictionarySize);
+    for (auto it = selected.rbegin(); it != selected.rend(); ++it)
+    {
+        dictionary.insert(dictionary.end(), it->first, it->first + it->second);
+    }
+    return dictionary;
+}
+
+void LZ4DictCompressor::RegisterDictionary(const Vector<uint8>& dictionary)
+{
+    using namespace LZ4DictCompressorDetails;
+
+    std::shared_ptr<const LZ4DictCompressor> compressor = std::make_shared<LZ4DictCompressor>(dictionary);
+    LockGuard<Mutex> lock(registryMutex);
+    registry[compressor->GetDictionaryId()] = std::move(compressor);
+}
+
+std::shared_ptr<const LZ4DictCompressor> LZ4DictCompressor::GetRegistered(uint32 dictionaryId)
+{
+    using namespace LZ4DictCompressorDetails;
+
+    LockGuard<Mutex> lock(registryMutex);
+    auto it = registry.find(dictionaryId);
+    return it != registry.end() ? it->second : nullptr;
+}
+
 } // end namespace DAVA
@@ -7,9 +7,11 @@ namespace DAVA
 class LZ4Compressor : public Compressor
 {
 public:
+    using Compressor::Decompress;
+
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
     // you should resize output to correct size before call this method
-    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const override;
 };
 
 class LZ4HCCompressor final : public LZ4Compressor
@@ -18,4 +20,50 @@ public:
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
 };
 
+/**
+    LZ4HC compressor with preset dictionary.
+
+    Dictionary is used as a prefix of every compressed buffer, so small files
+    (yaml, materials, scenes) can reference content common for the whole pack.
+    Compressed buffer starts with uint32 dictionary id (crc32 of dictionary),
+    decompression fails if it does not match compressor dictionary.
+
+    Dictionaries used to decompress standalone files (e.g. .dvpl downloaded by DLCManager)
+    have to be registered with `RegisterDictionary` and looked up with `GetRegistered`.
+    PackArchive registers dictionary of every opened pack, DLCManager registers dictionary of remote pack.
+*/
+class LZ4DictCompressor final : public Compressor
+{
+public:
+    static const uint32 MAX_DICTIONARY_SIZE = 64 * 1024; // lz4 can't reference data farther than 64Kb
+
+    explicit LZ4DictCompressor(Vector<uint8> dictionary);
+
+    using Compressor::Decompress;
+
+    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    // you should resize output to correct size before call this method
+    bool Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const override;
+
+    const Vector<uint8>& GetDictionary() const;
+    uint32 GetDictionaryId() const;
+
+    /** Return dictionary id stored in the beginning of compressed buffer or 0 if buffer is too small. */
+    static uint32 GetDictionaryId(const Vector<uint8>& compressed);
+    static uint32 GetDictionaryId(const uint8* compressed, uint32 compressedSize);
+
+    /**
+        Build dictionary not bigger then `dictionaryCapacity` from most frequent segments of `samples`.
+        Most valuable segments are placed in the end of dictionary, closest to compressed data.
+    */
+    static Vector<uint8> TrainDictionary(const Vector<Vector<uint8>>& samples, uint32 dictionaryCapacity = MAX_DICTIONARY_SIZE);
+
+    static void RegisterDictionary(const Vector<uint8>& dictionary);
+    static std::shared_ptr<const LZ4DictCompressor> GetRegistered(uint32 dictionaryId);
+
+private:
+    Vector<uint8> dictionary;
+    uint32 dictionaryId = 0;
+};
+
 } // end namespace DAVA
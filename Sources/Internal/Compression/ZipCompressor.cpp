@@ -57,15 +57,15 @@ bool ZipCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
     return true;
 }
 
-bool ZipCompressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+bool ZipCompressor::Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const
 {
-    if (in.size() > static_cast<uint32>(std::numeric_limits<uLong>::max()))
+    if (inSize > std::numeric_limits<uLong>::max())
     {
         Logger::Error("too big input buffer for uncompress rfc1951");
         return false;
     }
     uLong uncompressedSize = static_cast<uLong>(out.size());
-    int32 decompressResult = uncompress(out.data(), &uncompressedSize, in.data(), static_cast<uLong>(in.size()));
+    int32 decompressResult = uncompress(out.data(), &uncompressedSize, in, static_cast<uLong>(inSize));
     if (decompressResult != Z_OK)
     {
         Logger::Error("can't uncompress rfc1951 buffer");
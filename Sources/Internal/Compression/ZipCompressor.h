@@ -14,9 +14,11 @@ class File;
 class ZipCompressor : public Compressor
 {
 public:
+    using Compressor::Decompress;
+
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
     // you should resize output to correct size before call this method
-    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, uint32 inSize, Vector<uint8>& out) const override;
 };
 
 class ZipFile final
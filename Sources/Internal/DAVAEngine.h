@@ -157,7 +157,7 @@
 // Particle System
 #include "Particles/ParticleEmitter.h"
 #include "Particles/ParticleLayer.h"
-#include "Particles/Particle.h"
+#include "Particles/ParticleStorage.h"
 
 // 3D core classes
 #include "Scene3D/SceneFileV2.h"
@@ -6,6 +6,7 @@
 #include "FileSystem/FileAPIHelper.h"
 #include "DLCManager/DLCDownloader.h"
 #include "Utils/CRC32.h"
+#include "Compression/LZ4Compressor.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
 #include "Time/SystemTimer.h"
@@ -520,6 +521,7 @@ void DLCManagerImpl::Initialize(const FilePath& dirToDownloadPacks_,
         localCacheMeta = dirToDownloadPacks_ + "local_copy_server_meta.meta";
         localCacheFileTable = dirToDownloadPacks_ + "local_copy_server_file_table.block";
         localCacheFooter = dirToDownloadPacks_ + "local_copy_server_footer.footer";
+        localCacheDictionary = dirToDownloadPacks_ + "local_copy_server_dictionary.dict";
         urlToSuperPack = urlToServerSuperpack_;
         hints = hints_;
 
@@ -1211,7 +1213,9 @@ void DLCManagerImpl::CompareLocalMetaWitnRemoteHash()
     if (fs->IsFile(localCacheMeta))
     {
         const uint32 localCrc32 = CRC32::ForFile(localCacheMeta);
-        if (localCrc32 != initFooterOnServer.metaDataCrc32)
+        const bool dictionaryMatch = initFooterOnServer.dictionarySize == 0 ||
+        (fs->IsFile(localCacheDictionary) && CRC32::ForFile(localCacheDictionary) == initFooterOnServer.dictionaryCrc32);
+        if (localCrc32 != initFooterOnServer.metaDataCrc32 || !dictionaryMatch)
         {
             DeleteLocalMetaFile();
             // we have to download new localDB file from server!
@@ -1236,12 +1240,14 @@ void DLCManagerImpl::AskServerMeta()
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, &profiler);
 
-    uint64 internalDataSize = initFooterOnServer.metaDataSize +
+    // dictionary block lays right before meta, so download both in one request
+    uint64 internalDataSize = initFooterOnServer.dictionarySize +
+    initFooterOnServer.metaDataSize +
     initFooterOnServer.info.filesTableSize +
     sizeof(PackFormat::PackFile::FooterBlock);
 
     uint64 downloadOffset = fullSizeServerData - internalDataSize;
-    uint64 downloadSize = initFooterOnServer.metaDataSize;
+    uint64 downloadSize = initFooterOnServer.dictionarySize + initFooterOnServer.metaDataSize;
 
     buffer.resize(static_cast<size_t>(downloadSize));
 
@@ -1293,6 +1299,10 @@ void DLCManagerImpl::ParseMeta()
 {
     DAVA_PROFILER_CPU_SCOPE_CUSTOM(__FUNCTION__, &profiler);
 
+    const uint32 dictionarySize = initFooterOnServer.dictionarySize;
+    Vector<uint8> dictionary(buffer.begin(), buffer.begin() + dictionarySize);
+    buffer.erase(buffer.begin(), buffer.begin() + dictionarySize);
+
     const uint32 buffCrc32 = CRC32::ForBuffer(buffer);
 
     try
@@ -1305,6 +1315,20 @@ void DLCManagerImpl::ParseMeta()
             DAVA_THROW(Exception, "on server bad superpack!!! Footer meta not match crc32");
         }
 
+        if (dictionarySize > 0)
+        {
+            const uint32 dictionaryCrc32 = CRC32::ForBuffer(dictionary);
+            if (dictionaryCrc32 != initFooterOnServer.dictionaryCrc32)
+            {
+                log << "on server bad superpack!!! Footer dictionary not match crc32 "
+                    << std::hex << dictionaryCrc32 << " != "
+                    << initFooterOnServer.dictionaryCrc32 << std::dec << std::endl;
+                DAVA_THROW(Exception, "on server bad superpack!!! Footer dictionary not match crc32");
+            }
+
+            WriteBufferToFile(dictionary, localCacheDictionary);
+        }
+
         WriteBufferToFile(buffer, localCacheMeta);
     }
     catch (Exception& ex)
@@ -1389,6 +1413,21 @@ void DLCManagerImpl::LoadPacksDataFromMeta()
 
         metaRemote.reset(new PackMetaData(buffer.data(), buffer.size(), uncompressedFileNames));
 
+        if (initFooterOnServer.dictionarySize > 0)
+        {
+            // downloaded .dvpl files compressed with Lz4Dict are decompressed with this dictionary
+            Vector<uint8> dictionary;
+            if (!engine.GetContext()->fileSystem->ReadFileContents(localCacheDictionary, dictionary))
+            {
+                DAVA_THROW(Exception, "can't read localCacheDictionary");
+            }
+            if (initFooterOnServer.dictionaryCrc32 != CRC32::ForBuffer(dictionary))
+            {
+                DAVA_THROW(Exception, "can't read localCacheDictionary hash not match");
+            }
+            LZ4DictCompressor::RegisterDictionary(dictionary);
+        }
+
         const size_t numFiles = metaRemote->GetFileCount();
         scanFileReady.resize(numFiles);
 
@@ -1398,7 +1437,7 @@ void DLCManagerImpl::LoadPacksDataFromMeta()
     catch (Exception& ex)
     {
         log << "can't load pack data from meta: " << ex.what() << " file: " << ex.file << "(" << ex.line << ")" << std::endl;
-        engine.GetContext()->fileSystem->DeleteFile(localCacheMeta);
+        DeleteLocalMetaFile();
 
         // lets start all over again
         initState = InitState::LoadingRequestAskFooter;
@@ -1505,6 +1544,7 @@ void DLCManagerImpl::DeleteLocalMetaFile() const
 {
     FileSystem* fs = engine.GetContext()->fileSystem;
     fs->DeleteFile(localCacheMeta);
+    fs->DeleteFile(localCacheDictionary);
 }
 
 bool DLCManagerImpl::IsPackDownloaded(const String& packName) const
@@ -280,6 +280,7 @@ private:
     FilePath localCacheMeta;
     FilePath localCacheFileTable;
     FilePath localCacheFooter;
+    FilePath localCacheDictionary;
     FilePath dirToDownloadedPacks;
     String urlToSuperPack;
     bool isProcessingEnabled = false;
@@ -29,6 +29,8 @@ void DebugOverlayItemRenderStats::Draw()
             AddUIntStat("Triangle List Count", stats.primitiveTriangleListCount);
             AddUIntStat("Triangle Strip Count", stats.primitiveTriangleStripCount);
             AddUIntStat("Line List Count", stats.primitiveLineListCount);
+            AddUIntStat("Instanced Batches", stats.instancedBatches);
+            AddUIntStat("Instanced Packets", stats.instancedPackets);
         }
 
         if (ImGui::CollapsingHeader("State Switch"))
@@ -53,6 +55,14 @@ void DebugOverlayItemRenderStats::Draw()
             AddUIntStat("Packets", stats.packets2d);
         }
 
+        if (ImGui::CollapsingHeader("Shader Cache"))
+        {
+            AddUIntStat("Hits", stats.shaderCacheHits);
+            AddUIntStat("Misses", stats.shaderCacheMisses);
+            AddUIntStat("Source Compilations", stats.shaderSourceCompilations);
+            AddUIntStat("Miss Time (us)", stats.shaderCacheMissUs);
+        }
+
         if (ImGui::CollapsingHeader("Fragments Info"))
         {
             for (uint32 i = 0; i < uint32(VisibilityQueryResults::QUERY_INDEX_COUNT); ++i)
@@ -55,6 +55,7 @@ const char* SCENE_GEODECAL_SYSTEM = "GeoDecalSystem";
 //Render
 const char* RENDER_PASS_PREPARE_ARRAYS = "RenderPass::PrepareArrays";
 const char* RENDER_PASS_DRAW_LAYERS = "RenderPass::DrawLayers";
+const char* RENDER_PASS_SORT_LAYERS = "RenderPass::SortLayers";
 const char* RENDER_PREPARE_LANDSCAPE = "Landscape::Prepare";
 
 //RHI
@@ -55,6 +55,7 @@ extern const char* SCENE_GEODECAL_SYSTEM;
 //Render
 extern const char* RENDER_PASS_PREPARE_ARRAYS;
 extern const char* RENDER_PASS_DRAW_LAYERS;
+extern const char* RENDER_PASS_SORT_LAYERS;
 extern const char* RENDER_PREPARE_LANDSCAPE;
 
 //RHI
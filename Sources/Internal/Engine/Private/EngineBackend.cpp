@@ -809,7 +809,11 @@ void EngineBackend::InitRenderer(Window* w)
 
     w->InitCustomRenderParams(rendererParams);
 
-    rhi::ShaderSourceCache::Load("~doc:/ShaderSource.bin");
+    // shader sources precompiled by ResourceEditor (-shadercache) are shipped with resources,
+    // sources compiled at runtime since last launch are merged on top of them
+    String precompiledShaderCache = options->GetString("precompiled_shader_cache", "~res:/ShaderSource.bin");
+    rhi::ShaderSourceCache::Load(precompiledShaderCache.c_str());
+    rhi::ShaderSourceCache::Load("~doc:/ShaderSource.bin", true);
     Renderer::Initialize(renderer, rendererParams);
     context->renderSystem2D->Init();
 
@@ -0,0 +1,29 @@
+#include "Entity/SceneSystemAccess.h"
+
+namespace DAVA
+{
+bool SceneSystemAccess::ConflictsWith(const SceneSystemAccess& other) const
+{
+    if ((writeComponents & (other.readComponents | other.writeComponents)).any() ||
+        (other.writeComponents & readComponents).any())
+    {
+        return true;
+    }
+
+    return Intersects(writeSingletons, other.readSingletons) ||
+    Intersects(writeSingletons, other.writeSingletons) ||
+    Intersects(readSingletons, other.writeSingletons);
+}
+
+bool SceneSystemAccess::Intersects(const Vector<const Type*>& a, const Vector<const Type*>& b)
+{
+    for (const Type* type : a)
+    {
+        if (std::find(b.begin(), b.end(), type) != b.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+} // namespace DAVA
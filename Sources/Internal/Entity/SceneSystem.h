@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Base/BaseTypes.h"
+#include "Entity/SceneSystemAccess.h"
 
 /**
     \defgroup systems Systems
@@ -25,6 +26,14 @@ public:
     inline void SetRequiredComponents(const ComponentMask& requiredComponents);
     inline const ComponentMask& GetRequiredComponents() const;
 
+    /**
+        \brief Declare data accessed by `Process`. Should be called before system is added to scene.
+        Systems with declared non-conflicting access can be processed concurrently. See SceneSystemAccess for details.
+     */
+    inline void SetProcessAccess(const SceneSystemAccess& access);
+    inline const SceneSystemAccess& GetProcessAccess() const;
+    inline bool HasProcessAccess() const;
+
     /**
         \brief  This function is called when any entity registered to scene.
                 It sorts out is entity has all necessary components and we need to call AddEntity.
@@ -133,11 +142,22 @@ protected:
 
 private:
     ComponentMask requiredComponents;
+    SceneSystemAccess processAccess;
+    bool hasProcessAccess = false;
     Scene* scene = nullptr;
 
     bool locked = false;
 };
 
+/** Timing of `SceneSystem::Process` call collected by scene. */
+struct SceneSystemProcessTiming
+{
+    SceneSystem* system = nullptr;
+    int64 startUs = 0;
+    int64 durationUs = 0;
+    int32 workerIndex = -1; ///< Index of worker thread system was processed on, -1 for the main thread.
+};
+
 // Inline
 inline Scene* SceneSystem::GetScene() const
 {
@@ -153,4 +173,20 @@ inline const ComponentMask& SceneSystem::GetRequiredComponents() const
 {
     return requiredComponents;
 }
+
+inline void SceneSystem::SetProcessAccess(const SceneSystemAccess& access)
+{
+    processAccess = access;
+    hasProcessAccess = true;
+}
+
+inline const SceneSystemAccess& SceneSystem::GetProcessAccess() const
+{
+    return processAccess;
+}
+
+inline bool SceneSystem::HasProcessAccess() const
+{
+    return hasProcessAccess;
+}
 }
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/Type.h"
+#include "Entity/ComponentUtils.h"
+
+namespace DAVA
+{
+/**
+    \ingroup systems
+    \brief Description of data which is read and written by `SceneSystem::Process`.
+
+    Scene uses access descriptions to find systems which can be processed concurrently:
+    two systems conflict if one of them writes components or singletons the other one reads or writes.
+    Besides singleton components any shared object (e.g. `RenderSystem`) can be declared as singleton
+    to serialize systems which use it.
+
+    System without declared access is processed exclusively on the main thread, in registration order,
+    after all previous systems and before all following ones.
+
+    Example:
+    \code
+    WindSystem::WindSystem(Scene* scene)
+        : SceneSystem(scene)
+    {
+        SetProcessAccess(SceneSystemAccess().WriteComponent<WindComponent>());
+    }
+    \endcode
+*/
+class SceneSystemAccess
+{
+public:
+    template <typename T>
+    SceneSystemAccess& ReadComponent();
+
+    template <typename T>
+    SceneSystemAccess& WriteComponent();
+
+    template <typename T>
+    SceneSystemAccess& ReadSingleton();
+
+    template <typename T>
+    SceneSystemAccess& WriteSingleton();
+
+    /** Require system to be processed on the main thread. It still can be processed concurrently with worker-thread systems. */
+    SceneSystemAccess& SetMainThreadOnly(bool mainThreadOnly);
+    bool IsMainThreadOnly() const;
+
+    /** Return true if systems with `this` and `other` access can't be processed concurrently. */
+    bool ConflictsWith(const SceneSystemAccess& other) const;
+
+private:
+    static bool Intersects(const Vector<const Type*>& a, const Vector<const Type*>& b);
+
+    ComponentMask readComponents;
+    ComponentMask writeComponents;
+    Vector<const Type*> readSingletons;
+    Vector<const Type*> writeSingletons;
+    bool mainThreadOnly = false;
+};
+
+template <typename T>
+SceneSystemAccess& SceneSystemAccess::ReadComponent()
+{
+    readComponents |= ComponentUtils::MakeMask<T>();
+    return *this;
+}
+
+template <typename T>
+SceneSystemAccess& SceneSystemAccess::WriteComponent()
+{
+    writeComponents |= ComponentUtils::MakeMask<T>();
+    return *this;
+}
+
+template <typename T>
+SceneSystemAccess& SceneSystemAccess::ReadSingleton()
+{
+    readSingletons.push_back(Type::Instance<T>());
+    return *this;
+}
+
+template <typename T>
+SceneSystemAccess& SceneSystemAccess::WriteSingleton()
+{
+    writeSingletons.push_back(Type::Instance<T>());
+    return *this;
+}
+
+inline SceneSystemAccess& SceneSystemAccess::SetMainThreadOnly(bool mainThreadOnly_)
+{
+    mainThreadOnly = mainThreadOnly_;
+    return *this;
+}
+
+inline bool SceneSystemAccess::IsMainThreadOnly() const
+{
+    return mainThreadOnly;
+}
+} // namespace DAVA
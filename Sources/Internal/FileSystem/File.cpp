@@ -12,6 +12,7 @@
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/CheckIOError.h"
 #include "FileSystem/ResourceArchive.h"
+#include "FileSystem/Private/ResourceArchiveFile.h"
 #include "Engine/Private/Android/AssetsManagerAndroid.h"
 
 #include "Compression/LZ4Compressor.h"
@@ -201,20 +202,35 @@ File* File::Create(const FilePath& filename, uint32 attributes)
 File* File::LoadFileFromMountedArchive(const String& packName, const String& relative)
 {
     FileSystem* fs = FileSystem::Instance();
+
+    // Only lookup is done under lock, archive supports concurrent reads
+    std::shared_ptr<ResourceArchive> archive;
     {
         LockGuard<Mutex> lock(fs->accessArchiveMap);
 
         auto it = fs->resArchiveMap.find(packName);
         if (it != end(fs->resArchiveMap))
         {
-            Vector<uint8> fileContent;
-            if (it->second.archive->LoadFile(relative, fileContent))
-            {
-                return DynamicMemoryFile::Create(std::move(fileContent), READ, "~res:/" + relative);
-            }
+            archive = it->second.archive;
         }
-        return nullptr;
     }
+
+    if (archive)
+    {
+        // Stored files of mapped pack are read in place, without copying into memory file
+        ResourceArchive::FileView fileView;
+        if (archive->GetFileView(relative, fileView))
+        {
+            return ResourceArchiveFile::Create(std::move(fileView), "~res:/" + relative);
+        }
+
+        Vector<uint8> fileContent;
+        if (archive->LoadFile(relative, fileContent))
+        {
+            return DynamicMemoryFile::Create(std::move(fileContent), READ, "~res:/" + relative);
+        }
+    }
+    return nullptr;
 }
 
 bool File::IsFileInMountedArchive(const String& packName, const String& relative)
@@ -306,6 +322,31 @@ File* File::CompressedCreate(const FilePath& filename, uint32 attributes)
         return file;
     }
 
+    if (footer.type == Compressor::Type::Lz4Dict)
+    {
+        // dictionary is shared by all files of pack and registered when pack is opened or DLC meta is loaded
+        const uint32 dictionaryId = LZ4DictCompressor::GetDictionaryId(compressed);
+        std::shared_ptr<const LZ4DictCompressor> dictCompressor = LZ4DictCompressor::GetRegistered(dictionaryId);
+        if (!dictCompressor)
+        {
+            Logger::Error("can't decompress file: %s, it is compressed with dictionary 0x%08x which is not registered;"
+                          " open .dvpk the file comes from or initialize DLCManager before reading it",
+                          filename.GetAbsolutePathname().c_str(), dictionaryId);
+            return nullptr;
+        }
+
+        Vector<uint8> uncompressed(footer.sizeUncompressed);
+
+        if (!dictCompressor->Decompress(compressed, uncompressed))
+        {
+            Logger::Error("decompress failed on file: %s", filename.GetAbsolutePathname().c_str());
+            return nullptr;
+        }
+
+        DynamicMemoryFile* file = DynamicMemoryFile::Create(std::move(uncompressed), attributes, filename);
+        return file;
+    }
+
     if (footer.type == Compressor::Type::None)
     {
         DynamicMemoryFile* file = DynamicMemoryFile::Create(std::move(compressed), attributes, filename);
@@ -964,7 +964,7 @@ void FileSystem::Mount(const FilePath& archiveName, const String& attachPath)
     {
         ResourceArchiveItem item;
         item.attachPath = attachPath;
-        item.archive.reset(new ResourceArchive(archiveName));
+        item.archive = std::make_shared<ResourceArchive>(archiveName);
         item.archiveFilePath = archiveName;
 
         {
@@ -234,6 +234,8 @@ public:
 
         \param[in] archiveName pathname or local filename of archive we want to attach
         thread safe
+        Files opened from archive stay readable after unmount, archive is released with last of them
+        (see ResourceArchive::FileView).
     */
     virtual void Unmount(const FilePath& arhiveName);
 
@@ -323,7 +325,7 @@ private:
         {
         }
 
-        std::unique_ptr<ResourceArchive> archive;
+        std::shared_ptr<ResourceArchive> archive; // shared with loads in progress, so archive can be unmounted while they are reading
         String attachPath;
         FilePath archiveFilePath;
     };
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+/**
+    Read-only view of the whole file content in memory.
+
+    Regular file on disk is mapped into address space, so its pages are loaded by OS on demand and shared between processes.
+    If file can not be mapped (file from resource archive or compressed .dvpl file, platform without mapping support)
+    its content is read into internal buffer, so `GetData` is valid after successful `Open` in any case.
+
+    Example:
+    \code
+    MemoryMappedFile file;
+    if (file.Open("~res:/3d/Maps/map.sc2b"))
+    {
+        const Header* header = reinterpret_cast<const Header*>(file.GetData());
+    }
+    \endcode
+*/
+class MemoryMappedFile final
+{
+public:
+    MemoryMappedFile() = default;
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /**
+        Open file at `path`, previously opened file is closed. Return false if file can not be opened or read.
+        If `allowReadToBuffer` is false, file which can not be mapped is not read into memory and false is returned.
+    */
+    bool Open(const FilePath& path, bool allowReadToBuffer = true);
+
+    /** Release mapping or internal buffer. */
+    void Close();
+
+    /** Return true if file is opened. */
+    bool IsOpen() const;
+
+    /** Return true if file content is mapped, false if it was read into memory buffer. */
+    bool IsMapped() const;
+
+    /** Return pointer to file content. */
+    const uint8* GetData() const;
+
+    /** Return size of file content in bytes. */
+    uint64 GetSize() const;
+
+private:
+    bool Map(const String& absolutePathname);
+    void Unmap();
+    bool ReadToBuffer(const FilePath& path);
+
+    const uint8* data = nullptr;
+    uint64 size = 0;
+    Vector<uint8> buffer;
+    bool opened = false;
+    bool mapped = false;
+};
+
+inline bool MemoryMappedFile::IsOpen() const
+{
+    return opened;
+}
+
+inline bool MemoryMappedFile::IsMapped() const
+{
+    return mapped;
+}
+
+inline const uint8* MemoryMappedFile::GetData() const
+{
+    return data;
+}
+
+inline uint64 MemoryMappedFile::GetSize() const
+{
+    return size;
+}
+
+} // namespace DAVA
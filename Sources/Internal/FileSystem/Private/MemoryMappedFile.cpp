@@ -0,0 +1,167 @@
+#include "FileSystem/MemoryMappedFile.h"
+#include "FileSystem/File.h"
+#include "Base/ScopedPtr.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+
+#if defined(__DAVAENGINE_WIN32__)
+#include "Utils/UTF8Utils.h"
+#include <windows.h>
+#elif !defined(__DAVAENGINE_WIN_UAP__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace DAVA
+{
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+bool MemoryMappedFile::Open(const FilePath& path, bool allowReadToBuffer)
+{
+    Close();
+
+    opened = Map(path.GetAbsolutePathname()) || (allowReadToBuffer && ReadToBuffer(path));
+    return opened;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (mapped)
+    {
+        Unmap();
+    }
+
+    buffer.clear();
+    buffer.shrink_to_fit();
+    data = nullptr;
+    size = 0;
+    opened = false;
+    mapped = false;
+}
+
+bool MemoryMappedFile::ReadToBuffer(const FilePath& path)
+{
+    ScopedPtr<File> file(File::Create(path, File::OPEN | File::READ));
+    if (!file)
+    {
+        return false;
+    }
+
+    uint64 fileSize = file->GetSize();
+    if (fileSize > std::numeric_limits<uint32>::max())
+    {
+        Logger::Error("MemoryMappedFile: file %s is too big to be read into memory", path.GetStringValue().c_str());
+        return false;
+    }
+
+    buffer.resize(static_cast<size_t>(fileSize));
+    if (fileSize > 0 && file->Read(buffer.data(), static_cast<uint32>(fileSize)) != fileSize)
+    {
+        Logger::Error("MemoryMappedFile: failed to read file %s", path.GetStringValue().c_str());
+        buffer.clear();
+        return false;
+    }
+
+    data = buffer.data();
+    size = fileSize;
+    return true;
+}
+
+#if defined(__DAVAENGINE_WIN32__)
+
+bool MemoryMappedFile::Map(const String& absolutePathname)
+{
+    WideString pathname = UTF8Utils::EncodeToWideString(absolutePathname);
+    HANDLE file = ::CreateFileW(pathname.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    void* view = nullptr;
+    if (::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+    {
+        HANDLE mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            // View keeps mapping object alive
+            ::CloseHandle(mapping);
+        }
+    }
+    ::CloseHandle(file);
+
+    if (view == nullptr)
+    {
+        return false;
+    }
+
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(fileSize.QuadPart);
+    mapped = true;
+    return true;
+}
+
+void MemoryMappedFile::Unmap()
+{
+    BOOL result = ::UnmapViewOfFile(data);
+    DVASSERT(result != FALSE);
+}
+
+#elif defined(__DAVAENGINE_WIN_UAP__)
+
+bool MemoryMappedFile::Map(const String& /*absolutePathname*/)
+{
+    // Content is always read into buffer
+    return false;
+}
+
+void MemoryMappedFile::Unmap()
+{
+}
+
+#else
+
+bool MemoryMappedFile::Map(const String& absolutePathname)
+{
+    int fd = ::open(absolutePathname.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    void* view = MAP_FAILED;
+    struct stat fileStat;
+    if (::fstat(fd, &fileStat) == 0 && S_ISREG(fileStat.st_mode) && fileStat.st_size > 0)
+    {
+        view = ::mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    // Mapping stays valid after descriptor is closed
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(fileStat.st_size);
+    mapped = true;
+    return true;
+}
+
+void MemoryMappedFile::Unmap()
+{
+    int result = ::munmap(const_cast<uint8*>(data), static_cast<size_t>(size));
+    DVASSERT(result == 0);
+}
+
+#endif
+
+} // namespace DAVA
@@ -5,11 +5,16 @@
 #include "Utils/CRC32.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
-
-#include <mutex>
+#include "Concurrency/LockGuard.h"
 
 namespace DAVA
 {
+namespace PackArchiveDetails
+{
+// Larger scratch buffers are freed after use to not keep peak memory of the biggest file forever
+const size_t MAX_RETAINED_SCRATCH_SIZE = 4 * 1024 * 1024;
+}
+
 void PackArchive::ExtractFileTableData(const PackFormat::PackFile::FooterBlock& footerBlock,
                                        const Vector<uint8>& tmpBuffer,
                                        String& fileNames,
@@ -174,6 +179,39 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         }
         packMeta.reset(new PackMetaData(&metaBlock[0], metaBlock.size(), fileNames));
     }
+
+    // dictionary block is placed right before metadata block, it is empty if pack has no Lz4Dict content
+    Vector<uint8> dictionary(footerBlock.dictionarySize);
+    if (footerBlock.dictionarySize > 0)
+    {
+        uint64 startDictionaryBlock = size - (sizeof(packFile.footer) + packFile.footer.info.filesTableSize + footerBlock.metaDataSize + footerBlock.dictionarySize);
+        if (!file->Seek(startDictionaryBlock, File::SEEK_FROM_START))
+        {
+            DAVA_THROW(Exception, "can't seek dictionary");
+        }
+        if (file->Read(dictionary.data(), footerBlock.dictionarySize) != footerBlock.dictionarySize)
+        {
+            DAVA_THROW(Exception, "can't read dictionary");
+        }
+        if (CRC32::ForBuffer(dictionary) != footerBlock.dictionaryCrc32)
+        {
+            DAVA_THROW(Exception, "crc32 not match in dictionary in file: " + fileName);
+        }
+    }
+    if (!dictionary.empty())
+    {
+        // .dvpl files extracted from this pack are compressed with same dictionary, make it available for them
+        LZ4DictCompressor::RegisterDictionary(dictionary);
+    }
+    dictCompressor.reset(new LZ4DictCompressor(std::move(dictionary)));
+
+    // Only real mapping is useful here, reading whole pack into memory is not an option
+    std::shared_ptr<MemoryMappedFile> mapping = std::make_shared<MemoryMappedFile>();
+    if (mapping->Open(archiveName, false))
+    {
+        mappedFile = std::move(mapping);
+        verifiedFiles = Vector<std::atomic<bool>>(packFile.filesTable.data.files.size());
+    }
 }
 
 const Vector<ResourceArchive::FileInfo>& PackArchive::GetFilesInfo() const
@@ -206,12 +244,13 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
 {
     using namespace PackFormat;
 
-    if (!HasFile(relativeFilePath))
+    auto found = mapFileData.find(relativeFilePath);
+    if (found == mapFileData.end())
     {
         return false;
     }
 
-    const FileTableEntry& fileEntry = *mapFileData.find(relativeFilePath)->second;
+    const FileTableEntry& fileEntry = *found->second;
     output.resize(fileEntry.originalSize);
 
     if (!file)
@@ -219,19 +258,11 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
         DAVA_THROW(DAVA::Exception, "can't open: " + relativeFilePath + " from pack: " + archiveName.GetStringValue());
     }
 
-    bool isOk = file->Seek(fileEntry.startPosition, File::SEEK_FROM_START);
-    if (!isOk)
-    {
-        Logger::Error("can't load file: %s course: can't find start file position in pack file", relativeFilePath.c_str());
-        return false;
-    }
-
     switch (fileEntry.type)
     {
     case Compressor::Type::None:
     {
-        uint32 readOk = file->Read(output.data(), fileEntry.originalSize);
-        if (readOk != fileEntry.originalSize)
+        if (!ReadContent(fileEntry.startPosition, output.data(), fileEntry.originalSize))
         {
             Logger::Error("can't load file: %s course: can't read uncompressed content", relativeFilePath.c_str());
             return false;
@@ -240,35 +271,48 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     break;
     case Compressor::Type::Lz4:
     case Compressor::Type::Lz4HC:
+    case Compressor::Type::RFC1951:
+    case Compressor::Type::Lz4Dict:
     {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
-
-        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
-        if (readOk != fileEntry.compressedSize)
+        // compressed content is decompressed straight from mapped view, scratch buffer is needed only without mapping
+        Vector<uint8>* packedBuf = nullptr;
+        const uint8* packed = nullptr;
+        bool isOk = true;
+        if (mappedFile)
         {
-            Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
-            return false;
+            isOk = fileEntry.startPosition + fileEntry.compressedSize <= mappedFile->GetSize();
+            packed = mappedFile->GetData() + fileEntry.startPosition;
         }
-
-        if (!LZ4Compressor().Decompress(packedBuf, output))
+        else
         {
-            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
-            return false;
+            packedBuf = AcquireScratchBuffer();
+            packedBuf->resize(fileEntry.compressedSize);
+            isOk = ReadContent(fileEntry.startPosition, packedBuf->data(), fileEntry.compressedSize);
+            packed = packedBuf->data();
         }
-    }
-    break;
-    case Compressor::Type::RFC1951:
-    {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
 
-        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
-        if (readOk != fileEntry.compressedSize)
+        if (!isOk)
         {
             Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
-            return false;
+        }
+        else if (fileEntry.type == Compressor::Type::RFC1951)
+        {
+            isOk = ZipCompressor().Decompress(packed, fileEntry.compressedSize, output);
+        }
+        else if (fileEntry.type == Compressor::Type::Lz4Dict)
+        {
+            isOk = dictCompressor->Decompress(packed, fileEntry.compressedSize, output);
+        }
+        else
+        {
+            isOk = LZ4Compressor().Decompress(packed, fileEntry.compressedSize, output);
         }
 
-        if (!ZipCompressor().Decompress(packedBuf, output))
+        if (packedBuf != nullptr)
+        {
+            ReleaseScratchBuffer(packedBuf);
+        }
+        if (!isOk)
         {
             Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
             return false;
@@ -287,6 +331,85 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     return true;
 }
 
+bool PackArchive::GetFileView(const String& relativeFilePath, ResourceArchive::FileView& view) const
+{
+    using namespace PackFormat;
+
+    auto found = mapFileData.find(relativeFilePath);
+    if (!mappedFile || found == mapFileData.end())
+    {
+        return false;
+    }
+
+    const FileTableEntry& fileEntry = *found->second;
+    if (fileEntry.type != Compressor::Type::None || fileEntry.startPosition + fileEntry.originalSize > mappedFile->GetSize())
+    {
+        return false;
+    }
+
+    const uint8* data = mappedFile->GetData() + fileEntry.startPosition;
+
+    // Mapped content does not change, so checking it once is enough. Several threads may check same file
+    // simultaneously for the first time, this is harmless.
+    std::atomic<bool>& verified = verifiedFiles[&fileEntry - packFile.filesTable.data.files.data()];
+    if (!verified.load(std::memory_order_acquire))
+    {
+        if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(data, fileEntry.originalSize))
+        {
+            String msg = "original crc32 not match for: " + relativeFilePath + " in pack: " + archiveName.GetStringValue();
+            throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
+        }
+        verified.store(true, std::memory_order_release);
+    }
+
+    view.data = data;
+    view.size = fileEntry.originalSize;
+    view.mapping = mappedFile;
+    return true;
+}
+
+bool PackArchive::ReadContent(uint64 position, uint8* output, uint32 size) const
+{
+    if (mappedFile)
+    {
+        if (position + size > mappedFile->GetSize())
+        {
+            return false;
+        }
+        Memcpy(output, mappedFile->GetData() + position, size);
+        return true;
+    }
+
+    LockGuard<Mutex> lock(fileMutex);
+    return file->Seek(position, File::SEEK_FROM_START) && file->Read(output, size) == size;
+}
+
+Vector<uint8>* PackArchive::AcquireScratchBuffer() const
+{
+    {
+        LockGuard<Spinlock> lock(scratchBuffersLock);
+        if (!scratchBuffers.empty())
+        {
+            Vector<uint8>* buffer = scratchBuffers.back().release();
+            scratchBuffers.pop_back();
+            return buffer;
+        }
+    }
+    return new Vector<uint8>();
+}
+
+void PackArchive::ReleaseScratchBuffer(Vector<uint8>* buffer) const
+{
+    if (buffer->capacity() > PackArchiveDetails::MAX_RETAINED_SCRATCH_SIZE)
+    {
+        Vector<uint8>().swap(*buffer);
+    }
+
+    std::unique_ptr<Vector<uint8>> bufferPtr(buffer);
+    LockGuard<Spinlock> lock(scratchBuffersLock);
+    scratchBuffers.push_back(std::move(bufferPtr));
+}
+
 uint32 PackArchive::GetFileIndex(const String& releativeFilePath) const
 {
     uint32 result = std::numeric_limits<uint32>::max();
@@ -315,4 +438,9 @@ const PackFormat::PackFile& PackArchive::GetPackFile() const
     return packFile;
 }
 
+const LZ4DictCompressor* PackArchive::GetDictCompressor() const
+{
+    return dictCompressor.get();
+}
+
 } // end namespace DAVA
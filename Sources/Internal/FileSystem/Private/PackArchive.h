@@ -4,9 +4,23 @@
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/PackMetaData.h"
 #include "FileSystem/File.h"
+#include "FileSystem/MemoryMappedFile.h"
+#include "Compression/LZ4Compressor.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Spinlock.h"
+
+#include <atomic>
 
 namespace DAVA
 {
+/**
+    Archive in .dvpk format.
+
+    `LoadFile` can be called from any number of threads at once: content is copied from memory-mapped pack
+    without touching shared file position. If pack can not be mapped (e.g. it is located inside of apk),
+    reads from the file handle are serialized.
+    Stored files of mapped pack are available without copying through `GetFileView`.
+*/
 class PackArchive final : public ResourceArchiveImpl
 {
 public:
@@ -16,6 +30,7 @@ public:
     const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const override;
     bool HasFile(const String& relativeFilePath) const override;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const override;
+    bool GetFileView(const String& relativeFilePath, ResourceArchive::FileView& view) const override;
 
     /**
 		return index of struct with file info, usefull for meta data
@@ -31,6 +46,9 @@ public:
 
     const PackFormat::PackFile& GetPackFile() const;
 
+    /** Return compressor for Lz4Dict content, its dictionary is empty if pack has none. */
+    const LZ4DictCompressor* GetDictCompressor() const;
+
     static void ExtractFileTableData(const PackFormat::PackFile::FooterBlock& footerBlock,
                                      const Vector<uint8>& tmpBuffer,
                                      String& fileNames,
@@ -43,10 +61,26 @@ public:
                               Vector<ResourceArchive::FileInfo>& filesInfo);
 
 private:
+    bool ReadContent(uint64 position, uint8* output, uint32 size) const;
+
+    Vector<uint8>* AcquireScratchBuffer() const;
+    void ReleaseScratchBuffer(Vector<uint8>* buffer) const;
+
     const FilePath archiveName;
     mutable RefPtr<File> file;
+    mutable Mutex fileMutex;
+    // Shared with file views, so mapping outlives archive while content is in use
+    std::shared_ptr<MemoryMappedFile> mappedFile;
+    // Per entry of files table, set after crc32 of stored content is checked on first view
+    mutable Vector<std::atomic<bool>> verifiedFiles;
+
+    // Buffers for compressed content reused between calls, each loading thread holds its own buffer while decompressing
+    mutable Spinlock scratchBuffersLock;
+    mutable Vector<std::unique_ptr<Vector<uint8>>> scratchBuffers;
+
     PackFormat::PackFile packFile;
     std::unique_ptr<PackMetaData> packMeta;
+    std::unique_ptr<LZ4DictCompressor> dictCompressor;
     UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
     Vector<ResourceArchive::FileInfo> filesInfo;
 };
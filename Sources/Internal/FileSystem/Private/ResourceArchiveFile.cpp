@@ -0,0 +1,107 @@
+#include "FileSystem/Private/ResourceArchiveFile.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+ResourceArchiveFile* ResourceArchiveFile::Create(ResourceArchive::FileView&& view, const FilePath& name)
+{
+    ResourceArchiveFile* file = new ResourceArchiveFile();
+    file->view = std::move(view);
+    file->filename = name;
+    return file;
+}
+
+uint32 ResourceArchiveFile::Read(void* destinationBuffer, uint32 dataSize)
+{
+    DVASSERT(nullptr != destinationBuffer);
+
+    if (currentPtr == view.size && !isEof && dataSize > 0)
+    {
+        isEof = true;
+        return 0;
+    }
+
+    uint64 realReadSize = dataSize;
+    if (currentPtr + realReadSize > view.size)
+    {
+        isEof = true;
+        realReadSize = (currentPtr < view.size) ? view.size - currentPtr : 0;
+    }
+
+    if (realReadSize > 0)
+    {
+        Memcpy(destinationBuffer, view.data + currentPtr, static_cast<size_t>(realReadSize));
+        currentPtr += realReadSize;
+    }
+    return static_cast<uint32>(realReadSize);
+}
+
+uint64 ResourceArchiveFile::GetPos() const
+{
+    return currentPtr;
+}
+
+uint64 ResourceArchiveFile::GetSize() const
+{
+    return view.size;
+}
+
+bool ResourceArchiveFile::Seek(int64 position, eFileSeek seekType)
+{
+    int64 pos = 0;
+    switch (seekType)
+    {
+    case SEEK_FROM_START:
+        pos = position;
+        break;
+    case SEEK_FROM_CURRENT:
+        pos = static_cast<int64>(currentPtr) + position;
+        break;
+    case SEEK_FROM_END:
+        pos = static_cast<int64>(view.size) - 1 + position;
+        break;
+    default:
+        return false;
+    };
+
+    if (pos < 0)
+    {
+        return false;
+    }
+
+    if (pos > static_cast<int64>(view.size))
+    {
+        Logger::Warning("archive file opened in readonly mode you about to seek over EOF (POSIX let it)");
+    }
+
+    currentPtr = static_cast<uint64>(pos);
+    // behavior like in std::FILE http://en.cppreference.com/w/c/io/fseek
+    isEof = false;
+
+    return true;
+}
+
+bool ResourceArchiveFile::IsEof() const
+{
+    return isEof;
+}
+
+uint32 ResourceArchiveFile::Write(const void* /*sourceBuffer*/, uint32 /*dataSize*/)
+{
+    DVASSERT(false, "Write is not supported");
+    return 0;
+}
+
+bool ResourceArchiveFile::Truncate(uint64 /*size*/)
+{
+    DVASSERT(false, "Truncate is not supported");
+    return false;
+}
+
+bool ResourceArchiveFile::Flush()
+{
+    return true;
+}
+
+} // namespace DAVA
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "FileSystem/File.h"
+#include "FileSystem/ResourceArchive.h"
+
+namespace DAVA
+{
+/**
+    Read-only file which reads content of stored file directly from memory-mapped resource archive.
+    Read and seek behavior is the same as of DynamicMemoryFile opened for reading.
+*/
+class ResourceArchiveFile final : public File
+{
+public:
+    static ResourceArchiveFile* Create(ResourceArchive::FileView&& view, const FilePath& name);
+
+    /** Return pointer to the whole file content. */
+    const uint8* GetData() const;
+
+    uint32 Read(void* destinationBuffer, uint32 dataSize) override;
+    uint64 GetPos() const override;
+    uint64 GetSize() const override;
+    bool Seek(int64 position, eFileSeek seekType) override;
+    bool IsEof() const override;
+
+private:
+    ResourceArchiveFile() = default;
+
+    uint32 Write(const void* sourceBuffer, uint32 dataSize) override;
+    bool Truncate(uint64 size) override;
+    bool Flush() override;
+
+    ResourceArchive::FileView view;
+    uint64 currentPtr = 0;
+    bool isEof = false;
+};
+
+inline const uint8* ResourceArchiveFile::GetData() const
+{
+    return view.data;
+}
+
+} // namespace DAVA
@@ -13,6 +13,11 @@ public:
     virtual const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const = 0;
     virtual bool HasFile(const String& relativeFilePath) const = 0;
     virtual bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const = 0;
+
+    virtual bool GetFileView(const String& relativeFilePath, ResourceArchive::FileView& view) const
+    {
+        return false;
+    }
 };
 
 } // end namespace DAVA
@@ -2,6 +2,7 @@
 
 #include "FileSystem/Private/ResourceArchivePrivate.h"
 #include "Compression/ZipCompressor.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
@@ -17,6 +18,7 @@ public:
 
 private:
     ZipFile zipFile;
+    mutable Mutex zipFileMutex; // zip reader keeps state of extraction, so loads are serialized
     Vector<ResourceArchive::FileInfo> fileInfos;
 };
 } // end namespace DAVA
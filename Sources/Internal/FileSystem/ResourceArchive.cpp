@@ -97,6 +97,11 @@ bool ResourceArchive::LoadFile(const String& relativeFilePath,
     return impl->LoadFile(relativeFilePath, output);
 }
 
+bool ResourceArchive::GetFileView(const String& relativeFilePath, FileView& view) const
+{
+    return impl->GetFileView(relativeFilePath, view);
+}
+
 bool ResourceArchive::UnpackToFolder(const FilePath& dir) const
 {
     Vector<uint8> content;
@@ -39,11 +39,31 @@ public:
         Compressor::Type compressionType = Compressor::Type::None;
     };
 
+    /**
+        Read-only view of stored (not compressed) file content inside of memory-mapped archive.
+        Archive content stays mapped while any view referencing it is alive, even if archive is destroyed
+        or unmounted with `FileSystem::Unmount`: archive file is kept open and its address space reserved
+        until last view (and every `File` created over it) is released.
+        Crc32 of content is checked once per file on first view, not on every call.
+    */
+    struct FileView
+    {
+        const uint8* data = nullptr;
+        uint32 size = 0;
+        std::shared_ptr<const void> mapping;
+    };
+
     const Vector<FileInfo>& GetFilesInfo() const;
     const FileInfo* GetFileInfo(const String& relativeFilePath) const;
     bool HasFile(const String& relativeFilePath) const;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& outputFileContent) const;
 
+    /**
+        Fill `view` with content of `relativeFilePath` without copying.
+        Return false if file is compressed or archive is not memory-mapped, use `LoadFile` in this case.
+    */
+    bool GetFileView(const String& relativeFilePath, FileView& view) const;
+
     bool UnpackToFolder(const FilePath& dir) const;
 
 private:
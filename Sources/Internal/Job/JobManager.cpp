@@ -6,7 +6,6 @@
 #include "Engine/Engine.h"
 #include "Concurrency/LockGuard.h"
 #include "Concurrency/UniqueLock.h"
-#include "Job/JobThread.h"
 #include "Platform/DeviceInfo.h"
 
 namespace DAVA
@@ -18,13 +17,7 @@ JobManager::JobManager(Engine* e)
     , workerDoneSem(0)
 {
     uint32 cpuCoresCount = DeviceInfo::GetCpuCount();
-    workerThreads.reserve(cpuCoresCount);
-
-    for (uint32 i = 0; i < cpuCoresCount; ++i)
-    {
-        JobThread* thread = new JobThread(&workerQueue, &workerDoneSem);
-        workerThreads.push_back(thread);
-    }
+    scheduler.reset(new JobScheduler(std::max(cpuCoresCount, 1u)));
 
     e->update.Connect(this, &JobManager::Update);
 }
@@ -41,12 +34,7 @@ JobManager::~JobManager()
     mainJobIDCounter = 0;
     mainCV.NotifyAll();
 
-    for (uint32 i = 0; i < workerThreads.size(); ++i)
-    {
-        SafeDelete(workerThreads[i]);
-    }
-
-    workerThreads.clear();
+    scheduler.reset();
 }
 
 void JobManager::Update(float32 /*frameDelta*/)
@@ -100,7 +88,7 @@ void JobManager::Update(float32 /*frameDelta*/)
 
 uint32 JobManager::GetWorkersCount() const
 {
-    return static_cast<uint32>(workerThreads.size());
+    return scheduler->GetWorkersCount();
 }
 
 uint32 JobManager::CreateMainJob(const Function<void()>& fn, eMainJobType mainJobType)
@@ -235,10 +223,44 @@ bool JobManager::HasMainJobID(uint32 mainJobID)
     return (mainJobID > mainJobLastExecutedID);
 }
 
-void JobManager::CreateWorkerJob(const Function<void()>& fn)
+JobHandle JobManager::CreateWorkerJob(const Function<void()>& fn, const JobHandle& parent)
+{
+    return CreateWorkerJobAfter(JobHandle(), fn, parent);
+}
+
+JobHandle JobManager::CreateWorkerJobAfter(const JobHandle& dependency, const Function<void()>& fn, const JobHandle& parent)
+{
+    // Count every job, so WaitWorkerJobs can wait for all of them regardless of their parents
+    workerJobsCount.fetch_add(1);
+    return scheduler->ScheduleAfter(dependency, [this, fn]() {
+        fn();
+        workerJobsCount.fetch_sub(1);
+        workerDoneSem.Post();
+    },
+                                    parent);
+}
+
+JobHandle JobManager::CreateWorkerJobGroup()
+{
+    return scheduler->CreateGroup();
+}
+
+void JobManager::SealWorkerJobGroup(const JobHandle& group)
+{
+    scheduler->SealGroup(group);
+}
+
+void JobManager::WaitWorkerJob(const JobHandle& handle)
+{
+    if (handle)
+    {
+        scheduler->Wait(handle);
+    }
+}
+
+void JobManager::ParallelFor(uint32 begin, uint32 end, uint32 grainSize, const Function<void(uint32, uint32)>& fn)
 {
-    workerQueue.Push(fn);
-    workerQueue.Signal();
+    scheduler->ParallelFor(begin, end, grainSize, fn);
 }
 
 void JobManager::WaitWorkerJobs()
@@ -264,6 +286,6 @@ void JobManager::WaitWorkerJobs()
 
 bool JobManager::HasWorkerJobs()
 {
-    return !workerQueue.IsEmpty();
+    return workerJobsCount.load() > 0;
 }
 }
@@ -6,12 +6,11 @@
 #include "Concurrency/Semaphore.h"
 #include "Concurrency/Thread.h"
 #include "Functional/Function.h"
-#include "Job/JobQueue.h"
+#include "Job/JobScheduler.h"
 
 namespace DAVA
 {
 class Engine;
-class JobThread;
 class JobManager
 {
 public:
@@ -59,8 +58,36 @@ public:
 
     /*! Add function to execute in the worker-thread.
 		\param [in] fn Function to execute.
+		\param [in] parent Optional parent job. Parent is not finished until this job is finished.
+        \return Handle of created job. It can be used to wait for this job or as parent/dependency of other jobs.
 	*/
-    void CreateWorkerJob(const Function<void()>& fn);
+    JobHandle CreateWorkerJob(const Function<void()>& fn, const JobHandle& parent = JobHandle());
+
+    /*! Add function to execute in the worker-thread after `dependency` job is finished.
+		\param [in] dependency Job to wait for.
+		\param [in] fn Function to execute.
+		\param [in] parent Optional parent job.
+        \return Handle of created job.
+	*/
+    JobHandle CreateWorkerJobAfter(const JobHandle& dependency, const Function<void()>& fn, const JobHandle& parent = JobHandle());
+
+    /*! Create empty job group. Worker jobs created with the group as parent can be waited all at once.
+        Group is not done until it is sealed with `SealWorkerJobGroup`.
+    */
+    JobHandle CreateWorkerJobGroup();
+
+    /*! Close job group: it is done as soon as all jobs added to it are finished. Must be called exactly once per group. */
+    void SealWorkerJobGroup(const JobHandle& group);
+
+    /*! Wait until job with given handle and all its children are executed.
+        Calling thread executes other worker jobs while waiting.
+    */
+    void WaitWorkerJob(const JobHandle& handle);
+
+    /*! Execute `fn(chunkBegin, chunkEnd)` for chunks of range [begin, end) in worker-threads and wait for them.
+		\param [in] grainSize Chunk size. If zero chunk size is selected automatically.
+	*/
+    void ParallelFor(uint32 begin, uint32 end, uint32 grainSize, const Function<void(uint32, uint32)>& fn);
 
     /*! Wait until all worker-thread jobs are executed. */
     void WaitWorkerJobs();
@@ -70,6 +97,9 @@ public:
 	*/
     bool HasWorkerJobs();
 
+    /*! Returns work-stealing scheduler which executes worker-thread jobs. */
+    JobScheduler* GetScheduler() const;
+
 protected:
     struct MainJob
     {
@@ -98,7 +128,12 @@ protected:
     MainJob curMainJob;
 
     Semaphore workerDoneSem;
-    JobQueueWorker workerQueue;
-    Vector<JobThread*> workerThreads;
+    std::unique_ptr<JobScheduler> scheduler;
+    std::atomic<int32> workerJobsCount{ 0 };
 };
+
+inline JobScheduler* JobManager::GetScheduler() const
+{
+    return scheduler.get();
+}
 }
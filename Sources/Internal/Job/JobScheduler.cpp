@@ -0,0 +1,374 @@
+#include "Job/JobScheduler.h"
+
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/UniqueLock.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+struct JobScheduler::Job
+{
+    Function<void()> fn;
+    JobHandle handle;
+};
+
+struct JobScheduler::Worker
+{
+    JobScheduler* owner = nullptr;
+    int32 index = 0;
+    uint32 randomState = 0;
+    Thread* thread = nullptr;
+    WorkStealingDeque<Job> deque;
+};
+
+namespace JobSchedulerDetails
+{
+const uint32 MAX_SPINS_BEFORE_SLEEP = 64;
+const uint32 CHUNKS_PER_WORKER = 4;
+
+uint32 NextRandom(uint32& state)
+{
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+} // namespace JobSchedulerDetails
+
+JobCounter::~JobCounter()
+{
+    // Continuations of a dependency which never finished are never executed
+    for (JobScheduler::Job* job : continuations)
+    {
+        delete job;
+    }
+}
+
+ThreadLocalPtr<JobScheduler::Worker>& JobScheduler::CurrentWorker()
+{
+    // Worker descriptors are owned by scheduler, so TLS should not delete them
+    static ThreadLocalPtr<Worker> currentWorker([](Worker*) {});
+    return currentWorker;
+}
+
+JobScheduler::JobScheduler(uint32 workersCount)
+{
+    DVASSERT(workersCount > 0);
+
+    // Create all descriptors before starting threads as workers steal from each other
+    workers.reserve(workersCount);
+    for (uint32 i = 0; i < workersCount; ++i)
+    {
+        Worker* worker = new Worker();
+        worker->owner = this;
+        worker->index = static_cast<int32>(i);
+        worker->randomState = 0x9E3779B9u * (i + 1);
+        workers.push_back(worker);
+    }
+
+    for (Worker* worker : workers)
+    {
+        worker->thread = Thread::Create([this, worker]() { WorkerFunc(worker); });
+        worker->thread->SetName("DAVA::JobWorker");
+        worker->thread->Start();
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    {
+        LockGuard<Mutex> guard(sleepMutex);
+        cancel = true;
+        sleepCV.NotifyAll();
+    }
+
+    for (Worker* worker : workers)
+    {
+        worker->thread->Join();
+        SafeRelease(worker->thread);
+    }
+
+    // Drop jobs which were not executed
+    for (Worker* worker : workers)
+    {
+        while (Job* job = worker->deque.Pop())
+        {
+            delete job;
+        }
+        delete worker;
+    }
+    workers.clear();
+
+    for (Job* job : injectionQueue)
+    {
+        delete job;
+    }
+    injectionQueue.clear();
+}
+
+int32 JobScheduler::GetCurrentWorkerIndex() const
+{
+    Worker* worker = CurrentWorker().Get();
+    return (worker != nullptr && worker->owner == this) ? worker->index : -1;
+}
+
+JobHandle JobScheduler::CreateGroup()
+{
+    // Self reference keeps the group unfinished until SealGroup, so early dependents wait for the children
+    JobHandle group = std::make_shared<JobCounter>();
+    group->unfinished = 1;
+    group->sealed = false;
+    return group;
+}
+
+void JobScheduler::SealGroup(const JobHandle& group)
+{
+    DVASSERT(group);
+
+    bool wasSealed = group->sealed.exchange(true);
+    DVASSERT(!wasSealed, "Job group is sealed twice");
+    if (!wasSealed)
+    {
+        Finish(group.get());
+    }
+}
+
+JobHandle JobScheduler::Schedule(const Function<void()>& fn, const JobHandle& parent)
+{
+    return ScheduleAfter(JobHandle(), fn, parent);
+}
+
+JobHandle JobScheduler::ScheduleAfter(const JobHandle& dependency, const Function<void()>& fn, const JobHandle& parent)
+{
+    DVASSERT(fn != nullptr);
+
+    JobHandle handle = std::make_shared<JobCounter>();
+    handle->unfinished = 1;
+    if (parent)
+    {
+        handle->parent = parent;
+        parent->unfinished.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Job* job = new Job();
+    job->fn = fn;
+    job->handle = handle;
+
+    if (dependency)
+    {
+        LockGuard<Spinlock> guard(dependency->continuationsLock);
+        if (!dependency->IsDone())
+        {
+            // Job will be pushed by Finish() when dependency is done
+            dependency->continuations.push_back(job);
+            return handle;
+        }
+    }
+
+    Push(job);
+    return handle;
+}
+
+void JobScheduler::ParallelFor(uint32 begin, uint32 end, uint32 grainSize, const Function<void(uint32, uint32)>& fn)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    uint32 count = end - begin;
+    if (grainSize == 0)
+    {
+        uint32 chunksCount = GetWorkersCount() * JobSchedulerDetails::CHUNKS_PER_WORKER;
+        grainSize = std::max(1u, (count + chunksCount - 1) / chunksCount);
+    }
+
+    if (count <= grainSize)
+    {
+        fn(begin, end);
+        return;
+    }
+
+    JobHandle group = CreateGroup();
+    for (uint32 chunkBegin = begin + grainSize; chunkBegin < end; chunkBegin += grainSize)
+    {
+        uint32 chunkEnd = std::min(end, chunkBegin + grainSize);
+        Schedule([&fn, chunkBegin, chunkEnd]() { fn(chunkBegin, chunkEnd); }, group);
+    }
+
+    SealGroup(group);
+
+    // Process first chunk on calling thread
+    fn(begin, begin + grainSize);
+
+    Wait(group);
+}
+
+void JobScheduler::Wait(const JobHandle& handle)
+{
+    DVASSERT(handle->sealed, "Waiting for job group that is not sealed");
+
+    uint32 spins = 0;
+    while (!handle->IsDone())
+    {
+        if (TryExecuteOne())
+        {
+            spins = 0;
+        }
+        else if (++spins < JobSchedulerDetails::MAX_SPINS_BEFORE_SLEEP)
+        {
+            Thread::Yield();
+        }
+        else
+        {
+            Thread::Sleep(0);
+        }
+    }
+}
+
+bool JobScheduler::TryExecuteOne()
+{
+    Worker* self = CurrentWorker().Get();
+    if (self != nullptr && self->owner != this)
+    {
+        self = nullptr;
+    }
+
+    Job* job = Take(self);
+    if (job != nullptr)
+    {
+        Execute(job);
+        return true;
+    }
+    return false;
+}
+
+void JobScheduler::Push(Job* job)
+{
+    Worker* self = CurrentWorker().Get();
+    bool pushed = (self != nullptr && self->owner == this && self->deque.Push(job));
+    if (!pushed)
+    {
+        LockGuard<Spinlock> guard(injectionLock);
+        injectionQueue.push_back(job);
+    }
+
+    // Pairs with the sleepingWorkers increment in WorkerFunc: either we see a sleeper and wake it up
+    // or the worker sees pending job and does not go to sleep
+    pendingJobs.fetch_add(1, std::memory_order_seq_cst);
+    if (sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+    {
+        LockGuard<Mutex> guard(sleepMutex);
+        sleepCV.NotifyOne();
+    }
+}
+
+JobScheduler::Job* JobScheduler::Take(Worker* self)
+{
+    Job* job = nullptr;
+
+    if (self != nullptr)
+    {
+        job = self->deque.Pop();
+    }
+
+    if (job == nullptr)
+    {
+        LockGuard<Spinlock> guard(injectionLock);
+        if (!injectionQueue.empty())
+        {
+            job = injectionQueue.front();
+            injectionQueue.pop_front();
+        }
+    }
+
+    if (job == nullptr)
+    {
+        uint32 workersCount = GetWorkersCount();
+        uint32 start = 0;
+        if (self != nullptr)
+        {
+            start = JobSchedulerDetails::NextRandom(self->randomState) % workersCount;
+        }
+
+        for (uint32 i = 0; i < workersCount && job == nullptr; ++i)
+        {
+            Worker* victim = workers[(start + i) % workersCount];
+            if (victim != self)
+            {
+                job = victim->deque.Steal();
+            }
+        }
+    }
+
+    if (job != nullptr)
+    {
+        pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+void JobScheduler::Execute(Job* job)
+{
+    job->fn();
+    Finish(job->handle.get());
+    delete job;
+}
+
+void JobScheduler::Finish(JobCounter* counter)
+{
+    if (counter->unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        Vector<Job*> continuations;
+        {
+            LockGuard<Spinlock> guard(counter->continuationsLock);
+            continuations.swap(counter->continuations);
+        }
+
+        for (Job* job : continuations)
+        {
+            Push(job);
+        }
+
+        if (counter->parent)
+        {
+            Finish(counter->parent.get());
+        }
+    }
+}
+
+void JobScheduler::WorkerFunc(Worker* self)
+{
+    CurrentWorker().Reset(self);
+
+    uint32 spins = 0;
+    while (!cancel)
+    {
+        Job* job = Take(self);
+        if (job != nullptr)
+        {
+            Execute(job);
+            spins = 0;
+        }
+        else if (++spins < JobSchedulerDetails::MAX_SPINS_BEFORE_SLEEP)
+        {
+            Thread::Yield();
+        }
+        else
+        {
+            UniqueLock<Mutex> lock(sleepMutex);
+            sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+            while (pendingJobs.load(std::memory_order_seq_cst) <= 0 && !cancel)
+            {
+                sleepCV.Wait(lock);
+            }
+            sleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
+            spins = 0;
+        }
+    }
+
+    CurrentWorker().Release();
+}
+
+} // namespace DAVA
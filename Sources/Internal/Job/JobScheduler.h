@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Spinlock.h"
+#include "Concurrency/Thread.h"
+#include "Concurrency/ThreadLocalPtr.h"
+#include "Functional/Function.h"
+#include "Job/WorkStealingDeque.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+class JobCounter;
+
+/** Handle to a scheduled job, can be used to wait for the job or as parent/dependency of other jobs. */
+using JobHandle = std::shared_ptr<JobCounter>;
+
+/**
+    Work-stealing job scheduler.
+
+    Every worker thread owns a `WorkStealingDeque`: jobs scheduled from a worker go to its own deque,
+    idle workers steal from the others. Jobs scheduled from non-worker threads go to a shared injection queue.
+
+    Jobs can form hierarchies: a job scheduled with `parent` handle delays completion of the parent until the job finishes.
+    Job scheduled with `ScheduleAfter` does not start until its dependency is done.
+
+    Group created by `CreateGroup` stays open until `SealGroup` is called, so jobs scheduled after the group
+    do not start while the group is still empty or being filled.
+
+    Example:
+    \code
+    JobHandle root = scheduler->CreateGroup();
+    scheduler->ScheduleAfter(root, []() { Finalize(); });
+    for (Entity* e : entities)
+    {
+        scheduler->Schedule([e]() { Process(e); }, root);
+    }
+    scheduler->SealGroup(root);
+    scheduler->Wait(root);
+    \endcode
+*/
+class JobScheduler final
+{
+public:
+    /** Create scheduler with `workersCount` worker threads. */
+    explicit JobScheduler(uint32 workersCount);
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    /** Return number of worker threads. */
+    uint32 GetWorkersCount() const;
+
+    /** Return index of the worker thread the function is called from or -1 if calling thread is not a worker. */
+    int32 GetCurrentWorkerIndex() const;
+
+    /**
+        Create empty open group handle. Jobs scheduled with this handle as parent are added to the group.
+        Group is not done until `SealGroup` is called for it, even if it has no unfinished children.
+    */
+    JobHandle CreateGroup();
+
+    /** Close `group` created by `CreateGroup`: it is done as soon as all its children are finished. Must be called exactly once. */
+    void SealGroup(const JobHandle& group);
+
+    /** Schedule `fn` for execution on worker threads. If `parent` is set, it is not done until this job is finished. */
+    JobHandle Schedule(const Function<void()>& fn, const JobHandle& parent = JobHandle());
+
+    /** Schedule `fn` for execution after `dependency` is done. */
+    JobHandle ScheduleAfter(const JobHandle& dependency, const Function<void()>& fn, const JobHandle& parent = JobHandle());
+
+    /**
+        Split range [begin, end) into chunks of `grainSize` elements, execute `fn(chunkBegin, chunkEnd)` for each chunk
+        on worker threads and wait until all chunks are processed. If `grainSize` is zero it is selected automatically.
+    */
+    void ParallelFor(uint32 begin, uint32 end, uint32 grainSize, const Function<void(uint32, uint32)>& fn);
+
+    /** Block until `handle` is done. Calling thread executes pending jobs while waiting. Group must be sealed before waiting. */
+    void Wait(const JobHandle& handle);
+
+    /** Try to take one pending job and execute it on calling thread. Return true if a job was executed. */
+    bool TryExecuteOne();
+
+private:
+    friend class JobCounter;
+
+    struct Job;
+    struct Worker;
+
+    void Push(Job* job);
+    Job* Take(Worker* self);
+    void Execute(Job* job);
+    void Finish(JobCounter* counter);
+    void WorkerFunc(Worker* self);
+
+    static ThreadLocalPtr<Worker>& CurrentWorker();
+
+    Vector<Worker*> workers;
+
+    Spinlock injectionLock;
+    Deque<Job*> injectionQueue;
+
+    std::atomic<int32> pendingJobs{ 0 };
+    std::atomic<int32> sleepingWorkers{ 0 };
+    std::atomic<bool> cancel{ false };
+
+    Mutex sleepMutex;
+    ConditionVariable sleepCV;
+};
+
+/**
+    Completion counter of a job or a group of jobs.
+
+    Counter is considered done when the job it was created for and all its child jobs have finished.
+    Counter created by `JobScheduler::CreateGroup` holds a reference of its own instead of a job, and is done
+    when it is sealed and all its children are finished.
+*/
+class JobCounter final
+{
+public:
+    ~JobCounter();
+
+    /** Return true if job and all its children have finished. */
+    bool IsDone() const;
+
+private:
+    friend class JobScheduler;
+
+    std::atomic<int32> unfinished{ 0 };
+    std::atomic<bool> sealed{ true };
+    std::shared_ptr<JobCounter> parent;
+
+    Spinlock continuationsLock;
+    Vector<JobScheduler::Job*> continuations;
+};
+
+inline bool JobCounter::IsDone() const
+{
+    return unfinished.load(std::memory_order_acquire) == 0;
+}
+
+inline uint32 JobScheduler::GetWorkersCount() const
+{
+    return static_cast<uint32>(workers.size());
+}
+
+} // namespace DAVA
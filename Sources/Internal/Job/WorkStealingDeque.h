@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Debug/DVAssert.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+/**
+    Bounded Chase-Lev work-stealing deque of pointers.
+
+    Only the owner thread is allowed to call `Push` and `Pop`, they work on the bottom end of the deque (LIFO order).
+    Any other thread can call `Steal`, which takes elements from the top end (FIFO order).
+    Capacity is fixed and must be a power of two, `Push` returns false if deque is full so caller can put element elsewhere.
+
+    Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le, Pop, Cohen, Nardelli, 2013).
+*/
+template <typename T>
+class WorkStealingDeque final
+{
+public:
+    explicit WorkStealingDeque(uint32 capacity = 4096);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /** Push `item` to the bottom of deque. Owner thread only. Return false if deque is full. */
+    bool Push(T* item);
+
+    /** Pop item from the bottom of deque. Owner thread only. Return nullptr if deque is empty. */
+    T* Pop();
+
+    /** Steal item from the top of deque. Can be called from any thread. Return nullptr if deque is empty or race was lost. */
+    T* Steal();
+
+    /** Return approximate count of items in deque. */
+    uint32 GetApproxSize() const;
+
+private:
+    std::atomic<int64> top;
+    std::atomic<int64> bottom;
+    std::atomic<T*>* buffer = nullptr;
+    int64 mask = 0;
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(uint32 capacity)
+    : top(0)
+    , bottom(0)
+    , mask(static_cast<int64>(capacity) - 1)
+{
+    DVASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0, "WorkStealingDeque capacity should be a power of two");
+    buffer = new std::atomic<T*>[capacity];
+    for (uint32 i = 0; i < capacity; ++i)
+    {
+        buffer[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque()
+{
+    delete[] buffer;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Push(T* item)
+{
+    int64 b = bottom.load(std::memory_order_relaxed);
+    int64 t = top.load(std::memory_order_acquire);
+    if (b - t > mask)
+    {
+        return false;
+    }
+
+    buffer[b & mask].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+T* WorkStealingDeque<T>::Pop()
+{
+    int64 b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64 t = top.load(std::memory_order_relaxed);
+
+    T* item = nullptr;
+    if (t <= b)
+    {
+        item = buffer[b & mask].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last item, race with thieves
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+template <typename T>
+T* WorkStealingDeque<T>::Steal()
+{
+    int64 t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64 b = bottom.load(std::memory_order_acquire);
+
+    if (t < b)
+    {
+        T* item = buffer[t & mask].load(std::memory_order_relaxed);
+        if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+uint32 WorkStealingDeque<T>::GetApproxSize() const
+{
+    int64 b = bottom.load(std::memory_order_relaxed);
+    int64 t = top.load(std::memory_order_relaxed);
+    return b > t ? static_cast<uint32>(b - t) : 0;
+}
+
+} // namespace DAVA
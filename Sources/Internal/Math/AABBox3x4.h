@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/AABBox3.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+/**
+    \brief Four axial-aligned bounding boxes stored as structure of arrays.
+    Layout lets Frustum test all four boxes against one plane with single SIMD operations.
+ */
+struct AABBox3x4
+{
+    static const uint32 BOX_COUNT = 4;
+
+    float32 minX[BOX_COUNT];
+    float32 minY[BOX_COUNT];
+    float32 minZ[BOX_COUNT];
+    float32 maxX[BOX_COUNT];
+    float32 maxY[BOX_COUNT];
+    float32 maxZ[BOX_COUNT];
+
+    inline AABBox3x4();
+
+    inline void Set(uint32 index, const AABBox3& box);
+    inline AABBox3 Get(uint32 index) const;
+};
+
+inline AABBox3x4::AABBox3x4()
+{
+    for (uint32 i = 0; i < BOX_COUNT; ++i)
+    {
+        Set(i, AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 0.0f)));
+    }
+}
+
+inline void AABBox3x4::Set(uint32 index, const AABBox3& box)
+{
+    DVASSERT(index < BOX_COUNT);
+    minX[index] = box.min.x;
+    minY[index] = box.min.y;
+    minZ[index] = box.min.z;
+    maxX[index] = box.max.x;
+    maxY[index] = box.max.y;
+    maxZ[index] = box.max.z;
+}
+
+inline AABBox3 AABBox3x4::Get(uint32 index) const
+{
+    DVASSERT(index < BOX_COUNT);
+    return AABBox3(Vector3(minX[index], minY[index], minZ[index]), Vector3(maxX[index], maxY[index], maxZ[index]));
+}
+
+} // namespace DAVA
@@ -551,6 +551,12 @@ uint32 MemoryManager::GetTrackedMemoryUsage(uint32 poolIndex) const
     return statAllocPool[poolIndex].allocByApp;
 }
 
+uint32 MemoryManager::GetAllocationCount() const
+{
+    LockType lock(allocMutex);
+    return statGeneral.nextBlockNo;
+}
+
 uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
 {
     DVASSERT(tagIndex != 0 && IsPowerOf2(tagIndex));
@@ -94,6 +94,9 @@ public:
 
     uint32 GetTaggedMemoryUsage(uint32 tagIndex) const;
 
+    // Number of allocations made by application since start
+    uint32 GetAllocationCount() const;
+
     uint32 CalcStatConfigSize() const;
     void GetStatConfig(void* buffer, uint32 bufSize) const;
 
@@ -43,7 +43,6 @@ public:
     RefPtr<PropertyLine<float32>> turbulenceLine;
 
     Vector3 position;
-    Vector3 worldPosition;
     Vector3 rotation;
     Vector3 direction{ 0.0f, 0.0f, 1.0f };
     Vector3 forcePower{ 1.0f, 1.0f, 1.0f };
@@ -7,12 +7,12 @@ namespace DAVA
 class ParticleForce;
 class Vector3;
 class Entity;
-struct Particle;
+class ParticleStorage;
 
 class ParticleForces
 {
 public:
-    static void ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, Particle* particle, const Vector3& prevPosition, const Vector3& forcePosition);
+    static void ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, ParticleStorage& particles, uint32 particleIndex, const Vector3& prevPosition, const Vector3& forcePosition);
 };
 
 class ParticleForcesUtils
@@ -2,7 +2,7 @@
 
 #include "ParticleEmitter.h"
 #include "ParticleLayer.h"
-#include "Particle.h"
+#include "ParticleStorage.h"
 #include "Render/Material/NMaterial.h"
 
 namespace DAVA
@@ -42,7 +42,7 @@ struct ParticleGroup
     ParticleEmitter* emitter = nullptr;
     ParticleLayer* layer = nullptr;
     NMaterial* material = nullptr;
-    Particle* head = nullptr;
+    ParticleStorage particles;
 
     Vector3 spawnPosition;
 
@@ -73,5 +73,6 @@ struct ParticleEffectData
 {
     Vector<ParentInfo> infoSources;
     List<ParticleGroup> groups;
+    AABBox3 bbox; // world space bounds of all particles
 };
 }
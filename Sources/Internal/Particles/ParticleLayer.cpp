@@ -381,6 +381,11 @@ bool ParticleLayer::IsLodActive(int32 lod)
     return false;
 }
 
+bool ParticleLayer::NeedsOrderedParticles() const
+{
+    return blending == BLENDING_ALPHABLEND || blending == BLENDING_PREMULTIPLIED_ALPHA;
+}
+
 void ParticleLayer::SetLodActive(int32 lod, bool active)
 {
     if ((lod >= 0) && (lod < static_cast<int32>(activeLODS.size())))
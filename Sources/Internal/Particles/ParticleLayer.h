@@ -6,12 +6,14 @@
 #include "Render/2D/Sprite.h"
 
 #include "FileSystem/YamlParser.h"
-#include "Particles/Particle.h"
+#include "Particles/ParticleStorage.h"
 #include "Particles/ParticleForceSimplified.h"
 #include "Particles/ParticlePropertyLine.h"
 #include "FileSystem/FilePath.h"
 #include <Reflection/Reflection.h>
 
+#include <atomic>
+
 namespace DAVA
 {
 class ParticleEmitterInstance;
@@ -39,7 +41,8 @@ struct ParticleLayer : public BaseObject
     float32 stripeFadeDistanceFromTop = 0.0f;
     RefPtr<PropertyLine<Color>> stripeColorOverLife;
 
-    float32 maxStripeOverLife = 0.0f;
+    // Layer is shared by effects simulated in parallel, value is computed lazily by any of them
+    std::atomic<float32> maxStripeOverLife{ 0.0f };
 
     enum eType
     {
@@ -100,6 +103,9 @@ struct ParticleLayer : public BaseObject
     bool IsLodActive(int32 lod);
     void SetLodActive(int32 lod, bool active);
 
+    // particles are drawn in storage order, so blending that depends on draw order requires to keep it on removal
+    bool NeedsOrderedParticles() const;
+
     void SetSprite(const FilePath& spritePath);
     void SetFlowmap(const FilePath& spritePath_);
     void SetPivotPoint(Vector2 pivot);
@@ -236,7 +242,7 @@ struct ParticleLayer : public BaseObject
     bool enableFlow = false;
     bool enableFlowAnimation = false;
     bool usePerspectiveMapping = false;
-    bool isMaxStripeOverLifeDirty = true;
+    std::atomic<bool> isMaxStripeOverLifeDirty{ true };
 
     bool useThreePointGradient = false;
     bool applyGlobalForces = false;
@@ -275,12 +281,11 @@ inline float32 ParticleLayer::CalculateMaxStripeSizeOverLife()
 {
     using Key = PropertyLine<float32>::PropertyKey;
 
-    if (!isMaxStripeOverLifeDirty)
-        return maxStripeOverLife;
+    if (!isMaxStripeOverLifeDirty.load(std::memory_order_acquire))
+        return maxStripeOverLife.load(std::memory_order_relaxed);
     if (stripeSizeOverLife.Get() == nullptr)
         return 1.0f;
 
-    isMaxStripeOverLifeDirty = false;
     const Vector<Key>& keys = stripeSizeOverLife->GetValues();
     auto max = std::max_element(keys.begin(), keys.end(),
                                 [](const Key& a, const Key& b)
@@ -288,8 +293,11 @@ inline float32 ParticleLayer::CalculateMaxStripeSizeOverLife()
                                     return a.value < b.value;
                                 }
                                 );
-    maxStripeOverLife = (*max).value;
-    return maxStripeOverLife;
+    // several threads may compute same value at once, flag release makes value visible to threads which see it cleared
+    const float32 maxValue = (*max).value;
+    maxStripeOverLife.store(maxValue, std::memory_order_relaxed);
+    isMaxStripeOverLifeDirty.store(false, std::memory_order_release);
+    return maxValue;
 }
 
 inline bool ParticleLayer::GetInheritPosition() const
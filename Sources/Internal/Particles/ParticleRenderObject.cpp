@@ -191,7 +191,7 @@ uint32 ParticleRenderObject::SelectLayout(const ParticleLayer& layer)
     return layoutMap[key];
 }
 
-void ParticleRenderObject::UpdateStripeVertex(float32*& dataPtr, Vector3& position, Vector3& uv, float32* color, ParticleLayer* layer, Particle* particle, float32 fresToAlpha)
+void ParticleRenderObject::UpdateStripeVertex(float32*& dataPtr, Vector3& position, Vector3& uv, float32* color, ParticleLayer* layer, const ParticleStorage& particles, uint32 particleIndex, float32 fresToAlpha)
 {
     *dataPtr++ = position.x;
     *dataPtr++ = position.y;
@@ -206,28 +206,28 @@ void ParticleRenderObject::UpdateStripeVertex(float32*& dataPtr, Vector3& positi
     {
         *dataPtr++ = uv.x;
         *dataPtr++ = uv.y;
-        *dataPtr++ = particle->currFlowSpeed;
-        *dataPtr++ = particle->currFlowOffset;
+        *dataPtr++ = particles.currFlowSpeed[particleIndex];
+        *dataPtr++ = particles.currFlowOffset[particleIndex];
     }
     if (layer->enableNoise && layer->noise.get() != nullptr)
     {
         float32 offsetU = uv.x;
         if (layer->enableNoiseScroll)
-            offsetU += layer->usePerspectiveMapping ? particle->currNoiseUOffset * uv.z : particle->currNoiseUOffset;
+            offsetU += layer->usePerspectiveMapping ? particles.currNoiseUOffset[particleIndex] * uv.z : particles.currNoiseUOffset[particleIndex];
 
         *dataPtr++ = offsetU;
 
         float32 offsetV = uv.y;
         if (layer->enableNoiseScroll)
-            offsetV += layer->usePerspectiveMapping ? particle->currNoiseVOffset * uv.z : particle->currNoiseVOffset;
+            offsetV += layer->usePerspectiveMapping ? particles.currNoiseVOffset[particleIndex] * uv.z : particles.currNoiseVOffset[particleIndex];
         *dataPtr++ = offsetV;
 
-        *dataPtr++ = particle->currNoiseScale;
+        *dataPtr++ = particles.currNoiseScale[particleIndex];
     }
     if (layer->enableAlphaRemap || layer->usePerspectiveMapping || layer->useFresnelToAlpha)
     {
         *dataPtr++ = fresToAlpha;
-        *dataPtr++ = particle->alphaRemap;
+        *dataPtr++ = particles.alphaRemap[particleIndex];
         *dataPtr++ = uv.z;
     }
 }
@@ -309,19 +309,19 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
         int32 basises[4]; //4 basises max per particle
         basisCount = PrepareBasisIndexes(group, basises);
 
-        Particle* current = group.head;
-        while (current)
+        const ParticleStorage& particles = group.particles;
+        for (uint32 particleIndex = 0, particleCount = particles.GetCount(); particleIndex < particleCount; ++particleIndex)
         {
-            float32* pT = group.layer->sprite->GetTextureVerts(current->frame);
-            Color currColor = current->color;
+            float32* pT = group.layer->sprite->GetTextureVerts(particles.frame[particleIndex]);
+            Color currColor = particles.color[particleIndex];
             if (group.layer->colorOverLife)
-                currColor = group.layer->colorOverLife->GetValue(current->life / current->lifeTime);
+                currColor = group.layer->colorOverLife->GetValue(particles.life[particleIndex] / particles.lifeTime[particleIndex]);
             if (group.layer->alphaOverLife)
-                currColor.a = group.layer->alphaOverLife->GetValue(current->life / current->lifeTime);
+                currColor.a = group.layer->alphaOverLife->GetValue(particles.life[particleIndex] / particles.lifeTime[particleIndex]);
             uint32 color = rhi::NativeColorRGBA(currColor.r, currColor.g, currColor.b, Min(currColor.a, 1.0f));
             float32 sin_angle;
             float32 cos_angle;
-            SinCosFast(-current->angle, sin_angle, cos_angle); //- is because artists consider positive rotation to be clockwise
+            SinCosFast(-particles.angle[particleIndex], sin_angle, cos_angle); //- is because artists consider positive rotation to be clockwise
 
             for (int32 i = 0; i < basisCount; i++)
             {
@@ -347,7 +347,7 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
                 //TODO: rethink this code - it should be easier
                 if (group.layer->isLong) //note that for now it's just a copy of long implementatio - later rethink it;
                 {
-                    ey = current->speed;
+                    ey = particles.GetSpeed(particleIndex);
                     float32 vel = ey.Length();
                     float32 base = 0.0f;
                     if (vel < EPSILON)
@@ -373,12 +373,12 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
                     fresnelToAlpha = FresnelShlick(dot, group.layer->fresnelToAlphaBias, group.layer->fresnelToAlphaPower);
                 }
 
-                left *= 0.5f * current->currSize.x * (1 + group.layer->layerPivotPoint.x);
-                right *= 0.5f * current->currSize.x * (1 - group.layer->layerPivotPoint.x);
-                top *= 0.5f * current->currSize.y * (1 + group.layer->layerPivotPoint.y);
-                bot *= 0.5f * current->currSize.y * (1 - group.layer->layerPivotPoint.y);
+                left *= 0.5f * particles.currSize[particleIndex].x * (1 + group.layer->layerPivotPoint.x);
+                right *= 0.5f * particles.currSize[particleIndex].x * (1 - group.layer->layerPivotPoint.x);
+                top *= 0.5f * particles.currSize[particleIndex].y * (1 + group.layer->layerPivotPoint.y);
+                bot *= 0.5f * particles.currSize[particleIndex].y * (1 - group.layer->layerPivotPoint.y);
 
-                Vector3 particlePosition = current->position;
+                Vector3 particlePosition = particles.GetPosition(particleIndex);
                 if (group.layer->GetInheritPosition())
                     particlePosition += effectData->infoSources[group.positionSource].position;
                 Array<Vector3, 4> quadPos = { particlePosition + left + bot, particlePosition + right + bot, particlePosition + left + top, particlePosition + right + top };
@@ -399,7 +399,7 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
 
                 if (begin->layer->enableFrameBlend)
                 {
-                    int32 nextFrame = current->frame + 1;
+                    int32 nextFrame = particles.frame[particleIndex] + 1;
                     if (nextFrame >= group.layer->sprite->GetFrameCount())
                     {
                         if (group.layer->loopSpriteAnimation)
@@ -413,34 +413,34 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
                     {
                         verts[i][ptrOffset] = *(pT++);
                         verts[i][ptrOffset + 1] = *(pT++);
-                        verts[i][ptrOffset + 2] = current->animTime;
+                        verts[i][ptrOffset + 2] = particles.animTime[particleIndex];
                     }
                     ptrOffset += 3;
                 }
                 if (begin->layer->enableFlow && begin->layer->flowmap.get() != nullptr)
                 {
-                    float32* flowUV = group.layer->flowmap->GetTextureVerts(current->frame);
+                    float32* flowUV = group.layer->flowmap->GetTextureVerts(particles.frame[particleIndex]);
                     for (int32 i = 0; i < 4; i++) // VS_TEXCOORD2.xy, z - speed, w - offset.
                     {
                         verts[i][ptrOffset + 0] = flowUV[i * 2];
                         verts[i][ptrOffset + 1] = flowUV[i * 2 + 1];
-                        verts[i][ptrOffset + 2] = current->currFlowSpeed;
-                        verts[i][ptrOffset + 3] = current->currFlowOffset;
+                        verts[i][ptrOffset + 2] = particles.currFlowSpeed[particleIndex];
+                        verts[i][ptrOffset + 3] = particles.currFlowOffset[particleIndex];
                     }
                     ptrOffset += 4;
                 }
                 if (begin->layer->enableNoise && begin->layer->noise.get() != nullptr)
                 {
-                    float32* noiseUV = group.layer->noise->GetTextureVerts(current->frame);
+                    float32* noiseUV = group.layer->noise->GetTextureVerts(particles.frame[particleIndex]);
                     for (int32 i = 0; i < 4; ++i)
                     {
                         verts[i][ptrOffset + 0] = noiseUV[i * 2]; // VS_TEXCOORD0 xy + color.
                         verts[i][ptrOffset + 1] = noiseUV[i * 2 + 1];
-                        verts[i][ptrOffset + 2] = current->currNoiseScale;
+                        verts[i][ptrOffset + 2] = particles.currNoiseScale[particleIndex];
                         if (begin->layer->enableNoiseScroll)
                         {
-                            verts[i][ptrOffset + 0] += current->currNoiseUOffset;
-                            verts[i][ptrOffset + 1] += current->currNoiseVOffset;
+                            verts[i][ptrOffset + 0] += particles.currNoiseUOffset[particleIndex];
+                            verts[i][ptrOffset + 1] += particles.currNoiseVOffset[particleIndex];
                         }
                     }
                     ptrOffset += 3;
@@ -450,7 +450,7 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
                     for (int32 i = 0; i < 4; ++i)
                     {
                         verts[i][ptrOffset + 0] = fresnelToAlpha;
-                        verts[i][ptrOffset + 1] = current->alphaRemap;
+                        verts[i][ptrOffset + 1] = particles.alphaRemap[particleIndex];
                         verts[i][ptrOffset + 2] = 0.0f;
                     }
                     ptrOffset += 3;
@@ -458,7 +458,6 @@ void ParticleRenderObject::AppendParticleGroup(List<ParticleGroup>::iterator beg
                 currpos += particleStride;
                 verteciesAppended += 4;
             }
-            current = current->next;
         }
     }
 
@@ -489,22 +488,19 @@ void ParticleRenderObject::AppendStripeParticle(List<ParticleGroup>::iterator be
         if (basisCount == 0)
             continue;
 
-        Particle* currentParticle = group.head;
-        while (currentParticle)
+        const ParticleStorage& particles = group.particles;
+        for (uint32 particleIndex = 0, particleCount = particles.GetCount(); particleIndex < particleCount; ++particleIndex)
         {
             StripeData& data = group.stripe;
             if (!data.isActive)
-            {
-                currentParticle = currentParticle->next;
                 continue;
-            }
 
-            float32* pT = group.layer->sprite->GetTextureVerts(currentParticle->frame);
-            Color currColor = currentParticle->color;
+            float32* pT = group.layer->sprite->GetTextureVerts(particles.frame[particleIndex]);
+            Color currColor = particles.color[particleIndex];
             if (group.layer->colorOverLife)
-                currColor = group.layer->colorOverLife->GetValue(currentParticle->life / currentParticle->lifeTime);
+                currColor = group.layer->colorOverLife->GetValue(particles.life[particleIndex] / particles.lifeTime[particleIndex]);
             if (group.layer->alphaOverLife)
-                currColor.a = group.layer->alphaOverLife->GetValue(currentParticle->life / currentParticle->lifeTime);
+                currColor.a = group.layer->alphaOverLife->GetValue(particles.life[particleIndex] / particles.lifeTime[particleIndex]);
 
             StripeNode& base = data.baseNode;
             List<StripeNode>& nodes = data.stripeNodes;
@@ -567,10 +563,10 @@ void ParticleRenderObject::AppendStripeParticle(List<ParticleGroup>::iterator be
                 float32 tile = 1.0f;
                 if (group.layer->stripeTextureTileOverLife)
                     tile = group.layer->stripeTextureTileOverLife->GetValue(0.0f);
-                float32 startU = currentParticle->life * group.layer->stripeUScrollSpeed;
-                float32 startV = currentParticle->life * group.layer->stripeVScrollSpeed;
+                float32 startU = particles.life[particleIndex] * group.layer->stripeUScrollSpeed;
+                float32 startV = particles.life[particleIndex] * group.layer->stripeVScrollSpeed;
                 if (Abs(data.uvOffset) > EPSILON)
-                    startV += data.uvOffset * tile + currentParticle->life * group.layer->stripeVScrollSpeed;
+                    startV += data.uvOffset * tile + particles.life[particleIndex] * group.layer->stripeVScrollSpeed;
 
                 Vector3 uv1 = Vector3(startU, startV, 0.0f);
                 Vector3 uv2 = Vector3(startU + 1.0f, startV, 0.0f);
@@ -601,8 +597,8 @@ void ParticleRenderObject::AppendStripeParticle(List<ParticleGroup>::iterator be
 
                 uint32 col = rhi::NativeColorRGBA(Saturate(currColor.r * colOverLife.r), Saturate(currColor.g * colOverLife.g), Saturate(currColor.b * colOverLife.b), Saturate(currColor.a * colOverLife.a * fadeFromTop));
                 float32* color = reinterpret_cast<float32*>(&col);
-                UpdateStripeVertex(vertexBufferData, left, uv1, color, group.layer, currentParticle, fresnelToAlpha);
-                UpdateStripeVertex(vertexBufferData, right, uv2, color, group.layer, currentParticle, fresnelToAlpha);
+                UpdateStripeVertex(vertexBufferData, left, uv1, color, group.layer, particles, particleIndex, fresnelToAlpha);
+                UpdateStripeVertex(vertexBufferData, right, uv2, color, group.layer, particles, particleIndex, fresnelToAlpha);
 
                 float32 distance = 0.0f;
 
@@ -642,9 +638,9 @@ void ParticleRenderObject::AppendStripeParticle(List<ParticleGroup>::iterator be
                     tile = 1.0f;
                     if (group.layer->stripeTextureTileOverLife)
                         tile = group.layer->stripeTextureTileOverLife->GetValue(overLifeTime);
-                    float32 v = distance * tile + currentParticle->life * group.layer->stripeVScrollSpeed;
+                    float32 v = distance * tile + particles.life[particleIndex] * group.layer->stripeVScrollSpeed;
                     if (Abs(data.uvOffset) > EPSILON)
-                        v += data.uvOffset * tile + currentParticle->life * group.layer->stripeVScrollSpeed;
+                        v += data.uvOffset * tile + particles.life[particleIndex] * group.layer->stripeVScrollSpeed;
 
                     if (group.layer->usePerspectiveMapping)
                     {
@@ -657,8 +653,8 @@ void ParticleRenderObject::AppendStripeParticle(List<ParticleGroup>::iterator be
                     uv1.y = v;
                     uv2.y = v;
 
-                    UpdateStripeVertex(vertexBufferData, left, uv1, color, group.layer, currentParticle, fresnelToAlpha);
-                    UpdateStripeVertex(vertexBufferData, right, uv2, color, group.layer, currentParticle, fresnelToAlpha);
+                    UpdateStripeVertex(vertexBufferData, left, uv1, color, group.layer, particles, particleIndex, fresnelToAlpha);
+                    UpdateStripeVertex(vertexBufferData, right, uv2, color, group.layer, particles, particleIndex, fresnelToAlpha);
                 }
                 for (uint32 i = 0; i < static_cast<uint32>(nodes.size()); ++i)
                 {
@@ -674,7 +670,6 @@ void ParticleRenderObject::AppendStripeParticle(List<ParticleGroup>::iterator be
                 baseVertex += vCountInBasis;
             }
             AppendRenderBatch(begin->material, iCount, SelectLayout(*begin->layer), vb, ib.buffer, ib.baseIndex);
-            currentParticle = currentParticle->next;
         }
     }
 }
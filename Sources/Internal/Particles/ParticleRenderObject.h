@@ -76,7 +76,7 @@ private:
     uint32 GetVertexStride(ParticleLayer* layer);
     int32 CalculateParticleCount(const ParticleGroup& group);
     uint32 SelectLayout(const ParticleLayer& layer);
-    void UpdateStripeVertex(float32*& dataPtr, Vector3& position, Vector3& uv, float32* color, ParticleLayer* layer, Particle* particle, float32 fresToAlpha);
+    void UpdateStripeVertex(float32*& dataPtr, Vector3& position, Vector3& uv, float32* color, ParticleLayer* layer, const ParticleStorage& particles, uint32 particleIndex, float32 fresToAlpha);
     Vector3 GetStripeNormalizedSpeed(const StripeData& data);
 
     Map<uint32, uint32> layoutMap;
@@ -107,6 +107,6 @@ inline bool ParticleRenderObject::CheckIfSimpleParticle(ParticleLayer* layer) co
 
 inline bool ParticleRenderObject::CheckGroup(const ParticleGroup& group) const
 {
-    return group.material && group.head && !group.layer->isDisabled && group.layer->sprite;
+    return group.material && !group.particles.IsEmpty() && !group.layer->isDisabled && group.layer->sprite;
 }
 }
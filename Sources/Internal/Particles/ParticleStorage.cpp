@@ -0,0 +1,301 @@
+#include "Particles/ParticleStorage.h"
+
+#include <limits>
+
+#include "Debug/DVAssert.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DAVA_PARTICLES_SSE 1
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define DAVA_PARTICLES_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace ParticleStorageDetails
+{
+const uint32 SIMD_WIDTH = 4;
+
+// dst[i] += src[i] * scale[i] * dt, null scale means 1
+void MultiplyAdd(float32* dst, const float32* src, const float32* scale, float32 dt, uint32 count)
+{
+    uint32 i = 0;
+#if defined(DAVA_PARTICLES_SSE)
+    const __m128 dt4 = _mm_set1_ps(dt);
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+    {
+        __m128 delta = _mm_mul_ps(_mm_loadu_ps(src + i), dt4);
+        if (scale != nullptr)
+            delta = _mm_mul_ps(delta, _mm_loadu_ps(scale + i));
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), delta));
+    }
+#elif defined(DAVA_PARTICLES_NEON)
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+    {
+        float32x4_t delta = vmulq_n_f32(vld1q_f32(src + i), dt);
+        if (scale != nullptr)
+            delta = vmulq_f32(delta, vld1q_f32(scale + i));
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), delta));
+    }
+#endif
+    for (; i < count; ++i)
+        dst[i] += src[i] * (scale != nullptr ? scale[i] * dt : dt);
+}
+
+// dst[i] += value * scale[i] * dt, null scale means 1
+void AddScaled(float32* dst, float32 value, const float32* scale, float32 dt, uint32 count)
+{
+    const float32 delta = value * dt;
+    uint32 i = 0;
+#if defined(DAVA_PARTICLES_SSE)
+    const __m128 delta4 = _mm_set1_ps(delta);
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+    {
+        __m128 d = (scale != nullptr) ? _mm_mul_ps(delta4, _mm_loadu_ps(scale + i)) : delta4;
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), d));
+    }
+#elif defined(DAVA_PARTICLES_NEON)
+    const float32x4_t delta4 = vdupq_n_f32(delta);
+    for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+    {
+        float32x4_t d = (scale != nullptr) ? vmulq_n_f32(vld1q_f32(scale + i), delta) : delta4;
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), d));
+    }
+#endif
+    for (; i < count; ++i)
+        dst[i] += (scale != nullptr) ? delta * scale[i] : delta;
+}
+
+// min(values[i] - radius[i]) and max(values[i] + radius[i]) over all particles
+void MinMax(const float32* values, const float32* radius, uint32 count, float32& outMin, float32& outMax)
+{
+    float32 minValue = std::numeric_limits<float32>::max();
+    float32 maxValue = -std::numeric_limits<float32>::max();
+    uint32 i = 0;
+#if defined(DAVA_PARTICLES_SSE)
+    if (count >= SIMD_WIDTH)
+    {
+        __m128 min4 = _mm_set1_ps(minValue);
+        __m128 max4 = _mm_set1_ps(maxValue);
+        for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+        {
+            __m128 v = _mm_loadu_ps(values + i);
+            __m128 r = _mm_loadu_ps(radius + i);
+            min4 = _mm_min_ps(min4, _mm_sub_ps(v, r));
+            max4 = _mm_max_ps(max4, _mm_add_ps(v, r));
+        }
+        alignas(16) float32 mins[SIMD_WIDTH];
+        alignas(16) float32 maxs[SIMD_WIDTH];
+        _mm_store_ps(mins, min4);
+        _mm_store_ps(maxs, max4);
+        for (uint32 k = 0; k < SIMD_WIDTH; ++k)
+        {
+            minValue = Min(minValue, mins[k]);
+            maxValue = Max(maxValue, maxs[k]);
+        }
+    }
+#elif defined(DAVA_PARTICLES_NEON)
+    if (count >= SIMD_WIDTH)
+    {
+        float32x4_t min4 = vdupq_n_f32(minValue);
+        float32x4_t max4 = vdupq_n_f32(maxValue);
+        for (; i + SIMD_WIDTH <= count; i += SIMD_WIDTH)
+        {
+            float32x4_t v = vld1q_f32(values + i);
+            float32x4_t r = vld1q_f32(radius + i);
+            min4 = vminq_f32(min4, vsubq_f32(v, r));
+            max4 = vmaxq_f32(max4, vaddq_f32(v, r));
+        }
+        float32 mins[SIMD_WIDTH];
+        float32 maxs[SIMD_WIDTH];
+        vst1q_f32(mins, min4);
+        vst1q_f32(maxs, max4);
+        for (uint32 k = 0; k < SIMD_WIDTH; ++k)
+        {
+            minValue = Min(minValue, mins[k]);
+            maxValue = Max(maxValue, maxs[k]);
+        }
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        minValue = Min(minValue, values[i] - radius[i]);
+        maxValue = Max(maxValue, values[i] + radius[i]);
+    }
+    outMin = minValue;
+    outMax = maxValue;
+}
+}
+
+template <typename Fn>
+void ParticleStorage::ForEachArray(Fn&& fn)
+{
+    fn(positionX);
+    fn(positionY);
+    fn(positionZ);
+    fn(speedX);
+    fn(speedY);
+    fn(speedZ);
+    fn(life);
+    fn(lifeTime);
+    fn(angle);
+    fn(spin);
+    fn(frame);
+    fn(animTime);
+    fn(baseFlowSpeed);
+    fn(currFlowSpeed);
+    fn(baseFlowOffset);
+    fn(currFlowOffset);
+    fn(baseNoiseScale);
+    fn(currNoiseScale);
+    fn(baseNoiseUScrollSpeed);
+    fn(currNoiseUOffset);
+    fn(baseNoiseVScrollSpeed);
+    fn(currNoiseVOffset);
+    fn(currRadius);
+    fn(alphaRemap);
+    fn(baseSize);
+    fn(currSize);
+    fn(color);
+    fn(positionTarget);
+    fn(seed);
+}
+
+uint32 ParticleStorage::Add()
+{
+    ForEachArray([](auto& array) {
+        using ValueType = typename std::decay_t<decltype(array)>::value_type;
+        array.push_back(ValueType());
+    });
+    return count++;
+}
+
+void ParticleStorage::Remove(uint32 index)
+{
+    DVASSERT(index < count);
+    uint32 last = count - 1;
+    ForEachArray([index, last](auto& array) {
+        if (index != last)
+            array[index] = array[last];
+        array.pop_back();
+    });
+    --count;
+}
+
+uint32 ParticleStorage::RemoveDead(bool keepOrder)
+{
+    if (keepOrder)
+    {
+        uint32 firstDead = 0;
+        while (firstDead < count && life[firstDead] < lifeTime[firstDead])
+        {
+            ++firstDead;
+        }
+        if (firstDead == count)
+        {
+            return 0;
+        }
+
+        aliveIndices.clear();
+        for (uint32 i = firstDead + 1; i < count; ++i)
+        {
+            if (life[i] < lifeTime[i])
+            {
+                aliveIndices.push_back(i);
+            }
+        }
+
+        uint32 newCount = firstDead + static_cast<uint32>(aliveIndices.size());
+        ForEachArray([this, firstDead, newCount](auto& array) {
+            uint32 dst = firstDead;
+            for (uint32 src : aliveIndices)
+            {
+                array[dst++] = array[src];
+            }
+            array.erase(array.begin() + newCount, array.end());
+        });
+
+        uint32 removed = count - newCount;
+        count = newCount;
+        return removed;
+    }
+
+    uint32 removed = 0;
+    uint32 i = 0;
+    while (i < count)
+    {
+        if (life[i] >= lifeTime[i])
+        {
+            Remove(i); // last particle takes this index, check it on next iteration
+            ++removed;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    return removed;
+}
+
+void ParticleStorage::Clear()
+{
+    ForEachArray([](auto& array) {
+        array.clear();
+    });
+    count = 0;
+}
+
+void ParticleStorage::AddLife(float32 dt)
+{
+    ParticleStorageDetails::AddScaled(life.data(), 1.0f, nullptr, dt, count);
+}
+
+void ParticleStorage::ComputeOverLife(float32* overLife) const
+{
+    const float32* l = life.data();
+    const float32* lt = lifeTime.data();
+    uint32 i = 0;
+#if defined(DAVA_PARTICLES_SSE)
+    for (; i + ParticleStorageDetails::SIMD_WIDTH <= count; i += ParticleStorageDetails::SIMD_WIDTH)
+        _mm_storeu_ps(overLife + i, _mm_div_ps(_mm_loadu_ps(l + i), _mm_loadu_ps(lt + i)));
+#endif
+    // NEON has no precise vector division on armv7, scalar loop is auto-vectorized on arm64
+    for (; i < count; ++i)
+        overLife[i] = l[i] / lt[i];
+}
+
+void ParticleStorage::IntegratePositions(const float32* velocityScale, float32 dt)
+{
+    ParticleStorageDetails::MultiplyAdd(positionX.data(), speedX.data(), velocityScale, dt, count);
+    ParticleStorageDetails::MultiplyAdd(positionY.data(), speedY.data(), velocityScale, dt, count);
+    ParticleStorageDetails::MultiplyAdd(positionZ.data(), speedZ.data(), velocityScale, dt, count);
+}
+
+void ParticleStorage::IntegrateAngles(const float32* spinScale, float32 dt)
+{
+    ParticleStorageDetails::MultiplyAdd(angle.data(), spin.data(), spinScale, dt, count);
+}
+
+void ParticleStorage::Accelerate(const Vector3& acceleration, const float32* accelerationScale, float32 dt)
+{
+    ParticleStorageDetails::AddScaled(speedX.data(), acceleration.x, accelerationScale, dt, count);
+    ParticleStorageDetails::AddScaled(speedY.data(), acceleration.y, accelerationScale, dt, count);
+    ParticleStorageDetails::AddScaled(speedZ.data(), acceleration.z, accelerationScale, dt, count);
+}
+
+void ParticleStorage::AddToBBox(const Vector3& offset, AABBox3& bbox) const
+{
+    if (count == 0)
+        return;
+
+    Vector3 minPoint;
+    Vector3 maxPoint;
+    ParticleStorageDetails::MinMax(positionX.data(), currRadius.data(), count, minPoint.x, maxPoint.x);
+    ParticleStorageDetails::MinMax(positionY.data(), currRadius.data(), count, minPoint.y, maxPoint.y);
+    ParticleStorageDetails::MinMax(positionZ.data(), currRadius.data(), count, minPoint.z, maxPoint.z);
+    bbox.AddPoint(minPoint + offset);
+    bbox.AddPoint(maxPoint + offset);
+}
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+
+namespace DAVA
+{
+/**
+    \brief Particles of one ParticleGroup stored as structure of arrays.
+    Particle is addressed by index in [0, GetCount()), new particles are appended to the end.
+    `Remove` moves the last particle into place of removed one, so indices are not stable across removals.
+    `RemoveDead` can keep order of remaining particles, which is draw order of the group (see ParticleLayer::NeedsOrderedParticles).
+    Bulk update kernels process whole arrays and use SSE or NEON where available.
+*/
+class ParticleStorage
+{
+public:
+    uint32 GetCount() const;
+    bool IsEmpty() const;
+
+    /** Append particle with all attributes zeroed (color is white) and return its index. */
+    uint32 Add();
+    /** Remove particle by moving the last particle into its place. */
+    void Remove(uint32 index);
+    /**
+        Remove particles with life >= lifeTime. Return number of removed particles.
+        With `keepOrder` remaining particles are compacted in order, otherwise the last particles take places of removed ones.
+    */
+    uint32 RemoveDead(bool keepOrder);
+    void Clear();
+
+    Vector3 GetPosition(uint32 index) const;
+    void SetPosition(uint32 index, const Vector3& position);
+    Vector3 GetSpeed(uint32 index) const;
+    void SetSpeed(uint32 index, const Vector3& speed);
+    void Kill(uint32 index);
+
+    /** life += dt for every particle. */
+    void AddLife(float32 dt);
+    /** overLife[i] = life[i] / lifeTime[i]. `overLife` must hold GetCount() values. */
+    void ComputeOverLife(float32* overLife) const;
+    /** position += speed * velocityScale[i] * dt. Null `velocityScale` means 1 for every particle. */
+    void IntegratePositions(const float32* velocityScale, float32 dt);
+    /** angle += spin * spinScale[i] * dt. Null `spinScale` means 1 for every particle. */
+    void IntegrateAngles(const float32* spinScale, float32 dt);
+    /** speed += acceleration * accelerationScale[i] * dt. Null `accelerationScale` means 1 for every particle. */
+    void Accelerate(const Vector3& acceleration, const float32* accelerationScale, float32 dt);
+    /** Extend `bbox` by spheres of currRadius around (position + offset) of every particle. */
+    void AddToBBox(const Vector3& offset, AABBox3& bbox) const;
+
+    Vector<float32> positionX;
+    Vector<float32> positionY;
+    Vector<float32> positionZ;
+    Vector<float32> speedX;
+    Vector<float32> speedY;
+    Vector<float32> speedZ;
+
+    Vector<float32> life;
+    Vector<float32> lifeTime;
+
+    Vector<float32> angle;
+    Vector<float32> spin;
+
+    Vector<int32> frame;
+    Vector<float32> animTime;
+
+    Vector<float32> baseFlowSpeed;
+    Vector<float32> currFlowSpeed;
+    Vector<float32> baseFlowOffset;
+    Vector<float32> currFlowOffset;
+
+    Vector<float32> baseNoiseScale;
+    Vector<float32> currNoiseScale;
+    Vector<float32> baseNoiseUScrollSpeed;
+    Vector<float32> currNoiseUOffset;
+    Vector<float32> baseNoiseVScrollSpeed;
+    Vector<float32> currNoiseVOffset;
+
+    Vector<float32> currRadius; //for bbox computation
+    Vector<float32> alphaRemap;
+    Vector<Vector2> baseSize;
+    Vector<Vector2> currSize;
+
+    Vector<Color> color;
+
+    Vector<int32> positionTarget; //superemitter particles only
+    Vector<uint32> seed; //stable per particle random value, used by forces instead of particle index
+
+private:
+    template <typename Fn>
+    void ForEachArray(Fn&& fn);
+
+    Vector<uint32> aliveIndices; //scratch for ordered compaction
+    uint32 count = 0;
+};
+
+inline uint32 ParticleStorage::GetCount() const
+{
+    return count;
+}
+
+inline bool ParticleStorage::IsEmpty() const
+{
+    return count == 0;
+}
+
+inline Vector3 ParticleStorage::GetPosition(uint32 index) const
+{
+    return Vector3(positionX[index], positionY[index], positionZ[index]);
+}
+
+inline void ParticleStorage::SetPosition(uint32 index, const Vector3& position)
+{
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+}
+
+inline Vector3 ParticleStorage::GetSpeed(uint32 index) const
+{
+    return Vector3(speedX[index], speedY[index], speedZ[index]);
+}
+
+inline void ParticleStorage::SetSpeed(uint32 index, const Vector3& speed)
+{
+    speedX[index] = speed.x;
+    speedY[index] = speed.y;
+    speedZ[index] = speed.z;
+}
+
+inline void ParticleStorage::Kill(uint32 index)
+{
+    life[index] = lifeTime[index] + 0.1f;
+}
+}
@@ -25,8 +25,12 @@ namespace
 {
 const bool virtualToPhysicalTransformEnabledDefaultValue = true;
 
-const uint32 MAX_VERTICES = 1024;
-const uint32 MAX_INDECES = MAX_VERTICES * 2;
+// indices are 16-bit and relative to packet base vertex, so packet can't address more than 64k vertices,
+// but in practice packet is limited by dynamic buffer page (see MaxPacketVertices/MaxPacketIndices)
+const uint32 MAX_INDEXED_VERTICES = 0x10000;
+// dynamic buffer space reserved for new packet, packet grows up to it without flush
+const uint32 BATCH_VERTICES_RESERVE = 4096;
+const uint32 BATCH_INDICES_RESERVE = BATCH_VERTICES_RESERVE * 2;
 const float32 SEGMENT_LENGTH = 15.0f;
 }
 
@@ -127,9 +131,6 @@ void RenderSystem2D::Init()
     lastUsedCustomWorldMatrix = false;
     lastCustomWorldMatrix = Matrix4::IDENTITY;
     lastClip = Rect(0, 0, -1, -1);
-
-    currentVertexBuffer.reserve(MAX_VERTICES * VBO_STRIDE[1]);
-    currentIndexBuffer.reserve(MAX_INDECES);
 }
 
 RenderSystem2D::~RenderSystem2D()
@@ -246,6 +247,7 @@ void RenderSystem2D::BeginRenderTargetPass(const RenderTargetPassDescriptor& des
     DVASSERT(!IsRenderTargetPass());
 
     Flush();
+    InvalidateStaticBatch();
 
     renderPassTargetDescriptor = desc;
 
@@ -293,6 +295,7 @@ void RenderSystem2D::EndRenderTargetPass()
 void RenderSystem2D::SetViewMatrix(const Matrix4& _viewMatrix)
 {
     Flush();
+    InvalidateStaticBatch();
 
     viewMatrix = _viewMatrix;
     viewMatrixSemantic += 8; //cause the same as at Setup2DMatrices()
@@ -498,26 +501,22 @@ void RenderSystem2D::Flush()
         return;
     }
 
-    DynamicBufferAllocator::AllocResultVB vertexBuffer = DynamicBufferAllocator::AllocateVertexBuffer(GetVBOStride(currentTexcoordStreamCount), vertexIndex);
-    DynamicBufferAllocator::AllocResultIB indexBuffer = DynamicBufferAllocator::AllocateIndexBuffer(indexIndex);
-    DVASSERT(vertexBuffer.allocatedVertices == vertexIndex);
-    DVASSERT(indexBuffer.allocatedindices == indexIndex);
-    Memcpy(vertexBuffer.data, currentVertexBuffer.data(), GetVBOStride(currentTexcoordStreamCount) * vertexIndex);
-    Memcpy(indexBuffer.data, currentIndexBuffer.data(), indexIndex * 2);
+    DynamicBufferAllocator::TrimVertexBuffer(batchVertexBuffer, GetVBOStride(currentTexcoordStreamCount), vertexIndex);
+    DynamicBufferAllocator::TrimIndexBuffer(batchIndexBuffer, indexIndex);
 
-    currentPacket.vertexStream[0] = vertexBuffer.buffer;
-    currentPacket.vertexCount = vertexBuffer.allocatedVertices;
-    currentPacket.baseVertex = vertexBuffer.baseVertex;
-    currentPacket.indexBuffer = indexBuffer.buffer;
-    currentPacket.startIndex = indexBuffer.baseIndex;
+    currentPacket.vertexStream[0] = batchVertexBuffer.buffer;
+    currentPacket.vertexCount = vertexIndex;
+    currentPacket.baseVertex = batchVertexBuffer.baseVertex;
+    currentPacket.indexBuffer = batchIndexBuffer.buffer;
+    currentPacket.startIndex = batchIndexBuffer.baseIndex;
 
     if (currentPacketListHandle != rhi::InvalidHandle && currentPacket.primitiveCount > 0)
     {
         AddPacket(currentPacket);
     }
 
-    currentVertexBuffer.clear();
-    currentIndexBuffer.clear();
+    batchVertexBuffer = {};
+    batchIndexBuffer = {};
 
     currentPacket.vertexStream[0] = rhi::HVertexBuffer();
     currentPacket.vertexCount = 0;
@@ -538,6 +537,9 @@ void RenderSystem2D::DrawPacket(rhi::Packet& packet)
         return;
     }
     Flush();
+
+    // packet is built by caller, so it can't be replayed
+    InvalidateStaticBatch();
     if (currentClip.dx > 0.f && currentClip.dy > 0.f)
     {
         const Rect& transformedClipRect = TransformClipRect(currentClip, currentVirtualToPhysicalMatrix);
@@ -581,90 +583,16 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     ++Renderer::GetRenderStats().batches2d;
 #endif
     uint32 trimmedTexCoordCount = Max(batchDesc.texCoordCount, 1u); //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
-    if ((vertexIndex + batchDesc.vertexCount > MAX_VERTICES) || (indexIndex + batchDesc.indexCount > MAX_INDECES) || (trimmedTexCoordCount != currentTexcoordStreamCount))
+    if (batchDesc.vertexCount > MaxPacketVertices(trimmedTexCoordCount) || batchDesc.indexCount > MaxPacketIndices())
     {
-        // Buffer overflow or format changed. Switch to next VBO.
-        Flush();
-        currentTexcoordStreamCount = trimmedTexCoordCount;
-        currentPacket.vertexLayoutUID = GetVertexLayoutId(currentTexcoordStreamCount);
-
-        // TODO: Make draw for big buffers (bigger than buffers in pool)
-        // Draw immediately if batch is too big to buffer
-        if (batchDesc.vertexCount > MAX_VERTICES || batchDesc.indexCount > MAX_INDECES)
-        {
-            if (((prevFrameErrorsFlags & BUFFER_OVERFLOW_ERROR) != BUFFER_OVERFLOW_ERROR))
-            {
-                Logger::Warning("PushBatch: Too much vertices (%d of %d)! Direct draw.", batchDesc.vertexCount, MAX_VERTICES);
-            }
-            currFrameErrorsFlags |= BUFFER_OVERFLOW_ERROR;
-        }
-    }
-
-    // Begin check world matrix
-    bool needUpdateWorldMatrix = false;
-    bool useCustomWorldMatrix = batchDesc.worldMatrix != nullptr;
-    if (!useCustomWorldMatrix && !lastUsedCustomWorldMatrix) // Equal and False
-    {
-        // Skip check world matrices. Use Matrix4::IDENTITY. (the most frequent option)
-    }
-    else if (useCustomWorldMatrix && lastUsedCustomWorldMatrix) // Equal and True
-    {
-        if (lastCustomWorldMatrix != *batchDesc.worldMatrix) // Update only if matrices not equal
-        {
-            needUpdateWorldMatrix = true;
-            lastCustomWorldMatrix = *batchDesc.worldMatrix;
-        }
-    }
-    else // Not equal
-    {
-        needUpdateWorldMatrix = true;
-        if (useCustomWorldMatrix)
-        {
-            lastCustomWorldMatrix = *batchDesc.worldMatrix;
-        }
+        PushSplitBatch(batchDesc, trimmedTexCoordCount);
+        return;
     }
-    // End check world matrix
 
-    // Begin new packet
-    if (currentPacket.textureSet != batchDesc.textureSetHandle || currentPacket.primitiveType != batchDesc.primitiveType || lastMaterial != batchDesc.material || lastClip != currentClip || needUpdateWorldMatrix)
+    if (!PrepareBatch(trimmedTexCoordCount, batchDesc.vertexCount, batchDesc.indexCount, batchDesc.material, batchDesc.textureSetHandle, batchDesc.samplerStateHandle, batchDesc.primitiveType, batchDesc.worldMatrix))
     {
-        Flush();
-        if (useCustomWorldMatrix)
-        {
-            Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &lastCustomWorldMatrix, DynamicBindings::UPDATE_SEMANTIC_ALWAYS);
-        }
-        else
-        {
-            Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &Matrix4::IDENTITY, reinterpret_cast<pointer_size>(&Matrix4::IDENTITY));
-        }
-        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_PROJ, &projMatrix, static_cast<pointer_size>(projMatrixSemantic));
-        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_VIEW, &viewMatrix, static_cast<pointer_size>(viewMatrixSemantic));
-        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_GLOBAL_TIME, &globalTime, reinterpret_cast<pointer_size>(&globalTime));
-
-        if (currentClip.dx > 0.f && currentClip.dy > 0.f)
-        {
-            const Rect& transformedClipRect = TransformClipRect(currentClip, currentVirtualToPhysicalMatrix);
-            currentPacket.scissorRect.x = static_cast<int16>(std::floor(transformedClipRect.x));
-            currentPacket.scissorRect.y = static_cast<int16>(std::floor(transformedClipRect.y));
-            currentPacket.scissorRect.width = static_cast<int16>(std::ceil(transformedClipRect.dx));
-            currentPacket.scissorRect.height = static_cast<int16>(std::ceil(transformedClipRect.dy));
-            currentPacket.options |= rhi::Packet::OPT_OVERRIDE_SCISSOR;
-        }
-        else
-        {
-            currentPacket.options &= ~rhi::Packet::OPT_OVERRIDE_SCISSOR;
-        }
-        lastClip = currentClip;
-
-        currentPacket.primitiveType = batchDesc.primitiveType;
-
-        DVASSERT(batchDesc.material);
-        lastMaterial = batchDesc.material;
-        lastMaterial->BindParams(currentPacket);
-        currentPacket.textureSet = batchDesc.textureSetHandle;
-        currentPacket.samplerState = batchDesc.samplerStateHandle;
+        return;
     }
-    // End new packet
 
     // Begin define draw color
     Color useColor = batchDesc.singleColor;
@@ -707,12 +635,12 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     };
 
     uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
-    currentVertexBuffer.resize(vertexStride * (vertexIndex + batchDesc.vertexCount));
-    currentIndexBuffer.resize(indexIndex + batchDesc.indexCount);
+    uint8* vertexData = batchVertexBuffer.data + vertexStride * vertexIndex;
+    uint16* indexData = batchIndexBuffer.data + indexIndex;
 
     for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
     {
-        BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+        BatchVertex& v = *OffsetPointer<BatchVertex>(vertexData, vertexStride * i);
         v.pos.x = batchDesc.vertexPointer[i * batchDesc.vertexStride];
         v.pos.y = batchDesc.vertexPointer[i * batchDesc.vertexStride + 1];
         //TODO: rethink do we still require z in rhi?
@@ -727,34 +655,357 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
         {
             DVASSERT(batchDesc.texCoordPointer[texStream] != nullptr);
-            BatchVertex& v = *OffsetPointer<BatchVertex>(currentVertexBuffer.data(), vertexStride * (vertexIndex + i));
+            BatchVertex& v = *OffsetPointer<BatchVertex>(vertexData, vertexStride * i);
             v.uv_ext[texStream - 1].x = batchDesc.texCoordPointer[texStream][i * texStride];
             v.uv_ext[texStream - 1].y = batchDesc.texCoordPointer[texStream][i * texStride + 1];
         }
     }
 
-    uint32 ii = indexIndex;
     for (uint32 i = 0; i < batchDesc.indexCount; ++i)
     {
-        currentIndexBuffer[ii++] = vertexIndex + batchDesc.indexPointer[i];
+        indexData[i] = vertexIndex + batchDesc.indexPointer[i];
     }
     // End fill vertex and index buffers
 
+    if (recordingStaticBatch != nullptr)
+    {
+        RecordStaticBatch(batchDesc, vertexData);
+    }
+
+    CommitBatch(batchDesc.vertexCount, batchDesc.indexCount);
+}
+
+uint32 RenderSystem2D::MaxPacketVertices(uint32 texCoordStreamCount)
+{
+    return Min(MAX_INDEXED_VERTICES, DynamicBufferAllocator::GetPageSize() / GetVBOStride(texCoordStreamCount));
+}
+
+uint32 RenderSystem2D::MaxPacketIndices()
+{
+    return DynamicBufferAllocator::GetPageSize() / static_cast<uint32>(sizeof(uint16));
+}
+
+void RenderSystem2D::PushSplitBatch(const BatchDescriptor2D& batchDesc, uint32 texCoordStreamCount)
+{
+    const uint32 maxVertices = MaxPacketVertices(texCoordStreamCount);
+    const uint32 maxIndices = MaxPacketIndices();
+    const bool isStrip = (batchDesc.primitiveType == rhi::PRIMITIVE_TRIANGLESTRIP);
+    const uint32 primitiveSize = (batchDesc.primitiveType == rhi::PRIMITIVE_LINELIST) ? 2 : 3;
+
+    // each part references only vertices it uses, so it is pushed as separate batch with compacted vertex data
+    const uint16 NOT_MAPPED = 0xFFFF;
+    Vector<uint16> remap(batchDesc.vertexCount, NOT_MAPPED);
+    Vector<uint32> partVertices;
+    Vector<uint16> partIndices;
+    Vector<float32> positions;
+    Array<Vector<float32>, BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT> texCoords;
+    Vector<uint32> colors;
+
+    auto pushPart = [&]() {
+        uint32 partVertexCount = static_cast<uint32>(partVertices.size());
+        positions.resize(partVertexCount * 2);
+        if (batchDesc.colorPointer != nullptr)
+        {
+            colors.resize(partVertexCount);
+        }
+
+        BatchDescriptor2D part = batchDesc;
+        for (uint32 texStream = 0; texStream < batchDesc.texCoordCount; ++texStream)
+        {
+            if (batchDesc.texCoordPointer[texStream] != nullptr)
+            {
+                texCoords[texStream].resize(partVertexCount * 2);
+                part.texCoordPointer[texStream] = texCoords[texStream].data();
+            }
+        }
+
+        for (uint32 i = 0; i < partVertexCount; ++i)
+        {
+            uint32 src = partVertices[i];
+            positions[i * 2] = batchDesc.vertexPointer[src * batchDesc.vertexStride];
+            positions[i * 2 + 1] = batchDesc.vertexPointer[src * batchDesc.vertexStride + 1];
+            for (uint32 texStream = 0; texStream < batchDesc.texCoordCount; ++texStream)
+            {
+                if (batchDesc.texCoordPointer[texStream] != nullptr)
+                {
+                    texCoords[texStream][i * 2] = batchDesc.texCoordPointer[texStream][src * batchDesc.texCoordStride];
+                    texCoords[texStream][i * 2 + 1] = batchDesc.texCoordPointer[texStream][src * batchDesc.texCoordStride + 1];
+                }
+            }
+            if (batchDesc.colorPointer != nullptr)
+            {
+                colors[i] = batchDesc.colorPointer[src * batchDesc.colorStride];
+            }
+            remap[src] = NOT_MAPPED;
+        }
+
+        part.vertexCount = partVertexCount;
+        part.vertexPointer = positions.data();
+        part.vertexStride = 2;
+        part.texCoordStride = 2;
+        part.colorPointer = (batchDesc.colorPointer != nullptr) ? colors.data() : nullptr;
+        part.colorStride = 1;
+        part.indexCount = static_cast<uint32>(partIndices.size());
+        part.indexPointer = partIndices.data();
+        PushBatch(part);
+
+        partVertices.clear();
+        partIndices.clear();
+    };
+
+    auto addIndex = [&](uint16 index) {
+        if (remap[index] == NOT_MAPPED)
+        {
+            remap[index] = static_cast<uint16>(partVertices.size());
+            partVertices.push_back(index);
+        }
+        partIndices.push_back(remap[index]);
+    };
+
+    if (isStrip)
+    {
+        // strip is cut into overlapping parts, each part starts at even triangle to keep winding
+        uint32 partLength = Min(maxVertices, maxIndices);
+        partLength -= (partLength % 2);
+        for (uint32 start = 0; start + 2 < batchDesc.indexCount; start += partLength - 2)
+        {
+            uint32 end = Min(start + partLength, batchDesc.indexCount);
+            for (uint32 i = start; i < end; ++i)
+            {
+                addIndex(batchDesc.indexPointer[i]);
+            }
+            pushPart();
+        }
+    }
+    else
+    {
+        for (uint32 i = 0; i + primitiveSize <= batchDesc.indexCount; i += primitiveSize)
+        {
+            if (partVertices.size() + primitiveSize > maxVertices || partIndices.size() + primitiveSize > maxIndices)
+            {
+                pushPart();
+            }
+            for (uint32 k = 0; k < primitiveSize; ++k)
+            {
+                addIndex(batchDesc.indexPointer[i + k]);
+            }
+        }
+        if (!partIndices.empty())
+        {
+            pushPart();
+        }
+    }
+}
+
+bool RenderSystem2D::PrepareBatch(uint32 texCoordStreamCount, uint32 vertexCount, uint32 indexCount,
+                                  NMaterial* material, rhi::HTextureSet textureSet, rhi::HSamplerState samplerState, rhi::PrimitiveType primitiveType, const Matrix4* worldMatrix)
+{
+    if ((vertexIndex + vertexCount > batchVertexBuffer.allocatedVertices) || (indexIndex + indexCount > batchIndexBuffer.allocatedindices) || (texCoordStreamCount != currentTexcoordStreamCount))
+    {
+        // Buffer overflow or format changed. Switch to next VBO.
+        Flush();
+        currentTexcoordStreamCount = texCoordStreamCount;
+        currentPacket.vertexLayoutUID = GetVertexLayoutId(currentTexcoordStreamCount);
+    }
+
+    // Begin check world matrix
+    bool needUpdateWorldMatrix = false;
+    bool useCustomWorldMatrix = worldMatrix != nullptr;
+    if (!useCustomWorldMatrix && !lastUsedCustomWorldMatrix) // Equal and False
+    {
+        // Skip check world matrices. Use Matrix4::IDENTITY. (the most frequent option)
+    }
+    else if (useCustomWorldMatrix && lastUsedCustomWorldMatrix) // Equal and True
+    {
+        if (lastCustomWorldMatrix != *worldMatrix) // Update only if matrices not equal
+        {
+            needUpdateWorldMatrix = true;
+            lastCustomWorldMatrix = *worldMatrix;
+        }
+    }
+    else // Not equal
+    {
+        needUpdateWorldMatrix = true;
+        if (useCustomWorldMatrix)
+        {
+            lastCustomWorldMatrix = *worldMatrix;
+        }
+    }
+    // End check world matrix
+
+    // Begin new packet
+    if (currentPacket.textureSet != textureSet || currentPacket.primitiveType != primitiveType || lastMaterial != material || lastClip != currentClip || needUpdateWorldMatrix)
+    {
+        Flush();
+        if (useCustomWorldMatrix)
+        {
+            Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &lastCustomWorldMatrix, DynamicBindings::UPDATE_SEMANTIC_ALWAYS);
+        }
+        else
+        {
+            Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &Matrix4::IDENTITY, reinterpret_cast<pointer_size>(&Matrix4::IDENTITY));
+        }
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_PROJ, &projMatrix, static_cast<pointer_size>(projMatrixSemantic));
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_VIEW, &viewMatrix, static_cast<pointer_size>(viewMatrixSemantic));
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_GLOBAL_TIME, &globalTime, reinterpret_cast<pointer_size>(&globalTime));
+
+        if (currentClip.dx > 0.f && currentClip.dy > 0.f)
+        {
+            const Rect& transformedClipRect = TransformClipRect(currentClip, currentVirtualToPhysicalMatrix);
+            currentPacket.scissorRect.x = static_cast<int16>(std::floor(transformedClipRect.x));
+            currentPacket.scissorRect.y = static_cast<int16>(std::floor(transformedClipRect.y));
+            currentPacket.scissorRect.width = static_cast<int16>(std::ceil(transformedClipRect.dx));
+            currentPacket.scissorRect.height = static_cast<int16>(std::ceil(transformedClipRect.dy));
+            currentPacket.options |= rhi::Packet::OPT_OVERRIDE_SCISSOR;
+        }
+        else
+        {
+            currentPacket.options &= ~rhi::Packet::OPT_OVERRIDE_SCISSOR;
+        }
+        lastClip = currentClip;
+
+        currentPacket.primitiveType = primitiveType;
+
+        DVASSERT(material);
+        lastMaterial = material;
+        lastMaterial->BindParams(currentPacket);
+        currentPacket.textureSet = textureSet;
+        currentPacket.samplerState = samplerState;
+    }
+    // End new packet
+
+    // Begin allocate packet buffers
+    if (batchVertexBuffer.allocatedVertices == 0)
+    {
+        bool fits = (vertexCount <= MaxPacketVertices(currentTexcoordStreamCount)) && (indexCount <= MaxPacketIndices());
+        if (fits)
+        {
+            uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
+            batchVertexBuffer = DynamicBufferAllocator::AllocateVertexBuffer(vertexStride, Max(vertexCount, BATCH_VERTICES_RESERVE));
+            batchIndexBuffer = DynamicBufferAllocator::AllocateIndexBuffer(Max(indexCount, BATCH_INDICES_RESERVE));
+
+            // allocator returns less than requested if it doesn't fit into buffer page
+            fits = (batchVertexBuffer.allocatedVertices >= vertexCount) && (batchIndexBuffer.allocatedindices >= indexCount);
+            if (!fits)
+            {
+                DynamicBufferAllocator::TrimVertexBuffer(batchVertexBuffer, vertexStride, 0);
+                DynamicBufferAllocator::TrimIndexBuffer(batchIndexBuffer, 0);
+                batchVertexBuffer = {};
+                batchIndexBuffer = {};
+            }
+        }
+
+        if (!fits)
+        {
+            if (((prevFrameErrorsFlags & BUFFER_OVERFLOW_ERROR) != BUFFER_OVERFLOW_ERROR))
+            {
+                Logger::Warning("PushBatch: Too much vertices (%d vertices, %d indices)! Batch is skipped.", vertexCount, indexCount);
+            }
+            currFrameErrorsFlags |= BUFFER_OVERFLOW_ERROR;
+            return false;
+        }
+    }
+    // End allocate packet buffers
+
+    return true;
+}
+
+void RenderSystem2D::CommitBatch(uint32 vertexCount, uint32 indexCount)
+{
     switch (currentPacket.primitiveType)
     {
     case rhi::PRIMITIVE_LINELIST:
-        currentPacket.primitiveCount += batchDesc.indexCount / 2;
+        currentPacket.primitiveCount += indexCount / 2;
         break;
     case rhi::PRIMITIVE_TRIANGLELIST:
-        currentPacket.primitiveCount += batchDesc.indexCount / 3;
+        currentPacket.primitiveCount += indexCount / 3;
         break;
     case rhi::PRIMITIVE_TRIANGLESTRIP:
-        currentPacket.primitiveCount += batchDesc.indexCount - 2;
+        currentPacket.primitiveCount += indexCount - 2;
         break;
     }
 
-    indexIndex += batchDesc.indexCount;
-    vertexIndex += batchDesc.vertexCount;
+    indexIndex += indexCount;
+    vertexIndex += vertexCount;
+}
+
+void RenderSystem2D::BeginStaticBatch(StaticBatch2D* staticBatch)
+{
+    DVASSERT(recordingStaticBatch == nullptr);
+    DVASSERT(staticBatch != nullptr);
+
+    staticBatch->Clear();
+    staticBatch->valid = true;
+    recordingStaticBatch = staticBatch;
+}
+
+void RenderSystem2D::EndStaticBatch()
+{
+    DVASSERT(recordingStaticBatch != nullptr);
+    recordingStaticBatch = nullptr;
+}
+
+void RenderSystem2D::InvalidateStaticBatch()
+{
+    if (recordingStaticBatch != nullptr)
+    {
+        recordingStaticBatch->valid = false;
+    }
+}
+
+void RenderSystem2D::RecordStaticBatch(const BatchDescriptor2D& batchDesc, const uint8* vertexData)
+{
+    StaticBatch2D::Batch batch;
+    batch.material = SafeRetain(batchDesc.material);
+    batch.textureSet = rhi::CopyTextureSet(batchDesc.textureSetHandle);
+    batch.samplerState = rhi::CopySamplerState(batchDesc.samplerStateHandle);
+    batch.primitiveType = batchDesc.primitiveType;
+    batch.clip = currentClip;
+    batch.useWorldMatrix = (batchDesc.worldMatrix != nullptr);
+    batch.worldMatrix = batch.useWorldMatrix ? *batchDesc.worldMatrix : Matrix4::IDENTITY;
+    batch.texCoordStreamCount = currentTexcoordStreamCount;
+
+    uint32 vertexDataSize = GetVBOStride(currentTexcoordStreamCount) * batchDesc.vertexCount;
+    batch.vertexOffset = static_cast<uint32>(recordingStaticBatch->vertices.size());
+    batch.vertexCount = batchDesc.vertexCount;
+    recordingStaticBatch->vertices.insert(recordingStaticBatch->vertices.end(), vertexData, vertexData + vertexDataSize);
+
+    batch.indexOffset = static_cast<uint32>(recordingStaticBatch->indices.size());
+    batch.indexCount = batchDesc.indexCount;
+    recordingStaticBatch->indices.insert(recordingStaticBatch->indices.end(), batchDesc.indexPointer, batchDesc.indexPointer + batchDesc.indexCount);
+
+    recordingStaticBatch->batches.push_back(batch);
+}
+
+void RenderSystem2D::DrawStaticBatch(const StaticBatch2D* staticBatch)
+{
+    DVASSERT(staticBatch->IsValid());
+
+    Rect clip = currentClip;
+    for (const StaticBatch2D::Batch& batch : staticBatch->batches)
+    {
+#if defined(__DAVAENGINE_RENDERSTATS__)
+        ++Renderer::GetRenderStats().batches2d;
+#endif
+        currentClip = batch.clip;
+        if (!PrepareBatch(batch.texCoordStreamCount, batch.vertexCount, batch.indexCount, batch.material, batch.textureSet, batch.samplerState, batch.primitiveType, batch.useWorldMatrix ? &batch.worldMatrix : nullptr))
+        {
+            continue;
+        }
+
+        uint32 vertexStride = GetVBOStride(currentTexcoordStreamCount);
+        Memcpy(batchVertexBuffer.data + vertexStride * vertexIndex, staticBatch->vertices.data() + batch.vertexOffset, vertexStride * batch.vertexCount);
+
+        uint16* indexData = batchIndexBuffer.data + indexIndex;
+        const uint16* srcIndexData = staticBatch->indices.data() + batch.indexOffset;
+        for (uint32 i = 0; i < batch.indexCount; ++i)
+        {
+            indexData[i] = vertexIndex + srcIndexData[i];
+        }
+
+        CommitBatch(batch.vertexCount, batch.indexCount);
+    }
+    currentClip = clip;
 }
 
 void RenderSystem2D::Draw(Sprite* sprite, SpriteDrawState* drawState, const Color& color)
@@ -1810,7 +2061,7 @@ void TiledDrawData::GenerateTileData()
     GenerateAxisData(size.y, sprite->GetRectOffsetValueForFrame(frame, Sprite::ACTIVE_HEIGHT),
                      GetEngineContext()->uiControlSystem->vcs->ConvertResourceToVirtualY(float32(texture->GetHeight()), sprite->GetResourceSizeIndex()), stretchCap.y, cellsHeight);
 
-    uint32 vertexLimitPerUnit = MAX_VERTICES - (MAX_VERTICES % 4); // Round for 4 vertexes
+    uint32 vertexLimitPerUnit = BATCH_VERTICES_RESERVE - (BATCH_VERTICES_RESERVE % 4); // Round for 4 vertexes
     uint32 indexLimitPerUnit = vertexLimitPerUnit / 4 * 6;
     uint32 vertexTotalCount = static_cast<uint32>(4 * cellsHeight.size() * cellsWidth.size());
     uint32 indexTotalCount = static_cast<uint32>(6 * cellsHeight.size() * cellsWidth.size());
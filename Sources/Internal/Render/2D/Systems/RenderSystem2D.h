@@ -5,6 +5,8 @@
 #include "Functional/Function.h"
 #include "Render/2D/Sprite.h"
 #include "Render/2D/Systems/BatchDescriptor2D.h"
+#include "Render/2D/Systems/StaticBatch2D.h"
+#include "Render/DynamicBufferAllocator.h"
 #include "Render/RenderBase.h"
 
 namespace DAVA
@@ -176,6 +178,21 @@ public:
 
     void PushBatch(const BatchDescriptor2D& batchDesc);
 
+    /**
+     * Record batches pushed till EndStaticBatch into staticBatch (they are still drawn as usual).
+     * Recorded geometry can be drawn again by DrawStaticBatch while source content stays unchanged.
+     */
+    void BeginStaticBatch(StaticBatch2D* staticBatch);
+    void EndStaticBatch();
+    bool IsRecordingStaticBatch() const;
+    void DrawStaticBatch(const StaticBatch2D* staticBatch);
+    /**
+     * Mark batch being recorded as not replayable.
+     * Must be called by anything drawn inside of recording which bypasses PushBatch or has side effects on draw
+     * (own render passes, native views positioned on draw), since replay skips it.
+     */
+    void InvalidateStaticBatch();
+
     /*
      *  note - it will flush currently batched!
      *  it will also modify packet to add current clip
@@ -193,6 +210,7 @@ public:
     void Flush();
 
     void SetClip(const Rect& rect);
+    const Rect& GetClip() const;
     void IntersectClipRect(const Rect& rect);
     void RemoveClip();
 
@@ -318,6 +336,14 @@ private:
 
     void AddPacket(rhi::Packet& packet);
 
+    bool PrepareBatch(uint32 texCoordStreamCount, uint32 vertexCount, uint32 indexCount,
+                      NMaterial* material, rhi::HTextureSet textureSet, rhi::HSamplerState samplerState, rhi::PrimitiveType primitiveType, const Matrix4* worldMatrix);
+    void CommitBatch(uint32 vertexCount, uint32 indexCount);
+    void PushSplitBatch(const BatchDescriptor2D& batchDesc, uint32 texCoordStreamCount);
+    uint32 MaxPacketVertices(uint32 texCoordStreamCount);
+    uint32 MaxPacketIndices();
+    void RecordStaticBatch(const BatchDescriptor2D& batchDesc, const uint8* vertexData);
+
     Rect TransformClipRect(const Rect& rect, const Matrix4& transformMatrix);
 
     inline bool IsRenderTargetPass()
@@ -359,8 +385,9 @@ private:
 
     bool spriteClipping = true;
 
-    Vector<uint8> currentVertexBuffer;
-    Vector<uint16> currentIndexBuffer;
+    // batch geometry is built right in dynamic buffers, unused tail is returned on Flush
+    DynamicBufferAllocator::AllocResultVB batchVertexBuffer = {};
+    DynamicBufferAllocator::AllocResultIB batchIndexBuffer = {};
     rhi::Packet currentPacket;
     uint32 currentTexcoordStreamCount = 1; //1 is for default draw
     uint32 currentIndexBase = 0;
@@ -372,6 +399,8 @@ private:
     bool lastUsedCustomWorldMatrix = false;
     float32 globalTime = 0.f;
 
+    StaticBatch2D* recordingStaticBatch = nullptr;
+
     uint32 VBO_STRIDE[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT + 1];
     uint32 vertexLayouts2d[BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT + 1];
 
@@ -399,6 +428,16 @@ inline void RenderSystem2D::SetHightlightControlsVerticesLimit(uint32 verticesCo
     highlightControlsVerticesLimit = verticesCount;
 }
 
+inline const Rect& RenderSystem2D::GetClip() const
+{
+    return currentClip;
+}
+
+inline bool RenderSystem2D::IsRecordingStaticBatch() const
+{
+    return recordingStaticBatch != nullptr;
+}
+
 inline uint32 RenderSystem2D::GetVertexLayoutId(uint32 texCoordStreamCount)
 {
     return vertexLayouts2d[texCoordStreamCount];
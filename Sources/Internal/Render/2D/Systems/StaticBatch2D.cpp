@@ -0,0 +1,25 @@
+#include "Render/2D/Systems/StaticBatch2D.h"
+#include "Render/Material/NMaterial.h"
+
+namespace DAVA
+{
+StaticBatch2D::~StaticBatch2D()
+{
+    Clear();
+}
+
+void StaticBatch2D::Clear()
+{
+    for (Batch& batch : batches)
+    {
+        SafeRelease(batch.material);
+        rhi::ReleaseTextureSet(batch.textureSet);
+        rhi::ReleaseSamplerState(batch.samplerState);
+    }
+
+    batches.clear();
+    vertices.clear();
+    indices.clear();
+    valid = false;
+}
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Matrix4.h"
+#include "Math/Rect.h"
+#include "Render/RHI/rhi_Public.h"
+
+namespace DAVA
+{
+class NMaterial;
+
+/**
+    Retained 2D geometry.
+    Batches pushed to RenderSystem2D between BeginStaticBatch and EndStaticBatch are stored in ready-to-draw vertex format,
+    so DrawStaticBatch draws them again without regenerating. Batch becomes invalid if recorded content can't be replayed
+    (direct packets, view matrix changes, render target passes or RenderSystem2D::InvalidateStaticBatch calls).
+*/
+class StaticBatch2D
+{
+public:
+    StaticBatch2D() = default;
+    ~StaticBatch2D();
+
+    StaticBatch2D(const StaticBatch2D&) = delete;
+    StaticBatch2D& operator=(const StaticBatch2D&) = delete;
+
+    void Clear();
+    bool IsValid() const;
+
+private:
+    friend class RenderSystem2D;
+
+    struct Batch
+    {
+        NMaterial* material = nullptr;
+        rhi::HTextureSet textureSet;
+        rhi::HSamplerState samplerState;
+        rhi::PrimitiveType primitiveType = rhi::PRIMITIVE_TRIANGLELIST;
+        Rect clip;
+        Matrix4 worldMatrix;
+        bool useWorldMatrix = false;
+        uint32 texCoordStreamCount = 1;
+        uint32 vertexOffset = 0;
+        uint32 vertexCount = 0;
+        uint32 indexOffset = 0;
+        uint32 indexCount = 0;
+    };
+
+    Vector<Batch> batches;
+    Vector<uint8> vertices;
+    Vector<uint16> indices;
+    bool valid = false;
+};
+
+inline bool StaticBatch2D::IsValid() const
+{
+    return valid;
+}
+}
@@ -76,7 +76,6 @@ TextBlock::TextBlock()
     : scale(1.f, 1.f)
     , cacheFinalSize(0.f, 0.f)
     , cacheTextSize(0.f, 0.f)
-    , cachedLayoutData({ TextBlockDetail::INVALID_VECTOR, TextBlockDetail::INVALID_WIDTH })
     , renderSize(1.f)
     , fontSize(14.f)
     , cacheDx(0)
@@ -103,6 +102,8 @@ TextBlock::TextBlock()
 
     textBlockRender = NULL;
     needPrepareInternal = false;
+
+    ResetCachedLayoutData();
 }
 
 TextBlock::TextBlock(const TextBlock& src)
@@ -113,6 +114,7 @@ TextBlock::TextBlock(const TextBlock& src)
     , cacheSpriteOffset(src.cacheSpriteOffset)
     , cacheTextSize(src.cacheTextSize)
     , cachedLayoutData(src.cachedLayoutData)
+    , nextCachedLayoutData(src.nextCachedLayoutData)
     , renderSize(src.renderSize)
     , fontSize(src.fontSize)
     , cacheDx(src.cacheDx)
@@ -365,18 +367,22 @@ Vector2 TextBlock::GetPreferredSizeForWidth(float32 width)
     if (!font)
         return Vector2();
 
-    if (!NeedCalculateCacheParams() &&
-        cachedLayoutData.size != INVALID_VECTOR &&
-        cachedLayoutData.width == width)
+    if (!NeedCalculateCacheParams())
     {
-        return cachedLayoutData.size;
+        for (const CachedLayoutData& data : cachedLayoutData)
+        {
+            if (data.size != INVALID_VECTOR && data.width == width)
+            {
+                return data.size;
+            }
+        }
     }
 
+    Vector2 size;
     if (requestedSize.dx < 0.0f && requestedSize.dy < 0.0f && fittingType == 0)
     {
         CalculateCacheParamsIfNeed();
-        cachedLayoutData.size = cacheTextSize;
-        cachedLayoutData.width = width;
+        size = cacheTextSize;
     }
     else
     {
@@ -386,11 +392,15 @@ Vector2 TextBlock::GetPreferredSizeForWidth(float32 width)
         clone->fittingType = 0;
         clone->CalculateCacheParams();
 
-        cachedLayoutData.size = clone->cacheTextSize;
-        cachedLayoutData.width = width;
+        size = clone->cacheTextSize;
     }
 
-    return cachedLayoutData.size;
+    CachedLayoutData& data = cachedLayoutData[nextCachedLayoutData];
+    data.size = size;
+    data.width = width;
+    nextCachedLayoutData = (nextCachedLayoutData + 1) % CACHED_LAYOUT_DATA_COUNT;
+
+    return size;
 }
 
 Sprite* TextBlock::GetSprite()
@@ -406,8 +416,7 @@ void TextBlock::NeedPrepare(Texture* texture /*=NULL*/)
 {
     needCalculateCacheParams = true;
     needPrepareInternal = true;
-    cachedLayoutData.size = TextBlockDetail::INVALID_VECTOR;
-    cachedLayoutData.width = TextBlockDetail::INVALID_WIDTH;
+    ResetCachedLayoutData();
 }
 
 void TextBlock::PrepareInternal()
@@ -1026,9 +1035,18 @@ void TextBlock::CalculateCacheParamsIfNeed()
     {
         needCalculateCacheParams = false;
         CalculateCacheParams();
-        cachedLayoutData.size = INVALID_VECTOR;
-        cachedLayoutData.width = INVALID_WIDTH;
+        ResetCachedLayoutData();
+    }
+}
+
+void TextBlock::ResetCachedLayoutData()
+{
+    for (CachedLayoutData& data : cachedLayoutData)
+    {
+        data.size = TextBlockDetail::INVALID_VECTOR;
+        data.width = TextBlockDetail::INVALID_WIDTH;
     }
+    nextCachedLayoutData = 0;
 }
 
 void TextBlock::PreDraw()
@@ -147,6 +147,7 @@ private:
 
     void CalculateCacheParams();
     void CalculateCacheParamsIfNeed();
+    void ResetCachedLayoutData();
 
     void SetFontInternal(Font* _font);
 
@@ -158,11 +159,16 @@ private:
     Vector2 cacheFinalSize;
     Vector2 cacheSpriteOffset;
     Vector2 cacheTextSize;
-    struct
+    // Layout asks preferred size for several widths in one pass (unconstrained width, then height for known width),
+    // so a few last results are kept
+    static const int32 CACHED_LAYOUT_DATA_COUNT = 4;
+    struct CachedLayoutData
     {
         Vector2 size;
         float32 width;
-    } cachedLayoutData;
+    };
+    Array<CachedLayoutData, CACHED_LAYOUT_DATA_COUNT> cachedLayoutData;
+    int32 nextCachedLayoutData = 0;
 
     float32 renderSize;
     float32 fontSize;
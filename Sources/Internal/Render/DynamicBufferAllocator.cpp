@@ -1,6 +1,7 @@
 #include "DynamicBufferAllocator.h"
 #include "Render/Renderer.h"
 #include "Functional/Function.h"
+#include "Math/MathHelpers.h"
 #include <queue>
 
 namespace DAVA
@@ -10,6 +11,7 @@ namespace DynamicBufferAllocator
 namespace //for private members
 {
 uint32 pageSize = DEFAULT_PAGE_SIZE;
+const uint32 INSTANCE_BUFFER_MIN_SIZE = 4096;
 
 template <class HBuffer>
 class BufferProxy
@@ -141,6 +143,16 @@ struct BufferAllocator
         return res;
     }
 
+    void TrimData(HBuffer buffer, uint32 size, uint32 base, uint32 count, uint32 usedCount)
+    {
+        DVASSERT(usedCount <= count);
+
+        if (currentlyMappedBuffer && (currentlyMappedBuffer->buffer == buffer) && (currentlyUsedSize == (base + count) * size))
+        {
+            currentlyUsedSize = (base + usedCount) * size;
+        }
+    }
+
     void Clear()
     {
         for (auto b : buffersToUnmap)
@@ -209,8 +221,100 @@ private:
     List<BufferInfo*> freeBuffers;
 };
 
+struct InstanceBufferAllocator
+{
+    using BufferInfo = BufferAllocator<rhi::HVertexBuffer>::BufferInfo;
+
+    AllocResultVB AllocateData(uint32 size, uint32 count)
+    {
+        DVASSERT(size);
+
+        uint32 requiredSize = size * count;
+
+        BufferInfo* bufferInfo = nullptr;
+        for (auto it = freeBuffers.begin(); it != freeBuffers.end(); ++it)
+        {
+            if ((*it)->allocatedSize >= requiredSize)
+            {
+                bufferInfo = *it;
+                freeBuffers.erase(it);
+                break;
+            }
+        }
+
+        if (bufferInfo == nullptr)
+        {
+            bufferInfo = new BufferInfo();
+            bufferInfo->allocatedSize = uint32(NextPowerOf2(int32(Max(requiredSize, INSTANCE_BUFFER_MIN_SIZE))));
+            bufferInfo->buffer = BufferProxy<rhi::HVertexBuffer>::CreateBuffer(bufferInfo->allocatedSize);
+        }
+
+        bufferInfo->readySync = rhi::GetCurrentFrameSyncObject();
+        mappedBuffers.push_back(bufferInfo);
+
+        AllocResultVB res;
+        res.buffer = bufferInfo->buffer;
+        res.data = BufferProxy<rhi::HVertexBuffer>::MapBuffer(bufferInfo->buffer, 0, requiredSize);
+        res.baseVertex = 0;
+        res.allocatedVertices = count;
+        return res;
+    }
+
+    void Clear()
+    {
+        EndFrame();
+
+        for (auto b : usedBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::DeleteBuffer(b->buffer);
+            SafeDelete(b);
+        }
+        usedBuffers.clear();
+
+        for (auto b : freeBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::DeleteBuffer(b->buffer);
+            SafeDelete(b);
+        }
+        freeBuffers.clear();
+    }
+
+    void BeginFrame()
+    {
+        auto it = usedBuffers.begin();
+        while (it != usedBuffers.end())
+        {
+            if (rhi::SyncObjectSignaled((*it)->readySync))
+            {
+                freeBuffers.push_back(*it);
+                it = usedBuffers.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void EndFrame()
+    {
+        for (auto b : mappedBuffers)
+        {
+            BufferProxy<rhi::HVertexBuffer>::UnmapBuffer(b->buffer);
+            usedBuffers.push_back(b);
+        }
+        mappedBuffers.clear();
+    }
+
+private:
+    Vector<BufferInfo*> usedBuffers;
+    Vector<BufferInfo*> mappedBuffers;
+    List<BufferInfo*> freeBuffers;
+};
+
 BufferAllocator<rhi::HVertexBuffer> vertexBufferAllocator;
 BufferAllocator<rhi::HIndexBuffer> indexBufferAllocator;
+InstanceBufferAllocator instanceBufferAllocator;
 
 rhi::HIndexBuffer currQuadList;
 uint32 currMaxQuadCount = 0;
@@ -229,6 +333,21 @@ AllocResultIB AllocateIndexBuffer(uint32 indexCount)
     return AllocResultIB{ result.buffer, reinterpret_cast<uint16*>(result.data), result.base, result.count };
 }
 
+void TrimVertexBuffer(const AllocResultVB& allocation, uint32 vertexSize, uint32 usedVertexCount)
+{
+    vertexBufferAllocator.TrimData(allocation.buffer, vertexSize, allocation.baseVertex, allocation.allocatedVertices, usedVertexCount);
+}
+
+void TrimIndexBuffer(const AllocResultIB& allocation, uint32 usedIndexCount)
+{
+    indexBufferAllocator.TrimData(allocation.buffer, 2, allocation.baseIndex, allocation.allocatedindices, usedIndexCount);
+}
+
+AllocResultVB AllocateInstanceBuffer(uint32 instanceSize, uint32 instanceCount)
+{
+    return instanceBufferAllocator.AllocateData(instanceSize, instanceCount);
+}
+
 const uint32 VERTICES_PER_QUAD = 4;
 const uint32 INDICES_PER_QUAD = 6;
 
@@ -290,12 +409,14 @@ void BeginFrame()
 {
     vertexBufferAllocator.BeginFrame();
     indexBufferAllocator.BeginFrame();
+    instanceBufferAllocator.BeginFrame();
 }
 
 void EndFrame()
 {
     vertexBufferAllocator.EndFrame();
     indexBufferAllocator.EndFrame();
+    instanceBufferAllocator.EndFrame();
 }
 
 void Clear()
@@ -308,6 +429,7 @@ void Clear()
     }
     vertexBufferAllocator.Clear();
     indexBufferAllocator.Clear();
+    instanceBufferAllocator.Clear();
 }
 
 void SetPageSize(uint32 size)
@@ -317,5 +439,10 @@ void SetPageSize(uint32 size)
     vertexBufferAllocator.Clear();
     indexBufferAllocator.Clear();
 }
+
+uint32 GetPageSize()
+{
+    return pageSize;
+}
 }
 }
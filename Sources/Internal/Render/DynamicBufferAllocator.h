@@ -29,6 +29,15 @@ struct AllocResultIB
 AllocResultVB AllocateVertexBuffer(uint32 vertexSize, uint32 vertexCount);
 AllocResultIB AllocateIndexBuffer(uint32 indexCount);
 
+//return unused tail of allocation back to allocator, so geometry can be built right in buffer allocated for the worst case
+//works only if nothing was allocated after it, otherwise tail stays allocated till the end of frame
+void TrimVertexBuffer(const AllocResultVB& allocation, uint32 vertexSize, uint32 usedVertexCount);
+void TrimIndexBuffer(const AllocResultIB& allocation, uint32 usedIndexCount);
+
+//per-instance data always starts at the beginning of returned buffer (baseVertex is 0) as base instance is not supported on GLES,
+//so every allocation takes whole buffer - allocate once per instanced draw
+AllocResultVB AllocateInstanceBuffer(uint32 instanceSize, uint32 instanceCount);
+
 //it has a bit different life cycle - it is put to eviction queue only once greater size buffer is requested (so client code should still request it every frame), still trying to share existing one
 rhi::HIndexBuffer AllocateQuadListIndexBuffer(uint32 quadCount);
 
@@ -37,6 +46,7 @@ void EndFrame();
 void Clear();
 
 void SetPageSize(uint32 size);
+uint32 GetPageSize();
 }
 }
 
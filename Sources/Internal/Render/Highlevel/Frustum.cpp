@@ -2,6 +2,14 @@
 #include "Render/Highlevel/Frustum.h"
 #include <Render/2D/Systems/RenderSystem2D.h>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DAVA_FRUSTUM_SSE 1
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define DAVA_FRUSTUM_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace DAVA
 {
 //! \brief Set view frustum from matrix information
@@ -166,6 +174,82 @@ bool Frustum::IsInside(const AABBox3* box) const
     return true;
 }
 
+uint32 Frustum::IsInside(const AABBox3x4& boxes, uint8 planeMask) const
+{
+    // same test as in IsInside(box): box is outside if its nearest to plane vertex is in front of plane
+#if defined(DAVA_FRUSTUM_SSE)
+    const __m128 minX = _mm_loadu_ps(boxes.minX);
+    const __m128 minY = _mm_loadu_ps(boxes.minY);
+    const __m128 minZ = _mm_loadu_ps(boxes.minZ);
+    const __m128 maxX = _mm_loadu_ps(boxes.maxX);
+    const __m128 maxY = _mm_loadu_ps(boxes.maxY);
+    const __m128 maxZ = _mm_loadu_ps(boxes.maxZ);
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 outside = zero;
+    for (int32 i = 0; i < planeCount; ++i)
+    {
+        if (planeMask & (1 << i))
+        {
+            const Plane& plane = planeArray[i];
+            __m128 dist = _mm_mul_ps(_mm_set1_ps(plane.n.x), (plane.n.x >= 0.0f) ? minX : maxX);
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.n.y), (plane.n.y >= 0.0f) ? minY : maxY));
+            dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.n.z), (plane.n.z >= 0.0f) ? minZ : maxZ));
+            dist = _mm_add_ps(dist, _mm_set1_ps(plane.d));
+            outside = _mm_or_ps(outside, _mm_cmpgt_ps(dist, zero));
+        }
+    }
+    return ~static_cast<uint32>(_mm_movemask_ps(outside)) & 0xF;
+#elif defined(DAVA_FRUSTUM_NEON)
+    const float32x4_t minX = vld1q_f32(boxes.minX);
+    const float32x4_t minY = vld1q_f32(boxes.minY);
+    const float32x4_t minZ = vld1q_f32(boxes.minZ);
+    const float32x4_t maxX = vld1q_f32(boxes.maxX);
+    const float32x4_t maxY = vld1q_f32(boxes.maxY);
+    const float32x4_t maxZ = vld1q_f32(boxes.maxZ);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    uint32x4_t outside = vdupq_n_u32(0);
+    for (int32 i = 0; i < planeCount; ++i)
+    {
+        if (planeMask & (1 << i))
+        {
+            const Plane& plane = planeArray[i];
+            float32x4_t dist = vdupq_n_f32(plane.d);
+            dist = vmlaq_n_f32(dist, (plane.n.x >= 0.0f) ? minX : maxX, plane.n.x);
+            dist = vmlaq_n_f32(dist, (plane.n.y >= 0.0f) ? minY : maxY, plane.n.y);
+            dist = vmlaq_n_f32(dist, (plane.n.z >= 0.0f) ? minZ : maxZ, plane.n.z);
+            outside = vorrq_u32(outside, vcgtq_f32(dist, zero));
+        }
+    }
+    uint32 insideMask = 0;
+    insideMask |= (vgetq_lane_u32(outside, 0) == 0) ? 0x1 : 0x0;
+    insideMask |= (vgetq_lane_u32(outside, 1) == 0) ? 0x2 : 0x0;
+    insideMask |= (vgetq_lane_u32(outside, 2) == 0) ? 0x4 : 0x0;
+    insideMask |= (vgetq_lane_u32(outside, 3) == 0) ? 0x8 : 0x0;
+    return insideMask;
+#else
+    uint32 insideMask = 0;
+    for (uint32 box = 0; box < AABBox3x4::BOX_COUNT; ++box)
+    {
+        bool inside = true;
+        for (int32 i = 0; (i < planeCount) && inside; ++i)
+        {
+            if (planeMask & (1 << i))
+            {
+                const Plane& plane = planeArray[i];
+                float32 x = (plane.n.x >= 0.0f) ? boxes.minX[box] : boxes.maxX[box];
+                float32 y = (plane.n.y >= 0.0f) ? boxes.minY[box] : boxes.maxY[box];
+                float32 z = (plane.n.z >= 0.0f) ? boxes.minZ[box] : boxes.maxZ[box];
+                inside = (plane.DistanceToPoint(x, y, z) <= 0.0f);
+            }
+        }
+        insideMask |= inside ? (1 << box) : 0;
+    }
+    return insideMask;
+#endif
+}
+
 bool Frustum::IsFullyInside(const AABBox3& box) const
 {
     for (int plane = 0; plane < planeCount; ++plane)
@@ -5,6 +5,7 @@
 #include "Base/BaseObject.h"
 #include "Base/BaseMath.h"
 #include "Math/AABBox3.h"
+#include "Math/AABBox3x4.h"
 #include "Math/Plane.h"
 
 namespace DAVA
@@ -62,6 +63,12 @@ public:
     // unlike Classify this function do not modify plane masking as, though still modify startClippingPlane
     bool IsInside(const AABBox3& box, uint8 planeMask, uint8& startClippingPlane) const;
 
+    //! \brief Check visibility of four axial aligned bounding boxes at once
+    //! \param boxes bounding boxes in structure of arrays form
+    //! \param planeMask planes to check boxes against
+    //! \return mask with bit i set if box i is not outside of frustum
+    uint32 IsInside(const AABBox3x4& boxes, uint8 planeMask) const;
+
     //! \brief Check axial aligned bounding box visibility
     //! \param box bounding box
     bool IsFullyInside(const AABBox3& box) const;
@@ -1,9 +1,53 @@
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/RenderSystem.h"
 #include "Render/Highlevel/RenderPass.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Renderer.h"
+#include "Render/RenderOptions.h"
+#include "Base/Radix/Radix.h"
 
 namespace DAVA
 {
+namespace RenderBatchArrayDetails
+{
+const uint32 BATCH_SORTING_KEY_SHIFT = 60;
+const uint32 MATERIAL_SHIFT = 28;
+const uint32 TEXTURE_SET_SHIFT = 12;
+const uint32 GEOMETRY_SHIFT = 4;
+
+// upper bits of non-negative float are monotonic with its value, so they give logarithmic depth quantization without clamping
+inline uint64 DepthBits(float32 distance)
+{
+    union
+    {
+        float32 f;
+        uint32 u;
+    } bits;
+    bits.f = Max(distance, 0.f);
+    return bits.u >> 20;
+}
+
+// power of two range of distance: 0 is closer than 2, 15 is farther than 32768
+inline uint64 DepthLog2Bits(float32 distance)
+{
+    uint64 exponent = DepthBits(distance) >> 3;
+    return Clamp(exponent, uint64(127), uint64(142)) - 127;
+}
+
+// folded vertex buffer handle, keeps batches of same material and geometry adjacent for auto instancing
+inline uint64 GeometryBits(RenderBatch* batch)
+{
+    PolygonGroup* polygonGroup = batch->GetPolygonGroup();
+    uint32 handle = static_cast<uint32>((polygonGroup != nullptr) ? polygonGroup->vertexBuffer : batch->vertexBuffer);
+    return (handle ^ (handle >> 8) ^ (handle >> 16)) & 0xFF;
+}
+
+inline uint64 SaturateDistance(uint64 distance)
+{
+    return Min(distance, uint64(0xFFFFFFFF));
+}
+}
+
 RenderBatchArray::RenderBatchArray()
     : sortFlags(0)
 {
@@ -11,75 +55,133 @@ RenderBatchArray::RenderBatchArray()
     //renderBatchArray.reserve(4096);
 }
 
-bool RenderBatchArray::MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b)
+void RenderBatchArray::Sort(Camera* camera)
 {
-    return a->layerSortingKey > b->layerSortingKey;
+    if (BeginSort())
+    {
+        ComputeSortingKeys(camera, 0, GetRenderBatchCount());
+        SortByKeys();
+    }
 }
 
-void RenderBatchArray::Sort(Camera* camera)
+bool RenderBatchArray::BeginSort()
 {
     // Need sort
     sortFlags |= SORT_REQUIRED;
 
-    if ((sortFlags & SORT_THIS_FRAME) == SORT_THIS_FRAME)
+    return (sortFlags & SORT_THIS_FRAME) == SORT_THIS_FRAME;
+}
+
+void RenderBatchArray::ComputeSortingKeys(Camera* camera, uint32 begin, uint32 end)
+{
+    DVASSERT(begin <= end && end <= GetRenderBatchCount());
+
+    using namespace RenderBatchArrayDetails;
+
+    if (sortFlags & SORT_BY_MATERIAL)
     {
-        if (sortFlags & SORT_BY_MATERIAL)
-        {
-            //Vector3 cameraPosition = camera->GetPosition();
+        Vector3 cameraPosition = (camera != nullptr) ? camera->GetPosition() : Vector3();
+        Vector3 cameraDirection = (camera != nullptr) ? camera->GetDirection() : Vector3();
+        bool autoInstancing = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::AUTO_INSTANCING);
 
-            for (RenderBatch* batch : renderBatchArray)
+        for (uint32 i = begin; i < end; ++i)
+        {
+            RenderBatch* batch = renderBatchArray[i];
+            NMaterial* material = batch->GetMaterial();
+            uint64 materialKey = material->GetSortingKey();
+            uint64 textureSetKey = material->GetRenderStateSortingKey() & 0xFFFF;
+            Vector3 delta = batch->GetRenderObject()->GetWorldBoundingBox().GetCenter() - cameraPosition;
+            //VI: sorting key has the following layout: (k:4)(m:32)(t:16)(d:12)
+            //key and whole material key go first, parent material defines shader and so pipeline state,
+            //then texture set to minimize texture changes inside material, then front to back
+            //with auto instancing (d:12) becomes (g:8)(d:4), where 'g' is geometry and depth is power of two distance range
+            float32 depth = delta.DotProduct(cameraDirection);
+            uint64 depthBits = 0x0FFF - DepthBits(depth);
+            if (autoInstancing)
             {
-                //pointer_size renderObjectId = (pointer_size)batch->GetRenderObject();
-                //RenderObject * renderObject = batch->GetRenderObject();
-                //Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
-                //float32 distance = (position - cameraPosition).Length();
-                //uint32 distanceBits = (0xFFFF - ((uint32)distance) & 0xFFFF);
-                uint32 materialIndex = batch->GetMaterial()->GetSortingKey();
-                //VI: sorting key has the following layout: (m:8)(s:4)(d:20)
-                //batch->layerSortingKey = (pointer_size)((materialIndex << 20) | (batch->GetSortingKey() << 28) | (distanceBits));
-                batch->layerSortingKey = static_cast<pointer_size>((materialIndex & 0x0FFFFFFF) | (batch->GetSortingKey() << 28));
-                //batch->layerSortingKey = (pointer_size)((batch->GetMaterial()->GetSortingKey() << 20) | (batch->GetSortingKey() << 28) | (renderObjectId & 0x000FFFFF));
+                depthBits = (GeometryBits(batch) << GEOMETRY_SHIFT) | (0x0F - DepthLog2Bits(depth));
             }
+            batch->layerSortingKey = (uint64(batch->GetSortingKey()) << BATCH_SORTING_KEY_SHIFT) | (materialKey << MATERIAL_SHIFT) | (textureSetKey << TEXTURE_SET_SHIFT) | depthBits;
+        }
+    }
+    else if (sortFlags & SORT_BY_DISTANCE_BACK_TO_FRONT)
+    {
+        Vector3 cameraPosition = camera->GetPosition();
+        Vector3 cameraDirection = camera->GetDirection();
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
-
-            sortFlags &= ~SORT_REQUIRED;
+        for (uint32 i = begin; i < end; ++i)
+        {
+            RenderBatch* batch = renderBatchArray[i];
+            Vector3 delta = batch->GetRenderObject()->GetWorldMatrixPtr()->GetTranslationVector() - cameraPosition;
+            uint64 distance = delta.DotProduct(cameraDirection) < 0 ? 0 : (static_cast<uint64>(delta.Length() * 1000.0f)); //x1000.0f is to prevent resorting of nearby objects
+            distance = SaturateDistance(distance + 31 - batch->GetSortingOffset());
+            batch->layerSortingKey = distance | (uint64(batch->GetSortingKey()) << BATCH_SORTING_KEY_SHIFT);
         }
-        else if (sortFlags & SORT_BY_DISTANCE_BACK_TO_FRONT)
+    }
+    else if (sortFlags & SORT_BY_DISTANCE_FRONT_TO_BACK)
+    {
+        Vector3 cameraPosition = camera->GetPosition();
+
+        for (uint32 i = begin; i < end; ++i)
         {
-            Vector3 cameraPosition = camera->GetPosition();
-            Vector3 cameraDirection = camera->GetDirection();
+            RenderBatch* batch = renderBatchArray[i];
+            RenderObject* renderObject = batch->GetRenderObject();
+            Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
+            uint64 distance = SaturateDistance(static_cast<uint64>((position - cameraPosition).Length() * 100.0f) + 31 - batch->GetSortingOffset());
+            uint64 distanceBits = 0xFFFFFFFF - distance;
 
-            for (RenderBatch* batch : renderBatchArray)
-            {
-                Vector3 delta = batch->GetRenderObject()->GetWorldMatrixPtr()->GetTranslationVector() - cameraPosition;
-                uint32 distance = delta.DotProduct(cameraDirection) < 0 ? 0 : (static_cast<uint32>(delta.Length() * 1000.0f)); //x1000.0f is to prevent resorting of nearby objects (still 26 km range)
-                distance = distance + 31 - batch->GetSortingOffset();
-                batch->layerSortingKey = (distance & 0x0fffffff) | (batch->GetSortingKey() << 28);
-            }
+            batch->layerSortingKey = distanceBits | (uint64(batch->GetSortingKey()) << BATCH_SORTING_KEY_SHIFT);
+        }
+    }
+}
 
-            std::stable_sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+void RenderBatchArray::SortByKeys()
+{
+    if (sortFlags & (SORT_BY_MATERIAL | SORT_BY_DISTANCE_BACK_TO_FRONT | SORT_BY_DISTANCE_FRONT_TO_BACK))
+    {
+        RadixSortBatches();
+    }
 
-            sortFlags |= SORT_REQUIRED;
-        }
-        else if (sortFlags & SORT_BY_DISTANCE_FRONT_TO_BACK)
-        {
-            Vector3 cameraPosition = camera->GetPosition();
+    if (sortFlags & SORT_BY_MATERIAL)
+    {
+        sortFlags &= ~SORT_REQUIRED;
+    }
+    else if (sortFlags & (SORT_BY_DISTANCE_BACK_TO_FRONT | SORT_BY_DISTANCE_FRONT_TO_BACK))
+    {
+        sortFlags |= SORT_REQUIRED;
+    }
+}
 
-            for (RenderBatch* batch : renderBatchArray)
-            {
-                RenderObject* renderObject = batch->GetRenderObject();
-                Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
-                uint32 distance = static_cast<uint32>((position - cameraPosition).Length() * 100.0f) + 31 - batch->GetSortingOffset();
-                uint32 distanceBits = 0x0fffffff - distance & 0x0fffffff;
+void RenderBatchArray::RadixSortBatches()
+{
+    uint32 count = GetRenderBatchCount();
 
-                batch->layerSortingKey = distanceBits | (batch->GetSortingKey() << 28);
-            }
+    // after previous sort `sortedBatches` holds previous unsorted array and `previousIndices` its sorted order.
+    // Visibility usually produces same batches in same order, then sort starts from previous order:
+    // keys of static view are already sorted and RadixSort64 returns after histogram pass
+    bool coherent = (sortedBatches == renderBatchArray) && (previousIndices.size() == count);
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+    sortKeys.resize(count);
+    sortIndices.resize(count);
+    tempKeys.resize(count);
+    tempIndices.resize(count);
 
-            sortFlags |= SORT_REQUIRED;
-        }
+    // batches with greater layer sorting key are drawn first, so keys are inverted for ascending sort
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint32 index = coherent ? previousIndices[i] : i;
+        sortKeys[i] = ~renderBatchArray[index]->layerSortingKey;
+        sortIndices[i] = index;
+    }
+
+    RadixSort64(sortKeys.data(), sortIndices.data(), tempKeys.data(), tempIndices.data(), count);
+
+    sortedBatches.resize(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        sortedBatches[i] = renderBatchArray[sortIndices[i]];
     }
+    renderBatchArray.swap(sortedBatches);
+    previousIndices.swap(sortIndices);
 }
 };
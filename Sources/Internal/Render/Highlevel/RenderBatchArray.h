@@ -32,10 +32,27 @@ public:
     void Sort(Camera* camera);
     inline void SetSortingFlags(uint32 flags);
 
+    // Sort split into steps, so keys of large arrays can be computed by chunks on different threads.
+    // BeginSort returns false if array is not sorted this frame.
+    bool BeginSort();
+    void ComputeSortingKeys(Camera* camera, uint32 begin, uint32 end);
+    void SortByKeys();
+
 private:
+    void RadixSortBatches();
+
     Vector<RenderBatch*> renderBatchArray;
     uint32 sortFlags;
-    static bool MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b);
+
+    // compact key/index arrays for radix sort, kept between frames to avoid allocations
+    Vector<uint64> sortKeys;
+    Vector<uint64> tempKeys;
+    Vector<uint32> sortIndices;
+    Vector<uint32> tempIndices;
+    Vector<RenderBatch*> sortedBatches;
+
+    // sorted order of previous frame, seeds sort when batches come in same order
+    Vector<uint32> previousIndices;
 };
 
 inline void RenderBatchArray::Clear()
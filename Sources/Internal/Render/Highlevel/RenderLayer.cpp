@@ -3,6 +3,11 @@
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/Camera.h"
 #include "Render/VisibilityQueryResults.h"
+#include "Render/DynamicBufferAllocator.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Renderer.h"
+#include "Render/RenderOptions.h"
+#include "Render/3D/PolygonGroup.h"
 #include "Base/Radix/Radix.h"
 #include "Debug/ProfilerGPU.h"
 #include "Debug/ProfilerMarkerNames.h"
@@ -42,6 +47,89 @@ const uint32 RenderLayer::LAYER_SORTING_FLAGS_SHADOW_VOLUME = 0;
 const uint32 RenderLayer::LAYER_SORTING_FLAGS_VEGETATION = 0;
 const uint32 RenderLayer::LAYER_SORTING_FLAGS_DEBUG_DRAW = 0;
 
+namespace RenderLayerDetails
+{
+const uint32 MAX_INSTANCES_PER_DRAW = 512;
+const uint32 INSTANCE_DATA_SIZE = 3 * sizeof(Vector4); // three columns of world matrix, last one is always (0, 0, 0, 1)
+const float32 UNIFORM_SCALE_EPSILON = 1e-3f;
+
+// instanced shaders use rotation part of world-view matrix as its inverse transpose, which is valid only for uniform scale
+bool HasUniformScale(const Matrix4& worldMatrix)
+{
+    float32 scaleX = Vector3(worldMatrix._data[0][0], worldMatrix._data[0][1], worldMatrix._data[0][2]).SquareLength();
+    float32 scaleY = Vector3(worldMatrix._data[1][0], worldMatrix._data[1][1], worldMatrix._data[1][2]).SquareLength();
+    float32 scaleZ = Vector3(worldMatrix._data[2][0], worldMatrix._data[2][1], worldMatrix._data[2][2]).SquareLength();
+    float32 epsilon = UNIFORM_SCALE_EPSILON * Max(scaleX, Max(scaleY, scaleZ));
+    return (std::abs(scaleX - scaleY) <= epsilon) && (std::abs(scaleX - scaleZ) <= epsilon);
+}
+
+bool CanBeInstanced(RenderBatch* batch)
+{
+    // other render object types bind their own dynamic parameters, which can't be moved to instance stream
+    RenderObject::eType objectType = batch->GetRenderObject()->GetType();
+    if (objectType != RenderObject::TYPE_RENDEROBJECT && objectType != RenderObject::TYPE_MESH)
+        return false;
+
+    if (batch->instanceCount != 0 || batch->perfQueryStart.IsValid() || batch->perfQueryEnd.IsValid())
+        return false;
+
+    // instance data goes to second vertex stream
+    PolygonGroup* polygonGroup = batch->GetPolygonGroup();
+    uint32 vertexLayoutId = (polygonGroup != nullptr) ? polygonGroup->vertexLayoutId : batch->vertexLayoutId;
+    const rhi::VertexLayout* vertexLayout = rhi::VertexLayout::Get(vertexLayoutId);
+    if (vertexLayout == nullptr || vertexLayout->StreamCount() != 1)
+        return false;
+
+    return HasUniformScale(*batch->GetRenderObject()->GetWorldMatrixPtr());
+}
+
+bool HasSameGeometry(RenderBatch* a, RenderBatch* b)
+{
+    if (a->GetPolygonGroup() != b->GetPolygonGroup() || a->startIndex != b->startIndex)
+        return false;
+
+    if (a->GetPolygonGroup() != nullptr)
+        return true;
+
+    return (a->vertexBuffer == b->vertexBuffer) && (a->indexBuffer == b->indexBuffer) &&
+    (a->vertexBase == b->vertexBase) && (a->vertexCount == b->vertexCount) && (a->indexCount == b->indexCount) &&
+    (a->primitiveType == b->primitiveType) && (a->vertexLayoutId == b->vertexLayoutId);
+}
+
+uint32 GetInstancedVertexLayout(uint32 geometryLayoutUID)
+{
+    static UnorderedMap<uint32, uint32> instancedLayouts;
+
+    auto it = instancedLayouts.find(geometryLayoutUID);
+    if (it != instancedLayouts.end())
+        return it->second;
+
+    const rhi::VertexLayout* geometryLayout = rhi::VertexLayout::Get(geometryLayoutUID);
+    DVASSERT(geometryLayout != nullptr && geometryLayout->StreamCount() == 1);
+
+    rhi::VertexLayout instancedLayout = *geometryLayout;
+    instancedLayout.AddStream(rhi::VDF_PER_INSTANCE);
+    instancedLayout.AddElement(rhi::VS_TEXCOORD, 4, rhi::VDT_FLOAT, 4);
+    instancedLayout.AddElement(rhi::VS_TEXCOORD, 5, rhi::VDT_FLOAT, 4);
+    instancedLayout.AddElement(rhi::VS_TEXCOORD, 6, rhi::VDT_FLOAT, 4);
+
+    uint32 instancedLayoutUID = rhi::VertexLayout::UniqueId(instancedLayout);
+    instancedLayouts[geometryLayoutUID] = instancedLayoutUID;
+    return instancedLayoutUID;
+}
+
+void WriteInstanceData(const Matrix4& worldMatrix, float32* dst)
+{
+    for (uint32 c = 0; c < 3; ++c)
+    {
+        *dst++ = worldMatrix._data[0][c];
+        *dst++ = worldMatrix._data[1][c];
+        *dst++ = worldMatrix._data[2][c];
+        *dst++ = worldMatrix._data[3][c];
+    }
+}
+}
+
 RenderLayer::RenderLayer(eRenderLayerID _id, uint32 sortingFlags)
     : layerID(_id)
     , sortFlags(sortingFlags)
@@ -72,20 +160,70 @@ RenderLayer::eRenderLayerID RenderLayer::GetLayerIDByName(const FastName& name)
 
 void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList)
 {
+    using namespace RenderLayerDetails;
+
     uint32 size = static_cast<uint32>(batchArray.GetRenderBatchCount());
 
+    // batches sorted by material go in runs of same material and geometry, such runs are drawn as single instanced packet
+    bool autoInstancing = (sortFlags & RenderBatchArray::SORT_BY_MATERIAL) && rhi::DeviceCaps().isInstancingSupported &&
+    Renderer::GetOptions()->IsOptionEnabled(RenderOptions::AUTO_INSTANCING);
+
     rhi::Packet packet;
     for (uint32 k = 0; k < size; ++k)
     {
         RenderBatch* batch = batchArray.Get(k);
         RenderObject* renderObject = batch->GetRenderObject();
-        renderObject->BindDynamicParameters(camera, batch);
         NMaterial* mat = batch->GetMaterial();
+
+        uint32 instancesCount = 1;
+        if (autoInstancing && mat && CanBeInstanced(batch))
+        {
+            while ((k + instancesCount < size) && (instancesCount < MAX_INSTANCES_PER_DRAW))
+            {
+                RenderBatch* nextBatch = batchArray.Get(k + instancesCount);
+                // light params are bound once per instanced draw from first batch
+                if (nextBatch->GetMaterial() != mat || !HasSameGeometry(batch, nextBatch) || !CanBeInstanced(nextBatch) ||
+                    nextBatch->GetRenderObject()->GetLight(0) != renderObject->GetLight(0))
+                    break;
+                ++instancesCount;
+            }
+
+            if (instancesCount > 1 && !mat->PreBuildInstancedMaterial())
+                instancesCount = 1;
+        }
+
+        renderObject->BindDynamicParameters(camera, batch);
         if (mat)
         {
             batch->BindGeometryData(packet);
             DVASSERT(packet.primitiveCount);
-            mat->BindParams(packet);
+
+            if (instancesCount > 1)
+            {
+                DynamicBufferAllocator::AllocResultVB instanceData = DynamicBufferAllocator::AllocateInstanceBuffer(INSTANCE_DATA_SIZE, instancesCount);
+                float32* dst = reinterpret_cast<float32*>(instanceData.data);
+                for (uint32 i = 0; i < instancesCount; ++i)
+                {
+                    WriteInstanceData(*batchArray.Get(k + i)->GetRenderObject()->GetWorldMatrixPtr(), dst);
+                    dst += INSTANCE_DATA_SIZE / sizeof(float32);
+                }
+
+                packet.vertexStreamCount = 2;
+                packet.vertexStream[1] = instanceData.buffer;
+                packet.instanceCount = instancesCount;
+                packet.vertexLayoutUID = GetInstancedVertexLayout(packet.vertexLayoutUID);
+                mat->BindInstancedParams(packet);
+
+#ifdef __DAVAENGINE_RENDERSTATS__
+                Renderer::GetRenderStats().instancedBatches += instancesCount;
+                ++Renderer::GetRenderStats().instancedPackets;
+#endif
+            }
+            else
+            {
+                mat->BindParams(packet);
+            }
+
             packet.debugMarker = mat->GetEffectiveFXName().c_str();
             packet.perfQueryStart = batch->perfQueryStart;
             packet.perfQueryEnd = batch->perfQueryEnd;
@@ -104,6 +242,8 @@ void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::
 #endif
             rhi::AddPacket(packetList, packet);
         }
+
+        k += instancesCount - 1;
     }
 }
 };
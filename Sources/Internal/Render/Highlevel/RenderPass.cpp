@@ -9,6 +9,10 @@
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Concurrency/Thread.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Job/JobScheduler.h"
 
 #include "Render/Renderer.h"
 #include "Render/Texture.h"
@@ -22,6 +26,12 @@
 
 namespace DAVA
 {
+namespace RenderPassDetails
+{
+const uint32 SORT_CHUNK_SIZE = 512;
+const uint32 PARALLEL_SORT_MIN_BATCHES = 1024;
+}
+
 RenderPass::RenderPass(const FastName& _name)
     : passName(_name)
 {
@@ -167,14 +177,75 @@ void RenderPass::DrawLayers(Camera* camera)
     Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_RCP_VIEWPORT_SIZE, &rcpViewportSize, reinterpret_cast<pointer_size>(&rcpViewportSize));
     Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_VIEWPORT_OFFSET, &viewportOffset, reinterpret_cast<pointer_size>(&viewportOffset));
 
+    SortLayers(camera);
+
     size_t size = renderLayers.size();
     for (size_t k = 0; k < size; ++k)
     {
         RenderLayer* layer = renderLayers[k];
+        layer->Draw(camera, layersBatchArrays[layer->GetRenderLayerID()], packetList);
+    }
+}
+
+void RenderPass::SortLayers(Camera* camera)
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_PASS_SORT_LAYERS)
+
+    using namespace RenderPassDetails;
+
+    sortChunks.clear();
+    sortedArrays.clear();
+
+    uint32 sortedBatchCount = 0;
+    for (RenderLayer* layer : renderLayers)
+    {
         RenderBatchArray& batchArray = layersBatchArrays[layer->GetRenderLayerID()];
-        batchArray.Sort(camera);
+        if (batchArray.BeginSort())
+        {
+            uint32 batchCount = batchArray.GetRenderBatchCount();
+            for (uint32 begin = 0; begin < batchCount; begin += SORT_CHUNK_SIZE)
+            {
+                sortChunks.push_back({ &batchArray, begin, Min(begin + SORT_CHUNK_SIZE, batchCount) });
+            }
+            sortedArrays.push_back(&batchArray);
+            sortedBatchCount += batchCount;
+        }
+    }
 
-        layer->Draw(camera, batchArray, packetList);
+    // Sorting keys of large layers are computed by chunks and layers are sorted independently in jobs.
+    // Packets are still recorded on calling thread into single packet list: RenderObject::BindDynamicParameters
+    // writes global Renderer::GetDynamicBindings(), NMaterial::BindParams updates const buffers shared by all batches
+    // of the material and DynamicBufferAllocator is not thread-safe. Recording into per-worker packet lists requires
+    // per-worker copies of all of them.
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    bool parallel = (jobManager != nullptr) && (sortedBatchCount >= PARALLEL_SORT_MIN_BATCHES) &&
+    Renderer::GetOptions()->IsOptionEnabled(RenderOptions::PARALLEL_RENDER_PREPARE);
+    if (parallel)
+    {
+        JobScheduler* scheduler = jobManager->GetScheduler();
+        scheduler->ParallelFor(0, static_cast<uint32>(sortChunks.size()), 1, [this, camera](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                sortChunks[i].batchArray->ComputeSortingKeys(camera, sortChunks[i].begin, sortChunks[i].end);
+            }
+        });
+        scheduler->ParallelFor(0, static_cast<uint32>(sortedArrays.size()), 1, [this](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                sortedArrays[i]->SortByKeys();
+            }
+        });
+    }
+    else
+    {
+        for (const SortChunk& chunk : sortChunks)
+        {
+            chunk.batchArray->ComputeSortingKeys(camera, chunk.begin, chunk.end);
+        }
+        for (RenderBatchArray* batchArray : sortedArrays)
+        {
+            batchArray->SortByKeys();
+        }
     }
 }
 
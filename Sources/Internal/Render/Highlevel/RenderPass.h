@@ -43,6 +43,7 @@ protected:
 
     void SetupCameraParams(Camera* mainCamera, Camera* drawCamera, Vector4* externalClipPlane = NULL);
     void DrawLayers(Camera* camera);
+    void SortLayers(Camera* camera);
     void DrawDebug(Camera* camera, RenderSystem* renderSystem);
 
     bool BeginRenderPass();
@@ -54,6 +55,15 @@ protected:
     std::array<RenderBatchArray, RenderLayer::RENDER_LAYER_ID_COUNT> layersBatchArrays;
     Vector<RenderObject*> visibilityArray;
 
+    struct SortChunk
+    {
+        RenderBatchArray* batchArray;
+        uint32 begin;
+        uint32 end;
+    };
+    Vector<SortChunk> sortChunks;
+    Vector<RenderBatchArray*> sortedArrays;
+
     rhi::HPacketList packetList;
     rhi::HRenderPass renderPass;
 
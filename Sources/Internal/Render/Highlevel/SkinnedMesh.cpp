@@ -1,4 +1,3 @@
-#include "Scene3D/SkeletonAnimation/JointTransform.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Render/Renderer.h"
 
@@ -93,21 +92,24 @@ void SkinnedMesh::BindDynamicParameters(Camera* camera, RenderBatch* batch)
     RenderObject::BindDynamicParameters(camera, batch);
 }
 
-void SkinnedMesh::UpdateJointTransforms(const Vector<JointTransform>& finalTransforms)
+void SkinnedMesh::UpdateJointTransforms(const Vector<Vector4>& finalPositions, const Vector<Vector4>& finalOrientations)
 {
+    DVASSERT(finalPositions.size() == finalOrientations.size());
+
     for (auto& jointsData : jointTargetsData)
     {
         const JointTargets& targets = jointsData.first;
         JointTargetsData& data = jointsData.second;
 
+        Vector4* positions = data.positions.data();
+        Vector4* quaternions = data.quaternions.data();
         for (uint32 j = 0; j < data.jointsDataCount; ++j)
         {
             uint32 transformIndex = targets[j];
-            DVASSERT(transformIndex < uint32(finalTransforms.size()));
+            DVASSERT(transformIndex < uint32(finalPositions.size()));
 
-            const JointTransform& finalTransform = finalTransforms[transformIndex];
-            data.positions[j] = Vector4(Vector3(finalTransform.GetPosition().data), finalTransform.GetScale());
-            data.quaternions[j] = Vector4(finalTransform.GetOrientation().data);
+            positions[j] = finalPositions[transformIndex];
+            quaternions[j] = finalOrientations[transformIndex];
         }
     }
 }
@@ -20,6 +20,40 @@ void QuadTree::QuadTreeNode::Reset()
     nodeInfo = 0;
 }
 
+void QuadTree::QuadTreeNode::AddObject(RenderObject* object)
+{
+    uint32 index = static_cast<uint32>(objects.size());
+    objects.push_back(object);
+    objectBoxes.resize(index / AABBox3x4::BOX_COUNT + 1);
+    objectBoxes[index / AABBox3x4::BOX_COUNT].Set(index % AABBox3x4::BOX_COUNT, object->GetWorldBoundingBox());
+}
+
+void QuadTree::QuadTreeNode::RemoveObject(RenderObject* object)
+{
+    Vector<RenderObject*>::iterator it = std::find(objects.begin(), objects.end(), object);
+    DVASSERT(it != objects.end());
+
+    uint32 index = static_cast<uint32>(std::distance(objects.begin(), it));
+    uint32 lastIndex = static_cast<uint32>(objects.size() - 1);
+    if (index != lastIndex)
+    {
+        objects[index] = objects[lastIndex];
+        AABBox3 lastBox = objectBoxes[lastIndex / AABBox3x4::BOX_COUNT].Get(lastIndex % AABBox3x4::BOX_COUNT);
+        objectBoxes[index / AABBox3x4::BOX_COUNT].Set(index % AABBox3x4::BOX_COUNT, lastBox);
+    }
+    objects.pop_back();
+    objectBoxes.resize((objects.size() + AABBox3x4::BOX_COUNT - 1) / AABBox3x4::BOX_COUNT);
+}
+
+void QuadTree::QuadTreeNode::UpdateObjectBox(RenderObject* object)
+{
+    Vector<RenderObject*>::iterator it = std::find(objects.begin(), objects.end(), object);
+    DVASSERT(it != objects.end());
+
+    uint32 index = static_cast<uint32>(std::distance(objects.begin(), it));
+    objectBoxes[index / AABBox3x4::BOX_COUNT].Set(index % AABBox3x4::BOX_COUNT, object->GetWorldBoundingBox());
+}
+
 QuadTree::QuadTree(int32 _maxTreeDepth)
     : maxTreeDepth(_maxTreeDepth)
 {
@@ -245,13 +279,13 @@ void QuadTree::AddRenderObject(RenderObject* renderObject)
     if ((renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) || (!worldBox.IsInside(objBox)))
     {
         //object is somehow outside the world - just add to root
-        nodes[0].objects.push_back(renderObject);
+        nodes[0].AddObject(renderObject);
         renderObject->SetTreeNodeIndex(0);
         renderObject->RemoveFlag(RenderObject::TREE_NODE_NEED_UPDATE);
         return;
     }
     uint16 nodeToAdd = FindObjectAddNode(0, renderObject->GetWorldBoundingBox());
-    nodes[nodeToAdd].objects.push_back(renderObject);
+    nodes[nodeToAdd].AddObject(renderObject);
     renderObject->SetTreeNodeIndex(nodeToAdd);
     renderObject->RemoveFlag(RenderObject::TREE_NODE_NEED_UPDATE);
 }
@@ -274,9 +308,7 @@ void QuadTree::RemoveRenderObject(RenderObject* renderObject)
     uint16 currIndex = renderObject->GetTreeNodeIndex();
     DVASSERT(currIndex != INVALID_TREE_NODE_INDEX);
     renderObject->SetTreeNodeIndex(INVALID_TREE_NODE_INDEX);
-    Vector<RenderObject*>::iterator it = std::find(nodes[currIndex].objects.begin(), nodes[currIndex].objects.end(), renderObject);
-    DVASSERT(it != nodes[currIndex].objects.end());
-    nodes[currIndex].objects.erase(it);
+    nodes[currIndex].RemoveObject(renderObject);
 
     if (renderObject->GetFlags() & RenderObject::TREE_NODE_NEED_UPDATE)
     {
@@ -355,7 +387,11 @@ const AABBox3& QuadTree::GetWorldBoundingBox() const
 void QuadTree::ObjectUpdated(RenderObject* renderObject)
 {
     if (renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE)
+    {
+        //object stays in its node, but keep box actual in case flag is removed later
+        nodes[renderObject->GetTreeNodeIndex()].UpdateObjectBox(renderObject);
         return;
+    }
 
     DVASSERT(worldInitialized);
     //remove object from its current tree node
@@ -374,20 +410,9 @@ void QuadTree::ObjectUpdated(RenderObject* renderObject)
 
     if (reverseIndex != baseIndex)
     {
-        //remove from base
-        int32 objectsSize = static_cast<int32>(nodes[baseIndex].objects.size());
-        int32 objIndex = 0;
-        for (; objIndex < objectsSize; ++objIndex)
-        {
-            if (nodes[baseIndex].objects[objIndex] == renderObject)
-                break;
-        }
-        DVASSERT(objIndex < objectsSize);
-        if (objectsSize > 1)
-            nodes[baseIndex].objects[objIndex] = nodes[baseIndex].objects[objectsSize - 1];
-        nodes[baseIndex].objects.resize(objectsSize - 1);
-        //and add to target
-        nodes[reverseIndex].objects.push_back(renderObject);
+        //remove from base and add to target
+        nodes[baseIndex].RemoveObject(renderObject);
+        nodes[reverseIndex].AddObject(renderObject);
         renderObject->SetTreeNodeIndex(reverseIndex);
 
         /*only now we can climb back and remove/mark nodes*/
@@ -417,6 +442,7 @@ void QuadTree::ObjectUpdated(RenderObject* renderObject)
     }
     else
     {
+        nodes[baseIndex].UpdateObjectBox(renderObject);
         MarkNodeDirty(baseIndex);
     }
     //as object change can wrap any of parent boxes
@@ -471,14 +497,21 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     }
     else
     {
+        //boxes are tested four at once, objects are touched only to check flags
+        uint32 insideMask = 0;
         for (int32 i = 0; i < objectsSize; ++i)
         {
+            uint32 lane = i % AABBox3x4::BOX_COUNT;
+            if (lane == 0)
+            {
+                insideMask = currFrustum->IsInside(currNode.objectBoxes[i / AABBox3x4::BOX_COUNT], clippingFlags);
+            }
+
             RenderObject* obj = currNode.objects[i];
             uint32 flags = obj->GetFlags();
             if ((flags & currVisibilityCriteria) == currVisibilityCriteria)
             {
-                if ((flags & RenderObject::ALWAYS_CLIPPING_VISIBLE)
-                    || currFrustum->IsInside(obj->GetWorldBoundingBox(), clippingFlags, obj->startClippingPlane))
+                if ((flags & RenderObject::ALWAYS_CLIPPING_VISIBLE) || (insideMask & (1 << lane)))
                 {
                     visibilityArray.push_back(obj);
 #if defined(__DAVAENGINE_RENDERSTATS__)
@@ -694,20 +727,9 @@ void QuadTree::Update()
             uint16 targetNode = FindObjectAddNode(startNode, object->GetWorldBoundingBox());
             if (startNode != targetNode)
             {
-                //remove from base
-                int32 objectsSize = static_cast<int32>(nodes[startNode].objects.size());
-                int32 objIndex = 0;
-                for (; objIndex < objectsSize; ++objIndex)
-                {
-                    if (nodes[startNode].objects[objIndex] == object)
-                        break;
-                }
-                DVASSERT(objIndex < objectsSize);
-                if (objectsSize > 1)
-                    nodes[startNode].objects[objIndex] = nodes[startNode].objects[objectsSize - 1];
-                nodes[startNode].objects.resize(objectsSize - 1);
-                //and add to target
-                nodes[targetNode].objects.push_back(object);
+                //remove from base and add to target
+                nodes[startNode].RemoveObject(object);
+                nodes[targetNode].AddObject(object);
                 object->SetTreeNodeIndex(targetNode);
             }
         }
@@ -2,6 +2,7 @@
 
 #include "Base/BaseObject.h"
 #include "Math/AABBox3.h"
+#include "Math/AABBox3x4.h"
 #include "Render/Highlevel/RenderHierarchy.h"
 #include "Render/UniqueStateSet.h"
 
@@ -59,8 +60,13 @@ public:
         const static uint16 START_CLIP_PLANE_OFFSET = 4;
         uint16 nodeInfo; // format : ddddddddddzccñ where c - numChildNodes, z - dirtyZ, d - depth
         Vector<RenderObject*> objects;
+        Vector<AABBox3x4> objectBoxes; // world boxes of objects, objectBoxes[i / 4] lane i % 4 is box of objects[i]
         QuadTreeNode();
         void Reset();
+
+        void AddObject(RenderObject* object);
+        void RemoveObject(RenderObject* object); // last object takes place of removed one
+        void UpdateObjectBox(RenderObject* object);
     };
 
 private:
@@ -27,6 +27,7 @@ Mutex fxCacheMutex;
 namespace FXCache
 {
 const FXDescriptor& LoadFXFromOldTemplate(const FastName& fxName, UnorderedMap<FastName, int32>& defines, const Vector<size_t>& key, const FastName& quality);
+const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& quality);
 
 void Initialize()
 {
@@ -85,6 +86,52 @@ const FXDescriptor& GetFXDescriptor(const FastName& fxName, UnorderedMap<FastNam
     return LoadFXFromOldTemplate(fxName, defines, key, quality);
 }
 
+UnorderedMap<FastName, int32> BuildPassShaderDefines(const RenderPassDescriptor& pass, const UnorderedMap<FastName, int32>& defines)
+{
+    UnorderedMap<FastName, int32> shaderDefines = defines;
+    for (auto& templateDefine : pass.templateDefines)
+    {
+        if (templateDefine.second == 0)
+            shaderDefines.erase(templateDefine.first);
+        else
+            shaderDefines[templateDefine.first] = templateDefine.second;
+    }
+
+    if (pass.hasBlend)
+    {
+        if (shaderDefines.find(NMaterialFlagName::FLAG_BLENDING) == shaderDefines.end())
+            shaderDefines[NMaterialFlagName::FLAG_BLENDING] = BLENDING_ALPHABLEND;
+    }
+    else
+    {
+        shaderDefines.erase(NMaterialFlagName::FLAG_BLENDING);
+    }
+
+    return shaderDefines;
+}
+
+void CollectShaderPermutations(const FastName& fxName, const UnorderedMap<FastName, int32>& defines, const FastName& quality, Vector<ShaderDescriptorCache::ShaderPermutation>& permutations)
+{
+    using namespace FXCacheDetails;
+
+    DVASSERT(initialized);
+
+    if (!fxName.IsValid())
+    {
+        return; //default fx is compiled on initialization
+    }
+
+    LockGuard<Mutex> guard(FXCacheDetails::fxCacheMutex);
+    const FXDescriptor& fxTemplate = LoadOldTempalte(fxName, quality);
+    for (const RenderPassDescriptor& pass : fxTemplate.renderPassDescriptors)
+    {
+        ShaderDescriptorCache::ShaderPermutation permutation;
+        permutation.name = pass.shaderFileName;
+        permutation.defines = BuildPassShaderDefines(pass, defines);
+        permutations.emplace_back(std::move(permutation));
+    }
+}
+
 const FXDescriptor& LoadOldTempalte(const FastName& fxName, const FastName& quality)
 {
     using namespace FXCacheDetails;
@@ -369,25 +416,7 @@ const FXDescriptor& LoadFXFromOldTemplate(const FastName& fxName, UnorderedMap<F
     target.defines = defines; //combine
     for (auto& pass : target.renderPassDescriptors)
     {
-        UnorderedMap<FastName, int32> shaderDefines = defines;
-        for (auto& templateDefine : pass.templateDefines)
-        {
-            if (templateDefine.second == 0)
-                shaderDefines.erase(templateDefine.first);
-            else
-                shaderDefines[templateDefine.first] = templateDefine.second;
-        }
-
-        if (pass.hasBlend)
-        {
-            if (shaderDefines.find(NMaterialFlagName::FLAG_BLENDING) == shaderDefines.end())
-                shaderDefines[NMaterialFlagName::FLAG_BLENDING] = BLENDING_ALPHABLEND;
-        }
-        else
-        {
-            shaderDefines.erase(NMaterialFlagName::FLAG_BLENDING);
-        }
-
+        UnorderedMap<FastName, int32> shaderDefines = BuildPassShaderDefines(pass, defines);
         pass.shader = ShaderDescriptorCache::GetShaderDescriptor(pass.shaderFileName, shaderDefines);
         pass.depthStencilState = rhi::AcquireDepthStencilState(pass.depthStateDescriptor);
     }
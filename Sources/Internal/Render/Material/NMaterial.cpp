@@ -7,6 +7,8 @@
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Material/FXCache.h"
 #include "Render/Shader.h"
+#include "Render/ShaderCache.h"
+#include "Render/Renderer.h"
 #include "Render/Texture.h"
 
 #include "Utils/Utils.h"
@@ -33,6 +35,75 @@ V GetValuePtr(const UnorderedMap<K, V>& umap, const K& key)
 
     return nullptr;
 }
+
+// per-object dynamic params which can't be restored from per-instance world matrix,
+// light params are per-object too, but batches are drawn instanced only with same light (see RenderLayer)
+const DynamicBindings::eUniformSemantic NON_INSTANCEABLE_PARAMS[] =
+{
+  DynamicBindings::PARAM_INV_WORLD,
+  DynamicBindings::PARAM_WORLD_INV_TRANSPOSE,
+  DynamicBindings::PARAM_INV_WORLD_VIEW,
+  DynamicBindings::PARAM_INV_WORLD_VIEW_PROJ,
+  DynamicBindings::PARAM_WORLD_SCALE,
+  DynamicBindings::PARAM_LOCAL_BOUNDING_BOX,
+  DynamicBindings::PARAM_WORLD_VIEW_OBJECT_CENTER,
+  DynamicBindings::PARAM_BOUNDING_BOX_SIZE,
+  DynamicBindings::PARAM_SPEED_TREE_TRUNK_OSCILLATION,
+  DynamicBindings::PARAM_SPEED_TREE_LEAFS_OSCILLATION,
+  DynamicBindings::PARAM_SPEED_TREE_LIGHT_SMOOTHING,
+  DynamicBindings::PARAM_SPHERICAL_HARMONICS,
+  DynamicBindings::PARAM_JOINT_POSITIONS,
+  DynamicBindings::PARAM_JOINT_QUATERNIONS
+};
+
+// AUTO_INSTANCING shaders compute these params from per-instance world matrix instead of reading them
+const DynamicBindings::eUniformSemantic INSTANCE_DERIVED_PARAMS[] =
+{
+  DynamicBindings::PARAM_WORLD,
+  DynamicBindings::PARAM_WORLD_VIEW,
+  DynamicBindings::PARAM_WORLD_VIEW_INV_TRANSPOSE,
+  DynamicBindings::PARAM_WORLD_VIEW_PROJ
+};
+
+// per-instance world matrix occupies TEXCOORD4..TEXCOORD6 of AUTO_INSTANCING shaders
+const uint32 INSTANCE_DATA_VERTEX_FORMAT = EVF_PIVOT4 | EVF_FLEXIBILITY | EVF_ANGLE_SIN_COS;
+
+bool CanDrawInstanced(ShaderDescriptor* shader)
+{
+    if (!shader->IsValid() || (shader->GetRequiredVertexFormat() & INSTANCE_DATA_VERTEX_FORMAT) != 0)
+        return false;
+
+    for (DynamicBindings::eUniformSemantic semantic : NON_INSTANCEABLE_PARAMS)
+    {
+        if (shader->UsesDynamicParam(semantic))
+            return false;
+    }
+    return true;
+}
+
+// AUTO_INSTANCING variant is requested by BuildInstancedVariant at draw time, so compile it together with regular one
+void PreCacheInstancedFX(const FastName& fxName, UnorderedMap<FastName, int32>& flags, const FastName& quality, const FXDescriptor& fxDescr)
+{
+    if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::AUTO_INSTANCING))
+        return;
+
+    bool canDrawInstanced = std::any_of(fxDescr.renderPassDescriptors.begin(), fxDescr.renderPassDescriptors.end(), [](const RenderPassDescriptor& pass) {
+        return CanDrawInstanced(pass.shader);
+    });
+    if (canDrawInstanced)
+    {
+        flags[NMaterialFlagName::FLAG_AUTO_INSTANCING] = 1;
+        FXCache::GetFXDescriptor(fxName, flags, quality);
+    }
+}
+
+uint32 GetAnisotropyLevel()
+{
+    const AnisotropyQuality* anisotropicQuality =
+    QualitySettingsSystem::Instance()->GetAnisotropyQuality(QualitySettingsSystem::Instance()->GetCurAnisotropyQuality());
+
+    return (anisotropicQuality == nullptr) ? 1 : std::min(anisotropicQuality->maxAnisotropy, rhi::DeviceCaps().maxAnisotropy);
+}
 }
 
 const float32 NMaterial::DEFAULT_LIGHTMAP_SIZE = 16.0f;
@@ -150,6 +221,8 @@ NMaterial::~NMaterial()
     }
     for (auto& variant : renderVariants)
         delete variant.second;
+    for (auto& variant : instancedRenderVariants)
+        delete variant.second;
 }
 
 void NMaterial::BindParams(rhi::Packet& target)
@@ -158,33 +231,46 @@ void NMaterial::BindParams(rhi::Packet& target)
 
     //Logger::Info( "bind-params" );
     DVASSERT(activeVariantInstance); //trying to bind material that was not staged to render
-    DVASSERT(activeVariantInstance->shader); //should have returned false on PreBuild!
-    DVASSERT(activeVariantInstance->shader->IsValid()); //should have returned false on PreBuild!
+    BindVariantParams(activeVariantInstance, target);
+}
+
+void NMaterial::BindInstancedParams(rhi::Packet& target)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    DVASSERT(activeInstancedVariantInstance); //trying to bind material that was not staged to instanced render
+    BindVariantParams(activeInstancedVariantInstance, target);
+}
+
+void NMaterial::BindVariantParams(RenderVariantInstance* variantInstance, rhi::Packet& target)
+{
+    DVASSERT(variantInstance->shader); //should have returned false on PreBuild!
+    DVASSERT(variantInstance->shader->IsValid()); //should have returned false on PreBuild!
     /*set pipeline state*/
-    target.renderPipelineState = activeVariantInstance->shader->GetPiplineState();
-    target.depthStencilState = activeVariantInstance->depthState;
-    target.samplerState = activeVariantInstance->samplerState;
-    target.textureSet = activeVariantInstance->textureSet;
-    target.cullMode = activeVariantInstance->cullMode;
+    target.renderPipelineState = variantInstance->shader->GetPiplineState();
+    target.depthStencilState = variantInstance->depthState;
+    target.samplerState = variantInstance->samplerState;
+    target.textureSet = variantInstance->textureSet;
+    target.cullMode = variantInstance->cullMode;
 
-    if (activeVariantInstance->wireFrame)
+    if (variantInstance->wireFrame)
         target.options |= rhi::Packet::OPT_WIREFRAME;
     else
         target.options &= ~rhi::Packet::OPT_WIREFRAME;
 
-    if (activeVariantInstance->alphablend)
+    if (variantInstance->alphablend)
         target.userFlags |= USER_FLAG_ALPHABLEND;
     else
         target.userFlags &= ~USER_FLAG_ALPHABLEND;
 
-    if (activeVariantInstance->alphatest)
+    if (variantInstance->alphatest)
         target.userFlags |= USER_FLAG_ALPHATEST;
     else
         target.userFlags &= ~USER_FLAG_ALPHATEST;
 
-    activeVariantInstance->shader->UpdateDynamicParams();
+    variantInstance->shader->UpdateDynamicParams();
     /*update values in material const buffers*/
-    for (auto& materialBufferBinding : activeVariantInstance->materialBufferBindings)
+    for (auto& materialBufferBinding : variantInstance->materialBufferBindings)
     {
         if (materialBufferBinding->lastValidPropertySemantic == NMaterialProperty::GetCurrentUpdateSemantic()) //prevent buffer update if nothing changed
             continue;
@@ -215,13 +301,13 @@ void NMaterial::BindParams(rhi::Packet& target)
         materialBufferBinding->lastValidPropertySemantic = NMaterialProperty::GetCurrentUpdateSemantic();
     }
 
-    target.vertexConstCount = static_cast<uint32>(activeVariantInstance->vertexConstBuffers.size());
-    target.fragmentConstCount = static_cast<uint32>(activeVariantInstance->fragmentConstBuffers.size());
+    target.vertexConstCount = static_cast<uint32>(variantInstance->vertexConstBuffers.size());
+    target.fragmentConstCount = static_cast<uint32>(variantInstance->fragmentConstBuffers.size());
     /*bind material const buffers*/
-    for (size_t i = 0, sz = activeVariantInstance->vertexConstBuffers.size(); i < sz; ++i)
-        target.vertexConst[i] = activeVariantInstance->vertexConstBuffers[i];
-    for (size_t i = 0, sz = activeVariantInstance->fragmentConstBuffers.size(); i < sz; ++i)
-        target.fragmentConst[i] = activeVariantInstance->fragmentConstBuffers[i];
+    for (size_t i = 0, sz = variantInstance->vertexConstBuffers.size(); i < sz; ++i)
+        target.vertexConst[i] = variantInstance->vertexConstBuffers[i];
+    for (size_t i = 0, sz = variantInstance->fragmentConstBuffers.size(); i < sz; ++i)
+        target.fragmentConst[i] = variantInstance->fragmentConstBuffers[i];
 }
 
 uint32 NMaterial::GetRequiredVertexFormat()
@@ -740,6 +826,11 @@ void NMaterial::ClearLocalBuffers()
     }
     for (auto& variant : renderVariants)
         variant.second->materialBufferBindings.clear();
+    for (auto& variant : instancedRenderVariants)
+    {
+        if (variant.second != nullptr)
+            variant.second->materialBufferBindings.clear();
+    }
     localConstBuffers.clear();
 }
 
@@ -775,7 +866,9 @@ void NMaterial::PreCacheFX()
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
     flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
-    FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
+    FastName quality = QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup());
+    const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, quality);
+    NMaterialDetail::PreCacheInstancedFX(GetEffectiveFXName(), flags, quality, fxDescr);
 }
 
 void NMaterial::PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName)
@@ -792,7 +885,10 @@ void NMaterial::PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFl
         else
             flags[it.first] = it.second;
     }
-    FXCache::GetFXDescriptor(extraFxName.IsValid() ? extraFxName : GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
+    const FastName& fxName = extraFxName.IsValid() ? extraFxName : GetEffectiveFXName();
+    FastName quality = QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup());
+    const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(fxName, flags, quality);
+    NMaterialDetail::PreCacheInstancedFX(fxName, flags, quality, fxDescr);
 }
 
 void NMaterial::PreCacheFXVariations(const Vector<FastName>& fxNames, const Vector<FastName>& flags)
@@ -813,6 +909,28 @@ void NMaterial::PreCacheFXVariations(const Vector<FastName>& fxNames, const Vect
     }
 }
 
+void NMaterial::CollectShaderPermutations(const FastName& quality, Vector<ShaderDescriptorCache::ShaderPermutation>& permutations)
+{
+    UnorderedMap<FastName, int32> flags(16);
+    CollectMaterialFlags(flags);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    FXCache::CollectShaderPermutations(GetEffectiveFXName(), flags, quality, permutations);
+
+    // AUTO_INSTANCING variants are built at draw time, shaders not supporting them are skipped to keep cache small
+    Vector<ShaderDescriptorCache::ShaderPermutation> instancedPermutations;
+    flags[NMaterialFlagName::FLAG_AUTO_INSTANCING] = 1;
+    FXCache::CollectShaderPermutations(GetEffectiveFXName(), flags, quality, instancedPermutations);
+    for (ShaderDescriptorCache::ShaderPermutation& permutation : instancedPermutations)
+    {
+        if (ShaderDescriptorCache::IsDefineUsed(permutation.name, NMaterialFlagName::FLAG_AUTO_INSTANCING))
+        {
+            permutations.emplace_back(std::move(permutation));
+        }
+    }
+}
+
 void NMaterial::RebuildRenderVariants()
 {
     InvalidateBufferBindings();
@@ -832,12 +950,18 @@ void NMaterial::RebuildRenderVariants()
 
     /*at least in theory flag changes can lead to changes in number of render passes*/
     activeVariantInstance = nullptr;
+    activeInstancedVariantInstance = nullptr;
     activeVariantName = FastName();
     for (auto& variant : renderVariants)
     {
         delete variant.second;
     }
     renderVariants.clear();
+    for (auto& variant : instancedRenderVariants)
+    {
+        delete variant.second;
+    }
+    instancedRenderVariants.clear();
 
     for (auto& variantDescr : fxDescr.renderPassDescriptors)
     {
@@ -889,183 +1013,193 @@ void NMaterial::RebuildBindings()
     InvalidateBufferBindings();
 
     for (auto& variant : renderVariants)
+        RebuildVariantBindings(variant.second);
+    for (auto& variant : instancedRenderVariants)
     {
-        RenderVariantInstance* currRenderVariant = variant.second;
-        ShaderDescriptor* currShader = currRenderVariant->shader;
-        if (!currShader->IsValid()) //cant build for empty shader
-            continue;
-        currRenderVariant->vertexConstBuffers.resize(currShader->GetVertexConstBuffersCount());
-        currRenderVariant->fragmentConstBuffers.resize(currShader->GetFragmentConstBuffersCount());
+        if (variant.second != nullptr)
+            RebuildVariantBindings(variant.second);
+    }
+
+    needRebuildBindings = false;
+}
 
-        for (auto& bufferDescr : currShader->GetConstBufferDescriptors())
+void NMaterial::RebuildVariantBindings(RenderVariantInstance* currRenderVariant)
+{
+    ShaderDescriptor* currShader = currRenderVariant->shader;
+    if (!currShader->IsValid()) //cant build for empty shader
+        return;
+    currRenderVariant->vertexConstBuffers.resize(currShader->GetVertexConstBuffersCount());
+    currRenderVariant->fragmentConstBuffers.resize(currShader->GetFragmentConstBuffersCount());
+
+    for (auto& bufferDescr : currShader->GetConstBufferDescriptors())
+    {
+        rhi::HConstBuffer bufferHandle;
+        MaterialBufferBinding* bufferBinding = nullptr;
+        //for static buffers resolve sharing and bindings
+        if (bufferDescr.updateType == rhi::ShaderProp::SOURCE_MATERIAL)
         {
-            rhi::HConstBuffer bufferHandle;
-            MaterialBufferBinding* bufferBinding = nullptr;
-            //for static buffers resolve sharing and bindings
-            if (bufferDescr.updateType == rhi::ShaderProp::SOURCE_MATERIAL)
+            bufferBinding = GetConstBufferBinding(bufferDescr.propertyLayoutId);
+            //local buffers can contain buffer for corresponding layout if for example several passes us same buffer layout
+            bool needLocalOverride = NeedLocalOverride(bufferDescr.propertyLayoutId) && (NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
+            //Create local buffer and build it's bindings if required;
+            if ((bufferBinding == nullptr) || needLocalOverride)
             {
-                bufferBinding = GetConstBufferBinding(bufferDescr.propertyLayoutId);
-                //local buffers can contain buffer for corresponding layout if for example several passes us same buffer layout
-                bool needLocalOverride = NeedLocalOverride(bufferDescr.propertyLayoutId) && (NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
-                //Create local buffer and build it's bindings if required;
-                if ((bufferBinding == nullptr) || needLocalOverride)
-                {
-                    //create buffer
-                    bufferBinding = new MaterialBufferBinding();
+                //create buffer
+                bufferBinding = new MaterialBufferBinding();
 
-                    //create handles
-                    if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
-                        bufferBinding->constBuffer = rhi::CreateVertexConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
-                    else
-                        bufferBinding->constBuffer = rhi::CreateFragmentConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
+                //create handles
+                if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
+                    bufferBinding->constBuffer = rhi::CreateVertexConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
+                else
+                    bufferBinding->constBuffer = rhi::CreateFragmentConstBuffer(currShader->GetPiplineState(), bufferDescr.targetSlot);
 
-                    if (bufferBinding->constBuffer != rhi::InvalidHandle)
-                    {
-                        //if const buffer is InvalidHandle this means that whole const buffer was cut by shader compiler/linker
-                        //it should not be updated but still can be shared as other shader variants can use it
+                if (bufferBinding->constBuffer != rhi::InvalidHandle)
+                {
+                    //if const buffer is InvalidHandle this means that whole const buffer was cut by shader compiler/linker
+                    //it should not be updated but still can be shared as other shader variants can use it
 
-                        //create bindings for this buffer
-                        for (auto& propDescr : ShaderDescriptor::GetProps(bufferDescr.propertyLayoutId))
+                    //create bindings for this buffer
+                    for (auto& propDescr : ShaderDescriptor::GetProps(bufferDescr.propertyLayoutId))
+                    {
+                        NMaterialProperty* prop = GetMaterialProperty(propDescr.uid);
+                        if ((prop != nullptr)) //has property of the same type
                         {
-                            NMaterialProperty* prop = GetMaterialProperty(propDescr.uid);
-                            if ((prop != nullptr)) //has property of the same type
-                            {
-                                DVASSERT(prop->type == propDescr.type);
+                            DVASSERT(prop->type == propDescr.type);
 
-                                // create property binding
+                            // create property binding
 
-                                bufferBinding->propBindings.emplace_back(propDescr.type,
-                                                                         propDescr.bufferReg, propDescr.bufferRegCount, 0, prop);
+                            bufferBinding->propBindings.emplace_back(propDescr.type,
+                                                                     propDescr.bufferReg, propDescr.bufferRegCount, 0, prop);
+                        }
+                        else
+                        {
+                            //just set default property to const buffer
+                            if (propDescr.type < rhi::ShaderProp::TYPE_FLOAT4)
+                            {
+                                rhi::UpdateConstBuffer1fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.bufferRegCount, propDescr.defaultValue, ShaderDescriptor::CalculateDataSize(propDescr.type, 1));
                             }
                             else
                             {
-                                //just set default property to const buffer
-                                if (propDescr.type < rhi::ShaderProp::TYPE_FLOAT4)
-                                {
-                                    rhi::UpdateConstBuffer1fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.bufferRegCount, propDescr.defaultValue, ShaderDescriptor::CalculateDataSize(propDescr.type, 1));
-                                }
-                                else
-                                {
-                                    rhi::UpdateConstBuffer4fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.defaultValue, propDescr.bufferRegCount);
-                                }
+                                rhi::UpdateConstBuffer4fv(bufferBinding->constBuffer, propDescr.bufferReg, propDescr.defaultValue, propDescr.bufferRegCount);
                             }
                         }
                     }
-
-                    //store it locally or at parent
-                    if (needLocalOverride || (!parent))
-                    {
-                        //buffer should be handled locally
-                        DVASSERT(NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
-                        localConstBuffers[bufferDescr.propertyLayoutId] = bufferBinding;
-                    }
-                    else
-                    {
-                        //buffer can be propagated upward
-                        parent->InjectChildBuffer(bufferDescr.propertyLayoutId, bufferBinding);
-                    }
                 }
-                currRenderVariant->materialBufferBindings.push_back(bufferBinding);
 
-                bufferHandle = bufferBinding->constBuffer;
+                //store it locally or at parent
+                if (needLocalOverride || (!parent))
+                {
+                    //buffer should be handled locally
+                    DVASSERT(NMaterialDetail::GetValuePtr(localConstBuffers, bufferDescr.propertyLayoutId) == nullptr);
+                    localConstBuffers[bufferDescr.propertyLayoutId] = bufferBinding;
+                }
+                else
+                {
+                    //buffer can be propagated upward
+                    parent->InjectChildBuffer(bufferDescr.propertyLayoutId, bufferBinding);
+                }
             }
+            currRenderVariant->materialBufferBindings.push_back(bufferBinding);
 
-            else //if (bufferDescr.updateType == ConstBufferDescriptor::ConstBufferUpdateType::Static)
-            {
-                //for dynamic buffers just copy it's handle to corresponding slot
-                bufferHandle = currShader->GetDynamicBuffer(bufferDescr.type, bufferDescr.targetSlot);
-            }
+            bufferHandle = bufferBinding->constBuffer;
+        }
 
-            if (bufferHandle.IsValid())
-            {
-                if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
-                    currRenderVariant->vertexConstBuffers[bufferDescr.targetSlot] = bufferHandle;
-                else
-                    currRenderVariant->fragmentConstBuffers[bufferDescr.targetSlot] = bufferHandle;
-            }
+        else //if (bufferDescr.updateType == ConstBufferDescriptor::ConstBufferUpdateType::Static)
+        {
+            //for dynamic buffers just copy it's handle to corresponding slot
+            bufferHandle = currShader->GetDynamicBuffer(bufferDescr.type, bufferDescr.targetSlot);
         }
-    }
 
-    needRebuildBindings = false;
+        if (bufferHandle.IsValid())
+        {
+            if (bufferDescr.type == ConstBufferDescriptor::Type::Vertex)
+                currRenderVariant->vertexConstBuffers[bufferDescr.targetSlot] = bufferHandle;
+            else
+                currRenderVariant->fragmentConstBuffers[bufferDescr.targetSlot] = bufferHandle;
+        }
+    }
 }
 
 void NMaterial::RebuildTextureBindings()
 {
     InvalidateTextureBindings();
 
-    const AnisotropyQuality* anisotropicQuality =
-    QualitySettingsSystem::Instance()->GetAnisotropyQuality(QualitySettingsSystem::Instance()->GetCurAnisotropyQuality());
-
-    uint32_t anisotropyLevel = (anisotropicQuality == nullptr) ? 1 : std::min(anisotropicQuality->maxAnisotropy, rhi::DeviceCaps().maxAnisotropy);
+    uint32 anisotropyLevel = NMaterialDetail::GetAnisotropyLevel();
 
     for (auto& variant : renderVariants)
+        RebuildVariantTextureBindings(variant.second, anisotropyLevel);
+    for (auto& variant : instancedRenderVariants)
     {
-        RenderVariantInstance* currRenderVariant = variant.second;
+        if (variant.second != nullptr)
+            RebuildVariantTextureBindings(variant.second, anisotropyLevel);
+    }
 
-        //release existing
-        rhi::ReleaseTextureSet(currRenderVariant->textureSet);
-        rhi::ReleaseSamplerState(currRenderVariant->samplerState);
+    needRebuildTextures = false;
+}
 
-        ShaderDescriptor* currShader = currRenderVariant->shader;
-        if (!currShader->IsValid()) //cant build for empty shader
-            continue;
-        rhi::TextureSetDescriptor textureDescr;
-        rhi::SamplerState::Descriptor samplerDescr;
-        const rhi::ShaderSamplerList& fragmentSamplerList = currShader->GetFragmentSamplerList();
-        const rhi::ShaderSamplerList& vertexSamplerList = currShader->GetVertexSamplerList();
-
-        textureDescr.fragmentTextureCount = static_cast<uint32>(fragmentSamplerList.size());
-        samplerDescr.fragmentSamplerCount = static_cast<uint32>(fragmentSamplerList.size());
-        for (size_t i = 0, sz = textureDescr.fragmentTextureCount; i < sz; ++i)
-        {
-            RuntimeTextures::eDynamicTextureSemantic textureSemantic = RuntimeTextures::GetDynamicTextureSemanticByName(currShader->GetFragmentSamplerList()[i].uid);
-            if (textureSemantic == RuntimeTextures::TEXTURE_STATIC)
-            {
-                Texture* tex = GetEffectiveTexture(fragmentSamplerList[i].uid);
-                if (tex)
-                {
-                    textureDescr.fragmentTexture[i] = tex->handle;
-                    samplerDescr.fragmentSampler[i] = tex->samplerState;
-                }
-                else
-                {
-                    textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(fragmentSamplerList[i].type);
-                    samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(fragmentSamplerList[i].type);
+void NMaterial::RebuildVariantTextureBindings(RenderVariantInstance* currRenderVariant, uint32 anisotropyLevel)
+{
+    //release existing
+    rhi::ReleaseTextureSet(currRenderVariant->textureSet);
+    rhi::ReleaseSamplerState(currRenderVariant->samplerState);
 
-                    Logger::FrameworkDebug(" no texture for slot : %s", fragmentSamplerList[i].uid.c_str());
-                }
-            }
-            else
-            {
-                textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetDynamicTexture(textureSemantic);
-                samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetDynamicTextureSamplerState(textureSemantic);
-            }
-            samplerDescr.fragmentSampler[i].anisotropyLevel = anisotropyLevel;
-            DVASSERT(textureDescr.fragmentTexture[i].IsValid());
-        }
+    ShaderDescriptor* currShader = currRenderVariant->shader;
+    if (!currShader->IsValid()) //cant build for empty shader
+        return;
+    rhi::TextureSetDescriptor textureDescr;
+    rhi::SamplerState::Descriptor samplerDescr;
+    const rhi::ShaderSamplerList& fragmentSamplerList = currShader->GetFragmentSamplerList();
+    const rhi::ShaderSamplerList& vertexSamplerList = currShader->GetVertexSamplerList();
 
-        textureDescr.vertexTextureCount = static_cast<uint32>(vertexSamplerList.size());
-        samplerDescr.vertexSamplerCount = static_cast<uint32>(vertexSamplerList.size());
-        for (size_t i = 0, sz = textureDescr.vertexTextureCount; i < sz; ++i)
+    textureDescr.fragmentTextureCount = static_cast<uint32>(fragmentSamplerList.size());
+    samplerDescr.fragmentSamplerCount = static_cast<uint32>(fragmentSamplerList.size());
+    for (size_t i = 0, sz = textureDescr.fragmentTextureCount; i < sz; ++i)
+    {
+        RuntimeTextures::eDynamicTextureSemantic textureSemantic = RuntimeTextures::GetDynamicTextureSemanticByName(currShader->GetFragmentSamplerList()[i].uid);
+        if (textureSemantic == RuntimeTextures::TEXTURE_STATIC)
         {
-            Texture* tex = GetEffectiveTexture(vertexSamplerList[i].uid);
+            Texture* tex = GetEffectiveTexture(fragmentSamplerList[i].uid);
             if (tex)
             {
-                textureDescr.vertexTexture[i] = tex->handle;
-                samplerDescr.vertexSampler[i] = tex->samplerState;
+                textureDescr.fragmentTexture[i] = tex->handle;
+                samplerDescr.fragmentSampler[i] = tex->samplerState;
             }
             else
             {
-                textureDescr.vertexTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(vertexSamplerList[i].type);
-                samplerDescr.vertexSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(vertexSamplerList[i].type);
+                textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(fragmentSamplerList[i].type);
+                samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(fragmentSamplerList[i].type);
+
+                Logger::FrameworkDebug(" no texture for slot : %s", fragmentSamplerList[i].uid.c_str());
             }
         }
+        else
+        {
+            textureDescr.fragmentTexture[i] = Renderer::GetRuntimeTextures().GetDynamicTexture(textureSemantic);
+            samplerDescr.fragmentSampler[i] = Renderer::GetRuntimeTextures().GetDynamicTextureSamplerState(textureSemantic);
+        }
+        samplerDescr.fragmentSampler[i].anisotropyLevel = anisotropyLevel;
+        DVASSERT(textureDescr.fragmentTexture[i].IsValid());
+    }
 
-        currRenderVariant->textureSet = rhi::AcquireTextureSet(textureDescr);
-        currRenderVariant->samplerState = rhi::AcquireSamplerState(samplerDescr);
+    textureDescr.vertexTextureCount = static_cast<uint32>(vertexSamplerList.size());
+    samplerDescr.vertexSamplerCount = static_cast<uint32>(vertexSamplerList.size());
+    for (size_t i = 0, sz = textureDescr.vertexTextureCount; i < sz; ++i)
+    {
+        Texture* tex = GetEffectiveTexture(vertexSamplerList[i].uid);
+        if (tex)
+        {
+            textureDescr.vertexTexture[i] = tex->handle;
+            samplerDescr.vertexSampler[i] = tex->samplerState;
+        }
+        else
+        {
+            textureDescr.vertexTexture[i] = Renderer::GetRuntimeTextures().GetPinkTexture(vertexSamplerList[i].type);
+            samplerDescr.vertexSampler[i] = Renderer::GetRuntimeTextures().GetPinkTextureSamplerState(vertexSamplerList[i].type);
+        }
     }
 
-    needRebuildTextures = false;
+    currRenderVariant->textureSet = rhi::AcquireTextureSet(textureDescr);
+    currRenderVariant->samplerState = rhi::AcquireSamplerState(samplerDescr);
 }
 
 bool NMaterial::PreBuildMaterial(const FastName& passName)
@@ -1087,6 +1221,7 @@ bool NMaterial::PreBuildMaterial(const FastName& passName)
         {
             activeVariantName = passName;
             activeVariantInstance = it->second;
+            activeInstancedVariantInstance = nullptr;
 
             res = (activeVariantInstance->shader->IsValid());
         }
@@ -1098,6 +1233,73 @@ bool NMaterial::PreBuildMaterial(const FastName& passName)
     return res;
 }
 
+bool NMaterial::PreBuildInstancedMaterial()
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    if ((activeVariantInstance == nullptr) || !activeVariantInstance->shader->IsValid())
+        return false;
+
+    if (activeInstancedVariantInstance == nullptr)
+    {
+        auto it = instancedRenderVariants.find(activeVariantName);
+        if (it == instancedRenderVariants.end())
+        {
+            //nullptr is stored too, so unsupported variants are not checked every frame
+            it = instancedRenderVariants.emplace(activeVariantName, BuildInstancedVariant(activeVariantName, activeVariantInstance)).first;
+        }
+        activeInstancedVariantInstance = it->second;
+    }
+
+    return (activeInstancedVariantInstance != nullptr);
+}
+
+RenderVariantInstance* NMaterial::BuildInstancedVariant(const FastName& passName, RenderVariantInstance* variant)
+{
+    if (!NMaterialDetail::CanDrawInstanced(variant->shader))
+        return nullptr;
+
+    UnorderedMap<FastName, int32> flags(16);
+    CollectMaterialFlags(flags);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    flags[NMaterialFlagName::FLAG_AUTO_INSTANCING] = 1;
+    const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
+
+    for (auto& variantDescr : fxDescr.renderPassDescriptors)
+    {
+        if (variantDescr.passName != passName)
+            continue;
+
+        //shaders not supporting AUTO_INSTANCING still use per-object matrices and have no per-instance data
+        ShaderDescriptor* shader = variantDescr.shader;
+        if (!shader->IsValid() || (shader->GetRequiredVertexFormat() & NMaterialDetail::INSTANCE_DATA_VERTEX_FORMAT) != NMaterialDetail::INSTANCE_DATA_VERTEX_FORMAT)
+            return nullptr;
+
+        for (DynamicBindings::eUniformSemantic semantic : NMaterialDetail::INSTANCE_DERIVED_PARAMS)
+        {
+            if (shader->UsesDynamicParam(semantic))
+                return nullptr;
+        }
+
+        RenderVariantInstance* instancedVariant = new RenderVariantInstance();
+        instancedVariant->renderLayer = variant->renderLayer;
+        instancedVariant->depthState = variantDescr.depthStencilState;
+        instancedVariant->shader = shader;
+        instancedVariant->cullMode = variant->cullMode;
+        instancedVariant->wireFrame = variant->wireFrame;
+        instancedVariant->alphablend = variant->alphablend;
+        instancedVariant->alphatest = variant->alphatest;
+
+        RebuildVariantBindings(instancedVariant);
+        RebuildVariantTextureBindings(instancedVariant, NMaterialDetail::GetAnisotropyLevel());
+        return instancedVariant;
+    }
+
+    return nullptr;
+}
+
 NMaterial* NMaterial::Clone()
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
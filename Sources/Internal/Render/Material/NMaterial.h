@@ -7,6 +7,7 @@
 #include "NMaterialStateDynamicPropertiesInsp.h"
 #include "NMaterialStateDynamicTexturesInsp.h"
 #include "Render/Shader.h"
+#include "Render/ShaderCache.h"
 #include "Scene3D/DataNode.h"
 
 #include "MemoryManager/MemoryProfiler.h"
@@ -158,6 +159,8 @@ public:
 
     inline uint32 GetRenderLayerID() const;
     inline uint32 GetSortingKey() const;
+    // pipeline state and texture set of active variant packed as (p:16)(t:16), batches with equal key share render state
+    inline uint32 GetRenderStateSortingKey() const;
 
     //Configs managment
     uint32 GetConfigCount() const;
@@ -183,11 +186,19 @@ public:
     // later add engine flags here
     bool PreBuildMaterial(const FastName& passName);
 
+    // prepares variant of active pass which takes world matrix from per-instance vertex data (TEXCOORD4..TEXCOORD6),
+    // returns false if shader of active variant uses other per-object params or doesn't support AUTO_INSTANCING
+    bool PreBuildInstancedMaterial();
+    void BindInstancedParams(rhi::Packet& target);
+
     // RHI_COMPLETE - it's temporary solution to avoid FX loading and shaders compilation after loading
     void PreCacheFX();
     void PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName = FastName());
     void PreCacheFXVariations(const Vector<FastName>& fxNames, const Vector<FastName>& flags);
 
+    // appends shader permutations of material for `quality` without compiling them, used to precompile shaders offline
+    void CollectShaderPermutations(const FastName& quality, Vector<ShaderDescriptorCache::ShaderPermutation>& permutations);
+
     static const float32 DEFAULT_LIGHTMAP_SIZE;
 
     enum eUserFlag
@@ -204,6 +215,10 @@ private:
     void RebuildBindings();
     void RebuildTextureBindings();
     void RebuildRenderVariants();
+    void RebuildVariantBindings(RenderVariantInstance* currRenderVariant);
+    void RebuildVariantTextureBindings(RenderVariantInstance* currRenderVariant, uint32 anisotropyLevel);
+    RenderVariantInstance* BuildInstancedVariant(const FastName& passName, RenderVariantInstance* variant);
+    void BindVariantParams(RenderVariantInstance* variantInstance, rhi::Packet& target);
 
     bool NeedLocalOverride(UniquePropertyLayout propertyLayout);
     void ClearLocalBuffers();
@@ -243,6 +258,10 @@ private:
     // this is for render passes - not used right now - only active variant instance
     UnorderedMap<FastName, RenderVariantInstance*> renderVariants;
 
+    // built on demand by PreBuildInstancedMaterial, nullptr if pass can't be drawn instanced
+    UnorderedMap<FastName, RenderVariantInstance*> instancedRenderVariants;
+    RenderVariantInstance* activeInstancedVariantInstance = nullptr;
+
     uint32 sortingKey = 0;
     bool needRebuildBindings = true;
     bool needRebuildTextures = true;
@@ -286,6 +305,16 @@ uint32 NMaterial::GetSortingKey() const
 {
     return sortingKey;
 }
+uint32 NMaterial::GetRenderStateSortingKey() const
+{
+    if (activeVariantInstance == nullptr || activeVariantInstance->shader == nullptr)
+        return 0;
+
+    // low 16 bits of rhi handle are pool index
+    uint32 pipelineState = static_cast<rhi::Handle>(activeVariantInstance->shader->GetPiplineState()) & 0xFFFF;
+    uint32 textureSet = static_cast<rhi::Handle>(activeVariantInstance->textureSet) & 0xFFFF;
+    return (pipelineState << 16) | textureSet;
+}
 
 inline uint32 NMaterial::GetCurrentConfigIndex() const
 {
@@ -222,6 +222,8 @@ public:
     static const FastName FLAG_LANDSCAPE_LOD_MORPHING;
     static const FastName FLAG_LANDSCAPE_MORPHING_COLOR;
 
+    static const FastName FLAG_AUTO_INSTANCING;
+
     static const FastName FLAG_HEIGHTMAP_FLOAT_TEXTURE;
 
     //Illumination params
@@ -8,6 +8,8 @@
 #include "Concurrency/LockGuard.h"
 #include "MemoryManager/MemoryProfiler.h"
 
+#include <atomic>
+
 #if (RHI_RESOURCE_INCLUDE_BACKTRACE)
 #include "Debug/Backtrace.h"
 #endif
@@ -49,6 +51,10 @@ enum eHandleMasks : uint32
 
 #define RHI_HANDLE_INDEX(h) ((h & HANDLE_INDEX_MASK) >> HANDLE_INDEX_SHIFT)
 
+// Alloc, Free, Get and IsAlive are lock-free and may be called from any thread:
+// free entries form a list with tagged head (tag is bumped on every change to prevent ABA),
+// entry state keeps allocation flag and generation, so handle validation is a single atomic load.
+// Lock/Unlock only serialize ReleaseAll/ReCreateAll and iteration.
 template <class T, ResourceType RT, typename DT, bool need_restore = false>
 class
 ResourcePool
@@ -81,7 +87,7 @@ public:
             do
             {
                 ++entry;
-            } while (entry != end && !entry->allocated);
+            } while (entry != end && !entry->IsAllocated());
         }
         T* operator->()
         {
@@ -109,7 +115,7 @@ public:
             : entry(e)
             , end(e_end)
         {
-            while (entry != end && !entry->allocated)
+            while (entry != end && !entry->IsAllocated())
             {
                 ++entry;
             }
@@ -123,14 +129,31 @@ public:
     static Iterator End();
 
 private:
+    enum : uint32
+    {
+        ENTRY_ALLOCATED = 0x1U,
+        ENTRY_GENERATION_SHIFT = 1,
+        ENTRY_GENERATION_MASK = HANDLE_GENERATION_MASK >> HANDLE_GENERATION_SHIFT,
+
+        FREE_LIST_END = HANDLE_INDEX_MASK
+    };
+
     struct Entry
     {
         T object;
 
-        uint32 allocated : 1;
-        uint32 generation : 8;
-        uint32 nextObjectIndex : 16;
-        uint32 pad : 7;
+        std::atomic<uint32> state; // (generation << ENTRY_GENERATION_SHIFT) | ENTRY_ALLOCATED
+        std::atomic<uint32> nextObjectIndex;
+
+        bool IsAllocated() const
+        {
+            return (state.load(std::memory_order_acquire) & ENTRY_ALLOCATED) != 0;
+        }
+
+        uint32 Generation() const
+        {
+            return state.load(std::memory_order_acquire) >> ENTRY_GENERATION_SHIFT;
+        }
 
 #if (RHI_RESOURCE_INCLUDE_BACKTRACE)
         enum : uint32
@@ -150,22 +173,29 @@ private:
 #endif
     };
 
-    static Entry* Object;
+    static Entry* InitObjects();
+
+    static uint64 MakeHead(uint64 prevHead, uint32 index)
+    {
+        return (((prevHead >> 32) + 1) << 32) | index;
+    }
+
+    static std::atomic<Entry*> Object;
     static uint32 ObjectCount;
-    static uint32 HeadIndex;
+    static std::atomic<uint64> Head; // (tag:32)(index:32)
     static DAVA::Spinlock ObjectSync;
 };
 
 #define RHI_IMPL_POOL(T, RT, DT, nr) \
-template <> rhi::ResourcePool<T, RT, DT, nr>::Entry* rhi::ResourcePool<T, RT, DT, nr>::Object = 0;    \
+template <> std::atomic<rhi::ResourcePool<T, RT, DT, nr>::Entry*> rhi::ResourcePool<T, RT, DT, nr>::Object(nullptr);    \
 template <> uint32 rhi::ResourcePool<T, RT, DT, nr>::ObjectCount = 2048; \
-template <> uint32 rhi::ResourcePool<T, RT, DT, nr>::HeadIndex = 0;    \
+template <> std::atomic<uint64> rhi::ResourcePool<T, RT, DT, nr>::Head(0);    \
 template <> DAVA::Spinlock rhi::ResourcePool<T, RT, DT, nr>::ObjectSync = {};   \
 
 #define RHI_IMPL_POOL_SIZE(T, RT, DT, nr, sz) \
-template <> rhi::ResourcePool<T, RT, DT, nr>::Entry* rhi::ResourcePool<T, RT, DT, nr>::Object = 0;    \
+template <> std::atomic<rhi::ResourcePool<T, RT, DT, nr>::Entry*> rhi::ResourcePool<T, RT, DT, nr>::Object(nullptr);    \
 template <> uint32 rhi::ResourcePool<T, RT, DT, nr>::ObjectCount = sz;   \
-template <> uint32 rhi::ResourcePool<T, RT, DT, nr>::HeadIndex = 0;    \
+template <> std::atomic<uint64> rhi::ResourcePool<T, RT, DT, nr>::Head(0);    \
 template <> DAVA::Spinlock rhi::ResourcePool<T, RT, DT, nr>::ObjectSync = {};
 
 //------------------------------------------------------------------------------
@@ -175,7 +205,7 @@ inline void
 ResourcePool<T, RT, DT, nr>::Reserve(unsigned maxCount)
 {
     DAVA::LockGuard<DAVA::Spinlock> lock(ObjectSync);
-    DVASSERT(Object == nullptr);
+    DVASSERT(Object.load(std::memory_order_relaxed) == nullptr);
     DVASSERT(maxCount < HANDLE_INDEX_MASK);
     ObjectCount = maxCount;
 }
@@ -183,44 +213,74 @@ ResourcePool<T, RT, DT, nr>::Reserve(unsigned maxCount)
 //------------------------------------------------------------------------------
 
 template <class T, ResourceType RT, class DT, bool nr>
-inline Handle ResourcePool<T, RT, DT, nr>::Alloc()
+inline typename ResourcePool<T, RT, DT, nr>::Entry*
+ResourcePool<T, RT, DT, nr>::InitObjects()
 {
     DAVA::LockGuard<DAVA::Spinlock> lock(ObjectSync);
 
-    uint32 handle = InvalidHandle;
-    if (!Object)
+    Entry* objects = Object.load(std::memory_order_relaxed);
+    if (objects == nullptr)
     {
+        DVASSERT(ObjectCount < HANDLE_INDEX_MASK);
+
         DAVA_MEMORY_PROFILER_ALLOC_SCOPE(DAVA::ALLOC_POOL_RHI_RESOURCE_POOL);
-        Object = new Entry[ObjectCount];
+        objects = new Entry[ObjectCount];
 
         uint32 objectIndex = 0;
         while (objectIndex < ObjectCount)
         {
-            Entry& e = Object[objectIndex];
-            e.allocated = false;
-            e.generation = 0;
+            Entry& e = objects[objectIndex];
+            e.state.store(0, std::memory_order_relaxed);
 
             ++objectIndex;
-            e.nextObjectIndex = objectIndex;
+            e.nextObjectIndex.store(objectIndex, std::memory_order_relaxed);
         }
 
-        (Object + ObjectCount - 1)->nextObjectIndex = 0;
+        objects[ObjectCount - 1].nextObjectIndex.store(FREE_LIST_END, std::memory_order_relaxed);
+
+        Head.store(0, std::memory_order_relaxed);
+        Object.store(objects, std::memory_order_release);
     }
 
-    Entry* e = Object + HeadIndex;
-    RHI_POOL_ASSERT(!e->allocated, DAVA::Format("[RHIPool] Failed to allocate handle: pool is empty | Pool<%d>", RT).c_str());
-    HeadIndex = e->nextObjectIndex;
+    return objects;
+}
 
-    e->allocated = true;
-    ++e->generation;
+//------------------------------------------------------------------------------
+
+template <class T, ResourceType RT, class DT, bool nr>
+inline Handle ResourcePool<T, RT, DT, nr>::Alloc()
+{
+    Entry* objects = Object.load(std::memory_order_acquire);
+    if (objects == nullptr)
+    {
+        objects = InitObjects();
+    }
+
+    uint32 index = FREE_LIST_END;
+    uint64 head = Head.load(std::memory_order_acquire);
+    do
+    {
+        index = uint32(head);
+        if (index == FREE_LIST_END)
+        {
+            RHI_POOL_ASSERT(false, DAVA::Format("[RHIPool] Failed to allocate handle: pool is empty | Pool<%d>", RT).c_str());
+            return InvalidHandle;
+        }
+    } while (!Head.compare_exchange_weak(head, MakeHead(head, objects[index].nextObjectIndex.load(std::memory_order_relaxed)), std::memory_order_acq_rel, std::memory_order_acquire));
+
+    Entry* e = objects + index;
+    uint32 state = e->state.load(std::memory_order_relaxed);
+    RHI_POOL_ASSERT((state & ENTRY_ALLOCATED) == 0, DAVA::Format("[RHIPool] Failed to allocate handle: entry is already allocated | Pool<%d>", RT).c_str());
+
+    uint32 generation = ((state >> ENTRY_GENERATION_SHIFT) + 1) & ENTRY_GENERATION_MASK;
+    e->state.store((generation << ENTRY_GENERATION_SHIFT) | ENTRY_ALLOCATED, std::memory_order_release);
 
 #if (RHI_RESOURCE_INCLUDE_BACKTRACE)
     e->CaptureBacktrace();
 #endif
 
-    handle = 0;
-    handle = ((uint32(e - Object) << HANDLE_INDEX_SHIFT) & HANDLE_INDEX_MASK) |
-    (((e->generation) << HANDLE_GENERATION_SHIFT) & HANDLE_GENERATION_MASK) |
+    uint32 handle = ((index << HANDLE_INDEX_SHIFT) & HANDLE_INDEX_MASK) |
+    ((generation << HANDLE_GENERATION_SHIFT) & HANDLE_GENERATION_MASK) |
     ((RT << HANDLE_TYPE_SHIFT) & HANDLE_TYPE_MASK);
 
     return handle;
@@ -238,14 +298,19 @@ inline void ResourcePool<T, RT, DT, nr>::Free(Handle h)
     RHI_POOL_ASSERT(type == RT, DAVA::Format("[RHIPool] Failed to free handle: mismatch resource type | Pool<%d>, handle(type: %d, index: %d, generation: %d)", RT, HANDLE_DECOMPOSE(h)).c_str());
     RHI_POOL_ASSERT(index < ObjectCount, DAVA::Format("[RHIPool] Failed to free handle: index out of bounds | Pool<%d>, handle(type: %d, index: %d, generation: %d)", RT, HANDLE_DECOMPOSE(h)).c_str());
 
-    Entry* e = Object + index;
-    RHI_POOL_ASSERT(e->allocated, DAVA::Format("[RHIPool] Failed to free handle: handle already freed | Pool<%d>", RT).c_str());
+    Entry* e = Object.load(std::memory_order_acquire) + index;
+    uint32 generation = (h & HANDLE_GENERATION_MASK) >> HANDLE_GENERATION_SHIFT;
+    uint32 state = (generation << ENTRY_GENERATION_SHIFT) | ENTRY_ALLOCATED;
+    bool freed = e->state.compare_exchange_strong(state, generation << ENTRY_GENERATION_SHIFT, std::memory_order_acq_rel);
+    RHI_POOL_ASSERT(freed, DAVA::Format("[RHIPool] Failed to free handle: handle already freed | Pool<%d>, handle(type: %d, index: %d, generation: %d)", RT, HANDLE_DECOMPOSE(h)).c_str());
+    if (!freed)
+        return;
 
-    ObjectSync.Lock();
-    e->nextObjectIndex = HeadIndex;
-    HeadIndex = index;
-    e->allocated = false;
-    ObjectSync.Unlock();
+    uint64 head = Head.load(std::memory_order_relaxed);
+    do
+    {
+        e->nextObjectIndex.store(uint32(head), std::memory_order_relaxed);
+    } while (!Head.compare_exchange_weak(head, MakeHead(head, index), std::memory_order_release, std::memory_order_relaxed));
 }
 
 //------------------------------------------------------------------------------
@@ -257,9 +322,9 @@ inline T* ResourcePool<T, RT, DT, nr>::Get(Handle h)
     RHI_POOL_ASSERT(((h & HANDLE_TYPE_MASK) >> HANDLE_TYPE_SHIFT) == RT, DAVA::Format("[RHIPool] Failed to get resource by handle: invalid resource type | Pool<%d>, handle(type: %d, index: %d, generation: %d)", RT, HANDLE_DECOMPOSE(h)).c_str());
     uint32 index = (h & HANDLE_INDEX_MASK) >> HANDLE_INDEX_SHIFT;
     RHI_POOL_ASSERT(index < ObjectCount, DAVA::Format("[RHIPool] Failed to get resource by handle: index out of bounds | Pool<%d>, handle(type: %d, index: %d, generation: %d)", RT, HANDLE_DECOMPOSE(h)).c_str());
-    Entry* e = Object + index;
-    RHI_POOL_ASSERT(e->allocated, DAVA::Format("[RHIPool] Failed to get resource by handle: not allocated | Pool<%d>, handle(type: %d, index: %d, generation: %d), last valid generation was %d", RT, HANDLE_DECOMPOSE(h), e->generation).c_str());
-    RHI_POOL_ASSERT(e->generation == ((h & HANDLE_GENERATION_MASK) >> HANDLE_GENERATION_SHIFT), DAVA::Format("[RHIPool] Failed to get resource by handle: requested generation mismatch | Pool<%d>, handle(type: %d, index: %d, generation: %d), current valid generation is %d", RT, HANDLE_DECOMPOSE(h), e->generation).c_str());
+    Entry* e = Object.load(std::memory_order_acquire) + index;
+    RHI_POOL_ASSERT(e->IsAllocated(), DAVA::Format("[RHIPool] Failed to get resource by handle: not allocated | Pool<%d>, handle(type: %d, index: %d, generation: %d), last valid generation was %d", RT, HANDLE_DECOMPOSE(h), e->Generation()).c_str());
+    RHI_POOL_ASSERT(e->Generation() == ((h & HANDLE_GENERATION_MASK) >> HANDLE_GENERATION_SHIFT), DAVA::Format("[RHIPool] Failed to get resource by handle: requested generation mismatch | Pool<%d>, handle(type: %d, index: %d, generation: %d), current valid generation is %d", RT, HANDLE_DECOMPOSE(h), e->Generation()).c_str());
 
     return &(e->object);
 }
@@ -274,8 +339,9 @@ inline bool ResourcePool<T, RT, DT, nr>::IsAlive(Handle h)
     uint32 index = (h & HANDLE_INDEX_MASK) >> HANDLE_INDEX_SHIFT;
     RHI_POOL_ASSERT(index < ObjectCount, DAVA::Format("[RHIPool] Failed to check (is alive) resource by handle: index out of bounds | Pool<%d>, handle(type: %d, index: %d, generation: %d)", RT, HANDLE_DECOMPOSE(h)).c_str());
 
-    Entry* e = Object + index;
-    return e->allocated && (e->generation == ((h & HANDLE_GENERATION_MASK) >> HANDLE_GENERATION_SHIFT));
+    Entry* e = Object.load(std::memory_order_acquire) + index;
+    uint32 state = ((h & HANDLE_GENERATION_MASK) >> HANDLE_GENERATION_SHIFT << ENTRY_GENERATION_SHIFT) | ENTRY_ALLOCATED;
+    return e->state.load(std::memory_order_acquire) == state;
 }
 
 //------------------------------------------------------------------------------
@@ -284,7 +350,8 @@ template <class T, ResourceType RT, typename DT, bool nr>
 inline typename ResourcePool<T, RT, DT, nr>::Iterator
 ResourcePool<T, RT, DT, nr>::Begin()
 {
-    return (Object) ? Iterator(Object, Object + ObjectCount) : Iterator(nullptr, nullptr);
+    Entry* objects = Object.load(std::memory_order_acquire);
+    return (objects) ? Iterator(objects, objects + ObjectCount) : Iterator(nullptr, nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -293,7 +360,8 @@ template <class T, ResourceType RT, typename DT, bool nr>
 inline typename ResourcePool<T, RT, DT, nr>::Iterator
 ResourcePool<T, RT, DT, nr>::End()
 {
-    return (Object) ? Iterator(Object + ObjectCount, Object + ObjectCount) : Iterator(nullptr, nullptr);
+    Entry* objects = Object.load(std::memory_order_acquire);
+    return (objects) ? Iterator(objects + ObjectCount, objects + ObjectCount) : Iterator(nullptr, nullptr);
 }
 
 //------------------------------------------------------------------------------
@@ -139,6 +139,7 @@ private:
 };
 
 static ShaderFileCallback ShaderSourceFileCallback("~res:/Materials/Shaders");
+static Mutex shaderSourceFileCallbackMutex; // include cache is shared by all shader sources
 
 //==============================================================================
 
@@ -169,6 +170,13 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText)
 //------------------------------------------------------------------------------
 
 bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines)
+{
+    return ShaderSource::Construct(progType, srcText, defines, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api targetApi)
 {
     bool success = false;
     DAVA::PreProc pre_proc(&ShaderSourceFileCallback);
@@ -182,7 +190,13 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
         pre_proc.AddDefine(name, value);
     }
 
-    if (pre_proc.Process(srcText, &src))
+    bool preprocessed = false;
+    {
+        LockGuard<Mutex> guard(shaderSourceFileCallbackMutex);
+        preprocessed = pre_proc.Process(srcText, &src);
+    }
+
+    if (preprocessed)
     {
         #if RHI_DUMP_SHADERSOURCE
         {
@@ -257,7 +271,7 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::
                 InlineFunctions();
 
             // ugly workaround to save some memory
-            GetSourceCode(HostApi());
+            GetSourceCode(targetApi);
             delete ast;
             ast = nullptr;
         }
@@ -1742,10 +1756,11 @@ const DAVA::String& ShaderSource::GetSourceCode(Api targetApi) const
 
     if (code[targetApi].empty() && (ast != nullptr))
     {
+        // generators keep state while generating, so they are not shared between threads
         static sl::Allocator alloc;
-        static sl::HLSLGenerator hlsl_gen(&alloc);
-        static sl::GLESGenerator gles_gen(&alloc);
-        static sl::MSLGenerator mtl_gen(&alloc);
+        sl::HLSLGenerator hlsl_gen(&alloc);
+        sl::GLESGenerator gles_gen(&alloc);
+        sl::MSLGenerator mtl_gen(&alloc);
 
         bool codeGenerated = false;
         const char* main = (type == PROG_VERTEX) ? "vp_main" : "fp_main";
@@ -1898,11 +1913,13 @@ void ShaderSource::Reset()
 
 void ShaderSource::AddIncludeDirectory(const char* dir)
 {
+    LockGuard<Mutex> guard(shaderSourceFileCallbackMutex);
     ShaderSourceFileCallback.AddIncludeDirectory(dir);
 }
 
 void ShaderSource::PurgeIncludesCache()
 {
+    LockGuard<Mutex> guard(shaderSourceFileCallbackMutex);
     ShaderSourceFileCallback.ClearCache();
 }
 
@@ -2024,13 +2041,19 @@ Mutex shaderSourceEntryMutex;
 std::vector<ShaderSourceCache::entry_t> ShaderSourceCache::Entry;
 
 const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
+{
+    return ShaderSourceCache::Get(uid, srcHash, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash, Api api)
 {
     LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
     //    Logger::Info("get-shader-src (host-api = %i)",HostApi());
     //    Logger::Info("  uid= \"%s\"",uid.c_str());
     const ShaderSource* src = nullptr;
-    Api api = HostApi();
 
     for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
     {
@@ -2047,14 +2070,20 @@ const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 
 //------------------------------------------------------------------------------
 const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines)
+{
+    return ShaderSourceCache::Add(filename, uid, progType, srcText, defines, HostApi());
+}
+
+//------------------------------------------------------------------------------
+
+const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api api)
 {
     ShaderSource* src = new ShaderSource(filename);
 
-    if (src->Construct(progType, srcText, defines))
+    if (src->Construct(progType, srcText, defines, api))
     {
         LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
-        uint32 api = HostApi();
         uint32 srcHash = DAVA::HashValue_N(srcText, unsigned(strlen(srcText)));
 
         bool doAdd = true;
@@ -2092,6 +2121,14 @@ const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, P
 
 //------------------------------------------------------------------------------
 
+uint32 ShaderSourceCache::GetEntryCount()
+{
+    LockGuard<Mutex> guard(shaderSourceEntryMutex);
+    return static_cast<uint32>(Entry.size());
+}
+
+//------------------------------------------------------------------------------
+
 void ShaderSourceCache::Clear()
 {
     LockGuard<Mutex> guard(shaderSourceEntryMutex);
@@ -2149,7 +2186,7 @@ void ShaderSourceCache::Save(const char* fileName)
 
 //------------------------------------------------------------------------------
 
-void ShaderSourceCache::Load(const char* fileName)
+void ShaderSourceCache::Load(const char* fileName, bool append)
 {
     using namespace DAVA;
 
@@ -2157,15 +2194,21 @@ void ShaderSourceCache::Load(const char* fileName)
 
     if (file)
     {
-        Clear();
+        if (!append)
+        {
+            Clear();
+        }
 
+        std::vector<entry_t> loaded;
         bool success = true;
         SCOPE_EXIT
         {
+            for (const entry_t& e : loaded)
+                delete e.src;
+
             if (!success)
             {
-                Clear();
-                Logger::Warning("ShaderSource-Cache failed to load, ignoring cached shaders\n");
+                Logger::Warning("ShaderSource-Cache %s failed to load, ignoring cached shaders\n", fileName);
             }
         };
         
@@ -2176,14 +2219,12 @@ void ShaderSourceCache::Load(const char* fileName)
 
         if (formatVersion == FormatVersion)
         {
-            LockGuard<Mutex> guard(shaderSourceEntryMutex);
-
             uint32 entryCount = 0;
             READ_CHECK(ReadUI4(file, &entryCount));
-            Entry.resize(entryCount);
-            Logger::Info("loading cached-shaders (%u): ", Entry.size());
+            loaded.resize(entryCount);
+            Logger::Info("loading cached-shaders (%u) from %s", entryCount, fileName);
 
-            for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+            for (std::vector<entry_t>::iterator e = loaded.begin(), e_end = loaded.end(); e != e_end; ++e)
             {
                 std::string str;
                 READ_CHECK(ReadS0(file, &str));
@@ -2194,6 +2235,29 @@ void ShaderSourceCache::Load(const char* fileName)
 
                 READ_CHECK(e->src->Load(Api(e->api), file));
             }
+
+            LockGuard<Mutex> guard(shaderSourceEntryMutex);
+
+            const size_t presentCount = Entry.size();
+            Entry.reserve(presentCount + loaded.size());
+            for (entry_t& l : loaded)
+            {
+                bool present = false;
+                for (size_t i = 0; i != presentCount; ++i)
+                {
+                    if ((Entry[i].uid == l.uid) && (Entry[i].api == l.api) && (Entry[i].srcHash == l.srcHash))
+                    {
+                        present = true;
+                        break;
+                    }
+                }
+
+                if (!present)
+                {
+                    Entry.push_back(l);
+                    l.src = nullptr;
+                }
+            }
         }
         else
         {
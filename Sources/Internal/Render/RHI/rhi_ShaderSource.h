@@ -72,6 +72,7 @@ public:
     ~ShaderSource();
 
     bool Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines);
+    bool Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api targetApi);
     void InlineFunctions();
     bool Construct(ProgType progType, const char* srcText);
     bool Load(Api api, DAVA::File* in);
@@ -121,11 +122,16 @@ ShaderSourceCache
 {
 public:
     static const ShaderSource* Get(FastName uid, uint32 srcHash);
+    static const ShaderSource* Get(FastName uid, uint32 srcHash, Api api);
     static const ShaderSource* Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines);
+    // can be called from several threads at once, used to precompile shaders offline for `api` other than host one
+    static const ShaderSource* Add(const char* filename, FastName uid, ProgType progType, const char* srcText, const std::vector<std::string>& defines, Api api);
 
+    static uint32 GetEntryCount();
     static void Clear();
     static void Save(const char* fileName);
-    static void Load(const char* fileName);
+    // with `append` entries from file are merged into cache, entries with same uid, api and source hash are kept
+    static void Load(const char* fileName, bool append = false);
 
 private:
     struct
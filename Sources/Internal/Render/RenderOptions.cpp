@@ -35,6 +35,8 @@ FastName optionsNames[RenderOptions::OPTIONS_COUNT] =
   FastName("Update Particle Emitters"),
   FastName("Draw Particles"),
   FastName("Particle Prepare Buffers"),
+  FastName("Parallel Render Prepare"),
+  FastName("Auto Instancing"),
   FastName("Albedo mipmaps"),
   FastName("Lightmap mipmaps"),
 #if defined(LOCALIZATION_DEBUG)
@@ -43,6 +43,8 @@ public:
         UPDATE_PARTICLE_EMMITERS,
         PARTICLES_DRAW,
         PARTICLES_PREPARE_BUFFERS,
+        PARALLEL_RENDER_PREPARE,
+        AUTO_INSTANCING,
         REPLACE_ALBEDO_MIPMAPS,
         REPLACE_LIGHTMAP_MIPMAPS,
 #if defined(LOCALIZATION_DEBUG)
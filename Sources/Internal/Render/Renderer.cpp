@@ -303,6 +303,14 @@ void RenderStats::Reset()
     visibleRenderObjects = 0U;
     occludedRenderObjects = 0U;
 
+    shaderCacheHits = 0U;
+    shaderCacheMisses = 0U;
+    shaderSourceCompilations = 0U;
+    shaderCacheMissUs = 0U;
+
+    instancedBatches = 0U;
+    instancedPackets = 0U;
+
     visibilityQueryResults.clear();
 }
 
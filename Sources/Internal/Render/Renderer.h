@@ -94,6 +94,14 @@ struct RenderStats
     uint32 visibleRenderObjects = 0U;
     uint32 occludedRenderObjects = 0U;
 
+    uint32 shaderCacheHits = 0U;
+    uint32 shaderCacheMisses = 0U; // shader descriptors created this frame
+    uint32 shaderSourceCompilations = 0U; // misses not found in precompiled shader source cache
+    uint32 shaderCacheMissUs = 0U; // time spent creating shader descriptors
+
+    uint32 instancedBatches = 0U; // render batches merged into instanced packets
+    uint32 instancedPackets = 0U;
+
     UnorderedMap<FastName, uint32> visibilityQueryResults = UnorderedMap<FastName, uint32>(16);
 };
 }
@@ -119,6 +119,16 @@ void ShaderDescriptor::ClearDynamicBindings()
         dynamicBinding.updateSemantic = 0;
 }
 
+bool ShaderDescriptor::UsesDynamicParam(DynamicBindings::eUniformSemantic semantic) const
+{
+    for (const DynamicPropertyBinding& dynamicBinding : dynamicPropertyBindings)
+    {
+        if (dynamicBinding.dynamicPropertySemantic == semantic)
+            return true;
+    }
+    return false;
+}
+
 uint32 ShaderDescriptor::GetVertexConstBuffersCount()
 {
     return vertexConstBuffersCount;
@@ -55,6 +55,7 @@ public: //utility
 public:
     void UpdateDynamicParams();
     void ClearDynamicBindings();
+    bool UsesDynamicParam(DynamicBindings::eUniformSemantic semantic) const;
 
     uint32 GetVertexConstBuffersCount();
     uint32 GetFragmentConstBuffersCount();
@@ -1,11 +1,19 @@
 #include "Render/ShaderCache.h"
 #include "Render/RHI/rhi_ShaderCache.h"
+#include "Render/Renderer.h"
 #include "FileSystem/FileSystem.h"
 #include "Concurrency/LockGuard.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Job/JobScheduler.h"
 #include "Logger/Logger.h"
+#include "Time/SystemTimer.h"
 #include "Utils/StringFormat.h"
 #include "Render/RHI/rhi_ShaderSource.h"
 
+#include <atomic>
+
 #define RHI_TRACE_CACHE_USAGE 0
 
 namespace DAVA
@@ -189,20 +197,9 @@ void SetLoadingNotifyEnabled(bool enable)
 #define LOG_TRACE_USAGE(...)
 #endif
 
-ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+// returns readable name of permutation, `progDefines` are sorted by define name
+String BuildProgramDefines(const FastName& name, const UnorderedMap<FastName, int32>& defines, Vector<String>& progDefines)
 {
-    DVASSERT(initialized);
-
-    LockGuard<Mutex> guard(shaderCacheMutex);
-
-    Vector<size_t> key = BuildFlagsKey(name, defines);
-
-    auto descriptorIt = shaderDescriptors.find(key);
-    if (descriptorIt != shaderDescriptors.end())
-        return descriptorIt->second;
-
-    //not found - create new shader
-    Vector<String> progDefines;
     progDefines.reserve(defines.size() * 2);
     String resName(name.c_str());
     resName += "  defines: ";
@@ -231,6 +228,40 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     for (size_t i = 0; i != progDefines.size(); i += 2)
         resName += Format("%s = %s, ", progDefines[i + 0].c_str(), progDefines[i + 1].c_str());
 
+    return resName;
+}
+
+ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+{
+    DVASSERT(initialized);
+
+    LockGuard<Mutex> guard(shaderCacheMutex);
+
+    Vector<size_t> key = BuildFlagsKey(name, defines);
+
+    auto descriptorIt = shaderDescriptors.find(key);
+    if (descriptorIt != shaderDescriptors.end())
+    {
+#if defined(__DAVAENGINE_RENDERSTATS__)
+        ++Renderer::GetRenderStats().shaderCacheHits;
+#endif
+        return descriptorIt->second;
+    }
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+    RenderStats& stats = Renderer::GetRenderStats();
+    const int64 missStartUs = SystemTimer::GetUs();
+    ++stats.shaderCacheMisses;
+    SCOPE_EXIT
+    {
+        stats.shaderCacheMissUs += static_cast<uint32>(SystemTimer::GetUs() - missStartUs);
+    };
+#endif
+
+    //not found - create new shader
+    Vector<String> progDefines;
+    String resName = BuildProgramDefines(name, defines, progDefines);
+
     if (loadingNotifyEnabled)
     {
         Logger::Error("Forbidden call to GetShaderDescriptor %s", resName.c_str());
@@ -251,6 +282,9 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
 
     if (!vSource || !fSource)
     {
+#if defined(__DAVAENGINE_RENDERSTATS__)
+        ++stats.shaderSourceCompilations;
+#endif
         LOG_TRACE_USAGE("building \"%s\"", vProgUid.c_str());
         vSource = rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), progDefines);
         fSource = rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), progDefines);
@@ -342,6 +376,85 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     return res;
 }
 
+bool IsDefineUsed(const FastName& name, const FastName& define)
+{
+    LockGuard<Mutex> guard(shaderCacheMutex);
+    const ShaderSourceCode& sourceCode = GetSourceCode(name);
+    return (strstr(sourceCode.vertexProgText.data(), define.c_str()) != nullptr) ||
+    (strstr(sourceCode.fragmentProgText.data(), define.c_str()) != nullptr);
+}
+
+uint32 PrecompileShaderSources(const Vector<ShaderPermutation>& permutations, rhi::Api api)
+{
+    DVASSERT(initialized);
+
+    struct ProgramSources
+    {
+        ShaderSourceCode sourceCode;
+        Vector<String> progDefines;
+        FastName vProgUid;
+        FastName fProgUid;
+    };
+
+    Vector<ProgramSources> programs;
+    {
+        LockGuard<Mutex> guard(shaderCacheMutex);
+
+        Set<Vector<size_t>> keys;
+        for (const ShaderPermutation& permutation : permutations)
+        {
+            if (!keys.insert(BuildFlagsKey(permutation.name, permutation.defines)).second)
+                continue;
+
+            ProgramSources program;
+            String resName = BuildProgramDefines(permutation.name, permutation.defines, program.progDefines);
+            program.vProgUid = FastName(String("vSource: ") + resName);
+            program.fProgUid = FastName(String("fSource: ") + resName);
+            program.sourceCode = GetSourceCode(permutation.name);
+
+            bool cached = (rhi::ShaderSourceCache::Get(program.vProgUid, program.sourceCode.vSrcHash, api) != nullptr) &&
+            (rhi::ShaderSourceCache::Get(program.fProgUid, program.sourceCode.fSrcHash, api) != nullptr);
+            if (!cached)
+            {
+                programs.emplace_back(std::move(program));
+            }
+        }
+    }
+
+    // shader sources are parsed without cache lock, rhi::ShaderSourceCache guards its entries itself
+    std::atomic<uint32> constructedCount(0);
+    auto constructPrograms = [&programs, &constructedCount, api](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const ProgramSources& program = programs[i];
+            const ShaderSourceCode& sourceCode = program.sourceCode;
+            const rhi::ShaderSource* vSource = rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), program.vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), program.progDefines, api);
+            const rhi::ShaderSource* fSource = rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), program.fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), program.progDefines, api);
+            if (vSource != nullptr && fSource != nullptr)
+            {
+                ++constructedCount;
+            }
+            else
+            {
+                Logger::Error("failed to precompile \"%s\"", program.vProgUid.c_str());
+            }
+        }
+    };
+
+    uint32 programsCount = static_cast<uint32>(programs.size());
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr)
+    {
+        jobManager->GetScheduler()->ParallelFor(0, programsCount, 1, constructPrograms);
+    }
+    else
+    {
+        constructPrograms(0, programsCount);
+    }
+
+    return constructedCount;
+}
+
 void ReloadShaders()
 {
     DVASSERT(initialized);
@@ -8,6 +8,12 @@ namespace DAVA
 {
 namespace ShaderDescriptorCache
 {
+struct ShaderPermutation
+{
+    FastName name;
+    UnorderedMap<FastName, int32> defines;
+};
+
 void Initialize();
 void Uninitialize();
 void Clear();
@@ -19,5 +25,15 @@ void SetLoadingNotifyEnabled(bool enable);
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 Vector<size_t> BuildFlagsKey(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 size_t GetUniqueFlagKey(FastName flagName);
+
+/**
+    Construct shader sources of `permutations` for `api` in parallel jobs and add them to rhi::ShaderSourceCache.
+    Permutations already present in cache are skipped. Returns count of constructed permutations.
+    Saved cache is loaded on startup, so shaders are not parsed when descriptors are created in game.
+*/
+uint32 PrecompileShaderSources(const Vector<ShaderPermutation>& permutations, rhi::Api api);
+
+/** Return true if vertex or fragment program source of shader `name` mentions `define`. */
+bool IsDefineUsed(const FastName& name, const FastName& define);
 };
 };
@@ -34,10 +34,11 @@ ParticleEffectComponent::ParticleEffectComponent()
 {
     effectData.infoSources.resize(1);
     effectData.infoSources[0].size = Vector2(1, 1);
+    renderData.infoSources = effectData.infoSources;
 
     // world transform doesn't effect particle render object drawing
     // instead particles are generated in corresponding world position
-    effectRenderObject = new ParticleRenderObject(&effectData);
+    effectRenderObject = new ParticleRenderObject(&renderData);
     effectRenderObject->SetWorldMatrixPtr(&Matrix4::IDENTITY);
 
     if (QualitySettingsSystem::Instance()->IsOptionEnabled(QualitySettingsSystem::QUALITY_OPTION_LOD0_EFFECTS))
@@ -97,6 +98,7 @@ void ParticleEffectComponent::Stop(bool isDeleteAllParticles)
 {
     if (state == STATE_STOPPED)
         return;
+    WaitSimulation();
     if (isDeleteAllParticles)
     {
         ClearCurrentGroups();
@@ -127,7 +129,10 @@ bool ParticleEffectComponent::IsPaused()
 
 void ParticleEffectComponent::Step(float32 delta)
 {
-    GetEntity()->GetScene()->particleEffectSystem->UpdateEffect(this, delta, delta);
+    ParticleEffectSystem* system = GetEntity()->GetScene()->particleEffectSystem;
+    system->WaitSimulation();
+    system->UpdateEffect(this, delta, delta);
+    system->PublishRenderData(this);
 }
 
 void ParticleEffectComponent::Restart(bool isDeleteAllParticles)
@@ -151,24 +156,36 @@ void ParticleEffectComponent::StopWhenEmpty(bool value /*= true*/)
 
 void ParticleEffectComponent::ClearGroup(ParticleGroup& group)
 {
-    Particle* current = group.head;
-    while (current)
-    {
-        Particle* next = current->next;
-        delete current;
-        current = next;
-    }
+    group.particles.Clear();
     group.layer->Release();
     group.emitter->Release();
 }
 
 void ParticleEffectComponent::ClearCurrentGroups()
 {
+    WaitSimulation();
     for (List<ParticleGroup>::iterator it = effectData.groups.begin(), e = effectData.groups.end(); it != e; ++it)
     {
         ClearGroup(*it);
     }
     effectData.groups.clear();
+
+    // published groups hold own references to layers and emitters
+    for (ParticleGroup& group : renderData.groups)
+    {
+        ClearGroup(group);
+    }
+    renderData.groups.clear();
+}
+
+void ParticleEffectComponent::WaitSimulation()
+{
+    Entity* entity = GetEntity();
+    Scene* scene = (entity != nullptr) ? entity->GetScene() : nullptr;
+    if (scene != nullptr && scene->particleEffectSystem != nullptr)
+    {
+        scene->particleEffectSystem->WaitSimulation();
+    }
 }
 
 void ParticleEffectComponent::SetRenderObjectVisible(bool visible)
@@ -181,6 +198,7 @@ void ParticleEffectComponent::SetRenderObjectVisible(bool visible)
 
 void ParticleEffectComponent::SetGroupsFinishing()
 {
+    WaitSimulation();
     for (List<ParticleGroup>::iterator it = effectData.groups.begin(), e = effectData.groups.end(); it != e; ++it)
     {
         (*it).finishingGroup = true;
@@ -199,6 +217,7 @@ float32 ParticleEffectComponent::GetPlaybackSpeed()
 
 void ParticleEffectComponent::SetPlaybackSpeed(float32 value)
 {
+    WaitSimulation();
     playbackSpeed = value;
 }
 
@@ -216,6 +235,7 @@ void ParticleEffectComponent::SetDesiredLodLevel(int32 level)
 
 void ParticleEffectComponent::SetExtertnalValue(const String& name, float32 value)
 {
+    WaitSimulation();
     externalValues[name] = value;
     for (MultiMap<String, ModifiablePropertyLineBase *>::iterator it = externalModifiables.lower_bound(name), e = externalModifiables.upper_bound(name); it != e; ++it)
         (*it).second->SetModifier(value);
@@ -259,6 +279,7 @@ void ParticleEffectComponent::UnRegisterModifiable(ModifiablePropertyLineBase* p
 
 void ParticleEffectComponent::RebuildEffectModifiables()
 {
+    WaitSimulation();
     externalModifiables.clear();
     List<ModifiablePropertyLineBase*> modifiables;
     for (auto& instance : emitterInstances)
@@ -278,7 +299,7 @@ void ParticleEffectComponent::RebuildEffectModifiables()
 int32 ParticleEffectComponent::GetActiveParticlesCount()
 {
     int32 totalActiveParticles = 0;
-    for (List<ParticleGroup>::iterator it = effectData.groups.begin(), e = effectData.groups.end(); it != e; ++it)
+    for (List<ParticleGroup>::iterator it = renderData.groups.begin(), e = renderData.groups.end(); it != e; ++it)
         totalActiveParticles += (*it).activeParticleCount;
 
     return totalActiveParticles;
@@ -433,6 +454,7 @@ Vector3 ParticleEffectComponent::GetSpawnPosition(int32 id) const
 
 void ParticleEffectComponent::SetSpawnPosition(int32 id, const Vector3& position)
 {
+    WaitSimulation();
     DVASSERT((id >= 0) && (id < static_cast<int32>(emitterInstances.size())));
     emitterInstances[id]->SetSpawnPosition(position);
 }
@@ -462,11 +484,13 @@ ParticleEmitter* ParticleEffectComponent::GetEmitter(uint32 id) const
 
 void ParticleEffectComponent::AddEmitterInstance(ParticleEmitter* emitter)
 {
+    WaitSimulation();
     emitterInstances.emplace_back(new ParticleEmitterInstance(this, emitter));
 }
 
 void ParticleEffectComponent::AddEmitterInstance(ParticleEmitterInstance* instance)
 {
+    WaitSimulation();
     instance->SetOwner(this);
     emitterInstances.emplace_back(SafeRetain(instance));
 }
@@ -485,6 +509,7 @@ int32 ParticleEffectComponent::GetEmitterInstanceIndex(ParticleEmitterInstance*
 
 void ParticleEffectComponent::InsertEmitterInstanceAt(ParticleEmitterInstance* emitter, uint32 position)
 {
+    WaitSimulation();
     auto it = emitterInstances.begin();
     std::advance(it, DAVA::Min(position, GetEmittersCount()));
     emitter->SetOwner(this);
@@ -493,6 +518,7 @@ void ParticleEffectComponent::InsertEmitterInstanceAt(ParticleEmitterInstance* e
 
 void ParticleEffectComponent::RemoveEmitterInstance(ParticleEmitterInstance* emitter)
 {
+    WaitSimulation();
     auto findPred = [emitter](const DAVA::RefPtr<ParticleEmitterInstance>& qualityEmitter) {
         return (qualityEmitter->GetEmitter() == emitter->GetEmitter());
     };
@@ -506,7 +532,7 @@ void ParticleEffectComponent::RemoveEmitterInstance(ParticleEmitterInstance* emi
 int32 ParticleEffectComponent::GetLayerActiveParticlesCount(ParticleLayer* layer)
 {
     int32 count = 0;
-    for (List<ParticleGroup>::iterator it = effectData.groups.begin(), e = effectData.groups.end(); it != e; ++it)
+    for (List<ParticleGroup>::iterator it = renderData.groups.begin(), e = renderData.groups.end(); it != e; ++it)
     {
         if (it->layer == layer)
         {
@@ -518,15 +544,14 @@ int32 ParticleEffectComponent::GetLayerActiveParticlesCount(ParticleLayer* layer
 float32 ParticleEffectComponent::GetLayerActiveParticlesSquare(ParticleLayer* layer)
 {
     float32 square = 0;
-    for (List<ParticleGroup>::iterator it = effectData.groups.begin(), e = effectData.groups.end(); it != e; ++it)
+    for (List<ParticleGroup>::iterator it = renderData.groups.begin(), e = renderData.groups.end(); it != e; ++it)
     {
         if (it->layer == layer)
         {
-            Particle* currParticle = it->head;
-            while (currParticle)
+            const ParticleStorage& particles = it->particles;
+            for (uint32 i = 0, count = particles.GetCount(); i < count; ++i)
             {
-                square += currParticle->currSize.x * currParticle->currSize.y;
-                currParticle = currParticle->next;
+                square += particles.currSize[i].x * particles.currSize[i].y;
             }
         }
     }
@@ -565,6 +590,7 @@ void ParticleEffectComponent::SetClippingVisible(bool visible)
 
 void ParticleEffectComponent::ReloadEmitters()
 {
+    WaitSimulation();
     const ParticlesQualitySettings::FilepathSelector* filepathSelector = QualitySettingsSystem::Instance()->GetParticlesQualitySettings().GetOrCreateFilepathSelector();
 
     for (auto instance : emitterInstances)
@@ -88,6 +88,7 @@ private:
     void ClearGroup(ParticleGroup& group);
     void ClearCurrentGroups();
     void SetGroupsFinishing();
+    void WaitSimulation();
 
     /*completion message stuff*/
     Message playbackComplete;
@@ -99,7 +100,8 @@ private:
     /*Emitters setup*/
     Vector<RefPtr<ParticleEmitterInstance>> emitterInstances;
 
-    ParticleEffectData effectData;
+    ParticleEffectData effectData; // simulated by ParticleEffectSystem, possibly on job workers
+    ParticleEffectData renderData; // copy of effectData published after simulation, drawn by effectRenderObject
     ParticleRenderObject* effectRenderObject;
 
     eState state = STATE_STOPPED;
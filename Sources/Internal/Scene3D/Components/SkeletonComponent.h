@@ -82,7 +82,9 @@ private:
     //transforms info
     Vector<JointTransform> localSpaceTransforms;
     Vector<JointTransform> objectSpaceTransforms;
-    Vector<JointTransform> finalTransforms;
+    //final transforms packed for skinning: position in xyz and scale in w, orientation quaternion
+    Vector<Vector4> finalPositions;
+    Vector<Vector4> finalOrientations;
     //bind pose
     Vector<JointTransform> inverseBindTransforms;
     //bounding boxes
@@ -50,9 +50,11 @@ private:
     Matrix4 worldMatrix = Matrix4::IDENTITY;
     Transform* parentTransform = nullptr;
     Entity* parent = nullptr; //Entity::parent should be removed
+    uint32 hierarchyIndex = TransformSystem::INVALID_HIERARCHY_INDEX; // node of entity in TransformSystem hierarchy
 
     friend class TransformSystem;
     friend class FTransformComponent;
+    friend class SceneFileV2;
 
     DAVA_VIRTUAL_REFLECTION(TransformComponent, Component);
 };
@@ -479,26 +479,8 @@ void Entity::Save(KeyedArchive* archive, SerializationContext* serializationCont
     uint32 savedIndex = 0;
     for (Component* c : components)
     {
-        const ReflectedType* refType = ReflectedTypeDB::GetByType(c->GetType());
-
-        DVASSERT(refType != nullptr);
-
-        ReflectedMeta* meta = refType->GetStructure()->meta.get();
-
-        bool isSerializable = meta == nullptr || meta->GetMeta<M::NonSerializableComponent>() == nullptr;
-
-        if (isSerializable)
+        if (IsSerializableComponent(c))
         {
-            //don't save empty custom properties
-            if (c->GetType()->Is<CustomPropertiesComponent>())
-            {
-                CustomPropertiesComponent* customProps = CastIfEqual<CustomPropertiesComponent*>(c);
-                if (customProps && customProps->GetArchive()->Count() <= 0)
-                {
-                    continue;
-                }
-            }
-
             KeyedArchive* compArch = new KeyedArchive();
             c->Serialize(compArch, serializationContext);
             compsArch->SetArchive(KeyedArchive::GenKeyFromIndex(savedIndex), compArch);
@@ -545,19 +527,52 @@ void Entity::LoadComponentsV7(KeyedArchive* compsArch, SerializationContext* ser
                 Component* comp = ObjectFactory::Instance()->New<Component>(componentType);
                 if (nullptr != comp)
                 {
-                    if (comp->GetType()->Is<TransformComponent>())
-                    {
-                        RemoveComponent(comp->GetType());
-                    }
-
-                    AddComponent(comp);
-                    comp->Deserialize(compArch, serializationContext);
+                    LoadComponent(comp, compArch, serializationContext);
                 }
             }
         }
     }
 }
 
+void Entity::LoadComponent(Component* component, KeyedArchive* compArch, SerializationContext* serializationContext)
+{
+    if (component->GetType()->Is<TransformComponent>())
+    {
+        RemoveComponent(component->GetType());
+    }
+
+    AddComponent(component);
+    if (nullptr != compArch)
+    {
+        component->Deserialize(compArch, serializationContext);
+    }
+}
+
+bool Entity::IsSerializableComponent(Component* component)
+{
+    const ReflectedType* refType = ReflectedTypeDB::GetByType(component->GetType());
+
+    DVASSERT(refType != nullptr);
+
+    ReflectedMeta* meta = refType->GetStructure()->meta.get();
+    if (meta != nullptr && meta->GetMeta<M::NonSerializableComponent>() != nullptr)
+    {
+        return false;
+    }
+
+    //don't save empty custom properties
+    if (component->GetType()->Is<CustomPropertiesComponent>())
+    {
+        CustomPropertiesComponent* customProps = CastIfEqual<CustomPropertiesComponent*>(component);
+        if (customProps && customProps->GetArchive()->Count() <= 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 void Entity::SetSolid(bool isSolid)
 {
     KeyedArchive* props = GetOrCreateCustomProperties(this)->GetArchive();
@@ -298,6 +298,9 @@ protected:
     void UpdateFamily();
     void RemoveAllComponents();
     void LoadComponentsV7(KeyedArchive* compsArch, SerializationContext* serializationContext);
+    // Add loaded component, deserialize it from `compArch` if it is not nullptr
+    void LoadComponent(Component* component, KeyedArchive* compArch, SerializationContext* serializationContext);
+    static bool IsSerializableComponent(Component* component);
 
     String RecursiveBuildFullName(Entity* node, Entity* endNode);
 
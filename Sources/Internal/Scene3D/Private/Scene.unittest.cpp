@@ -3,6 +3,8 @@
 #include "Entity/SceneSystem.h"
 #include "Entity/SingletonComponent.h"
 
+#include <atomic>
+
 using namespace DAVA;
 
 class Mysystem : public SceneSystem
@@ -22,6 +24,32 @@ class MyComponent : public SingletonComponent
 {
 };
 
+class MyOtherComponent : public SingletonComponent
+{
+};
+
+class OrderedSystem : public SceneSystem
+{
+public:
+    OrderedSystem(Scene* scene, std::atomic<uint32>* counter_)
+        : SceneSystem(scene)
+        , counter(counter_)
+    {
+    }
+
+    void Process(float32 timeElapsed) override
+    {
+        order = counter->fetch_add(1);
+    }
+
+    void PrepareForRemove() override
+    {
+    }
+
+    std::atomic<uint32>* counter = nullptr;
+    uint32 order = 0;
+};
+
 DAVA_TESTCLASS (SceneTest)
 {
     DAVA_TEST (GetSystem)
@@ -69,4 +97,60 @@ DAVA_TESTCLASS (SceneTest)
         scene->RemoveSingletonComponent(myComponent);
         TEST_VERIFY(scene->GetSingletonComponent<MyComponent>() == nullptr);
     }
-};
\ No newline at end of file
+
+    DAVA_TEST (SystemsProcessOrder)
+    {
+        Scene* scene = new Scene(0);
+        SCOPE_EXIT
+        {
+            SafeRelease(scene);
+        };
+
+        std::atomic<uint32> counter(0);
+
+        // writer and reader of the same singleton should keep registration order,
+        // independent system and exclusive (undeclared) system should not break it
+        OrderedSystem* writer = new OrderedSystem(scene, &counter);
+        writer->SetProcessAccess(SceneSystemAccess().WriteSingleton<MyComponent>());
+        OrderedSystem* independent = new OrderedSystem(scene, &counter);
+        independent->SetProcessAccess(SceneSystemAccess().WriteSingleton<MyOtherComponent>());
+        OrderedSystem* reader = new OrderedSystem(scene, &counter);
+        reader->SetProcessAccess(SceneSystemAccess().ReadSingleton<MyComponent>());
+        OrderedSystem* exclusive = new OrderedSystem(scene, &counter);
+
+        scene->AddSystem(writer, 0, Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(independent, 0, Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(reader, 0, Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(exclusive, 0, Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+
+        // concurrent processing is opt-in
+        TEST_VERIFY(scene->GetSystemsProcessMode() == Scene::eSystemsProcessMode::SEQUENTIAL);
+        scene->SetSystemsProcessMode(Scene::eSystemsProcessMode::PARALLEL);
+        scene->SetSystemsProcessTimingEnabled(true);
+
+        for (uint32 frame = 0; frame < 100; ++frame)
+        {
+            uint32 frameStart = counter;
+            scene->Update(0.016f);
+
+            TEST_VERIFY(counter == frameStart + 4);
+            TEST_VERIFY(writer->order < reader->order);
+            TEST_VERIFY(exclusive->order == frameStart + 3);
+        }
+
+        const Vector<Scene::SystemProcessTiming>& timing = scene->GetSystemsProcessTiming();
+        TEST_VERIFY(timing.size() == 4);
+        TEST_VERIFY(timing[0].system == writer);
+        TEST_VERIFY(timing[3].system == exclusive);
+        TEST_VERIFY(timing[3].workerIndex == -1);
+
+        // sequential mode processes systems strictly in registration order
+        scene->SetSystemsProcessMode(Scene::eSystemsProcessMode::SEQUENTIAL);
+        uint32 frameStart = counter;
+        scene->Update(0.016f);
+        TEST_VERIFY(writer->order == frameStart);
+        TEST_VERIFY(independent->order == frameStart + 1);
+        TEST_VERIFY(reader->order == frameStart + 2);
+        TEST_VERIFY(exclusive->order == frameStart + 3);
+    }
+};
@@ -0,0 +1,760 @@
+#include "Scene3D/SceneFileV2.h"
+#include "Scene3D/SceneFile/BinarySceneFormat.h"
+#include "Scene3D/Components/ParticleEffectComponent.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Scene3D/Components/WaveComponent.h"
+#include "Scene3D/Components/WindComponent.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Scene3D/Systems/QualitySettingsSystem.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+
+#include "Base/ObjectFactory.h"
+#include "Base/ScopedPtr.h"
+#include "Debug/DVAssert.h"
+#include "Engine/Engine.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/KeyedArchive.h"
+#include "FileSystem/MemoryMappedFile.h"
+#include "FileSystem/UnmanagedMemoryFile.h"
+#include "Job/JobManager.h"
+#include "Job/JobScheduler.h"
+#include "Logger/Logger.h"
+#include "Math/TransformUtils.h"
+
+namespace DAVA
+{
+namespace SceneFileV2BinaryDetails
+{
+using namespace BinarySceneFormat;
+
+// Number of blobs decoded by one job
+const uint32 DECODE_GRAIN_SIZE = 32;
+
+uint32 Align(uint32 value)
+{
+    return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+class StringTable
+{
+public:
+    uint32 Add(const String& str)
+    {
+        auto found = indices.find(str);
+        if (found != indices.end())
+        {
+            return found->second;
+        }
+
+        uint32 index = static_cast<uint32>(strings.size());
+        indices.emplace(str, index);
+        strings.push_back(str);
+        return index;
+    }
+
+    const Vector<String>& GetStrings() const
+    {
+        return strings;
+    }
+
+private:
+    Vector<String> strings;
+    UnorderedMap<String, uint32> indices;
+};
+
+struct BlobWriter
+{
+    BlobWriter()
+        : file(DynamicMemoryFile::Create(File::CREATE | File::WRITE))
+    {
+    }
+
+    // Offset of blob is relative to the beginning of blobs data and is fixed up when layout is known
+    bool Write(KeyedArchive* archive, uint32 type, BlobRecord& record)
+    {
+        return BeginBlob(record) && archive->Save(file) && EndBlob(type, BLOB_KEYED_ARCHIVE, record);
+    }
+
+    bool Write(const Vector<uint8>& content, uint32 type, uint32 encoding, BlobRecord& record)
+    {
+        uint32 size = static_cast<uint32>(content.size());
+        return BeginBlob(record) && file->Write(content.data(), size) == size && EndBlob(type, encoding, record);
+    }
+
+    bool BeginBlob(BlobRecord& record)
+    {
+        uint32 begin = static_cast<uint32>(file->GetSize());
+        record.offset = Align(begin);
+        const uint8 padding[ALIGNMENT] = {};
+        return file->Write(padding, record.offset - begin) == record.offset - begin;
+    }
+
+    bool EndBlob(uint32 type, uint32 encoding, BlobRecord& record)
+    {
+        record.type = type;
+        record.encoding = encoding;
+        record.size = static_cast<uint32>(file->GetSize()) - record.offset;
+        return true;
+    }
+
+    ScopedPtr<DynamicMemoryFile> file;
+};
+
+template <typename T>
+void WriteTable(Vector<uint8>& content, uint32 offset, const Vector<T>& table)
+{
+    if (!table.empty())
+    {
+        Memcpy(content.data() + offset, table.data(), table.size() * sizeof(T));
+    }
+}
+
+template <typename T>
+bool IsTableValid(uint64 fileSize, uint32 offset, uint32 count)
+{
+    return (offset % ALIGNMENT) == 0 && static_cast<uint64>(offset) + static_cast<uint64>(count) * sizeof(T) <= fileSize;
+}
+
+template <typename T>
+const T* GetTable(const uint8* data, uint32 offset)
+{
+    return reinterpret_cast<const T*>(data + offset);
+}
+
+template <typename T>
+void WriteRecord(const T& value, Vector<uint8>& record)
+{
+    record.resize(sizeof(T));
+    Memcpy(record.data(), &value, sizeof(T));
+}
+
+template <typename T>
+bool ReadRecord(const uint8* data, uint32 size, T& value)
+{
+    if (size != sizeof(T))
+    {
+        return false;
+    }
+    Memcpy(&value, data, sizeof(T));
+    return true;
+}
+
+void WriteVector(const Vector3& v, float32* out)
+{
+    Memcpy(out, v.data, sizeof(v.data));
+}
+
+void WriteVector(const Quaternion& q, float32* out)
+{
+    Memcpy(out, q.data, sizeof(q.data));
+}
+}
+
+bool SceneFileV2::SaveComponentRecord(Component* component, Vector<uint8>& record, uint32& encoding)
+{
+    using namespace SceneFileV2BinaryDetails;
+
+    const Type* type = component->GetType();
+    if (type->Is<TransformComponent>())
+    {
+        TransformComponent* transform = static_cast<TransformComponent*>(component);
+        TransformRecord value;
+        WriteVector(transform->localTransform.GetTranslation(), value.localTranslation);
+        WriteVector(transform->localTransform.GetScale(), value.localScale);
+        WriteVector(transform->localTransform.GetRotation(), value.localRotation);
+        WriteVector(transform->worldTransform.GetTranslation(), value.worldTranslation);
+        WriteVector(transform->worldTransform.GetScale(), value.worldScale);
+        WriteVector(transform->worldTransform.GetRotation(), value.worldRotation);
+        WriteRecord(value, record);
+        encoding = BLOB_TRANSFORM_RECORD;
+        return true;
+    }
+    else if (type->Is<WindComponent>())
+    {
+        WindComponent* wind = static_cast<WindComponent*>(component);
+        WindRecord value;
+        WriteVector(wind->GetInfluenceBBox().min, value.influenceMin);
+        WriteVector(wind->GetInfluenceBBox().max, value.influenceMax);
+        value.force = wind->GetWindForce();
+        value.speed = wind->GetWindSpeed();
+        WriteRecord(value, record);
+        encoding = BLOB_WIND_RECORD;
+        return true;
+    }
+    else if (type->Is<WaveComponent>())
+    {
+        WaveComponent* wave = static_cast<WaveComponent*>(component);
+        WaveRecord value;
+        value.amplitude = wave->GetWaveAmplitude();
+        value.length = wave->GetWaveLenght();
+        value.speed = wave->GetWaveSpeed();
+        value.damping = wave->GetDampingRatio();
+        value.influenceRadius = wave->GetInfluenceRadius();
+        WriteRecord(value, record);
+        encoding = BLOB_WAVE_RECORD;
+        return true;
+    }
+
+    return false;
+}
+
+Component* SceneFileV2::LoadComponentRecord(uint32 encoding, const uint8* data, uint32 size)
+{
+    using namespace SceneFileV2BinaryDetails;
+
+    if (encoding == BLOB_TRANSFORM_RECORD)
+    {
+        TransformRecord value;
+        if (ReadRecord(data, size, value))
+        {
+            TransformComponent* transform = new TransformComponent();
+            transform->localTransform.SetTranslation(Vector3(value.localTranslation));
+            transform->localTransform.SetScale(Vector3(value.localScale));
+            transform->localTransform.SetRotation(Quaternion(value.localRotation));
+            transform->worldTransform.SetTranslation(Vector3(value.worldTranslation));
+            transform->worldTransform.SetScale(Vector3(value.worldScale));
+            transform->worldTransform.SetRotation(Quaternion(value.worldRotation));
+            transform->worldMatrix = TransformUtils::ToMatrix(transform->worldTransform);
+            return transform;
+        }
+    }
+    else if (encoding == BLOB_WIND_RECORD)
+    {
+        WindRecord value;
+        if (ReadRecord(data, size, value))
+        {
+            WindComponent* wind = new WindComponent();
+            wind->SetInfluenceBBox(AABBox3(Vector3(value.influenceMin), Vector3(value.influenceMax)));
+            wind->SetWindForce(value.force);
+            wind->SetWindSpeed(value.speed);
+            return wind;
+        }
+    }
+    else if (encoding == BLOB_WAVE_RECORD)
+    {
+        WaveRecord value;
+        if (ReadRecord(data, size, value))
+        {
+            WaveComponent* wave = new WaveComponent();
+            wave->SetWaveAmplitude(value.amplitude);
+            wave->SetWaveLenght(value.length);
+            wave->SetWaveSpeed(value.speed);
+            wave->SetDampingRatio(value.damping);
+            wave->SetInfluenceRadius(value.influenceRadius);
+            return wave;
+        }
+    }
+
+    return nullptr;
+}
+
+SceneFileV2::eError SceneFileV2::SaveSceneBinary(const FilePath& filename, Scene* scene, eFileType fileType)
+{
+    using namespace SceneFileV2BinaryDetails;
+
+    const VersionInfo::SceneVersion& currentVersion = GetEngineContext()->versionInfo->GetCurrentVersion();
+
+    serializationContext.SetRootNodePath(filename);
+    serializationContext.SetScenePath(FilePath(filename.GetDirectory()));
+    serializationContext.SetVersion(currentVersion.version);
+    serializationContext.SetScene(scene);
+
+    if (isSaveForGame)
+    {
+        scene->OptimizeBeforeExport();
+    }
+
+    BinarySceneFormat::Header fileHeader = {};
+    fileHeader.marker = FILE_MARKER;
+    fileHeader.formatVersion = FORMAT_VERSION;
+    fileHeader.sceneVersion = currentVersion.version;
+    fileHeader.fileType = fileType;
+
+    StringTable strings;
+    BlobWriter blobs;
+
+    Vector<TagRecord> tags;
+    tags.reserve(currentVersion.tags.size());
+    for (const auto& tag : currentVersion.tags)
+    {
+        tags.push_back({ strings.Add(tag.first), tag.second });
+    }
+
+    // data nodes are written in the same order as in .sc2: global material goes first
+    Vector<DataNode*> dataNodes;
+    PrepareDataNodesForSave(scene, dataNodes);
+
+    NMaterial* globalMaterial = scene->GetGlobalMaterial();
+    if (nullptr != globalMaterial)
+    {
+        fileHeader.globalMaterialId = globalMaterial->GetNodeID();
+        dataNodes.insert(dataNodes.begin(), globalMaterial);
+    }
+
+    Vector<BlobRecord> dataNodeRecords(dataNodes.size());
+    for (size_t i = 0; i < dataNodes.size(); ++i)
+    {
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        dataNodes[i]->Save(archive, &serializationContext);
+        if (!blobs.Write(archive, strings.Add(dataNodes[i]->GetClassName()), dataNodeRecords[i]))
+        {
+            Logger::Error("SceneFileV2::SaveSceneBinary failed to write datanode, file: %s", filename.GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_WRITE_ERROR);
+            return GetError();
+        }
+    }
+
+    // entities are written in depth-first order, so parent is always created before its children on load
+    Vector<EntityRecord> entityRecords;
+    Vector<BlobRecord> componentRecords;
+    Vector<std::pair<Entity*, uint32>> stack;
+    for (int32 i = scene->GetChildrenCount() - 1; i >= 0; --i)
+    {
+        stack.emplace_back(scene->GetChild(i), INVALID_INDEX);
+    }
+
+    while (!stack.empty())
+    {
+        Entity* entity = stack.back().first;
+        uint32 parentIndex = stack.back().second;
+        stack.pop_back();
+
+        EntityRecord record = {};
+        record.parent = parentIndex;
+        record.className = strings.Add(entity->GetClassName());
+        record.name = strings.Add(entity->GetName().c_str());
+        record.id = entity->id;
+        record.flags = entity->flags;
+        record.childrenCount = entity->GetChildrenCount();
+        record.firstComponent = static_cast<uint32>(componentRecords.size());
+
+        for (Component* component : entity->components)
+        {
+            if (Entity::IsSerializableComponent(component))
+            {
+                BlobRecord componentRecord;
+                bool written = false;
+
+                Vector<uint8> typedRecord;
+                uint32 encoding = BLOB_KEYED_ARCHIVE;
+                if (SaveComponentRecord(component, typedRecord, encoding))
+                {
+                    written = blobs.Write(typedRecord, strings.Add(ObjectFactory::Instance()->GetName(component)), encoding, componentRecord);
+                }
+                else
+                {
+                    ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+                    component->Serialize(archive, &serializationContext);
+                    written = blobs.Write(archive, strings.Add(archive->GetString("comp.typename")), componentRecord);
+                }
+
+                if (!written)
+                {
+                    Logger::Error("SceneFileV2::SaveSceneBinary failed to write component, file: %s", filename.GetAbsolutePathname().c_str());
+                    SetError(ERROR_FILE_WRITE_ERROR);
+                    return GetError();
+                }
+                componentRecords.push_back(componentRecord);
+            }
+        }
+        record.componentsCount = static_cast<uint32>(componentRecords.size()) - record.firstComponent;
+
+        uint32 entityIndex = static_cast<uint32>(entityRecords.size());
+        entityRecords.push_back(record);
+
+        for (int32 i = entity->GetChildrenCount() - 1; i >= 0; --i)
+        {
+            stack.emplace_back(entity->GetChild(i), entityIndex);
+        }
+    }
+
+    // layout
+    const Vector<String>& stringsData = strings.GetStrings();
+    uint64 offset = Align(sizeof(BinarySceneFormat::Header));
+
+    fileHeader.stringsCount = static_cast<uint32>(stringsData.size());
+    fileHeader.stringsOffset = static_cast<uint32>(offset);
+    offset += stringsData.size() * sizeof(StringRecord);
+
+    Vector<StringRecord> stringRecords(stringsData.size());
+    for (size_t i = 0; i < stringsData.size(); ++i)
+    {
+        stringRecords[i].offset = static_cast<uint32>(offset);
+        stringRecords[i].length = static_cast<uint32>(stringsData[i].size());
+        offset += stringsData[i].size() + 1;
+    }
+
+    offset = Align(static_cast<uint32>(offset));
+    fileHeader.tagsCount = static_cast<uint32>(tags.size());
+    fileHeader.tagsOffset = static_cast<uint32>(offset);
+    offset = Align(static_cast<uint32>(offset + tags.size() * sizeof(TagRecord)));
+
+    fileHeader.dataNodesCount = static_cast<uint32>(dataNodeRecords.size());
+    fileHeader.dataNodesOffset = static_cast<uint32>(offset);
+    offset = Align(static_cast<uint32>(offset + dataNodeRecords.size() * sizeof(BlobRecord)));
+
+    fileHeader.entitiesCount = static_cast<uint32>(entityRecords.size());
+    fileHeader.entitiesOffset = static_cast<uint32>(offset);
+    offset = Align(static_cast<uint32>(offset + entityRecords.size() * sizeof(EntityRecord)));
+
+    fileHeader.componentsCount = static_cast<uint32>(componentRecords.size());
+    fileHeader.componentsOffset = static_cast<uint32>(offset);
+    offset = Align(static_cast<uint32>(offset + componentRecords.size() * sizeof(BlobRecord)));
+
+    const Vector<uint8>& blobsData = blobs.file->GetDataVector();
+    uint64 fileSize = offset + blobsData.size();
+    if (fileSize > std::numeric_limits<uint32>::max())
+    {
+        Logger::Error("SceneFileV2::SaveSceneBinary scene is too big for binary format, file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FILE_WRITE_ERROR);
+        return GetError();
+    }
+
+    uint32 blobsOffset = static_cast<uint32>(offset);
+    for (BlobRecord& record : dataNodeRecords)
+    {
+        record.offset += blobsOffset;
+    }
+    for (BlobRecord& record : componentRecords)
+    {
+        record.offset += blobsOffset;
+    }
+
+    Vector<uint8> content(static_cast<size_t>(fileSize), 0);
+    Memcpy(content.data(), &fileHeader, sizeof(BinarySceneFormat::Header));
+    WriteTable(content, fileHeader.stringsOffset, stringRecords);
+    for (size_t i = 0; i < stringsData.size(); ++i)
+    {
+        Memcpy(content.data() + stringRecords[i].offset, stringsData[i].c_str(), stringsData[i].size());
+    }
+    WriteTable(content, fileHeader.tagsOffset, tags);
+    WriteTable(content, fileHeader.dataNodesOffset, dataNodeRecords);
+    WriteTable(content, fileHeader.entitiesOffset, entityRecords);
+    WriteTable(content, fileHeader.componentsOffset, componentRecords);
+    WriteTable(content, blobsOffset, blobsData);
+
+    ScopedPtr<File> file(File::Create(filename, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("SceneFileV2::SaveSceneBinary failed to create file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FAILED_TO_CREATE_FILE);
+        return GetError();
+    }
+
+    if (file->Write(content.data(), static_cast<uint32>(content.size())) != content.size() || !file->Flush())
+    {
+        Logger::Error("SceneFileV2::SaveSceneBinary failed to write file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FILE_WRITE_ERROR);
+        return GetError();
+    }
+
+    return GetError();
+}
+
+SceneFileV2::eError SceneFileV2::LoadSceneBinary(const FilePath& filename, Scene* scene)
+{
+    using namespace SceneFileV2BinaryDetails;
+
+    MemoryMappedFile mappedFile;
+    if (!mappedFile.Open(filename))
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary failed to open file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FAILED_TO_CREATE_FILE);
+        return GetError();
+    }
+
+    const uint8* data = mappedFile.GetData();
+    const uint64 fileSize = mappedFile.GetSize();
+
+    BinarySceneFormat::Header fileHeader;
+    if (fileSize < sizeof(BinarySceneFormat::Header) || fileSize > std::numeric_limits<uint32>::max())
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary: scene header is not valid in file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FILE_READ_ERROR);
+        return GetError();
+    }
+    Memcpy(&fileHeader, data, sizeof(BinarySceneFormat::Header));
+
+    if (fileHeader.marker != FILE_MARKER || fileHeader.formatVersion != FORMAT_VERSION)
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary: unsupported format of file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_VERSION_IS_TOO_OLD);
+        return GetError();
+    }
+
+    if (fileHeader.sceneVersion < SCENE_FILE_MINIMAL_SUPPORTED_VERSION)
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary: scene version %d is too old. Minimal supported version is %d. File: %s", fileHeader.sceneVersion, SCENE_FILE_MINIMAL_SUPPORTED_VERSION, filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_VERSION_IS_TOO_OLD);
+        return GetError();
+    }
+
+    bool tablesValid = IsTableValid<StringRecord>(fileSize, fileHeader.stringsOffset, fileHeader.stringsCount)
+    && IsTableValid<TagRecord>(fileSize, fileHeader.tagsOffset, fileHeader.tagsCount)
+    && IsTableValid<BlobRecord>(fileSize, fileHeader.dataNodesOffset, fileHeader.dataNodesCount)
+    && IsTableValid<EntityRecord>(fileSize, fileHeader.entitiesOffset, fileHeader.entitiesCount)
+    && IsTableValid<BlobRecord>(fileSize, fileHeader.componentsOffset, fileHeader.componentsCount);
+
+    // strings are used in place, each one is '\0'-terminated in file
+    Vector<const char*> strings(fileHeader.stringsCount, nullptr);
+    const StringRecord* stringRecords = GetTable<StringRecord>(data, fileHeader.stringsOffset);
+    for (uint32 i = 0; tablesValid && i < fileHeader.stringsCount; ++i)
+    {
+        uint64 end = static_cast<uint64>(stringRecords[i].offset) + stringRecords[i].length;
+        tablesValid = end < fileSize && data[end] == '\0';
+        strings[i] = reinterpret_cast<const char*>(data + stringRecords[i].offset);
+    }
+
+    const TagRecord* tags = GetTable<TagRecord>(data, fileHeader.tagsOffset);
+    for (uint32 i = 0; tablesValid && i < fileHeader.tagsCount; ++i)
+    {
+        tablesValid = tags[i].name < fileHeader.stringsCount;
+    }
+
+    // data nodes and components are decoded together, so they share single blobs table
+    Vector<const BlobRecord*> blobRecords;
+    blobRecords.reserve(fileHeader.dataNodesCount + fileHeader.componentsCount);
+    const BlobRecord* dataNodeRecords = GetTable<BlobRecord>(data, fileHeader.dataNodesOffset);
+    const BlobRecord* componentRecords = GetTable<BlobRecord>(data, fileHeader.componentsOffset);
+    for (uint32 i = 0; tablesValid && i < fileHeader.dataNodesCount; ++i)
+    {
+        blobRecords.push_back(dataNodeRecords + i);
+    }
+    for (uint32 i = 0; tablesValid && i < fileHeader.componentsCount; ++i)
+    {
+        blobRecords.push_back(componentRecords + i);
+    }
+    for (size_t i = 0; tablesValid && i < blobRecords.size(); ++i)
+    {
+        const BlobRecord* record = blobRecords[i];
+        bool isDataNode = (i < fileHeader.dataNodesCount);
+        tablesValid = record->type < fileHeader.stringsCount
+        && static_cast<uint64>(record->offset) + record->size <= fileSize
+        && (isDataNode ? record->encoding == BLOB_KEYED_ARCHIVE : record->encoding < BLOB_ENCODINGS_COUNT);
+    }
+
+    const EntityRecord* entityRecords = GetTable<EntityRecord>(data, fileHeader.entitiesOffset);
+    for (uint32 i = 0; tablesValid && i < fileHeader.entitiesCount; ++i)
+    {
+        const EntityRecord& record = entityRecords[i];
+        tablesValid = (record.parent == INVALID_INDEX || record.parent < i)
+        && record.className < fileHeader.stringsCount
+        && record.name < fileHeader.stringsCount
+        && static_cast<uint64>(record.firstComponent) + record.componentsCount <= fileHeader.componentsCount;
+    }
+
+    if (!tablesValid)
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary: file is corrupted: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FILE_READ_ERROR);
+        return GetError();
+    }
+
+    // load version tags
+    header.version = fileHeader.sceneVersion;
+    descriptor.fileType = fileHeader.fileType;
+    scene->version.version = fileHeader.sceneVersion;
+    for (uint32 i = 0; i < fileHeader.tagsCount; ++i)
+    {
+        scene->version.tags.insert(VersionInfo::TagsMap::value_type(strings[tags[i].name], tags[i].version));
+    }
+
+    if (!TestSceneVersion(scene, filename))
+    {
+        SetError(ERROR_VERSION_TAGS_INVALID);
+        return GetError();
+    }
+
+    serializationContext.SetRootNodePath(filename);
+    serializationContext.SetScenePath(filename.GetDirectory());
+    serializationContext.SetVersion(fileHeader.sceneVersion);
+    serializationContext.SetScene(scene);
+    serializationContext.SetDefaultMaterialQuality(NMaterialQualityName::DEFAULT_QUALITY_NAME);
+
+    // Decoding of archives and building of components stored as fixed records do not touch the scene
+    // and are done on job workers. Other objects are created and deserialized and all components are attached
+    // on calling thread: materials, entity families and serialization context are not thread-safe.
+    uint32 blobsCount = static_cast<uint32>(blobRecords.size());
+    Vector<KeyedArchive*> archives(blobsCount, nullptr);
+    Vector<Component*> builtComponents(blobsCount, nullptr);
+    Vector<uint8> archiveLoaded(blobsCount, 0);
+    auto decode = [&](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const BlobRecord* record = blobRecords[i];
+            if (record->encoding == BLOB_KEYED_ARCHIVE)
+            {
+                ScopedPtr<UnmanagedMemoryFile> blobFile(new UnmanagedMemoryFile(data + record->offset, record->size));
+                archives[i] = new KeyedArchive();
+                archiveLoaded[i] = archives[i]->Load(blobFile) ? 1 : 0;
+            }
+            else
+            {
+                builtComponents[i] = LoadComponentRecord(record->encoding, data + record->offset, record->size);
+                archiveLoaded[i] = (builtComponents[i] != nullptr) ? 1 : 0;
+            }
+        }
+    };
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr && blobsCount > DECODE_GRAIN_SIZE)
+    {
+        jobManager->GetScheduler()->ParallelFor(0, blobsCount, DECODE_GRAIN_SIZE, decode);
+    }
+    else
+    {
+        decode(0, blobsCount);
+    }
+
+    bool archivesLoaded = std::all_of(archiveLoaded.begin(), archiveLoaded.end(), [](uint8 loaded) { return loaded != 0; });
+    KeyedArchive** dataNodeArchives = archives.data();
+    KeyedArchive** componentArchives = archives.data() + fileHeader.dataNodesCount;
+    Component** componentsFromRecords = builtComponents.data() + fileHeader.dataNodesCount;
+
+    if (isDebugLogEnabled)
+    {
+        Logger::FrameworkDebug("+ load data objects");
+    }
+
+    for (uint32 i = 0; archivesLoaded && i < fileHeader.dataNodesCount; ++i)
+    {
+        archivesLoaded = CreateDataNode(scene, dataNodeArchives[i], dataNodeRecords[i].offset);
+    }
+
+    if (archivesLoaded)
+    {
+        NMaterial* globalMaterial = nullptr;
+        if (fileHeader.globalMaterialId != DataNode::INVALID_ID)
+        {
+            globalMaterial = static_cast<NMaterial*>(serializationContext.GetDataBlock(fileHeader.globalMaterialId));
+            serializationContext.SetGlobalMaterialKey(fileHeader.globalMaterialId);
+        }
+
+        serializationContext.ResolveMaterialBindings();
+
+        ApplyFogQuality(globalMaterial);
+        scene->SetGlobalMaterial(globalMaterial);
+    }
+
+    if (isDebugLogEnabled)
+    {
+        Logger::FrameworkDebug("+ load hierarchy");
+    }
+
+    Vector<Entity*> entities(archivesLoaded ? fileHeader.entitiesCount : 0, nullptr);
+    bool keepUnusedQualityEntities = QualitySettingsSystem::Instance()->GetKeepUnusedEntities();
+    scene->children.reserve(scene->children.size() + fileHeader.entitiesCount);
+    for (uint32 i = 0; i < static_cast<uint32>(entities.size()); ++i)
+    {
+        const EntityRecord& record = entityRecords[i];
+        const char* className = strings[record.className];
+
+        Entity* entity = nullptr;
+        bool skipEntity = false;
+        if (strcmp(className, "Entity") == 0)
+        {
+            entity = new Entity();
+        }
+        else
+        {
+            BaseObject* obj = ObjectFactory::Instance()->New<BaseObject>(className);
+            entity = dynamic_cast<Entity*>(obj);
+            if (nullptr == entity)
+            {
+                //in case if editor class is loading in non-editor project
+                SafeRelease(obj);
+                entity = new Entity();
+                skipEntity = true;
+            }
+        }
+
+        entity->SetScene(scene);
+        entity->name = FastName(strings[record.name]);
+        entity->id = record.id;
+        entity->sceneId = scene->GetSceneID();
+        entity->flags = record.flags & ~Entity::TRANSFORM_DIRTY;
+
+        for (uint32 c = record.firstComponent; c < record.firstComponent + record.componentsCount; ++c)
+        {
+            if (nullptr != componentsFromRecords[c])
+            {
+                entity->LoadComponent(componentsFromRecords[c], nullptr, &serializationContext);
+                componentsFromRecords[c] = nullptr;
+                continue;
+            }
+
+            Component* component = ObjectFactory::Instance()->New<Component>(strings[componentRecords[c].type]);
+            if (nullptr != component)
+            {
+                entity->LoadComponent(component, componentArchives[c], &serializationContext);
+            }
+        }
+
+        if (isDebugLogEnabled)
+        {
+            Logger::FrameworkDebug("- %s(%s)", entity->GetName().c_str(), entity->GetClassName().c_str());
+        }
+
+        Entity* parent = (record.parent == INVALID_INDEX) ? scene : entities[record.parent];
+        if (!skipEntity && (keepUnusedQualityEntities || QualitySettingsSystem::Instance()->IsQualityVisible(entity)))
+        {
+            parent->AddNode(entity);
+        }
+        entity->children.reserve(record.childrenCount);
+        entities[i] = entity;
+    }
+
+    for (Entity* entity : entities)
+    {
+        ParticleEffectComponent* effect = entity->GetComponent<ParticleEffectComponent>();
+        if (effect && (effect->loadedVersion == 0))
+            effect->CollapseOldEffect(&serializationContext);
+    }
+
+    for (Entity* entity : entities)
+    {
+        SafeRelease(entity);
+    }
+    for (KeyedArchive* archive : archives)
+    {
+        SafeRelease(archive);
+    }
+    for (Component* component : builtComponents)
+    {
+        SafeDelete(component); // not attached because loading failed
+    }
+
+    if (!archivesLoaded)
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary failed to load data in file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FILE_READ_ERROR);
+        return GetError();
+    }
+
+    UpdatePolygonGroupRequestedFormatRecursively(scene);
+    ScopedPtr<UnmanagedMemoryFile> polygonDataFile(new UnmanagedMemoryFile(data, static_cast<uint32>(fileSize)));
+    const bool contextLoaded = serializationContext.LoadPolygonGroupData(polygonDataFile);
+    if (!contextLoaded)
+    {
+        Logger::Error("SceneFileV2::LoadSceneBinary LoadPolygonGroupData failed in file: %s", filename.GetAbsolutePathname().c_str());
+        SetError(ERROR_FILE_READ_ERROR);
+        return GetError();
+    }
+    OptimizeScene(scene);
+
+    if (serializationContext.GetVersion() < LODSYSTEM2)
+    {
+        FixLodForLodsystem2(scene);
+    }
+
+    if (GetError() == ERROR_NO_ERROR)
+    {
+        scene->SceneDidLoaded();
+        scene->OnSceneReady(scene);
+    }
+
+    return GetError();
+}
+} // namespace DAVA
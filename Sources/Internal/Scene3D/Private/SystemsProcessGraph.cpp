@@ -0,0 +1,203 @@
+#include "Scene3D/Private/SystemsProcessGraph.h"
+
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Entity/SceneSystem.h"
+#include "Job/JobScheduler.h"
+#include "Time/SystemTimer.h"
+
+namespace DAVA
+{
+void SystemsProcessGraph::Build(const Vector<SceneSystem*>& systems)
+{
+    stages.clear();
+    systemsCount = static_cast<uint32>(systems.size());
+
+    size_t maxStageSize = 0;
+    for (uint32 i = 0; i < systemsCount; ++i)
+    {
+        SceneSystem* system = systems[i];
+        bool concurrent = system->HasProcessAccess();
+
+        if (stages.empty() || !concurrent || !stages.back().concurrent)
+        {
+            stages.emplace_back();
+            stages.back().concurrent = concurrent;
+        }
+
+        Stage& stage = stages.back();
+        uint32 nodeIndex = static_cast<uint32>(stage.nodes.size());
+
+        Node node;
+        node.system = system;
+        node.orderIndex = i;
+        node.mainThreadOnly = !concurrent || system->GetProcessAccess().IsMainThreadOnly();
+
+        if (concurrent)
+        {
+            // Depend on every previous conflicting system to keep registration order for them
+            for (uint32 j = 0; j < nodeIndex; ++j)
+            {
+                Node& prev = stage.nodes[j];
+                if (system->GetProcessAccess().ConflictsWith(prev.system->GetProcessAccess()))
+                {
+                    prev.successors.push_back(nodeIndex);
+                    node.dependenciesCount++;
+                }
+            }
+        }
+
+        stage.nodes.push_back(std::move(node));
+        maxStageSize = std::max(maxStageSize, stage.nodes.size());
+    }
+
+    remainingDependencies.reset(new std::atomic<uint32>[maxStageSize]);
+}
+
+uint32 SystemsProcessGraph::GetConcurrentStagesCount() const
+{
+    uint32 count = 0;
+    for (const Stage& stage : stages)
+    {
+        if (stage.concurrent && stage.nodes.size() > 1)
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void SystemsProcessGraph::Process(const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings)
+{
+    if (timings != nullptr)
+    {
+        timings->resize(systemsCount);
+    }
+
+    if (scheduler == nullptr)
+    {
+        ProcessSequential(processFn, timings);
+        return;
+    }
+
+    for (Stage& stage : stages)
+    {
+        if (stage.concurrent && stage.nodes.size() > 1)
+        {
+            ProcessConcurrentStage(stage, processFn, scheduler, timings);
+        }
+        else
+        {
+            for (const Node& node : stage.nodes)
+            {
+                RunSystem(node, processFn, scheduler, timings);
+            }
+        }
+    }
+}
+
+void SystemsProcessGraph::ProcessSequential(const ProcessFn& processFn, Vector<Timing>* timings)
+{
+    for (const Stage& stage : stages)
+    {
+        for (const Node& node : stage.nodes)
+        {
+            RunSystem(node, processFn, nullptr, timings);
+        }
+    }
+}
+
+void SystemsProcessGraph::ProcessConcurrentStage(Stage& stage, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings)
+{
+    uint32 nodesCount = static_cast<uint32>(stage.nodes.size());
+
+    finishedNodesCount = 0;
+    for (uint32 i = 0; i < nodesCount; ++i)
+    {
+        remainingDependencies[i] = stage.nodes[i].dependenciesCount;
+    }
+
+    for (uint32 i = 0; i < nodesCount; ++i)
+    {
+        if (stage.nodes[i].dependenciesCount == 0)
+        {
+            LaunchNode(stage, i, processFn, scheduler, timings);
+        }
+    }
+
+    // Main thread processes main-thread-only systems and helps workers until whole stage is done
+    while (finishedNodesCount.load() < nodesCount)
+    {
+        uint32 nodeIndex = nodesCount;
+        {
+            LockGuard<Spinlock> guard(mainThreadQueueLock);
+            if (!mainThreadQueue.empty())
+            {
+                // Take the oldest ready system first to keep registration order among main-thread systems
+                nodeIndex = mainThreadQueue.front();
+                mainThreadQueue.pop_front();
+            }
+        }
+
+        if (nodeIndex < nodesCount)
+        {
+            RunNode(stage, nodeIndex, processFn, scheduler, timings);
+        }
+        else if (!scheduler->TryExecuteOne())
+        {
+            Thread::Yield();
+        }
+    }
+}
+
+void SystemsProcessGraph::LaunchNode(Stage& stage, uint32 nodeIndex, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings)
+{
+    if (stage.nodes[nodeIndex].mainThreadOnly)
+    {
+        LockGuard<Spinlock> guard(mainThreadQueueLock);
+        mainThreadQueue.push_back(nodeIndex);
+    }
+    else
+    {
+        Stage* stagePtr = &stage;
+        const ProcessFn* processFnPtr = &processFn;
+        scheduler->Schedule([this, stagePtr, nodeIndex, processFnPtr, scheduler, timings]() {
+            RunNode(*stagePtr, nodeIndex, *processFnPtr, scheduler, timings);
+        });
+    }
+}
+
+void SystemsProcessGraph::RunNode(Stage& stage, uint32 nodeIndex, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings)
+{
+    const Node& node = stage.nodes[nodeIndex];
+    RunSystem(node, processFn, scheduler, timings);
+
+    for (uint32 successor : node.successors)
+    {
+        if (remainingDependencies[successor].fetch_sub(1) == 1)
+        {
+            LaunchNode(stage, successor, processFn, scheduler, timings);
+        }
+    }
+
+    // Should be the last access to the stage state: main thread may leave the stage right after it
+    finishedNodesCount.fetch_add(1);
+}
+
+void SystemsProcessGraph::RunSystem(const Node& node, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings)
+{
+    if (timings != nullptr)
+    {
+        Timing& timing = (*timings)[node.orderIndex];
+        timing.system = node.system;
+        timing.workerIndex = (scheduler != nullptr) ? scheduler->GetCurrentWorkerIndex() : -1;
+        timing.startUs = SystemTimer::GetUs();
+        processFn(node.system);
+        timing.durationUs = SystemTimer::GetUs() - timing.startUs;
+    }
+    else
+    {
+        processFn(node.system);
+    }
+}
+} // namespace DAVA
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/Spinlock.h"
+#include "Entity/SceneSystem.h"
+#include "Functional/Function.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+class JobScheduler;
+
+/**
+    Execution plan of `Scene::systemsToProcess`.
+
+    Systems are split into stages. A system without declared `SceneSystemAccess` forms exclusive stage processed on the main thread.
+    Consecutive systems with declared access form concurrent stage: inside the stage system depends on every previous
+    system it conflicts with, and systems with all dependencies processed are started on worker threads
+    (or on the main thread if they require so).
+*/
+class SystemsProcessGraph final
+{
+public:
+    using Timing = SceneSystemProcessTiming;
+
+    using ProcessFn = Function<void(SceneSystem*)>;
+
+    /** Build plan for `systems` listed in registration order. */
+    void Build(const Vector<SceneSystem*>& systems);
+
+    /**
+        Process all systems with `processFn`. If `scheduler` is nullptr systems are processed sequentially.
+        If `timings` is not nullptr it is filled with per-system timings in registration order.
+    */
+    void Process(const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings);
+
+    /** Return count of stages which can process more than one system concurrently. */
+    uint32 GetConcurrentStagesCount() const;
+
+private:
+    struct Node
+    {
+        SceneSystem* system = nullptr;
+        uint32 orderIndex = 0;
+        uint32 dependenciesCount = 0;
+        bool mainThreadOnly = false;
+        Vector<uint32> successors;
+    };
+
+    struct Stage
+    {
+        bool concurrent = false;
+        Vector<Node> nodes;
+    };
+
+    void ProcessSequential(const ProcessFn& processFn, Vector<Timing>* timings);
+    void ProcessConcurrentStage(Stage& stage, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings);
+    void LaunchNode(Stage& stage, uint32 nodeIndex, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings);
+    void RunNode(Stage& stage, uint32 nodeIndex, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings);
+    void RunSystem(const Node& node, const ProcessFn& processFn, JobScheduler* scheduler, Vector<Timing>* timings);
+
+    Vector<Stage> stages;
+    uint32 systemsCount = 0;
+
+    // Per-frame state of the stage being processed
+    std::unique_ptr<std::atomic<uint32>[]> remainingDependencies;
+    std::atomic<uint32> finishedNodesCount{ 0 };
+    Spinlock mainThreadQueueLock;
+    Deque<uint32> mainThreadQueue;
+};
+} // namespace DAVA
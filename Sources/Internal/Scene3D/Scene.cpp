@@ -1,8 +1,10 @@
 #include "Scene3D/Scene.h"
 
 #include "Concurrency/Thread.h"
+#include "Debug/Backtrace.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
 #include "Entity/ComponentUtils.h"
 #include "FileSystem/FileSystem.h"
 #include "Render/3D/StaticMesh.h"
@@ -37,7 +39,9 @@
 #include "Scene3D/DataNode.h"
 #include "Scene3D/Lod/LodComponent.h"
 #include "Scene3D/Lod/LodSystem.h"
+#include "Scene3D/Private/SystemsProcessGraph.h"
 #include "Scene3D/SceneFileV2.h"
+#include "Scene3D/SceneFile/BinarySceneFormat.h"
 #include "Scene3D/Systems/ActionUpdateSystem.h"
 #include "Scene3D/Systems/AnimationSystem.h"
 #include "Scene3D/Systems/DebugRenderSystem.h"
@@ -60,6 +64,8 @@
 #include "Scene3D/Systems/UpdateSystem.h"
 #include "Scene3D/Systems/WaveSystem.h"
 #include "Scene3D/Systems/WindSystem.h"
+#include "Job/JobManager.h"
+#include "Logger/Logger.h"
 #include "Sound/SoundSystem.h"
 #include "Time/SystemTimer.h"
 #include "UI/UIEvent.h"
@@ -194,6 +200,7 @@ Scene::Scene(uint32 _systemsMask /* = SCENE_SYSTEM_ALL_MASK */)
     , sceneGlobalMaterial(0)
     , mainCamera(0)
     , drawCamera(0)
+    , systemsProcessGraph(new SystemsProcessGraph())
 {
     static uint32 idCounter = 0;
     sceneId = ++idCounter;
@@ -578,6 +585,7 @@ void Scene::AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMa
     {
         bool wasInsertedForProcess = insertSystemBefore(systemsToProcess, insertBeforeSceneForProcess);
         DVASSERT(wasInsertedForProcess);
+        systemsProcessGraphDirty = true;
     }
 
     if (processFlags & SCENE_SYSTEM_REQUIRE_INPUT)
@@ -600,7 +608,7 @@ void Scene::RemoveSystem(SceneSystem* sceneSystem)
 {
     sceneSystem->PrepareForRemove();
 
-    RemoveSystem(systemsToProcess, sceneSystem);
+    systemsProcessGraphDirty |= RemoveSystem(systemsToProcess, sceneSystem);
     RemoveSystem(systemsToInput, sceneSystem);
     RemoveSystem(systemsToFixedProcess, sceneSystem);
 
@@ -679,6 +687,12 @@ void Scene::Update(float32 timeElapsed)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_UPDATE)
 
+    // particles simulation started by previous update reads transforms, which are changed by systems below
+    if (particleEffectSystem != nullptr)
+    {
+        particleEffectSystem->WaitSimulation();
+    }
+
     fixedUpdate.lastTime += timeElapsed;
     //call ProcessFixed N times where N = (timeSinceLastProcessFixed + timeElapsed) / fixedUpdate.constantTime;
     while (fixedUpdate.lastTime >= fixedUpdate.constantTime)
@@ -690,27 +704,22 @@ void Scene::Update(float32 timeElapsed)
         fixedUpdate.lastTime -= fixedUpdate.constantTime;
     }
 
-    for (SceneSystem* system : systemsToProcess)
+    if (systemsProcessGraphDirty)
     {
-        if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
-        {
-            updatableSystem->UpdatePreTransform(timeElapsed);
-            transformSystem->Process(timeElapsed);
-            updatableSystem->UpdatePostTransform(timeElapsed);
-        }
-        else if (system == lodSystem)
-        {
-            if (Renderer::GetOptions()->IsOptionEnabled(RenderOptions::UPDATE_LODS))
-            {
-                lodSystem->Process(timeElapsed);
-            }
-        }
-        else
-        {
-            system->Process(timeElapsed);
-        }
+        systemsProcessGraph->Build(systemsToProcess);
+        systemsProcessGraphDirty = false;
+    }
+
+    JobScheduler* scheduler = nullptr;
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (systemsProcessMode == eSystemsProcessMode::PARALLEL && jobManager != nullptr)
+    {
+        scheduler = jobManager->GetScheduler();
     }
 
+    systemsProcessGraph->Process([this, timeElapsed](SceneSystem* system) { ProcessSystem(system, timeElapsed); },
+                                 scheduler, systemsProcessTimingEnabled ? &systemsProcessTiming : nullptr);
+
     if (transformSingleComponent)
     {
         transformSingleComponent->Clear();
@@ -721,11 +730,108 @@ void Scene::Update(float32 timeElapsed)
     {
         collisionSingleComponent->collisions.clear();
     }
+
+    // Transforms and collisions of late fetched simulation are processed by systems in next frame
+    if (physicsSystem != nullptr)
+    {
+        physicsSystem->ProcessLateFetch();
+    }
 #endif
 
     sceneGlobalTime += timeElapsed;
 }
 
+void Scene::ProcessSystem(SceneSystem* system, float32 timeElapsed)
+{
+    if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
+    {
+        updatableSystem->UpdatePreTransform(timeElapsed);
+        transformSystem->Process(timeElapsed);
+        updatableSystem->UpdatePostTransform(timeElapsed);
+    }
+    else if (system == lodSystem)
+    {
+        if (Renderer::GetOptions()->IsOptionEnabled(RenderOptions::UPDATE_LODS))
+        {
+            lodSystem->Process(timeElapsed);
+        }
+    }
+    else
+    {
+        system->Process(timeElapsed);
+    }
+}
+
+void Scene::SetSystemsProcessMode(eSystemsProcessMode mode)
+{
+    systemsProcessMode = mode;
+}
+
+Scene::eSystemsProcessMode Scene::GetSystemsProcessMode() const
+{
+    return systemsProcessMode;
+}
+
+void Scene::SetSystemsProcessTimingEnabled(bool enabled)
+{
+    systemsProcessTimingEnabled = enabled;
+    if (!enabled)
+    {
+        systemsProcessTiming.clear();
+    }
+}
+
+bool Scene::IsSystemsProcessTimingEnabled() const
+{
+    return systemsProcessTimingEnabled;
+}
+
+const Vector<Scene::SystemProcessTiming>& Scene::GetSystemsProcessTiming() const
+{
+    return systemsProcessTiming;
+}
+
+namespace SceneDetails
+{
+String GetSystemName(SceneSystem* system)
+{
+    // Class name without namespace, e.g. "WindSystem" for DAVA::WindSystem
+    String name = Debug::DemangleFrameSymbol(typeid(*system).name());
+    if (name.empty())
+    {
+        name = typeid(*system).name();
+    }
+
+    size_t nameStart = name.find_last_of(": ");
+    return (nameStart != String::npos) ? name.substr(nameStart + 1) : name;
+}
+} // namespace SceneDetails
+
+void Scene::DumpSystemsProcessTiming() const
+{
+    if (systemsProcessTiming.empty())
+    {
+        return;
+    }
+
+    int64 frameStartUs = systemsProcessTiming.front().startUs;
+    for (const SystemProcessTiming& timing : systemsProcessTiming)
+    {
+        frameStartUs = std::min(frameStartUs, timing.startUs);
+    }
+
+    Logger::Info("Scene systems process timing (%s):", systemsProcessMode == eSystemsProcessMode::PARALLEL ? "parallel" : "sequential");
+    for (const SystemProcessTiming& timing : systemsProcessTiming)
+    {
+        String threadName = (timing.workerIndex < 0) ? String("main") : Format("worker %d", timing.workerIndex);
+        Logger::Info("    %-40s start: %6lld us, duration: %6lld us, thread: %s",
+                     SceneDetails::GetSystemName(timing.system).c_str(),
+                     static_cast<long long>(timing.startUs - frameStartUs),
+                     static_cast<long long>(timing.durationUs),
+                     threadName.c_str());
+    }
+}
+
 void Scene::Draw()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_DRAW)
@@ -822,7 +928,7 @@ SceneFileV2::eError Scene::LoadScene(const DAVA::FilePath& pathname)
     RemoveAllChildren();
     SetName(pathname.GetFilename().c_str());
 
-    if (pathname.IsEqualToExtension(".sc2"))
+    if (pathname.IsEqualToExtension(".sc2") || pathname.IsEqualToExtension(BinarySceneFormat::FILE_EXTENSION))
     {
         ScopedPtr<SceneFileV2> file(new SceneFileV2());
         file->EnableDebugLog(false);
@@ -846,6 +952,10 @@ SceneFileV2::eError Scene::SaveScene(const DAVA::FilePath& pathname, bool saveFo
     ScopedPtr<SceneFileV2> file(new SceneFileV2());
     file->EnableDebugLog(false);
     file->EnableSaveForGame(saveForGame);
+    if (pathname.IsEqualToExtension(BinarySceneFormat::FILE_EXTENSION))
+    {
+        return file->SaveSceneBinary(pathname, this);
+    }
     return file->SaveScene(pathname, this);
 }
 
@@ -22,6 +22,7 @@ namespace DAVA
 
 class Texture;
 class StaticMesh;
+class SystemsProcessGraph;
 class DataNode;
 class ShadowVolumeNode;
 class Light;
@@ -127,6 +128,15 @@ public:
         SCENE_SYSTEM_REQUIRE_FIXED_PROCESS = 1 << 2
     };
 
+    enum class eSystemsProcessMode : uint32
+    {
+        SEQUENTIAL, ///< Systems are processed one by one on the main thread in registration order.
+        PARALLEL ///< Systems with declared non-conflicting access are processed concurrently on worker threads.
+    };
+
+    /** Per-system timing of the last `Update` call. */
+    using SystemProcessTiming = SceneSystemProcessTiming;
+
     Scene(uint32 systemsMask = SCENE_SYSTEM_ALL_MASK);
 
     /**
@@ -206,6 +216,20 @@ public:
 
     virtual void Update(float32 timeElapsed);
     virtual void Draw();
+
+    /**
+        \brief Set how systems are processed in `Update`. Default is eSystemsProcessMode::SEQUENTIAL.
+        Use eSystemsProcessMode::PARALLEL to process systems with declared non-conflicting access on worker threads.
+     */
+    void SetSystemsProcessMode(eSystemsProcessMode mode);
+    eSystemsProcessMode GetSystemsProcessMode() const;
+
+    /** \brief Enable collecting of per-system timings in `Update`. */
+    void SetSystemsProcessTimingEnabled(bool enabled);
+    bool IsSystemsProcessTimingEnabled() const;
+    const Vector<SystemProcessTiming>& GetSystemsProcessTiming() const;
+    /** \brief Write per-system timings of the last `Update` to log. */
+    void DumpSystemsProcessTiming() const;
     void SceneDidLoaded() override;
 
     Camera* GetCamera(int32 n);
@@ -262,6 +286,13 @@ protected:
     void RegisterEntitiesInSystemRecursively(SceneSystem* system, Entity* entity);
 
     bool RemoveSystem(Vector<SceneSystem*>& storage, SceneSystem* system);
+    void ProcessSystem(SceneSystem* system, float32 timeElapsed);
+
+    std::unique_ptr<SystemsProcessGraph> systemsProcessGraph;
+    bool systemsProcessGraphDirty = true;
+    eSystemsProcessMode systemsProcessMode = eSystemsProcessMode::SEQUENTIAL;
+    bool systemsProcessTimingEnabled = false;
+    Vector<SystemProcessTiming> systemsProcessTiming;
 
     uint32 systemsMask;
     uint32 maxEntityIDCounter;
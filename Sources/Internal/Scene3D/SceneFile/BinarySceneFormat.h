@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Binary scene container (.sc2b), written by `SceneFileV2::SaveSceneBinary` and loaded by `SceneFileV2::LoadScene`.
+
+    All tables are addressed by offsets from the beginning of file and aligned to `ALIGNMENT`,
+    so file can be memory-mapped and tables can be used in place without parsing.
+    Data nodes and components are stored as typed blobs: type name and encoding are stored in the table.
+    Components listed in `eBlobEncoding` are stored as fixed records and are built on job workers while loading,
+    blobs of other components and of data nodes contain KeyedArchive the object was serialized to.
+
+    File layout:
+    - Header
+    - StringRecord[stringsCount], then characters of all strings, each one is '\0'-terminated
+    - TagRecord[tagsCount] - version tags of the scene
+    - BlobRecord[dataNodesCount] - data nodes in load order, global material goes first
+    - EntityRecord[entitiesCount] - entities in depth-first order, parent always precedes its children
+    - BlobRecord[componentsCount] - components of all entities, grouped by entity
+    - blobs data
+*/
+namespace BinarySceneFormat
+{
+const char* const FILE_EXTENSION = ".sc2b";
+const Array<char8, 4> FILE_MARKER{ { 'S', 'F', 'B', '1' } };
+const uint32 FORMAT_VERSION = 2;
+const uint32 ALIGNMENT = 8;
+const uint32 INVALID_INDEX = static_cast<uint32>(-1);
+
+struct Header
+{
+    Array<char8, 4> marker;
+    uint32 formatVersion;
+    uint32 sceneVersion; // version of scene serialization, see VersionInfo::SceneVersion
+    uint32 fileType; // see SceneFileV2::eFileType
+    uint64 globalMaterialId; // 0 if scene has no global material
+
+    uint32 stringsCount;
+    uint32 stringsOffset;
+    uint32 tagsCount;
+    uint32 tagsOffset;
+    uint32 dataNodesCount;
+    uint32 dataNodesOffset;
+    uint32 entitiesCount;
+    uint32 entitiesOffset;
+    uint32 componentsCount;
+    uint32 componentsOffset;
+};
+
+struct StringRecord
+{
+    uint32 offset;
+    uint32 length; // without terminating '\0'
+};
+
+struct TagRecord
+{
+    uint32 name; // index in string table
+    uint32 version;
+};
+
+enum eBlobEncoding : uint32
+{
+    BLOB_KEYED_ARCHIVE = 0,
+    BLOB_TRANSFORM_RECORD, ///< TransformRecord of TransformComponent
+    BLOB_WIND_RECORD, ///< WindRecord of WindComponent
+    BLOB_WAVE_RECORD, ///< WaveRecord of WaveComponent
+    BLOB_ENCODINGS_COUNT
+};
+
+struct BlobRecord
+{
+    uint32 type; // index of class name in string table
+    uint32 encoding; // see eBlobEncoding
+    uint32 offset;
+    uint32 size;
+};
+
+struct TransformRecord
+{
+    float32 localTranslation[3];
+    float32 localScale[3];
+    float32 localRotation[4];
+    float32 worldTranslation[3];
+    float32 worldScale[3];
+    float32 worldRotation[4];
+};
+
+struct WindRecord
+{
+    float32 influenceMin[3];
+    float32 influenceMax[3];
+    float32 force;
+    float32 speed;
+};
+
+struct WaveRecord
+{
+    float32 amplitude;
+    float32 length;
+    float32 speed;
+    float32 damping;
+    float32 influenceRadius;
+};
+
+struct EntityRecord
+{
+    uint32 parent; // index of parent entity or INVALID_INDEX for children of scene
+    uint32 className; // index in string table
+    uint32 name; // index in string table
+    uint32 id;
+    uint32 flags;
+    uint32 childrenCount;
+    uint32 firstComponent; // index of the first component in components table
+    uint32 componentsCount;
+};
+
+static_assert(sizeof(Header) == 64, "BinarySceneFormat::Header layout is a part of file format");
+static_assert(sizeof(StringRecord) == 8, "BinarySceneFormat::StringRecord layout is a part of file format");
+static_assert(sizeof(TagRecord) == 8, "BinarySceneFormat::TagRecord layout is a part of file format");
+static_assert(sizeof(BlobRecord) == 16, "BinarySceneFormat::BlobRecord layout is a part of file format");
+static_assert(sizeof(TransformRecord) == 80, "BinarySceneFormat::TransformRecord layout is a part of file format");
+static_assert(sizeof(WindRecord) == 32, "BinarySceneFormat::WindRecord layout is a part of file format");
+static_assert(sizeof(WaveRecord) == 20, "BinarySceneFormat::WaveRecord layout is a part of file format");
+static_assert(sizeof(EntityRecord) == 32, "BinarySceneFormat::EntityRecord layout is a part of file format");
+
+} // namespace BinarySceneFormat
+} // namespace DAVA
@@ -34,6 +34,7 @@
 #include "Scene3D/Components/ComponentHelpers.h"
 
 #include "Scene3D/Scene.h"
+#include "Scene3D/SceneFile/BinarySceneFormat.h"
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 
 #include "Scene3D/Converters/SpeedTreeConverter.h"
@@ -159,58 +160,9 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
         scene->OptimizeBeforeExport();
     }
 
-    Set<DataNode*> nodes;
-    scene->GetDataNodes(nodes);
-
-    uint32 serializableNodesCount = 0;
-    uint64 maxDataNodeID = 0;
-
-    // compute maxid for datanodes
-    for (auto node : nodes)
-    {
-        // TODO: now one datanode can be used in multiple scenes,
-        // but datanote->scene points only on single scene. This should be
-        // discussed and fixed in the future.
-        if (node->GetScene() == scene && node->GetNodeID() > maxDataNodeID)
-        {
-            maxDataNodeID = node->GetNodeID();
-        }
-    }
-
-    // assign datanode id-s and
-    // count serializable nodes
-    for (auto node : nodes)
-    {
-        if (IsDataNodeSerializable(node))
-        {
-            // TODO: if datanode is from another scene, it should be saved with newly
-            // generated datanode-id. Unfortunately this ID will be generated on every scene save,
-            // because we don't change scene pointer in datanode->scene.
-            // This should be discussed and fixed in the future.
-            serializableNodesCount++;
-            if (node->GetScene() != scene || node->GetNodeID() == DataNode::INVALID_ID)
-            {
-                node->SetNodeID(++maxDataNodeID);
-            }
-        }
-    }
-
-    // do we need to save globalmaterial?
+    Vector<DataNode*> orderedNodes;
+    uint32 serializableNodesCount = PrepareDataNodesForSave(scene, orderedNodes);
     NMaterial* globalMaterial = scene->GetGlobalMaterial();
-    if (nullptr != globalMaterial)
-    {
-        if (nodes.count(globalMaterial) > 0)
-        {
-            // remove global material from set,
-            // as it should be saved exclusively
-            // on the top of data nodes
-            nodes.erase(globalMaterial);
-        }
-        else
-        {
-            serializableNodesCount++;
-        }
-    }
 
     // save datanodes count
     if (sizeof(uint32) != file->Write(&serializableNodesCount, sizeof(uint32)))
@@ -223,10 +175,6 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
     // save global material on top of datanodes
     if (nullptr != globalMaterial)
     {
-        if (globalMaterial->GetNodeID() == DataNode::INVALID_ID)
-        {
-            globalMaterial->SetNodeID(++maxDataNodeID);
-        }
         if (!SaveDataNode(globalMaterial, file))
         {
             Logger::Error("SceneFileV2::SaveScene failed to write global materials file: %s", filename.GetAbsolutePathname().c_str());
@@ -235,21 +183,14 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
         }
     }
 
-    // sort in ascending ID order
-    Set<DataNode*, std::function<bool(DataNode*, DataNode*)>> orderedNodes(nodes.begin(), nodes.end(),
-                                                                           [](DataNode* a, DataNode* b) { return a->GetNodeID() < b->GetNodeID(); });
-
     // save the rest of datanodes
-    for (auto node : orderedNodes)
+    for (DataNode* node : orderedNodes)
     {
-        if (IsDataNodeSerializable(node))
+        if (!SaveDataNode(node, file))
         {
-            if (!SaveDataNode(node, file))
-            {
-                Logger::Error("SceneFileV2::SaveScene failed to write datanode file: %s", filename.GetAbsolutePathname().c_str());
-                SetError(ERROR_FILE_WRITE_ERROR);
-                return GetError();
-            }
+            Logger::Error("SceneFileV2::SaveScene failed to write datanode file: %s", filename.GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_WRITE_ERROR);
+            return GetError();
         }
     }
 
@@ -293,6 +234,82 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
     return GetError();
 }
 
+uint32 SceneFileV2::PrepareDataNodesForSave(Scene* scene, Vector<DataNode*>& orderedNodes)
+{
+    Set<DataNode*> nodes;
+    scene->GetDataNodes(nodes);
+
+    uint32 serializableNodesCount = 0;
+    uint64 maxDataNodeID = 0;
+
+    // compute maxid for datanodes
+    for (auto node : nodes)
+    {
+        // TODO: now one datanode can be used in multiple scenes,
+        // but datanote->scene points only on single scene. This should be
+        // discussed and fixed in the future.
+        if (node->GetScene() == scene && node->GetNodeID() > maxDataNodeID)
+        {
+            maxDataNodeID = node->GetNodeID();
+        }
+    }
+
+    // assign datanode id-s and
+    // count serializable nodes
+    for (auto node : nodes)
+    {
+        if (IsDataNodeSerializable(node))
+        {
+            // TODO: if datanode is from another scene, it should be saved with newly
+            // generated datanode-id. Unfortunately this ID will be generated on every scene save,
+            // because we don't change scene pointer in datanode->scene.
+            // This should be discussed and fixed in the future.
+            serializableNodesCount++;
+            if (node->GetScene() != scene || node->GetNodeID() == DataNode::INVALID_ID)
+            {
+                node->SetNodeID(++maxDataNodeID);
+            }
+        }
+    }
+
+    // do we need to save globalmaterial?
+    NMaterial* globalMaterial = scene->GetGlobalMaterial();
+    if (nullptr != globalMaterial)
+    {
+        if (nodes.count(globalMaterial) > 0)
+        {
+            // remove global material from set,
+            // as it should be saved exclusively
+            // on the top of data nodes
+            nodes.erase(globalMaterial);
+        }
+        else
+        {
+            serializableNodesCount++;
+        }
+    }
+
+    if (nullptr != globalMaterial && globalMaterial->GetNodeID() == DataNode::INVALID_ID)
+    {
+        globalMaterial->SetNodeID(++maxDataNodeID);
+    }
+
+    // sort in ascending ID order
+    Set<DataNode*, std::function<bool(DataNode*, DataNode*)>> sortedNodes(nodes.begin(), nodes.end(),
+                                                                          [](DataNode* a, DataNode* b) { return a->GetNodeID() < b->GetNodeID(); });
+
+    orderedNodes.clear();
+    for (DataNode* node : sortedNodes)
+    {
+        if (IsDataNodeSerializable(node))
+        {
+            orderedNodes.push_back(node);
+        }
+    }
+
+    return serializableNodesCount;
+}
+
 bool SceneFileV2::ReadHeader(SceneFileV2::Header& _header, File* file)
 {
     DVASSERT(file);
@@ -378,6 +395,11 @@ VersionInfo::SceneVersion SceneFileV2::LoadSceneVersion(const FilePath& filename
 
 SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scene)
 {
+    if (filename.IsEqualToExtension(BinarySceneFormat::FILE_EXTENSION))
+    {
+        return LoadSceneBinary(filename, scene);
+    }
+
     ScopedPtr<File> file(File::Create(filename, File::OPEN | File::READ));
     if (!file)
     {
@@ -423,25 +445,11 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
         }
     }
 
-    VersionInfo::eStatus status = GetEngineContext()->versionInfo->TestVersion(scene->version);
-    switch (status)
-    {
-    case VersionInfo::COMPATIBLE:
-    {
-        const String tags = GetEngineContext()->versionInfo->UnsupportedTagsMessage(scene->version);
-        Logger::Warning("SceneFileV2::LoadScene scene was saved with older version of framework. Saving scene will broke compatibility. Missed tags: %s", tags.c_str());
-    }
-    break;
-    case VersionInfo::INVALID:
+    if (!TestSceneVersion(scene, filename))
     {
-        const String tags = GetEngineContext()->versionInfo->NoncompatibleTagsMessage(scene->version);
-        Logger::Error("SceneFileV2::LoadScene scene(%d) is incompatible with current version(%d). Wrong tags: %s", header.version, SCENE_FILE_CURRENT_VERSION, tags.c_str());
         SetError(ERROR_VERSION_TAGS_INVALID);
         return GetError();
     }
-    default:
-        break;
-    }
 
     serializationContext.SetRootNodePath(filename);
     serializationContext.SetScenePath(filename.GetDirectory());
@@ -556,6 +564,30 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
     return GetError();
 }
 
+bool SceneFileV2::TestSceneVersion(Scene* scene, const FilePath& filename)
+{
+    VersionInfo::eStatus status = GetEngineContext()->versionInfo->TestVersion(scene->version);
+    switch (status)
+    {
+    case VersionInfo::COMPATIBLE:
+    {
+        const String tags = GetEngineContext()->versionInfo->UnsupportedTagsMessage(scene->version);
+        Logger::Warning("SceneFileV2::LoadScene scene was saved with older version of framework. Saving scene will broke compatibility. Missed tags: %s", tags.c_str());
+    }
+    break;
+    case VersionInfo::INVALID:
+    {
+        const String tags = GetEngineContext()->versionInfo->NoncompatibleTagsMessage(scene->version);
+        Logger::Error("SceneFileV2::LoadScene scene(%d) is incompatible with current version(%d). Wrong tags: %s. File: %s", scene->version.version, SCENE_FILE_CURRENT_VERSION, tags.c_str(), filename.GetAbsolutePathname().c_str());
+        return false;
+    }
+    default:
+        break;
+    }
+
+    return true;
+}
+
 void SceneFileV2::ApplyFogQuality(NMaterial* globalMaterial)
 {
     QualitySettingsSystem* qss = QualitySettingsSystem::Instance();
@@ -774,11 +806,15 @@ bool SceneFileV2::SaveDataNode(DataNode* node, File* file)
 
 bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 {
-    bool loaded = true;
     uint32 currFilePos = static_cast<uint32>(file->GetPos());
     ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-    loaded &= archive->Load(file);
+    bool loaded = archive->Load(file);
 
+    return CreateDataNode(scene, archive, currFilePos) && loaded;
+}
+
+bool SceneFileV2::CreateDataNode(Scene* scene, KeyedArchive* archive, uint32 filePos)
+{
     String name = archive->GetString("##name");
     DataNode* node = dynamic_cast<DataNode*>(ObjectFactory::Instance()->New<BaseObject>(name));
 
@@ -801,7 +837,7 @@ bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 
         if (name == "PolygonGroup")
         {
-            serializationContext.AddLoadedPolygonGroup(static_cast<PolygonGroup*>(node), currFilePos);
+            serializationContext.AddLoadedPolygonGroup(static_cast<PolygonGroup*>(node), filePos);
         }
 
         int32 childrenCount = archive->GetInt32("#childrenCount", 0);
@@ -809,7 +845,7 @@ bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 
         SafeRelease(node);
     }
-    return loaded;
+    return true;
 }
 
 bool SceneFileV2::SaveDataHierarchy(DataNode* node, File* /*file*/, int32 /*level*/)
@@ -62,6 +62,7 @@ namespace DAVA
      scene->Load("filename
 */
 
+class Component;
 class NMaterial;
 class Scene;
 
@@ -125,6 +126,12 @@ public:
 
     eError SaveScene(const FilePath& filename, Scene* _scene, SceneFileV2::eFileType fileType = SceneFileV2::SceneFile);
     eError LoadScene(const FilePath& filename, Scene* _scene);
+
+    /**
+        Save scene into binary memory-mappable container, see BinarySceneFormat.
+        Such file is loaded with `LoadScene` when its extension is BinarySceneFormat::FILE_EXTENSION.
+    */
+    eError SaveSceneBinary(const FilePath& filename, Scene* _scene, SceneFileV2::eFileType fileType = SceneFileV2::SceneFile);
     static VersionInfo::SceneVersion LoadSceneVersion(const FilePath& filename);
 
     void EnableDebugLog(bool _isDebugLogEnabled);
@@ -154,6 +161,15 @@ private:
     static bool ReadHeader(Header& header, File* file);
     static bool ReadVersionTags(VersionInfo::SceneVersion& version, File* file);
     void AddToNodeMap(DataNode* node);
+    bool TestSceneVersion(Scene* scene, const FilePath& filename);
+    uint32 PrepareDataNodesForSave(Scene* scene, Vector<DataNode*>& orderedNodes);
+
+    eError LoadSceneBinary(const FilePath& filename, Scene* scene);
+
+    /** Write fixed binary record of `component` into `record`. Return false if component is not stored as a record. */
+    static bool SaveComponentRecord(Component* component, Vector<uint8>& record, uint32& encoding);
+    /** Create component from fixed binary record. Does not touch scene, so it can be called on job workers. */
+    static Component* LoadComponentRecord(uint32 encoding, const uint8* data, uint32 size);
 
     Header header;
 
@@ -170,6 +186,7 @@ private:
     void LoadDataHierarchy(Scene* scene, DataNode* node, File* file, int32 level);
     bool SaveDataNode(DataNode* node, File* file);
     bool LoadDataNode(Scene* scene, DataNode* parent, File* file);
+    bool CreateDataNode(Scene* scene, KeyedArchive* archive, uint32 filePos);
 
     inline bool IsDataNodeSerializable(DataNode* node)
     {
@@ -1,7 +1,64 @@
 #include "JointTransform.h"
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DAVA_JOINT_TRANSFORM_SSE 1
+#include <xmmintrin.h>
+#endif
+
 namespace DAVA
 {
+#if defined(DAVA_JOINT_TRANSFORM_SSE)
+namespace JointTransformDetails
+{
+template <int lane>
+inline __m128 Splat(__m128 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(lane, lane, lane, lane));
+}
+
+// w lane of result is zero
+inline __m128 CrossProduct(__m128 a, __m128 b)
+{
+    __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+    __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+    return _mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX));
+}
+
+// same as Quaternion::operator*
+inline __m128 MultiplyQuaternions(__m128 q1, __m128 q2)
+{
+    const __m128 signX = _mm_setr_ps(1.f, -1.f, 1.f, -1.f);
+    const __m128 signY = _mm_setr_ps(1.f, 1.f, -1.f, -1.f);
+    const __m128 signZ = _mm_setr_ps(-1.f, 1.f, 1.f, -1.f);
+
+    __m128 res = _mm_mul_ps(Splat<3>(q1), q2);
+    res = _mm_add_ps(res, _mm_mul_ps(Splat<0>(q1), _mm_mul_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 1, 2, 3)), signX)));
+    res = _mm_add_ps(res, _mm_mul_ps(Splat<1>(q1), _mm_mul_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(1, 0, 3, 2)), signY)));
+    res = _mm_add_ps(res, _mm_mul_ps(Splat<2>(q1), _mm_mul_ps(_mm_shuffle_ps(q2, q2, _MM_SHUFFLE(2, 3, 0, 1)), signZ)));
+    return res;
+}
+
+// same as Quaternion::ApplyToVectorFast for xyz, w lane of `v` is kept
+inline __m128 RotateVector(__m128 q, __m128 v)
+{
+    __m128 t = CrossProduct(q, v);
+    t = _mm_add_ps(t, t);
+    return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(Splat<3>(q), t)), CrossProduct(q, t));
+}
+
+// xyz - position, w - scale of t0.AppendTransform(t1)
+inline __m128 AppendPositionScale(__m128 orientation0, __m128 positionScale0, __m128 positionScale1)
+{
+    const __m128 maskXYZ = _mm_setr_ps(1.f, 1.f, 1.f, 0.f);
+
+    __m128 rotated = RotateVector(orientation0, positionScale1);
+    return _mm_add_ps(_mm_mul_ps(positionScale0, maskXYZ), _mm_mul_ps(rotated, Splat<3>(positionScale0)));
+}
+}
+#endif
+
 JointTransform::JointTransform(const Matrix4& transform)
 {
     Construct(transform);
@@ -23,6 +80,14 @@ Matrix4 JointTransform::GetMatrix() const
 JointTransform JointTransform::AppendTransform(const JointTransform& transform) const
 {
     JointTransform res;
+#if defined(DAVA_JOINT_TRANSFORM_SSE)
+    Vector4 positionScale;
+    Vector4 resOrientation;
+    AppendTransform(transform, positionScale, resOrientation);
+    res.position = Vector3(positionScale.x, positionScale.y, positionScale.z);
+    res.scale = positionScale.w;
+    res.orientation = Quaternion(resOrientation.data);
+#else
     res.position = ApplyToPoint(transform.position);
     res.scale = scale * transform.scale;
 
@@ -32,12 +97,39 @@ JointTransform JointTransform::AppendTransform(const JointTransform& transform)
         res.orientation = orientation;
     else if (transform.HasOrientation())
         res.orientation = transform.orientation;
-
+#endif
     res.flags = flags | transform.flags;
 
     return res;
 }
 
+void JointTransform::AppendTransform(const JointTransform& transform, Vector4& outPositionScale, Vector4& outOrientation) const
+{
+#if defined(DAVA_JOINT_TRANSFORM_SSE)
+    using namespace JointTransformDetails;
+
+    __m128 orientation0 = _mm_setr_ps(orientation.x, orientation.y, orientation.z, orientation.w);
+    __m128 positionScale0 = _mm_setr_ps(position.x, position.y, position.z, scale);
+    __m128 positionScale1 = _mm_setr_ps(transform.position.x, transform.position.y, transform.position.z, transform.scale);
+    _mm_storeu_ps(outPositionScale.data, AppendPositionScale(orientation0, positionScale0, positionScale1));
+
+    if (HasOrientation() && transform.HasOrientation())
+    {
+        __m128 orientation1 = _mm_setr_ps(transform.orientation.x, transform.orientation.y, transform.orientation.z, transform.orientation.w);
+        _mm_storeu_ps(outOrientation.data, MultiplyQuaternions(orientation0, orientation1));
+    }
+    else
+    {
+        const Quaternion& q = transform.HasOrientation() ? transform.orientation : orientation;
+        outOrientation = Vector4(q.x, q.y, q.z, q.w);
+    }
+#else
+    JointTransform res = AppendTransform(transform);
+    outPositionScale = Vector4(res.position, res.scale);
+    outOrientation = Vector4(res.orientation.data);
+#endif
+}
+
 JointTransform JointTransform::GetInverse() const
 {
     JointTransform res;
@@ -33,6 +33,11 @@ public:
     void Construct(const Matrix4& transform);
 
     JointTransform AppendTransform(const JointTransform& transform) const;
+    /**
+        Same as AppendTransform, but writes result in form consumed by skinning shader:
+        `outPositionScale` is position in xyz and scale in w, `outOrientation` is orientation quaternion.
+    */
+    void AppendTransform(const JointTransform& transform, Vector4& outPositionScale, Vector4& outOrientation) const;
     JointTransform GetInverse() const;
 
     Vector3 ApplyToPoint(const Vector3& point) const;
@@ -34,6 +34,7 @@ void SkeletonAnimation::BindSkeleton(const SkeletonComponent* skeleton)
     for (SkeletonAnimationClip& clip : animationClips)
     {
         clip.boundTracks.clear();
+        clip.boundTracksKeyCursors.clear();
 
         uint32 trackCount = clip.animationClip->GetTrackCount();
         uint32 jointCount = skeleton->GetJointsCount();
@@ -47,7 +48,9 @@ void SkeletonAnimation::BindSkeleton(const SkeletonComponent* skeleton)
             const AnimationTrack* track = clip.animationClip->FindTrack(joint.uid.c_str());
             if (track != nullptr)
             {
+                DVASSERT(track->GetChannelsCount() <= AnimationTrack::CHANNEL_TARGET_COUNT);
                 clip.boundTracks.emplace_back(std::make_pair(j, track));
+                clip.boundTracksKeyCursors.emplace_back(KeyCursors{});
                 maxJointIndex = Max(maxJointIndex, j);
             }
         }
@@ -89,7 +92,7 @@ void SkeletonAnimation::EvaluatePose(float32 animationLocalTime, SkeletonPose* o
         uint32 jointIndex = clip->boundTracks[t].first;
         const AnimationTrack* track = clip->boundTracks[t].second;
 
-        outPose->SetTransform(jointIndex, EvaluateJointTransform(animationLocalTime, track));
+        outPose->SetTransform(jointIndex, EvaluateJointTransform(animationLocalTime, track, &clip->boundTracksKeyCursors[t]));
     }
 }
 
@@ -137,16 +140,17 @@ float32 SkeletonAnimation::GetDuration() const
 
 //////////////////////////////////////////////////////////////////////////
 
-JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track)
+JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track, KeyCursors* keyCursors)
 {
     static const uint32 MAX_CHANNEL_VALUE_SIZE = 4;
     DVASSERT(MAX_CHANNEL_VALUE_SIZE >= track->GetMaxChannelValueSize());
 
     JointTransform transform;
     Array<float32, MAX_CHANNEL_VALUE_SIZE> workData;
-    for (uint32 c = 0; c < track->GetChannelsCount(); ++c)
+    uint32 channelsCount = Min(track->GetChannelsCount(), uint32(keyCursors->size()));
+    for (uint32 c = 0; c < channelsCount; ++c)
     {
-        track->Evaluate(time, c, workData.data(), uint32(workData.size()));
+        track->Evaluate(time, c, workData.data(), uint32(workData.size()), &(*keyCursors)[c]);
 
         AnimationTrack::eChannelTarget target = track->GetChannelTarget(c);
         switch (target)
@@ -180,7 +184,7 @@ void SkeletonAnimation::EvaluateRootPosition(SkeletonAnimationClip* clip, float3
 
     if (clip->rootNodePositionChannel != std::numeric_limits<uint32>::max() && clip->rootNodeTrack != nullptr)
     {
-        clip->rootNodeTrack->Evaluate(GetClipLocalTime(clip, animationLocalTime), clip->rootNodePositionChannel, outPosition->data, uint32(Vector3::AXIS_COUNT));
+        clip->rootNodeTrack->Evaluate(GetClipLocalTime(clip, animationLocalTime), clip->rootNodePositionChannel, outPosition->data, uint32(Vector3::AXIS_COUNT), &clip->rootNodeKeyCursor);
     }
 }
 
@@ -25,21 +25,25 @@ public:
     float32 GetDuration() const;
 
 protected:
+    using KeyCursors = Array<uint32, AnimationTrack::CHANNEL_TARGET_COUNT>;
+
     struct SkeletonAnimationClip
     {
         AnimationClip* animationClip = nullptr;
         UnorderedSet<uint32> jointsIgnoreMask;
 
         Vector<std::pair<uint32, const AnimationTrack*>> boundTracks; //[jointIndex, track]
+        Vector<KeyCursors> boundTracksKeyCursors; //last evaluated keys of bound tracks channels, clip data is shared between animations
         const AnimationTrack* rootNodeTrack = nullptr; //for root-node transform extraction
         uint32 rootNodePositionChannel = std::numeric_limits<uint32>::max();
+        uint32 rootNodeKeyCursor = 0;
 
         float32 duration = 0.f;
         float32 clipStartTimestamp = 0.f;
         float32 animationStartTimestamp = 0.f;
     };
 
-    static JointTransform EvaluateJointTransform(float32 time, const AnimationTrack* track);
+    static JointTransform EvaluateJointTransform(float32 time, const AnimationTrack* track, KeyCursors* keyCursors);
     void EvaluateRootPosition(SkeletonAnimationClip* clip, float32 animationLocalTime, Vector3* outPosition);
     SkeletonAnimationClip* FindClip(float32 animationTime);
     float32 GetClipLocalTime(SkeletonAnimationClip* clip, float32 animationLocalTime);
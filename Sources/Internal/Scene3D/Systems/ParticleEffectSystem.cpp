@@ -1,6 +1,7 @@
 #include "Scene3D/Systems/ParticleEffectSystem.h"
 
 #include <limits>
+#include <random>
 
 #include "Math/MathConstants.h"
 #include "Scene3D/Components/ParticleEffectComponent.h"
@@ -25,11 +26,26 @@
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Job/JobScheduler.h"
 
 namespace DAVA
 {
 namespace ParticleEffectSystemDetails
 {
+// Smallest number of effects simulated by one job
+const uint32 PARALLEL_GRAIN_SIZE = 8;
+
+bool HasSuperemitterGroups(const List<ParticleGroup>& groups)
+{
+    for (const ParticleGroup& group : groups)
+    {
+        if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+            return true;
+    }
+    return false;
+}
+
 Matrix3 GenerateEmitterRotationMatrix(Vector3 vector, float32 power)
 {
     Vector3 axis(vector.y, -vector.x, 0);
@@ -41,6 +57,38 @@ Matrix3 GenerateEmitterRotationMatrix(Vector3 vector, float32 power)
 }
 }
 
+struct ParticleEffectSystem::UpdateContext
+{
+    explicit UpdateContext(uint32 seed)
+        : generator(seed)
+    {
+    }
+
+    float32 RandFloat()
+    {
+        return std::uniform_real_distribution<float32>(0.0f, 1.0f)(generator);
+    }
+
+    uint32 Rand()
+    {
+        return static_cast<uint32>(generator());
+    }
+
+    // engine Random is not thread safe, so every context has own generator
+    std::mt19937 generator;
+
+    // forces of currently updated group, force world positions are kept here as forces are shared between effects
+    Vector<Vector3> currSimplifiedForceValues;
+    Vector<ParticleForce*> effectAlignForces;
+    Vector<ParticleForce*> worldAlignForces;
+    Vector<Vector3> worldAlignForcePositions;
+
+    // per particle scratch arrays reused by bulk updates of particle groups
+    Vector<float32> particlesOverLife;
+    Vector<float32> particlesScale;
+    Vector<Vector3> particlesPrevPosition;
+};
+
 NMaterial* ParticleEffectSystem::AcquireMaterial(const MaterialData& materialData)
 {
     if (materialData.texture == nullptr) //for superemitter particles eg
@@ -132,10 +180,14 @@ ParticleEffectSystem::ParticleEffectSystem(Scene* scene, bool _is2DMode)
 
     particleBaseMaterial = new NMaterial();
     particleBaseMaterial->SetFXName(NMaterialName::PARTICLES);
+
+    updateContexts.emplace_back(new UpdateContext(GetEngineContext()->random->Rand()));
 }
 
 ParticleEffectSystem::~ParticleEffectSystem()
 {
+    WaitSimulation();
+
     for (auto& it : particlesMaterials)
         SafeRelease(it.second);
 
@@ -300,7 +352,8 @@ void ParticleEffectSystem::AddToActive(ParticleEffectComponent* effect)
             Matrix4* worldTransformPointer = effect->GetEntity()->GetComponent<TransformComponent>()->GetWorldMatrixPtr();
             effect->effectRenderObject->SetWorldMatrixPtr(worldTransformPointer);
             Vector3 pos = worldTransformPointer->GetTranslationVector();
-            effect->effectRenderObject->SetAABBox(AABBox3(pos, pos));
+            effect->effectData.bbox = AABBox3(pos, pos);
+            effect->effectRenderObject->SetAABBox(effect->effectData.bbox);
             scene->GetRenderSystem()->RenderPermanent(effect->effectRenderObject);
         }
     }
@@ -324,18 +377,21 @@ void ParticleEffectSystem::RemoveFromActive(ParticleEffectComponent* effect)
 
 void ParticleEffectSystem::AddEntity(Entity* entity)
 {
+    WaitSimulation();
     ParticleEffectComponent* effect = entity->GetComponent<ParticleEffectComponent>();
     PrebuildMaterials(effect);
 }
 
 void ParticleEffectSystem::AddComponent(Entity* entity, Component* component)
 {
+    WaitSimulation();
     ParticleEffectComponent* effect = static_cast<ParticleEffectComponent*>(component);
     PrebuildMaterials(effect);
 }
 
 void ParticleEffectSystem::RemoveEntity(Entity* entity)
 {
+    WaitSimulation();
     ParticleEffectComponent* effect = entity->GetComponent<ParticleEffectComponent>();
     if (effect && effect->state != ParticleEffectComponent::STATE_STOPPED)
         RemoveFromActive(effect);
@@ -343,6 +399,7 @@ void ParticleEffectSystem::RemoveEntity(Entity* entity)
 
 void ParticleEffectSystem::RemoveComponent(Entity* entity, Component* component)
 {
+    WaitSimulation();
     ParticleEffectComponent* effect = static_cast<ParticleEffectComponent*>(component);
     if (effect && effect->state != ParticleEffectComponent::STATE_STOPPED)
         RemoveFromActive(effect);
@@ -350,6 +407,9 @@ void ParticleEffectSystem::RemoveComponent(Entity* entity, Component* component)
 
 void ParticleEffectSystem::PrepareForRemove()
 {
+    WaitSimulation();
+    simulationPending = false;
+
     if (QualitySettingsSystem::Instance()->IsOptionEnabled(QualitySettingsSystem::QUALITY_OPTION_DISABLE_EFFECTS) == false)
     {
         for (ParticleEffectComponent* component : activeComponents)
@@ -369,6 +429,7 @@ void ParticleEffectSystem::ImmediateEvent(Component* component, uint32 event)
     DVASSERT(component->GetType()->Is<ParticleEffectComponent>());
 
     ParticleEffectComponent* effect = static_cast<ParticleEffectComponent*>(component);
+    WaitSimulation();
     if (event == EventSystem::START_PARTICLE_EFFECT)
     {
         if (effect->state == ParticleEffectComponent::STATE_STOPPED)
@@ -390,6 +451,14 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_PARTICLE_SYSTEM);
 
+    // simulation started by previous Process overlapped drawing of previous render data, publish its results now
+    WaitSimulation();
+    if (simulationPending)
+    {
+        simulationPending = false;
+        FinishEffects();
+    }
+
     if (timeElapsed == 0.f)
     {
         timeElapsed = 0.000001f;
@@ -405,10 +474,10 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     float32 speedMult = 1.0f + (perfSettings->GetPsPerformanceSpeedMult() - 1.0f) * (1 - currPSValue);
     float32 shortEffectTime = timeElapsed * speedMult;
 
-    size_t componentsCount = activeComponents.size();
-    for (size_t i = 0; i < componentsCount; i++)
+    parallelEffects.clear();
+    mainThreadEffects.clear();
+    for (ParticleEffectComponent* effect : activeComponents)
     {
-        ParticleEffectComponent* effect = activeComponents[i];
         if (effect->activeLodLevel != effect->desiredLodLevel)
             UpdateActiveLod(effect);
         if (effect->state == ParticleEffectComponent::STATE_STARTING)
@@ -418,7 +487,30 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
 
         if (effect->isPaused)
             continue;
-        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed);
+
+        if (ParticleEffectSystemDetails::HasSuperemitterGroups(effect->effectData.groups))
+            mainThreadEffects.push_back(effect);
+        else
+            parallelEffects.push_back(effect);
+    }
+
+    UpdateEffects(timeElapsed, shortEffectTime);
+    if (!simulationPending)
+    {
+        FinishEffects();
+    }
+}
+
+void ParticleEffectSystem::FinishEffects()
+{
+    // restarting, stopping and callbacks may change active effects and materials, so they are done after simulation
+    size_t componentsCount = activeComponents.size();
+    for (size_t i = 0; i < componentsCount; i++)
+    {
+        ParticleEffectComponent* effect = activeComponents[i];
+        // effects started after simulation was scheduled are run by next Process
+        if (effect->isPaused || effect->state == ParticleEffectComponent::STATE_STARTING)
+            continue;
 
         bool effectEnded = effect->stopWhenEmpty ? effect->effectData.groups.empty() : (effect->time > effect->effectDuration);
         if (effectEnded)
@@ -436,6 +528,8 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
                 effect->SetGroupsFinishing();
             }
         }
+        PublishRenderData(effect);
+
         /*finish restart criteria*/
         if ((effect->state == ParticleEffectComponent::STATE_STOPPING) && effect->effectData.groups.empty())
         {
@@ -456,6 +550,103 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     }
 }
 
+void ParticleEffectSystem::UpdateEffects(float32 timeElapsed, float32 shortEffectTime)
+{
+    for (ParticleEffectComponent* effect : mainThreadEffects)
+        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed);
+
+    JobScheduler* scheduler = nullptr;
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    Scene* scene = GetScene();
+    if (jobManager != nullptr && scene != nullptr && scene->GetSystemsProcessMode() == Scene::eSystemsProcessMode::PARALLEL)
+    {
+        scheduler = jobManager->GetScheduler();
+    }
+
+    const uint32 grainSize = ParticleEffectSystemDetails::PARALLEL_GRAIN_SIZE;
+    uint32 effectsCount = static_cast<uint32>(parallelEffects.size());
+    uint32 workersCount = (scheduler != nullptr) ? scheduler->GetWorkersCount() : 0;
+    if (maxSimulationThreads > 0)
+        workersCount = Min(workersCount, maxSimulationThreads);
+
+    if (workersCount > 0 && effectsCount > grainSize)
+    {
+        while (updateContexts.size() < scheduler->GetWorkersCount() + 1)
+            updateContexts.emplace_back(new UpdateContext(GetEngineContext()->random->Rand()));
+
+        // one job per allowed worker, jobs take chunks of effects until all are simulated
+        uint32 jobsCount = Min(workersCount, (effectsCount + grainSize - 1) / grainSize);
+        nextSimulatedEffect = 0;
+        simulationScheduler = scheduler;
+        simulationJob = scheduler->CreateGroup();
+        for (uint32 job = 0; job < jobsCount; ++job)
+        {
+            scheduler->Schedule([this, scheduler, effectsCount, timeElapsed, shortEffectTime]() {
+                // main thread may execute the job while waiting, it uses the first context
+                UpdateContext& context = *updateContexts[scheduler->GetCurrentWorkerIndex() + 1];
+                for (uint32 begin = nextSimulatedEffect.fetch_add(grainSize); begin < effectsCount; begin = nextSimulatedEffect.fetch_add(grainSize))
+                {
+                    for (uint32 i = begin, end = Min(begin + grainSize, effectsCount); i < end; ++i)
+                    {
+                        ParticleEffectComponent* effect = parallelEffects[i];
+                        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed, context);
+                    }
+                }
+            },
+                                simulationJob);
+        }
+        scheduler->SealGroup(simulationJob);
+        simulationPending = true;
+    }
+    else
+    {
+        for (ParticleEffectComponent* effect : parallelEffects)
+            UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed);
+    }
+}
+
+void ParticleEffectSystem::WaitSimulation()
+{
+    if (simulationJob)
+    {
+        simulationScheduler->Wait(simulationJob);
+        simulationJob.reset();
+    }
+}
+
+void ParticleEffectSystem::PublishRenderData(ParticleEffectComponent* effect)
+{
+    const ParticleEffectData& simulated = effect->effectData;
+    ParticleEffectData& published = effect->renderData;
+    published.infoSources = simulated.infoSources;
+
+    // groups are assigned in place to reuse particle arrays, published groups keep own references to layers and emitters
+    List<ParticleGroup>::iterator it = published.groups.begin();
+    for (const ParticleGroup& group : simulated.groups)
+    {
+        if (it == published.groups.end())
+            it = published.groups.emplace(it);
+
+        SafeRetain(group.layer);
+        SafeRetain(group.emitter);
+        SafeRelease(it->layer);
+        SafeRelease(it->emitter);
+        *it = group;
+        ++it;
+    }
+    while (it != published.groups.end())
+    {
+        effect->ClearGroup(*it);
+        it = published.groups.erase(it);
+    }
+
+    if (!simulated.bbox.IsEmpty())
+    {
+        published.bbox = simulated.bbox;
+        effect->effectRenderObject->SetAABBox(published.bbox);
+    }
+}
+
 void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
 {
     DVASSERT(effect->activeLodLevel != effect->desiredLodLevel);
@@ -474,42 +665,26 @@ void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
             ParticleGroup& group = *it;
             if (group.layer->degradeStrategy == ParticleLayer::DEGRADE_REMOVE)
             {
-                Particle* current = group.head;
-                while (current)
-                {
-                    Particle* next = current->next;
-                    delete current;
-                    current = next;
-                }
-                group.head = nullptr;
+                group.particles.Clear();
             }
             else if (group.layer->degradeStrategy == ParticleLayer::DEGRADE_CUT_PARTICLES)
             {
-                Particle* current = group.head;
-                Particle* prev = nullptr;
-                int32 i = 0;
-                while (current)
+                for (uint32 i = 1; i < group.particles.GetCount(); i += 2) //cut every second particle
                 {
-                    Particle* next = current->next;
-                    if (i % 2) //cut every second particle
-                    {
-                        delete current;
-                        group.activeParticleCount--;
-                        if (prev)
-                            prev->next = next;
-                        else
-                            group.head = next;
-                    }
-                    prev = current;
-                    current = next;
-                    i++;
+                    group.particles.Kill(i);
                 }
+                group.activeParticleCount -= group.particles.RemoveDead(group.layer->NeedsOrderedParticles());
             }
         }
     }
 }
 
 void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime)
+{
+    UpdateEffect(effect, deltaTime, shortEffectTime, *updateContexts.front());
+}
+
+void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime, UpdateContext& context)
 {
     effect->time += deltaTime;
     const Matrix4* worldTransformPtr;
@@ -526,7 +701,7 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
 
     AABBox3 bbox;
     List<ParticleGroup>::iterator it = effect->effectData.groups.begin();
-    Random* random = GetEngineContext()->random;
+    Matrix4 invWorld;
     bool isInverseCalculated = false;
     while (it != effect->effectData.groups.end())
     {
@@ -543,22 +718,18 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         if ((!group.finishingGroup) && (group.layer->isLooped) && (currLoopTime > group.loopDuration)) //restart loop
         {
             group.loopStartTime = group.time;
-            group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * static_cast<float32>(random->RandFloat());
-            group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * static_cast<float32>(random->RandFloat());
+            group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * context.RandFloat();
+            group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * context.RandFloat();
             currLoopTime = 0;
         }
 
         //prepare forces as they will now actually change in time even for already generated particles
-        static Vector<Vector3> currSimplifiedForceValues;
-        int32 simplifiedForcesCount;
+        Vector<Vector3>& currSimplifiedForceValues = context.currSimplifiedForceValues;
+        int32 simplifiedForcesCount = 0;
 
-        static Vector<ParticleForce*> effectAlignCurrForces;
-        static Vector<ParticleForce*> worldAlignCurrForces;
         uint32 forcesCountWorldAlign = 0;
         uint32 effectAlignForcesCount = 0;
-
-        static Matrix4 invWorld;
-        if (group.head)
+        if (!group.particles.IsEmpty())
         {
             simplifiedForcesCount = static_cast<int32>(group.layer->GetSimplifiedParticleForces().size());
             if (simplifiedForcesCount)
@@ -576,8 +747,9 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
             uint32 allForcesCount = static_cast<uint32>(group.layer->GetParticleForces().size());
             if (allForcesCount > 0)
             {
-                effectAlignCurrForces.resize(allForcesCount);
-                worldAlignCurrForces.resize(allForcesCount);
+                context.effectAlignForces.resize(allForcesCount);
+                context.worldAlignForces.resize(allForcesCount);
+                context.worldAlignForcePositions.resize(allForcesCount);
                 for (uint32 i = 0; i < allForcesCount; ++i)
                 {
                     DAVA::ParticleForce* currForce = group.layer->GetParticleForces()[i];
@@ -586,13 +758,13 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
 
                     if (currForce->worldAlign)
                     {
-                        currForce->worldPosition = currForce->position + worldTransformPtr->GetTranslationVector(); // Ignore emitter rotation.
-                        worldAlignCurrForces[forcesCountWorldAlign] = currForce;
+                        context.worldAlignForcePositions[forcesCountWorldAlign] = currForce->position + worldTransformPtr->GetTranslationVector(); // Ignore emitter rotation.
+                        context.worldAlignForces[forcesCountWorldAlign] = currForce;
                         ++forcesCountWorldAlign;
                     }
                     else
                     {
-                        effectAlignCurrForces[effectAlignForcesCount] = currForce;
+                        context.effectAlignForces[effectAlignForcesCount] = currForce;
                         ++effectAlignForcesCount;
                         if (!isInverseCalculated)
                         {
@@ -604,70 +776,60 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
             }
         }
 
-        Particle* current = group.head;
-        Particle* prev = nullptr;
+        ParticleStorage& particles = group.particles;
+        particles.AddLife(dt);
+        particles.RemoveDead(group.layer->NeedsOrderedParticles());
+        uint32 particleCount = particles.GetCount();
+        group.activeParticleCount = static_cast<int32>(particleCount);
 
-        while (current)
-        {
-            current->life += dt;
-            if (current->life >= current->lifeTime)
-            {
-                Particle* next = current->next;
-                if (prev == nullptr)
-                    group.head = next;
-                else
-                    prev->next = next;
-                delete current;
-                current = next;
-                continue;
-            }
-            group.activeParticleCount++;
+        Vector<float32>& particlesOverLife = context.particlesOverLife;
+        particlesOverLife.resize(particleCount);
+        particles.ComputeOverLife(particlesOverLife.data());
 
-            float32 overLifeTime = current->life / current->lifeTime;
+        if ((particleCount > 0) && (group.layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE))
+        {
+            UpdateRegularParticlesData(effect, group, context, simplifiedForcesCount, dt, bbox, effectAlignForcesCount, forcesCountWorldAlign, *worldTransformPtr, invWorld, currLoopTimeNormalized);
+        }
 
-            if (group.layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE)
-            {
-                UpdateRegularParticleData(effect, current, group, overLifeTime, simplifiedForcesCount, currSimplifiedForceValues, dt, bbox, effectAlignCurrForces, effectAlignForcesCount, worldAlignCurrForces, forcesCountWorldAlign, *worldTransformPtr, invWorld, currLoopTimeNormalized);
-            }
+        for (uint32 current = 0; current < particleCount; ++current)
+        {
+            float32 overLifeTime = particlesOverLife[current];
 
             if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
             {
-                effect->effectData.infoSources[current->positionTarget].position = current->position;
-                effect->effectData.infoSources[current->positionTarget].size = current->currSize;
+                effect->effectData.infoSources[particles.positionTarget[current]].position = particles.GetPosition(current);
+                effect->effectData.infoSources[particles.positionTarget[current]].size = particles.currSize[current];
             }
 
             if (group.layer->enableNoise && group.layer->noise.get() != nullptr)
             {
                 if (group.layer->noiseScaleOverLife != nullptr)
-                    current->currNoiseScale = current->baseNoiseScale * group.layer->noiseScaleOverLife->GetValue(overLifeTime);
+                    particles.currNoiseScale[current] = particles.baseNoiseScale[current] * group.layer->noiseScaleOverLife->GetValue(overLifeTime);
 
                 DAVA::float32 overLifeScale = 1.0f;
                 if (group.layer->noiseUScrollSpeedOverLife != nullptr)
                 {
                     overLifeScale = group.layer->noiseUScrollSpeedOverLife->GetValue(overLifeTime);
                 }
-                current->currNoiseUOffset += current->baseNoiseUScrollSpeed * overLifeScale * deltaTime;
+                particles.currNoiseUOffset[current] += particles.baseNoiseUScrollSpeed[current] * overLifeScale * deltaTime;
 
                 overLifeScale = 1.0f;
                 if (group.layer->noiseVScrollSpeedOverLife != nullptr)
                 {
                     overLifeScale = group.layer->noiseVScrollSpeedOverLife->GetValue(overLifeTime);
                 }
-                current->currNoiseVOffset += current->baseNoiseVScrollSpeed * overLifeScale * deltaTime;
+                particles.currNoiseVOffset[current] += particles.baseNoiseVScrollSpeed[current] * overLifeScale * deltaTime;
             }
 
             if (group.layer->enableAlphaRemap && group.layer->alphaRemapSprite.get() != nullptr && group.layer->alphaRemapOverLife != nullptr)
             {
                 float32 lookup = overLifeTime * group.layer->alphaRemapLoopCount;
                 float32 intPart;
-                current->alphaRemap = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
+                particles.alphaRemap[current] = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
             }
 
             if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
-                UpdateStripe(current, effect->effectData, group, deltaTime, bbox, currSimplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
-
-            prev = current;
-            current = current->next;
+                UpdateStripe(particles, current, effect->effectData, group, deltaTime, bbox, currSimplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
         }
         bool allowParticleGeneration = !group.finishingGroup;
         allowParticleGeneration &= (currLoopTime > group.loopLayerStartTime);
@@ -676,13 +838,13 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         {
             if (group.layer->type == ParticleLayer::TYPE_SINGLE_PARTICLE || group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
             {
-                if (!group.head)
+                if (particles.IsEmpty())
                 {
-                    current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr);
+                    uint32 current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr, context);
                     if (group.layer->GetInheritPosition())
-                        AddParticleToBBox(current->position + effect->effectData.infoSources[group.positionSource].position, current->currRadius, bbox);
+                        AddParticleToBBox(particles.GetPosition(current) + effect->effectData.infoSources[group.positionSource].position, particles.currRadius[current], bbox);
                     else
-                        AddParticleToBBox(current->position, current->currRadius, bbox);
+                        AddParticleToBBox(particles.GetPosition(current), particles.currRadius[current], bbox);
                 }
             }
             else
@@ -692,23 +854,23 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
                 if (group.layer->number)
                     newParticles = group.layer->number->GetValue(currLoopTime);
                 if (group.layer->numberVariation)
-                    newParticles += group.layer->numberVariation->GetValue(currLoopTime) * static_cast<float32>(random->RandFloat());
+                    newParticles += group.layer->numberVariation->GetValue(currLoopTime) * context.RandFloat();
                 newParticles *= dt;
                 group.particlesToGenerate += newParticles;
 
                 while (group.particlesToGenerate >= 1.0f)
                 {
                     group.particlesToGenerate -= 1.0f;
-                    current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr);
+                    uint32 current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr, context);
                     if (group.layer->GetInheritPosition())
-                        AddParticleToBBox(current->position + effect->effectData.infoSources[group.positionSource].position, current->currRadius, bbox);
+                        AddParticleToBBox(particles.GetPosition(current) + effect->effectData.infoSources[group.positionSource].position, particles.currRadius[current], bbox);
                     else
-                        AddParticleToBBox(current->position, current->currRadius, bbox);
+                        AddParticleToBBox(particles.GetPosition(current), particles.currRadius[current], bbox);
                 }
             }
         }
 
-        if (group.finishingGroup && (group.head == nullptr))
+        if (group.finishingGroup && particles.IsEmpty())
         {
             DAVA::SafeRelease(group.emitter);
             DAVA::SafeRelease(group.layer);
@@ -724,15 +886,15 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         Vector3 pos = worldTransformPtr->GetTranslationVector();
         bbox = AABBox3(pos, pos);
     }
-    effect->effectRenderObject->SetAABBox(bbox);
+    effect->effectData.bbox = bbox;
 }
 
-void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive)
+void ParticleEffectSystem::UpdateStripe(const ParticleStorage& particles, uint32 particleIndex, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive)
 {
     ParticleLayer* layer = group.layer;
     StripeData& data = group.stripe;
     Vector3 prevBasePosition = data.baseNode.position;
-    data.baseNode.position = particle->position;
+    data.baseNode.position = particles.GetPosition(particleIndex);
     data.isActive = isActive;
 
     if (layer->GetInheritPosition())
@@ -745,7 +907,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
         data.baseNode.position = effectData.infoSources[group.positionSource].position;
     }
 
-    data.baseNode.speed = particle->speed;
+    data.baseNode.speed = particles.GetSpeed(particleIndex);
 
     bool shouldInsert = data.stripeNodes.empty() || (data.baseNode.position - data.stripeNodes.front().position).SquareLength() > layer->stripeVertexSpawnStep * layer->stripeVertexSpawnStep;
 
@@ -814,7 +976,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
         else
         {
             float32 delta = (data.baseNode.position - prevBasePosition).Length();
-            if (particle->speed.DotProduct(data.baseNode.position - prevBasePosition) <= 0)
+            if (particles.GetSpeed(particleIndex).DotProduct(data.baseNode.position - prevBasePosition) <= 0)
             {
                 data.uvOffset -= delta;
             }
@@ -833,212 +995,276 @@ void ParticleEffectSystem::AddParticleToBBox(const Vector3& position, float radi
     bbox.AddPoint(position + sz);
 }
 
-Particle* ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform)
+uint32 ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform, UpdateContext& context)
 {
-    Particle* particle = new Particle();
-    particle->life = 0.0f;
+    ParticleStorage& particles = group.particles;
+    uint32 index = particles.Add();
+    particles.life[index] = 0.0f;
+    particles.seed[index] = context.Rand();
 
-    particle->color = Color();
+    particles.color[index] = Color();
     if (group.layer->colorRandom)
     {
-        particle->color = group.layer->colorRandom->GetValue(static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particles.color[index] = group.layer->colorRandom->GetValue(context.RandFloat());
     }
     if (group.emitter->colorOverLife)
     {
-        particle->color *= group.emitter->colorOverLife->GetValue(group.time);
+        particles.color[index] *= group.emitter->colorOverLife->GetValue(group.time);
     }
 
-    particle->lifeTime = 0.0f;
+    particles.lifeTime[index] = 0.0f;
     if (group.layer->life)
-        particle->lifeTime += group.layer->life->GetValue(currLoopTime);
+        particles.lifeTime[index] += group.layer->life->GetValue(currLoopTime);
     if (group.layer->lifeVariation)
-        particle->lifeTime += (group.layer->lifeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particles.lifeTime[index] += (group.layer->lifeVariation->GetValue(currLoopTime) * context.RandFloat());
 
     // Flow.
-    particle->baseFlowSpeed = 0.0f;
+    particles.baseFlowSpeed[index] = 0.0f;
     if (group.layer->flowSpeed)
-        particle->baseFlowSpeed += group.layer->flowSpeed->GetValue(currLoopTime);
+        particles.baseFlowSpeed[index] += group.layer->flowSpeed->GetValue(currLoopTime);
     if (group.layer->flowSpeedVariation)
-        particle->baseFlowSpeed += (group.layer->flowSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currFlowSpeed = particle->baseFlowSpeed;
+        particles.baseFlowSpeed[index] += (group.layer->flowSpeedVariation->GetValue(currLoopTime) * context.RandFloat());
+    particles.currFlowSpeed[index] = particles.baseFlowSpeed[index];
 
-    particle->baseFlowOffset = 0.0f;
+    particles.baseFlowOffset[index] = 0.0f;
     if (group.layer->flowOffset)
-        particle->baseFlowOffset += group.layer->flowOffset->GetValue(currLoopTime);
+        particles.baseFlowOffset[index] += group.layer->flowOffset->GetValue(currLoopTime);
     if (group.layer->flowOffsetVariation)
-        particle->baseFlowOffset += (group.layer->flowOffsetVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currFlowOffset = particle->baseFlowOffset;
+        particles.baseFlowOffset[index] += (group.layer->flowOffsetVariation->GetValue(currLoopTime) * context.RandFloat());
+    particles.currFlowOffset[index] = particles.baseFlowOffset[index];
 
     // Noise.
-    particle->baseNoiseScale = 0.0f;
+    particles.baseNoiseScale[index] = 0.0f;
     if (group.layer->noiseScale)
-        particle->baseNoiseScale += group.layer->noiseScale->GetValue(currLoopTime);
+        particles.baseNoiseScale[index] += group.layer->noiseScale->GetValue(currLoopTime);
     if (group.layer->noiseScaleVariation)
-        particle->baseNoiseScale += (group.layer->noiseScaleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseScale = particle->baseNoiseScale;
+        particles.baseNoiseScale[index] += (group.layer->noiseScaleVariation->GetValue(currLoopTime) * context.RandFloat());
+    particles.currNoiseScale[index] = particles.baseNoiseScale[index];
 
-    particle->baseNoiseUScrollSpeed = 0.0f;
+    particles.baseNoiseUScrollSpeed[index] = 0.0f;
     if (group.layer->noiseUScrollSpeed)
-        particle->baseNoiseUScrollSpeed += group.layer->noiseUScrollSpeed->GetValue(currLoopTime);
+        particles.baseNoiseUScrollSpeed[index] += group.layer->noiseUScrollSpeed->GetValue(currLoopTime);
     if (group.layer->noiseUScrollSpeedVariation)
-        particle->baseNoiseUScrollSpeed += (group.layer->noiseUScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseUOffset = particle->baseNoiseUScrollSpeed;
+        particles.baseNoiseUScrollSpeed[index] += (group.layer->noiseUScrollSpeedVariation->GetValue(currLoopTime) * context.RandFloat());
+    particles.currNoiseUOffset[index] = particles.baseNoiseUScrollSpeed[index];
 
-    particle->baseNoiseVScrollSpeed = 0.0f;
+    particles.baseNoiseVScrollSpeed[index] = 0.0f;
     if (group.layer->noiseVScrollSpeed)
-        particle->baseNoiseVScrollSpeed += group.layer->noiseVScrollSpeed->GetValue(currLoopTime);
+        particles.baseNoiseVScrollSpeed[index] += group.layer->noiseVScrollSpeed->GetValue(currLoopTime);
     if (group.layer->noiseVScrollSpeedVariation)
-        particle->baseNoiseVScrollSpeed += (group.layer->noiseVScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseVOffset = particle->baseNoiseVScrollSpeed;
+        particles.baseNoiseVScrollSpeed[index] += (group.layer->noiseVScrollSpeedVariation->GetValue(currLoopTime) * context.RandFloat());
+    particles.currNoiseVOffset[index] = particles.baseNoiseVScrollSpeed[index];
 
     // size
-    particle->baseSize = Vector2(1.0f, 1.0f);
+    particles.baseSize[index] = Vector2(1.0f, 1.0f);
     if (group.layer->size)
-        particle->baseSize = group.layer->size->GetValue(currLoopTime);
+        particles.baseSize[index] = group.layer->size->GetValue(currLoopTime);
     if (group.layer->sizeVariation)
-        particle->baseSize += (group.layer->sizeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->baseSize *= effect->effectData.infoSources[group.positionSource].size;
+        particles.baseSize[index] += (group.layer->sizeVariation->GetValue(currLoopTime) * context.RandFloat());
+    particles.baseSize[index] *= effect->effectData.infoSources[group.positionSource].size;
 
-    particle->currSize = particle->baseSize;
+    particles.currSize[index] = particles.baseSize[index];
     if (group.layer->sizeOverLifeXY)
-        particle->currSize *= group.layer->sizeOverLifeXY->GetValue(0);
-    Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
-    particle->currRadius = pivotSize.Length();
+        particles.currSize[index] *= group.layer->sizeOverLifeXY->GetValue(0);
+    Vector2 pivotSize = particles.currSize[index] * group.layer->layerPivotSizeOffsets;
+    particles.currRadius[index] = pivotSize.Length();
 
-    particle->angle = 0.0f;
-    particle->spin = 0.0f;
+    particles.angle[index] = 0.0f;
+    particles.spin[index] = 0.0f;
     if (group.layer->angle)
-        particle->angle = DegToRad(group.layer->angle->GetValue(currLoopTime));
+        particles.angle[index] = DegToRad(group.layer->angle->GetValue(currLoopTime));
     if (group.layer->angleVariation)
-        particle->angle += DegToRad(group.layer->angleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particles.angle[index] += DegToRad(group.layer->angleVariation->GetValue(currLoopTime) * context.RandFloat());
     if (group.layer->spin)
-        particle->spin = DegToRad(group.layer->spin->GetValue(currLoopTime));
+        particles.spin[index] = DegToRad(group.layer->spin->GetValue(currLoopTime));
     if (group.layer->spinVariation)
-        particle->spin += DegToRad(group.layer->spinVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        particles.spin[index] += DegToRad(group.layer->spinVariation->GetValue(currLoopTime) * context.RandFloat());
     if (group.layer->randomSpinDirection)
     {
-        int32 dir = Rand() & 1;
-        particle->spin *= (dir)*2 - 1;
+        int32 dir = context.Rand() & 1;
+        particles.spin[index] *= (dir)*2 - 1;
     }
-    particle->frame = 0;
-    particle->animTime = 0;
+    particles.frame[index] = 0;
+    particles.animTime[index] = 0;
     if (group.layer->randomFrameOnStart && group.layer->sprite)
     {
-        particle->frame = static_cast<int32>(static_cast<float32>(GetEngineContext()->random->RandFloat()) * static_cast<float32>(group.layer->sprite->GetFrameCount()));
+        particles.frame[index] = static_cast<int32>(context.RandFloat() * static_cast<float32>(group.layer->sprite->GetFrameCount()));
     }
 
-    PrepareEmitterParameters(particle, group, worldTransform);
+    Vector3 position;
+    Vector3 speed;
+    PrepareEmitterParameters(position, speed, group, worldTransform, context);
 
     float32 vel = 0.0f;
     if (group.layer->velocity)
         vel += group.layer->velocity->GetValue(currLoopTime);
     if (group.layer->velocityVariation)
-        vel += (group.layer->velocityVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->speed *= vel;
+        vel += (group.layer->velocityVariation->GetValue(currLoopTime) * context.RandFloat());
+    speed *= vel;
 
     if (!group.layer->GetInheritPosition()) //just generate at correct position
     {
-        particle->position += effect->effectData.infoSources[group.positionSource].position;
+        position += effect->effectData.infoSources[group.positionSource].position;
     }
+    particles.SetPosition(index, position);
+    particles.SetSpeed(index, speed);
 
-    particle->next = group.head;
-    group.head = particle;
     group.activeParticleCount++;
     if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
     {
         ParentInfo info;
-        info.position = particle->position;
-        info.size = particle->currSize;
+        info.position = position;
+        info.size = particles.currSize[index];
         effect->effectData.infoSources.push_back(info);
-        particle->positionTarget = static_cast<int32>(effect->effectData.infoSources.size() - 1);
+        particles.positionTarget[index] = static_cast<int32>(effect->effectData.infoSources.size() - 1);
         ParticleEmitter* innerEmitter = group.layer->innerEmitter->GetEmitter();
         if (innerEmitter)
-            RunEmitter(effect, innerEmitter, Vector3(0, 0, 0), particle->positionTarget);
+            RunEmitter(effect, innerEmitter, Vector3(0, 0, 0), particles.positionTarget[index]);
     }
 
     group.particlesGenerated++;
-    return particle;
+    return index;
 }
 
-void ParticleEffectSystem::UpdateRegularParticleData(ParticleEffectComponent* effect, Particle* particle, const ParticleGroup& group, float32 overLife, int32 simplifiedForcesCount, Vector<Vector3>& currSimplifiedForceValues, float32 dt, AABBox3& bbox, const Vector<ParticleForce*>& effectAlignForces, uint32 effectAlignForcesCount, const Vector<ParticleForce*>& worldAlignForces, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife)
+void ParticleEffectSystem::UpdateRegularParticlesData(ParticleEffectComponent* effect, ParticleGroup& group, UpdateContext& context, int32 simplifiedForcesCount, float32 dt, AABBox3& bbox, uint32 effectAlignForcesCount, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife)
 {
-    float32 currVelocityOverLife = 1.0f;
-    if (group.layer->velocityOverLife)
-        currVelocityOverLife = group.layer->velocityOverLife->GetValue(overLife);
-    Vector3 prevParticlePosition = particle->position;
-    particle->position += particle->speed * (currVelocityOverLife * dt);
-
-    float32 currSpinOverLife = 1.0f;
-    if (group.layer->spinOverLife)
-        currSpinOverLife = group.layer->spinOverLife->GetValue(overLife);
-    particle->angle += particle->spin * currSpinOverLife * dt;
-
-    Vector3 acceleration(0.0f, 0.0f, 0.0f);
-    for (int32 i = 0; i < simplifiedForcesCount; ++i)
+    const float32* overLife = context.particlesOverLife.data();
+    const Vector<Vector3>& currSimplifiedForceValues = context.currSimplifiedForceValues;
+    const Vector<ParticleForce*>& effectAlignForces = context.effectAlignForces;
+    const Vector<ParticleForce*>& worldAlignForces = context.worldAlignForces;
+    Vector<float32>& particlesScale = context.particlesScale;
+    Vector<Vector3>& particlesPrevPosition = context.particlesPrevPosition;
+
+    ParticleStorage& particles = group.particles;
+    ParticleLayer* layer = group.layer;
+    uint32 count = particles.GetCount();
+
+    bool applyGlobalForces = layer->applyGlobalForces && !globalForces.empty();
+    bool hasForces = (worldAlignForcesCount > 0) || (effectAlignForcesCount > 0) || applyGlobalForces;
+    if (hasForces)
     {
-        acceleration += (group.layer->GetSimplifiedParticleForces()[i]->forceOverLife) ? (currSimplifiedForceValues[i] * group.layer->GetSimplifiedParticleForces()[i]->forceOverLife->GetValue(overLife)) : currSimplifiedForceValues[i];
+        particlesPrevPosition.resize(count);
+        for (uint32 i = 0; i < count; ++i)
+            particlesPrevPosition[i] = particles.GetPosition(i);
     }
 
-    for (uint32 i = 0; i < worldAlignForcesCount; ++i)
-        ParticleForces::ApplyForce(worldAlignForces[i], particle->speed, particle->position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, worldAlignForces[i]->worldPosition);
+    const float32* scale = nullptr;
+    if (layer->velocityOverLife)
+    {
+        particlesScale.resize(count);
+        for (uint32 i = 0; i < count; ++i)
+            particlesScale[i] = layer->velocityOverLife->GetValue(overLife[i]);
+        scale = particlesScale.data();
+    }
+    particles.IntegratePositions(scale, dt);
 
-    if (effectAlignForcesCount > 0)
+    scale = nullptr;
+    if (layer->spinOverLife)
     {
-        Vector3 effectSpacePosition;
-        Vector3 prevEffectSpacePosition;
-        Vector3 effectSpaceSpeed;
-        effectSpacePosition = particle->position * invWorld;
-        effectSpaceSpeed = particle->speed * Matrix3(invWorld);
-        if (group.layer->GetPlaneCollisiontForcesCount() > 0)
-            prevEffectSpacePosition = prevParticlePosition * invWorld;
+        particlesScale.resize(count);
+        for (uint32 i = 0; i < count; ++i)
+            particlesScale[i] = layer->spinOverLife->GetValue(overLife[i]);
+        scale = particlesScale.data();
+    }
+    particles.IntegrateAngles(scale, dt);
 
-        for (uint32 i = 0; i < effectAlignForcesCount; ++i)
-            ParticleForces::ApplyForce(effectAlignForces[i], effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particle, prevEffectSpacePosition, effectAlignForces[i]->position);
+    if (hasForces)
+    {
+        Vector3 effectDown = -Vector3(invWorld._20, invWorld._21, invWorld._22);
+        Matrix3 invWorldRotation(invWorld);
+        Matrix3 worldRotation(world);
+        for (uint32 p = 0; p < count; ++p)
+        {
+            Vector3 position = particles.GetPosition(p);
+            Vector3 speed = particles.GetSpeed(p);
+            const Vector3& prevParticlePosition = particlesPrevPosition[p];
 
-        particle->speed = effectSpaceSpeed * Matrix3(world);
-        if (group.layer->GetAlterPositionForcesCount() > 0)
-            particle->position = effectSpacePosition * world;
-    }
+            for (uint32 i = 0; i < worldAlignForcesCount; ++i)
+                ParticleForces::ApplyForce(worldAlignForces[i], speed, position, dt, overLife[p], layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particles, p, prevParticlePosition, context.worldAlignForcePositions[i]);
 
-    if (group.layer->applyGlobalForces)
-        ApplyGlobalForces(particle, dt, overLife, layerOverLife, prevParticlePosition);
+            if (effectAlignForcesCount > 0)
+            {
+                Vector3 effectSpacePosition;
+                Vector3 prevEffectSpacePosition;
+                Vector3 effectSpaceSpeed;
+                effectSpacePosition = position * invWorld;
+                effectSpaceSpeed = speed * invWorldRotation;
+                if (layer->GetPlaneCollisiontForcesCount() > 0)
+                    prevEffectSpacePosition = prevParticlePosition * invWorld;
+
+                for (uint32 i = 0; i < effectAlignForcesCount; ++i)
+                    ParticleForces::ApplyForce(effectAlignForces[i], effectSpaceSpeed, effectSpacePosition, dt, overLife[p], layerOverLife, effectDown, particles, p, prevEffectSpacePosition, effectAlignForces[i]->position);
+
+                speed = effectSpaceSpeed * worldRotation;
+                if (layer->GetAlterPositionForcesCount() > 0)
+                    position = effectSpacePosition * world;
+            }
 
-    particle->speed += acceleration * dt;
+            if (applyGlobalForces)
+                ApplyGlobalForces(particles, p, speed, position, dt, overLife[p], layerOverLife, prevParticlePosition);
 
-    if (group.layer->sizeOverLifeXY)
+            particles.SetPosition(p, position);
+            particles.SetSpeed(p, speed);
+        }
+    }
+
+    const Vector<ParticleForceSimplified*>& simplifiedForces = layer->GetSimplifiedParticleForces();
+    for (int32 i = 0; i < simplifiedForcesCount; ++i)
     {
-        particle->currSize = particle->baseSize * group.layer->sizeOverLifeXY->GetValue(overLife);
-        Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
-        particle->currRadius = pivotSize.Length();
+        scale = nullptr;
+        if (simplifiedForces[i]->forceOverLife)
+        {
+            particlesScale.resize(count);
+            for (uint32 p = 0; p < count; ++p)
+                particlesScale[p] = simplifiedForces[i]->forceOverLife->GetValue(overLife[p]);
+            scale = particlesScale.data();
+        }
+        particles.Accelerate(currSimplifiedForceValues[i], scale, dt);
     }
-    if (group.layer->GetInheritPosition())
-        AddParticleToBBox(particle->position + effect->effectData.infoSources[group.positionSource].position, particle->currRadius, bbox);
-    else
-        AddParticleToBBox(particle->position, particle->currRadius, bbox);
 
-    if (group.layer->frameOverLifeEnabled && group.layer->sprite)
+    if (layer->sizeOverLifeXY)
     {
-        float32 animDelta = group.layer->frameOverLifeFPS;
-        if (group.layer->animSpeedOverLife)
-            animDelta *= group.layer->animSpeedOverLife->GetValue(overLife);
-        particle->animTime += animDelta * dt;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            particles.currSize[i] = particles.baseSize[i] * layer->sizeOverLifeXY->GetValue(overLife[i]);
+            Vector2 pivotSize = particles.currSize[i] * layer->layerPivotSizeOffsets;
+            particles.currRadius[i] = pivotSize.Length();
+        }
+    }
+    if (layer->GetInheritPosition())
+        particles.AddToBBox(effect->effectData.infoSources[group.positionSource].position, bbox);
+    else
+        particles.AddToBBox(Vector3(0.0f, 0.0f, 0.0f), bbox);
 
-        while (particle->animTime > 1.0f)
+    if (layer->frameOverLifeEnabled && layer->sprite)
+    {
+        int32 frameCount = layer->sprite->GetFrameCount();
+        for (uint32 i = 0; i < count; ++i)
         {
-            particle->frame++;
-            particle->animTime -= 1.0f;
-            if (particle->frame >= group.layer->sprite->GetFrameCount())
+            float32 animDelta = layer->frameOverLifeFPS;
+            if (layer->animSpeedOverLife)
+                animDelta *= layer->animSpeedOverLife->GetValue(overLife[i]);
+            float32& animTime = particles.animTime[i];
+            int32& frame = particles.frame[i];
+            animTime += animDelta * dt;
+
+            while (animTime > 1.0f)
             {
-                if (group.layer->loopSpriteAnimation)
-                    particle->frame = 0;
-                else
-                    particle->frame = group.layer->sprite->GetFrameCount() - 1;
+                frame++;
+                animTime -= 1.0f;
+                if (frame >= frameCount)
+                {
+                    if (layer->loopSpriteAnimation)
+                        frame = 0;
+                    else
+                        frame = frameCount - 1;
+                }
             }
         }
     }
 }
 
-void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition)
+void ParticleEffectSystem::ApplyGlobalForces(ParticleStorage& particles, uint32 particleIndex, Vector3& speed, Vector3& position, float32 dt, float32 overLife, float32 layerOverLife, const Vector3& prevParticlePosition)
 {
     for (auto& forcePair : globalForces)
     {
@@ -1049,8 +1275,8 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
         for (ParticleForce* force : forcePair.second.worldAlignForces)
         {
             Vector3 forceWorldPosition = worldTransformPtr->GetTranslationVector() + force->position;
-            if (force->isInfinityRange || (forceWorldPosition - particle->position).SquareLength() < force->GetSquaredRadius())
-                ParticleForces::ApplyForce(force, particle->speed, particle->position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, forceWorldPosition);
+            if (force->isInfinityRange || (forceWorldPosition - position).SquareLength() < force->GetSquaredRadius())
+                ParticleForces::ApplyForce(force, speed, position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particles, particleIndex, prevParticlePosition, forceWorldPosition);
         }
 
         if (!forcePair.second.effectAlignForces.empty())
@@ -1064,7 +1290,7 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
                     break;
                 }
                 Vector3 forceWorldPosition = worldTransformPtr->GetTranslationVector() + force->position; // Do not rotate global forces if force position is not zero.
-                float32 sqrDist = (forceWorldPosition - particle->position).SquareLength();
+                float32 sqrDist = (forceWorldPosition - position).SquareLength();
                 if (sqrDist < force->GetSquaredRadius())
                 {
                     inForceBoundingSphere = true;
@@ -1076,24 +1302,24 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
 
             Matrix4 invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
 
-            Vector3 effectSpacePosition = particle->position * invWorld;
+            Vector3 effectSpacePosition = position * invWorld;
             Vector3 prevEffectSpacePosition = prevParticlePosition * invWorld;
-            Vector3 effectSpaceSpeed = particle->speed * Matrix3(invWorld);
+            Vector3 effectSpaceSpeed = speed * Matrix3(invWorld);
             bool transformPosition = false;
             for (ParticleForce* force : forcePair.second.effectAlignForces)
             {
                 if (force->CanAlterPosition())
                     transformPosition = true;
-                ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particle, prevEffectSpacePosition, force->position);
+                ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particles, particleIndex, prevEffectSpacePosition, force->position);
             }
-            particle->speed = effectSpaceSpeed * Matrix3(*worldTransformPtr);
+            speed = effectSpaceSpeed * Matrix3(*worldTransformPtr);
             if (transformPosition)
-                particle->position = effectSpacePosition * (*worldTransformPtr);
+                position = effectSpacePosition * (*worldTransformPtr);
         }
     }
 }
 
-void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, ParticleGroup& group, const Matrix4& worldTransform)
+void ParticleEffectSystem::PrepareEmitterParameters(Vector3& position, Vector3& speed, ParticleGroup& group, const Matrix4& worldTransform, UpdateContext& context)
 {
     //calculate position new particle position in emitter space (for point leave it V3(0,0,0))
     uintptr_t uptr = reinterpret_cast<uintptr_t>(&group);
@@ -1106,7 +1332,7 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         if (group.emitter->size)
         {
             Vector3 currSize = group.emitter->size->GetValue(group.time);
-            particle->position = Vector3(currSize.x * (ParticlesRandom::VanDerCorputRnd(ind, 3) - 0.5f), currSize.y * (ParticlesRandom::VanDerCorputRnd(ind, 2) - 0.5f), currSize.z * (ParticlesRandom::VanDerCorputRnd(ind, 5) - 0.5f));
+            position = Vector3(currSize.x * (ParticlesRandom::VanDerCorputRnd(ind, 3) - 0.5f), currSize.y * (ParticlesRandom::VanDerCorputRnd(ind, 2) - 0.5f), currSize.z * (ParticlesRandom::VanDerCorputRnd(ind, 5) - 0.5f));
         }
     }
     else if ((group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_VOLUME) || (group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_EDGES) || (group.emitter->emitterType == ParticleEmitter::EMITTER_SHOCKWAVE))
@@ -1132,13 +1358,13 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         float32 curAngle = angleBase + angleVariation * ParticlesRandom::VanDerCorputRnd(ind, 3);
         if (group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_VOLUME)
         {
-            float32 rndRadiusNorm = std::sqrt(static_cast<float32>(GetEngineContext()->random->RandFloat())); // Better distribution on circle.
+            float32 rndRadiusNorm = std::sqrt(context.RandFloat()); // Better distribution on circle.
             curRadius = Lerp(innerRadius, curRadius, rndRadiusNorm);
         }
         float32 sinAngle = 0.0f;
         float32 cosAngle = 0.0f;
         SinCosFast(curAngle, sinAngle, cosAngle);
-        particle->position = Vector3(curRadius * cosAngle, curRadius * sinAngle, 0.0f);
+        position = Vector3(curRadius * cosAngle, curRadius * sinAngle, 0.0f);
     }
 
     //current emission vector and it's length
@@ -1158,11 +1384,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
     //calculate speed in emitter space not transformed by emission vector yet
     if (group.emitter->emitterType == ParticleEmitter::EMITTER_SHOCKWAVE)
     {
-        particle->speed = particle->position;
-        float32 spl = particle->speed.SquareLength();
+        speed = position;
+        float32 spl = speed.SquareLength();
         if (spl > EPSILON)
         {
-            particle->speed *= currVelPower / std::sqrt(spl);
+            speed *= currVelPower / std::sqrt(spl);
         }
     }
     else
@@ -1171,11 +1397,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         {
             float32 theta = ParticlesRandom::VanDerCorputRnd(ind, 3) * DegToRad(group.emitter->emissionRange->GetValue(group.time)) * 0.5f;
             float32 phi = ParticlesRandom::VanDerCorputRnd(ind, 4) * PI_2;
-            particle->speed = Vector3(currVelPower * cos(phi) * sin(theta), currVelPower * sin(phi) * sin(theta), currVelPower * cos(theta));
+            speed = Vector3(currVelPower * cos(phi) * sin(theta), currVelPower * sin(phi) * sin(theta), currVelPower * cos(theta));
         }
         else
         {
-            particle->speed = Vector3(0, 0, currVelPower);
+            speed = Vector3(0, 0, currVelPower);
         }
     }
 
@@ -1187,19 +1413,19 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
     {
         if (currEmissionVector.z < 0)
         {
-            particle->position = particle->position * PIRotationAroundX;
+            position = position * PIRotationAroundX;
 
             if (!hasCustomEmissionVector)
-                particle->speed = particle->speed * PIRotationAroundX;
+                speed = speed * PIRotationAroundX;
         }
     }
     else
     {
         Matrix3 rotation = ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currEmissionVector, currEmissionPower);
-        particle->position = particle->position * rotation;
+        position = position * rotation;
 
         if (!hasCustomEmissionVector)
-            particle->speed = particle->speed * rotation;
+            speed = speed * rotation;
     }
 
     if (hasCustomEmissionVector)
@@ -1207,20 +1433,21 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         if ((std::abs(currVelVector.x) < EPSILON) && (std::abs(currVelVector.y) < EPSILON))
         {
             if (currVelVector.z < 0)
-                particle->speed = particle->speed * PIRotationAroundX;
+                speed = speed * PIRotationAroundX;
         }
         else
         {
-            particle->speed = particle->speed * ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currVelVector, currVelPower);
+            speed = speed * ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currVelVector, currVelPower);
         }
     }
-    particle->position += group.spawnPosition;
-    TransformPerserveLength(particle->speed, newTransform);
-    TransformPerserveLength(particle->position, newTransform); //note - from now emitter position is not effected by scale anymore (artist request)
+    position += group.spawnPosition;
+    TransformPerserveLength(speed, newTransform);
+    TransformPerserveLength(position, newTransform); //note - from now emitter position is not effected by scale anymore (artist request)
 }
 
 void ParticleEffectSystem::SetGlobalExtertnalValue(const String& name, float32 value)
 {
+    WaitSimulation();
     globalExternalValues[name] = value;
     for (Vector<ParticleEffectComponent *>::iterator it = activeComponents.begin(), e = activeComponents.end(); it != e; ++it)
         (*it)->SetExtertnalValue(name, value);
@@ -2,6 +2,7 @@
 
 #include "Base/BaseTypes.h"
 #include "Entity/SceneSystem.h"
+#include "Job/JobScheduler.h"
 #include "Scene3D/Components/ParticleEffectComponent.h"
 
 namespace DAVA
@@ -83,29 +84,67 @@ public:
 
     void PrebuildMaterials(ParticleEffectComponent* component);
 
+    /**
+        Limit number of job workers simulating effects, 0 means all job workers.
+        Effects are simulated on job workers only when scene systems are processed in PARALLEL mode.
+    */
+    inline void SetMaxSimulationThreads(uint32 threadsCount);
+    inline uint32 GetMaxSimulationThreads() const;
+
+    /**
+        Block until effects simulation started by `Process` is finished.
+
+        In PARALLEL mode `Process` does not wait for job workers: effects are drawn from render data published
+        by previous `Process` (see ParticleEffectComponent::renderData) while simulation is running.
+        Scene waits for simulation before update, ParticleEffectComponent waits before changing simulated state.
+        Code changing emitters or layers of playing effects has to call it too.
+    */
+    void WaitSimulation();
+
 protected:
+    struct UpdateContext;
+
     void RunEffect(ParticleEffectComponent* effect);
     void AddToActive(ParticleEffectComponent* effect);
     void RemoveFromActive(ParticleEffectComponent* effect);
 
     void UpdateActiveLod(ParticleEffectComponent* effect);
     void UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime);
-    Particle* GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform);
-    void UpdateRegularParticleData(ParticleEffectComponent* effect, Particle* particle, const ParticleGroup& group, float32 overLife, int32 simplifiedForcesCount, Vector<Vector3>& currSimplifiedForceValues, float32 dt, AABBox3& bbox, const Vector<ParticleForce*>& effectAlignForces, uint32 effectAlignForcesCount, const Vector<ParticleForce*>& worldAlignForces, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife);
+    void UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime, UpdateContext& context);
+    uint32 GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform, UpdateContext& context);
+    void UpdateRegularParticlesData(ParticleEffectComponent* effect, ParticleGroup& group, UpdateContext& context, int32 simplifiedForcesCount, float32 dt, AABBox3& bbox, uint32 effectAlignForcesCount, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife);
 
-    void PrepareEmitterParameters(Particle* particle, ParticleGroup& group, const Matrix4& worldTransform);
+    void PrepareEmitterParameters(Vector3& position, Vector3& speed, ParticleGroup& group, const Matrix4& worldTransform, UpdateContext& context);
     void AddParticleToBBox(const Vector3& position, float radius, AABBox3& bbox);
 
     void RunEmitter(ParticleEffectComponent* effect, ParticleEmitter* emitter, const Vector3& spawnPosition, int32 positionSource = 0);
 
 private:
-    void ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition);
-    void UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive);
+    void ApplyGlobalForces(ParticleStorage& particles, uint32 particleIndex, Vector3& speed, Vector3& position, float32 dt, float32 overLife, float32 layerOverLife, const Vector3& prevParticlePosition);
+    void UpdateStripe(const ParticleStorage& particles, uint32 particleIndex, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive);
     void SimulateEffect(ParticleEffectComponent* effect);
+    void UpdateEffects(float32 timeElapsed, float32 shortEffectTime);
+    void FinishEffects();
+    void PublishRenderData(ParticleEffectComponent* effect);
+    UpdateContext& GetUpdateContext();
 
     Map<String, float32> globalExternalValues;
     Vector<ParticleEffectComponent*> activeComponents;
 
+    // effects simulated this frame, effects with superemitter layers create groups and materials so they stay on main thread
+    Vector<ParticleEffectComponent*> parallelEffects;
+    Vector<ParticleEffectComponent*> mainThreadEffects;
+
+    // one context per updating thread, main thread uses the first one
+    Vector<std::unique_ptr<UpdateContext>> updateContexts;
+    uint32 maxSimulationThreads = 0;
+
+    // simulation of `parallelEffects` running on job workers, its results are finished by next `Process`
+    JobScheduler* simulationScheduler = nullptr;
+    JobHandle simulationJob;
+    std::atomic<uint32> nextSimulatedEffect{ 0 };
+    bool simulationPending = false;
+
     struct EffectGlobalForcesData
     {
         Vector<ParticleForce*> worldAlignForces;
@@ -138,4 +177,14 @@ inline bool ParticleEffectSystem::GetAllowLodDegrade() const
 {
     return allowLodDegrade;
 }
+
+inline void ParticleEffectSystem::SetMaxSimulationThreads(uint32 threadsCount)
+{
+    maxSimulationThreads = threadsCount;
+}
+
+inline uint32 ParticleEffectSystem::GetMaxSimulationThreads() const
+{
+    return maxSimulationThreads;
+}
 };
\ No newline at end of file
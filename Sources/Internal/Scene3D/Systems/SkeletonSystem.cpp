@@ -3,6 +3,10 @@
 #include "Animation/AnimationTrack.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Job/JobScheduler.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/ComponentHelpers.h"
@@ -16,6 +20,12 @@
 
 namespace DAVA
 {
+namespace SkeletonSystemDetails
+{
+// Smallest number of skeletons updated by one job
+const uint32 PARALLEL_GRAIN_SIZE = 16;
+}
+
 SkeletonSystem::SkeletonSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -72,6 +82,7 @@ void SkeletonSystem::Process(float32 timeElapsed)
     UpdateTestSkeletons();
 #endif
 
+    updatedSkeletons.clear();
     for (int32 i = 0, sz = static_cast<int32>(entities.size()); i < sz; ++i)
     {
         SkeletonComponent* component = GetSkeletonComponent(entities[i]);
@@ -85,19 +96,53 @@ void SkeletonSystem::Process(float32 timeElapsed)
 
             if (component->startJoint != SkeletonComponent::INVALID_JOINT_INDEX)
             {
-                UpdateJointTransforms(component);
+                UpdatedSkeleton updated;
+                updated.skeleton = component;
                 RenderObject* ro = GetRenderObject(entities[i]);
                 if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
                 {
-                    UpdateSkinnedMesh(component, static_cast<SkinnedMesh*>(ro));
+                    updated.skinnedMesh = static_cast<SkinnedMesh*>(ro);
                 }
+                updatedSkeletons.push_back(updated);
             }
         }
     }
 
+    // Skeletons are independent, so poses and skinning data are computed in jobs
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 updatedCount = static_cast<uint32>(updatedSkeletons.size());
+    if (jobManager != nullptr && GetScene()->GetSystemsProcessMode() == Scene::eSystemsProcessMode::PARALLEL && updatedCount > SkeletonSystemDetails::PARALLEL_GRAIN_SIZE)
+    {
+        jobManager->GetScheduler()->ParallelFor(0, updatedCount, SkeletonSystemDetails::PARALLEL_GRAIN_SIZE, [this](uint32 begin, uint32 end) {
+            UpdateSkeletonsRange(begin, end);
+        });
+    }
+    else
+    {
+        UpdateSkeletonsRange(0, updatedCount);
+    }
+
+    RenderSystem* renderSystem = GetScene()->GetRenderSystem();
+    for (const UpdatedSkeleton& updated : updatedSkeletons)
+    {
+        if (updated.skinnedMesh != nullptr)
+            renderSystem->MarkForUpdate(updated.skinnedMesh);
+    }
+
     DrawSkeletons(GetScene()->renderSystem->GetDebugDrawer());
 }
 
+void SkeletonSystem::UpdateSkeletonsRange(uint32 begin, uint32 end)
+{
+    for (uint32 i = begin; i < end; ++i)
+    {
+        const UpdatedSkeleton& updated = updatedSkeletons[i];
+        UpdateJointTransforms(updated.skeleton);
+        if (updated.skinnedMesh != nullptr)
+            UpdateSkinnedMeshData(updated.skeleton, updated.skinnedMesh);
+    }
+}
+
 void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
 {
     for (Entity* entity : entities)
@@ -158,7 +203,7 @@ void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
             }
 
             //calculate final transform including bindTransform
-            skeleton->finalTransforms[currJoint] = skeleton->objectSpaceTransforms[currJoint].AppendTransform(skeleton->inverseBindTransforms[currJoint]);
+            skeleton->objectSpaceTransforms[currJoint].AppendTransform(skeleton->inverseBindTransforms[currJoint], skeleton->finalPositions[currJoint], skeleton->finalOrientations[currJoint]);
 
             if (!skeleton->jointsArray[currJoint].bbox.IsEmpty())
             {
@@ -183,6 +228,12 @@ void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 }
 
 void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
+{
+    UpdateSkinnedMeshData(skeleton, skinnedMeshObject);
+    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
+}
+
+void SkeletonSystem::UpdateSkinnedMeshData(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
 {
     DVASSERT(!skeleton->configUpdated);
 
@@ -197,10 +248,8 @@ void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh*
         }
     }
 
-    skinnedMeshObject->UpdateJointTransforms(skeleton->finalTransforms);
+    skinnedMeshObject->UpdateJointTransforms(skeleton->finalPositions, skeleton->finalOrientations);
     skinnedMeshObject->SetBoundingBox(resBox); //TODO: *Skinning* decide on bbox calculation
-
-    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
 }
 
 void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
@@ -211,7 +260,8 @@ void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
     skeleton->jointInfo.resize(jointsCount);
     skeleton->localSpaceTransforms.resize(jointsCount);
     skeleton->objectSpaceTransforms.resize(jointsCount);
-    skeleton->finalTransforms.resize(jointsCount);
+    skeleton->finalPositions.resize(jointsCount);
+    skeleton->finalOrientations.resize(jointsCount);
     skeleton->inverseBindTransforms.resize(jointsCount);
     skeleton->objectSpaceBoxes.resize(jointsCount);
 
@@ -28,13 +28,22 @@ public:
     void DrawSkeletons(RenderHelper* drawer);
 
 private:
+    struct UpdatedSkeleton
+    {
+        SkeletonComponent* skeleton = nullptr;
+        SkinnedMesh* skinnedMesh = nullptr;
+    };
+
     void UpdateJointTransforms(SkeletonComponent* skeleton);
+    void UpdateSkinnedMeshData(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject);
+    void UpdateSkeletonsRange(uint32 begin, uint32 end);
 
     void RebuildSkeleton(SkeletonComponent* skeleton);
 
     void UpdateTestSkeletons(float32 timeElapsed);
 
     Vector<Entity*> entities;
+    Vector<UpdatedSkeleton> updatedSkeletons; //skeletons with joints changed this frame, reused between frames
 };
 
 } //ns
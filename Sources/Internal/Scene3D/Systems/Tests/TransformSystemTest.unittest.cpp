@@ -0,0 +1,218 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/RefPtr.h"
+#include "Functional/Function.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+
+DAVA_TESTCLASS (TransformSystemTest)
+{
+    DAVA::Vector3 GetWorldTranslation(DAVA::Entity * entity)
+    {
+        return entity->GetComponent<DAVA::TransformComponent>()->GetWorldTransform().GetTranslation();
+    }
+
+    bool IsWorldTranslation(DAVA::Entity * entity, const DAVA::Vector3& expected)
+    {
+        return (GetWorldTranslation(entity) - expected).Length() < 0.001f;
+    }
+
+    void SetLocalTranslation(DAVA::Entity * entity, const DAVA::Vector3& translation)
+    {
+        entity->GetComponent<DAVA::TransformComponent>()->SetLocalTranslation(translation);
+    }
+
+    DAVA_TEST (DeepHierarchy)
+    {
+        using namespace DAVA;
+
+        const uint32 depth = 200;
+
+        RefPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG));
+
+        Entity* parent = scene.Get();
+        Entity* root = nullptr;
+        Entity* leaf = nullptr;
+        for (uint32 i = 0; i < depth; ++i)
+        {
+            RefPtr<Entity> entity(new Entity());
+            SetLocalTranslation(entity.Get(), Vector3(1.f, 0.f, 0.f));
+            parent->AddNode(entity.Get());
+            parent = entity.Get();
+
+            root = (root == nullptr) ? entity.Get() : root;
+            leaf = entity.Get();
+        }
+
+        scene->Update(0.016f);
+        TEST_VERIFY(FLOAT_EQUAL(GetWorldTranslation(leaf).x, static_cast<float32>(depth)));
+
+        SetLocalTranslation(root, Vector3(0.f, 0.f, 0.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(FLOAT_EQUAL(GetWorldTranslation(leaf).x, static_cast<float32>(depth - 1)));
+        TEST_VERIFY(FLOAT_EQUAL(GetWorldTranslation(leaf->GetParent()).x, static_cast<float32>(depth - 2)));
+    }
+
+    DAVA_TEST (WideHierarchy)
+    {
+        using namespace DAVA;
+
+        // More children than fixed traversal stack used to hold, enough to split levels between workers
+        const uint32 childrenCount = 6000;
+
+        RefPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG));
+        scene->SetSystemsProcessMode(Scene::eSystemsProcessMode::PARALLEL);
+
+        RefPtr<Entity> root(new Entity());
+        scene->AddNode(root.Get());
+
+        for (uint32 i = 0; i < childrenCount; ++i)
+        {
+            RefPtr<Entity> child(new Entity());
+            SetLocalTranslation(child.Get(), Vector3(static_cast<float32>(i), 0.f, 0.f));
+            root->AddNode(child.Get());
+
+            RefPtr<Entity> grandChild(new Entity());
+            SetLocalTranslation(grandChild.Get(), Vector3(0.f, 1.f, 0.f));
+            child->AddNode(grandChild.Get());
+        }
+
+        Function<bool(float32)> verifyAll = [&](float32 rootZ) {
+            bool result = true;
+            for (int32 i = 0; i < root->GetChildrenCount(); ++i)
+            {
+                Entity* child = root->GetChild(i);
+                Vector3 expected(static_cast<float32>(i), 0.f, rootZ);
+                result = result && IsWorldTranslation(child, expected);
+                result = result && IsWorldTranslation(child->GetChild(0), expected + Vector3(0.f, 1.f, 0.f));
+            }
+            return result;
+        };
+
+        scene->Update(0.016f);
+        TEST_VERIFY(verifyAll(0.f));
+
+        SetLocalTranslation(root.Get(), Vector3(0.f, 0.f, 10.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(verifyAll(10.f));
+
+        scene->SetSystemsProcessMode(Scene::eSystemsProcessMode::SEQUENTIAL);
+        SetLocalTranslation(root.Get(), Vector3(0.f, 0.f, 20.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(verifyAll(20.f));
+    }
+
+    DAVA_TEST (Reparent)
+    {
+        using namespace DAVA;
+
+        RefPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG));
+
+        RefPtr<Entity> first(new Entity());
+        SetLocalTranslation(first.Get(), Vector3(1.f, 0.f, 0.f));
+        scene->AddNode(first.Get());
+
+        RefPtr<Entity> second(new Entity());
+        SetLocalTranslation(second.Get(), Vector3(0.f, 2.f, 0.f));
+        scene->AddNode(second.Get());
+
+        RefPtr<Entity> child(new Entity());
+        SetLocalTranslation(child.Get(), Vector3(0.f, 0.f, 3.f));
+        first->AddNode(child.Get());
+
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(child.Get(), Vector3(1.f, 0.f, 3.f)));
+
+        second->AddNode(child.Get());
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(child.Get(), Vector3(0.f, 2.f, 3.f)));
+
+        scene->RemoveNode(second.Get());
+        SetLocalTranslation(first.Get(), Vector3(5.f, 0.f, 0.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(first.Get(), Vector3(5.f, 0.f, 0.f)));
+    }
+
+    DAVA_TEST (ChangedNodesInsideChangedSubtree)
+    {
+        using namespace DAVA;
+
+        RefPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG));
+
+        RefPtr<Entity> root(new Entity());
+        scene->AddNode(root.Get());
+
+        RefPtr<Entity> first(new Entity());
+        SetLocalTranslation(first.Get(), Vector3(1.f, 0.f, 0.f));
+        root->AddNode(first.Get());
+
+        RefPtr<Entity> second(new Entity());
+        SetLocalTranslation(second.Get(), Vector3(0.f, 1.f, 0.f));
+        root->AddNode(second.Get());
+
+        RefPtr<Entity> leaf(new Entity());
+        first->AddNode(leaf.Get());
+
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(leaf.Get(), Vector3(1.f, 0.f, 0.f)));
+
+        // leaf and its grandparent are changed in the same frame
+        SetLocalTranslation(leaf.Get(), Vector3(0.f, 0.f, 1.f));
+        SetLocalTranslation(root.Get(), Vector3(10.f, 0.f, 0.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(leaf.Get(), Vector3(11.f, 0.f, 1.f)));
+        TEST_VERIFY(IsWorldTranslation(second.Get(), Vector3(10.f, 1.f, 0.f)));
+
+        // removed subtree is not updated and is linked again when added back
+        root->RemoveNode(first.Get());
+        SetLocalTranslation(root.Get(), Vector3(20.f, 0.f, 0.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(second.Get(), Vector3(20.f, 1.f, 0.f)));
+
+        second->AddNode(first.Get());
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(leaf.Get(), Vector3(21.f, 1.f, 1.f)));
+
+        SetLocalTranslation(second.Get(), Vector3(0.f, 2.f, 0.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(leaf.Get(), Vector3(21.f, 2.f, 1.f)));
+    }
+
+    DAVA_TEST (SubtreeRemovedFromScene)
+    {
+        using namespace DAVA;
+
+        RefPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_TRANSFORM_FLAG));
+
+        RefPtr<Entity> parent(new Entity());
+        SetLocalTranslation(parent.Get(), Vector3(1.f, 0.f, 0.f));
+        scene->AddNode(parent.Get());
+
+        RefPtr<Entity> child(new Entity());
+        SetLocalTranslation(child.Get(), Vector3(0.f, 1.f, 0.f));
+        parent->AddNode(child.Get());
+
+        RefPtr<Entity> grandChild(new Entity());
+        SetLocalTranslation(grandChild.Get(), Vector3(0.f, 0.f, 1.f));
+        child->AddNode(grandChild.Get());
+
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(grandChild.Get(), Vector3(1.f, 1.f, 1.f)));
+
+        // Subtree is removed from scene in the same frame its root is changed
+        SetLocalTranslation(parent.Get(), Vector3(2.f, 0.f, 0.f));
+        scene->RemoveNode(parent.Get());
+        scene->Update(0.016f);
+
+        // Links between transforms are restored when subtree is added back
+        scene->AddNode(parent.Get());
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(grandChild.Get(), Vector3(2.f, 1.f, 1.f)));
+
+        SetLocalTranslation(parent.Get(), Vector3(3.f, 0.f, 0.f));
+        scene->Update(0.016f);
+        TEST_VERIFY(IsWorldTranslation(child.Get(), Vector3(3.f, 1.f, 0.f)));
+        TEST_VERIFY(IsWorldTranslation(grandChild.Get(), Vector3(3.f, 1.f, 1.f)));
+    }
+};
@@ -1,9 +1,13 @@
 #include "Debug/DVAssert.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Job/JobScheduler.h"
 #include "Scene3D/Components/AnimationComponent.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Math/Transform.h"
+#include "Math/TransformUtils.h"
 #include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
 #include "Scene3D/Components/TransformComponent.h"
 #include "Scene3D/Entity.h"
@@ -12,6 +16,12 @@
 
 namespace DAVA
 {
+namespace TransformSystemDetails
+{
+// Levels smaller than this are processed on the calling thread
+const uint32 PARALLEL_GRAIN_SIZE = 512;
+}
+
 TransformSystem::TransformSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -24,151 +34,326 @@ void TransformSystem::Process(float32 timeElapsed)
     TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
     for (Entity* e : tsc->localTransformChanged)
     {
-        EntityNeedUpdate(e);
-        HierarchicAddToUpdate(e);
+        MarkNeedUpdate(e);
     }
     for (Entity* e : tsc->transformParentChanged)
     {
-        EntityNeedUpdate(e);
-        HierarchicAddToUpdate(e);
+        UpdateParentLink(e);
+        MarkNeedUpdate(e);
     }
     for (Entity* e : tsc->animationTransformChanged)
     {
-        EntityNeedUpdate(e);
-        HierarchicAddToUpdate(e);
+        MarkNeedUpdate(e);
     }
 
-    passedNodes = 0;
-    multipliedNodes = 0;
-
-    uint32 size = static_cast<uint32>(updatableEntities.size());
-    for (uint32 i = 0; i < size; ++i)
+    if (dirtyNodes.empty())
     {
-        FindNodeThatRequireUpdate(updatableEntities[i]);
+        return;
     }
-    updatableEntities.clear();
-}
 
-void TransformSystem::FindNodeThatRequireUpdate(Entity* entity)
-{
-    static const uint32 STACK_SIZE = 5000;
-    uint32 stackPosition = 0;
-    Entity* stack[STACK_SIZE];
-    stack[stackPosition++] = entity;
+    CollectSweepNodes();
 
-    while (stackPosition > 0)
+    JobScheduler* scheduler = nullptr;
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr && GetScene()->GetSystemsProcessMode() == Scene::eSystemsProcessMode::PARALLEL)
     {
-        Entity* entity = stack[--stackPosition];
+        scheduler = jobManager->GetScheduler();
+    }
 
-        if (entity->GetFlags() & Entity::TRANSFORM_NEED_UPDATE)
+    // Each next level depends only on results of the previous one
+    uint32 levelsCount = static_cast<uint32>(levelOffsets.size()) - 1;
+    for (uint32 level = 0; level < levelsCount; ++level)
+    {
+        uint32 begin = levelOffsets[level];
+        uint32 end = levelOffsets[level + 1];
+        if (scheduler != nullptr && end - begin > TransformSystemDetails::PARALLEL_GRAIN_SIZE)
         {
-            TransformAllChildEntities(entity);
+            scheduler->ParallelFor(begin, end, TransformSystemDetails::PARALLEL_GRAIN_SIZE, [this](uint32 chunkBegin, uint32 chunkEnd) {
+                UpdateSweepRange(chunkBegin, chunkEnd);
+            });
         }
         else
         {
-            entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE | Entity::TRANSFORM_DIRTY);
-
-            // We already marked all children as non-dirty if we entered to TransformAllChildEntities()
-            uint32 size = entity->GetChildrenCount();
-            for (uint32 i = 0; i < size; ++i)
-            {
-                Entity* childEntity = entity->GetChild(i);
-                if (childEntity->GetFlags() & Entity::TRANSFORM_DIRTY)
-                {
-                    DVASSERT(stackPosition < STACK_SIZE - 1);
-                    stack[stackPosition++] = childEntity;
-                }
-            }
+            UpdateSweepRange(begin, end);
         }
     }
-    DVASSERT(stackPosition == 0);
+
+    // TransformSingleComponent is not thread-safe, so changes are published after the sweep
+    for (uint32 index : sweepNodes)
+    {
+        hierarchyNodeStates[index] = NODE_CLEAN;
+        tsc->worldTransformChanged.Push(hierarchyNodes[index].entity);
+    }
+    dirtyNodes.clear();
 }
 
-void TransformSystem::TransformAllChildEntities(Entity* entity)
+void TransformSystem::CollectSweepNodes()
 {
-    static const uint32 STACK_SIZE = 5000;
-    uint32 stackPosition = 0;
-    Entity* stack[STACK_SIZE];
-    stack[stackPosition++] = entity;
+    sweepNodes.clear();
+    levelOffsets.clear();
 
-    int32 localMultiplied = 0;
+    std::sort(dirtyNodes.begin(), dirtyNodes.end(), [this](uint32 l, uint32 r) {
+        return hierarchyNodes[l].depth < hierarchyNodes[r].depth;
+    });
 
-    while (stackPosition > 0)
+    // Level `d` consists of children of level `d - 1` and changed nodes of depth `d` which were not collected yet,
+    // so changed node inside changed subtree is collected once and no ancestors are walked
+    levelOffsets.push_back(0);
+    uint32 levelBegin = 0;
+    uint32 depth = 0;
+    size_t dirtyIndex = 0;
+    while (true)
     {
-        Entity* entity = stack[--stackPosition];
-
-        TransformComponent* transform = entity->GetComponent<TransformComponent>();
+        uint32 levelEnd = static_cast<uint32>(sweepNodes.size());
+        for (uint32 i = levelBegin; i < levelEnd; ++i)
+        {
+            for (int32 child = hierarchyNodes[sweepNodes[i]].firstChild; child >= 0; child = hierarchyNodes[child].nextSibling)
+            {
+                hierarchyNodeStates[child] = NODE_COLLECTED;
+                sweepNodes.push_back(static_cast<uint32>(child));
+            }
+        }
 
-        if (transform->parentTransform)
+        if (sweepNodes.size() == levelEnd)
         {
-            AnimationComponent* animComp = GetAnimationComponent(entity);
-            localMultiplied++;
-            if (animComp)
+            // Skip depths without changes
+            if (dirtyIndex == dirtyNodes.size())
             {
-                transform->worldTransform = Transform(animComp->animationTransform) * transform->localTransform * *(transform->parentTransform);
+                break;
             }
-            else
+            depth = std::max(depth, hierarchyNodes[dirtyNodes[dirtyIndex]].depth);
+        }
+
+        for (; dirtyIndex < dirtyNodes.size() && hierarchyNodes[dirtyNodes[dirtyIndex]].depth == depth; ++dirtyIndex)
+        {
+            uint32 index = dirtyNodes[dirtyIndex];
+            // Skip nodes removed after change and nodes already collected as part of changed subtree
+            if (hierarchyNodeStates[index] == NODE_CHANGED)
             {
-                transform->worldTransform = transform->localTransform * *(transform->parentTransform);
+                hierarchyNodeStates[index] = NODE_COLLECTED;
+                sweepNodes.push_back(index);
             }
+        }
 
-            transform->MarkWorldChanged();
+        if (sweepNodes.size() > levelEnd)
+        {
+            levelOffsets.push_back(static_cast<uint32>(sweepNodes.size()));
         }
+        levelBegin = levelEnd;
+        ++depth;
+    }
+}
 
-        entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE | Entity::TRANSFORM_DIRTY);
+void TransformSystem::UpdateSweepRange(uint32 begin, uint32 end)
+{
+    for (uint32 i = begin; i < end; ++i)
+    {
+        const HierarchyNode& node = hierarchyNodes[sweepNodes[i]];
+        TransformComponent* transform = node.transform;
 
-        uint32 size = entity->GetChildrenCount();
-        for (uint32 i = 0; i < size; ++i)
+        AnimationComponent* animComp = GetAnimationComponent(node.entity);
+        if (animComp)
         {
-            DVASSERT(stackPosition < STACK_SIZE - 1);
-            stack[stackPosition++] = entity->GetChild(i);
+            transform->worldTransform = Transform(animComp->animationTransform) * transform->localTransform;
         }
+        else
+        {
+            transform->worldTransform = transform->localTransform;
+        }
+
+        // Node is detached from removed parent transform until it is removed or linked again
+        if (transform->parentTransform != nullptr)
+        {
+            transform->worldTransform = transform->worldTransform * *(transform->parentTransform);
+        }
+        transform->worldMatrix = TransformUtils::ToMatrix(transform->worldTransform);
     }
-    DVASSERT(stackPosition == 0);
-    multipliedNodes += localMultiplied;
 }
 
-void TransformSystem::EntityNeedUpdate(Entity* entity)
+int32 TransformSystem::GetParentNodeIndex(Entity* entity) const
 {
-    entity->AddFlag(Entity::TRANSFORM_NEED_UPDATE);
+    Entity* parent = entity->GetParent();
+    if (parent != nullptr && parent != GetScene())
+    {
+        TransformComponent* parentTransform = parent->GetComponent<TransformComponent>();
+        if (parentTransform != nullptr && parentTransform->hierarchyIndex != INVALID_HIERARCHY_INDEX)
+        {
+            return static_cast<int32>(parentTransform->hierarchyIndex);
+        }
+    }
+
+    return -1;
 }
 
-void TransformSystem::HierarchicAddToUpdate(Entity* entity)
+void TransformSystem::LinkNode(uint32 index, int32 parentIndex)
 {
-    if (!(entity->GetFlags() & Entity::TRANSFORM_DIRTY))
+    HierarchyNode& node = hierarchyNodes[index];
+    DVASSERT(node.parent == -1 && node.nextSibling == -1 && node.prevSibling == -1);
+
+    node.parent = parentIndex;
+    node.depth = 0;
+    if (parentIndex >= 0)
     {
-        entity->AddFlag(Entity::TRANSFORM_DIRTY);
-        Entity* parent = entity->GetParent();
-        if (parent && parent->GetParent())
+        HierarchyNode& parent = hierarchyNodes[parentIndex];
+        node.nextSibling = parent.firstChild;
+        if (parent.firstChild >= 0)
         {
-            HierarchicAddToUpdate(entity->GetParent());
+            hierarchyNodes[parent.firstChild].prevSibling = static_cast<int32>(index);
         }
-        else
-        { //topmost parent
-            DVASSERT(entity->GetRetainCount() >= 1);
-            updatableEntities.push_back(entity);
+        parent.firstChild = static_cast<int32>(index);
+        node.depth = parent.depth + 1;
+    }
+
+    if (node.firstChild >= 0)
+    {
+        UpdateSubtreeDepth(index);
+    }
+}
+
+void TransformSystem::UnlinkNode(uint32 index)
+{
+    HierarchyNode& node = hierarchyNodes[index];
+    if (node.prevSibling >= 0)
+    {
+        hierarchyNodes[node.prevSibling].nextSibling = node.nextSibling;
+    }
+    else if (node.parent >= 0)
+    {
+        hierarchyNodes[node.parent].firstChild = node.nextSibling;
+    }
+
+    if (node.nextSibling >= 0)
+    {
+        hierarchyNodes[node.nextSibling].prevSibling = node.prevSibling;
+    }
+
+    node.parent = -1;
+    node.nextSibling = -1;
+    node.prevSibling = -1;
+}
+
+void TransformSystem::UpdateSubtreeDepth(uint32 index)
+{
+    depthStack.push_back(index);
+    while (!depthStack.empty())
+    {
+        const HierarchyNode& node = hierarchyNodes[depthStack.back()];
+        depthStack.pop_back();
+
+        for (int32 child = node.firstChild; child >= 0; child = hierarchyNodes[child].nextSibling)
+        {
+            hierarchyNodes[child].depth = node.depth + 1;
+            depthStack.push_back(static_cast<uint32>(child));
+        }
+    }
+}
+
+void TransformSystem::UpdateParentLink(Entity* entity)
+{
+    TransformComponent* transform = entity->GetComponent<TransformComponent>();
+    if (transform != nullptr && transform->hierarchyIndex != INVALID_HIERARCHY_INDEX)
+    {
+        int32 parentIndex = GetParentNodeIndex(entity);
+        if (hierarchyNodes[transform->hierarchyIndex].parent != parentIndex)
+        {
+            UnlinkNode(transform->hierarchyIndex);
+            LinkNode(transform->hierarchyIndex, parentIndex);
+        }
+    }
+}
+
+void TransformSystem::MarkNeedUpdate(Entity* entity)
+{
+    TransformComponent* transform = entity->GetComponent<TransformComponent>();
+    if (transform != nullptr && transform->hierarchyIndex != INVALID_HIERARCHY_INDEX)
+    {
+        DVASSERT(hierarchyNodes[transform->hierarchyIndex].entity == entity);
+        if (hierarchyNodeStates[transform->hierarchyIndex] == NODE_CLEAN)
+        {
+            hierarchyNodeStates[transform->hierarchyIndex] = NODE_CHANGED;
+            dirtyNodes.push_back(transform->hierarchyIndex);
         }
     }
 }
 
 void TransformSystem::AddEntity(Entity* entity)
 {
-    EntityNeedUpdate(entity);
-    HierarchicAddToUpdate(entity);
+    TransformComponent* transform = entity->GetComponent<TransformComponent>();
+    Entity* parent = entity->GetParent();
+    if (transform == nullptr || parent == nullptr)
+    {
+        return; // scene itself
+    }
+
+    if (transform->hierarchyIndex == INVALID_HIERARCHY_INDEX)
+    {
+        // Scene registers parents before children, but system may be added into already filled scene
+        TransformComponent* parentTransform = parent->GetComponent<TransformComponent>();
+        if (parent != GetScene() && parentTransform != nullptr && parentTransform->hierarchyIndex == INVALID_HIERARCHY_INDEX)
+        {
+            AddEntity(parent);
+        }
+
+        uint32 index = 0;
+        if (freeHierarchyNodes.empty())
+        {
+            index = static_cast<uint32>(hierarchyNodes.size());
+            hierarchyNodes.emplace_back();
+            hierarchyNodeStates.push_back(NODE_CLEAN);
+        }
+        else
+        {
+            index = freeHierarchyNodes.back();
+            freeHierarchyNodes.pop_back();
+        }
+
+        HierarchyNode& node = hierarchyNodes[index];
+        node.entity = entity;
+        node.transform = transform;
+        transform->hierarchyIndex = index;
+        LinkNode(index, GetParentNodeIndex(entity));
+
+        // Pointer could be cleared when parent was removed before, see RemoveEntity
+        transform->parentTransform = (parentTransform != nullptr) ? &parentTransform->worldTransform : nullptr;
+    }
+
+    MarkNeedUpdate(entity);
 }
 
 void TransformSystem::RemoveEntity(Entity* entity)
 {
-    //TODO: use hashmap
-    uint32 size = static_cast<uint32>(updatableEntities.size());
-    for (uint32 i = 0; i < size; ++i)
+    TransformComponent* transform = entity->GetComponent<TransformComponent>();
+    if (transform != nullptr && transform->hierarchyIndex != INVALID_HIERARCHY_INDEX)
     {
-        if (updatableEntities[i] == entity)
+        uint32 index = transform->hierarchyIndex;
+        UnlinkNode(index);
+
+        // Children are usually removed right after parent, until then they are detached roots
+        // which do not refer to the removed transform
+        int32 child = hierarchyNodes[index].firstChild;
+        while (child >= 0)
         {
-            updatableEntities[i] = updatableEntities[size - 1];
-            updatableEntities.pop_back();
-            break;
+            HierarchyNode& childNode = hierarchyNodes[child];
+            int32 nextChild = childNode.nextSibling;
+            childNode.parent = -1;
+            childNode.nextSibling = -1;
+            childNode.prevSibling = -1;
+            childNode.depth = 0;
+            UpdateSubtreeDepth(static_cast<uint32>(child));
+
+            if (childNode.transform->parentTransform == &transform->worldTransform)
+            {
+                childNode.transform->parentTransform = nullptr;
+            }
+            MarkNeedUpdate(childNode.entity);
+
+            child = nextChild;
         }
+
+        hierarchyNodes[index] = HierarchyNode();
+        hierarchyNodeStates[index] = NODE_CLEAN;
+        freeHierarchyNodes.push_back(index);
+        transform->hierarchyIndex = INVALID_HIERARCHY_INDEX;
     }
 
     entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE);
@@ -177,14 +362,20 @@ void TransformSystem::RemoveEntity(Entity* entity)
 
 void TransformSystem::PrepareForRemove()
 {
-    uint32 size = static_cast<uint32>(updatableEntities.size());
-    for (uint32 i = 0; i < size; ++i)
+    for (const HierarchyNode& node : hierarchyNodes)
     {
-        Entity* entity = updatableEntities[i];
-        entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE);
-        entity->RemoveFlag(Entity::TRANSFORM_DIRTY);
+        if (node.transform != nullptr)
+        {
+            node.transform->hierarchyIndex = INVALID_HIERARCHY_INDEX;
+        }
     }
 
-    updatableEntities.clear();
+    hierarchyNodes.clear();
+    hierarchyNodeStates.clear();
+    freeHierarchyNodes.clear();
+    dirtyNodes.clear();
+    sweepNodes.clear();
+    depthStack.clear();
+    levelOffsets.clear();
 }
 };
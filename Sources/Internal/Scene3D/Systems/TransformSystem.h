@@ -13,9 +13,23 @@ class Transform;
 class TransformComponent;
 class Transform;
 
+/**
+    Calculates world transforms of scene entities.
+
+    Scene hierarchy is mirrored in contiguous array of nodes linked by indices (parent, first child and siblings)
+    with depth of every node. Nodes are linked and unlinked incrementally when entities are added, removed or reparented,
+    removed nodes are reused.
+
+    Whole hierarchy is not kept as single depth-ordered array on purpose: such array has to be rebuilt on every
+    add, remove or reparent, and sweeping it costs O(nodes) even if one leaf is changed. Instead each frame changed nodes
+    are sorted by depth and only their subtrees are collected into compact list ordered by depth, so nodes of every level
+    are stored after all their parents. Levels of the list are swept one by one, every level is split between job workers.
+*/
 class TransformSystem : public SceneSystem
 {
 public:
+    static const uint32 INVALID_HIERARCHY_INDEX = static_cast<uint32>(-1);
+
     TransformSystem(Scene* scene);
 
     void AddEntity(Entity* entity) override;
@@ -25,14 +39,40 @@ public:
     void Process(float32 timeElapsed) override;
 
 private:
-    Vector<Entity*> updatableEntities;
+    struct HierarchyNode
+    {
+        Entity* entity = nullptr;
+        TransformComponent* transform = nullptr;
+        int32 parent = -1; // -1 for direct children of scene
+        int32 firstChild = -1;
+        int32 nextSibling = -1;
+        int32 prevSibling = -1;
+        uint32 depth = 0;
+    };
+
+    enum eNodeState : uint8
+    {
+        NODE_CLEAN = 0,
+        NODE_CHANGED, // node is in `dirtyNodes`
+        NODE_COLLECTED // node is in `sweepNodes`
+    };
+
+    int32 GetParentNodeIndex(Entity* entity) const;
+    void LinkNode(uint32 index, int32 parentIndex);
+    void UnlinkNode(uint32 index);
+    void UpdateSubtreeDepth(uint32 index);
+    void UpdateParentLink(Entity* entity);
+    void MarkNeedUpdate(Entity* entity);
+    void CollectSweepNodes();
+    void UpdateSweepRange(uint32 begin, uint32 end);
 
-    void EntityNeedUpdate(Entity* entity);
-    void HierarchicAddToUpdate(Entity* entity);
-    void FindNodeThatRequireUpdate(Entity* entity);
-    void TransformAllChildEntities(Entity* entity);
+    Vector<HierarchyNode> hierarchyNodes;
+    Vector<uint8> hierarchyNodeStates; // eNodeState of every node
+    Vector<uint32> freeHierarchyNodes;
 
-    int32 passedNodes;
-    int32 multipliedNodes;
+    Vector<uint32> dirtyNodes; // changed nodes, may contain duplicates and nodes removed after change
+    Vector<uint32> sweepNodes; // subtrees of changed nodes ordered by depth
+    Vector<uint32> depthStack; // scratch stack of UpdateSubtreeDepth
+    Vector<uint32> levelOffsets; // nodes of depth level `d` are in range [levelOffsets[d], levelOffsets[d + 1]) of sweepNodes
 };
 };
@@ -32,6 +32,8 @@ WaveSystem::WaveSystem(Scene* scene)
     :
     SceneSystem(scene)
 {
+    SetProcessAccess(SceneSystemAccess().WriteComponent<WaveComponent>());
+
     RenderOptions* options = Renderer::GetOptions();
     options->AddObserver(this);
     HandleEvent(options);
@@ -30,6 +30,9 @@ WindSystem::WindSystem(Scene* scene)
     :
     SceneSystem(scene)
 {
+    // Wind state is read by SpeedTreeUpdateSystem and FoliageSystem, which are processed exclusively
+    SetProcessAccess(SceneSystemAccess().WriteComponent<WindComponent>());
+
     RenderOptions* options = Renderer::GetOptions();
     options->AddObserver(this);
     HandleEvent(options);
@@ -21,7 +21,8 @@ public:
         FLAG_STICK_THIS = 1 << 4,
         FLAG_STICK_HARD = 1 << 5,
         FLAG_LTR = 1 << 6,
-        FLAG_RTL = 1 << 7
+        FLAG_RTL = 1 << 7,
+        FLAG_CHILDREN_SKIPPED = 1 << 8
     };
 
 public:
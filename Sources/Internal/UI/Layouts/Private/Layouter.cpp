@@ -13,6 +13,66 @@
 
 namespace DAVA
 {
+namespace LayouterDetails
+{
+bool IsLayoutClean(const UIControl* control)
+{
+    return !control->IsLayoutDirty() && !control->IsLayoutPositionDirty() && !control->IsLayoutOrderDirty() && !control->IsLayoutSubtreeDirty();
+}
+
+bool CanSkipChildren(const UIControl* control)
+{
+    if (control->GetChildren().empty() || !IsLayoutClean(control))
+    {
+        return false;
+    }
+
+    UISizePolicyComponent* sizePolicy = control->GetComponent<UISizePolicyComponent>();
+    return sizePolicy == nullptr || (!sizePolicy->IsDependsOnChildren(Vector2::AXIS_X) && !sizePolicy->IsDependsOnChildren(Vector2::AXIS_Y));
+}
+
+bool UsesVisibilityMargins(const UIControl* control)
+{
+    UISizePolicyComponent* sizePolicy = control->GetComponent<UISizePolicyComponent>();
+    if (sizePolicy != nullptr)
+    {
+        for (int32 axis = 0; axis < Vector2::AXIS_COUNT; ++axis)
+        {
+            LayoutFormula* formula = sizePolicy->GetFormula(axis);
+            if (formula != nullptr && formula->GetSource().find("visibilityMargins") != String::npos)
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool HasVisibilityMarginsInChildren(const UIControl* control)
+{
+    for (const auto& child : control->GetChildren())
+    {
+        if (child->GetComponentCount<UILayoutIsolationComponent>() == 0 && (UsesVisibilityMargins(child.Get()) || HasVisibilityMarginsInChildren(child.Get())))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResetLayoutSubtreeDirtyIfClean(UIControl* control)
+{
+    for (const auto& child : control->GetChildren())
+    {
+        if (!IsLayoutClean(child.Get()))
+        {
+            return;
+        }
+    }
+    control->ResetLayoutSubtreeDirty();
+}
+}
+
 void Layouter::ApplyLayout(UIControl* control)
 {
     CollectControls(control, true);
@@ -20,9 +80,56 @@ void Layouter::ApplyLayout(UIControl* control)
     ProcessAxis(Vector2::AXIS_X, true);
     ProcessAxis(Vector2::AXIS_Y, true);
 
+    // Skipped subtree is laid out again if its root gets new size, or if it is moved on screen
+    // (by itself or with any ancestor) while formulas inside of it depend on visibility margins
+    Vector<UIControl*> resizedControlsWithSkippedChildren;
+    Vector<UIControl*> movedControlsWithSkippedChildren;
+    Vector<bool> moved(layoutData.size(), false);
+    for (size_t i = 0; i < layoutData.size(); ++i)
+    {
+        const ControlLayoutData& data = layoutData[i];
+        UIControl* control = data.GetControl();
+        int32 parentIndex = data.GetParentIndex();
+
+        bool positionChanged = data.HasFlag(ControlLayoutData::FLAG_POSITION_CHANGED) && (control->GetPosition() - control->GetPivotPoint() != Vector2(data.GetX(), data.GetY()));
+        moved[i] = positionChanged || (parentIndex >= 0 && moved[parentIndex]);
+
+        if (data.HasFlag(ControlLayoutData::FLAG_CHILDREN_SKIPPED))
+        {
+            if (data.HasFlag(ControlLayoutData::FLAG_SIZE_CHANGED) && control->GetSize() != Vector2(data.GetWidth(), data.GetHeight()))
+            {
+                resizedControlsWithSkippedChildren.push_back(control);
+            }
+            else if (moved[i] && LayouterDetails::HasVisibilityMarginsInChildren(control))
+            {
+                movedControlsWithSkippedChildren.push_back(control);
+            }
+        }
+    }
+
     ApplySizesAndPositions();
 
+    // Applied sizes mark parents as having dirty subtree, children are processed before their parents
+    for (auto it = layoutData.rbegin(); it != layoutData.rend(); ++it)
+    {
+        LayouterDetails::ResetLayoutSubtreeDirtyIfClean(it->GetControl());
+    }
+
     layoutData.clear();
+
+    for (UIControl* c : resizedControlsWithSkippedChildren)
+    {
+        ApplyLayout(c);
+    }
+
+    // Whole moved subtree is laid out, since deeper clean subtrees are moved as well
+    bool skip = skipCleanSubtrees;
+    skipCleanSubtrees = false;
+    for (UIControl* c : movedControlsWithSkippedChildren)
+    {
+        ApplyLayout(c);
+    }
+    skipCleanSubtrees = skip;
 }
 
 void Layouter::ApplyLayoutNonRecursive(UIControl* control)
@@ -70,7 +177,15 @@ void Layouter::CollectControlChildren(UIControl* control, int32 parentIndex, int
         {
             if (child->GetComponentCount<UILayoutIsolationComponent>() == 0)
             {
-                CollectControlChildren(child.Get(), index, childIndex, recursive);
+                if (skipCleanSubtrees && LayouterDetails::CanSkipChildren(child.Get()))
+                {
+                    layoutData[childIndex].SetParentIndex(index);
+                    layoutData[childIndex].SetFlag(ControlLayoutData::FLAG_CHILDREN_SKIPPED);
+                }
+                else
+                {
+                    CollectControlChildren(child.Get(), index, childIndex, recursive);
+                }
                 childIndex++;
             }
         }
@@ -104,7 +219,11 @@ void Layouter::DoLayoutPhase(Vector2::eAxis axis)
     for (auto it = layoutData.begin(); it != layoutData.end(); ++it)
     {
         UIFlowLayoutComponent* flowLayoutComponent = it->GetControl()->GetComponent<UIFlowLayoutComponent>();
-        if (flowLayoutComponent && flowLayoutComponent->IsEnabled())
+        if (it->HasFlag(ControlLayoutData::FLAG_CHILDREN_SKIPPED))
+        {
+            // Children keep their layout, control is laid out separately if its size changes
+        }
+        else if (flowLayoutComponent && flowLayoutComponent->IsEnabled())
         {
             FlowLayoutAlgorithm(*this).Apply(*it, axis);
         }
@@ -186,6 +305,11 @@ void Layouter::SetRtl(bool rtl)
     isRtl = rtl;
 }
 
+void Layouter::SetSkipCleanSubtrees(bool skip)
+{
+    skipCleanSubtrees = skip;
+}
+
 bool Layouter::IsLeftNotch() const
 {
     return isLeftNotch;
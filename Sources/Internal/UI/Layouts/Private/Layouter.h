@@ -29,6 +29,13 @@ public:
     void SetRtl(bool rtl);
     bool IsRtl() const;
 
+    /**
+     Don't collect children of controls without dirty layout in subtree if control size
+     doesn't depend on children. Such subtree is laid out only if control size is changed.
+     */
+    void SetSkipCleanSubtrees(bool skip);
+    bool IsSkipCleanSubtrees() const;
+
     bool IsLeftNotch() const;
     bool IsRightNotch() const;
     const LayoutMargins& GetSafeAreaInsets() const;
@@ -47,6 +54,7 @@ public:
 private:
     Vector<ControlLayoutData> layoutData;
     bool isRtl = false;
+    bool skipCleanSubtrees = false;
     Rect visibilityRect;
     LayoutMargins safeAreaInsets;
     bool isLeftNotch = false;
@@ -68,6 +76,11 @@ inline bool Layouter::IsRtl() const
     return isRtl;
 }
 
+inline bool Layouter::IsSkipCleanSubtrees() const
+{
+    return skipCleanSubtrees;
+}
+
 inline const Rect& Layouter::GetVisibilityRect() const
 {
     return visibilityRect;
@@ -25,6 +25,14 @@
 
 namespace DAVA
 {
+namespace UILayoutSystemDetails
+{
+bool IsLayoutDirty(const UIControl* control)
+{
+    return control->IsLayoutDirty() || control->IsLayoutPositionDirty() || control->IsLayoutOrderDirty();
+}
+}
+
 UILayoutSystem::UILayoutSystem()
     : sharedLayouter(std::make_unique<Layouter>())
 {
@@ -99,6 +107,8 @@ void UILayoutSystem::Process(float32 elapsedTime)
     {
         ProcessControlHierarhy(popupContainer.Get());
     }
+
+    fullLayoutRequired = false;
 }
 
 void UILayoutSystem::UnregisterControl(UIControl* control)
@@ -147,11 +157,13 @@ void UILayoutSystem::ForceProcessControl(float32 elapsedTime, UIControl* control
 void UILayoutSystem::SetCurrentScreen(const RefPtr<UIScreen>& screen)
 {
     currentScreen = screen;
+    fullLayoutRequired = true;
 }
 
 void UILayoutSystem::SetPopupContainer(const RefPtr<UIControl>& _popupContainer)
 {
     popupContainer = _popupContainer;
+    fullLayoutRequired = true;
 }
 
 bool UILayoutSystem::IsRtl() const
@@ -162,6 +174,7 @@ bool UILayoutSystem::IsRtl() const
 void UILayoutSystem::SetRtl(bool rtl)
 {
     sharedLayouter->SetRtl(rtl);
+    fullLayoutRequired = true;
 }
 
 void UILayoutSystem::SetPhysicalSafeAreaInsets(float32 left, float32 top, float32 right, float32 bottom, bool isLeftNotch_, bool isRightNotch_)
@@ -180,6 +193,7 @@ void UILayoutSystem::SetPhysicalSafeAreaInsets(float32 left, float32 top, float3
                                       vcs->ConvertPhysicalToVirtualY(bottom),
                                       isLeftNotch,
                                       isRightNotch);
+    fullLayoutRequired = true;
 
     if (currentScreen.Valid())
     {
@@ -224,7 +238,9 @@ void UILayoutSystem::ProcessControl(UIControl* control)
 
     if (layoutDirty || (orderDirty && HaveToLayoutAfterReorder(control)) || (positionDirty && control->GetParent() && control->GetParent()->GetComponent(Type::Instance<UILayoutSourceRectComponent>())))
     {
+        // Clean subtrees are laid out again only after changes which affect whole screen
         UIControl* container = FindNotDependentOnChildrenControl(control);
+        sharedLayouter->SetSkipCleanSubtrees(!fullLayoutRequired);
         sharedLayouter->ApplyLayout(container);
 
         controlLayouted.Emit(container);
@@ -331,6 +347,11 @@ bool UILayoutSystem::HaveToLayoutAfterReposition(const UIControl* control) const
 
 void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
 {
+    if (!UILayoutSystemDetails::IsLayoutDirty(control) && !control->IsLayoutSubtreeDirty())
+    {
+        return;
+    }
+
     ProcessControl(control);
 
     // TODO: For now game has many places where changes in layouts can
@@ -350,11 +371,22 @@ void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
         }
         ++it;
     }
+
+    // Subtree stays dirty if layout of some child was changed during processing
+    for (const auto& child : children)
+    {
+        if (UILayoutSystemDetails::IsLayoutDirty(child.Get()) || child->IsLayoutSubtreeDirty())
+        {
+            return;
+        }
+    }
+    control->ResetLayoutSubtreeDirty();
 }
 
 void UILayoutSystem::UpdateVisibilityRect(const Rect& visibilityRect)
 {
     sharedLayouter->SetVisibilityRect(visibilityRect);
+    fullLayoutRequired = true;
     if (currentScreen.Valid())
     {
         currentScreen->SetLayoutDirty();
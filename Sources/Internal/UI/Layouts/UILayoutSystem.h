@@ -74,6 +74,7 @@ private:
     bool autoupdatesEnabled = true;
     bool dirty = false;
     bool needUpdate = false;
+    bool fullLayoutRequired = true;
     std::unique_ptr<class Layouter> sharedLayouter;
     RefPtr<UIScreen> currentScreen;
     RefPtr<UIControl> popupContainer;
@@ -8,6 +8,7 @@
 #include "Render/Renderer.h"
 #include "UI/Render/UIClipContentComponent.h"
 #include "UI/Render/UIDebugRenderComponent.h"
+#include "UI/Render/UIStaticBatchComponent.h"
 #include "UI/Scene3D/UISceneComponent.h"
 #include "UI/Text/Private/UITextSystemLink.h"
 #include "UI/Text/UITextComponent.h"
@@ -31,6 +32,14 @@ static void DrawLocalizationErrors(const UITextSystemLink* link, const UIGeometr
 #endif
 }
 
+namespace UIRenderSystemDetails
+{
+bool IsSameGeometricData(const UIGeometricData& a, const UIGeometricData& b)
+{
+    return a.position == b.position && a.size == b.size && a.pivotPoint == b.pivotPoint && a.scale == b.scale && a.angle == b.angle;
+}
+}
+
 UIRenderSystem::UIRenderSystem(RenderSystem2D* renderSystem2D_)
     : renderSystem2D(renderSystem2D_)
     , screenshoter(std::make_unique<UIScreenshoter>())
@@ -171,6 +180,30 @@ void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometric
         renderSystem2D->IntersectClipRect(unrotatedRect); //anyway it doesn't work with rotation
     }
 
+    UIStaticBatchComponent* staticBatch = control->GetComponent<UIStaticBatchComponent>();
+    if (staticBatch != nullptr && staticBatch->IsEnabled() && !renderSystem2D->IsRecordingStaticBatch())
+    {
+        RenderStaticBatch(staticBatch, control, drawData, parentBackground, parentColor);
+    }
+    else
+    {
+        RenderControlContent(control, drawData, parentBackground, parentColor);
+    }
+
+    if (clipContents)
+    {
+        renderSystem2D->PopClip();
+    }
+
+    const UIDebugRenderComponent* debugRenderComponent = control->GetComponent<UIDebugRenderComponent>();
+    if (debugRenderComponent && debugRenderComponent->IsEnabled())
+    {
+        DebugRender(debugRenderComponent, drawData);
+    }
+}
+
+void UIRenderSystem::RenderControlContent(UIControl* control, const UIGeometricData& drawData, const UIControlBackground* parentBackground, const Color& parentColor)
+{
     control->Draw(drawData);
     const UITextComponent* txt = control->GetComponent<UITextComponent>();
     if (txt)
@@ -188,16 +221,39 @@ void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometric
     }
 
     control->DrawAfterChilds(drawData);
+}
 
-    if (clipContents)
+void UIRenderSystem::RenderStaticBatch(UIStaticBatchComponent* component, UIControl* control, const UIGeometricData& drawData, const UIControlBackground* parentBackground, const Color& parentColor)
+{
+    if (!component->canBatch)
     {
-        renderSystem2D->PopClip();
+        RenderControlContent(control, drawData, parentBackground, parentColor);
+        return;
     }
 
-    const UIDebugRenderComponent* debugRenderComponent = control->GetComponent<UIDebugRenderComponent>();
-    if (debugRenderComponent && debugRenderComponent->IsEnabled())
+    const Rect& clip = renderSystem2D->GetClip();
+    if (component->staticBatch.IsValid() &&
+        UIRenderSystemDetails::IsSameGeometricData(component->batchGeometricData, drawData) &&
+        component->batchParentColor == parentColor &&
+        component->batchClip == clip)
     {
-        DebugRender(debugRenderComponent, drawData);
+        renderSystem2D->DrawStaticBatch(&component->staticBatch);
+        return;
+    }
+
+    component->batchGeometricData = drawData;
+    component->batchParentColor = parentColor;
+    component->batchClip = clip;
+
+    renderSystem2D->BeginStaticBatch(&component->staticBatch);
+    RenderControlContent(control, drawData, parentBackground, parentColor);
+    renderSystem2D->EndStaticBatch();
+
+    if (!component->staticBatch.IsValid())
+    {
+        // subtree draws something bypassing 2D batches, don't record it every frame
+        component->staticBatch.Clear();
+        component->canBatch = false;
     }
 }
 
@@ -11,6 +11,7 @@ class Color;
 class RenderSystem2D;
 class UIControlBackground;
 class UIDebugRenderComponent;
+class UIStaticBatchComponent;
 class UITextComponent;
 class UIScreen;
 class UIScreenTransition;
@@ -50,6 +51,8 @@ private:
     void ForceRenderControl(UIControl* control);
 
     void RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground);
+    void RenderControlContent(UIControl* control, const UIGeometricData& drawData, const UIControlBackground* parentBackground, const Color& parentColor);
+    void RenderStaticBatch(UIStaticBatchComponent* component, UIControl* control, const UIGeometricData& drawData, const UIControlBackground* parentBackground, const Color& parentColor);
 
     void DebugRender(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
     void RenderDebugRect(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
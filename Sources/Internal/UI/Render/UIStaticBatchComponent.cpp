@@ -0,0 +1,54 @@
+#include "UIStaticBatchComponent.h"
+#include "Engine/Engine.h"
+#include "Entity/ComponentManager.h"
+#include "Reflection/ReflectionRegistrator.h"
+
+namespace DAVA
+{
+DAVA_VIRTUAL_REFLECTION_IMPL(UIStaticBatchComponent)
+{
+    ReflectionRegistrator<UIStaticBatchComponent>::Begin()[M::DisplayName("Static Batch"), M::Group("Content")]
+    .ConstructorByPointer()
+    .DestructorByPointer([](UIStaticBatchComponent* c) { SafeRelease(c); })
+    .Field("enabled", &UIStaticBatchComponent::IsEnabled, &UIStaticBatchComponent::SetEnabled)[M::DisplayName("Enabled")]
+    .End();
+}
+IMPLEMENT_UI_COMPONENT(UIStaticBatchComponent);
+
+UIStaticBatchComponent::UIStaticBatchComponent()
+{
+}
+
+UIStaticBatchComponent::UIStaticBatchComponent(const UIStaticBatchComponent& src)
+    : UIComponent(src)
+    , enabled(src.enabled)
+{
+}
+
+UIStaticBatchComponent* UIStaticBatchComponent::Clone() const
+{
+    return new UIStaticBatchComponent(*this);
+}
+
+void UIStaticBatchComponent::SetEnabled(bool _enabled)
+{
+    enabled = _enabled;
+    Invalidate();
+}
+
+bool UIStaticBatchComponent::IsEnabled() const
+{
+    return enabled;
+}
+
+void UIStaticBatchComponent::Invalidate()
+{
+    staticBatch.Clear();
+    canBatch = true;
+}
+
+bool UIStaticBatchComponent::IsBatchValid() const
+{
+    return staticBatch.IsValid();
+}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Color.h"
+#include "Math/Rect.h"
+#include "Render/2D/Systems/StaticBatch2D.h"
+#include "UI/Components/UIComponent.h"
+#include "UI/UIGeometricData.h"
+#include "Reflection/Reflection.h"
+
+namespace DAVA
+{
+/**
+    Retains geometry of control subtree, so it is drawn without regenerating while nothing changes.
+    Geometric data and parent color of control with this component and current clip are checked on draw.
+    Changes inside of subtree invalidate it through `UIControl::SetStaticBatchDirty`: layout dirty flags
+    (children add/remove/order, visibility, position, size), angle and scale, background and text changes.
+    Content changed bypassing these setters (e.g. custom `Draw` overrides) requires explicit `Invalidate` call.
+    Subtrees with content drawn outside of 2D batches (UI3DView, UIParticles, native web and movie views)
+    can't be retained, they are drawn as usual until next `Invalidate` call.
+*/
+class UIStaticBatchComponent : public UIComponent
+{
+    DAVA_VIRTUAL_REFLECTION(UIStaticBatchComponent, UIComponent);
+    DECLARE_UI_COMPONENT(UIStaticBatchComponent);
+
+public:
+    UIStaticBatchComponent();
+    UIStaticBatchComponent(const UIStaticBatchComponent& src);
+
+    UIStaticBatchComponent* Clone() const override;
+
+    void SetEnabled(bool _enabled);
+    bool IsEnabled() const;
+
+    void Invalidate();
+    bool IsBatchValid() const;
+
+private:
+    friend class UIRenderSystem;
+
+    ~UIStaticBatchComponent() override = default;
+    UIStaticBatchComponent& operator=(const UIStaticBatchComponent&) = delete;
+
+    bool enabled = true;
+    bool canBatch = true; // false after recording of subtree turned out not replayable
+
+    StaticBatch2D staticBatch;
+    UIGeometricData batchGeometricData;
+    Color batchParentColor;
+    Rect batchClip;
+};
+}
@@ -0,0 +1,141 @@
+#include <Base/BaseTypes.h>
+#include <Base/RefPtr.h>
+#include <Engine/Engine.h>
+#include <UI/Render/UIStaticBatchComponent.h>
+#include <UI/Text/UITextComponent.h>
+#include <UI/UIControl.h>
+#include <UI/UIControlBackground.h>
+#include <UI/UIControlSystem.h>
+#include <UI/UIScreen.h>
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIStaticBatchComponentTest)
+{
+    BEGIN_FILES_COVERED_BY_TESTS()
+    FIND_FILES_IN_TARGET(DavaFramework)
+    DECLARE_COVERED_FILES("UIStaticBatchComponent.cpp")
+    END_FILES_COVERED_BY_TESTS();
+
+    RefPtr<UIControl> root;
+    RefPtr<UIControl> child;
+    UIStaticBatchComponent* staticBatch = nullptr;
+
+    UIStaticBatchComponentTest()
+    {
+        RefPtr<UIScreen> screen(new UIScreen());
+        GetEngineContext()->uiControlSystem->SetScreen(screen.Get());
+        GetEngineContext()->uiControlSystem->Update();
+
+        root = new UIControl(Rect(0.f, 0.f, 100.f, 100.f));
+        root->GetOrCreateComponent<UIControlBackground>()->SetDrawType(UIControlBackground::DRAW_FILL);
+        staticBatch = root->GetOrCreateComponent<UIStaticBatchComponent>();
+
+        child = new UIControl(Rect(10.f, 10.f, 20.f, 20.f));
+        child->GetOrCreateComponent<UIControlBackground>()->SetDrawType(UIControlBackground::DRAW_FILL);
+        root->AddControl(child.Get());
+
+        screen->AddControl(root.Get());
+    }
+
+    ~UIStaticBatchComponentTest()
+    {
+        GetEngineContext()->uiControlSystem->Reset();
+    }
+
+    void UpdateAndDraw()
+    {
+        GetEngineContext()->uiControlSystem->Update();
+        GetEngineContext()->uiControlSystem->Draw();
+    }
+
+    DAVA_TEST (RecordedBatchStaysValid)
+    {
+        UpdateAndDraw();
+        TEST_VERIFY(staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        TEST_VERIFY(staticBatch->IsBatchValid());
+    }
+
+    DAVA_TEST (ChildrenChangeInvalidatesBatch)
+    {
+        UpdateAndDraw();
+        RefPtr<UIControl> newChild(new UIControl(Rect(0.f, 0.f, 5.f, 5.f)));
+        root->AddControl(newChild.Get());
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        TEST_VERIFY(staticBatch->IsBatchValid());
+        root->RemoveControl(newChild.Get());
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+    }
+
+    DAVA_TEST (VisibilityChangeInvalidatesBatch)
+    {
+        UpdateAndDraw();
+        child->SetVisibilityFlag(false);
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        TEST_VERIFY(staticBatch->IsBatchValid());
+        child->SetVisibilityFlag(true);
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+    }
+
+    DAVA_TEST (GeometryChangeInvalidatesBatch)
+    {
+        UpdateAndDraw();
+        child->SetPosition(Vector2(30.f, 30.f));
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        child->SetSize(Vector2(40.f, 40.f));
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        child->SetAngleInDegrees(45.f);
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        child->SetScale(Vector2(2.f, 2.f));
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+    }
+
+    DAVA_TEST (BackgroundChangeInvalidatesBatch)
+    {
+        UpdateAndDraw();
+        child->GetComponent<UIControlBackground>()->SetColor(Color::Red);
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+
+        UpdateAndDraw();
+        child->GetComponent<UIControlBackground>()->SetSprite(nullptr);
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+    }
+
+    DAVA_TEST (TextChangeInvalidatesBatch)
+    {
+        UITextComponent* text = child->GetOrCreateComponent<UITextComponent>();
+        UpdateAndDraw();
+        TEST_VERIFY(staticBatch->IsBatchValid());
+
+        text->SetText("static batch");
+        UpdateAndDraw();
+        TEST_VERIFY(staticBatch->IsBatchValid());
+
+        // text system applies change on update, draw records batch again
+        text->SetText("changed text");
+        GetEngineContext()->uiControlSystem->Update();
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+    }
+
+    DAVA_TEST (DisabledComponentIsNotRecorded)
+    {
+        staticBatch->SetEnabled(false);
+        UpdateAndDraw();
+        TEST_VERIFY(!staticBatch->IsBatchValid());
+        staticBatch->SetEnabled(true);
+    }
+};
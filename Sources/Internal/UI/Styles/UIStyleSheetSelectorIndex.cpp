@@ -0,0 +1,186 @@
+#include "UI/Styles/UIStyleSheetSelectorIndex.h"
+#include "UI/Styles/UIStyleSheet.h"
+#include "UI/UIControl.h"
+#include "Base/Hash.h"
+
+namespace DAVA
+{
+namespace UIStyleSheetSelectorIndexDetails
+{
+// Caches are rebuilt from scratch when they grow too big (e.g. many controls with unique names)
+const size_t MAX_MATCH_RESULTS = 4096;
+
+// Signatures are unique among all indices, so signatures from different package contexts never collide
+uint32 nextSignature = 1;
+
+void AppendStyleSheets(const Vector<int32>* styleSheets, Vector<int32>& candidates)
+{
+    if (styleSheets != nullptr)
+    {
+        candidates.insert(candidates.end(), styleSheets->begin(), styleSheets->end());
+    }
+}
+
+template <typename K>
+const Vector<int32>* FindStyleSheets(const UnorderedMap<K, Vector<int32>>& map, const K& key)
+{
+    auto it = map.find(key);
+    return it != map.end() ? &it->second : nullptr;
+}
+}
+
+UIStyleSheetSelectorIndex::MatchKey::MatchKey(const UIControl* control)
+    : className(control->GetClassName())
+    , name(control->GetName())
+    , state(control->GetState())
+{
+    const Vector<UIStyleSheetClass>& controlClasses = control->GetClassSet().GetClasses();
+    classes.reserve(controlClasses.size());
+    for (const UIStyleSheetClass& clazz : controlClasses)
+    {
+        classes.push_back(clazz.clazz);
+    }
+}
+
+bool UIStyleSheetSelectorIndex::MatchKey::operator==(const MatchKey& other) const
+{
+    return state == other.state && name == other.name && classes == other.classes && className == other.className;
+}
+
+size_t UIStyleSheetSelectorIndex::MatchKeyHash::operator()(const MatchKey& key) const
+{
+    size_t seed = std::hash<String>()(key.className);
+    HashCombine(seed, key.name);
+    HashCombine(seed, key.state);
+    for (const FastName& clazz : key.classes)
+    {
+        HashCombine(seed, clazz);
+    }
+    return seed;
+}
+
+void UIStyleSheetSelectorIndex::Build(const Vector<UIPriorityStyleSheet>& sortedStyleSheets)
+{
+    styleSheetsByName.clear();
+    styleSheetsByClass.clear();
+    styleSheetsByType.clear();
+    universalStyleSheets.clear();
+    ancestorSelectors.clear();
+    ClearMatchResults();
+    signatures.clear();
+
+    for (size_t i = 0; i < sortedStyleSheets.size(); ++i)
+    {
+        const int32 index = static_cast<int32>(i);
+        const UIStyleSheetSelectorChain& chain = sortedStyleSheets[i].GetStyleSheet()->GetSelectorChain();
+        if (chain.GetSize() == 0)
+        {
+            universalStyleSheets.push_back(index);
+            continue;
+        }
+
+        // Most selective part of rightmost selector is used as key, it's enough to reject most of style sheets
+        const UIStyleSheetSelector& selector = *chain.rbegin();
+        if (selector.name.IsValid())
+        {
+            styleSheetsByName[selector.name].push_back(index);
+        }
+        else if (!selector.classes.empty())
+        {
+            styleSheetsByClass[selector.classes.front()].push_back(index);
+        }
+        else if (!selector.className.empty())
+        {
+            styleSheetsByType[selector.className].push_back(index);
+        }
+        else
+        {
+            universalStyleSheets.push_back(index);
+        }
+
+        for (auto it = chain.rbegin() + 1; it != chain.rend(); ++it)
+        {
+            ancestorSelectors.push_back(&(*it));
+        }
+    }
+}
+
+void UIStyleSheetSelectorIndex::CollectCandidates(const UIControl* control, const UIStyleSheetClassSet& globalClasses, Vector<int32>& candidates) const
+{
+    using namespace UIStyleSheetSelectorIndexDetails;
+
+    candidates = universalStyleSheets;
+
+    if (!styleSheetsByName.empty())
+    {
+        AppendStyleSheets(FindStyleSheets(styleSheetsByName, control->GetName()), candidates);
+    }
+
+    if (!styleSheetsByType.empty())
+    {
+        AppendStyleSheets(FindStyleSheets(styleSheetsByType, control->GetClassName()), candidates);
+    }
+
+    if (!styleSheetsByClass.empty())
+    {
+        for (const UIStyleSheetClass& clazz : control->GetClassSet().GetClasses())
+        {
+            AppendStyleSheets(FindStyleSheets(styleSheetsByClass, clazz.clazz), candidates);
+        }
+        for (const UIStyleSheetClass& clazz : globalClasses.GetClasses())
+        {
+            AppendStyleSheets(FindStyleSheets(styleSheetsByClass, clazz.clazz), candidates);
+        }
+    }
+
+    // Keep cascade order, the same style sheet may come from control and global classes
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+}
+
+void UIStyleSheetSelectorIndex::SetGlobalClassesVersion(uint32 version)
+{
+    if (globalClassesVersion != version)
+    {
+        globalClassesVersion = version;
+        ClearMatchResults();
+    }
+}
+
+const UIStyleSheetSelectorIndex::MatchResult* UIStyleSheetSelectorIndex::FindMatchResult(const MatchKey& key) const
+{
+    auto it = matchResults.find(key);
+    return it != matchResults.end() ? &it->second : nullptr;
+}
+
+const UIStyleSheetSelectorIndex::MatchResult& UIStyleSheetSelectorIndex::AddMatchResult(const MatchKey& key, Vector<int32>&& styleSheets, const Vector<int32>& matchedAncestorSelectors)
+{
+    using namespace UIStyleSheetSelectorIndexDetails;
+
+    if (matchResults.size() >= MAX_MATCH_RESULTS)
+    {
+        ClearMatchResults();
+    }
+
+    if (signatures.size() >= MAX_MATCH_RESULTS)
+    {
+        signatures.clear();
+    }
+
+    auto signatureIt = signatures.find(matchedAncestorSelectors);
+    if (signatureIt == signatures.end())
+    {
+        signatureIt = signatures.emplace(matchedAncestorSelectors, nextSignature++).first;
+    }
+
+    MatchResult& result = matchResults[key];
+    result.styleSheets = std::move(styleSheets);
+    result.signature = signatureIt->second;
+    return result;
+}
+
+void UIStyleSheetSelectorIndex::ClearMatchResults()
+{
+    matchResults.clear();
+}
+}
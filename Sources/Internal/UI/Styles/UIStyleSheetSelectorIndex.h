@@ -0,0 +1,72 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "UI/Styles/UIPriorityStyleSheet.h"
+#include "UI/Styles/UIStyleSheetStructs.h"
+
+namespace DAVA
+{
+class UIControl;
+
+/**
+    Style sheets of package context grouped by their rightmost selector (name, class or control type),
+    so only candidate style sheets are tested against control.
+
+    Also caches matching results for controls with the same type, name, state and classes.
+    Result includes list of style sheets whose rightmost selector matches control and signature of
+    non-rightmost selectors matched by control. Equal signatures mean that control can't change matching of its descendants.
+*/
+class UIStyleSheetSelectorIndex
+{
+public:
+    struct MatchKey
+    {
+        MatchKey(const UIControl* control);
+        bool operator==(const MatchKey& other) const;
+
+        String className;
+        FastName name;
+        int32 state = 0;
+        Vector<FastName> classes;
+    };
+
+    struct MatchResult
+    {
+        Vector<int32> styleSheets; // sorted indices of style sheets with matched rightmost selector
+        uint32 signature = 0;
+    };
+
+    void Build(const Vector<UIPriorityStyleSheet>& sortedStyleSheets);
+
+    void CollectCandidates(const UIControl* control, const UIStyleSheetClassSet& globalClasses, Vector<int32>& candidates) const;
+    const Vector<const UIStyleSheetSelector*>& GetAncestorSelectors() const;
+
+    void SetGlobalClassesVersion(uint32 version);
+    const MatchResult* FindMatchResult(const MatchKey& key) const;
+    const MatchResult& AddMatchResult(const MatchKey& key, Vector<int32>&& styleSheets, const Vector<int32>& ancestorSelectors);
+
+private:
+    struct MatchKeyHash
+    {
+        size_t operator()(const MatchKey& key) const;
+    };
+
+    void ClearMatchResults();
+
+    UnorderedMap<FastName, Vector<int32>> styleSheetsByName;
+    UnorderedMap<FastName, Vector<int32>> styleSheetsByClass;
+    UnorderedMap<String, Vector<int32>> styleSheetsByType;
+    Vector<int32> universalStyleSheets;
+    Vector<const UIStyleSheetSelector*> ancestorSelectors;
+
+    UnorderedMap<MatchKey, MatchResult, MatchKeyHash> matchResults;
+    Map<Vector<int32>, uint32> signatures;
+    uint32 globalClassesVersion = 0;
+};
+
+inline const Vector<const UIStyleSheetSelector*>& UIStyleSheetSelectorIndex::GetAncestorSelectors() const
+{
+    return ancestorSelectors;
+}
+}
@@ -111,6 +111,11 @@ bool UIStyleSheetClassSet::RemoveAllClasses()
     return false;
 }
 
+const Vector<UIStyleSheetClass>& UIStyleSheetClassSet::GetClasses() const
+{
+    return classes;
+}
+
 String UIStyleSheetClassSet::GetClassesAsString() const
 {
     String result;
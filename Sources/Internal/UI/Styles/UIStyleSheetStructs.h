@@ -119,6 +119,7 @@ public:
     bool ResetTaggedClass(const FastName& tag);
 
     bool RemoveAllClasses();
+    const Vector<UIStyleSheetClass>& GetClasses() const;
 
     String GetClassesAsString() const;
     void SetClassesFromString(const String& classes);
@@ -19,6 +19,7 @@ namespace DAVA
 namespace
 {
 const int32 PROPERTY_ANIMATION_GROUP_OFFSET = 100000;
+const size_t MAX_CHAIN_IDS = 65536;
 }
 
 struct ImmediatePropertySetter
@@ -150,7 +151,7 @@ void UIStyleSheetSystem::ProcessControl(UIControl* control, bool styleSheetListC
 #if STYLESHEET_STATS
     uint64 startTime = SystemTimer::GetUs();
 #endif
-    ProcessControlImpl(control, 0, styleSheetListChanged, true, false, nullptr);
+    ProcessControlImpl(control, 0, false, styleSheetListChanged, true, false, nullptr);
 #if STYLESHEET_STATS
     statsTime += SystemTimer::GetUs() - startTime;
 #endif
@@ -158,21 +159,34 @@ void UIStyleSheetSystem::ProcessControl(UIControl* control, bool styleSheetListC
 
 void UIStyleSheetSystem::DebugControl(UIControl* control, UIStyleSheetProcessDebugData* debugData)
 {
-    ProcessControlImpl(control, 0, true, false, true, debugData);
+    ProcessControlImpl(control, 0, false, true, false, true, debugData);
 }
 
-void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData)
+void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool ancestorsUnchanged, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData)
 {
     RefPtr<UIControlPackageContext> packageContext = control->GetPackageContext();
     const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
 
+    // Chain ids cover only selectors of package context they were built with,
+    // so root of nested package is matched again even if ancestors of other context are unchanged
+    const UIControl* parent = control->GetParent();
+    const bool isContextBoundary = (parent != nullptr && parent->GetPackageContext() != packageContext);
+
     if (control->IsStyleSheetDirty())
     {
         distanceFromDirty = 0;
+        ancestorsUnchanged = false;
+    }
+    else if (isContextBoundary)
+    {
+        ancestorsUnchanged = false;
     }
 
+    int32 childrenDistanceFromDirty = distanceFromDirty + 1;
+    bool childrenAncestorsUnchanged = ancestorsUnchanged;
+
     if (packageContext
-        && (styleSheetListChanged || distanceFromDirty < packageContext->GetMaxStyleSheetHierarchyDepth()))
+        && (styleSheetListChanged || (!ancestorsUnchanged && distanceFromDirty < packageContext->GetMaxStyleSheetHierarchyDepth())))
     {
 #if STYLESHEET_STATS
         ++statsProcessedControls;
@@ -188,11 +202,13 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
 
         Array<const UIStyleSheetProperty*, UIStyleSheetPropertyDataBase::STYLE_SHEET_PROPERTY_COUNT> propertySources = {};
 
-        for (auto styleSheetIter = styleSheets.rbegin(); styleSheetIter != styleSheets.rend(); ++styleSheetIter)
+        const UIStyleSheetSelectorIndex::MatchResult& matchResult = MatchControl(packageContext->GetSelectorIndex(), styleSheets, control);
+        for (auto indexIter = matchResult.styleSheets.rbegin(); indexIter != matchResult.styleSheets.rend(); ++indexIter)
         {
-            const UIStyleSheet* styleSheet = styleSheetIter->GetStyleSheet();
+            const UIPriorityStyleSheet& priorityStyleSheet = styleSheets[*indexIter];
+            const UIStyleSheet* styleSheet = priorityStyleSheet.GetStyleSheet();
 
-            if (StyleSheetMatchesControl(styleSheet, control))
+            if (StyleSheetMatchesAncestors(styleSheet, control))
             {
                 cascadeProperties |= styleSheet->GetPropertyTable()->GetPropertySet();
 
@@ -209,11 +225,24 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
 
                 if (debugData != nullptr)
                 {
-                    debugData->styleSheets.push_back(*styleSheetIter);
+                    debugData->styleSheets.push_back(priorityStyleSheet);
                 }
             }
         }
 
+        if (!dryRun)
+        {
+            // Descendants see this control and its ancestors only through matched selectors,
+            // so they are up to date if nothing of it has changed.
+            // Ancestors from other package context were matched with other selectors, so chain is started anew.
+            const uint32 chainId = isContextBoundary ? nextChainId++ : GetChainId(matchResult.signature, parent);
+            if (chainId == control->GetStyleSheetChainId() && !styleSheetListChanged)
+            {
+                childrenAncestorsUnchanged = true;
+            }
+            control->SetStyleSheetChainId(chainId);
+        }
+
         const UIStyleSheetPropertySet propertiesToApply = cascadeProperties & (~localControlProperties);
         if (debugData != nullptr)
         {
@@ -259,6 +288,11 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
             }
         }
     }
+    else if (!packageContext && !dryRun)
+    {
+        // Matching of control isn't checked without style sheets, so descendants can't rely on its chain id
+        control->SetStyleSheetChainId(nextChainId++);
+    }
 
     if (!dryRun)
     {
@@ -270,7 +304,7 @@ void UIStyleSheetSystem::ProcessControlImpl(UIControl* control, int32 distanceFr
     {
         for (const auto& child : control->GetChildren())
         {
-            ProcessControlImpl(child.Get(), distanceFromDirty + 1, styleSheetListChanged, true, dryRun, debugData);
+            ProcessControlImpl(child.Get(), childrenDistanceFromDirty, childrenAncestorsUnchanged, styleSheetListChanged, true, dryRun, debugData);
         }
     }
 }
@@ -279,6 +313,7 @@ void UIStyleSheetSystem::AddGlobalClass(const FastName& clazz)
 {
     if (globalClasses.AddClass(clazz))
     {
+        ++globalClassesVersion;
         SetGlobalStyleSheetDirty();
     }
 }
@@ -287,6 +322,7 @@ void UIStyleSheetSystem::RemoveGlobalClass(const FastName& clazz)
 {
     if (globalClasses.RemoveClass(clazz))
     {
+        ++globalClassesVersion;
         SetGlobalStyleSheetDirty();
     }
 }
@@ -298,7 +334,10 @@ bool UIStyleSheetSystem::HasGlobalClass(const FastName& clazz) const
 
 void UIStyleSheetSystem::SetGlobalTaggedClass(const FastName& tag, const FastName& clazz)
 {
-    globalClasses.SetTaggedClass(tag, clazz);
+    if (globalClasses.SetTaggedClass(tag, clazz))
+    {
+        ++globalClassesVersion;
+    }
 }
 
 FastName UIStyleSheetSystem::GetGlobalTaggedClass(const FastName& tag) const
@@ -308,12 +347,18 @@ FastName UIStyleSheetSystem::GetGlobalTaggedClass(const FastName& tag) const
 
 void UIStyleSheetSystem::ResetGlobalTaggedClass(const FastName& tag)
 {
-    globalClasses.ResetTaggedClass(tag);
+    if (globalClasses.ResetTaggedClass(tag))
+    {
+        ++globalClassesVersion;
+    }
 }
 
 void UIStyleSheetSystem::ClearGlobalClasses()
 {
-    globalClasses.RemoveAllClasses();
+    if (globalClasses.RemoveAllClasses())
+    {
+        ++globalClassesVersion;
+    }
 }
 
 void UIStyleSheetSystem::ClearStats()
@@ -349,16 +394,73 @@ void UIStyleSheetSystem::ProcessControlHierarhy(UIControl* control)
     }
 }
 
-bool UIStyleSheetSystem::StyleSheetMatchesControl(const UIStyleSheet* styleSheet, const UIControl* control)
+const UIStyleSheetSelectorIndex::MatchResult& UIStyleSheetSystem::MatchControl(UIStyleSheetSelectorIndex& index, const Vector<UIPriorityStyleSheet>& styleSheets, const UIControl* control)
+{
+    index.SetGlobalClassesVersion(globalClassesVersion);
+
+    UIStyleSheetSelectorIndex::MatchKey key(control);
+    if (const UIStyleSheetSelectorIndex::MatchResult* result = index.FindMatchResult(key))
+    {
+        return *result;
+    }
+
+    Vector<int32> candidates;
+    index.CollectCandidates(control, globalClasses, candidates);
+
+    Vector<int32> matchedStyleSheets;
+    for (int32 styleSheetIndex : candidates)
+    {
+        const UIStyleSheetSelectorChain& chain = styleSheets[styleSheetIndex].GetStyleSheet()->GetSelectorChain();
+        if (chain.GetSize() == 0 || SelectorMatchesControl(*chain.rbegin(), control))
+        {
+            matchedStyleSheets.push_back(styleSheetIndex);
+        }
+    }
+
+    Vector<int32> matchedAncestorSelectors;
+    const Vector<const UIStyleSheetSelector*>& ancestorSelectors = index.GetAncestorSelectors();
+    for (size_t i = 0; i < ancestorSelectors.size(); ++i)
+    {
+        if (SelectorMatchesControl(*ancestorSelectors[i], control))
+        {
+            matchedAncestorSelectors.push_back(static_cast<int32>(i));
+        }
+    }
+
+    return index.AddMatchResult(key, std::move(matchedStyleSheets), matchedAncestorSelectors);
+}
+
+uint32 UIStyleSheetSystem::GetChainId(uint32 signature, const UIControl* parent)
+{
+    if (chainIds.size() >= MAX_CHAIN_IDS)
+    {
+        // New ids never repeat old ones, so dropped chains only cause extra processing
+        chainIds.clear();
+    }
+
+    const uint32 parentChainId = parent != nullptr ? parent->GetStyleSheetChainId() : 0;
+    auto it = chainIds.emplace((static_cast<uint64>(signature) << 32) | parentChainId, nextChainId);
+    if (it.second)
+    {
+        ++nextChainId;
+    }
+    return it.first->second;
+}
+
+bool UIStyleSheetSystem::StyleSheetMatchesAncestors(const UIStyleSheet* styleSheet, const UIControl* control)
 {
 #if STYLESHEET_STATS
     ++statsMatches;
 #endif
 
-    const UIControl* currentControl = control;
+    const UIStyleSheetSelectorChain& chain = styleSheet->GetSelectorChain();
+    if (chain.GetSize() <= 1)
+        return true;
+
+    const UIControl* currentControl = control->GetParent();
 
-    auto endIter = styleSheet->GetSelectorChain().rend();
-    for (auto selectorIter = styleSheet->GetSelectorChain().rbegin(); selectorIter != endIter; ++selectorIter)
+    auto endIter = chain.rend();
+    for (auto selectorIter = chain.rbegin() + 1; selectorIter != endIter; ++selectorIter)
     {
         if (!currentControl || !SelectorMatchesControl(*selectorIter, currentControl))
             return false;
@@ -6,6 +6,7 @@
 #include "Base/RefPtr.h"
 #include "UI/Styles/UIPriorityStyleSheet.h"
 #include "UI/Styles/UIStyleSheetPropertyDataBase.h"
+#include "UI/Styles/UIStyleSheetSelectorIndex.h"
 #include "UI/Styles/UIStyleSheetStructs.h"
 #include "UI/UISystem.h"
 #include "Functional/Signal.h"
@@ -64,10 +65,12 @@ private:
     void Process(float32 elapsedTime) override;
     void ForceProcessControl(float32 elapsedTime, UIControl* control) override;
 
-    void ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData);
+    void ProcessControlImpl(UIControl* control, int32 distanceFromDirty, bool ancestorsUnchanged, bool styleSheetListChanged, bool recursively, bool dryRun, UIStyleSheetProcessDebugData* debugData);
     void ProcessControlHierarhy(UIControl* root);
 
-    bool StyleSheetMatchesControl(const UIStyleSheet* styleSheet, const UIControl* control);
+    const UIStyleSheetSelectorIndex::MatchResult& MatchControl(UIStyleSheetSelectorIndex& index, const Vector<UIPriorityStyleSheet>& styleSheets, const UIControl* control);
+    uint32 GetChainId(uint32 signature, const UIControl* parent);
+    bool StyleSheetMatchesAncestors(const UIStyleSheet* styleSheet, const UIControl* control);
     bool SelectorMatchesControl(const UIStyleSheetSelector& selector, const UIControl* control);
 
     template <typename CallbackType>
@@ -76,6 +79,11 @@ private:
     void SetGlobalStyleSheetDirty();
 
     UIStyleSheetClassSet globalClasses;
+    uint32 globalClassesVersion = 0;
+
+    /** Interned pairs of control signature and parent chain id, equal chain ids mean equal matching of all ancestors. */
+    UnorderedMap<uint64, uint32> chainIds;
+    uint32 nextChainId = 1;
 
     uint64 statsTime = 0;
     int32 statsProcessedControls = 0;
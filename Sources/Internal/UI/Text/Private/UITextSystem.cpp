@@ -55,6 +55,7 @@ void UITextSystem::ApplyData(UITextComponent* component)
         DVASSERT(control, "Invalid control pointer!");
 
         component->SetModified(false);
+        control->SetStaticBatchDirty();
 
         textBg->SetColorInheritType(component->GetColorInheritType());
         textBg->SetPerPixelAccuracyType(component->GetPerPixelAccuracyType());
@@ -83,6 +83,8 @@ void UI3DView::Draw(const UIGeometricData& geometricData)
         return;
 
     RenderSystem2D::Instance()->Flush();
+    // scene is drawn in its own render pass, which can't be recorded into static batch
+    RenderSystem2D::Instance()->InvalidateStaticBatch();
 
     const RenderSystem2D::RenderTargetPassDescriptor& currentTarget = RenderSystem2D::Instance()->GetActiveTargetDescriptor();
 
@@ -15,6 +15,7 @@
 #include "UI/Layouts/UILayoutSystem.h"
 #include "UI/Render/UIClipContentComponent.h"
 #include "UI/Render/UIRenderSystem.h"
+#include "UI/Render/UIStaticBatchComponent.h"
 #include "UI/Styles/UIStyleSheetSystem.h"
 #include "UI/UIAnalytics.h"
 #include "UI/UIControlBackground.h"
@@ -90,6 +91,7 @@ UIControl::UIControl(const Rect& rect)
     , layoutDirty(true)
     , layoutPositionDirty(true)
     , layoutOrderDirty(true)
+    , layoutSubtreeDirty(true)
     , inputEnabled(true)
 {
     StartControlTracking(this);
@@ -144,6 +146,11 @@ void UIControl::SetParent(UIControl* newParent)
         PropagateParentWithContext(newParent->packageContext ? newParent : newParent->parentWithContext);
 
         parent->RegisterInputProcessors(inputProcessorsCount);
+
+        if (layoutDirty || layoutPositionDirty || layoutOrderDirty || layoutSubtreeDirty)
+        {
+            parent->SetLayoutSubtreeDirty();
+        }
     }
     else
     {
@@ -433,6 +440,7 @@ void UIControl::SetPivot(const Vector2& newPivot)
 void UIControl::SetAngle(float32 angleInRad)
 {
     angle = angleInRad;
+    SetStaticBatchDirty();
 }
 
 void UIControl::SetAngleInDegrees(float32 angleInDeg)
@@ -889,6 +897,7 @@ void UIControl::CopyDataFrom(UIControl* srcControl)
     styleSheetInitialized = false;
     layoutDirty = srcControl->layoutDirty;
     layoutPositionDirty = srcControl->layoutPositionDirty;
+    layoutSubtreeDirty = true;
     layoutOrderDirty = srcControl->layoutOrderDirty;
     packageContext = srcControl->packageContext;
 
@@ -2254,6 +2263,11 @@ void UIControl::SetClassesFromString(const String& classesStr)
     SetStyleSheetDirty();
 }
 
+const UIStyleSheetClassSet& UIControl::GetClassSet() const
+{
+    return classes;
+}
+
 const UIStyleSheetPropertySet& UIControl::GetLocalPropertySet() const
 {
     return localProperties;
@@ -2313,9 +2327,24 @@ void UIControl::ResetStyleSheetDirty()
     styleSheetDirty = false;
 }
 
+uint32 UIControl::GetStyleSheetChainId() const
+{
+    return styleSheetChainId;
+}
+
+void UIControl::SetStyleSheetChainId(uint32 chainId)
+{
+    styleSheetChainId = chainId;
+}
+
 void UIControl::SetLayoutDirty()
 {
     layoutDirty = true;
+    SetStaticBatchDirty();
+    if (parent)
+    {
+        parent->SetLayoutSubtreeDirty();
+    }
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2336,6 +2365,11 @@ void UIControl::ResetLayoutDirty()
 void UIControl::SetLayoutPositionDirty()
 {
     layoutPositionDirty = true;
+    SetStaticBatchDirty();
+    if (parent)
+    {
+        parent->SetLayoutSubtreeDirty();
+    }
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2354,6 +2388,11 @@ void UIControl::ResetLayoutPositionDirty()
 void UIControl::SetLayoutOrderDirty()
 {
     layoutOrderDirty = true;
+    SetStaticBatchDirty();
+    if (parent)
+    {
+        parent->SetLayoutSubtreeDirty();
+    }
 }
 
 void UIControl::ResetLayoutOrderDirty()
@@ -2361,6 +2400,35 @@ void UIControl::ResetLayoutOrderDirty()
     layoutOrderDirty = false;
 }
 
+void UIControl::SetStaticBatchDirty()
+{
+    // retained geometry of static batch includes whole subtree, so every batch up to the root is affected
+    for (UIControl* control = this; control != nullptr; control = control->parent)
+    {
+        UIStaticBatchComponent* staticBatch = control->GetComponent<UIStaticBatchComponent>();
+        if (staticBatch != nullptr)
+        {
+            staticBatch->Invalidate();
+        }
+    }
+}
+
+void UIControl::SetLayoutSubtreeDirty()
+{
+    // Ancestors of control with dirty subtree are already marked
+    UIControl* control = this;
+    while (control != nullptr && !control->layoutSubtreeDirty)
+    {
+        control->layoutSubtreeDirty = true;
+        control = control->parent;
+    }
+}
+
+void UIControl::ResetLayoutSubtreeDirty()
+{
+    layoutSubtreeDirty = false;
+}
+
 void UIControl::SetPackageContext(const RefPtr<UIControlPackageContext>& newPackageContext)
 {
     if (packageContext != newPackageContext)
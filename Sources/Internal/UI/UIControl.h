@@ -906,6 +906,7 @@ protected:
     bool layoutDirty : 1;
     bool layoutPositionDirty : 1;
     bool layoutOrderDirty : 1;
+    bool layoutSubtreeDirty : 1;
 
     int32 inputProcessorsCount = 1;
 
@@ -1055,6 +1056,7 @@ public:
 
     String GetClassesAsString() const;
     void SetClassesFromString(const String& classes);
+    const UIStyleSheetClassSet& GetClassSet() const;
 
     const UIStyleSheetPropertySet& GetLocalPropertySet() const;
     void SetLocalPropertySet(const UIStyleSheetPropertySet& set);
@@ -1070,6 +1072,9 @@ public:
     void SetStyleSheetDirty();
     void ResetStyleSheetDirty();
 
+    uint32 GetStyleSheetChainId() const;
+    void SetStyleSheetChainId(uint32 chainId);
+
     bool IsLayoutDirty() const;
     void SetLayoutDirty();
     void ResetLayoutDirty();
@@ -1082,6 +1087,14 @@ public:
     void SetLayoutOrderDirty();
     void ResetLayoutOrderDirty();
 
+    /** Invalidate retained geometry of UIStaticBatchComponent on this control and its ancestors.
+        Layout dirty flags call it, so it is needed only for changes which don't affect layout. */
+    void SetStaticBatchDirty();
+
+    /** Some of descendants have dirty layout. */
+    bool IsLayoutSubtreeDirty() const;
+    void ResetLayoutSubtreeDirty();
+
     RefPtr<UIControlPackageContext> GetPackageContext() const;
     const RefPtr<UIControlPackageContext>& GetLocalPackageContext() const;
     void SetPackageContext(const RefPtr<UIControlPackageContext>& packageContext);
@@ -1093,8 +1106,10 @@ private:
     UIStyleSheetPropertySet styledProperties;
     RefPtr<UIControlPackageContext> packageContext;
     UIControl* parentWithContext = nullptr;
+    uint32 styleSheetChainId = 0;
 
     void PropagateParentWithContext(UIControl* newParentWithContext);
+    void SetLayoutSubtreeDirty();
     /* Styles */
 
 public:
@@ -1128,6 +1143,7 @@ inline const Vector2& UIControl::GetScale() const
 inline void UIControl::SetScale(const Vector2& newScale)
 {
     scale = newScale;
+    SetStaticBatchDirty();
 }
 
 inline const Vector2& UIControl::GetSize() const
@@ -1238,4 +1254,9 @@ inline bool UIControl::IsLayoutOrderDirty() const
 {
     return layoutOrderDirty;
 }
+
+inline bool UIControl::IsLayoutSubtreeDirty() const
+{
+    return layoutSubtreeDirty;
+}
 };
@@ -151,6 +151,7 @@ void UIControlBackground::SetSprite(const FilePath& path)
 void UIControlBackground::SetFrame(int32 drawFrame)
 {
     frame = drawFrame;
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetFrame(const FastName& frameName)
@@ -166,6 +167,7 @@ void UIControlBackground::SetFrame(const FastName& frameName)
 void UIControlBackground::SetAlign(int32 drawAlign)
 {
     align = drawAlign;
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetDrawType(UIControlBackground::eDrawType drawType)
@@ -186,17 +188,20 @@ void UIControlBackground::SetDrawType(UIControlBackground::eDrawType drawType)
 void UIControlBackground::SetModification(int32 modification)
 {
     spriteModification = modification;
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetColorInheritType(UIControlBackground::eColorInheritType inheritType)
 {
     DVASSERT(inheritType >= 0 && inheritType < COLOR_INHERIT_TYPES_COUNT);
     colorInheritType = inheritType;
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetPerPixelAccuracyType(ePerPixelAccuracyType accuracyType)
 {
     perPixelAccuracyType = accuracyType;
+    SetStaticBatchDirty();
 }
 
 UIControlBackground::ePerPixelAccuracyType UIControlBackground::GetPerPixelAccuracyType() const
@@ -549,6 +554,14 @@ const SpriteDrawState& UIControlBackground::GetLastDrawState() const
 }
 #endif
 
+void UIControlBackground::SetStaticBatchDirty()
+{
+    if (GetControl()) //workaround for standalone backgrounds
+    {
+        GetControl()->SetStaticBatchDirty();
+    }
+}
+
 void UIControlBackground::ReleaseDrawData()
 {
     SafeDelete(tiledData);
@@ -559,11 +572,13 @@ void UIControlBackground::ReleaseDrawData()
 void UIControlBackground::SetLeftRightStretchCap(float32 _leftStretchCap)
 {
     leftStretchCap = _leftStretchCap;
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetTopBottomStretchCap(float32 _topStretchCap)
 {
     topStretchCap = _topStretchCap;
+    SetStaticBatchDirty();
 }
 
 float32 UIControlBackground::GetLeftRightStretchCap() const
@@ -579,6 +594,7 @@ float32 UIControlBackground::GetTopBottomStretchCap() const
 void UIControlBackground::SetMaterial(NMaterial* _material)
 {
     material = _material;
+    SetStaticBatchDirty();
 }
 
 inline NMaterial* UIControlBackground::GetMaterial() const
@@ -589,21 +605,25 @@ inline NMaterial* UIControlBackground::GetMaterial() const
 void UIControlBackground::SetRenderBatches(const Vector<BatchDescriptor2D>& batches)
 {
     batchDescriptors = batches;
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::AppendRenderBatches(const Vector<BatchDescriptor2D>& batches)
 {
     batchDescriptors.insert(batchDescriptors.end(), batches.begin(), batches.end());
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::AddRenderBatch(const BatchDescriptor2D& batch)
 {
     batchDescriptors.push_back(batch);
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::ClearBatches()
 {
     batchDescriptors.clear();
+    SetStaticBatchDirty();
 }
 
 const Vector<BatchDescriptor2D>& UIControlBackground::GetRenderBatches() const
@@ -614,6 +634,7 @@ const Vector<BatchDescriptor2D>& UIControlBackground::GetRenderBatches() const
 void UIControlBackground::SetColor(const Color& _color)
 {
     color = _color;
+    SetStaticBatchDirty();
 }
 
 const Color& UIControlBackground::GetColor() const
@@ -644,11 +665,13 @@ void UIControlBackground::SetMaskSpriteFromPath(const FilePath& path)
         mask.Set(Sprite::Create(path));
     else
         mask.Set(nullptr);
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetMaskSprite(Sprite* sprite)
 {
     mask = sprite;
+    SetStaticBatchDirty();
 }
 
 FilePath UIControlBackground::GetDetailSpritePath() const
@@ -664,11 +687,13 @@ void UIControlBackground::SetDetailSpriteFromPath(const FilePath& path)
         detail.Set(Sprite::Create(path));
     else
         detail.Set(nullptr);
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetDetailSprite(Sprite* sprite)
 {
     detail = sprite;
+    SetStaticBatchDirty();
 }
 
 FilePath UIControlBackground::GetGradientSpritePath() const
@@ -684,11 +709,13 @@ void UIControlBackground::SetGradientSpriteFromPath(const FilePath& path)
         gradient.Set(Sprite::Create(path));
     else
         gradient.Set(nullptr);
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetGradientSprite(Sprite* sprite)
 {
     gradient = sprite;
+    SetStaticBatchDirty();
 }
 
 FilePath UIControlBackground::GetContourSpritePath() const
@@ -704,11 +731,13 @@ void UIControlBackground::SetContourSpriteFromPath(const FilePath& path)
         contour.Set(Sprite::Create(path));
     else
         contour.Set(nullptr);
+    SetStaticBatchDirty();
 }
 
 void UIControlBackground::SetContourSprite(Sprite* sprite)
 {
     contour = sprite;
+    SetStaticBatchDirty();
 }
 
 eGradientBlendMode UIControlBackground::GetGradientBlendMode() const
@@ -719,5 +748,6 @@ eGradientBlendMode UIControlBackground::GetGradientBlendMode() const
 void UIControlBackground::SetGradientBlendMode(eGradientBlendMode mode)
 {
     gradientMode = mode;
+    SetStaticBatchDirty();
 }
 };
@@ -278,6 +278,8 @@ protected:
     eGradientBlendMode gradientMode = GRADIENT_MULTIPLY;
 
 private:
+    void SetStaticBatchDirty();
+
     TiledDrawData* tiledData = nullptr;
     StretchDrawData* stretchData = nullptr;
     TiledMultilayerData* tiledMultulayerData = nullptr;
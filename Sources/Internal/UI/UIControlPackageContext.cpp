@@ -31,6 +31,7 @@ void UIControlPackageContext::AddStyleSheet(const UIPriorityStyleSheet& styleShe
 void UIControlPackageContext::RemoveAllStyleSheets()
 {
     styleSheets.clear();
+    styleSheetsSorted = false;
     maxStyleSheetHierarchyDepth = 0;
 }
 
@@ -39,12 +40,19 @@ const Vector<UIPriorityStyleSheet>& UIControlPackageContext::GetSortedStyleSheet
     if (!styleSheetsSorted)
     {
         std::sort(styleSheets.begin(), styleSheets.end());
+        selectorIndex.Build(styleSheets);
         styleSheetsSorted = true;
     }
 
     return styleSheets;
 }
 
+UIStyleSheetSelectorIndex& UIControlPackageContext::GetSelectorIndex()
+{
+    GetSortedStyleSheets();
+    return selectorIndex;
+}
+
 int32 UIControlPackageContext::GetMaxStyleSheetHierarchyDepth() const
 {
     return maxStyleSheetHierarchyDepth;
@@ -4,6 +4,7 @@
 #include "Base/BaseObject.h"
 #include "Base/BaseTypes.h"
 #include "UI/Styles/UIPriorityStyleSheet.h"
+#include "UI/Styles/UIStyleSheetSelectorIndex.h"
 
 namespace DAVA
 {
@@ -20,11 +21,13 @@ public:
     void RemoveAllStyleSheets();
 
     const Vector<UIPriorityStyleSheet>& GetSortedStyleSheets();
+    UIStyleSheetSelectorIndex& GetSelectorIndex();
 
     int32 GetMaxStyleSheetHierarchyDepth() const;
 
 private:
     Vector<UIPriorityStyleSheet> styleSheets;
+    UIStyleSheetSelectorIndex selectorIndex;
     bool styleSheetsSorted = false;
     int32 maxStyleSheetHierarchyDepth = 0;
 };
@@ -122,6 +122,8 @@ void UIMovieView::UpdateControlRect()
 void UIMovieView::Draw(const UIGeometricData& parentGeometricData)
 {
     UIControl::Draw(parentGeometricData);
+    // native view follows control on draw, so it must not be skipped by static batch replay
+    RenderSystem2D::Instance()->InvalidateStaticBatch();
     movieViewControl->Draw(parentGeometricData);
 #if defined(DRAW_PLACEHOLDER_FOR_STUB_UIMOVIEVIEW)
     static Color drawColor(Color(1.0f, 0.4f, 0.8f, 1.0f));
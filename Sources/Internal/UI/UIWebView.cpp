@@ -238,6 +238,8 @@ void UIWebView::Draw(const UIGeometricData& geometricData)
 {
     webViewControl->WillDraw();
     UIControl::Draw(geometricData);
+    // native view follows control on draw, so it must not be skipped by static batch replay
+    RenderSystem2D::Instance()->InvalidateStaticBatch();
     webViewControl->Draw(geometricData);
     webViewControl->DidDraw();
 }